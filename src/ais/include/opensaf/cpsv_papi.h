@@ -46,6 +46,35 @@ typedef void
                                 SaCkptIOVectorElementT *ioVector, SaUint32T numberOfElements);
 SaAisErrorT
 ncsCkptRegisterCkptArrivalCallback(SaCkptHandleT ckptHandle, ncsCkptCkptArrivalCallbackT ckptArrivalCallback);
+
+/*
+ * Asynchronous write. ncsCkptCheckpointWriteAsync() writes like
+ * saCkptCheckpointWrite() but returns without waiting for the write to be
+ * done. The result is delivered to the write callback, registered with
+ * ncsCkptRegisterCkptWriteCallback(), when saCkptDispatch() is invoked.
+ *
+ * The writes of a checkpoint handle are done, and their callbacks invoked,
+ * in the order they were issued. The ioVector may be reused when the call
+ * returns. SA_AIS_ERR_TRY_AGAIN is returned while too many writes of the
+ * checkpoint handle are pending. If a write times out, the writes of the
+ * checkpoint handle pending after it fail with SA_AIS_ERR_TIMEOUT as well.
+ *
+ * To a checkpoint created with SA_CKPT_WR_ALL_REPLICAS the writes of a
+ * checkpoint handle are sent one at a time, each one waiting for the remote
+ * replicas. Writes through several handles of the checkpoint are sent to
+ * the remote replicas together, in the order they arrive at the active
+ * replica.
+ */
+typedef void
+(*ncsCkptCheckpointWriteCallbackT) (SaInvocationT invocation,
+                                    SaCkptCheckpointHandleT checkpointHandle,
+                                    SaUint32T erroneousVectorIndex,
+                                    SaAisErrorT error);
+SaAisErrorT
+ncsCkptRegisterCkptWriteCallback(SaCkptHandleT ckptHandle, ncsCkptCheckpointWriteCallbackT ckptWriteCallback);
+SaAisErrorT
+ncsCkptCheckpointWriteAsync(SaCkptCheckpointHandleT checkpointHandle, SaInvocationT invocation,
+                            const SaCkptIOVectorElementT *ioVector, SaUint32T numberOfElements);
 #ifdef  __cplusplus
 }
 #endif
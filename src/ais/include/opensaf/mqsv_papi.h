@@ -0,0 +1,96 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2008 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ * Author(s): Ericsson AB
+ *
+ */
+
+/*****************************************************************************
+..............................................................................
+
+..............................................................................
+
+  DESCRIPTION:
+
+ _Public_ MQA abstractions and function prototypes
+
+*******************************************************************************/
+
+/*
+ * Module Inclusion Control...
+ */
+
+#ifndef MQSV_PAPI_H
+#define MQSV_PAPI_H
+
+#include "saMsg.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Least loaded queue group policy. A message sent to a queue group with this
+ * policy goes to the opened member queue that has the lowest fill level,
+ * members with about the same fill level take turns like for the round robin
+ * policy. The fill levels are reported periodically by the message node
+ * directors, see MSGND_LOAD_UPDATE_INTERVAL in msgnd.conf.
+ */
+#define NCS_MSG_QUEUE_GROUP_LEAST_LOADED ((SaMsgQueueGroupPolicyT)0x100)
+
+/*
+ * Batched send. ncsMsgMessageSendBatch() sends the numberOfMessages messages
+ * like saMsgMessageSend() does, in the order given. The messages to a queue
+ * are sent to the node of the queue in as few requests as possible. The
+ * messages to a queue group are sent one by one according to the policy of
+ * the group.
+ *
+ * The status of each message is returned in errors[], which shall hold
+ * numberOfMessages elements. SA_AIS_OK is returned if all the messages were
+ * sent, otherwise the status of the first message that was not sent. The
+ * timeout applies to each request, when a request times out or fails the
+ * messages not sent yet fail with the same error.
+ */
+SaAisErrorT
+ncsMsgMessageSendBatch(SaMsgHandleT msgHandle, const SaNameT *destination,
+                       const SaMsgMessageT *messages, SaUint32T numberOfMessages,
+                       SaTimeT timeout, SaAisErrorT *errors);
+
+/*
+ * Batched get. ncsMsgMessageGetBatch() gets up to maxMessages messages from
+ * the queue like saMsgMessageGet() does, the number of messages returned is
+ * given in numberOfMessages. The call waits at most timeout for the first
+ * message and then returns the messages that are in the queue, without
+ * waiting. The message buffers are handled as for saMsgMessageGet(), the
+ * sendTimes and senderIds arrays may be NULL.
+ *
+ * A message sent with saMsgMessageSendReceive() is returned as the first
+ * message of a call only. SA_AIS_ERR_NO_SPACE is returned when the first
+ * message does not fit into its buffer, a later message that does not fit is
+ * left in the queue.
+ *
+ * For a queue opened with SA_MSG_QUEUE_RECEIVE_CALLBACK a call stands for one
+ * saMsgMessageReceivedCallback, like a saMsgMessageGet(). The callbacks of
+ * the other messages returned are not invoked.
+ */
+SaAisErrorT
+ncsMsgMessageGetBatch(SaMsgQueueHandleT queueHandle, SaMsgMessageT *messages,
+                      SaTimeT *sendTimes, SaMsgSenderIdT *senderIds,
+                      SaUint32T maxMessages, SaUint32T *numberOfMessages,
+                      SaTimeT timeout);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif   /* MQSV_PAPI_H */
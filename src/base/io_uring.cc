@@ -0,0 +1,198 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+#include "base/io_uring.h"
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#if defined(__NR_io_uring_setup) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define HAVE_IO_URING 1
+#endif
+
+namespace base {
+
+#ifdef HAVE_IO_URING
+
+struct IoUring::Sqe : public io_uring_sqe {};
+
+IoUring::IoUring(unsigned entries)
+    : ring_fd_{-1},
+      in_flight_{0},
+      sq_ring_{MAP_FAILED},
+      sq_ring_size_{0},
+      cq_ring_{MAP_FAILED},
+      cq_ring_size_{0},
+      sqes_{MAP_FAILED},
+      sqes_size_{0} {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  int fd = syscall(__NR_io_uring_setup, entries, &params);
+  if (fd < 0) return;
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+  sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    close(fd);
+    return;
+  }
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    cq_ring_ = sq_ring_;
+  } else {
+    cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+  }
+  sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  sqes_ = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  if (cq_ring_ == MAP_FAILED || sqes_ == MAP_FAILED) {
+    if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_) {
+      munmap(cq_ring_, cq_ring_size_);
+    }
+    munmap(sq_ring_, sq_ring_size_);
+    close(fd);
+    cq_ring_ = sq_ring_ = MAP_FAILED;
+    return;
+  }
+
+  char* sq = static_cast<char*>(sq_ring_);
+  char* cq = static_cast<char*>(cq_ring_);
+  sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  cqes_ = cq + params.cq_off.cqes;
+  ring_fd_ = fd;
+}
+
+IoUring::~IoUring() {
+  if (ring_fd_ < 0) return;
+  // Completions of operations still in flight are not waited for. Their
+  // buffers must stay valid, i.e. the owner waits before destroying them.
+  munmap(sqes_, sqes_size_);
+  if (cq_ring_ != sq_ring_) munmap(cq_ring_, cq_ring_size_);
+  munmap(sq_ring_, sq_ring_size_);
+  close(ring_fd_);
+}
+
+bool IoUring::Submit(const Sqe& sqe) {
+  unsigned tail = *sq_tail_;
+  unsigned index = tail & sq_mask_;
+  static_cast<struct io_uring_sqe*>(sqes_)[index] = sqe;
+  sq_array_[index] = index;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  int result;
+  do {
+    result = syscall(__NR_io_uring_enter, ring_fd_, 1, 0, 0, nullptr, 0);
+  } while (result < 0 && errno == EINTR);
+  if (result != 1) {
+    // Not consumed by the kernel, take it back
+    __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+    return false;
+  }
+  ++in_flight_;
+  return true;
+}
+
+bool IoUring::Write(int fd, const void* buffer, size_t size, uint64_t offset,
+                    uint64_t user_data) {
+  if (ring_fd_ < 0) return false;
+  Sqe sqe;
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_WRITE;
+  sqe.fd = fd;
+  sqe.addr = reinterpret_cast<uintptr_t>(buffer);
+  sqe.len = size;
+  sqe.off = offset;
+  sqe.user_data = user_data;
+  return Submit(sqe);
+}
+
+bool IoUring::Fallocate(int fd, int mode, uint64_t offset, uint64_t length,
+                        uint64_t user_data) {
+  if (ring_fd_ < 0) return false;
+  Sqe sqe;
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_FALLOCATE;
+  sqe.fd = fd;
+  sqe.off = offset;
+  sqe.addr = length;
+  sqe.len = mode;
+  sqe.user_data = user_data;
+  return Submit(sqe);
+}
+
+bool IoUring::WaitCompletion(uint64_t* user_data, int* result) {
+  if (ring_fd_ < 0 || in_flight_ == 0) return false;
+  while (true) {
+    unsigned head = *cq_head_;
+    if (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+      const struct io_uring_cqe& cqe =
+          static_cast<struct io_uring_cqe*>(cqes_)[head & cq_mask_];
+      *user_data = cqe.user_data;
+      *result = cqe.res;
+      __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+      --in_flight_;
+      return true;
+    }
+    int rc = syscall(__NR_io_uring_enter, ring_fd_, 0, 1,
+                     IORING_ENTER_GETEVENTS, nullptr, 0);
+    if (rc < 0 && errno != EINTR) return false;
+  }
+}
+
+#else  // HAVE_IO_URING
+
+struct IoUring::Sqe {};
+
+IoUring::IoUring(unsigned)
+    : ring_fd_{-1},
+      in_flight_{0},
+      sq_ring_{nullptr},
+      sq_ring_size_{0},
+      cq_ring_{nullptr},
+      cq_ring_size_{0},
+      sqes_{nullptr},
+      sqes_size_{0} {}
+
+IoUring::~IoUring() {}
+
+bool IoUring::Submit(const Sqe&) { return false; }
+
+bool IoUring::Write(int, const void*, size_t, uint64_t, uint64_t) {
+  return false;
+}
+
+bool IoUring::Fallocate(int, int, uint64_t, uint64_t, uint64_t) {
+  return false;
+}
+
+bool IoUring::WaitCompletion(uint64_t*, int*) { return false; }
+
+#endif  // HAVE_IO_URING
+
+}  // namespace base
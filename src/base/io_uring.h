@@ -0,0 +1,75 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+#ifndef BASE_IO_URING_H_
+#define BASE_IO_URING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include "base/macros.h"
+
+namespace base {
+
+// A minimal io_uring instance (see io_uring(7)) for submitting file writes
+// asynchronously, using the system calls directly. An instance must only be
+// used by one thread at a time. If io_uring is not supported by the kernel or
+// is disabled, is_valid() returns false and the caller has to use synchronous
+// I/O instead.
+class IoUring {
+ public:
+  explicit IoUring(unsigned entries);
+  ~IoUring();
+  bool is_valid() const { return ring_fd_ >= 0; }
+  // Number of submitted operations not yet completed
+  unsigned in_flight() const { return in_flight_; }
+  // Submit a write of @a size bytes from @a buffer at @a offset in the file
+  // @a fd. The buffer must not be modified until the write has completed.
+  // Return false if the operation could not be submitted.
+  bool Write(int fd, const void* buffer, size_t size, uint64_t offset,
+             uint64_t user_data);
+  // Submit fallocate(fd, mode, offset, length).
+  bool Fallocate(int fd, int mode, uint64_t offset, uint64_t length,
+                 uint64_t user_data);
+  // Wait until an operation has completed and return its @a user_data and
+  // @a result, which is the return value of the system call or -errno.
+  // Return false if no operation is in flight or waiting failed.
+  bool WaitCompletion(uint64_t* user_data, int* result);
+
+ private:
+  struct Sqe;
+  bool Submit(const Sqe& sqe);
+
+  int ring_fd_;
+  unsigned in_flight_;
+  void* sq_ring_;
+  size_t sq_ring_size_;
+  void* cq_ring_;
+  size_t cq_ring_size_;
+  void* sqes_;
+  size_t sqes_size_;
+  unsigned* sq_tail_;
+  unsigned sq_mask_;
+  unsigned* sq_array_;
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  unsigned cq_mask_;
+  void* cqes_;
+
+  DELETE_COPY_AND_MOVE_OPERATORS(IoUring);
+};
+
+}  // namespace base
+
+#endif  // BASE_IO_URING_H_
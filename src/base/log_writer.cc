@@ -24,8 +24,16 @@
 #include <cstdio>
 #include <cstring>
 #include "base/getenv.h"
+#include "base/io_uring.h"
 #include "osaf/configmake.h"
 
+namespace {
+
+// user_data of operations that are not writes from an async buffer
+const uint64_t kFallocateOperation = ~uint64_t{0};
+
+}  // namespace
+
 LogWriter::LogWriter(const std::string& log_name, size_t max_backups,
                                                   size_t max_file_size)
     : log_file_{base::GetEnv<std::string>("pkglogdir", PKGLOGDIR) + "/" +
@@ -35,12 +43,44 @@ LogWriter::LogWriter(const std::string& log_name, size_t max_backups,
       current_buffer_size_{0},
       max_backups_{max_backups},
       max_file_size_{max_file_size},
-      buffer_{new char[kBufferSize]} {}
+      buffer_{new char[kBufferSize]},
+      io_uring_{nullptr},
+      async_buffers_{nullptr},
+      async_index_{0},
+      async_writes_{},
+      next_fd_{-1} {}
 
 LogWriter::~LogWriter() {
   Flush();
   Close();
+  WaitForAsyncIo();
+  if (next_fd_ >= 0) {
+    close(next_fd_);
+    unlink(next_log_file().c_str());
+  }
+  delete io_uring_;
+  if (async_buffers_ != nullptr) {
+    delete[] async_buffers_;
+  } else {
+    delete[] buffer_;
+  }
+}
+
+bool LogWriter::EnableAsyncIo() {
+  if (io_uring_ != nullptr) return true;
+  base::IoUring* io_uring = new base::IoUring{2 * kNoOfAsyncBuffers};
+  if (!io_uring->is_valid()) {
+    delete io_uring;
+    return false;
+  }
+  io_uring_ = io_uring;
+  async_buffers_ = new char[kNoOfAsyncBuffers * kBufferSize];
+  memcpy(async_buffers_, buffer_, current_buffer_size_);
   delete[] buffer_;
+  buffer_ = async_buffers_;
+  async_index_ = 0;
+  if (fd_ >= 0) Preallocate(fd_, current_file_size_);
+  return true;
 }
 
 std::string LogWriter::log_file(size_t backup) const {
@@ -62,6 +102,7 @@ void LogWriter::Open() {
       off_t seek_result = lseek(fd, 0, SEEK_END);
       if (seek_result >= 0) current_file_size_ = seek_result;
       fd_ = fd;
+      if (io_uring_ != nullptr) Preallocate(fd, current_file_size_);
     }
   }
 }
@@ -69,6 +110,13 @@ void LogWriter::Open() {
 void LogWriter::Close() {
   int fd = fd_;
   if (fd >= 0) {
+    if (io_uring_ != nullptr) {
+      WaitForAsyncIo();
+      // Release the preallocated space after the end of the file
+      if (ftruncate(fd, current_file_size_) != 0) {
+        // The space is kept, the data is not affected
+      }
+    }
     close(fd);
     fd_ = -1;
     current_file_size_ = 0;
@@ -85,6 +133,16 @@ void LogWriter::RotateLog() {
       unlink(previous_backup.c_str());
     }
   }
+  if (next_fd_ >= 0) {
+    if (rename(next_log_file().c_str(), log_file(0).c_str()) == 0) {
+      fd_ = next_fd_;
+    } else {
+      // Open() creates the log file instead
+      close(next_fd_);
+      unlink(next_log_file().c_str());
+    }
+    next_fd_ = -1;
+  }
 }
 
 void LogWriter::Write(const char* bytes, size_t size) {
@@ -100,17 +158,22 @@ void LogWriter::Write(const char* bytes, size_t size) {
     bytes_written += bytes_chunk;
     current_buffer_size_ += bytes_chunk;
     if (current_buffer_size_ >= kBufferSize ||
-        current_buffer_size_ >= max_file_size_) Flush();
+        current_buffer_size_ >= max_file_size_) WriteBuffer();
   }
 }
 
 void LogWriter::Write(size_t size) {
   current_buffer_size_ += size;
   if (current_buffer_size_ > kBufferSize - kMaxMessageSize ||
-      current_buffer_size_ >= max_file_size_) Flush();
+      current_buffer_size_ >= max_file_size_) WriteBuffer();
 }
 
 void LogWriter::Flush() {
+  WriteBuffer();
+  WaitForAsyncIo();
+}
+
+void LogWriter::WriteBuffer() {
   size_t size = current_buffer_size_;
   current_buffer_size_ = 0;
   if (size == 0) return;
@@ -121,6 +184,10 @@ void LogWriter::Flush() {
     if (fd_ < 0) Open();
     if (fd_ < 0) return;
   }
+  if (io_uring_ != nullptr) {
+    SubmitWrite(size);
+    return;
+  }
   size_t bytes_written = 0;
   while (bytes_written < size) {
     ssize_t result = write(fd_, buffer_ + bytes_written, size - bytes_written);
@@ -132,3 +199,92 @@ void LogWriter::Flush() {
   }
   current_file_size_ += bytes_written;
 }
+
+void LogWriter::SubmitWrite(size_t size) {
+  AsyncWrite& async_write = async_writes_[async_index_];
+  async_write.busy = true;
+  async_write.fd = fd_;
+  async_write.offset = current_file_size_;
+  async_write.size = size;
+  if (!io_uring_->Write(fd_, buffer_, size, current_file_size_,
+                        async_index_)) {
+    async_write.busy = false;
+    WriteAt(fd_, buffer_, size, current_file_size_);
+  }
+  current_file_size_ += size;
+  if (next_fd_ < 0 && current_file_size_ >= max_file_size_ / 2) {
+    PrepareNextFile();
+  }
+  async_index_ = (async_index_ + 1) % kNoOfAsyncBuffers;
+  while (async_writes_[async_index_].busy && CompleteAsyncIo()) {
+  }
+  buffer_ = async_buffers_ + async_index_ * kBufferSize;
+}
+
+bool LogWriter::CompleteAsyncIo() {
+  uint64_t user_data;
+  int result;
+  if (!io_uring_->WaitCompletion(&user_data, &result)) {
+    // The completions are lost, write again what might not have been written
+    for (size_t i = 0; i != kNoOfAsyncBuffers; ++i) {
+      AsyncWrite& async_write = async_writes_[i];
+      if (!async_write.busy) continue;
+      WriteAt(async_write.fd, async_buffers_ + i * kBufferSize,
+              async_write.size, async_write.offset);
+      async_write.busy = false;
+    }
+    return false;
+  }
+  // The result of preallocating is ignored, the file system might not
+  // support it
+  if (user_data == kFallocateOperation) return true;
+  AsyncWrite& async_write = async_writes_[user_data];
+  async_write.busy = false;
+  // Write what was not written synchronously, which also retries after an
+  // error such as -EAGAIN, or reports it in errno
+  size_t written = result > 0 ? result : 0;
+  if (written < async_write.size) {
+    WriteAt(async_write.fd, async_buffers_ + user_data * kBufferSize + written,
+            async_write.size - written, async_write.offset + written);
+  }
+  return true;
+}
+
+void LogWriter::WaitForAsyncIo() {
+  while (io_uring_ != nullptr && io_uring_->in_flight() != 0 &&
+         CompleteAsyncIo()) {
+  }
+}
+
+void LogWriter::Preallocate(int fd, size_t offset) {
+  if (offset >= max_file_size_) return;
+  if (!io_uring_->Fallocate(fd, FALLOC_FL_KEEP_SIZE, offset,
+                            max_file_size_ - offset, kFallocateOperation)) {
+    (void)fallocate(fd, FALLOC_FL_KEEP_SIZE, offset, max_file_size_ - offset);
+  }
+}
+
+void LogWriter::WriteAt(int fd, const char* bytes, size_t size,
+                        size_t offset) {
+  size_t bytes_written = 0;
+  while (bytes_written < size) {
+    ssize_t result = pwrite(fd, bytes + bytes_written, size - bytes_written,
+                            offset + bytes_written);
+    if (result < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) continue;
+      break;
+    }
+    bytes_written += result;
+  }
+}
+
+void LogWriter::PrepareNextFile() {
+  int fd;
+  do {
+    fd = open(next_log_file().c_str(), O_WRONLY | O_CLOEXEC | O_CREAT | O_TRUNC,
+              S_IRUSR | S_IWUSR | S_IRGRP);
+  } while (fd == -1 && errno == EINTR);
+  if (fd < 0) return;
+  next_fd_ = fd;
+  Preallocate(fd, 0);
+}
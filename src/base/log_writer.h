@@ -23,6 +23,10 @@
 #include <string>
 #include "base/macros.h"
 
+namespace base {
+class IoUring;
+}
+
 // This class is responsible for writing MDS log messages to disk, and rotating
 // the log file when it exceeds the maximum file size limit.
 class LogWriter {
@@ -44,17 +48,51 @@ class LogWriter {
   // file will be rotated if necessary. This method performs blocking file I/O.
   void Write(size_t size);
   void Write(const char* bytes, size_t size);
+  // Write the buffered log messages to the log file. With async I/O, also
+  // wait until all submitted writes have completed, so that the log messages
+  // are in the file when this method returns.
   void Flush();
   void RotateLog();
   void SetLogFile(const std::string& log_file) { log_file_ = log_file; }
   size_t file_size() const { return current_file_size_; }
+  // Submit the writes to the log file asynchronously with io_uring, so that
+  // Write() only waits for the disk when all kNoOfAsyncBuffers buffers are
+  // being written. The log file is preallocated with fallocate(), and the
+  // file used after the next rotation is created and preallocated when the
+  // log file is half full, so that rotating does not create the file.
+  // Return false, and keep writing synchronously, if io_uring is not
+  // available.
+  bool EnableAsyncIo();
 
  private:
   constexpr static const size_t kBufferSize = 128 * size_t{1024};
+  static const size_t kNoOfAsyncBuffers = 4;
+  // A write submitted from one of the async buffers
+  struct AsyncWrite {
+    bool busy;
+    int fd;
+    size_t offset;
+    size_t size;
+  };
   void Open();
   void Close();
+  // Write the current buffer to the log file, without waiting for the
+  // completion of an async write
+  void WriteBuffer();
+  // Submit the write of @a size bytes from the current buffer and switch to
+  // the next buffer, waiting until it is no longer being written.
+  void SubmitWrite(size_t size);
+  // Wait for one submitted operation and complete it. A failed or short
+  // write is completed synchronously. If waiting fails, the writes still in
+  // flight are done again synchronously and false is returned.
+  bool CompleteAsyncIo();
+  void WaitForAsyncIo();
+  void Preallocate(int fd, size_t offset);
+  void WriteAt(int fd, const char* bytes, size_t size, size_t offset);
+  void PrepareNextFile();
 
   std::string log_file(size_t backup) const;
+  std::string next_log_file() const { return log_file_ + ".next"; }
 
   std::string log_file_;
   int fd_;
@@ -63,6 +101,12 @@ class LogWriter {
   size_t max_backups_;
   size_t max_file_size_;
   char* buffer_;
+  base::IoUring* io_uring_;
+  char* async_buffers_;
+  size_t async_index_;
+  AsyncWrite async_writes_[kNoOfAsyncBuffers];
+  // The log file used after the next rotation, if created
+  int next_fd_;
 
   DELETE_COPY_AND_MOVE_OPERATORS(LogWriter);
 };
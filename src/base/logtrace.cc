@@ -28,6 +28,7 @@
 #include <time.h>
 #include <unistd.h>
 #include "base/getenv.h"
+#include "base/logtrace_binary.h"
 #include "base/logtrace_client.h"
 #include "base/logtrace_buffer.h"
 #include "base/ncsgl_defs.h"
@@ -46,12 +47,16 @@ size_t thread_trace_buffer_size = 0;
 
 }  // namespace global
 
+unsigned logtrace_active_mask = 0;
+
 // legacy tracing, trace is written by osaftransportd
 LogTraceClient* gl_remote_trace = nullptr;
 // direct osaf services logging to a configured file
 LogTraceClient* gl_remote_osaflog = nullptr;
 // local thread trace buffering
 LogTraceClient* gl_local_thread_trace = nullptr;
+// binary trace, replaces legacy tracing if enabled
+LogTraceBinary* gl_binary_trace = nullptr;
 
 std::once_flag init_flag;
 
@@ -60,6 +65,14 @@ thread_local LogTraceBuffer gl_thread_buffer{gl_local_thread_trace,
 
 static pid_t get_tid() { return syscall(SYS_gettid); }
 
+static void update_active_mask() {
+  unsigned mask = global::category_mask;
+  if (global::thread_trace_buffer_size > 0) {
+    mask |= (1 << CAT_TRACE_ENTER) | (1 << CAT_TRACE_LEAVE);
+  }
+  logtrace_active_mask = mask;
+}
+
 /**
  * USR2 signal handler to enable/disable trace (toggle)
  * @param sig
@@ -83,10 +96,22 @@ void trace_output(const char *file, unsigned line, unsigned priority,
   assert(priority <= LOG_DEBUG && category < CAT_MAX);
 
   if (strncmp(file, "src/", 4) == 0) file += 4;
+  // binary trace, the trace is formatted by the decoder
+  if (gl_binary_trace != nullptr) {
+    if (is_logtrace_enabled(category)) {
+      va_list ap2;
+      va_copy(ap2, ap);
+      gl_binary_trace->Write(file, line,
+                             global::prefix_name[priority + category], format,
+                             ap2);
+      va_end(ap2);
+    }
+    if (global::thread_trace_buffer_size == 0) return;
+  }
   snprintf(preamble, sizeof(preamble), "%d:%s:%u %s %s", get_tid(), file, line,
            global::prefix_name[priority + category], format);
   // legacy trace
-  if (is_logtrace_enabled(category)) {
+  if (gl_binary_trace == nullptr && is_logtrace_enabled(category)) {
     entry = LogTraceClient::Log(gl_remote_trace,
         static_cast<base::LogMessage::Severity>(priority), preamble, ap);
   }
@@ -197,8 +222,17 @@ static void logtrace_init_interal(const char *pathname, unsigned mask,
 
   // Initialize various type of logging instances based on
   // environment variables
+  if (result && base::GetEnv("TRACE_BINARY", uint32_t{0}) == 1) {
+    gl_binary_trace = new LogTraceBinary(global::msg_id);
+    if (!gl_binary_trace->is_open()) {
+      syslog(LOG_ERR, "logtrace: failed to open binary trace file for '%s'",
+             global::msg_id);
+      delete gl_binary_trace;
+      gl_binary_trace = nullptr;
+    }
+  }
   if (result && mask != 0) {
-    if (!gl_remote_trace) {
+    if (!gl_remote_trace && !gl_binary_trace) {
       gl_remote_trace = new LogTraceClient(global::msg_id,
           LogTraceClient::kRemoteBlocking);
     }
@@ -211,6 +245,7 @@ static void logtrace_init_interal(const char *pathname, unsigned mask,
           LogTraceClient::kLocalBuffer);
     }
   }
+  update_active_mask();
   if (base::GetEnv("OSAF_LOCAL_NODE_LOG", uint32_t{0}) == 1) {
     global::enable_osaf_log = true;
     if (!gl_remote_osaflog) {
@@ -266,11 +301,12 @@ int logtrace_init_daemon(const char *ident, const char *pathname,
 
 int trace_category_set(unsigned mask) {
   global::category_mask = mask;
+  update_active_mask();
 
   if (global::category_mask == 0) {
     syslog(LOG_INFO, "logtrace: trace disabled");
   } else {
-    if (!gl_remote_trace) {
+    if (!gl_remote_trace && !gl_binary_trace) {
       gl_remote_trace = new LogTraceClient(global::msg_id,
         LogTraceClient::kRemoteBlocking);
     }
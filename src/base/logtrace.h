@@ -29,6 +29,12 @@
  * the current mask setting and and-ed with the mask during filtering. Current
  * backend for tracing is file, in the future syslog could be used.
  * Filtering is done by the file back end.
+ *
+ * The TRACE macros test the category inline, the arguments of a disabled
+ * trace are not evaluated and no function is called. Categories can also be
+ * removed at compile time by defining LOGTRACE_COMPILED_CATEGORIES to a mask
+ * of the categories to keep, e.g. -DLOGTRACE_COMPILED_CATEGORIES=0x401 keeps
+ * only TRACE and TRACE_ENTER.
  */
 
 #ifndef BASE_LOGTRACE_H_
@@ -61,6 +67,10 @@ enum logtrace_categories {
 
 #define CATEGORY_ALL 0xffffffff
 
+#ifndef LOGTRACE_COMPILED_CATEGORIES
+#define LOGTRACE_COMPILED_CATEGORIES CATEGORY_ALL
+#endif
+
 /**
  * logtrace_init - Initialize the logtrace system.
  *
@@ -147,11 +157,23 @@ extern void logtrace_trace(const char *file, unsigned line, unsigned category,
     __attribute__((format(printf, 4, 5)));
 
 extern bool is_logtrace_enabled(unsigned category);
+
 extern void trace_output(const char *file, unsigned line, unsigned priority,
                             unsigned category, const char *format, va_list ap);
 extern void log_output(const char *file, unsigned line, unsigned priority,
                             unsigned category, const char *format, va_list ap);
 
+/* Categories for which logtrace_trace() must be called, i.e. the trace
+ * categories plus TRACE_ENTER/TRACE_LEAVE if the thread trace buffer is
+ * enabled. Updated by logtrace_init() and trace_category_set(). */
+extern unsigned logtrace_active_mask;
+
+#define LOGTRACE_ACTIVE(category)                                             \
+  __builtin_expect(                                                           \
+      (((unsigned)(LOGTRACE_COMPILED_CATEGORIES) & (1u << (category))) != 0)  \
+          && ((logtrace_active_mask & (1u << (category))) != 0),              \
+      0)
+
 /* LOG API. Use same levels as syslog */
 #define LOG_EM(format, args...) \
   logtrace_log(__FILE__, __LINE__, LOG_EMERG, (format), ##args)
@@ -169,24 +191,42 @@ extern void log_output(const char *file, unsigned line, unsigned priority,
   logtrace_log(__FILE__, __LINE__, LOG_INFO, (format), ##args)
 
 /* TRACE API. */
-#define TRACE(format, args...) \
-  logtrace_trace(__FILE__, __LINE__, CAT_TRACE, (format), ##args)
-#define TRACE_1(format, args...) \
-  logtrace_trace(__FILE__, __LINE__, CAT_TRACE1, (format), ##args)
-#define TRACE_2(format, args...) \
-  logtrace_trace(__FILE__, __LINE__, CAT_TRACE2, (format), ##args)
-#define TRACE_3(format, args...) \
-  logtrace_trace(__FILE__, __LINE__, CAT_TRACE3, (format), ##args)
-#define TRACE_4(format, args...) \
-  logtrace_trace(__FILE__, __LINE__, CAT_TRACE4, (format), ##args)
-#define TRACE_5(format, args...) \
-  logtrace_trace(__FILE__, __LINE__, CAT_TRACE5, (format), ##args)
-#define TRACE_6(format, args...) \
-  logtrace_trace(__FILE__, __LINE__, CAT_TRACE6, (format), ##args)
-#define TRACE_7(format, args...) \
-  logtrace_trace(__FILE__, __LINE__, CAT_TRACE7, (format), ##args)
-#define TRACE_8(format, args...) \
-  logtrace_trace(__FILE__, __LINE__, CAT_TRACE8, (format), ##args)
+#define TRACE(format, args...)                                                \
+  (LOGTRACE_ACTIVE(CAT_TRACE)                                                 \
+       ? logtrace_trace(__FILE__, __LINE__, CAT_TRACE, (format), ##args)      \
+       : (void)0)
+#define TRACE_1(format, args...)                                              \
+  (LOGTRACE_ACTIVE(CAT_TRACE1)                                                \
+       ? logtrace_trace(__FILE__, __LINE__, CAT_TRACE1, (format), ##args)     \
+       : (void)0)
+#define TRACE_2(format, args...)                                              \
+  (LOGTRACE_ACTIVE(CAT_TRACE2)                                                \
+       ? logtrace_trace(__FILE__, __LINE__, CAT_TRACE2, (format), ##args)     \
+       : (void)0)
+#define TRACE_3(format, args...)                                              \
+  (LOGTRACE_ACTIVE(CAT_TRACE3)                                                \
+       ? logtrace_trace(__FILE__, __LINE__, CAT_TRACE3, (format), ##args)     \
+       : (void)0)
+#define TRACE_4(format, args...)                                              \
+  (LOGTRACE_ACTIVE(CAT_TRACE4)                                                \
+       ? logtrace_trace(__FILE__, __LINE__, CAT_TRACE4, (format), ##args)     \
+       : (void)0)
+#define TRACE_5(format, args...)                                              \
+  (LOGTRACE_ACTIVE(CAT_TRACE5)                                                \
+       ? logtrace_trace(__FILE__, __LINE__, CAT_TRACE5, (format), ##args)     \
+       : (void)0)
+#define TRACE_6(format, args...)                                              \
+  (LOGTRACE_ACTIVE(CAT_TRACE6)                                                \
+       ? logtrace_trace(__FILE__, __LINE__, CAT_TRACE6, (format), ##args)     \
+       : (void)0)
+#define TRACE_7(format, args...)                                              \
+  (LOGTRACE_ACTIVE(CAT_TRACE7)                                                \
+       ? logtrace_trace(__FILE__, __LINE__, CAT_TRACE7, (format), ##args)     \
+       : (void)0)
+#define TRACE_8(format, args...)                                              \
+  (LOGTRACE_ACTIVE(CAT_TRACE8)                                                \
+       ? logtrace_trace(__FILE__, __LINE__, CAT_TRACE8, (format), ##args)     \
+       : (void)0)
 
 #ifdef __cplusplus
 
@@ -232,31 +272,48 @@ class Trace {
   const char *function_{nullptr};
 };
 
-#define TRACE_ENTER()                                                \
-  Trace t_(__FILE__, __FUNCTION__); \
-  t_.trace(__FILE__, __FUNCTION__, __LINE__, CAT_TRACE_ENTER, "%s ", \
+#define TRACE_ENTER()                                                         \
+  Trace t_(__FILE__, __FUNCTION__);                                           \
+  if (LOGTRACE_ACTIVE(CAT_TRACE_ENTER))                                       \
+  t_.trace(__FILE__, __FUNCTION__, __LINE__, CAT_TRACE_ENTER, "%s ",          \
            __FUNCTION__)
-#define TRACE_ENTER2(format, args...)                                        \
-  Trace t_(__FILE__, __FUNCTION__); \
-  t_.trace(__FILE__, __FUNCTION__, __LINE__, CAT_TRACE_ENTER, "%s: " format, \
+#define TRACE_ENTER2(format, args...)                                         \
+  Trace t_(__FILE__, __FUNCTION__);                                           \
+  if (LOGTRACE_ACTIVE(CAT_TRACE_ENTER))                                       \
+  t_.trace(__FILE__, __FUNCTION__, __LINE__, CAT_TRACE_ENTER, "%s: " format,  \
            __FUNCTION__, ##args)
 
-#define TRACE_LEAVE() \
-  t_.trace_leave(__FILE__, __LINE__, CAT_TRACE_LEAVE, "%s ", __FUNCTION__)
-#define TRACE_LEAVE2(format, args...)                                \
-  t_.trace_leave(__FILE__, __LINE__, CAT_TRACE_LEAVE, "%s: " format, \
-                 __FUNCTION__, ##args)
+#define TRACE_LEAVE()                                                         \
+  (LOGTRACE_ACTIVE(CAT_TRACE_LEAVE)                                           \
+       ? t_.trace_leave(__FILE__, __LINE__, CAT_TRACE_LEAVE, "%s ",           \
+                        __FUNCTION__)                                         \
+       : (void)0)
+#define TRACE_LEAVE2(format, args...)                                         \
+  (LOGTRACE_ACTIVE(CAT_TRACE_LEAVE)                                           \
+       ? t_.trace_leave(__FILE__, __LINE__, CAT_TRACE_LEAVE, "%s: " format,   \
+                        __FUNCTION__, ##args)                                 \
+       : (void)0)
 #else
-#define TRACE_ENTER() \
-  logtrace_trace(__FILE__, __LINE__, CAT_TRACE_ENTER, "%s ", __FUNCTION__)
-#define TRACE_ENTER2(format, args...)                                \
-  logtrace_trace(__FILE__, __LINE__, CAT_TRACE_ENTER, "%s: " format, \
-                 __FUNCTION__, ##args)
-#define TRACE_LEAVE() \
-  logtrace_trace(__FILE__, __LINE__, CAT_TRACE_LEAVE, "%s ", __FUNCTION__)
-#define TRACE_LEAVE2(format, args...)                                \
-  logtrace_trace(__FILE__, __LINE__, CAT_TRACE_LEAVE, "%s: " format, \
-                 __FUNCTION__, ##args)
+#define TRACE_ENTER()                                                         \
+  (LOGTRACE_ACTIVE(CAT_TRACE_ENTER)                                           \
+       ? logtrace_trace(__FILE__, __LINE__, CAT_TRACE_ENTER, "%s ",           \
+                        __FUNCTION__)                                         \
+       : (void)0)
+#define TRACE_ENTER2(format, args...)                                         \
+  (LOGTRACE_ACTIVE(CAT_TRACE_ENTER)                                           \
+       ? logtrace_trace(__FILE__, __LINE__, CAT_TRACE_ENTER,                  \
+                        "%s: " format, __FUNCTION__, ##args)                  \
+       : (void)0)
+#define TRACE_LEAVE()                                                         \
+  (LOGTRACE_ACTIVE(CAT_TRACE_LEAVE)                                           \
+       ? logtrace_trace(__FILE__, __LINE__, CAT_TRACE_LEAVE, "%s ",           \
+                        __FUNCTION__)                                         \
+       : (void)0)
+#define TRACE_LEAVE2(format, args...)                                         \
+  (LOGTRACE_ACTIVE(CAT_TRACE_LEAVE)                                           \
+       ? logtrace_trace(__FILE__, __LINE__, CAT_TRACE_LEAVE,                  \
+                        "%s: " format, __FUNCTION__, ##args)                  \
+       : (void)0)
 #endif
 
 #ifdef __cplusplus
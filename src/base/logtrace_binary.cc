@@ -0,0 +1,576 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+#include "base/logtrace_binary.h"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include "base/getenv.h"
+#include "osaf/configmake.h"
+
+namespace {
+
+// Record types, a record starts with a RecordHeader
+enum RecordType : uint32_t {
+  // Written when the file is opened: magic, pid and name. Call site ids are
+  // only valid until the next start record.
+  kStart = 1,
+  // Call site id, line, prefix, file and format
+  kCallSite = 2,
+  // Call site id, thread id, time and the arguments
+  kTrace = 3
+};
+
+struct RecordHeader {
+  uint32_t size;
+  uint32_t type;
+};
+
+const char kMagic[8] = {'O', 'S', 'A', 'F', 'B', 'T', 'R', '1'};
+const size_t kMaxRecordSize = 4096;
+const size_t kMaxCallSiteSize = 64 * 1024;
+
+using ArgType = LogTraceBinary::ArgType;
+using Conversion = LogTraceBinary::Conversion;
+
+class RecordBuffer {
+ public:
+  explicit RecordBuffer(RecordType type) : size_{sizeof(RecordHeader)} {
+    RecordHeader header{0, type};
+    memcpy(buffer_, &header, sizeof(header));
+  }
+  // Return false, and append nothing, if the record is full
+  bool Append(const void* data, size_t size) {
+    if (size_ + size > sizeof(buffer_)) return false;
+    memcpy(buffer_ + size_, data, size);
+    size_ += size;
+    return true;
+  }
+  template <typename T>
+  bool Append(T value) {
+    return Append(&value, sizeof(value));
+  }
+  // Append a string argument, truncated to fit
+  bool AppendString(const char* str) {
+    if (str == nullptr) str = "(null)";
+    size_t length = strnlen(str, LogTraceBinary::kMaxStringLength);
+    if (size_ + sizeof(uint16_t) > sizeof(buffer_)) return false;
+    length = std::min(length, sizeof(buffer_) - size_ - sizeof(uint16_t));
+    Append(static_cast<uint16_t>(length));
+    return Append(str, length);
+  }
+  const char* Finish() {
+    uint32_t size = size_;
+    memcpy(buffer_, &size, sizeof(size));
+    return buffer_;
+  }
+  size_t size() const { return size_; }
+
+ private:
+  char buffer_[kMaxRecordSize];
+  size_t size_;
+};
+
+// Read the payload of the next record, return the record type or 0 at end of
+// file or if the record is corrupt
+uint32_t ReadRecord(FILE* input, std::vector<char>* payload) {
+  RecordHeader header;
+  if (fread(&header, sizeof(header), 1, input) != 1) return 0;
+  if (header.size < sizeof(header) || header.size > kMaxCallSiteSize) return 0;
+  payload->resize(header.size - sizeof(header));
+  if (!payload->empty() &&
+      fread(payload->data(), payload->size(), 1, input) != 1) {
+    return 0;
+  }
+  return header.type;
+}
+
+class PayloadReader {
+ public:
+  explicit PayloadReader(const std::vector<char>& payload)
+      : data_{payload.data()}, size_{payload.size()}, offset_{0} {}
+  template <typename T>
+  bool Read(T* value) {
+    if (offset_ + sizeof(T) > size_) return false;
+    memcpy(value, data_ + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+  // Read a NUL terminated string
+  bool ReadCString(std::string* value) {
+    const void* end = memchr(data_ + offset_, '\0', size_ - offset_);
+    if (end == nullptr) return false;
+    value->assign(data_ + offset_, static_cast<const char*>(end));
+    offset_ += value->size() + 1;
+    return true;
+  }
+  // Read a string argument
+  bool ReadString(std::string* value) {
+    uint16_t length;
+    if (!Read(&length) || offset_ + length > size_) return false;
+    value->assign(data_ + offset_, length);
+    offset_ += length;
+    return true;
+  }
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t offset_;
+};
+
+// Format one argument with the conversion specification `spec`, which is
+// taken from the call site's format string
+int FormatArgument(char* buffer, size_t size, const char* spec, ...) {
+  va_list ap;
+  va_start(ap, spec);
+  int result = vsnprintf(buffer, size, spec, ap);
+  va_end(ap);
+  return result;
+}
+
+template <typename T>
+void AppendFormatted(std::string* output, const std::string& spec,
+                     const int* stars, int num_stars, T value) {
+  char buffer[1024];
+  int size;
+  if (num_stars == 0) {
+    size = FormatArgument(buffer, sizeof(buffer), spec.c_str(), value);
+  } else if (num_stars == 1) {
+    size = FormatArgument(buffer, sizeof(buffer), spec.c_str(), stars[0],
+                          value);
+  } else {
+    size = FormatArgument(buffer, sizeof(buffer), spec.c_str(), stars[0],
+                          stars[1], value);
+  }
+  if (size > 0) {
+    output->append(buffer,
+                   std::min(static_cast<size_t>(size), sizeof(buffer) - 1));
+  }
+}
+
+// Format the arguments of a trace record with `format`. Conversions without
+// arguments in the record, e.g. of a truncated record, are left as they are.
+std::string FormatTrace(const std::string& format, PayloadReader* reader) {
+  std::string output;
+  const char* p = format.c_str();
+  while (*p != '\0') {
+    const char* percent = strchr(p, '%');
+    if (percent == nullptr) {
+      output.append(p);
+      break;
+    }
+    output.append(p, percent);
+    Conversion conversion = LogTraceBinary::ParseConversion(percent);
+    const std::string spec{conversion.begin, conversion.end};
+    p = conversion.end;
+    if (conversion.type == ArgType::kNone) {
+      output.push_back('%');
+      continue;
+    }
+    int stars[2] = {0, 0};
+    int64_t star_value = 0;
+    bool ok = conversion.type != ArgType::kUnsupported;
+    for (int i = 0; ok && i < conversion.stars; ++i) {
+      ok = reader->Read(&star_value);
+      stars[i] = star_value;
+    }
+    int64_t int_value;
+    double double_value;
+    std::string string_value;
+    switch (ok ? conversion.type : ArgType::kUnsupported) {
+      case ArgType::kInt:
+        if (!(ok = reader->Read(&int_value))) break;
+        switch (conversion.length) {
+          case 'l':
+            AppendFormatted(&output, spec, stars, conversion.stars,
+                            static_cast<long>(int_value));
+            break;
+          case 'q':
+          case 'L':
+            AppendFormatted(&output, spec, stars, conversion.stars,
+                            static_cast<long long>(int_value));
+            break;
+          case 'j':
+            AppendFormatted(&output, spec, stars, conversion.stars,
+                            static_cast<intmax_t>(int_value));
+            break;
+          case 'z':
+          case 'Z':
+            AppendFormatted(&output, spec, stars, conversion.stars,
+                            static_cast<size_t>(int_value));
+            break;
+          case 't':
+            AppendFormatted(&output, spec, stars, conversion.stars,
+                            static_cast<ptrdiff_t>(int_value));
+            break;
+          default:
+            AppendFormatted(&output, spec, stars, conversion.stars,
+                            static_cast<int>(int_value));
+            break;
+        }
+        break;
+      case ArgType::kDouble:
+        if (!(ok = reader->Read(&double_value))) break;
+        if (conversion.length == 'L') {
+          AppendFormatted(&output, spec, stars, conversion.stars,
+                          static_cast<long double>(double_value));
+        } else {
+          AppendFormatted(&output, spec, stars, conversion.stars,
+                          double_value);
+        }
+        break;
+      case ArgType::kString:
+        if (!(ok = reader->ReadString(&string_value))) break;
+        AppendFormatted(&output, spec, stars, conversion.stars,
+                        string_value.c_str());
+        break;
+      case ArgType::kPointer:
+        if (!(ok = reader->Read(&int_value))) break;
+        AppendFormatted(&output, spec, stars, conversion.stars,
+                        reinterpret_cast<void*>(int_value));
+        break;
+      case ArgType::kErrno:
+        if (!(ok = reader->ReadString(&string_value))) break;
+        output.append(string_value);
+        break;
+      default:
+        ok = false;
+        break;
+    }
+    if (!ok) {
+      output.append(spec);
+      output.append(p);
+      break;
+    }
+  }
+  return output;
+}
+
+}  // namespace
+
+thread_local LogTraceBinary::IdCache LogTraceBinary::id_cache_;
+
+LogTraceBinary::Conversion LogTraceBinary::ParseConversion(const char* p) {
+  Conversion conversion{p, p + 1, 0, 0, ArgType::kUnsupported};
+  const char* q = p + 1;
+  if (*q == '%') {
+    conversion.type = ArgType::kNone;
+    conversion.end = q + 1;
+    return conversion;
+  }
+  while (*q != '\0' && strchr("-+ #0'I", *q) != nullptr) ++q;
+  for (int i = 0; i < 2; ++i) {
+    if (*q == '*') {
+      ++conversion.stars;
+      ++q;
+    } else {
+      while (*q >= '0' && *q <= '9') ++q;
+      if (*q == '$') return conversion;
+    }
+    if (i == 0 && *q == '.') {
+      ++q;
+    } else {
+      break;
+    }
+  }
+  switch (*q) {
+    case 'h':
+      conversion.length = (q[1] == 'h') ? 'H' : 'h';
+      break;
+    case 'l':
+      conversion.length = (q[1] == 'l') ? 'q' : 'l';
+      break;
+    case 'q':
+    case 'L':
+    case 'j':
+    case 'z':
+    case 'Z':
+    case 't':
+      conversion.length = *q;
+      break;
+    default:
+      break;
+  }
+  if (conversion.length == 'H' || conversion.length == 'q') {
+    q += (*q == 'q') ? 1 : 2;
+  } else if (conversion.length != 0) {
+    ++q;
+  }
+  if (*q == '\0') {
+    conversion.end = q;
+    return conversion;
+  }
+  conversion.end = q + 1;
+  if (strchr("diouxXc", *q) != nullptr) {
+    conversion.type = ArgType::kInt;
+  } else if (strchr("eEfFgGaA", *q) != nullptr) {
+    conversion.type = ArgType::kDouble;
+  } else if (*q == 's' && conversion.length == 0) {
+    conversion.type = ArgType::kString;
+  } else if (*q == 'p') {
+    conversion.type = ArgType::kPointer;
+  } else if (*q == 'm') {
+    conversion.type = ArgType::kErrno;
+  }
+  return conversion;
+}
+
+LogTraceBinary::LogTraceBinary(const char* name)
+    : name_{name},
+      file_name_{base::GetEnv<std::string>("pkglogdir", PKGLOGDIR) + "/" +
+                 name + ".bin"},
+      fd_{-1},
+      next_id_{1},
+      generation_{1},
+      file_size_{0} {
+  fd_ = Open(O_APPEND);
+  if (fd_ == -1) return;
+  struct stat statbuf;
+  if (fstat(fd_, &statbuf) == 0) file_size_ = statbuf.st_size;
+  WriteStart();
+}
+
+LogTraceBinary::~LogTraceBinary() {
+  if (fd_ != -1) close(fd_);
+}
+
+int LogTraceBinary::Open(int flags) {
+  int fd;
+  do {
+    fd = open(file_name_.c_str(), O_WRONLY | O_CLOEXEC | O_CREAT | flags,
+              S_IRUSR | S_IWUSR | S_IRGRP);
+  } while (fd == -1 && errno == EINTR);
+  return fd;
+}
+
+void LogTraceBinary::WriteStart() {
+  RecordBuffer record{kStart};
+  record.Append(kMagic, sizeof(kMagic));
+  record.Append(static_cast<uint32_t>(getpid()));
+  record.Append(name_.c_str(), name_.size() + 1);
+  WriteRecord(record.Finish(), record.size());
+}
+
+void LogTraceBinary::Rotate() {
+  if (rename(file_name_.c_str(), (file_name_ + ".1").c_str()) == -1) return;
+  int fd = Open(O_APPEND | O_TRUNC);
+  if (fd == -1) return;
+  // Keep the file descriptor, threads may be writing to it
+  dup2(fd, fd_);
+  close(fd);
+  file_size_ = 0;
+  ids_.clear();
+  ++generation_;
+  WriteStart();
+}
+
+void LogTraceBinary::WriteRecord(const char* record, size_t size) {
+  ssize_t result;
+  do {
+    result = write(fd_, record, size);
+  } while (result == -1 && errno == EINTR);
+  if (result > 0) file_size_ += result;
+}
+
+uint32_t LogTraceBinary::GetId(const CallSite& site, const char* prefix) {
+  uint32_t generation = generation_;
+  if (id_cache_.generation != generation) {
+    id_cache_.ids.clear();
+    id_cache_.generation = generation;
+  }
+  auto it = id_cache_.ids.find(site);
+  if (it != id_cache_.ids.end()) return it->second;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint32_t id;
+  auto global_it = ids_.find(site);
+  if (global_it != ids_.end()) {
+    id = global_it->second;
+  } else {
+    id = next_id_++;
+    std::string record(sizeof(RecordHeader), '\0');
+    record.append(reinterpret_cast<const char*>(&id), sizeof(id));
+    uint32_t line = site.line;
+    record.append(reinterpret_cast<const char*>(&line), sizeof(line));
+    record.append(prefix, strlen(prefix) + 1);
+    record.append(site.file, strlen(site.file) + 1);
+    record.append(site.format,
+                  strnlen(site.format, kMaxCallSiteSize - record.size() - 1));
+    record.push_back('\0');
+    RecordHeader header{static_cast<uint32_t>(record.size()), kCallSite};
+    memcpy(&record[0], &header, sizeof(header));
+    WriteRecord(record.data(), record.size());
+    ids_.emplace(site, id);
+  }
+  // Not cached if the file was rotated meanwhile
+  if (generation_ == id_cache_.generation) id_cache_.ids.emplace(site, id);
+  return id;
+}
+
+void LogTraceBinary::Write(const char* file, unsigned line, const char* prefix,
+                           const char* format, va_list ap) {
+  if (fd_ == -1) return;
+  int saved_errno = errno;
+  struct timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+
+  RecordBuffer record{kTrace};
+  record.Append(GetId(CallSite{file, line, format}, prefix));
+  record.Append(static_cast<uint32_t>(syscall(SYS_gettid)));
+  record.Append(static_cast<int64_t>(now.tv_sec));
+  record.Append(static_cast<int64_t>(now.tv_nsec));
+
+  bool ok = true;
+  const char* p = format;
+  while (ok && (p = strchr(p, '%')) != nullptr) {
+    Conversion conversion = ParseConversion(p);
+    p = conversion.end;
+    for (int i = 0; ok && i < conversion.stars; ++i) {
+      ok = record.Append(static_cast<int64_t>(va_arg(ap, int)));
+    }
+    if (!ok) break;
+    int64_t value;
+    switch (conversion.type) {
+      case ArgType::kNone:
+        break;
+      case ArgType::kInt:
+        switch (conversion.length) {
+          case 'l':
+            value = va_arg(ap, long);
+            break;
+          case 'q':
+          case 'L':
+            value = va_arg(ap, long long);
+            break;
+          case 'j':
+            value = va_arg(ap, intmax_t);
+            break;
+          case 'z':
+          case 'Z':
+            value = va_arg(ap, size_t);
+            break;
+          case 't':
+            value = va_arg(ap, ptrdiff_t);
+            break;
+          default:
+            value = va_arg(ap, int);
+            break;
+        }
+        ok = record.Append(value);
+        break;
+      case ArgType::kDouble:
+        if (conversion.length == 'L') {
+          ok = record.Append(static_cast<double>(va_arg(ap, long double)));
+        } else {
+          ok = record.Append(va_arg(ap, double));
+        }
+        break;
+      case ArgType::kString:
+        ok = record.AppendString(va_arg(ap, const char*));
+        break;
+      case ArgType::kPointer:
+        ok = record.Append(reinterpret_cast<int64_t>(va_arg(ap, void*)));
+        break;
+      case ArgType::kErrno:
+        ok = record.AppendString(strerror(saved_errno));
+        break;
+      default:
+        ok = false;
+        break;
+    }
+  }
+  WriteRecord(record.Finish(), record.size());
+
+  if (file_size_ > kMaxFileSize) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_size_ > kMaxFileSize) Rotate();
+  }
+  errno = saved_errno;
+}
+
+bool LogTraceBinary::Decode(FILE* input, FILE* output) {
+  struct CallSiteInfo {
+    uint32_t line;
+    std::string prefix;
+    std::string file;
+    std::string format;
+  };
+  std::unordered_map<uint32_t, CallSiteInfo> call_sites;
+  std::vector<char> payload;
+  std::string name;
+  uint32_t pid = 0;
+  bool started = false;
+  uint32_t type;
+
+  while ((type = ReadRecord(input, &payload)) != 0) {
+    PayloadReader reader{payload};
+    if (type == kStart) {
+      char magic[sizeof(kMagic)];
+      if (!reader.Read(&magic) || memcmp(magic, kMagic, sizeof(magic)) != 0 ||
+          !reader.Read(&pid) || !reader.ReadCString(&name)) {
+        return false;
+      }
+      call_sites.clear();
+      started = true;
+    } else if (!started) {
+      return false;
+    } else if (type == kCallSite) {
+      uint32_t id;
+      CallSiteInfo info;
+      if (!reader.Read(&id) || !reader.Read(&info.line) ||
+          !reader.ReadCString(&info.prefix) ||
+          !reader.ReadCString(&info.file) ||
+          !reader.ReadCString(&info.format)) {
+        return false;
+      }
+      call_sites[id] = std::move(info);
+    } else if (type == kTrace) {
+      uint32_t id;
+      uint32_t tid;
+      int64_t sec;
+      int64_t nsec;
+      if (!reader.Read(&id) || !reader.Read(&tid) || !reader.Read(&sec) ||
+          !reader.Read(&nsec)) {
+        return false;
+      }
+      time_t seconds = sec;
+      struct tm tm_time;
+      char time_string[32];
+      localtime_r(&seconds, &tm_time);
+      strftime(time_string, sizeof(time_string), "%Y-%m-%d %H:%M:%S",
+               &tm_time);
+      fprintf(output, "%s.%06ld %s[%u] ", time_string,
+              static_cast<long>(nsec / 1000), name.c_str(), pid);
+      auto it = call_sites.find(id);
+      if (it == call_sites.end()) {
+        // The call site was written to the previous file
+        fprintf(output, "%u: unknown call site %u\n", tid, id);
+        continue;
+      }
+      const CallSiteInfo& info = it->second;
+      fprintf(output, "%u:%s:%u %s %s\n", tid, info.file.c_str(), info.line,
+              info.prefix.c_str(), FormatTrace(info.format, &reader).c_str());
+    }
+  }
+  return started && feof(input);
+}
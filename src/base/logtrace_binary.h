@@ -0,0 +1,119 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+#ifndef BASE_LOGTRACE_BINARY_H_
+#define BASE_LOGTRACE_BINARY_H_
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "base/macros.h"
+
+// Binary trace, enabled with the TRACE_BINARY environment variable.
+//
+// Instead of formatting a trace and sending it to osaftransportd, the trace is
+// written to the file <pkglogdir>/<name>.bin as the id of the trace call site
+// followed by the raw arguments. The file name, line and format string of a
+// call site are written once, the first time it is traced. The trace is
+// formatted offline by the decoder, see "osaflog --decode-trace".
+//
+// The file is written in host byte order and must be decoded on a node with
+// the same architecture. When the file exceeds kMaxFileSize it is renamed to
+// <name>.bin.1, replacing the previous one.
+class LogTraceBinary {
+ public:
+  static const size_t kMaxFileSize = 10 * 1024 * 1024;
+  // Max length of a string argument, longer strings are truncated
+  static const size_t kMaxStringLength = 512;
+  explicit LogTraceBinary(const char* name);
+  ~LogTraceBinary();
+  bool is_open() const { return fd_ != -1; }
+  // Write one trace, `format` and `ap` as passed to trace_output()
+  void Write(const char* file, unsigned line, const char* prefix,
+             const char* format, va_list ap);
+  // Write the traces in the binary trace file `input` as text to `output`.
+  // Return false if `input` is not a binary trace file or is corrupt.
+  static bool Decode(FILE* input, FILE* output);
+
+  enum class ArgType {
+    kNone,  // "%%"
+    kInt,
+    kDouble,
+    kString,
+    kPointer,
+    kErrno,  // "%m", strerror(errno)
+    kUnsupported
+  };
+  // A printf conversion specification
+  struct Conversion {
+    const char* begin;
+    const char* end;
+    // Number of '*' width and precision arguments
+    int stars;
+    // Length modifier, 0 if none. 'H' for "hh" and 'q' for "ll"
+    char length;
+    ArgType type;
+  };
+  // Parse the conversion specification starting at the '%' `p`. Positional
+  // arguments and wide strings are not supported.
+  static Conversion ParseConversion(const char* p);
+
+ private:
+  struct CallSite {
+    const char* file;
+    unsigned line;
+    const char* format;
+    bool operator==(const CallSite& other) const {
+      return file == other.file && line == other.line &&
+             format == other.format;
+    }
+  };
+  struct CallSiteHash {
+    size_t operator()(const CallSite& site) const {
+      return std::hash<const void*>()(site.format) ^
+             std::hash<const void*>()(site.file) ^ site.line;
+    }
+  };
+  using CallSiteMap = std::unordered_map<CallSite, uint32_t, CallSiteHash>;
+  // Call site ids already looked up by the thread, avoids taking the mutex
+  struct IdCache {
+    uint32_t generation{0};
+    CallSiteMap ids;
+  };
+  int Open(int flags);
+  uint32_t GetId(const CallSite& site, const char* prefix);
+  void WriteStart();
+  void Rotate();
+  void WriteRecord(const char* record, size_t size);
+
+  static thread_local IdCache id_cache_;
+  const std::string name_;
+  const std::string file_name_;
+  int fd_;
+  // Protects the call site ids and rotation
+  std::mutex mutex_;
+  CallSiteMap ids_;
+  uint32_t next_id_;
+  // Incremented when the file is rotated, the ids are then written again
+  std::atomic<uint32_t> generation_;
+  std::atomic<size_t> file_size_;
+  DELETE_COPY_AND_MOVE_OPERATORS(LogTraceBinary);
+};
+
+#endif  // BASE_LOGTRACE_BINARY_H_
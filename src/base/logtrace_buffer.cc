@@ -22,6 +22,7 @@
 #include <cstdio>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <thread>
 
 LogTraceBuffer::LogTraceBuffer(LogTraceClient* owner, size_t buffer_size) :
@@ -34,7 +35,8 @@ LogTraceBuffer::LogTraceBuffer(LogTraceClient* owner, size_t buffer_size) :
   if (buffer_size_ > 0) {
     std::string log_file_name;
     tid_ = syscall(SYS_gettid);
-    vector_.resize(buffer_size_);
+    slots_.resize(buffer_size_ * kSlotSize);
+    lengths_.resize(buffer_size_);
     if (owner_) {
       owner_->AddExternalBuffer(tid_, this);
       log_file_name = std::string(owner_->app_name()) + "_" + owner_->proc_id()
@@ -54,15 +56,20 @@ LogTraceBuffer::~LogTraceBuffer() {
   delete log_writer_;
 }
 
-void LogTraceBuffer::WriteToBuffer(std::string trace) {
-  size_t length = trace.length();
-  if (length > kMaxTraceString) length = kMaxTraceString;
-  vector_[index_] = std::string(kLogTraceString) +
-      std::string(trace.c_str(), length);
-  length = vector_[index_].length();
-  if (trace.at(trace.length() - 1) != '\n') {
-    vector_[index_].replace(length - 1, 1, "\n");
+void LogTraceBuffer::WriteToBuffer(const char* trace) {
+  static const size_t kHeaderSize = strlen(kLogTraceString);
+  if (buffer_size_ == 0) return;
+  char* slot = &slots_[index_ * kSlotSize];
+  size_t length = strnlen(trace, kMaxTraceString);
+  memcpy(slot, kLogTraceString, kHeaderSize);
+  memcpy(slot + kHeaderSize, trace, length);
+  length += kHeaderSize;
+  // Each trace is one line, see ExtractTrace() in osaflog
+  if (slot[length - 1] != '\n') {
+    if (length == kSlotSize) --length;
+    slot[length++] = '\n';
   }
+  lengths_[index_] = length;
   if (++index_ == buffer_size_) index_ = 0;
   if (flush_required_) FlushBuffer();
 }
@@ -72,21 +79,19 @@ void LogTraceBuffer::RequestFlush() {
 }
 
 bool LogTraceBuffer::FlushBuffer() {
-  size_t i;
-  // flushing the right half first
-  for (i = index_ ; i < buffer_size_ ; i++) {
-    if (vector_[i].length() > 0) {
-      log_writer_->Write(vector_[i].c_str(), vector_[i].length());
-      vector_[i] = "";
+  if (buffer_size_ == 0) return true;
+  size_t i = index_;
+  // flushing the oldest trace first
+  do {
+    if (lengths_[i] > 0) {
+      char* slot = &slots_[i * kSlotSize];
+      log_writer_->Write(slot, lengths_[i]);
+      // Remove the header, the trace is not extracted from a coredump
+      slot[0] = '\0';
+      lengths_[i] = 0;
     }
-  }
-  // flushing the left half second
-  for (i = 0 ; i < index_ ; i++) {
-    if (vector_[i].length() > 0) {
-      log_writer_->Write(vector_[i].c_str(), vector_[i].length());
-      vector_[i] = "";
-    }
-  }
+    if (++i == buffer_size_) i = 0;
+  } while (i != index_);
   log_writer_->Flush();
   flush_required_ = false;
   return true;
@@ -16,6 +16,7 @@
 #ifndef BASE_LOGTRACE_BUFFER_H_
 #define BASE_LOGTRACE_BUFFER_H_
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <list>
@@ -28,6 +29,12 @@
 class LogTraceClient;
 // A class implements a buffer which is written in circular fashion
 // This buffer is attached to its owner which is a LogTraceClient
+//
+// The buffer is one allocation of @buffer_size_ fixed size slots, made when
+// the thread's buffer is created. A trace is copied to the next slot after
+// the kLogTraceString header, so writing a trace never allocates memory.
+// Slots that are empty or flushed have no header, only traces that are not
+// flushed are found in a coredump.
 
 class LogTraceBuffer {
  public:
@@ -39,9 +46,11 @@ class LogTraceBuffer {
   constexpr static const char* kLogTraceString = "1qaz2wsx";
   // Maximum characters per trace string
   static const uint32_t kMaxTraceString = 256 - strlen(kLogTraceString);
+  // Size of a slot, the header followed by the trace string
+  static const size_t kSlotSize = 256;
   LogTraceBuffer(LogTraceClient* owner, size_t buffer_size);
   ~LogTraceBuffer();
-  void WriteToBuffer(std::string trace);
+  void WriteToBuffer(const char* trace);
   bool FlushBuffer();
   void RequestFlush();
   void SetFlush(const bool flush) { flush_required_ = flush; }
@@ -51,7 +60,10 @@ class LogTraceBuffer {
   const size_t buffer_size_;
   size_t index_;
   int64_t tid_;
-  std::vector<std::string> vector_;
+  // @buffer_size_ slots of kSlotSize bytes
+  std::vector<char> slots_;
+  // Length of the header and trace in each slot, 0 if empty
+  std::vector<uint16_t> lengths_;
   LogWriter* log_writer_;
   bool flush_required_;
   DELETE_COPY_AND_MOVE_OPERATORS(LogTraceBuffer);
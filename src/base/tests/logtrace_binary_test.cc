@@ -0,0 +1,285 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "base/logtrace_binary.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using Conversion = LogTraceBinary::Conversion;
+using ArgType = LogTraceBinary::ArgType;
+
+// The length of the parsed conversion specification
+size_t SpecLength(const Conversion& conversion) {
+  return conversion.end - conversion.begin;
+}
+
+// Binary trace files in a directory of their own, see pkglogdir
+class LogTraceBinaryTest : public ::testing::Test {
+ protected:
+  LogTraceBinaryTest() {
+    char dir[] = "/tmp/logtrace_binary_testXXXXXX";
+    EXPECT_NE(mkdtemp(dir), nullptr);
+    dir_ = dir;
+    setenv("pkglogdir", dir_.c_str(), 1);
+  }
+
+  ~LogTraceBinaryTest() {
+    unlink(FileName().c_str());
+    unlink((FileName() + ".1").c_str());
+    rmdir(dir_.c_str());
+    unsetenv("pkglogdir");
+  }
+
+  std::string FileName() const { return dir_ + "/test.bin"; }
+
+  static void Trace(LogTraceBinary* trace, unsigned line, const char* format,
+                    ...) {
+    va_list ap;
+    va_start(ap, format);
+    trace->Write(__FILE__, line, ">>", format, ap);
+    va_end(ap);
+  }
+
+  // Decode a binary trace file, the lines without time, process and thread
+  bool Decode(const std::string& file_name, std::vector<std::string>* lines) {
+    FILE* input = fopen(file_name.c_str(), "r");
+    if (input == nullptr) return false;
+    char* text = nullptr;
+    size_t size = 0;
+    FILE* output = open_memstream(&text, &size);
+    bool result = LogTraceBinary::Decode(input, output);
+    fclose(output);
+    fclose(input);
+    std::string decoded{text, size};
+    free(text);
+    size_t begin = 0;
+    size_t end;
+    while ((end = decoded.find('\n', begin)) != std::string::npos) {
+      std::string line = decoded.substr(begin, end - begin);
+      // "<date> <time> test[<pid>] <tid>:<file>:<line> <prefix> <trace>"
+      size_t pos = line.find(' ', line.find(' ') + 1);
+      pos = line.find(' ', pos + 1);
+      pos = line.find(':', pos + 1);
+      lines->push_back(line.substr(pos + 1));
+      begin = end + 1;
+    }
+    return result;
+  }
+
+  std::string dir_;
+};
+
+}  // namespace
+
+TEST(LogTraceBinaryParseConversion, Percent) {
+  Conversion conversion = LogTraceBinary::ParseConversion("%%d");
+  EXPECT_EQ(conversion.type, ArgType::kNone);
+  EXPECT_EQ(SpecLength(conversion), 2u);
+}
+
+TEST(LogTraceBinaryParseConversion, Integers) {
+  Conversion conversion = LogTraceBinary::ParseConversion("%d, next");
+  EXPECT_EQ(conversion.type, ArgType::kInt);
+  EXPECT_EQ(conversion.length, 0);
+  EXPECT_EQ(SpecLength(conversion), 2u);
+
+  conversion = LogTraceBinary::ParseConversion("%-08lx");
+  EXPECT_EQ(conversion.type, ArgType::kInt);
+  EXPECT_EQ(conversion.length, 'l');
+  EXPECT_EQ(SpecLength(conversion), 6u);
+
+  conversion = LogTraceBinary::ParseConversion("%llu");
+  EXPECT_EQ(conversion.type, ArgType::kInt);
+  EXPECT_EQ(conversion.length, 'q');
+  EXPECT_EQ(SpecLength(conversion), 4u);
+
+  conversion = LogTraceBinary::ParseConversion("%hhd");
+  EXPECT_EQ(conversion.type, ArgType::kInt);
+  EXPECT_EQ(conversion.length, 'H');
+
+  conversion = LogTraceBinary::ParseConversion("%zu");
+  EXPECT_EQ(conversion.type, ArgType::kInt);
+  EXPECT_EQ(conversion.length, 'z');
+
+  conversion = LogTraceBinary::ParseConversion("%c");
+  EXPECT_EQ(conversion.type, ArgType::kInt);
+}
+
+TEST(LogTraceBinaryParseConversion, OtherTypes) {
+  Conversion conversion = LogTraceBinary::ParseConversion("%.2f");
+  EXPECT_EQ(conversion.type, ArgType::kDouble);
+  EXPECT_EQ(SpecLength(conversion), 4u);
+
+  conversion = LogTraceBinary::ParseConversion("%Lg");
+  EXPECT_EQ(conversion.type, ArgType::kDouble);
+  EXPECT_EQ(conversion.length, 'L');
+
+  conversion = LogTraceBinary::ParseConversion("%s");
+  EXPECT_EQ(conversion.type, ArgType::kString);
+
+  conversion = LogTraceBinary::ParseConversion("%p");
+  EXPECT_EQ(conversion.type, ArgType::kPointer);
+
+  conversion = LogTraceBinary::ParseConversion("%m");
+  EXPECT_EQ(conversion.type, ArgType::kErrno);
+}
+
+TEST(LogTraceBinaryParseConversion, Stars) {
+  Conversion conversion = LogTraceBinary::ParseConversion("%*d");
+  EXPECT_EQ(conversion.type, ArgType::kInt);
+  EXPECT_EQ(conversion.stars, 1);
+
+  conversion = LogTraceBinary::ParseConversion("%*.*s");
+  EXPECT_EQ(conversion.type, ArgType::kString);
+  EXPECT_EQ(conversion.stars, 2);
+  EXPECT_EQ(SpecLength(conversion), 5u);
+
+  conversion = LogTraceBinary::ParseConversion("%10.*s");
+  EXPECT_EQ(conversion.type, ArgType::kString);
+  EXPECT_EQ(conversion.stars, 1);
+}
+
+TEST(LogTraceBinaryParseConversion, Unsupported) {
+  // Positional argument
+  EXPECT_EQ(LogTraceBinary::ParseConversion("%1$d").type,
+            ArgType::kUnsupported);
+  // Wide string
+  EXPECT_EQ(LogTraceBinary::ParseConversion("%ls").type,
+            ArgType::kUnsupported);
+  // Unknown conversion
+  EXPECT_EQ(LogTraceBinary::ParseConversion("%y").type,
+            ArgType::kUnsupported);
+
+  // Ends at the end of the format
+  Conversion conversion = LogTraceBinary::ParseConversion("%l");
+  EXPECT_EQ(conversion.type, ArgType::kUnsupported);
+  EXPECT_EQ(*conversion.end, '\0');
+}
+
+TEST_F(LogTraceBinaryTest, DecodesTheWrittenTraces) {
+  {
+    LogTraceBinary trace{"test"};
+    ASSERT_TRUE(trace.is_open());
+    Trace(&trace, 10, "no arguments");
+    Trace(&trace, 11, "int %d, long %ld, long long %lld, unsigned %u", -1,
+          -2L, -3LL, 4u);
+    Trace(&trace, 12, "hex %#x, size %zu, char %c, percent %%", 255,
+          static_cast<size_t>(5), 'x');
+    Trace(&trace, 13, "double %.3f, long double %.1Lf", 1.5, 2.25L);
+    Trace(&trace, 14, "string '%s', null '%s', width '%5s', star '%*d'",
+          "abc", static_cast<const char*>(nullptr), "ab", 4, 7);
+    errno = ENOENT;
+    Trace(&trace, 15, "errno %m");
+    EXPECT_EQ(errno, ENOENT);
+    // Same call site again, the call site is written once
+    Trace(&trace, 11, "int %d, long %ld, long long %lld, unsigned %u", 1, 2L,
+          3LL, 4u);
+  }
+
+  std::vector<std::string> lines;
+  ASSERT_TRUE(Decode(FileName(), &lines));
+  const std::string file = __FILE__;
+  std::vector<std::string> expected{
+      file + ":10 >> no arguments",
+      file + ":11 >> int -1, long -2, long long -3, unsigned 4",
+      file + ":12 >> hex 0xff, size 5, char x, percent %",
+      file + ":13 >> double 1.500, long double 2.2",
+      file + ":14 >> string 'abc', null '(null)', width '   ab', star '   7'",
+      file + ":15 >> errno " + strerror(ENOENT),
+      file + ":11 >> int 1, long 2, long long 3, unsigned 4"};
+  EXPECT_EQ(lines, expected);
+}
+
+TEST_F(LogTraceBinaryTest, TruncatesLongStrings) {
+  std::string long_string(LogTraceBinary::kMaxStringLength + 100, 'a');
+  {
+    LogTraceBinary trace{"test"};
+    ASSERT_TRUE(trace.is_open());
+    Trace(&trace, 20, "%s", long_string.c_str());
+  }
+
+  std::vector<std::string> lines;
+  ASSERT_TRUE(Decode(FileName(), &lines));
+  ASSERT_EQ(lines.size(), 1u);
+  EXPECT_EQ(lines[0], std::string{__FILE__} + ":20 >> " +
+                          long_string.substr(
+                              0, LogTraceBinary::kMaxStringLength));
+}
+
+TEST_F(LogTraceBinaryTest, AppendsToAnExistingFile) {
+  {
+    LogTraceBinary trace{"test"};
+    Trace(&trace, 30, "first %d", 1);
+  }
+  {
+    // The call site ids start over in the new start record
+    LogTraceBinary trace{"test"};
+    Trace(&trace, 31, "second %d", 2);
+  }
+
+  std::vector<std::string> lines;
+  ASSERT_TRUE(Decode(FileName(), &lines));
+  std::vector<std::string> expected{
+      std::string{__FILE__} + ":30 >> first 1",
+      std::string{__FILE__} + ":31 >> second 2"};
+  EXPECT_EQ(lines, expected);
+}
+
+TEST_F(LogTraceBinaryTest, RotatesTheFile) {
+  std::string data(LogTraceBinary::kMaxStringLength, 'd');
+  size_t traces = 0;
+  {
+    LogTraceBinary trace{"test"};
+    ASSERT_TRUE(trace.is_open());
+    struct stat statbuf;
+    while (stat((FileName() + ".1").c_str(), &statbuf) != 0) {
+      Trace(&trace, 40, "%zu %s", traces++, data.c_str());
+      ASSERT_LT(traces * data.size(), 2 * LogTraceBinary::kMaxFileSize);
+    }
+    Trace(&trace, 40, "%zu %s", traces++, data.c_str());
+  }
+
+  // The call site is written again to the new file
+  std::vector<std::string> lines;
+  ASSERT_TRUE(Decode(FileName(), &lines));
+  ASSERT_EQ(lines.size(), 1u);
+  EXPECT_EQ(lines[0], std::string{__FILE__} + ":40 >> " +
+                          std::to_string(traces - 1) + " " + data);
+
+  std::vector<std::string> old_lines;
+  ASSERT_TRUE(Decode(FileName() + ".1", &old_lines));
+  EXPECT_EQ(old_lines.size(), traces - 1);
+}
+
+TEST_F(LogTraceBinaryTest, RejectsOtherFiles) {
+  FILE* file = fopen(FileName().c_str(), "w");
+  ASSERT_NE(file, nullptr);
+  fputs("2026-10-19 12:00:00.000000 not a binary trace\n", file);
+  fclose(file);
+
+  std::vector<std::string> lines;
+  EXPECT_FALSE(Decode(FileName(), &lines));
+  EXPECT_TRUE(lines.empty());
+}
@@ -1193,8 +1193,6 @@ SaAisErrorT saCkptCheckpointOpen(
 		}
 
 		if (add_flag == false) {
-			gc_node->open.info.open.o_addr =
-			    out_evt->info.cpa.info.openRsp.addr;
 			gc_node->ckpt_creat_attri =
 			    out_evt->info.cpa.info.openRsp.creation_attr;
 
@@ -4624,6 +4622,16 @@ SaAisErrorT saCkptCheckpointRead(SaCkptCheckpointHandleT checkpointHandle,
 		goto done;
 	}
 
+	/* Read the collocated replica on this node directly if possible,
+	 * without a round trip to CPND */
+	if (cpa_proc_direct_replica_read(cb, lc_node, gc_node, ioVector,
+					 numberOfElements, &cl_node->version) ==
+	    NCSCC_RC_SUCCESS) {
+		m_NCS_UNLOCK(&cb->cb_lock, NCS_LOCK_WRITE);
+		rc = SA_AIS_OK;
+		goto direct_read_done;
+	}
+
 	/* Populate the event & send it to CPND */
 	evt.type = CPSV_EVT_TYPE_CPND;
 	evt.info.cpnd.type = CPND_EVT_A2ND_CKPT_READ;
@@ -4718,6 +4726,7 @@ end:
 		out_evt = NULL;
 	}
 
+direct_read_done:
 fail1:
 lock_fail:
 clm_left:
@@ -5361,6 +5370,305 @@ done:
 	return rc;
 }
 
+/****************************************************************************
+  Name          :  ncsCkptRegisterCkptWriteCallback
+
+  Description   :  This function registers the callback of the async writes,
+		   see ncsCkptCheckpointWriteAsync.
+
+  Arguments     :  ckptHandle - Checkpoint handle.
+		   ckptWriteCallback - Pointer to write callback function.
+
+  Return Values :  Refer to SAI-AIS specification for various return values.
+
+  Notes         :
+******************************************************************************/
+SaAisErrorT
+ncsCkptRegisterCkptWriteCallback(SaCkptHandleT ckptHandle,
+				 ncsCkptCheckpointWriteCallbackT ckptWriteCallback)
+{
+	SaAisErrorT rc = SA_AIS_OK;
+	uint32_t proc_rc = NCSCC_RC_SUCCESS;
+	CPA_CLIENT_NODE *cl_node = NULL;
+	CPA_CB *cb = NULL;
+
+	TRACE_ENTER();
+	if (ckptWriteCallback == NULL) {
+		rc = SA_AIS_ERR_INVALID_PARAM;
+		TRACE_4(
+		    "cpa CkptWriteCallback Api failed with return value:%d,ckptHandle:%llx",
+		    rc, ckptHandle);
+		goto done;
+	}
+
+	/* retrieve CPA CB */
+	m_CPA_RETRIEVE_CB(cb);
+	if (!cb) {
+		rc = SA_AIS_ERR_BAD_HANDLE;
+		TRACE_4(
+		    "cpa CkptWriteCallback Api failed with return value:%d,ckptHandle:%llx",
+		    rc, ckptHandle);
+		goto done;
+	}
+
+	/* get the CB Lock */
+	if (m_NCS_LOCK(&cb->cb_lock, NCS_LOCK_WRITE) != NCSCC_RC_SUCCESS) {
+		rc = SA_AIS_ERR_LIBRARY;
+		TRACE_4(
+		    "cpa CkptWriteCallback:LOCK Api failed with return value:%d,ckptHandle:%llx",
+		    rc, ckptHandle);
+		goto lock_fail;
+	}
+
+	/* Get the Client info */
+	rc = cpa_client_node_get(&cb->client_tree, &ckptHandle, &cl_node);
+	if (!cl_node) {
+		rc = SA_AIS_ERR_BAD_HANDLE;
+		TRACE_4(
+		    "cpa CkptWriteCallback:client_node_get Api failed with return value:%d,ckptHandle:%llx",
+		    rc, ckptHandle);
+		goto proc_fail;
+	}
+
+	if (cl_node->callbk_mbx == 0)
+		proc_rc = cpa_callback_ipc_init(cl_node);
+	if (proc_rc != NCSCC_RC_SUCCESS) {
+		rc = SA_AIS_ERR_LIBRARY;
+		TRACE_4(
+		    "cpa CkptWriteCallback Api failed with return value:%d,ckptHandle:%llx",
+		    rc, ckptHandle);
+		goto proc_fail;
+	}
+	cl_node->write_callbk = ckptWriteCallback;
+	rc = SA_AIS_OK;
+
+proc_fail:
+	m_NCS_UNLOCK(&cb->cb_lock, NCS_LOCK_WRITE);
+lock_fail:
+	m_CPA_GIVEUP_CB;
+done:
+	TRACE_LEAVE2("API return code = %u", rc);
+	return rc;
+}
+
+/****************************************************************************
+  Name          :  ncsCkptCheckpointWriteAsync
+
+  Description   :  This function writes like saCkptCheckpointWrite, without
+		   waiting for the write to be done. The result is delivered
+		   to the write callback.
+
+  Arguments     :  checkpointHandle - Handle that designates the checkpoint.
+		   invocation - Identifies the write in the callback.
+		   ioVector - Pointer to a vector that contains elements
+			      ioVector[0], ..., ioVector[numberOfElements - 1].
+		   numberOfElements - Size of the ioVector.
+
+  Return Values :  Refer to SAI-AIS specification for various return values.
+
+  Notes         :  The writes of a checkpoint handle are sent in the order
+		   they are issued, at most CPA_ASYNC_WRITE_WINDOW at a time,
+		   and the CPND responds to them in that order. The writes
+		   waiting for room in the window keep a copy of their data.
+******************************************************************************/
+SaAisErrorT
+ncsCkptCheckpointWriteAsync(SaCkptCheckpointHandleT checkpointHandle,
+			    SaInvocationT invocation,
+			    const SaCkptIOVectorElementT *ioVector,
+			    SaUint32T numberOfElements)
+{
+	SaAisErrorT rc = SA_AIS_OK;
+	uint32_t proc_rc;
+	CPA_LOCAL_CKPT_NODE *lc_node = NULL;
+	CPA_CB *cb = NULL;
+	CPA_GLOBAL_CKPT_NODE *gc_node = NULL;
+	CPA_CLIENT_NODE *cl_node = NULL;
+	CPA_ASYNC_WRITE *write = NULL;
+	bool add_flag = false;
+	uint32_t iter = 0;
+	uint32_t err_flag = 0;
+
+	TRACE_ENTER2("SaCkptCheckpointHandleT passed is %llx",
+		     checkpointHandle);
+
+	if (ioVector == NULL) {
+		rc = SA_AIS_ERR_INVALID_PARAM;
+		TRACE_4(
+		    "cpa CkptWriteAsync Api failed with return value:%d,ckptHandle:%llx",
+		    rc, checkpointHandle);
+		goto done;
+	}
+
+	/* retrieve CPA CB */
+	m_CPA_RETRIEVE_CB(cb);
+	if (!cb) {
+		rc = SA_AIS_ERR_BAD_HANDLE;
+		TRACE_4(
+		    "cpa CkptWriteAsync Api failed with return value:%d,ckptHandle:%llx",
+		    rc, checkpointHandle);
+		goto done;
+	}
+
+	/* get the CB Lock */
+	if (m_NCS_LOCK(&cb->cb_lock, NCS_LOCK_WRITE) != NCSCC_RC_SUCCESS) {
+		rc = SA_AIS_ERR_LIBRARY;
+		TRACE_4(
+		    "cpa CkptWriteAsync Api failed with return value:%d,ckptHandle:%llx",
+		    rc, checkpointHandle);
+		goto lock_fail;
+	}
+
+	cpa_lcl_ckpt_node_get(&cb->lcl_ckpt_tree, &checkpointHandle, &lc_node);
+	if (!lc_node) {
+		rc = SA_AIS_ERR_BAD_HANDLE;
+		TRACE_4(
+		    "cpa CkptWriteAsync Api failed with return value:%d,ckptHandle:%llx",
+		    rc, checkpointHandle);
+		goto unlock;
+	}
+
+	cpa_client_node_get(&cb->client_tree, &lc_node->cl_hdl, &cl_node);
+	if (!cl_node) {
+		rc = SA_AIS_ERR_BAD_HANDLE;
+		TRACE_4(
+		    "cpa CkptWriteAsync:client_node_get failed with return value:%d,cl_hdl:%llx",
+		    rc, lc_node->cl_hdl);
+		goto unlock;
+	}
+
+	if (m_CPA_VER_IS_ABOVE_B_1_1(&cl_node->version)) {
+		if ((cb->is_cpnd_joined_clm != true) ||
+		    (cl_node->stale == true)) {
+			rc = SA_AIS_ERR_UNAVAILABLE;
+			TRACE_4("Cpa  CLM Node left, return value:%d", rc);
+			goto unlock;
+		}
+	}
+
+	if (cl_node->write_callbk == NULL) {
+		rc = SA_AIS_ERR_INIT;
+		TRACE_4(
+		    "cpa CkptWriteAsync Api failed with return value:%d,ckptHandle:%llx",
+		    rc, checkpointHandle);
+		goto unlock;
+	}
+
+	proc_rc = cpa_proc_check_iovector(cb, lc_node, ioVector,
+					  numberOfElements, &err_flag);
+	if (proc_rc != NCSCC_RC_SUCCESS) {
+		rc = SA_AIS_ERR_INVALID_PARAM;
+		TRACE_4(
+		    "cpa CkptWriteAsync Api failed with return value:%d,ckptHandle:%llx,index:%u",
+		    rc, checkpointHandle, err_flag);
+		goto unlock;
+	}
+
+	for (iter = 0; iter < numberOfElements; iter++) {
+		if (ioVector[iter].dataSize > CPSV_MAX_DATA_SIZE) {
+			rc = SA_AIS_ERR_NO_RESOURCES;
+			TRACE_4(
+			    "cpa CkptWriteAsync Api failed with return value:%d,ckptHandle:%llx",
+			    rc, checkpointHandle);
+			goto unlock;
+		}
+	}
+
+	/* If Write is not allowed return the error */
+	if (!(lc_node->open_flags & SA_CKPT_CHECKPOINT_WRITE)) {
+		rc = SA_AIS_ERR_ACCESS;
+		TRACE_4(
+		    "cpa CkptWriteAsync Api failed with return value:%d,ckptHandle:%llx",
+		    rc, checkpointHandle);
+		goto unlock;
+	}
+
+	cpa_gbl_ckpt_node_find_add(&cb->gbl_ckpt_tree, &lc_node->gbl_ckpt_hdl,
+				   &gc_node, &add_flag);
+	if (!gc_node) {
+		rc = SA_AIS_ERR_NO_RESOURCES;
+		TRACE_4("cpa - Global Ckpt Find Add Failed");
+		goto unlock;
+	}
+
+	if (gc_node->is_restart ||
+	    lc_node->num_async_writes >= CPA_ASYNC_WRITE_MAX) {
+		rc = SA_AIS_ERR_TRY_AGAIN;
+		TRACE_4(
+		    "cpa CkptWriteAsync Api failed with return value:%d,ckptHandle:%llx,pending:%u",
+		    rc, checkpointHandle, lc_node->num_async_writes);
+		goto unlock;
+	}
+
+	if (!gc_node->is_active_exists) {
+		rc = SA_AIS_ERR_NOT_EXIST;
+		TRACE_4(
+		    "cpa CkptWriteAsync Api failed with return value:%d,ckptHandle:%llx",
+		    rc, checkpointHandle);
+		goto unlock;
+	}
+
+	write = m_MMGR_ALLOC_CPA_DEFAULT(sizeof(CPA_ASYNC_WRITE));
+	if (!write) {
+		rc = SA_AIS_ERR_NO_MEMORY;
+		TRACE_4(
+		    "cpa CkptWriteAsync Api failed with return value:%d,ckptHandle:%llx",
+		    rc, checkpointHandle);
+		goto unlock;
+	}
+	memset(write, 0, sizeof(CPA_ASYNC_WRITE));
+	write->invocation = invocation;
+	write->num_of_elmts = numberOfElements;
+	for (iter = 0; iter < numberOfElements; iter++)
+		write->size += ioVector[iter].dataSize;
+
+	proc_rc = cpa_proc_build_data_access_evt(
+	    ioVector, numberOfElements, CPSV_CKPT_ACCESS_WRITE,
+	    gc_node->ckpt_creat_attri.maxSectionSize, NULL, &write->data);
+	if (proc_rc != NCSCC_RC_SUCCESS) {
+		rc = SA_AIS_ERR_INVALID_PARAM;
+		TRACE_4(
+		    "cpa CkptWriteAsync Api failed with return value:%d,ckptHandle:%llx",
+		    rc, checkpointHandle);
+		goto free_write;
+	}
+
+	/* Send it at once if the writes before it have been sent and there is
+	 * room in the window, otherwise it waits with a copy of the data */
+	if (lc_node->num_async_writes_sent == lc_node->num_async_writes &&
+	    lc_node->num_async_writes_sent <
+		cpa_proc_async_write_window(gc_node)) {
+		if (cpa_proc_async_write_send(cb, lc_node, gc_node, write) !=
+		    NCSCC_RC_SUCCESS) {
+			rc = SA_AIS_ERR_TRY_AGAIN;
+			goto free_write;
+		}
+	} else if (cpa_proc_async_write_copy(write) != NCSCC_RC_SUCCESS) {
+		rc = SA_AIS_ERR_NO_MEMORY;
+		TRACE_4(
+		    "cpa CkptWriteAsync Api failed with return value:%d,ckptHandle:%llx",
+		    rc, checkpointHandle);
+		goto free_write;
+	}
+
+	if (lc_node->async_write_last == NULL)
+		lc_node->async_write_list = write;
+	else
+		lc_node->async_write_last->next = write;
+	lc_node->async_write_last = write;
+	lc_node->num_async_writes++;
+	goto unlock;
+
+free_write:
+	cpa_proc_async_write_free(write);
+unlock:
+	m_NCS_UNLOCK(&cb->cb_lock, NCS_LOCK_WRITE);
+lock_fail:
+	m_CPA_GIVEUP_CB;
+done:
+	TRACE_LEAVE2("API return code = %u", rc);
+	return rc;
+}
+
 /****************************************************************************
 Name          :  saCkptTrack
 
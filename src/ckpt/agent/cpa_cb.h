@@ -29,11 +29,24 @@ typedef struct cpa_client_node {
   uint8_t stale;        /*Loss of connection with cpnd because of clm node left
                           will set this to true for the connection. */
   SaCkptCallbacksT_2 ckpt_callbk;
+  ncsCkptCheckpointWriteCallbackT write_callbk;
   SYSF_MBX callbk_mbx; /* Mailbox Queue for client messages */
   bool is_track_enabled;
   SaVersionT version;
 } CPA_CLIENT_NODE;
 
+/* Write issued by ncsCkptCheckpointWriteAsync, waiting for its response */
+typedef struct cpa_async_write {
+  struct cpa_async_write *next;
+  SaInvocationT invocation;
+  SaUint32T num_of_elmts;
+  SaSizeT size;         /* Of the data, for the timeout */
+  CPSV_CKPT_DATA *data; /* The ioVector, until the write is sent */
+  void *buffer;         /* Copy of its data, if not sent at once */
+  MDS_DEST dest;        /* Where the write was sent */
+  bool is_sent;
+} CPA_ASYNC_WRITE;
+
 /* Node to store the mapping info between local & global check point handles */
 typedef struct cpa_local_ckpt_node {
   NCS_PATRICIA_NODE patnode;
@@ -44,13 +57,25 @@ typedef struct cpa_local_ckpt_node {
   SaConstStringT ckpt_name;
   CPA_TMR async_req_tmr; /* Timer used for async requests */
   uint32_t sect_iter_cnt;
+  /* Async writes in the order issued, the sent ones first */
+  CPA_ASYNC_WRITE *async_write_list;
+  CPA_ASYNC_WRITE *async_write_last;
+  uint32_t num_async_writes;
+  uint32_t num_async_writes_sent;
+  /* Responses still to come to timed out async writes, from lost_dest */
+  uint32_t async_write_lost;
+  MDS_DEST async_write_lost_dest;
+  CPA_TMR async_write_tmr; /* Timer of the first async write sent */
 } CPA_LOCAL_CKPT_NODE;
 
 typedef struct cpa_glbl_ckpt_node {
   NCS_PATRICIA_NODE patnode;
   SaCkptCheckpointHandleT gbl_ckpt_hdl; /* globally aware handle */
   /*SaCkptCheckpointHandleT    lcl_ckpt_hdl; */
+  /* The collocated replica on this node, mapped read only */
   NCS_OS_POSIX_SHM_REQ_INFO open;
+  bool is_replica_map_failed;
+  uint32_t last_read_sec; /* Section found by the last direct read */
   SaCkptCheckpointCreationAttributesT ckpt_creat_attri;
   uint32_t ref_cnt; /* Client count */
   MDS_DEST active_mds_dest;
@@ -141,6 +166,10 @@ typedef struct cpa_prcess_evt_sync {
 
 #define CPSV_MAX_DATA_SIZE 40000000
 
+/* Direct reads of the collocated replica, see cpa_proc_direct_replica_read */
+#define CPA_DIRECT_READ_MAX_ELMTS 16
+#define CPA_DIRECT_READ_RETRIES 100
+
 #define m_CPA_IS_ALL_REPLICA_ATTR_SET(attr) \
   (((attr & SA_CKPT_WR_ALL_REPLICAS) != 0) ? true : false)
 #define m_CPA_IS_COLLOCATED_ATTR_SET(attr) \
@@ -274,6 +274,14 @@ uint32_t cpa_lcl_ckpt_node_delete(CPA_CB *cb, CPA_LOCAL_CKPT_NODE *lc_node)
 	if (lc_node) {
 		/* Stop timer, if running */
 		cpa_tmr_stop(&lc_node->async_req_tmr);
+		cpa_tmr_stop(&lc_node->async_write_tmr);
+
+		/* The callbacks of the pending async writes are not invoked */
+		while (lc_node->async_write_list != NULL) {
+			CPA_ASYNC_WRITE *write = lc_node->async_write_list;
+			lc_node->async_write_list = write->next;
+			cpa_proc_async_write_free(write);
+		}
 
 		if (lc_node->async_req_tmr.uarg) {
 			ncshm_destroy_hdl(NCS_SERVICE_ID_CPA,
@@ -472,8 +480,8 @@ uint32_t cpa_gbl_ckpt_node_delete(CPA_CB *cb, CPA_GLOBAL_CKPT_NODE *gc_node)
 		rc = NCSCC_RC_FAILURE;
 	}
 
-	if (gc_node)
-		m_MMGR_FREE_CPA_GLOBAL_CKPT_NODE(gc_node);
+	cpa_proc_replica_unmap(gc_node);
+	m_MMGR_FREE_CPA_GLOBAL_CKPT_NODE(gc_node);
 
 	return rc;
 }
@@ -39,6 +39,16 @@
        ? 1400                      \
        : 1600 + ((datasize / CPSV_AVG_DATA_SIZE) * 400))
 
+/* Async writes pending per checkpoint handle, and sent at a time */
+#define CPA_ASYNC_WRITE_MAX 1024
+#define CPA_ASYNC_WRITE_WINDOW 64
+/* The CPND keeps one write to all replicas per checkpoint handle awaiting
+ * the remote replicas, keyed by the handle, and answers a further write at
+ * once with SA_AIS_ERR_TRY_AGAIN. It also answers a write failing locally
+ * at once, ahead of the one awaiting the remote replicas, so a wider window
+ * would break the in order matching of the responses. */
+#define CPA_ASYNC_WRITE_WINDOW_ALL_REPLICAS 1
+
 #define m_CPSV_CONVERT_SATIME_TEN_MILLI_SEC(t) (t) / (10000000) /* 10^7 */
 
 #endif  // CKPT_AGENT_CPA_DEF_H_
@@ -29,6 +29,10 @@
 */
 
 #include "ckpt/agent/cpa.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <limits.h>
 #include "base/osaf_poll.h"
 
 static void cpa_process_callback_info(CPA_CB *cb, CPA_CLIENT_NODE *cl_node,
@@ -518,6 +522,339 @@ static void cpa_proc_async_sync_rsp(CPA_CB *cb, CPA_EVT *evt)
 	return;
 }
 
+/****************************************************************************
+  Name          : cpa_proc_async_write_free
+  Description   : This function frees an async write.
+  Arguments     : write - The write.
+  Return Values : None
+  Notes         : None
+******************************************************************************/
+void cpa_proc_async_write_free(CPA_ASYNC_WRITE *write)
+{
+	cpa_proc_free_cpsv_ckpt_data(write->data);
+	if (write->buffer)
+		m_MMGR_FREE_CPA_DEFAULT(write->buffer);
+	m_MMGR_FREE_CPA_DEFAULT(write);
+}
+
+/****************************************************************************
+  Name          : cpa_proc_async_write_copy
+  Description   : This function copies the section ids and the data of an
+		  async write, which is to be sent later.
+  Arguments     : write - The write, with the data of the application.
+  Return Values : NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE
+  Notes         : The copies are in one buffer.
+******************************************************************************/
+uint32_t cpa_proc_async_write_copy(CPA_ASYNC_WRITE *write)
+{
+	CPSV_CKPT_DATA *data = NULL;
+	SaSizeT size = 0;
+	uint8_t *ptr = NULL;
+
+	for (data = write->data; data != NULL; data = data->next)
+		size += data->sec_id.idLen + data->dataSize;
+
+	if (size == 0)
+		return NCSCC_RC_SUCCESS;
+
+	write->buffer = m_MMGR_ALLOC_CPA_DEFAULT(size);
+	if (write->buffer == NULL)
+		return NCSCC_RC_FAILURE;
+
+	ptr = write->buffer;
+	for (data = write->data; data != NULL; data = data->next) {
+		if (data->sec_id.idLen != 0) {
+			memcpy(ptr, data->sec_id.id, data->sec_id.idLen);
+			data->sec_id.id = ptr;
+			ptr += data->sec_id.idLen;
+		}
+		if (data->dataSize != 0) {
+			memcpy(ptr, data->data, data->dataSize);
+			data->data = ptr;
+			ptr += data->dataSize;
+		}
+	}
+	return NCSCC_RC_SUCCESS;
+}
+
+/****************************************************************************
+  Name          : cpa_proc_async_write_window
+  Description   : This function returns the number of async writes of a
+		  checkpoint handle which may be sent at a time.
+  Arguments     : gc_node - Global checkpoint node.
+  Return Values : Number of writes
+  Notes         : The CPND awaits the remote replicas for one write per
+		  checkpoint handle to a checkpoint written to all replicas,
+		  see CPA_ASYNC_WRITE_WINDOW_ALL_REPLICAS.
+******************************************************************************/
+uint32_t cpa_proc_async_write_window(CPA_GLOBAL_CKPT_NODE *gc_node)
+{
+	if (gc_node->ckpt_creat_attri.creationFlags & SA_CKPT_WR_ALL_REPLICAS)
+		return CPA_ASYNC_WRITE_WINDOW_ALL_REPLICAS;
+	return CPA_ASYNC_WRITE_WINDOW;
+}
+
+/****************************************************************************
+  Name          : cpa_proc_async_write_send
+  Description   : This function sends an async write to the active replica.
+  Arguments     : cb - CPA CB.
+		  lc_node - Local checkpoint node.
+		  gc_node - Global checkpoint node.
+		  write - The write, the first one not sent.
+  Return Values : NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE
+  Notes         : Called with the CB lock held, which keeps the writes of
+		  the checkpoint handle in order.
+******************************************************************************/
+uint32_t cpa_proc_async_write_send(CPA_CB *cb, CPA_LOCAL_CKPT_NODE *lc_node,
+				   CPA_GLOBAL_CKPT_NODE *gc_node,
+				   CPA_ASYNC_WRITE *write)
+{
+	CPSV_EVT evt;
+	uint32_t rc;
+
+	memset(&evt, '\0', sizeof(CPSV_EVT));
+	evt.type = CPSV_EVT_TYPE_CPND;
+	evt.info.cpnd.type = CPND_EVT_A2ND_CKPT_WRITE;
+	evt.info.cpnd.info.ckpt_write.type = CPSV_CKPT_ACCESS_WRITE;
+	evt.info.cpnd.info.ckpt_write.ckpt_id = lc_node->gbl_ckpt_hdl;
+	evt.info.cpnd.info.ckpt_write.lcl_ckpt_id = lc_node->lcl_ckpt_hdl;
+	evt.info.cpnd.info.ckpt_write.agent_mdest = cb->cpa_mds_dest;
+	evt.info.cpnd.info.ckpt_write.num_of_elmts = write->num_of_elmts;
+	evt.info.cpnd.info.ckpt_write.data = write->data;
+
+	rc = cpa_mds_msg_send(cb->cpa_mds_hdl, &gc_node->active_mds_dest, &evt,
+			      NCSMDS_SVC_ID_CPND);
+	if (rc != NCSCC_RC_SUCCESS) {
+		TRACE_4("cpa async write send failed with rc:%d,ckptHandle:%llx",
+			rc, lc_node->lcl_ckpt_hdl);
+		return rc;
+	}
+
+	/* The data has been encoded */
+	cpa_proc_free_cpsv_ckpt_data(write->data);
+	write->data = NULL;
+	if (write->buffer) {
+		m_MMGR_FREE_CPA_DEFAULT(write->buffer);
+		write->buffer = NULL;
+	}
+	write->dest = gc_node->active_mds_dest;
+	write->is_sent = true;
+	lc_node->num_async_writes_sent++;
+
+	if (!lc_node->async_write_tmr.is_active) {
+		lc_node->async_write_tmr.type = CPA_TMR_TYPE_WRITE;
+		lc_node->async_write_tmr.info.ckpt.client_hdl = lc_node->cl_hdl;
+		lc_node->async_write_tmr.info.ckpt.lcl_ckpt_hdl =
+		    lc_node->lcl_ckpt_hdl;
+		cpa_tmr_start(&lc_node->async_write_tmr,
+			      CPA_WAIT_TIME(write->size));
+	}
+	return NCSCC_RC_SUCCESS;
+}
+
+/****************************************************************************
+  Name          : cpa_proc_async_write_done
+  Description   : This function removes the first async write of a
+		  checkpoint handle and posts its callback.
+  Arguments     : lc_node - Local checkpoint node.
+		  cl_node - Client node, NULL if it is gone.
+		  error - Result of the write.
+		  error_index - Erroneous vector index.
+  Return Values : None
+  Notes         : None
+******************************************************************************/
+static void cpa_proc_async_write_done(CPA_LOCAL_CKPT_NODE *lc_node,
+				      CPA_CLIENT_NODE *cl_node,
+				      SaAisErrorT error, SaUint32T error_index)
+{
+	CPA_ASYNC_WRITE *write = lc_node->async_write_list;
+	CPA_CALLBACK_INFO *callback = NULL;
+
+	lc_node->async_write_list = write->next;
+	if (lc_node->async_write_list == NULL)
+		lc_node->async_write_last = NULL;
+	lc_node->num_async_writes--;
+	if (write->is_sent)
+		lc_node->num_async_writes_sent--;
+
+	if (cl_node != NULL) {
+		callback = m_MMGR_ALLOC_CPA_CALLBACK_INFO;
+		if (callback) {
+			memset(callback, 0, sizeof(CPA_CALLBACK_INFO));
+			callback->type = CPA_CALLBACK_TYPE_WRITE;
+			callback->invocation = write->invocation;
+			callback->lcl_ckpt_hdl = lc_node->lcl_ckpt_hdl;
+			callback->error_index = error_index;
+			callback->sa_err = error;
+			m_NCS_IPC_SEND(&cl_node->callbk_mbx, callback,
+				       NCS_IPC_PRIORITY_NORMAL);
+		}
+	}
+	cpa_proc_async_write_free(write);
+}
+
+/****************************************************************************
+  Name          : cpa_proc_async_write_send_next
+  Description   : This function sends the async writes of a checkpoint
+		  handle waiting for room in the window.
+  Arguments     : cb - CPA CB.
+		  lc_node - Local checkpoint node.
+		  cl_node - Client node.
+  Return Values : None
+  Notes         : A write which cannot be sent fails, the writes after it
+		  are still sent in order.
+******************************************************************************/
+static void cpa_proc_async_write_send_next(CPA_CB *cb,
+					   CPA_LOCAL_CKPT_NODE *lc_node,
+					   CPA_CLIENT_NODE *cl_node)
+{
+	CPA_GLOBAL_CKPT_NODE *gc_node = NULL;
+	CPA_ASYNC_WRITE *write = NULL;
+	uint32_t i;
+	bool add_flag = false;
+
+	cpa_gbl_ckpt_node_find_add(&cb->gbl_ckpt_tree, &lc_node->gbl_ckpt_hdl,
+				   &gc_node, &add_flag);
+	if (gc_node == NULL)
+		return;
+
+	while (lc_node->num_async_writes_sent < lc_node->num_async_writes &&
+	       lc_node->num_async_writes_sent <
+		   cpa_proc_async_write_window(gc_node)) {
+		/* The sent writes are first */
+		write = lc_node->async_write_list;
+		for (i = 0; i < lc_node->num_async_writes_sent; i++)
+			write = write->next;
+
+		if (gc_node->is_restart || !gc_node->is_active_exists ||
+		    cpa_proc_async_write_send(cb, lc_node, gc_node, write) !=
+			NCSCC_RC_SUCCESS) {
+			/* Only the unsent write can be removed, the callbacks
+			 * of the writes before it shall come first */
+			if (lc_node->num_async_writes_sent != 0)
+				return;
+			cpa_proc_async_write_done(lc_node, cl_node,
+						  SA_AIS_ERR_TRY_AGAIN, 0);
+		}
+	}
+}
+
+/****************************************************************************
+  Name          : cpa_proc_async_write_rsp
+  Description   : This function will process the response to an async
+		  write.
+  Arguments     : cb - CPA CB.
+		  evt - CPSV_EVT.
+  Return Values : None
+  Notes         : The CPND responds to the writes of a checkpoint handle in
+		  the order they were sent, i.e. the response is to the
+		  first write sent.
+******************************************************************************/
+static void cpa_proc_async_write_rsp(CPA_CB *cb, CPSV_EVT *evt)
+{
+	CPSV_ND2A_DATA_ACCESS_RSP *rsp = &evt->info.cpa.info.sec_data_rsp;
+	CPA_CLIENT_NODE *cl_node = NULL;
+	CPA_LOCAL_CKPT_NODE *lc_node = NULL;
+	CPA_ASYNC_WRITE *write = NULL;
+	SaAisErrorT error = SA_AIS_OK;
+
+	TRACE_ENTER();
+	if (rsp->type == CPSV_DATA_ACCESS_WRITE_RSP &&
+	    rsp->info.write_err_index != NULL) {
+		m_MMGR_FREE_CPSV_SaUint32T(rsp->info.write_err_index,
+					   NCS_SERVICE_ID_CPA);
+		rsp->info.write_err_index = NULL;
+	}
+
+	/* get the CB Lock */
+	if (m_NCS_LOCK(&cb->cb_lock, NCS_LOCK_WRITE) != NCSCC_RC_SUCCESS) {
+		TRACE_4("cpa cb lock take failed");
+		TRACE_LEAVE();
+		return;
+	}
+
+	cpa_lcl_ckpt_node_get(&cb->lcl_ckpt_tree, &rsp->lcl_ckpt_id, &lc_node);
+	if (lc_node == NULL)
+		goto done;
+
+	if (lc_node->async_write_lost != 0 &&
+	    lc_node->async_write_lost_dest == evt->sinfo.dest) {
+		TRACE_4("cpa late rsp to timed out async write,ckptHandle:%llx",
+			lc_node->lcl_ckpt_hdl);
+		lc_node->async_write_lost--;
+		goto done;
+	}
+
+	write = lc_node->async_write_list;
+	if (write == NULL || !write->is_sent ||
+	    write->dest != evt->sinfo.dest) {
+		TRACE_4("cpa unexpected async write rsp,ckptHandle:%llx",
+			lc_node->lcl_ckpt_hdl);
+		goto done;
+	}
+
+	if (rsp->num_of_elmts == -1)
+		error = rsp->error;
+
+	(void)cpa_client_node_get(&cb->client_tree, &lc_node->cl_hdl,
+				  &cl_node);
+	cpa_proc_async_write_done(lc_node, cl_node, error, rsp->error_index);
+
+	/* Time the next write sent */
+	if (lc_node->num_async_writes_sent != 0)
+		cpa_tmr_start(&lc_node->async_write_tmr,
+			      CPA_WAIT_TIME(lc_node->async_write_list->size));
+	else
+		cpa_tmr_stop(&lc_node->async_write_tmr);
+
+	cpa_proc_async_write_send_next(cb, lc_node, cl_node);
+
+done:
+	/* Release The Lock */
+	m_NCS_UNLOCK(&cb->cb_lock, NCS_LOCK_WRITE);
+	TRACE_LEAVE();
+}
+
+/****************************************************************************
+  Name          : cpa_proc_async_write_expiry
+  Description   : This function will process the timeout of an async write.
+  Arguments     : cb - CPA CB.
+		  lc_node - Local checkpoint node.
+  Return Values : None
+  Notes         : Called with the CB lock held. All the async writes of the
+		  checkpoint handle fail, the writes after the one timed out
+		  would otherwise be done without it.
+******************************************************************************/
+static void cpa_proc_async_write_expiry(CPA_CB *cb,
+					CPA_LOCAL_CKPT_NODE *lc_node)
+{
+	CPA_CLIENT_NODE *cl_node = NULL;
+	CPA_ASYNC_WRITE *write = lc_node->async_write_list;
+	MDS_DEST dest;
+
+	if (write == NULL || !write->is_sent)
+		return;
+
+	/* The responses to the writes sent may still come */
+	dest = write->dest;
+	if (lc_node->async_write_lost_dest != dest) {
+		lc_node->async_write_lost_dest = dest;
+		lc_node->async_write_lost = 0;
+	}
+	for (; write != NULL && write->is_sent; write = write->next) {
+		if (write->dest == dest)
+			lc_node->async_write_lost++;
+	}
+
+	TRACE_4("cpa async write timed out,ckptHandle:%llx,writes:%u",
+		lc_node->lcl_ckpt_hdl, lc_node->num_async_writes);
+	(void)cpa_client_node_get(&cb->client_tree, &lc_node->cl_hdl,
+				  &cl_node);
+	while (lc_node->async_write_list != NULL)
+		cpa_proc_async_write_done(lc_node, cl_node, SA_AIS_ERR_TIMEOUT,
+					  0);
+}
+
 /***************************************************************************************************
 * Name         : cpa_proc_ckpt_arrival_ntfy
 
@@ -704,8 +1041,16 @@ static void cpa_proc_tmr_expiry(CPA_CB *cb, CPA_EVT *evt)
 		return;
 	}
 
-	if ((evt->info.tmr_info.type == CPA_TMR_TYPE_OPEN) ||
-	    (evt->info.tmr_info.type == CPA_TMR_TYPE_SYNC)) {
+	if (evt->info.tmr_info.type == CPA_TMR_TYPE_WRITE) {
+		cpa_lcl_ckpt_node_get(&cb->lcl_ckpt_tree,
+				      &tmr_info->lcl_ckpt_hdl, &lc_node);
+		if (lc_node == NULL)
+			goto free_lock;
+
+		cpa_tmr_stop(&lc_node->async_write_tmr);
+		cpa_proc_async_write_expiry(cb, lc_node);
+	} else if ((evt->info.tmr_info.type == CPA_TMR_TYPE_OPEN) ||
+		   (evt->info.tmr_info.type == CPA_TMR_TYPE_SYNC)) {
 		/* Get the local Ckpt Node */
 		cpa_lcl_ckpt_node_get(&cb->lcl_ckpt_tree,
 				      &tmr_info->lcl_ckpt_hdl, &lc_node);
@@ -906,6 +1251,10 @@ uint32_t cpa_process_evt(CPA_CB *cb, CPSV_EVT *evt)
 		cpa_proc_ckpt_arrival_ntfy(cb, &evt->info.cpa);
 		break;
 
+	case CPA_EVT_ND2A_CKPT_DATA_RSP:
+		cpa_proc_async_write_rsp(cb, evt);
+		break;
+
 	case CPA_EVT_TIME_OUT:
 		cpa_proc_tmr_expiry(cb, &evt->info.cpa);
 		break;
@@ -1227,6 +1576,14 @@ static void cpa_process_callback_info(CPA_CB *cb, CPA_CLIENT_NODE *cl_node,
 		}
 		break;
 
+	case CPA_CALLBACK_TYPE_WRITE:
+		if (cl_node->write_callbk) {
+			cl_node->write_callbk(
+			    callback->invocation, callback->lcl_ckpt_hdl,
+			    callback->error_index, callback->sa_err);
+		}
+		break;
+
 	default:
 		break;
 	}
@@ -1520,6 +1877,319 @@ uint32_t cpa_proc_rmt_replica_read(SaUint32T numberOfElements,
 	return rc;
 }
 
+/****************************************************************************
+  Name          : cpa_proc_replica_map
+  Description   : Map the replica of the checkpoint on this node read only,
+		  the shared memory object created by CPND in
+		  cpnd_ckpt_replica_create().
+  Arguments     : cb - CPA CB
+		  lc_node - local checkpoint node
+		  gc_node - global checkpoint node
+  Return Values : NCSCC_RC_FAILURE/NCSCC_RC_SUCCESS
+  Notes         : The caller takes the cb lock
+******************************************************************************/
+static uint32_t cpa_proc_replica_map(CPA_CB *cb, CPA_LOCAL_CKPT_NODE *lc_node,
+				     CPA_GLOBAL_CKPT_NODE *gc_node)
+{
+	char buf[CPND_MAX_REPLICA_NAME_LENGTH];
+	char shm_name[PATH_MAX];
+	struct stat st;
+	uint64_t size;
+	void *addr;
+	int fd;
+
+	if (lc_node->ckpt_name == NULL || lc_node->ckpt_name[0] == '\0')
+		return NCSCC_RC_FAILURE;
+
+	memset(buf, '\0', sizeof(buf));
+	strncpy(buf, lc_node->ckpt_name, CPND_REP_NAME_MAX_CKPT_NAME_LENGTH);
+	sprintf(buf + strlen(buf) - 1, "_%u_%llu",
+		(uint32_t)m_NCS_NODE_ID_FROM_MDS_DEST(cb->cpnd_mds_dest),
+		gc_node->gbl_ckpt_hdl);
+	snprintf(shm_name, sizeof(shm_name), "/opensaf_%s", buf);
+
+	size = CPSV_REPLICA_SIZE(gc_node->ckpt_creat_attri.maxSections,
+				 gc_node->ckpt_creat_attri.maxSectionSize);
+	fd = shm_open(shm_name, O_RDONLY, 0);
+	if (fd < 0) {
+		TRACE_4("cpa replica shm_open of %s failed: %s", shm_name,
+			strerror(errno));
+		return NCSCC_RC_FAILURE;
+	}
+	/* A replica created by an older CPND has no sequence counters */
+	if (fstat(fd, &st) != 0 || (uint64_t)st.st_size < size) {
+		TRACE_4("cpa replica %s has no sequence counters", shm_name);
+		close(fd);
+		return NCSCC_RC_FAILURE;
+	}
+	addr = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (addr == MAP_FAILED) {
+		TRACE_4("cpa replica mmap of %s failed: %s", shm_name,
+			strerror(errno));
+		return NCSCC_RC_FAILURE;
+	}
+	if (((CPSV_CKPT_HDR *)addr)->ckpt_id != gc_node->gbl_ckpt_hdl) {
+		TRACE_4("cpa replica %s is of another checkpoint", shm_name);
+		munmap(addr, size);
+		return NCSCC_RC_FAILURE;
+	}
+
+	gc_node->open.info.open.o_addr = addr;
+	gc_node->open.info.open.i_size = size;
+	return NCSCC_RC_SUCCESS;
+}
+
+/****************************************************************************
+  Name          : cpa_proc_replica_unmap
+  Description   : Unmap the replica mapped by cpa_proc_replica_map
+  Arguments     : gc_node - global checkpoint node
+  Return Values : None
+  Notes         : The caller takes the cb lock
+******************************************************************************/
+void cpa_proc_replica_unmap(CPA_GLOBAL_CKPT_NODE *gc_node)
+{
+	if (gc_node->open.info.open.o_addr == NULL)
+		return;
+	munmap(gc_node->open.info.open.o_addr,
+	       gc_node->open.info.open.i_size);
+	gc_node->open.info.open.o_addr = NULL;
+}
+
+static bool cpa_proc_sec_id_match(const CPSV_SECT_HDR *sec_hdr,
+				  const SaCkptSectionIdT *sec_id)
+{
+	return sec_hdr->idLen == sec_id->idLen &&
+	       (sec_id->idLen == 0 ||
+		memcmp(sec_hdr->id, sec_id->id, sec_id->idLen) == 0);
+}
+
+/****************************************************************************
+  Name          : cpa_proc_sec_find
+  Description   : Find a section in the mapped replica
+  Arguments     : gc_node - global checkpoint node
+		  sec_id - section id
+  Return Values : Index of the section, or -1 if not found
+  Notes         : The section may be changed or deleted at any time, the
+		  caller checks the section again when it has read it
+******************************************************************************/
+static int32_t cpa_proc_sec_find(CPA_GLOBAL_CKPT_NODE *gc_node,
+				 const SaCkptSectionIdT *sec_id)
+{
+	const char *base = gc_node->open.info.open.o_addr;
+	const SaCkptCheckpointCreationAttributesT *attr =
+	    &gc_node->ckpt_creat_attri;
+	const CPSV_SECT_SEQ *sec_seq =
+	    (const CPSV_SECT_SEQ *)(base +
+				    CPSV_REPLICA_SEQ_OFFSET(
+					attr->maxSections,
+					attr->maxSectionSize) +
+				    sizeof(CPSV_REPLICA_SEQ));
+	const CPSV_SECT_HDR *sec_hdr;
+	uint32_t i, index;
+
+	for (i = 0; i < attr->maxSections; i++) {
+		/* Start with the section found the last time, a state
+		 * checkpoint is typically polled for the same section */
+		index = (gc_node->last_read_sec + i) % attr->maxSections;
+		if (!__atomic_load_n(&sec_seq[index].in_use, __ATOMIC_RELAXED))
+			continue;
+		sec_hdr = (const CPSV_SECT_HDR *)(base + sizeof(CPSV_CKPT_HDR) +
+						  index *
+						      (sizeof(CPSV_SECT_HDR) +
+						       attr->maxSectionSize));
+		if (cpa_proc_sec_id_match(sec_hdr, sec_id)) {
+			gc_node->last_read_sec = index;
+			return index;
+		}
+	}
+	return -1;
+}
+
+static void cpa_proc_direct_read_free(void *buffer, SaVersionT *version)
+{
+	if (buffer == NULL)
+		return;
+	if (m_CPA_VER_IS_ABOVE_B_1_1(version))
+		m_MMGR_FREE_CPA_DEFAULT(buffer);
+	else
+		free(buffer);
+}
+
+/****************************************************************************
+  Name          : cpa_proc_direct_replica_read
+  Description   : Read the sections from the collocated replica on this
+		  node, mapped into this process, instead of asking CPND to
+		  read them. Supported if the replica is updated synchronously
+		  with the writes, i.e. for a collocated checkpoint written to
+		  all replicas or whose active replica is on this node.
+  Arguments     : cb - CPA CB
+		  lc_node - local checkpoint node
+		  gc_node - global checkpoint node
+		  ioVector - the sections to read, as given to
+			     saCkptCheckpointRead()
+		  numberOfElements - number of elements in ioVector
+		  version - version of the client
+  Return Values : NCSCC_RC_SUCCESS if read, NCSCC_RC_FAILURE if the
+		  sections shall be read by CPND. That includes all errors,
+		  which are then reported the same way as before.
+  Notes         : The caller takes the cb lock. The copies are consistent
+		  by the sequence counters maintained by CPND, see
+		  CPSV_REPLICA_SEQ.
+******************************************************************************/
+uint32_t cpa_proc_direct_replica_read(CPA_CB *cb, CPA_LOCAL_CKPT_NODE *lc_node,
+				      CPA_GLOBAL_CKPT_NODE *gc_node,
+				      SaCkptIOVectorElementT *ioVector,
+				      SaUint32T numberOfElements,
+				      SaVersionT *version)
+{
+	const SaCkptCheckpointCreationAttributesT *attr =
+	    &gc_node->ckpt_creat_attri;
+	void *allocated[CPA_DIRECT_READ_MAX_ELMTS];
+	SaSizeT alloc_size[CPA_DIRECT_READ_MAX_ELMTS];
+	SaSizeT read_size[CPA_DIRECT_READ_MAX_ELMTS];
+	const CPSV_REPLICA_SEQ *replica_seq;
+	const CPSV_SECT_SEQ *sec_seq;
+	const CPSV_SECT_HDR *sec_hdr;
+	const char *base;
+	uint32_t retry, iter, seq, rep_seq = 0;
+	int32_t index;
+	SaSizeT sec_size;
+	bool user_buffer;
+
+	if (!m_CPA_IS_COLLOCATED_ATTR_SET(attr->creationFlags) ||
+	    (!m_CPA_IS_ALL_REPLICA_ATTR_SET(attr->creationFlags) &&
+	     (!gc_node->is_active_exists ||
+	      m_NCS_NODE_ID_FROM_MDS_DEST(gc_node->active_mds_dest) !=
+		  m_NCS_NODE_ID_FROM_MDS_DEST(cb->cpnd_mds_dest))))
+		return NCSCC_RC_FAILURE;
+	if (!cb->is_cpnd_up || numberOfElements == 0 ||
+	    numberOfElements > CPA_DIRECT_READ_MAX_ELMTS ||
+	    attr->maxSections == 0 || gc_node->is_replica_map_failed)
+		return NCSCC_RC_FAILURE;
+
+	if (gc_node->open.info.open.o_addr == NULL &&
+	    cpa_proc_replica_map(cb, lc_node, gc_node) != NCSCC_RC_SUCCESS) {
+		gc_node->is_replica_map_failed = true;
+		return NCSCC_RC_FAILURE;
+	}
+
+	base = gc_node->open.info.open.o_addr;
+	replica_seq =
+	    (const CPSV_REPLICA_SEQ *)(base +
+				       CPSV_REPLICA_SEQ_OFFSET(
+					   attr->maxSections,
+					   attr->maxSectionSize));
+	memset(allocated, 0, sizeof(allocated));
+	memset(alloc_size, 0, sizeof(alloc_size));
+
+	for (retry = 0; retry < CPA_DIRECT_READ_RETRIES; retry++) {
+		/* Several sections are consistent if no write to the replica
+		 * has been done while they were read */
+		if (numberOfElements > 1) {
+			rep_seq = __atomic_load_n(&replica_seq->seq,
+						  __ATOMIC_ACQUIRE);
+			if (rep_seq & 1)
+				continue;
+		}
+
+		for (iter = 0; iter < numberOfElements; iter++) {
+			if (ioVector[iter].sectionId.idLen > MAX_SIZE)
+				goto fallback;
+			index = cpa_proc_sec_find(gc_node,
+						  &ioVector[iter].sectionId);
+			if (index < 0)
+				goto fallback;
+			sec_seq = (const CPSV_SECT_SEQ *)(replica_seq + 1) +
+				  index;
+			sec_hdr =
+			    (const CPSV_SECT_HDR *)(base +
+						    sizeof(CPSV_CKPT_HDR) +
+						    index *
+							(sizeof(CPSV_SECT_HDR) +
+							 attr->maxSectionSize));
+
+			seq = __atomic_load_n(&sec_seq->seq, __ATOMIC_ACQUIRE);
+			/* The section may have been deleted and the slot
+			 * reused since it was found */
+			if ((seq & 1) ||
+			    !cpa_proc_sec_id_match(sec_hdr,
+						   &ioVector[iter].sectionId))
+				break;
+			sec_size = sec_hdr->sec_size;
+			if (sec_size > attr->maxSectionSize ||
+			    ioVector[iter].dataOffset > sec_size)
+				goto fallback;
+
+			/* The same read size as cpnd_ckpt_read_replica() */
+			user_buffer = ioVector[iter].dataBuffer != NULL &&
+				      ioVector[iter].dataBuffer !=
+					  allocated[iter];
+			if (user_buffer && ioVector[iter].dataOffset +
+						   ioVector[iter].dataSize <
+					       sec_size)
+				read_size[iter] = ioVector[iter].dataSize;
+			else
+				read_size[iter] =
+				    sec_size - ioVector[iter].dataOffset;
+
+			if (!user_buffer && read_size[iter] > alloc_size[iter]) {
+				/* Allocated for the user, as in
+				 * cpa_proc_rmt_replica_read() */
+				cpa_proc_direct_read_free(allocated[iter],
+							  version);
+				ioVector[iter].dataBuffer = NULL;
+				alloc_size[iter] = 0;
+				if (m_CPA_VER_IS_ABOVE_B_1_1(version))
+					allocated[iter] =
+					    m_MMGR_ALLOC_CPA_DEFAULT(
+						read_size[iter]);
+				else
+					allocated[iter] =
+					    malloc(read_size[iter]);
+				if (allocated[iter] == NULL)
+					goto fallback;
+				alloc_size[iter] = read_size[iter];
+				ioVector[iter].dataBuffer = allocated[iter];
+			}
+			if (read_size[iter] != 0)
+				memcpy(ioVector[iter].dataBuffer,
+				       (const char *)(sec_hdr + 1) +
+					   ioVector[iter].dataOffset,
+				       read_size[iter]);
+
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+			if (__atomic_load_n(&sec_seq->seq, __ATOMIC_RELAXED) !=
+				seq ||
+			    !__atomic_load_n(&sec_seq->in_use,
+					     __ATOMIC_RELAXED))
+				break;
+		}
+		if (iter != numberOfElements)
+			continue;
+		if (numberOfElements > 1 &&
+		    __atomic_load_n(&replica_seq->seq, __ATOMIC_RELAXED) !=
+			rep_seq)
+			continue;
+
+		for (iter = 0; iter < numberOfElements; iter++) {
+			if (read_size[iter] != 0)
+				ioVector[iter].readSize = read_size[iter];
+		}
+		return NCSCC_RC_SUCCESS;
+	}
+
+fallback:
+	/* Give back what was allocated, CPND reads all sections again */
+	for (iter = 0; iter < numberOfElements; iter++) {
+		if (allocated[iter] == NULL)
+			continue;
+		cpa_proc_direct_read_free(allocated[iter], version);
+		ioVector[iter].dataBuffer = NULL;
+	}
+	return NCSCC_RC_FAILURE;
+}
+
 /****************************************************************************
   Name          : cpa_proc_check_iovector
   Description   : procedure to check IoVector data size with ckpt max sizes
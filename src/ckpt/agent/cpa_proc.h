@@ -23,7 +23,8 @@ typedef enum cpa_callback_type {
   CPA_CALLBACK_TYPE_OPEN = 1,
   CPA_CALLBACK_TYPE_SYNC,
   CPA_CALLBACK_TYPE_ARRIVAL_NTFY,
-  CPA_CALLBACK_TYPE_MAX = CPA_CALLBACK_TYPE_ARRIVAL_NTFY
+  CPA_CALLBACK_TYPE_WRITE,
+  CPA_CALLBACK_TYPE_MAX = CPA_CALLBACK_TYPE_WRITE
 } CPA_CALLBACK_TYPE;
 
 /* Info required for Call back */
@@ -35,6 +36,7 @@ typedef struct cpa_callback_info {
   SaInvocationT invocation;
   SaCkptIOVectorElementT *ioVector;
   SaUint32T num_of_elmts;
+  SaUint32T error_index;
   SaAisErrorT sa_err;
 } CPA_CALLBACK_INFO;
 
@@ -45,6 +47,12 @@ uint32_t cpa_open_attr_validate(
     SaCkptCheckpointOpenFlagsT checkpointOpenFlags);
 
 uint32_t cpa_callback_ipc_init(CPA_CLIENT_NODE *client_info);
+uint32_t cpa_proc_async_write_copy(CPA_ASYNC_WRITE *write);
+uint32_t cpa_proc_async_write_window(CPA_GLOBAL_CKPT_NODE *gc_node);
+uint32_t cpa_proc_async_write_send(CPA_CB *cb, CPA_LOCAL_CKPT_NODE *lc_node,
+                                   CPA_GLOBAL_CKPT_NODE *gc_node,
+                                   CPA_ASYNC_WRITE *write);
+void cpa_proc_async_write_free(CPA_ASYNC_WRITE *write);
 void cpa_callback_ipc_destroy(CPA_CLIENT_NODE *client_info);
 uint32_t cpa_ckpt_finalize_proc(CPA_CB *cb, CPA_CLIENT_NODE *cl_node);
 uint32_t cpa_proc_shm_open(CPA_CB *cb, CPA_GLOBAL_CKPT_NODE *gc_node,
@@ -78,6 +86,14 @@ uint32_t cpa_proc_rmt_replica_read(SaUint32T numberOfElements,
                                    SaUint32T **erroneousVectorIndex,
                                    SaVersionT *version);
 
+uint32_t cpa_proc_direct_replica_read(CPA_CB *cb, CPA_LOCAL_CKPT_NODE *lc_node,
+                                      CPA_GLOBAL_CKPT_NODE *gc_node,
+                                      SaCkptIOVectorElementT *ioVector,
+                                      SaUint32T numberOfElements,
+                                      SaVersionT *version);
+
+void cpa_proc_replica_unmap(CPA_GLOBAL_CKPT_NODE *gc_node);
+
 void cpa_proc_free_read_data(CPSV_ND2A_DATA_ACCESS_RSP *rmt_read_rsp);
 
 void cpa_cb_dump(void);
@@ -51,7 +51,8 @@ void cpa_timer_expiry(NCSCONTEXT uarg)
 		evt.info.cpa.type = CPA_EVT_TIME_OUT;
 		evt.info.cpa.info.tmr_info.type = tmr->type;
 		if ((tmr->type == CPA_TMR_TYPE_OPEN) ||
-		    (tmr->type == CPA_TMR_TYPE_SYNC)) {
+		    (tmr->type == CPA_TMR_TYPE_SYNC) ||
+		    (tmr->type == CPA_TMR_TYPE_WRITE)) {
 			evt.info.cpa.info.tmr_info.lcl_ckpt_hdl =
 			    tmr->info.ckpt.lcl_ckpt_hdl;
 			evt.info.cpa.info.tmr_info.client_hdl =
@@ -0,0 +1,520 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+// ckptbench measures the throughput and the latency of the CKPT API for
+// different kinds of checkpoints, see PrintUsage(). Each configuration is run
+// on a checkpoint of its own, which is unlinked when done.
+
+#include <getopt.h>
+#include <saCkpt.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "base/saf_error.h"
+#include "base/string_parse.h"
+#include "base/time.h"
+
+namespace {
+
+enum Workload {
+  kCreate,
+  kWrite,
+  kOverwrite,
+  kRead,
+  kIterate,
+  kDelete,
+  kNoOfWorkloads
+};
+
+const char* const kWorkloadNames[kNoOfWorkloads] = {
+    "create", "write", "overwrite", "read", "iterate", "delete"};
+
+struct Config {
+  bool collocated;
+  SaCkptCheckpointCreationFlagsT update;
+  uint32_t no_of_sections;
+  SaSizeT section_size;
+};
+
+struct Options {
+  bool workloads[kNoOfWorkloads];
+  std::vector<bool> collocated;
+  SaCkptCheckpointCreationFlagsT update;
+  std::vector<uint32_t> no_of_sections;
+  std::vector<SaSizeT> section_sizes;
+  uint64_t no_of_operations;
+};
+
+void PrintUsage(const char* program_name) {
+  fprintf(stderr,
+          "Usage: %s [OPTION]...\n"
+          "\n"
+          "Measure the throughput and the latency of the CKPT service. A\n"
+          "checkpoint is created for each combination of replica type,\n"
+          "number of sections and section size, and the workloads are run\n"
+          "on it in the order create, write, overwrite, read, iterate,\n"
+          "delete. A line is printed for each workload, with the latencies\n"
+          "in microseconds.\n"
+          "\n"
+          "Options:\n"
+          "\n"
+          "-w or --workloads=LIST  Comma separated list of the workloads to\n"
+          "                        measure, default all:\n"
+          "                        create    saCkptSectionCreate()\n"
+          "                        write     saCkptCheckpointWrite()\n"
+          "                        overwrite saCkptSectionOverwrite()\n"
+          "                        read      saCkptCheckpointRead()\n"
+          "                        iterate   saCkptSectionIterationNext()\n"
+          "                        delete    saCkptSectionDelete()\n"
+          "-r or --replicas=LIST   Comma separated list of replica types,\n"
+          "                        'collocated' and/or 'non-collocated',\n"
+          "                        default both.\n"
+          "-u or --update=MODE     Update option of the checkpoints, 'active',\n"
+          "                        'weak' or 'all', default 'active'.\n"
+          "                        Collocated checkpoints are not run with\n"
+          "                        'all'.\n"
+          "-s or --sections=LIST   Comma separated list of numbers of\n"
+          "                        sections, default 1,1000.\n"
+          "-z or --size=LIST       Comma separated list of section sizes in\n"
+          "                        bytes, default 64,4096,65536.\n"
+          "-n or --operations=N    Number of operations of the write,\n"
+          "                        overwrite, read and iterate workloads,\n"
+          "                        default 10000. The sections are written\n"
+          "                        and read in turn.\n",
+          program_name);
+}
+
+// Split @a str at the commas
+std::vector<std::string> SplitList(const char* str) {
+  std::vector<std::string> items;
+  std::string list = str;
+  size_t pos = 0;
+  while (pos <= list.size()) {
+    size_t comma = list.find(',', pos);
+    if (comma == std::string::npos) comma = list.size();
+    items.push_back(list.substr(pos, comma - pos));
+    pos = comma + 1;
+  }
+  return items;
+}
+
+bool ParseNumbers(const char* str, std::vector<uint64_t>* numbers) {
+  numbers->clear();
+  for (const std::string& item : SplitList(str)) {
+    bool success;
+    uint64_t number = base::StrToUint64(item.c_str(), &success);
+    if (!success || number == 0) return false;
+    numbers->push_back(number);
+  }
+  return true;
+}
+
+// The latencies of the operations of a workload
+class Measurement {
+ public:
+  Measurement() : start_{base::ReadMonotonicClock()}, bytes_{0} {}
+  void Add(const timespec& start, const timespec& end, SaSizeT bytes) {
+    latencies_.push_back(base::TimespecToNanos(end - start));
+    bytes_ += bytes;
+  }
+  void Print(const Config& config, Workload workload) {
+    if (latencies_.empty()) return;
+    double elapsed =
+        base::TimespecToDouble(base::ReadMonotonicClock() - start_);
+    std::sort(latencies_.begin(), latencies_.end());
+    uint64_t sum = 0;
+    for (uint64_t latency : latencies_) sum += latency;
+    size_t ops = latencies_.size();
+    char throughput[32] = "-";
+    if (bytes_ != 0) {
+      snprintf(throughput, sizeof(throughput), "%.1f",
+               bytes_ / elapsed / (1024 * 1024));
+    }
+    printf("%-14s %-6s %8" PRIu32 " %8llu %-9s %8zu %10.0f %9s %9.1f %9.1f "
+           "%9.1f %9.1f\n",
+           config.collocated ? "collocated" : "non-collocated",
+           UpdateName(config.update), config.no_of_sections,
+           config.section_size, kWorkloadNames[workload], ops, ops / elapsed,
+           throughput, sum / 1000.0 / ops, latencies_[ops / 2] / 1000.0,
+           latencies_[ops * 99 / 100] / 1000.0, latencies_.back() / 1000.0);
+    fflush(stdout);
+  }
+  static void PrintHeader() {
+    printf("%-14s %-6s %8s %8s %-9s %8s %10s %9s %9s %9s %9s %9s\n",
+           "replica", "update", "sections", "size", "workload", "ops",
+           "ops/s", "MB/s", "avg_us", "p50_us", "p99_us", "max_us");
+  }
+  static const char* UpdateName(SaCkptCheckpointCreationFlagsT update) {
+    switch (update) {
+      case SA_CKPT_WR_ALL_REPLICAS:
+        return "all";
+      case SA_CKPT_WR_ACTIVE_REPLICA_WEAK:
+        return "weak";
+      default:
+        return "active";
+    }
+  }
+
+ private:
+  timespec start_;
+  std::vector<uint64_t> latencies_;
+  SaSizeT bytes_;
+};
+
+// Call @a function until it does not return SA_AIS_ERR_TRY_AGAIN. The time
+// spent waiting is part of the latency, as for an application.
+template <typename Function>
+SaAisErrorT Retry(Function function) {
+  SaAisErrorT rc;
+  while ((rc = function()) == SA_AIS_ERR_TRY_AGAIN) {
+    base::Sleep(base::MillisToTimespec(1));
+  }
+  return rc;
+}
+
+bool Check(SaAisErrorT rc, const char* api) {
+  if (rc == SA_AIS_OK) return true;
+  fprintf(stderr, "%s failed: %s\n", api, saf_error(rc));
+  return false;
+}
+
+class Benchmark {
+ public:
+  Benchmark(SaCkptHandleT ckpt_handle, const Options& options,
+            const Config& config)
+      : ckpt_handle_{ckpt_handle},
+        options_(options),
+        config_(config),
+        checkpoint_{0},
+        name_{},
+        section_ids_(config.no_of_sections),
+        section_names_(config.no_of_sections),
+        data_(config.section_size, 'x'),
+        buffer_(config.section_size) {
+    snprintf(reinterpret_cast<char*>(name_.value), sizeof(name_.value),
+             "safCkpt=ckptbench_%d_%s_%" PRIu32 "_%llu,safApp=safCkptService",
+             getpid(), config.collocated ? "colloc" : "noncolloc",
+             config.no_of_sections, config.section_size);
+    name_.length = strlen(reinterpret_cast<char*>(name_.value));
+    for (uint32_t i = 0; i != config.no_of_sections; ++i) {
+      section_names_[i] = "section" + std::to_string(i);
+      section_ids_[i].idLen = section_names_[i].size();
+      section_ids_[i].id = reinterpret_cast<SaUint8T*>(&section_names_[i][0]);
+    }
+  }
+
+  bool Run() {
+    SaCkptCheckpointCreationAttributesT attributes;
+    attributes.creationFlags =
+        config_.update |
+        (config_.collocated ? SA_CKPT_CHECKPOINT_COLLOCATED : 0);
+    attributes.checkpointSize =
+        config_.section_size * (config_.no_of_sections + 1);
+    attributes.retentionDuration = 0;
+    // Not 1, which is the checkpoint with only the default section
+    attributes.maxSections = config_.no_of_sections + 1;
+    attributes.maxSectionSize = config_.section_size;
+    attributes.maxSectionIdSize = 32;
+    if (!Check(Retry([&] {
+                 return saCkptCheckpointOpen(
+                     ckpt_handle_, &name_, &attributes,
+                     SA_CKPT_CHECKPOINT_CREATE | SA_CKPT_CHECKPOINT_READ |
+                         SA_CKPT_CHECKPOINT_WRITE,
+                     SA_TIME_ONE_MINUTE, &checkpoint_);
+               }),
+               "saCkptCheckpointOpen")) {
+      return false;
+    }
+    bool ok = true;
+    if (config_.collocated) {
+      ok = Check(Retry([&] { return saCkptActiveReplicaSet(checkpoint_); }),
+                 "saCkptActiveReplicaSet");
+    }
+    ok = ok && Create() && Write() && Overwrite() && Read() && Iterate() &&
+         Delete();
+    Retry([&] { return saCkptCheckpointClose(checkpoint_); });
+    Retry([&] { return saCkptCheckpointUnlink(ckpt_handle_, &name_); });
+    return ok;
+  }
+
+ private:
+  bool Create() {
+    Measurement measurement;
+    for (uint32_t i = 0; i != config_.no_of_sections; ++i) {
+      SaCkptSectionCreationAttributesT attributes;
+      attributes.sectionId = &section_ids_[i];
+      attributes.expirationTime = SA_TIME_END;
+      timespec start = base::ReadMonotonicClock();
+      SaAisErrorT rc = Retry([&] {
+        return saCkptSectionCreate(checkpoint_, &attributes, data_.data(),
+                                   data_.size());
+      });
+      measurement.Add(start, base::ReadMonotonicClock(), data_.size());
+      if (!Check(rc, "saCkptSectionCreate")) return false;
+    }
+    if (options_.workloads[kCreate]) measurement.Print(config_, kCreate);
+    return true;
+  }
+
+  bool Write() {
+    if (!options_.workloads[kWrite]) return true;
+    Measurement measurement;
+    for (uint64_t i = 0; i != options_.no_of_operations; ++i) {
+      SaCkptIOVectorElementT element;
+      memset(&element, 0, sizeof(element));
+      element.sectionId = section_ids_[i % config_.no_of_sections];
+      element.dataBuffer = &data_[0];
+      element.dataSize = data_.size();
+      SaUint32T erroneous_index;
+      timespec start = base::ReadMonotonicClock();
+      SaAisErrorT rc = Retry([&] {
+        return saCkptCheckpointWrite(checkpoint_, &element, 1,
+                                     &erroneous_index);
+      });
+      measurement.Add(start, base::ReadMonotonicClock(), data_.size());
+      if (!Check(rc, "saCkptCheckpointWrite")) return false;
+    }
+    measurement.Print(config_, kWrite);
+    return true;
+  }
+
+  bool Overwrite() {
+    if (!options_.workloads[kOverwrite]) return true;
+    Measurement measurement;
+    for (uint64_t i = 0; i != options_.no_of_operations; ++i) {
+      SaCkptSectionIdT* id = &section_ids_[i % config_.no_of_sections];
+      timespec start = base::ReadMonotonicClock();
+      SaAisErrorT rc = Retry([&] {
+        return saCkptSectionOverwrite(checkpoint_, id, data_.data(),
+                                      data_.size());
+      });
+      measurement.Add(start, base::ReadMonotonicClock(), data_.size());
+      if (!Check(rc, "saCkptSectionOverwrite")) return false;
+    }
+    measurement.Print(config_, kOverwrite);
+    return true;
+  }
+
+  bool Read() {
+    if (!options_.workloads[kRead]) return true;
+    Measurement measurement;
+    for (uint64_t i = 0; i != options_.no_of_operations; ++i) {
+      SaCkptIOVectorElementT element;
+      memset(&element, 0, sizeof(element));
+      element.sectionId = section_ids_[i % config_.no_of_sections];
+      element.dataBuffer = buffer_.data();
+      element.dataSize = buffer_.size();
+      SaUint32T erroneous_index;
+      timespec start = base::ReadMonotonicClock();
+      SaAisErrorT rc = Retry([&] {
+        return saCkptCheckpointRead(checkpoint_, &element, 1,
+                                    &erroneous_index);
+      });
+      measurement.Add(start, base::ReadMonotonicClock(), element.readSize);
+      if (!Check(rc, "saCkptCheckpointRead")) return false;
+    }
+    measurement.Print(config_, kRead);
+    return true;
+  }
+
+  // The sections are iterated over until no_of_operations sections have
+  // been returned. Only saCkptSectionIterationNext() is measured.
+  bool Iterate() {
+    if (!options_.workloads[kIterate]) return true;
+    Measurement measurement;
+    uint64_t ops = 0;
+    while (ops < options_.no_of_operations) {
+      SaCkptSectionIterationHandleT iterator;
+      if (!Check(Retry([&] {
+                   return saCkptSectionIterationInitialize(
+                       checkpoint_, SA_CKPT_SECTIONS_ANY, 0, &iterator);
+                 }),
+                 "saCkptSectionIterationInitialize")) {
+        return false;
+      }
+      SaAisErrorT rc = SA_AIS_OK;
+      while (ops < options_.no_of_operations) {
+        SaCkptSectionDescriptorT descriptor;
+        timespec start = base::ReadMonotonicClock();
+        rc = Retry([&] {
+          return saCkptSectionIterationNext(iterator, &descriptor);
+        });
+        if (rc != SA_AIS_OK) break;
+        measurement.Add(start, base::ReadMonotonicClock(), 0);
+        ++ops;
+      }
+      saCkptSectionIterationFinalize(iterator);
+      if (rc != SA_AIS_OK && rc != SA_AIS_ERR_NO_SECTIONS) {
+        return Check(rc, "saCkptSectionIterationNext");
+      }
+    }
+    measurement.Print(config_, kIterate);
+    return true;
+  }
+
+  bool Delete() {
+    if (!options_.workloads[kDelete]) return true;
+    Measurement measurement;
+    for (uint32_t i = 0; i != config_.no_of_sections; ++i) {
+      timespec start = base::ReadMonotonicClock();
+      SaAisErrorT rc = Retry(
+          [&] { return saCkptSectionDelete(checkpoint_, &section_ids_[i]); });
+      measurement.Add(start, base::ReadMonotonicClock(), 0);
+      if (!Check(rc, "saCkptSectionDelete")) return false;
+    }
+    measurement.Print(config_, kDelete);
+    return true;
+  }
+
+  SaCkptHandleT ckpt_handle_;
+  const Options& options_;
+  const Config config_;
+  SaCkptCheckpointHandleT checkpoint_;
+  SaNameT name_;
+  std::vector<SaCkptSectionIdT> section_ids_;
+  std::vector<std::string> section_names_;
+  std::string data_;
+  std::vector<char> buffer_;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  struct option long_options[] = {
+      {"workloads", required_argument, nullptr, 'w'},
+      {"replicas", required_argument, nullptr, 'r'},
+      {"update", required_argument, nullptr, 'u'},
+      {"sections", required_argument, nullptr, 's'},
+      {"size", required_argument, nullptr, 'z'},
+      {"operations", required_argument, nullptr, 'n'},
+      {"help", no_argument, nullptr, 'h'},
+      {nullptr, 0, nullptr, 0}};
+  Options options;
+  std::fill(options.workloads, options.workloads + kNoOfWorkloads, true);
+  options.collocated = {true, false};
+  options.update = SA_CKPT_WR_ACTIVE_REPLICA;
+  options.no_of_sections = {1, 1000};
+  options.section_sizes = {64, 4096, 65536};
+  options.no_of_operations = 10000;
+  std::vector<uint64_t> numbers;
+  int option;
+  while ((option = getopt_long(argc, argv, "w:r:u:s:z:n:h", long_options,
+                               nullptr)) != -1) {
+    switch (option) {
+      case 'w':
+        std::fill(options.workloads, options.workloads + kNoOfWorkloads,
+                  false);
+        for (const std::string& item : SplitList(optarg)) {
+          const char* const* name = std::find(
+              kWorkloadNames, kWorkloadNames + kNoOfWorkloads, item);
+          if (name == kWorkloadNames + kNoOfWorkloads) {
+            fprintf(stderr, "Illegal workload '%s'\n", item.c_str());
+            exit(EXIT_FAILURE);
+          }
+          options.workloads[name - kWorkloadNames] = true;
+        }
+        break;
+      case 'r':
+        options.collocated.clear();
+        for (const std::string& item : SplitList(optarg)) {
+          if (item != "collocated" && item != "non-collocated") {
+            fprintf(stderr, "Illegal replica type '%s'\n", item.c_str());
+            exit(EXIT_FAILURE);
+          }
+          options.collocated.push_back(item == "collocated");
+        }
+        break;
+      case 'u':
+        if (strcmp(optarg, "active") == 0) {
+          options.update = SA_CKPT_WR_ACTIVE_REPLICA;
+        } else if (strcmp(optarg, "weak") == 0) {
+          options.update = SA_CKPT_WR_ACTIVE_REPLICA_WEAK;
+        } else if (strcmp(optarg, "all") == 0) {
+          options.update = SA_CKPT_WR_ALL_REPLICAS;
+        } else {
+          fprintf(stderr, "Illegal update option '%s'\n", optarg);
+          exit(EXIT_FAILURE);
+        }
+        break;
+      case 's':
+        if (!ParseNumbers(optarg, &numbers)) {
+          fprintf(stderr, "Illegal number of sections '%s'\n", optarg);
+          exit(EXIT_FAILURE);
+        }
+        options.no_of_sections.assign(numbers.begin(), numbers.end());
+        break;
+      case 'z':
+        if (!ParseNumbers(optarg, &numbers)) {
+          fprintf(stderr, "Illegal section size '%s'\n", optarg);
+          exit(EXIT_FAILURE);
+        }
+        options.section_sizes.assign(numbers.begin(), numbers.end());
+        break;
+      case 'n': {
+        bool success;
+        options.no_of_operations = base::StrToUint64(optarg, &success);
+        if (!success || options.no_of_operations == 0) {
+          fprintf(stderr, "Illegal number of operations '%s'\n", optarg);
+          exit(EXIT_FAILURE);
+        }
+        break;
+      }
+      case 'h':
+        PrintUsage(argv[0]);
+        exit(EXIT_SUCCESS);
+      default:
+        PrintUsage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+  }
+  if (optind != argc) {
+    PrintUsage(argv[0]);
+    exit(EXIT_FAILURE);
+  }
+
+  SaCkptHandleT ckpt_handle;
+  SaVersionT version = {'B', 2, 2};
+  if (!Check(Retry([&] {
+               return saCkptInitialize(&ckpt_handle, nullptr, &version);
+             }),
+             "saCkptInitialize")) {
+    exit(EXIT_FAILURE);
+  }
+
+  bool ok = true;
+  Measurement::PrintHeader();
+  for (bool collocated : options.collocated) {
+    if (collocated && options.update == SA_CKPT_WR_ALL_REPLICAS) {
+      fprintf(stderr, "Collocated checkpoints skipped with update 'all'\n");
+      continue;
+    }
+    for (uint32_t no_of_sections : options.no_of_sections) {
+      for (SaSizeT section_size : options.section_sizes) {
+        Config config{collocated, options.update, no_of_sections,
+                      section_size};
+        Benchmark benchmark{ckpt_handle, options, config};
+        if (!benchmark.Run()) ok = false;
+      }
+    }
+  }
+
+  saCkptFinalize(ckpt_handle);
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
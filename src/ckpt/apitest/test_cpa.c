@@ -7981,6 +7981,178 @@ final1:
 	test_validate(result, TEST_PASS);
 }
 
+/******* CKPT Async Write *******/
+
+#define ASYNC_WRITES 16
+
+static int async_write_clbk_count;
+static int async_write_clbk_err;
+
+static void AppCkptWriteCallback(SaInvocationT invocation,
+				 SaCkptCheckpointHandleT checkpointHandle,
+				 SaUint32T erroneousVectorIndex,
+				 SaAisErrorT error)
+{
+	/* The writes of a checkpoint handle are done in the order issued */
+	if (invocation != async_write_clbk_count ||
+	    checkpointHandle != tcd.all_replicas_Writehdl ||
+	    error != SA_AIS_OK) {
+		m_TEST_CPSV_PRINTF(
+		    "\nWrite callback invocation %llu, expected %d, error %s\n",
+		    invocation, async_write_clbk_count,
+		    saf_error_string[error]);
+		async_write_clbk_err = 1;
+	}
+	async_write_clbk_count++;
+}
+
+void cpsv_it_asyncwrite_01()
+{
+	int result;
+	int i;
+	SaAisErrorT rc;
+	fd_set read_fd;
+	struct timeval tv;
+	char data[ASYNC_WRITES][16];
+	char buffer[16];
+	SaCkptIOVectorElementT write_vec, read_vec;
+	SaUint32T index;
+
+	async_write_clbk_count = 0;
+	async_write_clbk_err = 0;
+	printHead("To verify that async writes are done and called back in "
+		  "order");
+	result = test_ckptInitialize(CKPT_INIT_SUCCESS_T, TEST_CONFIG_MODE);
+	if (result != TEST_PASS)
+		goto final1;
+
+	result =
+	    test_ckptSelectionObject(CKPT_SEL_SUCCESS_T, TEST_NONCONFIG_MODE);
+	if (result != TEST_PASS)
+		goto final2;
+
+	result =
+	    test_ckptOpen(CKPT_OPEN_ALL_CREATE_SUCCESS_T, TEST_CONFIG_MODE);
+	if (result != TEST_PASS)
+		goto final2;
+
+	result = test_ckptOpen(CKPT_OPEN_ALL_WRITE_SUCCESS_T, TEST_CONFIG_MODE);
+	if (result != TEST_PASS)
+		goto final3;
+
+	result = test_ckptSectionCreate(CKPT_SECTION_CREATE_SUCCESS_T,
+					TEST_CONFIG_MODE);
+	if (result != TEST_PASS)
+		goto final3;
+
+	rc = ncsCkptRegisterCkptWriteCallback(tcd.ckptHandle,
+					      AppCkptWriteCallback);
+	if (rc != SA_AIS_OK) {
+		m_TEST_CPSV_PRINTF(" Return Value    : %s\n\n",
+				   saf_error_string[rc]);
+		result = TEST_FAIL;
+		goto final3;
+	}
+
+	/* Each write replaces the data of the one before, the ioVector is
+	 * reused right away */
+	for (i = 0; i < ASYNC_WRITES; i++) {
+		snprintf(data[i], sizeof(data[i]), "async write %02d", i);
+		fill_write_iovec(&write_vec, tcd.section1, data[i],
+				 strlen(data[i]), 0, 0);
+		while ((rc = ncsCkptCheckpointWriteAsync(
+			    tcd.all_replicas_Writehdl, i, &write_vec, 1)) ==
+		       SA_AIS_ERR_TRY_AGAIN)
+			saCkptDispatch(tcd.ckptHandle, SA_DISPATCH_ALL);
+		memset(data[i], 'x', sizeof(data[i]) - 1);
+		if (rc != SA_AIS_OK) {
+			m_TEST_CPSV_PRINTF(" Return Value    : %s\n\n",
+					   saf_error_string[rc]);
+			result = TEST_FAIL;
+			goto final3;
+		}
+	}
+
+	while (async_write_clbk_count < ASYNC_WRITES) {
+		FD_ZERO(&read_fd);
+		FD_SET(tcd.selobj, &read_fd);
+		tv.tv_sec = 10;
+		tv.tv_usec = 0;
+		if (select(tcd.selobj + 1, &read_fd, NULL, NULL, &tv) != 1) {
+			m_TEST_CPSV_PRINTF("\n%d of %d write callbacks\n",
+					   async_write_clbk_count,
+					   ASYNC_WRITES);
+			result = TEST_FAIL;
+			goto final3;
+		}
+		saCkptDispatch(tcd.ckptHandle, SA_DISPATCH_ALL);
+	}
+
+	if (async_write_clbk_err) {
+		result = TEST_FAIL;
+		goto final3;
+	}
+
+	/* The last write is the one left in the section */
+	memset(buffer, 0, sizeof(buffer));
+	fill_read_iovec(&read_vec, tcd.section1, buffer,
+			strlen("async write 00"), 0, 0);
+	rc = saCkptCheckpointRead(tcd.all_replicas_Writehdl, &read_vec, 1,
+				  &index);
+	snprintf(data[0], sizeof(data[0]), "async write %02d",
+		 ASYNC_WRITES - 1);
+	if (rc != SA_AIS_OK || strcmp(buffer, data[0]) != 0) {
+		m_TEST_CPSV_PRINTF("\nRead %s: '%s'\n", saf_error_string[rc],
+				   buffer);
+		result = TEST_FAIL;
+	} else
+		result = TEST_PASS;
+
+final3:
+	test_ckpt_cleanup(CPSV_CLEAN_ALL_REPLICAS_CKPT);
+final2:
+	test_cpsv_cleanup(CPSV_CLEAN_INIT_SUCCESS_T);
+final1:
+	printResult(result);
+	test_validate(result, TEST_PASS);
+}
+
+void cpsv_it_asyncwrite_02()
+{
+	int result;
+	SaAisErrorT rc;
+	printHead("To verify that an async write needs the write callback");
+	result = test_ckptInitialize(CKPT_INIT_SUCCESS_T, TEST_CONFIG_MODE);
+	if (result != TEST_PASS)
+		goto final1;
+
+	result =
+	    test_ckptOpen(CKPT_OPEN_ALL_CREATE_SUCCESS_T, TEST_CONFIG_MODE);
+	if (result != TEST_PASS)
+		goto final2;
+
+	result = test_ckptOpen(CKPT_OPEN_ALL_WRITE_SUCCESS_T, TEST_CONFIG_MODE);
+	if (result != TEST_PASS)
+		goto final3;
+
+	rc = ncsCkptCheckpointWriteAsync(tcd.all_replicas_Writehdl, 0,
+					 &tcd.general_write, 1);
+	m_TEST_CPSV_PRINTF(" Return Value    : %s\n\n", saf_error_string[rc]);
+
+	if (rc == SA_AIS_ERR_INIT)
+		result = TEST_PASS;
+	else
+		result = TEST_FAIL;
+
+final3:
+	test_ckpt_cleanup(CPSV_CLEAN_ALL_REPLICAS_CKPT);
+final2:
+	test_cpsv_cleanup(CPSV_CLEAN_INIT_SUCCESS_T);
+final1:
+	printResult(result);
+	test_validate(result, TEST_PASS);
+}
+
 /********** END OF TEST CASES ************/
 
 __attribute__((constructor)) static void ckpt_cpa_test_constructor(void)
@@ -8600,4 +8772,11 @@ __attribute__((constructor)) static void ckpt_cpa_test_constructor(void)
 			cpsv_it_ntf_02,
 			"To verify that Resource Available Notification is "
 			"received");
+
+	test_suite_add(26, "CKPT Async Write");
+	test_case_add(26, cpsv_it_asyncwrite_01,
+		      "To verify that async writes are done and called back in "
+		      "order");
+	test_case_add(26, cpsv_it_asyncwrite_02,
+		      "To verify that an async write needs the write callback");
 }
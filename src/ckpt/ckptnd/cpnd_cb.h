@@ -35,8 +35,6 @@ extern uint32_t gl_cpnd_cb_hdl;
 #define m_CPND_GIVEUP_CPND_CB ncshm_give_hdl(gl_cpnd_cb_hdl)
 
 #define CPND_MAX_REPLICAS 1000
-#define CPND_MAX_REPLICA_NAME_LENGTH 255
-#define CPND_REP_NAME_MAX_CKPT_NAME_LENGTH (CPND_MAX_REPLICA_NAME_LENGTH - 32)
 
 #define CPSV_GEN_SECTION_ID_SIZE 4
 #define CPSV_WAIT_TIME 1000
@@ -48,6 +46,10 @@ extern uint32_t gl_cpnd_cb_hdl;
        ? 1300                      \
        : 1500 + ((datasize / CPSV_AVG_DATA_SIZE) * 200))
 
+/* Writes to all replicas in flight per checkpoint, and writes per batch */
+#define CPND_REPL_WINDOW_DEFAULT 4
+#define CPND_REPL_BATCH_MAX_WRITES 64
+
 #define m_CPND_IS_LOCAL_NODE(m, n) memcmp(m, n, sizeof(MDS_DEST))
 
 #define m_CPND_IS_ALL_REPLICA_ATTR_SET(attr) \
@@ -150,8 +152,9 @@ typedef struct cpnd_ckpt_replica_info_tag {
   SaUint32T mem_used;             /* Used for status */
   NCS_OS_POSIX_SHM_REQ_INFO open; /* for shm open */
   uint32_t *shm_sec_mapping;      /* for validity of sec */
-  void *section_db;               /* used for C++ STL map */
-  void *local_section_db;         /* used for C++ STL map */
+  uint32_t *free_sec_ids;         /* stack of the free lcl_sec_ids */
+  uint32_t n_free_sec_ids;
+  void *section_db;               /* used for C++ section index */
 } CPND_CKPT_REPLICA_INFO;
 
 /*Structure to store info for ALL_REPL_WRITE EVT processing*/
@@ -165,9 +168,39 @@ typedef struct cpnd_all_repl_write_evt_node {
   CPSV_CPND_UPDATE_DEST *cpnd_update_dest_list;
   CPSV_SEND_INFO sinfo;
   SaCkptCheckpointHandleT lcl_ckpt_id;
-  /* struct cpnd_all_repl_write_evt_node *next;*/
+  /* Next write in the same batch, answered together with this one */
+  struct cpnd_all_repl_write_evt_node *next;
 } CPSV_CPND_ALL_REPL_EVT_NODE;
 
+/******************************************************************************
+ Batch of writes to all replicas waiting to be sent to the remote replicas, see
+ cpnd_proc_update_remote(). The writes have the same access type and are sent
+ in one message, the first write being the one the remote replicas respond to.
+ *****************************************************************************/
+typedef struct cpnd_repl_batch {
+  CPSV_CKPT_ACCESS write; /* Copy of the data of all the writes */
+  CPSV_CKPT_DATA *last_data;
+  uint32_t num_of_writes;
+  CPSV_CPND_ALL_REPL_EVT_NODE *evt_list;
+  CPSV_CPND_ALL_REPL_EVT_NODE *last_evt;
+  struct cpnd_repl_batch *next;
+} CPND_REPL_BATCH;
+
+/******************************************************************************
+ Transfer of the sections of the active replica to a new replica, see
+ cpnd_proc_repl_sync_start(). The sections are sent a chunk at a time, the
+ CPND going on with other events in between. The new replica gets the updates
+ to the checkpoint from the start of the transfer, so a chunk has the current
+ data of its sections.
+ *****************************************************************************/
+typedef struct cpnd_repl_sync {
+  MDS_DEST dest;            /* CPND of the new replica */
+  CPSV_A2ND_CKPT_SYNC sync; /* The sync request, sent back in each chunk */
+  CPND_CKPT_SECTION_INFO *next_sec; /* Next section to send, NULL if done */
+  uint32_t seqno;
+  struct cpnd_repl_sync *next;
+} CPND_REPL_SYNC;
+
 /******************************************************************************
  The checkpoint node that goes into particia tree cpnd_ckpt_info of CPND_CB
  *****************************************************************************/
@@ -214,6 +247,12 @@ typedef struct cpnd_ckpt_node {
       cpa_sinfo; /* Used in unlink flow while sending response to CPA */
   bool cpa_sinfo_flag;
   CPND_TMR open_active_sync_tmr;
+  /* Batches of writes to all replicas sent and not yet responded to by all
+     the remote replicas, at most cb->repl_window */
+  uint32_t repl_in_flight;
+  CPND_REPL_BATCH *repl_batch_list; /* Batches waiting to be sent */
+  CPND_REPL_BATCH *repl_batch_last;
+  CPND_REPL_SYNC *repl_sync_list; /* Transfers to new replicas */
 } CPND_CKPT_NODE;
 
 #define CPND_CKPT_NODE_NULL ((CPND_CKPT_NODE *)0)
@@ -337,6 +376,7 @@ typedef struct cpnd_cb_tag {
 
   bool scAbsenceAllowed;
   int shm_alloc_guaranteed;
+  uint32_t repl_window; /* Max batches of writes to all replicas in flight */
 
   NCS_SEL_OBJ clm_updated_sel_obj; /* The CLM select object updated event */
 
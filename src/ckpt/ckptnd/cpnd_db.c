@@ -152,6 +152,9 @@ void cpnd_ckpt_node_destroy(CPND_CB *cb, CPND_CKPT_NODE *cp_node)
 	/* Remove the cp_node from patricia */
 	cpnd_ckpt_node_del(cb, cp_node);
 
+	cpnd_proc_all_repl_batch_cleanup(cb, cp_node);
+	cpnd_proc_repl_sync_cleanup(cp_node);
+
 	tmp = cp_node->cpnd_dest_list;
 	while (tmp != NULL) {
 		free_tmp = tmp;
@@ -438,6 +441,7 @@ CPND_CKPT_SECTION_INFO *cpnd_ckpt_sec_add(CPND_CB *cb, CPND_CKPT_NODE *cp_node,
 	pSecPtr = m_MMGR_ALLOC_CPND_CKPT_SECTION_INFO;
 	if (pSecPtr == NULL) {
 		LOG_ER("cpnd ckpt section info memory allocation failed");
+		cpnd_ckpt_put_lck_sec_id(cp_node, lcl_sec_id);
 		return NULL;
 	}
 
@@ -519,6 +523,7 @@ section_add_fails:
 
 sec_id_allocate_fails:
 	m_MMGR_FREE_CPND_CPND_CKPT_SECTION_INFO(pSecPtr);
+	cpnd_ckpt_put_lck_sec_id(cp_node, lcl_sec_id);
 	TRACE_LEAVE();
 	return NULL;
 }
@@ -648,6 +653,8 @@ void cpnd_ckpt_node_tree_cleanup(CPND_CB *cb)
 		}
 
 		cpnd_ckpt_replica_destroy(cb, cp_node, &error);
+		cpnd_proc_all_repl_batch_cleanup(cb, cp_node);
+		cpnd_proc_repl_sync_cleanup(cp_node);
 
 		ncs_patricia_tree_del(&cb->ckpt_info_db,
 				      (NCS_PATRICIA_NODE *)&cp_node->patnode);
@@ -443,6 +443,10 @@ void cpnd_process_evt(CPSV_EVT *evt)
 	case CPND_EVT_CB_DUMP:
 		(void)cpnd_evt_proc_cb_dump(cb);
 		break;
+	case CPND_EVT_REPL_SYNC:
+		(void)cpnd_proc_repl_sync_next(cb,
+					       &evt->info.cpnd.info.repl_sync);
+		break;
 	case CPND_EVT_A2ND_CKPT_REFCNTSET:
 		(void)cpnd_evt_proc_ckpt_refcntset(cb, &evt->info.cpnd);
 		break;
@@ -2658,10 +2662,12 @@ static uint32_t cpnd_evt_proc_ckpt_sect_create(CPND_CB *cb, CPND_EVT *evt,
 		goto agent_rsp;
 	}
 
-	/* CPND REDUNDANCY */
+	/* CPND REDUNDANCY. Writes waiting to be sent to the remote replicas
+	 * shall reach them before the section is created there */
 	if ((true == cp_node->is_restart) ||
 	    (m_CPND_IS_LOCAL_NODE(&cp_node->active_mds_dest,
-				  &cb->cpnd_mdest_id) != 0)) {
+				  &cb->cpnd_mdest_id) != 0) ||
+	    (cp_node->repl_batch_list != NULL)) {
 		send_evt.type = CPSV_EVT_TYPE_CPA;
 		send_evt.info.cpa.type = CPA_EVT_ND2A_SEC_CREATE_RSP;
 		send_evt.info.cpa.info.sec_creat_rsp.error =
@@ -2996,12 +3002,10 @@ static uint32_t cpnd_evt_proc_ckpt_sect_create(CPND_CB *cb, CPND_EVT *evt,
 
 								if (tmp_sec_info ==
 								    sec_info) {
-									cp_node
-									    ->replica_info
-									    .shm_sec_mapping
-										[sec_info
-										     ->lcl_sec_id] =
-									    1;
+									cpnd_ckpt_put_lck_sec_id(
+									    cp_node,
+									    sec_info
+										->lcl_sec_id);
 									m_CPND_FREE_CKPT_SECTION(
 									    sec_info);
 								} else {
@@ -3140,10 +3144,12 @@ static uint32_t cpnd_evt_proc_ckpt_sect_delete(CPND_CB *cb, CPND_EVT *evt,
 		    SA_AIS_ERR_NOT_EXIST;
 		goto agent_rsp;
 	}
-	/* CPND REDUNDANCY */
+	/* CPND REDUNDANCY. Writes waiting to be sent to the remote replicas
+	 * shall reach them before the section is deleted there */
 	if ((true == cp_node->is_restart) ||
 	    (m_CPND_IS_LOCAL_NODE(&cp_node->active_mds_dest,
-				  &cb->cpnd_mdest_id) != 0)) {
+				  &cb->cpnd_mdest_id) != 0) ||
+	    (cp_node->repl_batch_list != NULL)) {
 		send_evt.type = CPSV_EVT_TYPE_CPA;
 		send_evt.info.cpa.type = CPA_EVT_ND2A_SEC_DELETE_RSP;
 		send_evt.info.cpa.info.sec_delete_rsp.error =
@@ -3176,7 +3182,7 @@ static uint32_t cpnd_evt_proc_ckpt_sect_delete(CPND_CB *cb, CPND_EVT *evt,
 			    SA_AIS_ERR_INVALID_PARAM;
 			goto agent_rsp;
 		}
-		cp_node->replica_info.shm_sec_mapping[sec_info->lcl_sec_id] = 1;
+		cpnd_ckpt_put_lck_sec_id(cp_node, sec_info->lcl_sec_id);
 
 		/* Send the arrival callback */
 		memset(&ckpt_data, '\0', sizeof(CPSV_CKPT_DATA));
@@ -3512,7 +3518,7 @@ static uint32_t cpnd_evt_proc_nd2nd_ckpt_sect_delete(CPND_CB *cb, CPND_EVT *evt,
 		}
 	} else {
 		/* resetting lcl_sec_id mapping */
-		cp_node->replica_info.shm_sec_mapping[sec_info->lcl_sec_id] = 1;
+		cpnd_ckpt_put_lck_sec_id(cp_node, sec_info->lcl_sec_id);
 	}
 
 	/* Send the arrival callback */
@@ -3865,7 +3871,16 @@ static uint32_t cpnd_evt_proc_ckpt_write(CPND_CB *cb, CPND_EVT *evt,
 		goto agent_rsp;
 
 agent_rsp:
-	rc = cpnd_mds_send_rsp(cb, sinfo, &send_evt);
+	/* An async write, see ncsCkptCheckpointWriteAsync, is responded to
+	 * with a message identifying its checkpoint handle */
+	if (sinfo->stype == MDS_SENDTYPE_SNDRSP) {
+		rc = cpnd_mds_send_rsp(cb, sinfo, &send_evt);
+	} else {
+		send_evt.info.cpa.info.sec_data_rsp.lcl_ckpt_id =
+		    evt->info.ckpt_write.lcl_ckpt_id;
+		rc = cpnd_mds_msg_send(cb, sinfo->to_svc, sinfo->dest,
+				       &send_evt);
+	}
 	TRACE_LEAVE();
 	return rc;
 }
@@ -4001,7 +4016,6 @@ cpnd_evt_proc_nd2nd_ckpt_active_data_access_rsp(CPND_CB *cb, CPND_EVT *evt,
 	uint32_t rc = NCSCC_RC_SUCCESS;
 	CPND_CKPT_NODE *cp_node = NULL;
 	CPSV_CPND_ALL_REPL_EVT_NODE *evt_node = NULL;
-	CPSV_EVT rsp_evt;
 	SaAisErrorT error = SA_AIS_OK;
 
 	TRACE_ENTER();
@@ -4009,10 +4023,14 @@ cpnd_evt_proc_nd2nd_ckpt_active_data_access_rsp(CPND_CB *cb, CPND_EVT *evt,
 	cpnd_evt_node_get(cb, evt->info.ckpt_nd2nd_data_rsp.lcl_ckpt_id,
 			  &evt_node);
 
-	memset(&rsp_evt, '\0', sizeof(CPSV_EVT));
-
-	rsp_evt.type = CPSV_EVT_TYPE_CPA;
-	rsp_evt.info.cpa.type = CPA_EVT_ND2A_CKPT_DATA_RSP;
+	/* A write waiting in a batch has not been sent, the response is to
+	 * an earlier write which has timed out */
+	if (evt_node && evt_node->cpnd_update_dest_list == NULL) {
+		TRACE_4("cpnd stale write rsp for lcl_ckpt_id:%llx",
+			evt->info.ckpt_nd2nd_data_rsp.lcl_ckpt_id);
+		TRACE_LEAVE();
+		return rc;
+	}
 
 	if (cp_node && evt_node) {
 		if (cp_node->ckpt_id == evt_node->ckpt_id) {
@@ -4045,34 +4063,10 @@ cpnd_evt_proc_nd2nd_ckpt_active_data_access_rsp(CPND_CB *cb, CPND_EVT *evt,
 			}
 
 			if (evt_node->write_rsp_cnt == 0) {
-				if (evt_node->write_rsp_tmr.is_active)
-					cpnd_tmr_stop(&evt_node->write_rsp_tmr);
-				/*Send OK response to CPA */
-				switch (evt->info.ckpt_write.type) {
-				case CPSV_DATA_ACCESS_WRITE_RSP:
-					rsp_evt.info.cpa.info.sec_data_rsp
-					    .type = CPSV_DATA_ACCESS_WRITE_RSP;
-					rsp_evt.info.cpa.info.sec_data_rsp
-					    .error = SA_AIS_OK;
-					break;
-
-				case CPSV_DATA_ACCESS_OVWRITE_RSP:
-					rsp_evt.info.cpa.info.sec_data_rsp
-					    .type =
-					    CPSV_DATA_ACCESS_OVWRITE_RSP;
-					rsp_evt.info.cpa.info.sec_data_rsp.info
-					    .ovwrite_error.error = SA_AIS_OK;
-					break;
-				}
-				rc = cpnd_mds_send_rsp(cb, &evt_node->sinfo,
-						       &rsp_evt);
-
-				/*Remove the all repl event node */
-				rc = cpnd_evt_node_del(cb, evt_node);
-				/*Free the memory */
-				if (evt_node)
-					cpnd_allrepl_write_evt_node_free(
-					    evt_node);
+				/*Send OK response to CPA, to all the writes
+				 * of the batch */
+				rc = cpnd_proc_all_repl_write_done(cb, evt_node,
+								   SA_AIS_OK);
 			}
 
 		} else {
@@ -4111,33 +4105,9 @@ cpnd_evt_proc_nd2nd_ckpt_active_data_access_rsp(CPND_CB *cb, CPND_EVT *evt,
 
 error:
 	if (evt_node != NULL) {
-
-		if (evt_node->write_rsp_tmr.is_active)
-			cpnd_tmr_stop(&evt_node->write_rsp_tmr);
-
 		/*Send Error response to CPA */
-		switch (evt->info.ckpt_write.type) {
-		case CPSV_DATA_ACCESS_WRITE_RSP:
-			rsp_evt.info.cpa.info.sec_data_rsp.type =
-			    CPSV_DATA_ACCESS_WRITE_RSP;
-			rsp_evt.info.cpa.info.sec_data_rsp.error = error;
-			break;
-
-		case CPSV_DATA_ACCESS_OVWRITE_RSP:
-			rsp_evt.info.cpa.info.sec_data_rsp.type =
-			    CPSV_DATA_ACCESS_OVWRITE_RSP;
-			rsp_evt.info.cpa.info.sec_data_rsp.info.ovwrite_error
-			    .error = error;
-			break;
-		}
-		rc = cpnd_mds_send_rsp(cb, &evt_node->sinfo, &rsp_evt);
-
-		/*Remove the all repl event node */
-		rc = cpnd_evt_node_del(cb, evt_node);
-		/*Free the memory */
-		cpnd_allrepl_write_evt_node_free(evt_node);
+		rc = cpnd_proc_all_repl_write_done(cb, evt_node, error);
 	}
-
 	TRACE_LEAVE();
 	return rc;
 }
@@ -4341,25 +4311,27 @@ static uint32_t cpnd_evt_proc_nd2nd_ckpt_sync_req(CPND_CB *cb, CPND_EVT *evt,
 		rc = cpnd_mds_send_rsp(cb, sinfo, &send_evt);
 	}
 
-	if ((cp_node->replica_info.n_secs > 0) &&
-	    !cpnd_ckpt_sec_empty(&cp_node->replica_info)) {
+	if (evt->info.sync_req.is_ckpt_open) {
+		/* Add the new replica's MDS_DEST to the dest list of this
+		 * replica, it gets the updates made during the transfer */
+		rc = cpnd_ckpt_remote_cpnd_add(cp_node, sinfo->dest);
 
-		if (evt->info.sync_req.is_ckpt_open) {
+		if ((cp_node->replica_info.n_secs > 0) &&
+		    !cpnd_ckpt_sec_empty(&cp_node->replica_info) &&
+		    (cpnd_proc_repl_sync_start(cb, cp_node, sinfo->dest,
+					       &evt->info.sync_req) !=
+		     NCSCC_RC_SUCCESS)) {
 			dest_list.dest = sinfo->dest;
 			dest_list.next = NULL;
 			cpnd_transfer_replica(cb, cp_node,
 					      evt->info.sync_req.ckpt_id,
 					      &dest_list, evt->info.sync_req);
-		} else
-			cpnd_transfer_replica(
-			    cb, cp_node, evt->info.sync_req.ckpt_id,
-			    cp_node->cpnd_dest_list, evt->info.sync_req);
-	}
-
-	if (evt->info.sync_req.is_ckpt_open) {
-		/* Add the new replica's MDS_DEST to the dest list of this
-		 * replica */
-		rc = cpnd_ckpt_remote_cpnd_add(cp_node, sinfo->dest);
+		}
+	} else if ((cp_node->replica_info.n_secs > 0) &&
+		   !cpnd_ckpt_sec_empty(&cp_node->replica_info)) {
+		cpnd_transfer_replica(cb, cp_node, evt->info.sync_req.ckpt_id,
+				      cp_node->cpnd_dest_list,
+				      evt->info.sync_req);
 	}
 
 	TRACE_LEAVE();
@@ -5026,8 +4998,7 @@ static uint32_t cpnd_evt_proc_ckpt_destroy(CPND_CB *cb, CPND_EVT *evt,
 			m_MMGR_FREE_CPND_DEFAULT(
 			    cp_node->replica_info.open.info.open.i_name);
 			/* freeing the sec_mapping memory */
-			m_MMGR_FREE_CPND_DEFAULT(
-			    cp_node->replica_info.shm_sec_mapping);
+			cpnd_ckpt_sec_mapping_free(cp_node);
 		}
 
 		TRACE_4("cpnd ckpt replica destroy success for ckpt_id:%llx",
@@ -228,6 +228,13 @@ static uint32_t cpnd_lib_init(CPND_CREATE_INFO *info)
 		cb->shm_alloc_guaranteed = 2;
 	}
 
+	/* Get the window of writes to all replicas */
+	cb->repl_window = CPND_REPL_WINDOW_DEFAULT;
+	if ((ptr = getenv("OSAF_CKPT_REPL_WINDOW")) != NULL) {
+		if (atoi(ptr) > 0)
+			cb->repl_window = atoi(ptr);
+	}
+
 	/* create a mail box */
 	if ((rc = m_NCS_IPC_CREATE(&cb->cpnd_mbx)) != NCSCC_RC_SUCCESS) {
 		LOG_ER("cpnd ipc create fail");
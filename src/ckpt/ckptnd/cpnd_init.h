@@ -95,7 +95,10 @@ void cpnd_ckpt_replica_delete(CPND_CB *cb, CPND_CKPT_NODE *ckpt_node);
 uint32_t cpnd_ckpt_replica_create(CPND_CB *cb, CPND_CKPT_NODE *cp_node);
 uint32_t cpnd_ckpt_remote_cpnd_add(CPND_CKPT_NODE *cp_node, MDS_DEST mds_info);
 uint32_t cpnd_ckpt_remote_cpnd_del(CPND_CKPT_NODE *cp_node, MDS_DEST mds_info);
+uint32_t cpnd_ckpt_sec_mapping_init(CPND_CKPT_NODE *cp_node, uint32_t n_used);
+void cpnd_ckpt_sec_mapping_free(CPND_CKPT_NODE *cp_node);
 int32_t cpnd_ckpt_get_lck_sec_id(CPND_CKPT_NODE *cp_node);
+void cpnd_ckpt_put_lck_sec_id(CPND_CKPT_NODE *cp_node, uint32_t lcl_sec_id);
 uint32_t cpnd_ckpt_sec_write(CPND_CB *cb, CPND_CKPT_NODE *cp_node,
                              CPND_CKPT_SECTION_INFO *sec_info, const void *data,
                              uint64_t size, uint64_t offset, uint32_t type);
@@ -150,6 +153,15 @@ void cpnd_proc_app_status(CPND_CB *cb);
 uint32_t cpnd_ckpt_client_find(CPND_CKPT_NODE *cp_node,
                                CPND_CKPT_CLIENT_NODE *cl_node);
 uint32_t cpnd_all_repl_rsp_expiry(CPND_CB *cb, CPND_TMR_INFO *tmr_info);
+uint32_t cpnd_proc_all_repl_write_done(CPND_CB *cb,
+                                       CPSV_CPND_ALL_REPL_EVT_NODE *evt_node,
+                                       SaAisErrorT error);
+void cpnd_proc_all_repl_batch_cleanup(CPND_CB *cb, CPND_CKPT_NODE *cp_node);
+uint32_t cpnd_proc_repl_sync_start(CPND_CB *cb, CPND_CKPT_NODE *cp_node,
+                                   MDS_DEST dest,
+                                   const CPSV_A2ND_CKPT_SYNC *sync);
+uint32_t cpnd_proc_repl_sync_next(CPND_CB *cb, CPSV_CKPT_DEST_INFO *repl_sync);
+void cpnd_proc_repl_sync_cleanup(CPND_CKPT_NODE *cp_node);
 uint32_t cpnd_open_active_sync_expiry(CPND_CB *cb, CPND_TMR_INFO *tmr_info);
 void cpnd_proc_free_read_data(CPSV_EVT *evt);
 SaUint32T cpnd_get_scAbsenceAllowed_attr();
@@ -213,6 +225,12 @@ void cpnd_allrepl_write_evt_node_tree_cleanup(CPND_CB *cb);
 void cpnd_allrepl_write_evt_node_tree_destroy(CPND_CB *cb);
 uint32_t cpnd_sec_hdr_update(CPND_CB *cb, CPND_CKPT_SECTION_INFO *pSecPtr,
                              CPND_CKPT_NODE *cp_node);
+void cpnd_replica_seq_begin(CPND_CKPT_NODE *cp_node);
+void cpnd_replica_seq_end(CPND_CKPT_NODE *cp_node);
+void cpnd_sec_seq_begin(CPND_CKPT_NODE *cp_node, uint32_t lcl_sec_id);
+void cpnd_sec_seq_end(CPND_CKPT_NODE *cp_node, uint32_t lcl_sec_id,
+                      bool in_use);
+void cpnd_replica_seq_restore(CPND_CKPT_NODE *cp_node);
 uint32_t cpnd_ckpt_hdr_update(CPND_CB *cb, CPND_CKPT_NODE *cp_node);
 void cpnd_ckpt_node_destroy(CPND_CB *cb, CPND_CKPT_NODE *cp_node);
 NCS_NODE_ID cpnd_get_node_id_from_mds_dest(MDS_DEST dest);
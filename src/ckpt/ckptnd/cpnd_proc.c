@@ -55,6 +55,9 @@ static void cpnd_dump_ckpt_attri(CPND_CKPT_NODE *cp_node);
 static void cpnd_ckpt_sc_cpnd_mdest_del(CPND_CB *cb);
 static void cpnd_headless_ckpt_node_del(CPND_CB *cb);
 static SaUint32T cpnd_get_imm_attr(char **attribute_names);
+static uint32_t cpnd_sec_hdr_write(CPND_CB *cb,
+				   CPND_CKPT_SECTION_INFO *sec_info,
+				   CPND_CKPT_NODE *cp_node);
 
 /****************************************************************************
  * Name          : cpnd_ckpt_client_add
@@ -404,9 +407,7 @@ uint32_t cpnd_ckpt_replica_destroy(CPND_CB *cb, CPND_CKPT_NODE *cp_node,
 		    cp_node->replica_info.open.info.open.i_name);
 
 		/* freeing the sec_mapping memory */
-		if (cp_node->replica_info.shm_sec_mapping)
-			m_MMGR_FREE_CPND_DEFAULT(
-			    cp_node->replica_info.shm_sec_mapping);
+		cpnd_ckpt_sec_mapping_free(cp_node);
 	}
 
 	if (!m_CPND_IS_COLLOCATED_ATTR_SET(
@@ -488,7 +489,6 @@ uint32_t cpnd_ckpt_replica_create(CPND_CB *cb, CPND_CKPT_NODE *cp_node)
 
 	uint32_t rc = NCSCC_RC_SUCCESS;
 	char *buf;
-	int32_t sec_cnt = 0;
 
 	TRACE_ENTER();
 	/* Check  maximum number of allowed replicas ,if exceeded Return Error
@@ -513,9 +513,8 @@ uint32_t cpnd_ckpt_replica_create(CPND_CB *cb, CPND_CKPT_NODE *cp_node)
 
 	cp_node->replica_info.open.type = NCS_OS_POSIX_SHM_REQ_OPEN;
 	cp_node->replica_info.open.info.open.i_size =
-	    sizeof(CPSV_CKPT_HDR) +
-	    cp_node->create_attrib.maxSections *
-		(sizeof(CPSV_SECT_HDR) + cp_node->create_attrib.maxSectionSize);
+	    CPSV_REPLICA_SIZE(cp_node->create_attrib.maxSections,
+			      cp_node->create_attrib.maxSectionSize);
 	cp_node->replica_info.open.ensures_space =
 	    cb->shm_alloc_guaranteed == 1;
 
@@ -547,12 +546,7 @@ again:
 	if (cp_node->replica_info.open.info.open.i_flags & O_CREAT)
 		cb->num_rep++;
 
-	cp_node->replica_info.shm_sec_mapping =
-	    (uint32_t *)m_MMGR_ALLOC_CPND_DEFAULT(
-		sizeof(uint32_t) * cp_node->create_attrib.maxSections);
-
-	for (; sec_cnt < cp_node->create_attrib.maxSections; sec_cnt++)
-		cp_node->replica_info.shm_sec_mapping[sec_cnt] = 1;
+	rc = cpnd_ckpt_sec_mapping_init(cp_node, 0);
 
 	TRACE_LEAVE();
 	return rc;
@@ -642,34 +636,129 @@ uint32_t cpnd_ckpt_remote_cpnd_del(CPND_CKPT_NODE *cp_node, MDS_DEST mds_info)
 	return NCSCC_RC_SUCCESS;
 }
 
+/****************************************************************************
+ * Name          : cpnd_ckpt_sec_mapping_init
+ *
+ * Description   : Function to allocate the mapping of the local section ids
+ *                 of a replica.
+ *
+ * Arguments     : CPND_CKPT_NODE *cp_node - CPND CKPT pointer
+ *                 uint32_t n_used - Number of local section ids in use, the
+ *                                   lowest ones
+ *
+ * Return Values : NCSCC_RC_SUCCESS/Error.
+ *
+ * Notes         : The free local section ids are kept on a stack so that
+ *                 one is found without searching the mapping. The stack
+ *                 starts with the lowest id on top; a freed id is pushed
+ *                 back on top and is thus the next one to be reused.
+ *****************************************************************************/
+uint32_t cpnd_ckpt_sec_mapping_init(CPND_CKPT_NODE *cp_node, uint32_t n_used)
+{
+	CPND_CKPT_REPLICA_INFO *replica_info = &cp_node->replica_info;
+	uint32_t max_sections = cp_node->create_attrib.maxSections;
+	uint32_t i = 0;
+
+	replica_info->shm_sec_mapping = (uint32_t *)m_MMGR_ALLOC_CPND_DEFAULT(
+	    sizeof(uint32_t) * max_sections);
+	replica_info->free_sec_ids = (uint32_t *)m_MMGR_ALLOC_CPND_DEFAULT(
+	    sizeof(uint32_t) * max_sections);
+	if (replica_info->shm_sec_mapping == NULL ||
+	    replica_info->free_sec_ids == NULL) {
+		LOG_ER("cpnd default memory alloc failed");
+		cpnd_ckpt_sec_mapping_free(cp_node);
+		return NCSCC_RC_FAILURE;
+	}
+
+	replica_info->n_free_sec_ids = 0;
+	for (i = max_sections; i > 0; i--) {
+		if (i - 1 < n_used) {
+			replica_info->shm_sec_mapping[i - 1] = 0;
+		} else {
+			replica_info->shm_sec_mapping[i - 1] = 1;
+			replica_info->free_sec_ids[replica_info
+						       ->n_free_sec_ids++] =
+			    i - 1;
+		}
+	}
+	return NCSCC_RC_SUCCESS;
+}
+
+/****************************************************************************
+ * Name          : cpnd_ckpt_sec_mapping_free
+ *
+ * Description   : Function to free the mapping of the local section ids
+ *                 of a replica.
+ *
+ * Arguments     : CPND_CKPT_NODE *cp_node - CPND CKPT pointer
+ *
+ * Return Values : None.
+ *
+ * Notes         : None.
+ *****************************************************************************/
+void cpnd_ckpt_sec_mapping_free(CPND_CKPT_NODE *cp_node)
+{
+	CPND_CKPT_REPLICA_INFO *replica_info = &cp_node->replica_info;
+
+	if (replica_info->shm_sec_mapping)
+		m_MMGR_FREE_CPND_DEFAULT(replica_info->shm_sec_mapping);
+	if (replica_info->free_sec_ids)
+		m_MMGR_FREE_CPND_DEFAULT(replica_info->free_sec_ids);
+	replica_info->shm_sec_mapping = NULL;
+	replica_info->free_sec_ids = NULL;
+	replica_info->n_free_sec_ids = 0;
+}
+
 /****************************************************************************
  * Name          :  cpnd_ckpt_get_lck_sec_id
  *
- * Description   : Function to process the
- *                 from Applications.
+ * Description   : Function to allocate a free local section id.
  *
  * Arguments     : CPND_CKPT_NODE *cp_node  - CPND CKPT pointer
  *
- * Return Values : NCSCC_RC_SUCCESS/Error.
+ * Return Values : The local section id, -1 if all are in use.
  *
  * Notes         : None.
  *****************************************************************************/
 int32_t cpnd_ckpt_get_lck_sec_id(CPND_CKPT_NODE *cp_node)
 {
+	CPND_CKPT_REPLICA_INFO *replica_info = &cp_node->replica_info;
 	uint32_t i = 0;
 
-	for (; i < cp_node->create_attrib.maxSections; i++)
-		if (cp_node->replica_info.shm_sec_mapping[i] == 1) {
-			cp_node->replica_info.shm_sec_mapping[i] = 0;
-			break;
-		}
-	if (i == cp_node->create_attrib.maxSections) {
+	if (replica_info->n_free_sec_ids == 0)
 		return -1;
-	}
 
+	i = replica_info->free_sec_ids[--replica_info->n_free_sec_ids];
+	replica_info->shm_sec_mapping[i] = 0;
 	return i;
 }
 
+/****************************************************************************
+ * Name          :  cpnd_ckpt_put_lck_sec_id
+ *
+ * Description   : Function to free the local section id of a deleted
+ *                 section.
+ *
+ * Arguments     : CPND_CKPT_NODE *cp_node  - CPND CKPT pointer
+ *                 uint32_t lcl_sec_id - The local section id
+ *
+ * Return Values : None.
+ *
+ * Notes         : None.
+ *****************************************************************************/
+void cpnd_ckpt_put_lck_sec_id(CPND_CKPT_NODE *cp_node, uint32_t lcl_sec_id)
+{
+	CPND_CKPT_REPLICA_INFO *replica_info = &cp_node->replica_info;
+
+	if (lcl_sec_id >= cp_node->create_attrib.maxSections ||
+	    replica_info->shm_sec_mapping[lcl_sec_id] == 1)
+		return;
+
+	replica_info->shm_sec_mapping[lcl_sec_id] = 1;
+	replica_info->free_sec_ids[replica_info->n_free_sec_ids++] =
+	    lcl_sec_id;
+}
+
 /****************************************************************************
  * Name          : cpnd_ckpt_sec_write
  *
@@ -718,7 +807,12 @@ uint32_t cpnd_ckpt_sec_write(CPND_CB *cb, CPND_CKPT_NODE *cp_node,
 
 	write_req.info.write.i_write_size = size;
 	write_req.ensures_space = cb->shm_alloc_guaranteed != 0;
+
+	/* The data and the section header are updated as one for the agents
+	 * reading the replica directly */
+	cpnd_sec_seq_begin(cp_node, sec_info->lcl_sec_id);
 	if (ncs_os_posix_shm(&write_req) == NCSCC_RC_FAILURE) {
+		cpnd_sec_seq_end(cp_node, sec_info->lcl_sec_id, true);
 		LOG_ER("shm write failed for cpnd_ckpt_sec_write");
 		return NCSCC_RC_FAILURE;
 	}
@@ -734,7 +828,7 @@ uint32_t cpnd_ckpt_sec_write(CPND_CB *cb, CPND_CKPT_NODE *cp_node,
 		}
 
 		/* SECTION HEADER UPDATE */
-		if (cpnd_sec_hdr_update(cb, sec_info, cp_node) ==
+		if (cpnd_sec_hdr_write(cb, sec_info, cp_node) ==
 		    NCSCC_RC_FAILURE) {
 			LOG_ER("cpnd sect hdr update failed");
 			rc = NCSCC_RC_FAILURE;
@@ -744,12 +838,13 @@ uint32_t cpnd_ckpt_sec_write(CPND_CB *cb, CPND_CKPT_NODE *cp_node,
 		cp_node->replica_info.mem_used -= sec_info->sec_size;
 		sec_info->sec_size = size;
 		cp_node->replica_info.mem_used += size;
-		if ((cpnd_sec_hdr_update(cb, sec_info, cp_node)) ==
+		if ((cpnd_sec_hdr_write(cb, sec_info, cp_node)) ==
 		    NCSCC_RC_FAILURE) {
 			LOG_ER("cpnd sect hdr update failed");
 			rc = NCSCC_RC_FAILURE;
 		}
 	}
+	cpnd_sec_seq_end(cp_node, sec_info->lcl_sec_id, true);
 	TRACE_LEAVE();
 	return rc;
 }
@@ -1037,6 +1132,7 @@ uint32_t cpnd_ckpt_update_replica(CPND_CB *cb, CPND_CKPT_NODE *cp_node,
 
 	TRACE_ENTER();
 	data = write_data->data;
+	cpnd_replica_seq_begin(cp_node);
 	for (; i < write_data->num_of_elmts; i++) {
 		sec_info = cpnd_ckpt_sec_get_create(cp_node, &data->sec_id);
 		if (sec_info == NULL) {
@@ -1049,15 +1145,22 @@ uint32_t cpnd_ckpt_update_replica(CPND_CB *cb, CPND_CKPT_NODE *cp_node,
 					TRACE_4(
 					    "cpnd - ckpt sect add failed , sec_id:%s ckpt_id:%llx",
 					    data->sec_id.id, cp_node->ckpt_id);
-					TRACE_LEAVE();
-					return NCSCC_RC_FAILURE;
+					rc = NCSCC_RC_FAILURE;
+					goto done;
 				}
+			} else if (cp_node->open_active_sync_tmr.is_active) {
+				/* The section comes with the transfer of the
+				 * replica, with the update */
+				TRACE("cpnd replica in sync has no sec_id:%s",
+				      data->sec_id.id);
+				data = data->next;
+				continue;
 			} else {
 				TRACE_4("cpnd replica has no sections");
 				*errflag = i;
 				*err_type = CKPT_UPDATE_REPLICA_NO_SECTION;
-				TRACE_LEAVE();
-				return NCSCC_RC_FAILURE;
+				rc = NCSCC_RC_FAILURE;
+				goto done;
 			}
 		}
 
@@ -1069,12 +1172,14 @@ uint32_t cpnd_ckpt_update_replica(CPND_CB *cb, CPND_CKPT_NODE *cp_node,
 			      data->sec_id.id);
 			*errflag = i;
 			*err_type = CKPT_UPDATE_REPLICA_RES_ERR;
-			TRACE_LEAVE();
-			return rc;
+			goto done;
 		}
 
 		data = data->next;
 	}
+done:
+	cpnd_replica_seq_end(cp_node);
+	TRACE_LEAVE();
 	return rc;
 }
 
@@ -1380,6 +1485,711 @@ void cpnd_proc_gen_mapping(CPND_CKPT_NODE *cp_node, CPSV_CKPT_ACCESS *ckpt_read,
 	TRACE_LEAVE();
 }
 
+/****************************************************************************
+ * Name          : cpnd_proc_all_repl_write_rsp_fill
+ *
+ * Description   : Function to fill the response to a write to all replicas.
+ *
+ * Arguments     : CPSV_EVT *rsp_evt - Response to the agent
+ *                 uint32_t write_type - CPSV_CKPT_ACCESS_WRITE/OVWRITE
+ *                 SaAisErrorT error - Result of the write
+ *
+ * Return Values : None.
+ *
+ * Notes         : None.
+ *****************************************************************************/
+static void cpnd_proc_all_repl_write_rsp_fill(CPSV_EVT *rsp_evt,
+					      uint32_t write_type,
+					      SaAisErrorT error)
+{
+	rsp_evt->type = CPSV_EVT_TYPE_CPA;
+	rsp_evt->info.cpa.type = CPA_EVT_ND2A_CKPT_DATA_RSP;
+
+	switch (write_type) {
+	case CPSV_CKPT_ACCESS_WRITE:
+		rsp_evt->info.cpa.info.sec_data_rsp.type =
+		    CPSV_DATA_ACCESS_WRITE_RSP;
+		rsp_evt->info.cpa.info.sec_data_rsp.error = error;
+		break;
+
+	case CPSV_CKPT_ACCESS_OVWRITE:
+		rsp_evt->info.cpa.info.sec_data_rsp.type =
+		    CPSV_DATA_ACCESS_OVWRITE_RSP;
+		rsp_evt->info.cpa.info.sec_data_rsp.info.ovwrite_error.error =
+		    error;
+		break;
+	}
+}
+
+/****************************************************************************
+ * Name          : cpnd_proc_all_repl_write_rsp_send
+ *
+ * Description   : Function to respond to the writes of a batch of writes to
+ *                 all replicas.
+ *
+ * Arguments     : CPND_CB *cb - CPND CB pointer
+ *                 CPSV_CPND_ALL_REPL_EVT_NODE *evt_node - First write
+ *                 SaAisErrorT error - Result of the writes
+ *
+ * Return Values : NCSCC_RC_SUCCESS/Error.
+ *
+ * Notes         : The event nodes are deleted and freed.
+ *****************************************************************************/
+static uint32_t
+cpnd_proc_all_repl_write_rsp_send(CPND_CB *cb,
+				  CPSV_CPND_ALL_REPL_EVT_NODE *evt_node,
+				  SaAisErrorT error)
+{
+	CPSV_CPND_ALL_REPL_EVT_NODE *next = NULL;
+	CPSV_EVT rsp_evt;
+	uint32_t rc = NCSCC_RC_SUCCESS;
+
+	while (evt_node != NULL) {
+		next = evt_node->next;
+
+		memset(&rsp_evt, '\0', sizeof(CPSV_EVT));
+		cpnd_proc_all_repl_write_rsp_fill(
+		    &rsp_evt, evt_node->write_rsp_tmr.write_type, error);
+		if (evt_node->sinfo.stype == MDS_SENDTYPE_SNDRSP) {
+			if (cpnd_mds_send_rsp(cb, &evt_node->sinfo,
+					      &rsp_evt) != NCSCC_RC_SUCCESS)
+				rc = NCSCC_RC_FAILURE;
+		} else {
+			/* An async write */
+			rsp_evt.info.cpa.info.sec_data_rsp.lcl_ckpt_id =
+			    evt_node->lcl_ckpt_id;
+			if (cpnd_mds_msg_send(cb, evt_node->sinfo.to_svc,
+					      evt_node->sinfo.dest,
+					      &rsp_evt) != NCSCC_RC_SUCCESS)
+				rc = NCSCC_RC_FAILURE;
+		}
+
+		/*Remove the all repl event node */
+		cpnd_evt_node_del(cb, evt_node);
+		/*Free the memory */
+		cpnd_allrepl_write_evt_node_free(evt_node);
+
+		evt_node = next;
+	}
+	return rc;
+}
+
+/****************************************************************************
+ * Name          : cpnd_proc_all_repl_write_send
+ *
+ * Description   : Function to send a write, or a batch of writes, to all
+ *                 the remote replicas.
+ *
+ * Arguments     : CPND_CB *cb - CPND CB pointer
+ *                 CPND_CKPT_NODE *cp_node - Checkpoint node
+ *                 CPSV_CKPT_ACCESS *write - The write(s)
+ *                 CPSV_CPND_ALL_REPL_EVT_NODE *evt_node - First write
+ *
+ * Return Values : NCSCC_RC_SUCCESS/Error.
+ *
+ * Notes         : The remote replicas respond to evt_node, which keeps the
+ *                 responses awaited.
+ *****************************************************************************/
+static uint32_t
+cpnd_proc_all_repl_write_send(CPND_CB *cb, CPND_CKPT_NODE *cp_node,
+			      CPSV_CKPT_ACCESS *write,
+			      CPSV_CPND_ALL_REPL_EVT_NODE *evt_node)
+{
+	CPSV_EVT send_evt;
+	CPSV_CPND_DEST_INFO *tmp = NULL;
+	CPSV_CPND_UPDATE_DEST *new = NULL, *head = NULL;
+	SaTimeT timeout = 0;
+	uint32_t rc = NCSCC_RC_SUCCESS;
+
+	TRACE_ENTER();
+	/*Copy the entire dest_list info of ckpt node to the event node */
+	for (tmp = cp_node->cpnd_dest_list; tmp != NULL; tmp = tmp->next) {
+		new = m_MMGR_ALLOC_CPND_UPDATE_DEST_INFO;
+		if (!new) {
+			LOG_ER("cpnd update dest info allocation failed");
+			TRACE_LEAVE();
+			return NCSCC_RC_FAILURE;
+		}
+		memset(new, 0, sizeof(CPSV_CPND_UPDATE_DEST));
+		new->dest = tmp->dest;
+		new->next = evt_node->cpnd_update_dest_list;
+		evt_node->cpnd_update_dest_list = new;
+	}
+
+	memset(&send_evt, '\0', sizeof(CPSV_EVT));
+	send_evt.type = CPSV_EVT_TYPE_CPND;
+	send_evt.info.cpnd.type =
+	    CPSV_EVT_ND2ND_CKPT_SECT_ACTIVE_DATA_ACCESS_REQ;
+	send_evt.info.cpnd.info.ckpt_nd2nd_data = *write;
+	/*Flag set to distinguish ALL_REPL case on response side */
+	send_evt.info.cpnd.info.ckpt_nd2nd_data.all_repl_evt_flag = true;
+	send_evt.info.cpnd.info.ckpt_nd2nd_data.lcl_ckpt_id =
+	    evt_node->lcl_ckpt_id;
+	send_evt.info.cpnd.info.ckpt_nd2nd_data.agent_mdest =
+	    evt_node->sinfo.dest;
+
+	/*Start the timer before send the async req to remote node */
+	timeout = CPND_WAIT_TIME(write->num_of_elmts *
+				 cp_node->create_attrib.maxSectionSize);
+	evt_node->write_rsp_tmr.type = CPND_ALL_REPL_RSP_EXPI;
+	evt_node->write_rsp_tmr.uarg = cb->cpnd_cb_hdl_id;
+	evt_node->write_rsp_tmr.ckpt_id = cp_node->ckpt_id;
+	evt_node->write_rsp_tmr.lcl_ckpt_hdl = evt_node->lcl_ckpt_id;
+	evt_node->write_rsp_tmr.agent_dest = evt_node->sinfo.dest;
+	cpnd_tmr_start(&evt_node->write_rsp_tmr, timeout);
+
+	for (head = evt_node->cpnd_update_dest_list; head != NULL;
+	     head = head->next) {
+		rc = cpnd_mds_msg_send(cb, NCSMDS_SVC_ID_CPND, head->dest,
+				       &send_evt);
+		if (rc != NCSCC_RC_SUCCESS) {
+			TRACE_4(
+			    "CPND - MDS send failed from Active Dest to Remote Dest cpnd_mdest_id:%" PRIu64
+			    ", dest:%" PRIu64 ",ckpt_id:%llx:rc:%d",
+			    cb->cpnd_mdest_id, head->dest, cp_node->ckpt_id,
+			    rc);
+		} else {
+			evt_node->write_rsp_cnt++;
+		}
+	}
+	cp_node->repl_in_flight++;
+
+	TRACE_LEAVE();
+	return NCSCC_RC_SUCCESS;
+}
+
+/****************************************************************************
+ * Name          : cpnd_proc_ckpt_data_copy_free
+ *
+ * Description   : Function to free data copied by cpnd_proc_ckpt_data_copy
+ *
+ * Arguments     : CPSV_CKPT_DATA *data - List of copied data
+ *
+ * Return Values : None.
+ *
+ * Notes         : None.
+ *****************************************************************************/
+static void cpnd_proc_ckpt_data_copy_free(CPSV_CKPT_DATA *data)
+{
+	CPSV_CKPT_DATA *tmp_data = NULL;
+
+	while (data != NULL) {
+		tmp_data = data;
+		data = data->next;
+		if (tmp_data->sec_id.id)
+			m_MMGR_FREE_CPND_DEFAULT(tmp_data->sec_id.id);
+		if (tmp_data->data)
+			m_MMGR_FREE_CPND_DEFAULT(tmp_data->data);
+		m_MMGR_FREE_CPSV_CKPT_DATA(tmp_data);
+	}
+}
+
+/****************************************************************************
+ * Name          : cpnd_proc_ckpt_data_copy
+ *
+ * Description   : Function to copy an element of the data of a write
+ *
+ * Arguments     : CPSV_CKPT_DATA *data - The element to copy
+ *
+ * Return Values : The copy, NULL if out of memory.
+ *
+ * Notes         : The section id and the data are copied as well.
+ *****************************************************************************/
+static CPSV_CKPT_DATA *cpnd_proc_ckpt_data_copy(const CPSV_CKPT_DATA *data)
+{
+	CPSV_CKPT_DATA *copy = m_MMGR_ALLOC_CPSV_CKPT_DATA;
+
+	if (copy == NULL)
+		return NULL;
+
+	*copy = *data;
+	copy->next = NULL;
+	copy->sec_id.id = NULL;
+	copy->data = NULL;
+
+	if (data->sec_id.idLen != 0 && data->sec_id.id != NULL) {
+		copy->sec_id.id = m_MMGR_ALLOC_CPND_DEFAULT(data->sec_id.idLen);
+		if (copy->sec_id.id == NULL)
+			goto free_copy;
+		memcpy(copy->sec_id.id, data->sec_id.id, data->sec_id.idLen);
+	}
+	if (data->dataSize != 0 && data->data != NULL) {
+		copy->data = m_MMGR_ALLOC_CPND_DEFAULT(data->dataSize);
+		if (copy->data == NULL)
+			goto free_copy;
+		memcpy(copy->data, data->data, data->dataSize);
+	}
+	return copy;
+
+free_copy:
+	cpnd_proc_ckpt_data_copy_free(copy);
+	return NULL;
+}
+
+/****************************************************************************
+ * Name          : cpnd_proc_all_repl_write_batch
+ *
+ * Description   : Function to add a write to all replicas to the batch of
+ *                 writes waiting to be sent to the remote replicas.
+ *
+ * Arguments     : CPND_CKPT_NODE *cp_node - Checkpoint node
+ *                 CPSV_CKPT_ACCESS *write - The write
+ *                 CPSV_CPND_ALL_REPL_EVT_NODE *evt_node - Event node of the
+ *                                                         write
+ *
+ * Return Values : NCSCC_RC_SUCCESS/Error.
+ *
+ * Notes         : A new batch is started if the write is of another type
+ *                 than the last batch or if that batch is full.
+ *****************************************************************************/
+static uint32_t
+cpnd_proc_all_repl_write_batch(CPND_CKPT_NODE *cp_node,
+			       CPSV_CKPT_ACCESS *write,
+			       CPSV_CPND_ALL_REPL_EVT_NODE *evt_node)
+{
+	CPND_REPL_BATCH *batch = cp_node->repl_batch_last;
+	CPSV_CKPT_DATA *data = NULL, *copy = NULL, *head = NULL, *last = NULL;
+	uint32_t num_of_elmts = 0;
+
+	/* The data is copied, the event is freed once it has been processed */
+	for (data = write->data; data != NULL; data = data->next) {
+		copy = cpnd_proc_ckpt_data_copy(data);
+		if (copy == NULL) {
+			LOG_ER("cpnd ckpt data allocation failed");
+			cpnd_proc_ckpt_data_copy_free(head);
+			return NCSCC_RC_FAILURE;
+		}
+		if (head == NULL)
+			head = copy;
+		else
+			last->next = copy;
+		last = copy;
+		num_of_elmts++;
+	}
+
+	if (batch == NULL || batch->write.type != write->type ||
+	    batch->num_of_writes == CPND_REPL_BATCH_MAX_WRITES) {
+		batch = m_MMGR_ALLOC_CPND_DEFAULT(sizeof(CPND_REPL_BATCH));
+		if (batch == NULL) {
+			LOG_ER("cpnd repl batch allocation failed");
+			cpnd_proc_ckpt_data_copy_free(head);
+			return NCSCC_RC_FAILURE;
+		}
+		memset(batch, '\0', sizeof(CPND_REPL_BATCH));
+		batch->write = *write;
+		batch->write.data = NULL;
+		batch->write.num_of_elmts = 0;
+
+		if (cp_node->repl_batch_last == NULL)
+			cp_node->repl_batch_list = batch;
+		else
+			cp_node->repl_batch_last->next = batch;
+		cp_node->repl_batch_last = batch;
+	}
+
+	if (head != NULL) {
+		if (batch->last_data == NULL)
+			batch->write.data = head;
+		else
+			batch->last_data->next = head;
+		batch->last_data = last;
+	}
+	batch->write.num_of_elmts += num_of_elmts;
+	batch->num_of_writes++;
+
+	if (batch->last_evt == NULL)
+		batch->evt_list = evt_node;
+	else
+		batch->last_evt->next = evt_node;
+	batch->last_evt = evt_node;
+
+	TRACE("cpnd batched write for lcl_ckpt_id:%llx, %u writes in batch",
+	      evt_node->lcl_ckpt_id, batch->num_of_writes);
+	return NCSCC_RC_SUCCESS;
+}
+
+/****************************************************************************
+ * Name          : cpnd_proc_all_repl_batch_send
+ *
+ * Description   : Function to send the batches of writes to all replicas
+ *                 waiting for room in the window.
+ *
+ * Arguments     : CPND_CB *cb - CPND CB pointer
+ *                 CPND_CKPT_NODE *cp_node - Checkpoint node
+ *
+ * Return Values : None.
+ *
+ * Notes         : None.
+ *****************************************************************************/
+static void cpnd_proc_all_repl_batch_send(CPND_CB *cb, CPND_CKPT_NODE *cp_node)
+{
+	CPND_REPL_BATCH *batch = NULL;
+
+	while (cp_node->repl_batch_list != NULL &&
+	       cp_node->repl_in_flight < cb->repl_window) {
+		batch = cp_node->repl_batch_list;
+		cp_node->repl_batch_list = batch->next;
+		if (cp_node->repl_batch_list == NULL)
+			cp_node->repl_batch_last = NULL;
+
+		TRACE("cpnd sending %u batched writes for ckpt_id:%llx",
+			batch->num_of_writes, cp_node->ckpt_id);
+		if (cp_node->cpnd_dest_list == NULL) {
+			/* The remote replicas are gone, the writes are in all
+			 * the replicas left */
+			cpnd_proc_all_repl_write_rsp_send(cb, batch->evt_list,
+							  SA_AIS_OK);
+		} else if (cpnd_proc_all_repl_write_send(
+			       cb, cp_node, &batch->write, batch->evt_list) !=
+			   NCSCC_RC_SUCCESS) {
+			cpnd_proc_all_repl_write_rsp_send(cb, batch->evt_list,
+							  SA_AIS_ERR_NO_MEMORY);
+		}
+
+		cpnd_proc_ckpt_data_copy_free(batch->write.data);
+		m_MMGR_FREE_CPND_DEFAULT(batch);
+	}
+}
+
+/****************************************************************************
+ * Name          : cpnd_proc_all_repl_write_done
+ *
+ * Description   : Function to respond to a write, or a batch of writes, to
+ *                 all replicas when all the remote replicas have responded,
+ *                 or on error, and to send the next batch of writes.
+ *
+ * Arguments     : CPND_CB *cb - CPND CB pointer
+ *                 CPSV_CPND_ALL_REPL_EVT_NODE *evt_node - First write
+ *                 SaAisErrorT error - Result of the writes
+ *
+ * Return Values : NCSCC_RC_SUCCESS/Error.
+ *
+ * Notes         : The event nodes are deleted and freed.
+ *****************************************************************************/
+uint32_t cpnd_proc_all_repl_write_done(CPND_CB *cb,
+				       CPSV_CPND_ALL_REPL_EVT_NODE *evt_node,
+				       SaAisErrorT error)
+{
+	CPND_CKPT_NODE *cp_node = NULL;
+	SaCkptCheckpointHandleT ckpt_id = evt_node->ckpt_id;
+	uint32_t rc = NCSCC_RC_SUCCESS;
+
+	TRACE_ENTER();
+	if (evt_node->write_rsp_tmr.is_active)
+		cpnd_tmr_stop(&evt_node->write_rsp_tmr);
+
+	rc = cpnd_proc_all_repl_write_rsp_send(cb, evt_node, error);
+
+	/* There is room in the window for the next batch */
+	cpnd_ckpt_node_get(cb, ckpt_id, &cp_node);
+	if (cp_node != NULL && cp_node->repl_in_flight > 0) {
+		cp_node->repl_in_flight--;
+		cpnd_proc_all_repl_batch_send(cb, cp_node);
+	}
+
+	TRACE_LEAVE();
+	return rc;
+}
+
+/****************************************************************************
+ * Name          : cpnd_proc_all_repl_batch_cleanup
+ *
+ * Description   : Function to discard the batches of writes to all replicas
+ *                 not yet sent, when the checkpoint is removed.
+ *
+ * Arguments     : CPND_CB *cb - CPND CB pointer
+ *                 CPND_CKPT_NODE *cp_node - Checkpoint node
+ *
+ * Return Values : None.
+ *
+ * Notes         : The writers are responded to with SA_AIS_ERR_NOT_EXIST.
+ *****************************************************************************/
+void cpnd_proc_all_repl_batch_cleanup(CPND_CB *cb, CPND_CKPT_NODE *cp_node)
+{
+	CPND_REPL_BATCH *batch = NULL;
+
+	while ((batch = cp_node->repl_batch_list) != NULL) {
+		cp_node->repl_batch_list = batch->next;
+		cpnd_proc_all_repl_write_rsp_send(cb, batch->evt_list,
+						  SA_AIS_ERR_NOT_EXIST);
+		cpnd_proc_ckpt_data_copy_free(batch->write.data);
+		m_MMGR_FREE_CPND_DEFAULT(batch);
+	}
+	cp_node->repl_batch_last = NULL;
+}
+
+/****************************************************************************
+ * Name          : cpnd_proc_repl_sync_remove
+ *
+ * Description   : Function to end a transfer of the replica to a new replica.
+ *
+ * Arguments     : CPND_CKPT_NODE *cp_node - Checkpoint node
+ *                 CPND_REPL_SYNC *repl_sync - The transfer
+ *
+ * Return Values : None.
+ *****************************************************************************/
+static void cpnd_proc_repl_sync_remove(CPND_CKPT_NODE *cp_node,
+				       CPND_REPL_SYNC *repl_sync)
+{
+	CPND_REPL_SYNC **prev = &cp_node->repl_sync_list;
+
+	while (*prev != repl_sync)
+		prev = &(*prev)->next;
+	*prev = repl_sync->next;
+	m_MMGR_FREE_CPND_DEFAULT(repl_sync);
+}
+
+/****************************************************************************
+ * Name          : cpnd_proc_repl_sync_post
+ *
+ * Description   : Function to post the event sending the next chunk of the
+ *                 replica to the new replica at dest.
+ *
+ * Arguments     : CPND_CB *cb - CPND CB pointer
+ *                 SaCkptCheckpointHandleT ckpt_id - Checkpoint
+ *                 MDS_DEST dest - CPND of the new replica
+ *
+ * Return Values : NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE
+ *
+ * Notes         : The event has low priority, so that the writes to the
+ *                 checkpoint are not held up by the transfer.
+ *****************************************************************************/
+static uint32_t cpnd_proc_repl_sync_post(CPND_CB *cb,
+					 SaCkptCheckpointHandleT ckpt_id,
+					 MDS_DEST dest)
+{
+	CPSV_EVT *evt = NULL;
+
+	evt = m_MMGR_ALLOC_CPSV_EVT(NCS_SERVICE_ID_CPND);
+	if (evt == NULL) {
+		TRACE_4("cpnd evt memory allocation failed");
+		return NCSCC_RC_FAILURE;
+	}
+	memset(evt, 0, sizeof(CPSV_EVT));
+	evt->type = CPSV_EVT_TYPE_CPND;
+	evt->info.cpnd.type = CPND_EVT_REPL_SYNC;
+	evt->info.cpnd.info.repl_sync.ckpt_id = ckpt_id;
+	evt->info.cpnd.info.repl_sync.mds_dest = dest;
+
+	if (m_NCS_IPC_SEND(&cb->cpnd_mbx, (NCSCONTEXT)evt,
+			   NCS_IPC_PRIORITY_LOW) != NCSCC_RC_SUCCESS) {
+		LOG_ER("cpnd ncs ipc send failed");
+		m_MMGR_FREE_CPSV_EVT(evt, NCS_SERVICE_ID_CPND);
+		return NCSCC_RC_FAILURE;
+	}
+	return NCSCC_RC_SUCCESS;
+}
+
+/****************************************************************************
+ * Name          : cpnd_proc_repl_sync_start
+ *
+ * Description   : Function to start the transfer of the sections of the
+ *                 active replica to a new replica, on a sync request of the
+ *                 CPND opening the checkpoint.
+ *
+ * Arguments     : CPND_CB *cb - CPND CB pointer
+ *                 CPND_CKPT_NODE *cp_node - Checkpoint node
+ *                 MDS_DEST dest - CPND of the new replica
+ *                 CPSV_A2ND_CKPT_SYNC *sync - The sync request
+ *
+ * Return Values : NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE
+ *
+ * Notes         : The sections are sent in chunks of MAX_SYNC_TRANSFER_SIZE,
+ *                 see cpnd_proc_repl_sync_next(). The new replica shall be in
+ *                 the cpnd_dest_list from the start of the transfer, so that
+ *                 it gets the updates made while the transfer goes on. A
+ *                 section updated before it is sent is sent with the update,
+ *                 the new replica ignores the update of a section it does not
+ *                 have yet.
+ *****************************************************************************/
+uint32_t cpnd_proc_repl_sync_start(CPND_CB *cb, CPND_CKPT_NODE *cp_node,
+				   MDS_DEST dest,
+				   const CPSV_A2ND_CKPT_SYNC *sync)
+{
+	CPND_REPL_SYNC *repl_sync = NULL;
+
+	TRACE_ENTER();
+	for (repl_sync = cp_node->repl_sync_list; repl_sync != NULL;
+	     repl_sync = repl_sync->next) {
+		if (m_NCS_MDS_DEST_EQUAL(&repl_sync->dest, &dest))
+			break;
+	}
+
+	if (repl_sync != NULL) {
+		/* The CPND asks again, start over. The event of the transfer
+		 * is already posted */
+		repl_sync->sync = *sync;
+		repl_sync->next_sec =
+		    cpnd_ckpt_sec_get_first(&cp_node->replica_info);
+		repl_sync->seqno = 1;
+		TRACE_LEAVE();
+		return NCSCC_RC_SUCCESS;
+	}
+
+	repl_sync = m_MMGR_ALLOC_CPND_DEFAULT(sizeof(CPND_REPL_SYNC));
+	if (repl_sync == NULL) {
+		TRACE_4("cpnd repl sync memory allocation failed");
+		TRACE_LEAVE();
+		return NCSCC_RC_FAILURE;
+	}
+	memset(repl_sync, 0, sizeof(CPND_REPL_SYNC));
+	repl_sync->dest = dest;
+	repl_sync->sync = *sync;
+	repl_sync->next_sec = cpnd_ckpt_sec_get_first(&cp_node->replica_info);
+	repl_sync->seqno = 1;
+	repl_sync->next = cp_node->repl_sync_list;
+	cp_node->repl_sync_list = repl_sync;
+
+	if (cpnd_proc_repl_sync_post(cb, cp_node->ckpt_id, dest) !=
+	    NCSCC_RC_SUCCESS) {
+		cpnd_proc_repl_sync_remove(cp_node, repl_sync);
+		TRACE_LEAVE();
+		return NCSCC_RC_FAILURE;
+	}
+	TRACE("cpnd replica transfer started for ckpt_id:%llx,dest:%" PRIu64,
+	      cp_node->ckpt_id, dest);
+	TRACE_LEAVE();
+	return NCSCC_RC_SUCCESS;
+}
+
+/****************************************************************************
+ * Name          : cpnd_proc_repl_sync_next
+ *
+ * Description   : Function to send the next chunk of the sections of the
+ *                 active replica to a new replica.
+ *
+ * Arguments     : CPND_CB *cb - CPND CB pointer
+ *                 CPSV_CKPT_DEST_INFO *repl_sync - Checkpoint and CPND of
+ *                                                  the new replica
+ *
+ * Return Values : NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE
+ *
+ * Notes         : The transfer is given up if the new replica is gone or
+ *                 this is no longer the active replica. The new replica then
+ *                 fails the open when its sync timer expires.
+ *****************************************************************************/
+uint32_t cpnd_proc_repl_sync_next(CPND_CB *cb, CPSV_CKPT_DEST_INFO *repl_sync)
+{
+	CPND_CKPT_NODE *cp_node = NULL;
+	CPND_REPL_SYNC *sync = NULL;
+	CPSV_CPND_DEST_INFO *dest = NULL;
+	CPND_CKPT_SECTION_INFO *sec_info = NULL;
+	CPSV_CKPT_DATA *sec_data = NULL, *tmp_sec_data = NULL;
+	CPSV_CKPT_ACCESS *sync_data = NULL;
+	CPSV_EVT send_evt;
+	uint32_t rc = NCSCC_RC_SUCCESS, num = 0;
+	SaSizeT size = 0;
+
+	TRACE_ENTER();
+	cpnd_ckpt_node_get(cb, repl_sync->ckpt_id, &cp_node);
+	if (cp_node == NULL) {
+		TRACE_4("cpnd ckpt node get failed for ckpt_id:%llx",
+			repl_sync->ckpt_id);
+		TRACE_LEAVE();
+		return NCSCC_RC_FAILURE;
+	}
+
+	for (sync = cp_node->repl_sync_list; sync != NULL; sync = sync->next) {
+		if (m_NCS_MDS_DEST_EQUAL(&sync->dest, &repl_sync->mds_dest))
+			break;
+	}
+	if (sync == NULL) {
+		TRACE_LEAVE();
+		return NCSCC_RC_SUCCESS;
+	}
+
+	for (dest = cp_node->cpnd_dest_list; dest != NULL; dest = dest->next) {
+		if (m_NCS_MDS_DEST_EQUAL(&dest->dest, &sync->dest))
+			break;
+	}
+	if ((dest == NULL) ||
+	    (m_CPND_IS_LOCAL_NODE(&cp_node->active_mds_dest,
+				  &cb->cpnd_mdest_id) != 0)) {
+		TRACE_4("cpnd replica transfer given up for ckpt_id:%llx",
+			cp_node->ckpt_id);
+		cpnd_proc_repl_sync_remove(cp_node, sync);
+		TRACE_LEAVE();
+		return NCSCC_RC_FAILURE;
+	}
+
+	memset(&send_evt, '\0', sizeof(CPSV_EVT));
+	send_evt.type = CPSV_EVT_TYPE_CPND;
+	send_evt.info.cpnd.type = CPND_EVT_ND2ND_CKPT_ACTIVE_SYNC;
+	sync_data = &send_evt.info.cpnd.info.ckpt_nd2nd_sync;
+	sync_data->type = CPSV_CKPT_ACCESS_SYNC;
+	sync_data->ckpt_id = cp_node->ckpt_id;
+	sync_data->ckpt_sync = sync->sync;
+	sync_data->seqno = sync->seqno++;
+
+	/* At least one section, whatever its size */
+	sec_info = sync->next_sec;
+	while ((sec_info != NULL) &&
+	       ((num == 0) ||
+		((size + sec_info->sec_size) <= MAX_SYNC_TRANSFER_SIZE))) {
+		tmp_sec_data = m_MMGR_ALLOC_CPSV_CKPT_DATA;
+		memset(tmp_sec_data, '\0', sizeof(CPSV_CKPT_DATA));
+
+		tmp_sec_data->sec_id = sec_info->sec_id;
+		tmp_sec_data->expirationTime = sec_info->exp_tmr;
+		tmp_sec_data->dataSize = sec_info->sec_size;
+		tmp_sec_data->data =
+		    m_MMGR_ALLOC_CPND_DEFAULT(tmp_sec_data->dataSize);
+
+		cpnd_ckpt_sec_read(cp_node, sec_info, tmp_sec_data->data,
+				   tmp_sec_data->dataSize, 0);
+
+		tmp_sec_data->next = sec_data;
+		sec_data = tmp_sec_data;
+
+		size += sec_info->sec_size;
+		num++;
+		sec_info = cpnd_ckpt_sec_get_next(&cp_node->replica_info,
+						  sec_info);
+	}
+	sync->next_sec = sec_info;
+
+	sync_data->num_of_elmts = num;
+	sync_data->data = sec_data;
+	sync_data->last_seq = (sec_info == NULL) ? true : false;
+
+	rc = cpnd_mds_msg_send(cb, NCSMDS_SVC_ID_CPND, sync->dest, &send_evt);
+	cpnd_proc_free_cpsv_ckpt_data(sec_data);
+
+	if (rc != NCSCC_RC_SUCCESS) {
+		TRACE_4("cpnd mds send failed for ckpt_id:%llx",
+			cp_node->ckpt_id);
+		cpnd_proc_repl_sync_remove(cp_node, sync);
+	} else if (sync_data->last_seq) {
+		TRACE("cpnd replica transfer done for ckpt_id:%llx,seqno:%u",
+		      cp_node->ckpt_id, sync_data->seqno);
+		cpnd_proc_repl_sync_remove(cp_node, sync);
+	} else {
+		rc = cpnd_proc_repl_sync_post(cb, cp_node->ckpt_id,
+					      sync->dest);
+		if (rc != NCSCC_RC_SUCCESS)
+			cpnd_proc_repl_sync_remove(cp_node, sync);
+	}
+
+	TRACE_LEAVE();
+	return rc;
+}
+
+/****************************************************************************
+ * Name          : cpnd_proc_repl_sync_cleanup
+ *
+ * Description   : Function to end the transfers to new replicas, when the
+ *                 checkpoint is removed.
+ *
+ * Arguments     : CPND_CKPT_NODE *cp_node - Checkpoint node
+ *
+ * Return Values : None.
+ *****************************************************************************/
+void cpnd_proc_repl_sync_cleanup(CPND_CKPT_NODE *cp_node)
+{
+	while (cp_node->repl_sync_list != NULL)
+		cpnd_proc_repl_sync_remove(cp_node, cp_node->repl_sync_list);
+}
+
 /****************************************************************************
  * Name          :
  *
@@ -1400,119 +2210,66 @@ uint32_t cpnd_proc_update_remote(CPND_CB *cb, CPND_CKPT_NODE *cp_node,
 {
 	CPSV_EVT send_evt;
 	CPSV_CPND_ALL_REPL_EVT_NODE *all_repl_evt = NULL;
-	CPSV_CPND_UPDATE_DEST *new = NULL, *head = NULL;
 	uint32_t rc = NCSCC_RC_SUCCESS;
-	SaTimeT timeout = 0;
-	SaSizeT datasize = 0;
 
 	TRACE_ENTER();
 	memset(&send_evt, '\0', sizeof(CPSV_EVT));
 	if (m_CPND_IS_ALL_REPLICA_ATTR_SET(
 		cp_node->create_attrib.creationFlags) == true) {
 		if (cp_node->cpnd_dest_list != NULL) {
-			CPSV_CPND_DEST_INFO *tmp = NULL;
-
-			tmp = cp_node->cpnd_dest_list;
-			send_evt.type = CPSV_EVT_TYPE_CPND;
-			send_evt.info.cpnd.type =
-			    CPSV_EVT_ND2ND_CKPT_SECT_ACTIVE_DATA_ACCESS_REQ;
-
-			{
-				send_evt.info.cpnd.info.ckpt_nd2nd_data =
-				    in_evt->info.ckpt_write;
-				datasize =
-				    in_evt->info.ckpt_write.num_of_elmts *
-				    cp_node->create_attrib.maxSectionSize;
-				timeout = CPND_WAIT_TIME(datasize);
-			}
-			/*Flag set to distinguish ALL_REPL case on response side
-			 */
-			send_evt.info.cpnd.info.ckpt_nd2nd_data
-			    .all_repl_evt_flag = true;
-			send_evt.info.cpnd.info.ckpt_nd2nd_data.agent_mdest =
-			    sinfo->dest;
 			/*Allocate memory to store the ALL REPL event node */
 			all_repl_evt = m_MMGR_ALLOC_CPND_ALL_REPL_EVT_NODE;
-			if (all_repl_evt) {
-
-				memset(all_repl_evt, '\0',
-				       sizeof(CPSV_CPND_ALL_REPL_EVT_NODE));
-
-				/*Populate the Event node */
-				all_repl_evt->ckpt_id = cp_node->ckpt_id;
-				all_repl_evt->lcl_ckpt_id =
-				    in_evt->info.ckpt_write.lcl_ckpt_id;
-				all_repl_evt->sinfo = *sinfo;
-
-				/*Copy the entire dest_list info of ckpt node to
-				 * all_repl_evt dest_list */
-				while (tmp != NULL) {
-					new =
-					    m_MMGR_ALLOC_CPND_UPDATE_DEST_INFO;
-					if (!new) {
-						rc = NCSCC_RC_FAILURE;
-						goto mem_fail;
-					}
-					memset(new, 0,
-					       sizeof(CPSV_CPND_UPDATE_DEST));
-					new->dest = tmp->dest;
-					if (head == NULL) {
-						head = new;
-					} else {
-						new->next = head;
-						head = new;
-					}
-					tmp = tmp->next;
-				}
-				all_repl_evt->cpnd_update_dest_list = head;
-
-				if (cpnd_evt_node_add(cb, all_repl_evt) ==
-				    NCSCC_RC_FAILURE) {
-					/*log this error */
-					LOG_ER(
-					    "cpnd a multi event_add request for lcl_ckpt_id: %llx, evt is in progress for ckpt_id : %llx",
-					    in_evt->info.ckpt_write.lcl_ckpt_id,
-					    cp_node->ckpt_id);
-				}
+			if (all_repl_evt == NULL) {
+				LOG_ER("cpnd all repl evt node allocation failed");
+				cpnd_proc_all_repl_write_rsp_fill(
+				    out_evt, in_evt->info.ckpt_write.type,
+				    SA_AIS_ERR_NO_MEMORY);
+				rc = NCSCC_RC_FAILURE;
+				goto mem_fail;
+			}
+			memset(all_repl_evt, '\0',
+			       sizeof(CPSV_CPND_ALL_REPL_EVT_NODE));
+
+			/*Populate the Event node */
+			all_repl_evt->ckpt_id = cp_node->ckpt_id;
+			all_repl_evt->lcl_ckpt_id =
+			    in_evt->info.ckpt_write.lcl_ckpt_id;
+			all_repl_evt->sinfo = *sinfo;
+			all_repl_evt->write_rsp_tmr.write_type =
+			    in_evt->info.ckpt_write.type;
+
+			if (cpnd_evt_node_add(cb, all_repl_evt) ==
+			    NCSCC_RC_FAILURE) {
+				/*log this error */
+				LOG_ER(
+				    "cpnd a multi event_add request for lcl_ckpt_id: %llx, evt is in progress for ckpt_id : %llx",
+				    in_evt->info.ckpt_write.lcl_ckpt_id,
+				    cp_node->ckpt_id);
+			}
 
-				/*Start the timer before send the async req to
-				 * remote node */
-				all_repl_evt->write_rsp_tmr.type =
-				    CPND_ALL_REPL_RSP_EXPI;
-				all_repl_evt->write_rsp_tmr.uarg =
-				    cb->cpnd_cb_hdl_id;
-				all_repl_evt->write_rsp_tmr.ckpt_id =
-				    cp_node->ckpt_id;
-				all_repl_evt->write_rsp_tmr.lcl_ckpt_hdl =
-				    in_evt->info.ckpt_write.lcl_ckpt_id;
-				all_repl_evt->write_rsp_tmr.agent_dest =
-				    sinfo->dest;
-				all_repl_evt->write_rsp_tmr.write_type =
-				    in_evt->info.ckpt_write.type;
-				rc = cpnd_tmr_start(
-				    &all_repl_evt->write_rsp_tmr, timeout);
-
-				while (head != NULL) {
-					rc = cpnd_mds_msg_send(
-					    cb, NCSMDS_SVC_ID_CPND, head->dest,
-					    &send_evt);
-					if (rc != NCSCC_RC_SUCCESS) {
-						TRACE_4(
-						    "CPND - MDS send failed from Active Dest to Remote Dest cpnd_mdest_id:%" PRIu64
-						    ",\
-						dest:%" PRIu64
-						    ",ckpt_id:%llx:rc:%d",
-						    cb->cpnd_mdest_id,
-						    head->dest,
-						    cp_node->ckpt_id, rc);
-					} else {
-						all_repl_evt->write_rsp_cnt++;
-					}
+			/* The write is sent at once unless the window of
+			 * batches in flight is full, then it is sent later
+			 * together with the writes following it */
+			if (cp_node->repl_in_flight < cb->repl_window &&
+			    cp_node->repl_batch_list == NULL)
+				rc = cpnd_proc_all_repl_write_send(
+				    cb, cp_node, &in_evt->info.ckpt_write,
+				    all_repl_evt);
+			else
+				rc = cpnd_proc_all_repl_write_batch(
+				    cp_node, &in_evt->info.ckpt_write,
+				    all_repl_evt);
 
-					head = head->next;
-				}
-			} else {
-				/*Log memory allocation failure */
+			if (rc != NCSCC_RC_SUCCESS) {
+				if (all_repl_evt->write_rsp_tmr.is_active)
+					cpnd_tmr_stop(
+					    &all_repl_evt->write_rsp_tmr);
+				cpnd_evt_node_del(cb, all_repl_evt);
+				cpnd_allrepl_write_evt_node_free(all_repl_evt);
+				cpnd_proc_all_repl_write_rsp_fill(
+				    out_evt, in_evt->info.ckpt_write.type,
+				    SA_AIS_ERR_NO_MEMORY);
+				goto mem_fail;
 			}
 		}
 	}
@@ -1702,7 +2459,7 @@ uint32_t cpnd_proc_sec_expiry(CPND_CB *cb, CPND_TMR_INFO *tmr_info)
 	}
 
 	cpnd_ckpt_sec_del(cb, cp_node, &pSec_info->sec_id, true);
-	cp_node->replica_info.shm_sec_mapping[pSec_info->lcl_sec_id] = 1;
+	cpnd_ckpt_put_lck_sec_id(cp_node, pSec_info->lcl_sec_id);
 
 	/* send out destory to all cpnd's maintaining this ckpt */
 	if (cp_node->cpnd_dest_list != NULL) {
@@ -1789,48 +2546,15 @@ uint32_t cpnd_open_active_sync_expiry(CPND_CB *cb, CPND_TMR_INFO *tmr_info)
 uint32_t cpnd_all_repl_rsp_expiry(CPND_CB *cb, CPND_TMR_INFO *tmr_info)
 {
 	uint32_t rc = NCSCC_RC_SUCCESS;
-	CPND_CKPT_NODE *cp_node = NULL;
 	CPSV_CPND_ALL_REPL_EVT_NODE *evt_node = NULL;
-	CPSV_EVT rsp_evt;
 
 	TRACE_ENTER();
-	cpnd_ckpt_node_get(cb, tmr_info->ckpt_id, &cp_node);
 	cpnd_evt_node_get(cb, tmr_info->lcl_ckpt_hdl, &evt_node);
 
-	memset(&rsp_evt, 0, sizeof(CPSV_EVT));
-
-	rsp_evt.type = CPSV_EVT_TYPE_CPA;
-	rsp_evt.info.cpa.type = CPA_EVT_ND2A_CKPT_DATA_RSP;
-
-	if (cp_node && evt_node) {
-		if (cp_node->ckpt_id == evt_node->ckpt_id) {
-			switch (tmr_info->write_type) {
-			case CPSV_CKPT_ACCESS_WRITE:
-				rsp_evt.info.cpa.info.sec_data_rsp.type =
-				    CPSV_DATA_ACCESS_WRITE_RSP;
-				rsp_evt.info.cpa.info.sec_data_rsp.error =
-				    SA_AIS_ERR_TIMEOUT;
-				break;
-
-			case CPSV_CKPT_ACCESS_OVWRITE:
-				rsp_evt.info.cpa.info.sec_data_rsp.type =
-				    CPSV_DATA_ACCESS_OVWRITE_RSP;
-				rsp_evt.info.cpa.info.sec_data_rsp.info
-				    .ovwrite_error.error = SA_AIS_ERR_TIMEOUT;
-				break;
-			}
-
-			rc = cpnd_mds_send_rsp(cb, &evt_node->sinfo, &rsp_evt);
-		}
-	}
-
-	if (evt_node) {
-		/*Remove the all repl event node */
-		cpnd_evt_node_del(cb, evt_node);
-
-		/*Free the memory */
-		cpnd_allrepl_write_evt_node_free(evt_node);
-	}
+	/* Respond with timeout to the writes sent in the same batch */
+	if (evt_node)
+		rc = cpnd_proc_all_repl_write_done(cb, evt_node,
+						   SA_AIS_ERR_TIMEOUT);
 
 	TRACE_LEAVE();
 	return rc;
@@ -2033,6 +2757,18 @@ node
 
 uint32_t cpnd_sec_hdr_update(CPND_CB *cb, CPND_CKPT_SECTION_INFO *sec_info,
 			     CPND_CKPT_NODE *cp_node)
+{
+	uint32_t rc;
+
+	cpnd_sec_seq_begin(cp_node, sec_info->lcl_sec_id);
+	rc = cpnd_sec_hdr_write(cb, sec_info, cp_node);
+	cpnd_sec_seq_end(cp_node, sec_info->lcl_sec_id, true);
+	return rc;
+}
+
+static uint32_t cpnd_sec_hdr_write(CPND_CB *cb,
+				   CPND_CKPT_SECTION_INFO *sec_info,
+				   CPND_CKPT_NODE *cp_node)
 {
 	CPSV_SECT_HDR sec_hdr;
 	uint32_t rc = NCSCC_RC_SUCCESS;
@@ -2069,6 +2805,120 @@ uint32_t cpnd_sec_hdr_update(CPND_CB *cb, CPND_CKPT_SECTION_INFO *sec_info,
 	return rc;
 }
 
+/****************************************************************************
+ * Name          : cpnd_replica_seq_begin / cpnd_replica_seq_end
+ *
+ * Description   : Mark the start and the end of an update of (possibly
+ *                 several) sections of the replica, for the agents reading
+ *                 several sections directly from the replica. See
+ *                 CPSV_REPLICA_SEQ.
+ *
+ * Arguments     : CPND_CKPT_NODE - ckpt node
+ ****************************************************************************/
+static CPSV_REPLICA_SEQ *cpnd_replica_seq(CPND_CKPT_NODE *cp_node)
+{
+	if (cp_node->replica_info.open.info.open.o_addr == NULL)
+		return NULL;
+	return (CPSV_REPLICA_SEQ *)((char *)cp_node->replica_info.open.info
+					.open.o_addr +
+				    CPSV_REPLICA_SEQ_OFFSET(
+					cp_node->create_attrib.maxSections,
+					cp_node->create_attrib.maxSectionSize));
+}
+
+void cpnd_replica_seq_begin(CPND_CKPT_NODE *cp_node)
+{
+	CPSV_REPLICA_SEQ *replica_seq = cpnd_replica_seq(cp_node);
+
+	if (replica_seq == NULL)
+		return;
+	__atomic_store_n(&replica_seq->seq, (replica_seq->seq + 1) | 1,
+			 __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+void cpnd_replica_seq_end(CPND_CKPT_NODE *cp_node)
+{
+	CPSV_REPLICA_SEQ *replica_seq = cpnd_replica_seq(cp_node);
+
+	if (replica_seq == NULL)
+		return;
+	__atomic_store_n(&replica_seq->seq, (replica_seq->seq + 1) & ~1U,
+			 __ATOMIC_RELEASE);
+}
+
+/****************************************************************************
+ * Name          : cpnd_sec_seq_begin / cpnd_sec_seq_end
+ *
+ * Description   : Mark the start and the end of an update of the header or
+ *                 the data of a section in the replica, for the agents
+ *                 reading the section directly from the replica. See
+ *                 CPSV_SECT_SEQ.
+ *
+ * Arguments     : CPND_CKPT_NODE - ckpt node
+ *                 lcl_sec_id - local section id
+ *                 in_use - false if the section has been deleted
+ ****************************************************************************/
+static CPSV_SECT_SEQ *cpnd_sec_seq(CPND_CKPT_NODE *cp_node,
+				   uint32_t lcl_sec_id)
+{
+	CPSV_REPLICA_SEQ *replica_seq = cpnd_replica_seq(cp_node);
+
+	if (replica_seq == NULL ||
+	    lcl_sec_id >= cp_node->create_attrib.maxSections)
+		return NULL;
+	return (CPSV_SECT_SEQ *)(replica_seq + 1) + lcl_sec_id;
+}
+
+void cpnd_sec_seq_begin(CPND_CKPT_NODE *cp_node, uint32_t lcl_sec_id)
+{
+	CPSV_SECT_SEQ *sec_seq = cpnd_sec_seq(cp_node, lcl_sec_id);
+
+	if (sec_seq == NULL)
+		return;
+	__atomic_store_n(&sec_seq->seq, (sec_seq->seq + 1) | 1,
+			 __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+void cpnd_sec_seq_end(CPND_CKPT_NODE *cp_node, uint32_t lcl_sec_id,
+		      bool in_use)
+{
+	CPSV_SECT_SEQ *sec_seq = cpnd_sec_seq(cp_node, lcl_sec_id);
+
+	if (sec_seq == NULL)
+		return;
+	sec_seq->in_use = in_use;
+	__atomic_store_n(&sec_seq->seq, (sec_seq->seq + 1) & ~1U,
+			 __ATOMIC_RELEASE);
+}
+
+/****************************************************************************
+ * Name          : cpnd_replica_seq_restore
+ *
+ * Description   : Complete the updates of the replica interrupted by a
+ *                 restart of CPND, the agents would otherwise never see the
+ *                 sections as consistent.
+ *
+ * Arguments     : CPND_CKPT_NODE - ckpt node
+ ****************************************************************************/
+void cpnd_replica_seq_restore(CPND_CKPT_NODE *cp_node)
+{
+	CPSV_REPLICA_SEQ *replica_seq = cpnd_replica_seq(cp_node);
+	CPSV_SECT_SEQ *sec_seq;
+	uint32_t i;
+
+	if (replica_seq == NULL)
+		return;
+	if (replica_seq->seq & 1)
+		cpnd_replica_seq_end(cp_node);
+	for (i = 0; i < cp_node->create_attrib.maxSections; i++) {
+		sec_seq = cpnd_sec_seq(cp_node, i);
+		if (sec_seq->seq & 1)
+			cpnd_sec_seq_end(cp_node, i, sec_seq->in_use);
+	}
+}
+
 /****************************************************************************
  * Name          : cpnd_cb_dump
  *
@@ -2937,9 +3787,7 @@ void cpnd_ckpt_replica_delete(CPND_CB *cb, CPND_CKPT_NODE *ckpt_node)
 		    ckpt_node->replica_info.open.info.open.i_name);
 
 		/* freeing the sec_mapping memory */
-		if (ckpt_node->replica_info.shm_sec_mapping)
-			m_MMGR_FREE_CPND_DEFAULT(
-			    ckpt_node->replica_info.shm_sec_mapping);
+		cpnd_ckpt_sec_mapping_free(ckpt_node);
 	}
 	TRACE_LEAVE();
 }
@@ -180,7 +180,7 @@ uint32_t cpnd_ckpt_replica_create_res(CPND_CB *cb,
 	/*   NCS_OS_POSIX_SHM_REQ_INFO read_req,shm_read; */
 	CPSV_CKPT_HDR ckpt_hdr;
 	CPSV_SECT_HDR sect_hdr;
-	uint32_t counter = 0, sec_cnt = 0, rc = NCSCC_RC_SUCCESS;
+	uint32_t counter = 0, rc = NCSCC_RC_SUCCESS;
 	CPND_CKPT_SECTION_INFO *pSecPtr = NULL;
 	NCS_OS_POSIX_SHM_REQ_INFO read_req;
 
@@ -189,9 +189,7 @@ uint32_t cpnd_ckpt_replica_create_res(CPND_CB *cb,
 	memset(&ckpt_hdr, '\0', sizeof(CPSV_CKPT_HDR));
 	open_req->type = NCS_OS_POSIX_SHM_REQ_OPEN;
 	open_req->info.open.i_size =
-	    sizeof(CPSV_CKPT_HDR) +
-	    (cp_info->maxSections *
-	     ((sizeof(CPSV_SECT_HDR) + cp_info->maxSecSize)));
+	    CPSV_REPLICA_SIZE(cp_info->maxSections, cp_info->maxSecSize);
 	open_req->info.open.i_offset = 0;
 	open_req->info.open.i_name = buf;
 	open_req->info.open.i_map_flags = MAP_SHARED;
@@ -218,21 +216,15 @@ uint32_t cpnd_ckpt_replica_create_res(CPND_CB *cb,
 	if ((*cp_node)->create_attrib.maxSections == 0)
 		return rc;
 
-	(*cp_node)->replica_info.shm_sec_mapping =
-	    (uint32_t *)m_MMGR_ALLOC_CPND_DEFAULT(
-		sizeof(uint32_t) * ((*cp_node)->create_attrib.maxSections));
+	cpnd_replica_seq_restore(*cp_node);
 
-	if ((*cp_node)->replica_info.shm_sec_mapping == NULL) {
-		LOG_ER("cpnd default memory alloc failed");
+	/* The sections read below are in use, the others are free */
+	if (cpnd_ckpt_sec_mapping_init(*cp_node, ckpt_hdr.n_secs) !=
+	    NCSCC_RC_SUCCESS) {
 		/*  assert(0); */
 		return NCSCC_RC_FAILURE;
 	}
 
-	/* The below for loop  indicates all are free */
-	for (; sec_cnt < (*cp_node)->create_attrib.maxSections; sec_cnt++)
-		(*cp_node)->replica_info.shm_sec_mapping[sec_cnt] = 1;
-	sec_cnt = 0;
-
 	while (counter < ckpt_hdr.n_secs) {
 		memset(&read_req, '\0', sizeof(NCS_OS_POSIX_SHM_REQ_INFO));
 		memset(&sect_hdr, '\0', sizeof(CPSV_SECT_HDR));
@@ -266,8 +258,6 @@ uint32_t cpnd_ckpt_replica_create_res(CPND_CB *cb,
 		   (sizeof(CPSV_SECT_HDR)+(*cp_node)->create_attrib.maxSectionSize);
 		   m_CPND_SEC_HDR_UPDATE(sect_hdr,open_req->info.open.o_addr+sizeof(CPSV_CKPT_HDR),offset);
 		 */
-		(*cp_node)->replica_info.shm_sec_mapping[sec_cnt] = 0;
-		sec_cnt++;
 		counter++;
 		pSecPtr = m_MMGR_ALLOC_CPND_CKPT_SECTION_INFO;
 		if (pSecPtr == NULL) {
@@ -317,9 +307,7 @@ uint32_t cpnd_ckpt_replica_create_res(CPND_CB *cb,
 	return rc;
 
 end:
-	if ((*cp_node)->replica_info.shm_sec_mapping != NULL)
-		m_MMGR_FREE_CPND_DEFAULT(
-		    (*cp_node)->replica_info.shm_sec_mapping);
+	cpnd_ckpt_sec_mapping_free(*cp_node);
 	cpnd_res_ckpt_sec_del(*cp_node);
 	TRACE_LEAVE2("Ret val %d", rc);
 	return rc;
@@ -18,37 +18,176 @@
 /*****************************************************************************
  *   FILE NAME: cpnd_sec.cc
  *
- *   DESCRIPTION: C++ implementation of section id map
+ *   DESCRIPTION: C++ implementation of section id index
  *
  ****************************************************************************/
 
+#include <cstdint>
 #include <cstring>
-#include <map>
+#include <vector>
 #include "base/logtrace.h"
 #include "base/ncsgl_defs.h"
 #include "ckpt/ckptnd/cpnd.h"
 
-struct ltSectionIdT {
-  bool operator()(const SaCkptSectionIdT *s1,
-                  const SaCkptSectionIdT *s2) const {
-    bool status(false);
+// Index of the sections of a replica. The sections are found by section id
+// in an open addressing hash table with linear probing, and by local section
+// id in a table indexed by it. The sections are also linked in the order they
+// were added, which is the order they are iterated in; a section added during
+// an iteration is thus visited by it.
+//
+// Note: the sections used to be iterated in section id order (shortest id
+// first, then memcmp order). A section iteration, the replica transfer to
+// another node and the restart code now see them in the order they were
+// added instead. The SA Forum API does not define the order of a section
+// iteration.
+class SectionIndex {
+ public:
+  SectionIndex()
+      : slots_(kMinSlots), no_of_sections_{0}, first_{kNone}, last_{kNone} {}
+
+  bool empty() const { return no_of_sections_ == 0; }
+
+  CPND_CKPT_SECTION_INFO *Find(const SaCkptSectionIdT *id) const {
+    const Slot &slot(slots_[Probe(id, Hash(id))]);
+    return slot.section;
+  }
+
+  CPND_CKPT_SECTION_INFO *FindLocal(uint32_t lcl_sec_id) const {
+    return lcl_sec_id < local_.size() ? local_[lcl_sec_id].section : nullptr;
+  }
 
-    if (s1->idLen < s2->idLen)
-      status = true;
-    else if (s1->idLen > s2->idLen)
-      status = false;
+  bool Add(CPND_CKPT_SECTION_INFO *section) {
+    uint32_t lcl_sec_id(section->lcl_sec_id);
+    if (lcl_sec_id == kNone || FindLocal(lcl_sec_id) != nullptr) return false;
+    uint64_t hash(Hash(&section->sec_id));
+    size_t index(Probe(&section->sec_id, hash));
+    if (slots_[index].section != nullptr) return false;
+
+    if (lcl_sec_id >= local_.size()) local_.resize(lcl_sec_id + 1);
+    Local &local(local_[lcl_sec_id]);
+    local.section = section;
+    local.prev = last_;
+    local.next = kNone;
+    if (last_ == kNone)
+      first_ = lcl_sec_id;
     else
-      status = (memcmp(s1->id, s2->id, s1->idLen) < 0);
+      local_[last_].next = lcl_sec_id;
+    last_ = lcl_sec_id;
+
+    slots_[index].hash = hash;
+    slots_[index].section = section;
+    // At most 3/4 of the slots are used, to keep the probe sequences short
+    if (++no_of_sections_ * 4 > slots_.size() * 3) Grow();
+    return true;
+  }
 
-    return status;
+  CPND_CKPT_SECTION_INFO *Remove(const SaCkptSectionIdT *id) {
+    size_t index(Probe(id, Hash(id)));
+    CPND_CKPT_SECTION_INFO *section(slots_[index].section);
+    if (section == nullptr) return nullptr;
+    Erase(index);
+
+    Local &local(local_[section->lcl_sec_id]);
+    if (local.prev == kNone)
+      first_ = local.next;
+    else
+      local_[local.prev].next = local.next;
+    if (local.next == kNone)
+      last_ = local.prev;
+    else
+      local_[local.next].prev = local.prev;
+    local.section = nullptr;
+    local.prev = local.next = kNone;
+    --no_of_sections_;
+    return section;
   }
-};
 
-typedef std::map<const SaCkptSectionIdT *, CPND_CKPT_SECTION_INFO *,
-                 ltSectionIdT>
-    SectionMap;
+  CPND_CKPT_SECTION_INFO *First() const {
+    return first_ != kNone ? local_[first_].section : nullptr;
+  }
+
+  CPND_CKPT_SECTION_INFO *Next(const CPND_CKPT_SECTION_INFO *section) const {
+    if (FindLocal(section->lcl_sec_id) != section) return nullptr;
+    uint32_t next(local_[section->lcl_sec_id].next);
+    return next != kNone ? local_[next].section : nullptr;
+  }
+
+ private:
+  static constexpr size_t kMinSlots = 16;
+  static constexpr uint32_t kNone = UINT32_MAX;
+
+  struct Slot {
+    uint64_t hash{0};
+    CPND_CKPT_SECTION_INFO *section{nullptr};
+  };
+
+  struct Local {
+    CPND_CKPT_SECTION_INFO *section{nullptr};
+    uint32_t prev{kNone};
+    uint32_t next{kNone};
+  };
+
+  // FNV-1a
+  static uint64_t Hash(const SaCkptSectionIdT *id) {
+    uint64_t hash(UINT64_C(14695981039346656037));
+    for (SaUint16T i = 0; i < id->idLen; ++i) {
+      hash ^= id->id[i];
+      hash *= UINT64_C(1099511628211);
+    }
+    return hash;
+  }
 
-typedef std::map<uint32_t, CPND_CKPT_SECTION_INFO *> LocalSectionIdMap;
+  // Return the slot of the section with the section id @a id, or the empty
+  // slot ending its probe sequence if there is no such section
+  size_t Probe(const SaCkptSectionIdT *id, uint64_t hash) const {
+    size_t mask(slots_.size() - 1);
+    size_t index(hash & mask);
+    while (slots_[index].section != nullptr) {
+      const Slot &slot(slots_[index]);
+      if (slot.hash == hash && slot.section->sec_id.idLen == id->idLen &&
+          memcmp(slot.section->sec_id.id, id->id, id->idLen) == 0)
+        break;
+      index = (index + 1) & mask;
+    }
+    return index;
+  }
+
+  // Empty the slot @a index, moving back the slots after it in the same
+  // probe sequences so that no tombstones are needed
+  void Erase(size_t index) {
+    size_t mask(slots_.size() - 1);
+    size_t next(index);
+    while (true) {
+      next = (next + 1) & mask;
+      if (slots_[next].section == nullptr) break;
+      size_t home(slots_[next].hash & mask);
+      // Moved back unless its home slot is cyclically in (index, next]
+      if (((next - home) & mask) >= ((next - index) & mask)) {
+        slots_[index] = slots_[next];
+        index = next;
+      }
+    }
+    slots_[index] = Slot{};
+  }
+
+  void Grow() {
+    std::vector<Slot> slots(slots_.size() * 2);
+    slots_.swap(slots);
+    size_t mask(slots_.size() - 1);
+    for (const Slot &slot : slots) {
+      if (slot.section == nullptr) continue;
+      size_t index(slot.hash & mask);
+      while (slots_[index].section != nullptr) index = (index + 1) & mask;
+      slots_[index] = slot;
+    }
+  }
+
+  std::vector<Slot> slots_;
+  std::vector<Local> local_;
+  size_t no_of_sections_;
+  uint32_t first_;
+  uint32_t last_;
+};
 
 void cpnd_ckpt_sec_map_init(CPND_CKPT_REPLICA_INFO *replicaInfo) {
   if (replicaInfo->section_db) {
@@ -56,21 +195,13 @@ void cpnd_ckpt_sec_map_init(CPND_CKPT_REPLICA_INFO *replicaInfo) {
     osafassert(false);
   }
 
-  if (replicaInfo->local_section_db) {
-    LOG_ER("section map for local section id already exists");
-    osafassert(false);
-  }
-
-  replicaInfo->section_db = new SectionMap;
-  replicaInfo->local_section_db = new LocalSectionIdMap;
+  replicaInfo->section_db = new SectionIndex;
 }
 
 void cpnd_ckpt_sec_map_destroy(CPND_CKPT_REPLICA_INFO *replicaInfo) {
-  delete static_cast<SectionMap *>(replicaInfo->section_db);
-  delete static_cast<LocalSectionIdMap *>(replicaInfo->local_section_db);
+  delete static_cast<SectionIndex *>(replicaInfo->section_db);
 
   replicaInfo->section_db = 0;
-  replicaInfo->local_section_db = 0;
 }
 
 /****************************************************************************
@@ -92,13 +223,11 @@ CPND_CKPT_SECTION_INFO *cpnd_ckpt_sec_get(const CPND_CKPT_NODE *cp_node,
   TRACE_ENTER();
 
   if (cp_node->replica_info.n_secs) {
-    SectionMap *map(
-        static_cast<SectionMap *>(cp_node->replica_info.section_db));
+    SectionIndex *index(
+        static_cast<SectionIndex *>(cp_node->replica_info.section_db));
 
-    if (map) {
-      SectionMap::iterator it(map->find(id));
-
-      if (it != map->end()) sectionInfo = it->second;
+    if (index) {
+      sectionInfo = index->Find(id);
     } else {
       LOG_ER("can't find map in cpnd_ckpt_sec_get");
       osafassert(false);
@@ -165,35 +294,24 @@ CPND_CKPT_SECTION_INFO *cpnd_ckpt_sec_del(CPND_CB *cb, CPND_CKPT_NODE *cp_node,
 
   TRACE_ENTER();
 
-  SectionMap *map(static_cast<SectionMap *>(cp_node->replica_info.section_db));
-
-  if (map) {
-    SectionMap::iterator it(map->find(id));
-
-    if (it != map->end()) {
-      sectionInfo = it->second;
-      map->erase(it);
+  SectionIndex *index(
+      static_cast<SectionIndex *>(cp_node->replica_info.section_db));
+
+  if (index) {
+    sectionInfo = index->Find(id);
+    // A transfer of the replica to a new replica goes on with the next
+    // section
+    for (CPND_REPL_SYNC *sync(cp_node->repl_sync_list); sectionInfo && sync;
+         sync = sync->next) {
+      if (sync->next_sec == sectionInfo)
+        sync->next_sec = index->Next(sectionInfo);
     }
+    sectionInfo = index->Remove(id);
   } else {
     LOG_ER("can't find map in cpnd_ckpt_sec_del");
     osafassert(false);
   }
 
-  LocalSectionIdMap *localSecMap(
-      static_cast<LocalSectionIdMap *>(cp_node->replica_info.local_section_db));
-
-  if (localSecMap) {
-    if (sectionInfo) {
-      LocalSectionIdMap::iterator it(
-          localSecMap->find(sectionInfo->lcl_sec_id));
-
-      if (it != localSecMap->end()) localSecMap->erase(it);
-    }
-  } else {
-    LOG_ER("can't find local sec map in cpnd_ckpt_sec_del");
-    osafassert(false);
-  }
-
   if (sectionInfo) {
     cp_node->replica_info.n_secs--;
     cp_node->replica_info.mem_used =
@@ -211,6 +329,10 @@ CPND_CKPT_SECTION_INFO *cpnd_ckpt_sec_del(CPND_CB *cb, CPND_CKPT_NODE *cp_node,
         LOG_ER("cpnd ckpt hdr update failed");
       }
     }
+
+    // Not to be read directly from the replica any more
+    cpnd_sec_seq_begin(cp_node, sectionInfo->lcl_sec_id);
+    cpnd_sec_seq_end(cp_node, sectionInfo->lcl_sec_id, false);
   }
 
   TRACE_LEAVE();
@@ -234,40 +356,17 @@ uint32_t cpnd_ckpt_sec_add_db(CPND_CKPT_REPLICA_INFO *replicaInfo,
                               CPND_CKPT_SECTION_INFO *sectionInfo) {
   uint32_t rc(NCSCC_RC_SUCCESS);
 
-  SectionMap *map(static_cast<SectionMap *>(replicaInfo->section_db));
-
-  if (map) {
-    std::pair<SectionMap::iterator, bool> p(
-        map->insert(std::make_pair(&sectionInfo->sec_id, sectionInfo)));
-
-    if (!p.second) {
-      LOG_ER("unable to add section info to map");
-      rc = NCSCC_RC_FAILURE;
-      return rc;
-    }
-  } else {
-    LOG_ER("can't find map in cpnd_ckpt_sec_add_db");
-    osafassert(false);
-  }
+  SectionIndex *index(static_cast<SectionIndex *>(replicaInfo->section_db));
 
-  LocalSectionIdMap *localSecMap(
-      static_cast<LocalSectionIdMap *>(replicaInfo->local_section_db));
-
-  if (localSecMap) {
-    std::pair<LocalSectionIdMap::iterator, bool> p(localSecMap->insert(
-        std::make_pair(sectionInfo->lcl_sec_id, sectionInfo)));
-
-    if (!p.second) {
+  if (index) {
+    if (!index->Add(sectionInfo)) {
       LOG_ER(
-          "unable to add section info to local section id map - the id %d already existed",
+          "unable to add section info to map - the section id or the local section id %d already existed",
           sectionInfo->lcl_sec_id);
       rc = NCSCC_RC_FAILURE;
-
-      /* Erase the element was inserted into section_db */
-      map->erase(&sectionInfo->sec_id);
     }
   } else {
-    LOG_ER("can't find local sec map in cpnd_ckpt_sec_add_db");
+    LOG_ER("can't find map in cpnd_ckpt_sec_add_db");
     osafassert(false);
   }
 
@@ -286,35 +385,23 @@ uint32_t cpnd_ckpt_sec_add_db(CPND_CKPT_REPLICA_INFO *replicaInfo,
  * Notes         : None.
  *****************************************************************************/
 void cpnd_ckpt_delete_all_sect(CPND_CKPT_NODE *cp_node) {
-  LocalSectionIdMap *localSecMap(
-      static_cast<LocalSectionIdMap *>(cp_node->replica_info.local_section_db));
-
-  if (localSecMap) {
-    localSecMap->erase(localSecMap->begin(), localSecMap->end());
-  } else {
-    LOG_ER("can't find local sec map in cpnd_ckpt_delete_all_sect");
-    osafassert(false);
-  }
+  SectionIndex *index(
+      static_cast<SectionIndex *>(cp_node->replica_info.section_db));
 
-  SectionMap *map(static_cast<SectionMap *>(cp_node->replica_info.section_db));
+  if (index) {
+    CPND_CKPT_SECTION_INFO *section;
 
-  if (map) {
-    SectionMap::iterator it(map->begin());
-
-    while (it != map->end()) {
+    while ((section = index->First()) != nullptr) {
+      index->Remove(&section->sec_id);
       cp_node->replica_info.n_secs--;
 
-      CPND_CKPT_SECTION_INFO *section(it->second);
+      cpnd_sec_seq_begin(cp_node, section->lcl_sec_id);
+      cpnd_sec_seq_end(cp_node, section->lcl_sec_id, false);
 
       if (section->ckpt_sec_exptmr.is_active)
         cpnd_tmr_stop(&section->ckpt_sec_exptmr);
 
       m_CPND_FREE_CKPT_SECTION(section);
-
-      SectionMap::iterator tmpIt(it);
-      ++it;
-
-      map->erase(tmpIt);
     }
   } else {
     LOG_ER("can't find sec map in cpnd_ckpt_delete_all_sect");
@@ -339,13 +426,11 @@ CPND_CKPT_SECTION_INFO *cpnd_get_sect_with_id(const CPND_CKPT_NODE *cp_node,
   CPND_CKPT_SECTION_INFO *sectionInfo(0);
 
   if (cp_node->replica_info.n_secs) {
-    LocalSectionIdMap *map(static_cast<LocalSectionIdMap *>(
-        cp_node->replica_info.local_section_db));
-
-    if (map) {
-      LocalSectionIdMap::iterator it(map->find(lcl_sec_id));
+    SectionIndex *index(
+        static_cast<SectionIndex *>(cp_node->replica_info.section_db));
 
-      if (it != map->end()) sectionInfo = it->second;
+    if (index) {
+      sectionInfo = index->FindLocal(lcl_sec_id);
     } else {
       LOG_ER("can't find sec map in cpnd_get_sect_with_id");
       osafassert(false);
@@ -358,21 +443,19 @@ CPND_CKPT_SECTION_INFO *cpnd_get_sect_with_id(const CPND_CKPT_NODE *cp_node,
 }
 
 bool cpnd_ckpt_sec_empty(const CPND_CKPT_REPLICA_INFO *replicaInfo) {
-  SectionMap *map(static_cast<SectionMap *>(replicaInfo->section_db));
+  SectionIndex *index(static_cast<SectionIndex *>(replicaInfo->section_db));
 
-  return map ? map->empty() : true;
+  return index ? index->empty() : true;
 }
 
 CPND_CKPT_SECTION_INFO *cpnd_ckpt_sec_get_first(
     const CPND_CKPT_REPLICA_INFO *replicaInfo) {
   CPND_CKPT_SECTION_INFO *sectionInfo(0);
 
-  SectionMap *map(static_cast<SectionMap *>(replicaInfo->section_db));
+  SectionIndex *index(static_cast<SectionIndex *>(replicaInfo->section_db));
 
-  if (map) {
-    SectionMap::iterator it(map->begin());
-
-    if (it != map->end()) sectionInfo = it->second;
+  if (index) {
+    sectionInfo = index->First();
   } else {
     LOG_ER("can't find sec map in cpnd_ckpt_sec_get_first");
   }
@@ -385,14 +468,10 @@ CPND_CKPT_SECTION_INFO *cpnd_ckpt_sec_get_next(
     const CPND_CKPT_SECTION_INFO *section) {
   CPND_CKPT_SECTION_INFO *sectionInfo(0);
 
-  SectionMap *map(static_cast<SectionMap *>(replicaInfo->section_db));
-
-  if (map) {
-    SectionMap::iterator it(map->find(&section->sec_id));
+  SectionIndex *index(static_cast<SectionIndex *>(replicaInfo->section_db));
 
-    if (it != map->end()) {
-      if (++it != map->end()) sectionInfo = it->second;
-    }
+  if (index) {
+    sectionInfo = index->Next(section);
   } else {
     LOG_ER("can't find sec map in cpnd_ckpt_sec_get_next");
   }
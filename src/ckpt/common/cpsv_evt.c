@@ -799,6 +799,15 @@ char *cpsv_evt_str(CPSV_EVT *evt, char *o_evt_str, size_t len)
 			    "CPND_EVT_D2ND_CKPT_INFO_UPDATE_ACK(err=%u)",
 			    evt->info.cpnd.info.ckpt_info_update_ack.error);
 			break;
+		case CPND_EVT_REPL_SYNC: {
+			CPSV_CKPT_DEST_INFO *info =
+			    &evt->info.cpnd.info.repl_sync;
+			snprintf(o_evt_str, len,
+				 "[%llu] CPND_EVT_REPL_SYNC(dest_node = 0x%X)",
+				 info->ckpt_id,
+				 m_NCS_NODE_ID_FROM_MDS_DEST(info->mds_dest));
+			break;
+		}
 		default:
 			snprintf(o_evt_str, len, "INVALID_CPND_TYPE(type = %d)",
 				 evt->info.cpnd.type);
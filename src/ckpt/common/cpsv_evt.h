@@ -191,6 +191,7 @@ typedef enum cpnd_evt_type {
   CPND_EVT_A2ND_CKPT_LIST_UPDATE, /* Checkpoint ckpt list update Call */
   CPND_EVT_A2ND_ARRIVAL_CB_UNREG, /* Checkpoint Arrival Callback Un-Register*/
   CPND_EVT_D2ND_CKPT_INFO_UPDATE_ACK, /* Checkpoint information update ack */
+  CPND_EVT_REPL_SYNC, /* Locally generated, transfer of a replica continues */
   CPND_EVT_MAX
 
 } CPND_EVT_TYPE;
@@ -816,6 +817,7 @@ typedef struct cpnd_evt {
     CPSV_MDS_INFO mds_info;
     CPND_TMR_INFO tmr_info;
     CPSV_A2ND_CKPT_LIST_UPDATE ckptListUpdate;
+    CPSV_CKPT_DEST_INFO repl_sync;
 
   } info;
 } CPND_EVT;
@@ -31,6 +31,11 @@
 #define CPSV_CPND_SHM_VERSION_DEPRECATE 2
 #define CPSV_CPND_SHM_VERSION_EXTENDED 3
 
+/* The replica of a checkpoint on a node is the shared memory object
+ * "opensaf_<ckpt name>_<node id>_<ckpt id>", created by CPND */
+#define CPND_MAX_REPLICA_NAME_LENGTH 255
+#define CPND_REP_NAME_MAX_CKPT_NAME_LENGTH (CPND_MAX_REPLICA_NAME_LENGTH - 32)
+
 typedef struct cpsv_ckpt_hdr {
   SaCkptCheckpointHandleT ckpt_id; /* Index for identifying the checkpoint */
   char ckpt_name[kOsafMaxDnLength];
@@ -58,6 +63,36 @@ typedef struct cpsv_sect_hdr {
   SaTimeT lastUpdate;
 } CPSV_SECT_HDR;
 
+/*
+ * Replica layout:
+ *
+ * | CPSV_CKPT_HDR | CPSV_SECT_HDR | section data | ... | CPSV_SECT_HDR |
+ * | section data | CPSV_REPLICA_SEQ | CPSV_SECT_SEQ | ... | CPSV_SECT_SEQ |
+ *
+ * The sequence counters after the sections let the agents read a collocated
+ * replica directly. CPND makes a counter odd before it updates the replica or
+ * the section, and even again when done, so a reader seeing the same even
+ * counter before and after copying a section has a consistent copy.
+ */
+typedef struct cpsv_replica_seq {
+  uint32_t seq; /* Odd while CPND updates sections of the replica */
+  uint32_t reserved;
+} CPSV_REPLICA_SEQ;
+
+typedef struct cpsv_sect_seq {
+  uint32_t seq;    /* Odd while CPND updates the section */
+  uint32_t in_use; /* The section header and data are valid */
+} CPSV_SECT_SEQ;
+
+#define CPSV_REPLICA_SEQ_OFFSET(max_sections, max_section_size)          \
+  ((sizeof(CPSV_CKPT_HDR) +                                              \
+    (uint64_t)(max_sections) * (sizeof(CPSV_SECT_HDR) + (max_section_size)) + \
+    7) & ~(uint64_t)7)
+
+#define CPSV_REPLICA_SIZE(max_sections, max_section_size)   \
+  (CPSV_REPLICA_SEQ_OFFSET(max_sections, max_section_size) + \
+   sizeof(CPSV_REPLICA_SEQ) + (uint64_t)(max_sections) * sizeof(CPSV_SECT_SEQ))
+
 typedef struct ckpt_info {
   SaNameT ckpt_name;
   SaCkptCheckpointHandleT ckpt_id;
@@ -35,6 +35,7 @@
 #include <random>
 #include <string>
 #include <vector>
+#include "base/logtrace_binary.h"
 #include "base/logtrace_buffer.h"
 #include "base/log_writer.h"
 #include "base/string_parse.h"
@@ -63,6 +64,7 @@ uint64_t GetInode(int fd);
 bool PrettyPrint(FILE* stream);
 bool PrettyPrint(const char* line, size_t size);
 int ExtractTrace(const std::string& core_file, const std::string& trace_file);
+int DecodeTrace(const std::string& trace_file);
 time_t ConvertToDateTime(const char* date_time, const char* format);
 bool IsValidRange(time_t from, time_t to, time_t current);
 bool IsValidDateTime(const char* input);
@@ -82,6 +84,7 @@ int main(int argc, char** argv) {
                                   {"rotate", no_argument, nullptr, 'r'},
                                   {"all", no_argument, nullptr, 'a'},
                                   {"extract-trace", required_argument, 0, 'e'},
+                                  {"decode-trace", required_argument, 0, 'D'},
                                   {"max-idle", required_argument, 0, 'i'},
                                   {"from", required_argument, 0, 'F'},
                                   {"to", required_argument, 0, 'T'},
@@ -111,13 +114,14 @@ int main(int argc, char** argv) {
   bool thread_trace = false;
   std::string input_core = "";
   std::string output_trace = "";
+  std::string binary_trace = "";
 
   if (argc == 1) {
     PrintUsage(argv[0]);
     exit(EXIT_FAILURE);
   }
 
-  while ((option = getopt_long(argc, argv, "m:b:fprade:i:F:T:",
+  while ((option = getopt_long(argc, argv, "m:b:fprade:D:i:F:T:",
                                long_options, &long_index)) != -1) {
     switch (option) {
       case 'p':
@@ -179,6 +183,9 @@ int main(int argc, char** argv) {
         }
         thread_trace = true;
         break;
+      case 'D':
+        binary_trace = std::string(optarg);
+        break;
       case 'F':
         if (optarg == nullptr) {
           fprintf(stderr, "DATE_TIME is not specified in arguments\n");
@@ -253,6 +260,7 @@ int main(int argc, char** argv) {
   }
 
   if (thread_trace) exit(ExtractTrace(input_core, output_trace));
+  if (!binary_trace.empty()) exit(DecodeTrace(binary_trace));
 
   if (argc > optind && !pretty_print_set && !delete_set && !rotate_set) {
     pretty_print_set = true;
@@ -344,6 +352,10 @@ void PrintUsage(const char* program_name) {
           "                      reads the <corefile> to extract the trace\n"
           "                      strings in all threads and writes them to\n"
           "                      the <tracefile> file.\n"
+          "-D <tracefile> or --decode-trace=<tracefile>\n"
+          "                      Print the traces in the binary trace file\n"
+          "                      <tracefile>, written by a process that has\n"
+          "                      TRACE_BINARY enabled.\n"
           "-i NUM or --max-idle=NUM\n"
           "                      Set the maximum number of idle time to NUM\n"
           "                      minutes. If a stream has not been used for\n"
@@ -644,6 +656,22 @@ int ExtractTrace(const std::string& core_file,
   return EXIT_SUCCESS;
 }
 
+int DecodeTrace(const std::string& trace_file) {
+  FILE* input = fopen(trace_file.c_str(), "r");
+  if (input == nullptr) {
+    fprintf(stderr, "Failed to open binary trace file: %s\n",
+            strerror(errno));
+    return EXIT_FAILURE;
+  }
+  bool result = LogTraceBinary::Decode(input, stdout);
+  fclose(input);
+  if (!result) {
+    fprintf(stderr, "Not a binary trace file or the file is corrupt\n");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
 time_t ConvertToDateTime(const char* date_time, const char* format) {
   struct tm timeDate;
   if (strptime(date_time, format, &timeDate) == NULL) {
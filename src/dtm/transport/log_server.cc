@@ -19,6 +19,7 @@
 #include "dtm/transport/log_server.h"
 #include <signal.h>
 #include <syslog.h>
+#include <cinttypes>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
@@ -59,9 +60,33 @@ LogServer::~LogServer() {
 }
 
 void LogServer::Run() {
+  if (writer_threads_) {
+    recv_buffers_.resize(kRecvBatchSize * LogWriter::kMaxMessageSize);
+    recv_iovecs_.resize(kRecvBatchSize);
+    recv_addrs_.resize(kRecvBatchSize);
+    recv_msgs_.resize(kRecvBatchSize);
+    for (size_t i = 0; i != kRecvBatchSize; ++i) {
+      recv_iovecs_[i].iov_base = &recv_buffers_[i * LogWriter::kMaxMessageSize];
+      recv_iovecs_[i].iov_len = LogWriter::kMaxMessageSize;
+    }
+    int sock = log_socket_.fd();
+    int recv_buffer_size = kRecvBufferSize;
+    if (sock >= 0 && setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &recv_buffer_size,
+                                sizeof(recv_buffer_size)) != 0) {
+      syslog(LOG_WARNING, "setsockopt(SO_RCVBUF) failed: %s", strerror(errno));
+    }
+    for (const auto& s : log_streams_) s.second->StartWriterThread();
+  }
+  if (async_io_) {
+    for (const auto& s : log_streams_) EnableAsyncIo(s.second);
+  }
   struct pollfd pfd[2] = {{term_fd_, POLLIN, 0}, {log_socket_.fd(), POLLIN, 0}};
   do {
-    ProcessRecvData();
+    if (writer_threads_) {
+      ProcessRecvBatch();
+    } else {
+      ProcessRecvData();
+    }
     CloseIdleStreams();
     PeriodicFlush();
     pfd[1].fd = log_socket_.fd();
@@ -80,12 +105,7 @@ void LogServer::ProcessRecvData() {
                                           &src_addr, &addrlen);
     if (result < 0) break;
     if (result == 0 || buffer[0] != '?') {
-      while (result != 0 && buffer[result - 1] == '\n') --result;
-      if (static_cast<size_t>(result) != LogWriter::kMaxMessageSize) {
-        buffer[result++] = '\n';
-      } else {
-        buffer[result - 1] = '\n';
-      }
+      result = TerminateMessage(buffer, result);
       size_t msg_id_size;
       const char* msg_id = Osaflog::GetField(buffer, result, 5, &msg_id_size);
       if (msg_id == nullptr) continue;
@@ -103,6 +123,58 @@ void LogServer::ProcessRecvData() {
   }
 }
 
+void LogServer::ProcessRecvBatch() {
+  for (size_t i = 0; i < 256 / kRecvBatchSize; ++i) {
+    int sock = log_socket_.fd();
+    if (sock < 0) break;
+    for (size_t j = 0; j != kRecvBatchSize; ++j) {
+      struct msghdr& hdr = recv_msgs_[j].msg_hdr;
+      hdr.msg_name = &recv_addrs_[j];
+      hdr.msg_namelen = sizeof(recv_addrs_[j]);
+      hdr.msg_iov = &recv_iovecs_[j];
+      hdr.msg_iovlen = 1;
+      hdr.msg_control = nullptr;
+      hdr.msg_controllen = 0;
+      hdr.msg_flags = 0;
+    }
+    int no_of_msgs;
+    do {
+      no_of_msgs = recvmmsg(sock, recv_msgs_.data(), kRecvBatchSize,
+                            MSG_DONTWAIT, nullptr);
+    } while (no_of_msgs < 0 && errno == EINTR);
+    if (no_of_msgs <= 0) break;
+    for (int j = 0; j != no_of_msgs; ++j) {
+      char* buffer = &recv_buffers_[j * LogWriter::kMaxMessageSize];
+      size_t size = recv_msgs_[j].msg_len;
+      if (size != 0 && buffer[0] == '?') {
+        ExecuteCommand(buffer, size, recv_addrs_[j],
+                       recv_msgs_[j].msg_hdr.msg_namelen);
+        continue;
+      }
+      size = TerminateMessage(buffer, size);
+      size_t msg_id_size;
+      const char* msg_id = Osaflog::GetField(buffer, size, 5, &msg_id_size);
+      if (msg_id == nullptr) continue;
+      LogStream* stream = GetStream(msg_id, msg_id_size);
+      if (stream == nullptr) continue;
+      stream_pid_map_[stream->name()] = ExtractPid(buffer, size);
+      current_stream_ = stream;
+      stream->Enqueue(buffer, size);
+    }
+    if (static_cast<size_t>(no_of_msgs) != kRecvBatchSize) break;
+  }
+}
+
+size_t LogServer::TerminateMessage(char* buffer, size_t size) {
+  while (size != 0 && buffer[size - 1] == '\n') --size;
+  if (size != LogWriter::kMaxMessageSize) {
+    buffer[size++] = '\n';
+  } else {
+    buffer[size - 1] = '\n';
+  }
+  return size;
+}
+
 void LogServer::PeriodicFlush() {
   struct timespec current = base::ReadMonotonicClock();
   auto it = log_streams_.begin();
@@ -179,6 +251,8 @@ LogServer::LogStream* LogServer::GetStream(const char* msg_id,
   if (no_of_log_streams_ >= kMaxNoOfStreams) return nullptr;
   if (!ValidateLogName(msg_id, msg_id_size)) return nullptr;
   LogStream* stream = new LogStream{log_name, max_backups_, max_file_size_};
+  if (async_io_) EnableAsyncIo(stream);
+  if (writer_threads_) stream->StartWriterThread();
   auto result = log_streams_.insert(
       std::map<std::string, LogStream*>::value_type{log_name, stream});
   if (!result.second) osaf_abort(msg_id_size);
@@ -186,6 +260,14 @@ LogServer::LogStream* LogServer::GetStream(const char* msg_id,
   return stream;
 }
 
+void LogServer::EnableAsyncIo(LogStream* stream) {
+  if (!stream->EnableAsyncIo()) {
+    syslog(LOG_WARNING, "io_uring is not available, %s is written "
+           "synchronously", stream->name());
+    async_io_ = false;
+  }
+}
+
 bool LogServer::ReadConfig(const char *transport_config_file) {
   FILE *transport_conf_file;
   char line[256];
@@ -260,6 +342,32 @@ bool LogServer::ReadConfig(const char *transport_config_file) {
                "has illegal value '%s'", &line[tag_len]);
       }
     }
+
+    if (strncmp(line, "TRANSPORT_WRITER_THREADS=",
+                strlen("TRANSPORT_WRITER_THREADS=")) == 0) {
+      tag_len = strlen("TRANSPORT_WRITER_THREADS=");
+      bool success;
+      uint64_t writer_threads = base::StrToUint64(&line[tag_len], &success);
+      if (success && writer_threads <= 1) {
+        writer_threads_ = writer_threads == 1;
+      } else {
+        syslog(LOG_ERR, "TRANSPORT_WRITER_THREADS "
+               "has illegal value '%s'", &line[tag_len]);
+      }
+    }
+
+    if (strncmp(line, "TRANSPORT_ASYNC_IO=",
+                strlen("TRANSPORT_ASYNC_IO=")) == 0) {
+      tag_len = strlen("TRANSPORT_ASYNC_IO=");
+      bool success;
+      uint64_t async_io = base::StrToUint64(&line[tag_len], &success);
+      if (success && async_io <= 1) {
+        async_io_ = async_io == 1;
+      } else {
+        syslog(LOG_ERR, "TRANSPORT_ASYNC_IO "
+               "has illegal value '%s'", &line[tag_len]);
+      }
+    }
   }
 
   /* Close file. */
@@ -414,13 +522,84 @@ LogServer::LogStream::LogStream(const std::string& log_name,
   last_write_ = base::ReadMonotonicClock();
 }
 
+LogServer::LogStream::~LogStream() {
+  if (writer_thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      stop_ = true;
+    }
+    queue_cond_.notify_one();
+    writer_thread_.join();
+  }
+  Flush();
+}
+
 void LogServer::LogStream::Write(size_t size) {
   if (log_writer_.empty()) last_flush_ = base::ReadMonotonicClock();
   log_writer_.Write(size);
   last_write_ = base::ReadMonotonicClock();
 }
 
+void LogServer::LogStream::StartWriterThread() {
+  if (writer_thread_.joinable()) return;
+  writer_thread_ = std::thread{&LogStream::WriterThread, this};
+}
+
+void LogServer::LogStream::Enqueue(const char* buffer, size_t size) {
+  last_write_ = base::ReadMonotonicClock();
+  if (!queued_since_flush_) {
+    last_flush_ = last_write_;
+    queued_since_flush_ = true;
+  }
+  bool was_empty;
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (queue_.size() + size > kMaxQueueSize) {
+      if (!dropping_) {
+        syslog(LOG_WARNING, "Log stream %s: queue full, dropping messages",
+               log_name_.c_str());
+        dropping_ = true;
+      }
+      ++dropped_;
+      return;
+    }
+    if (dropping_) {
+      syslog(LOG_NOTICE, "Log stream %s: %" PRIu64 " messages dropped",
+             log_name_.c_str(), dropped_);
+      dropping_ = false;
+      dropped_ = 0;
+    }
+    was_empty = queue_.empty();
+    queue_.append(buffer, size);
+  }
+  if (was_empty) queue_cond_.notify_one();
+}
+
+void LogServer::LogStream::WriterThread() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_cond_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (stop_) break;
+    }
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    WriteQueued();
+  }
+}
+
+void LogServer::LogStream::WriteQueued() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    writing_.swap(queue_);
+  }
+  if (!writing_.empty()) log_writer_.Write(writing_.data(), writing_.size());
+  writing_.clear();
+}
+
 void LogServer::LogStream::Flush() {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  WriteQueued();
   log_writer_.Flush();
   last_flush_ = base::ReadMonotonicClock();
+  queued_since_flush_ = false;
 }
@@ -20,9 +20,14 @@
 
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 #include "base/macros.h"
 #include "base/unix_server_socket.h"
 #include "dtm/common/osaflog_protocol.h"
@@ -30,9 +35,21 @@
 
 // This class implements a loop that receives log messages over a UNIX socket
 // and sends them to a LogWriter instance.
+//
+// With TRANSPORT_WRITER_THREADS=1 in transportd.conf, the loop receives the
+// log messages in batches with recvmmsg() and only queues them; every log
+// stream then has a writer thread doing the file I/O, so that a slow disk or
+// a busy stream does not stop the loop from emptying the socket.
+//
+// With TRANSPORT_ASYNC_IO=1, the log files are written with io_uring, see
+// LogWriter::EnableAsyncIo().
 class LogServer {
  public:
   static constexpr size_t kMaxNoOfStreams = 32;
+  // Max number of log messages received with one recvmmsg() call
+  static constexpr size_t kRecvBatchSize = 64;
+  // Receive buffer size of the socket when using writer threads
+  static constexpr int kRecvBufferSize = 4 * 1024 * 1024;
   static constexpr const char* kTransportdConfigFile =
                                        PKGSYSCONFDIR "/transportd.conf";
 
@@ -53,9 +70,12 @@ class LogServer {
   class LogStream {
    public:
     static constexpr size_t kMaxLogNameSize = 32;
+    // Max size of the log messages queued to the writer thread. Log messages
+    // are dropped when the queue is full.
+    static constexpr size_t kMaxQueueSize = 4 * 1024 * 1024;
     LogStream(const std::string& log_name, size_t max_backups,
                                                  size_t max_file_size);
-    ~LogStream() { Flush(); }
+    ~LogStream();
     size_t log_name_size() const { return log_name_.size(); }
     const char* log_name_data() const { return log_name_.data(); }
     char* current_buffer_position() {
@@ -67,8 +87,22 @@ class LogServer {
     // file will be rotated if necessary. This method performs blocking file
     // I/O.
     void Write(size_t size);
+    // Start a thread that writes the log messages queued with Enqueue().
+    void StartWriterThread();
+    bool has_writer_thread() const { return writer_thread_.joinable(); }
+    bool EnableAsyncIo() {
+      std::lock_guard<std::mutex> lock(writer_mutex_);
+      return log_writer_.EnableAsyncIo();
+    }
+    // Queue @a size bytes of log message data in the memory pointed to by @a
+    // buffer to be written by the writer thread. This method does not perform
+    // file I/O.
+    void Enqueue(const char* buffer, size_t size);
+    // Write the queued log messages, if any, and the buffered log messages to
+    // the log file.
     void Flush();
     void Rotate() {
+      std::lock_guard<std::mutex> lock(writer_mutex_);
       if (log_writer_.file_size() == 0) return;
       log_writer_.RotateLog();
     }
@@ -79,13 +113,37 @@ class LogServer {
     }
 
    private:
+    void WriterThread();
+    // Move the queued log messages to the log writer. Called with
+    // writer_mutex_ held, so that the log messages are written in order.
+    void WriteQueued();
+
     const std::string log_name_;
     struct timespec last_flush_;
     struct timespec last_write_;
+    // True if log messages have been queued since the last flush
+    bool queued_since_flush_{false};
+    // Serializes the use of log_writer_ by the writer thread and the loop
+    std::mutex writer_mutex_;
     LogWriter log_writer_;
+    std::thread writer_thread_;
+    std::mutex queue_mutex_;
+    std::condition_variable queue_cond_;
+    // Log messages queued to the writer thread and the ones being written
+    std::string queue_;
+    std::string writing_;
+    bool stop_{false};
+    bool dropping_{false};
+    uint64_t dropped_{0};
   };
 
+  // Remove trailing newlines and terminate the log message with exactly one
+  // newline. Return the new size of the log message.
+  static size_t TerminateMessage(char* buffer, size_t size);
   void ProcessRecvData();
+  // Receive log messages with recvmmsg() and queue them to the writer
+  // threads. Used instead of ProcessRecvData() when writer_threads_ is set.
+  void ProcessRecvBatch();
   void PeriodicFlush();
   std::string ExtractPid(const char* msg, size_t size);
   bool is_stream_owner_alive(const std::string& name);
@@ -114,11 +172,14 @@ class LogServer {
   std::string RotateCmd(const std::string& cmd, const std::string& arg);
   std::string RotateAllCmd(const std::string& /*cmd*/,
                            const std::string& /*arg*/);
+  void EnableAsyncIo(LogStream* stream);
   int term_fd_;
   // Configuration for LogServer
   size_t max_backups_;
   size_t max_file_size_;
   struct timespec max_idle_time_{0, 0};
+  bool writer_threads_{false};
+  bool async_io_{false};
 
   base::UnixServerSocket log_socket_;
   std::map<std::string, LogStream*> log_streams_;
@@ -126,6 +187,11 @@ class LogServer {
   LogStream* current_stream_;
   size_t no_of_log_streams_;
   static const Osaflog::ClientAddressConstantPrefix address_header_;
+  // recvmmsg() buffers, only allocated when using writer threads
+  std::vector<char> recv_buffers_;
+  std::vector<struct iovec> recv_iovecs_;
+  std::vector<struct sockaddr_un> recv_addrs_;
+  std::vector<struct mmsghdr> recv_msgs_;
 
   DELETE_COPY_AND_MOVE_OPERATORS(LogServer);
 };
@@ -13,9 +13,12 @@
  *
  */
 
+#include <sys/stat.h>
+#include <unistd.h>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
+#include <iterator>
 #include <string>
 #include "base/log_writer.h"
 #include "gtest/gtest.h"
@@ -70,3 +73,80 @@ TEST_F(LogWriterTest, ExistingFileShouldBeAppended) {
   EXPECT_EQ(line1, std::string(first_line));
   EXPECT_EQ(line2, std::string(second_line));
 }
+
+TEST_F(LogWriterTest, AsyncIoShouldWriteAndRotateInOrder) {
+  const size_t kNoOfLines = 20000;
+  LogWriter* log_writer = new LogWriter{"mds.log", 2, 64 * 1024};
+  if (!log_writer->EnableAsyncIo()) {
+    delete log_writer;
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  for (size_t i = 0; i != kNoOfLines; ++i) {
+    std::string line = "line " + std::to_string(i) + "\n";
+    memcpy(log_writer->current_buffer_position(), line.data(), line.size());
+    log_writer->Write(line.size());
+  }
+  delete log_writer;
+  struct stat statbuf;
+  EXPECT_NE(stat((tmpdir_ + "/mds.log.next").c_str(), &statbuf), 0);
+  // The last lines are in mds.log.2, mds.log.1 and mds.log, in that order
+  std::string last_line;
+  size_t expected = 0;
+  for (const char* suffix : {".2", ".1", ""}) {
+    std::ifstream istr(tmpdir_ + "/mds.log" + suffix);
+    ASSERT_TRUE(istr.is_open());
+    std::string line;
+    if (expected == 0) {
+      ASSERT_TRUE(std::getline(istr, line));
+      expected = std::stoul(line.substr(5)) + 1;
+    }
+    while (std::getline(istr, line)) {
+      ASSERT_EQ(line, "line " + std::to_string(expected));
+      ++expected;
+    }
+  }
+  EXPECT_EQ(expected, kNoOfLines);
+}
+
+TEST_F(LogWriterTest, AsyncIoFlushShouldWaitForTheWrites) {
+  LogWriter log_writer{"mds.log", 1, 5000 * 1024};
+  if (!log_writer.EnableAsyncIo()) GTEST_SKIP() << "io_uring is not available";
+  std::string data;
+  for (size_t i = 0; i != 10000; ++i) {
+    std::string line = "line " + std::to_string(i) + "\n";
+    memcpy(log_writer.current_buffer_position(), line.data(), line.size());
+    log_writer.Write(line.size());
+    data += line;
+  }
+  log_writer.Flush();
+  std::ifstream istr(tmpdir_ + std::string("/mds.log"));
+  std::string contents{std::istreambuf_iterator<char>(istr),
+                       std::istreambuf_iterator<char>()};
+  EXPECT_EQ(contents, data);
+}
+
+TEST_F(LogWriterTest, AsyncIoFailedRotationShouldRemoveTheNextFile) {
+  std::string log_file = tmpdir_ + std::string("/mds.log");
+  {
+    LogWriter log_writer{"mds.log", 0, 64 * 1024};
+    if (!log_writer.EnableAsyncIo()) {
+      GTEST_SKIP() << "io_uring is not available";
+    }
+    std::string line(100, 'x');
+    line += '\n';
+    struct stat statbuf;
+    while (stat((log_file + ".next").c_str(), &statbuf) != 0) {
+      ASSERT_LT(log_writer.file_size(), size_t{64 * 1024});
+      memcpy(log_writer.current_buffer_position(), line.data(), line.size());
+      log_writer.Write(line.size());
+    }
+    // The next file can not be renamed to a non-empty directory
+    ASSERT_EQ(unlink(log_file.c_str()), 0);
+    ASSERT_EQ(mkdir(log_file.c_str(), S_IRWXU), 0);
+    ASSERT_EQ(mkdir((log_file + "/dir").c_str(), S_IRWXU), 0);
+    log_writer.RotateLog();
+    EXPECT_NE(stat((log_file + ".next").c_str(), &statbuf), 0);
+  }
+  EXPECT_EQ(rmdir((log_file + "/dir").c_str()), 0);
+  EXPECT_EQ(rmdir(log_file.c_str()), 0);
+}
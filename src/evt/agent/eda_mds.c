@@ -22,9 +22,13 @@
 
 MDS_CLIENT_MSG_FORMAT_VER
 EDA_WRT_EDS_MSG_FMT_ARRAY[EDA_WRT_EDS_SUBPART_VER_RANGE] = {
-    1 /*msg format version for EDA subpart version 1 */
+    1, /*msg format version for EDA subpart version 1 */
+    2  /*msg format version for EDA subpart version 2 */
 };
 
+static uint32_t eda_dec_delv_evt_body(NCS_UBAID *uba,
+				      EDSV_EDA_EVT_DELIVER_CBK_PARAM *param);
+
 /****************************************************************************
   Name          : eda_enc_initialize_msg
 
@@ -570,14 +574,10 @@ static uint32_t eda_dec_chan_open_cbk_msg(NCS_UBAID *uba, EDSV_MSG *msg)
 static uint32_t eda_dec_delv_evt_cbk_msg(NCS_UBAID *uba, EDSV_MSG *msg)
 {
 	uint8_t *p8;
-	uint32_t x;
-	uint32_t fake_value;
-	uint64_t num_patterns;
 	uint32_t total_bytes = 0;
-	SaEvtEventPatternT *pattern_ptr;
 	EDSV_EDA_EVT_DELIVER_CBK_PARAM *param =
 	    &msg->info.cbk_info.param.evt_deliver_cbk;
-	uint8_t local_data[1024];
+	uint8_t local_data[12];
 
 	if (uba == NULL) {
 		TRACE_4("uba is NULL");
@@ -592,6 +592,96 @@ static uint32_t eda_dec_delv_evt_cbk_msg(NCS_UBAID *uba, EDSV_MSG *msg)
 	ncs_dec_skip_space(uba, 12);
 	total_bytes += 12;
 
+	total_bytes += eda_dec_delv_evt_body(uba, param);
+
+	return total_bytes;
+}
+
+/****************************************************************************
+  Name          : eda_dec_delv_evt_batch_cbk_msg
+
+  Description   : This routine decodes a deliver event callback message for
+		  a batch of subscriptions.
+
+  Arguments     : NCS_UBAID *msg,
+		  EDSV_MSG *msg
+
+  Return Values : uint32_t
+
+  Notes         : The subscriptions are returned in the subscs array of the
+		  message, the caller frees it.
+******************************************************************************/
+static uint32_t eda_dec_delv_evt_batch_cbk_msg(NCS_UBAID *uba, EDSV_MSG *msg)
+{
+	uint8_t *p8;
+	uint32_t x;
+	uint32_t total_bytes = 0;
+	EDSV_EDA_EVT_DELIVER_CBK_PARAM *param =
+	    &msg->info.cbk_info.param.evt_deliver_cbk;
+	uint8_t local_data[16];
+
+	if (uba == NULL) {
+		TRACE_4("uba is NULL");
+		return 0;
+	}
+
+	/* num_subscs */
+	p8 = ncs_dec_flatten_space(uba, local_data, 4);
+	param->num_subscs = ncs_decode_32bit(&p8);
+	ncs_dec_skip_space(uba, 4);
+	total_bytes += 4;
+
+	param->subscs = NULL;
+	if (param->num_subscs) {
+		param->subscs =
+		    m_MMGR_ALLOC_EDSV_DELIVER_SUBSCS(param->num_subscs);
+		if (!param->subscs) {
+			TRACE_4("malloc failed for subscriptions");
+			param->num_subscs = 0;
+			return 0;
+		}
+	}
+
+	/* reg_id, sub_id, chan_id, chan_open_id of each subscription */
+	for (x = 0; x < param->num_subscs; x++) {
+		p8 = ncs_dec_flatten_space(uba, local_data, 16);
+		param->subscs[x].reg_id = ncs_decode_32bit(&p8);
+		param->subscs[x].sub_id = ncs_decode_32bit(&p8);
+		param->subscs[x].chan_id = ncs_decode_32bit(&p8);
+		param->subscs[x].chan_open_id = ncs_decode_32bit(&p8);
+		ncs_dec_skip_space(uba, 16);
+		total_bytes += 16;
+	}
+
+	total_bytes += eda_dec_delv_evt_body(uba, param);
+
+	return total_bytes;
+}
+
+/****************************************************************************
+  Name          : eda_dec_delv_evt_body
+
+  Description   : This routine decodes the event of a deliver event callback
+		  message, everything from the patterns on.
+
+  Arguments     : NCS_UBAID *msg,
+		  EDSV_EDA_EVT_DELIVER_CBK_PARAM *param
+
+  Return Values : uint32_t
+
+  Notes         : None.
+******************************************************************************/
+static uint32_t eda_dec_delv_evt_body(NCS_UBAID *uba,
+				      EDSV_EDA_EVT_DELIVER_CBK_PARAM *param)
+{
+	uint8_t *p8;
+	uint32_t x;
+	uint32_t fake_value;
+	uint64_t num_patterns;
+	uint32_t total_bytes = 0;
+	SaEvtEventPatternT *pattern_ptr;
+	uint8_t local_data[1024];
+
 	/* Decode the patterns.
 	 * Must allocate space for these.
 	 */
@@ -723,6 +813,219 @@ static uint32_t eda_dec_clm_status_cbk_msg(NCS_UBAID *uba, EDSV_MSG *msg)
 	return total_bytes;
 }
 
+/****************************************************************************
+  Name          : eda_eds_deliver_evt_proc
+
+  Description   : This routine adds an event record for a delivered event
+		  and queues the callback message on the mailbox of the
+		  handle it was delivered to.
+
+  Arguments     : EDA_CB *eda_cb,
+		  EDSV_MSG *edsv_msg,
+		  MDS_SEND_PRIORITY_TYPE prio
+
+  Return Values : NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE
+
+  Notes         : Takes ownership of the message.
+******************************************************************************/
+static uint32_t eda_eds_deliver_evt_proc(EDA_CB *eda_cb, EDSV_MSG *edsv_msg,
+					 MDS_SEND_PRIORITY_TYPE prio)
+{
+	EDA_CLIENT_HDL_REC *eda_hdl_rec;
+	EDA_CHANNEL_HDL_REC *chan_hdl_rec;
+	EDA_EVENT_HDL_REC *evt_hdl_rec;
+	EDSV_EDA_EVT_DELIVER_CBK_PARAM *evt_dlv_param =
+	    &edsv_msg->info.cbk_info.param.evt_deliver_cbk;
+
+	/** Lookup the hdl rec
+	 **/
+	if (NULL == (eda_hdl_rec = eda_find_hdl_rec_by_regid(
+			 eda_cb, edsv_msg->info.cbk_info.eds_reg_id))) {
+		TRACE_4("reg record not found reg_id: %u",
+			edsv_msg->info.cbk_info.eds_reg_id);
+		edsv_free_evt_pattern_array(evt_dlv_param->pattern_array);
+		evt_dlv_param->pattern_array = NULL;
+		/** free the event data if any **/
+		if (evt_dlv_param->data) {
+			m_MMGR_FREE_EDSV_EVENT_DATA(evt_dlv_param->data);
+			evt_dlv_param->data = NULL;
+		}
+		eda_msg_destroy(edsv_msg);
+		return NCSCC_RC_FAILURE;
+	}
+
+	/** Lookup the channel record to which
+	 ** this event belongs
+	 **/
+	if (NULL == (chan_hdl_rec = eda_find_chan_hdl_rec_by_chan_id(
+			 eda_hdl_rec, evt_dlv_param->chan_id,
+			 evt_dlv_param->chan_open_id))) {
+		TRACE_4("chan rec not found for chan_id: %u, chan_open_id: %u",
+			evt_dlv_param->chan_id, evt_dlv_param->chan_open_id);
+		edsv_free_evt_pattern_array(evt_dlv_param->pattern_array);
+		evt_dlv_param->pattern_array = NULL;
+		/** free the event data if any **/
+		if (evt_dlv_param->data) {
+			m_MMGR_FREE_EDSV_EVENT_DATA(evt_dlv_param->data);
+			evt_dlv_param->data = NULL;
+		}
+		eda_msg_destroy(edsv_msg);
+		return NCSCC_RC_FAILURE;
+	}
+
+	/** Create/Add the new event record.
+	 **/
+	if (NULL == (evt_hdl_rec = eda_event_hdl_rec_add(&chan_hdl_rec))) {
+		edsv_free_evt_pattern_array(evt_dlv_param->pattern_array);
+		evt_dlv_param->pattern_array = NULL;
+		/** free the event data if any **/
+		if (evt_dlv_param->data) {
+			m_MMGR_FREE_EDSV_EVENT_DATA(evt_dlv_param->data);
+			evt_dlv_param->data = NULL;
+		}
+		eda_msg_destroy(edsv_msg);
+		TRACE_4("event record add failed");
+		return NCSCC_RC_FAILURE;
+	}
+
+	/** Initialize the fields in the evt_hdl_rec with data
+	 ** received in the message.
+	 **/
+	evt_hdl_rec->priority = evt_dlv_param->priority;
+	evt_hdl_rec->publisher_name = evt_dlv_param->publisher_name;
+	evt_hdl_rec->publish_time = evt_dlv_param->publish_time;
+	evt_hdl_rec->retention_time = evt_dlv_param->retention_time;
+	evt_hdl_rec->event_data_size = evt_dlv_param->data_len;
+
+	/** mark the event as rcvd.
+	 **/
+	evt_hdl_rec->evt_type |= EDA_EVT_RECEIVED;
+
+	/** Create/Add the new event inst record.
+	 **/
+
+	/** The evt hdl rec will take ownership of the memory
+	 ** for the patterns & data to avoid too many copies
+	 ** and not that much use of these in the callback.
+	 **/
+	evt_hdl_rec->del_evt_id = evt_dlv_param->eda_event_id;
+	evt_hdl_rec->pattern_array = evt_dlv_param->pattern_array;
+	evt_dlv_param->pattern_array = NULL;
+
+	evt_hdl_rec->evt_data = evt_dlv_param->data;
+	evt_dlv_param->data = NULL;
+
+	/* assign the newly allocated hdl */
+	evt_dlv_param->event_hdl = evt_hdl_rec->event_hdl;
+
+	/** enqueue this message. MDS & IPC priority match 1-1
+	 **/
+	if (NCSCC_RC_SUCCESS !=
+	    m_NCS_IPC_SEND(&eda_hdl_rec->mbx, edsv_msg, prio)) {
+		TRACE_4("IPC send failed for msg type: %u", edsv_msg->type);
+		return NCSCC_RC_FAILURE;
+	}
+
+	return NCSCC_RC_SUCCESS;
+}
+
+/****************************************************************************
+  Name          : eda_eds_deliver_evt_batch_proc
+
+  Description   : This routine splits an event delivered to a batch of
+		  subscriptions into one deliver event callback message per
+		  subscription, as if they had been sent one by one.
+
+  Arguments     : EDA_CB *eda_cb,
+		  EDSV_MSG *edsv_msg,
+		  MDS_SEND_PRIORITY_TYPE prio
+
+  Return Values : NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE
+
+  Notes         : Takes ownership of the message. The message itself is
+		  reused for the last subscription, which also takes over the
+		  patterns and the data.
+******************************************************************************/
+static uint32_t eda_eds_deliver_evt_batch_proc(EDA_CB *eda_cb,
+					       EDSV_MSG *edsv_msg,
+					       MDS_SEND_PRIORITY_TYPE prio)
+{
+	EDSV_MSG *msg;
+	EDSV_EDA_EVT_DELIVER_CBK_PARAM *param =
+	    &edsv_msg->info.cbk_info.param.evt_deliver_cbk;
+	EDSV_EDA_EVT_DELIVER_CBK_PARAM *msg_param;
+	EDSV_EDA_EVT_DELIVER_SUBSC *subscs = param->subscs;
+	uint32_t num_subscs = param->num_subscs;
+	uint32_t x;
+	uint32_t rc = NCSCC_RC_SUCCESS;
+	SaAisErrorT error;
+
+	param->subscs = NULL;
+	param->num_subscs = 0;
+	edsv_msg->info.cbk_info.type = EDSV_EDS_DELIVER_EVENT;
+
+	for (x = 0; x + 1 < num_subscs; x++) {
+		msg = m_MMGR_ALLOC_EDSV_MSG;
+		if (!msg) {
+			TRACE_4("malloc failed for deliver event message");
+			rc = NCSCC_RC_FAILURE;
+			continue;
+		}
+		*msg = *edsv_msg;
+		msg_param = &msg->info.cbk_info.param.evt_deliver_cbk;
+		msg_param->data = NULL;
+		msg_param->pattern_array =
+		    edsv_copy_evt_pattern_array(param->pattern_array, &error);
+		if (msg_param->pattern_array && param->data_len) {
+			msg_param->data = m_MMGR_ALLOC_EDSV_EVENT_DATA(
+			    (uint32_t)param->data_len);
+			if (msg_param->data)
+				memcpy(msg_param->data, param->data,
+				       (size_t)param->data_len);
+		}
+		if (!msg_param->pattern_array ||
+		    (param->data_len && !msg_param->data)) {
+			TRACE_4("copy of event failed");
+			if (msg_param->pattern_array)
+				edsv_free_evt_pattern_array(
+				    msg_param->pattern_array);
+			m_MMGR_FREE_EDSV_MSG(msg);
+			rc = NCSCC_RC_FAILURE;
+			continue;
+		}
+
+		msg->info.cbk_info.eds_reg_id = subscs[x].reg_id;
+		msg_param->sub_id = subscs[x].sub_id;
+		msg_param->chan_id = subscs[x].chan_id;
+		msg_param->chan_open_id = subscs[x].chan_open_id;
+		if (eda_eds_deliver_evt_proc(eda_cb, msg, prio) !=
+		    NCSCC_RC_SUCCESS)
+			rc = NCSCC_RC_FAILURE;
+	}
+
+	if (num_subscs == 0) {
+		edsv_free_evt_pattern_array(param->pattern_array);
+		param->pattern_array = NULL;
+		if (param->data) {
+			m_MMGR_FREE_EDSV_EVENT_DATA(param->data);
+			param->data = NULL;
+		}
+		eda_msg_destroy(edsv_msg);
+		return NCSCC_RC_FAILURE;
+	}
+
+	edsv_msg->info.cbk_info.eds_reg_id = subscs[x].reg_id;
+	param->sub_id = subscs[x].sub_id;
+	param->chan_id = subscs[x].chan_id;
+	param->chan_open_id = subscs[x].chan_open_id;
+	m_MMGR_FREE_EDSV_DELIVER_SUBSCS(subscs);
+	if (eda_eds_deliver_evt_proc(eda_cb, edsv_msg, prio) !=
+	    NCSCC_RC_SUCCESS)
+		rc = NCSCC_RC_FAILURE;
+
+	return rc;
+}
+
 /****************************************************************************
   Name          : eda_eds_msg_proc
 
@@ -803,118 +1106,11 @@ static uint32_t eda_eds_msg_proc(EDA_CB *eda_cb, EDSV_MSG *edsv_msg,
 				return NCSCC_RC_FAILURE;
 			}
 		} break;
-		case EDSV_EDS_DELIVER_EVENT: {
-			EDA_CLIENT_HDL_REC *eda_hdl_rec;
-			EDA_CHANNEL_HDL_REC *chan_hdl_rec;
-			EDA_EVENT_HDL_REC *evt_hdl_rec;
-			EDSV_EDA_EVT_DELIVER_CBK_PARAM *evt_dlv_param =
-			    &edsv_msg->info.cbk_info.param.evt_deliver_cbk;
-
-			/** Lookup the hdl rec
-			 **/
-			if (NULL ==
-			    (eda_hdl_rec = eda_find_hdl_rec_by_regid(
-				 eda_cb, edsv_msg->info.cbk_info.eds_reg_id))) {
-				TRACE_4("reg record not found reg_id: %u",
-					edsv_msg->info.cbk_info.eds_reg_id);
-				edsv_free_evt_pattern_array(
-				    evt_dlv_param->pattern_array);
-				evt_dlv_param->pattern_array = NULL;
-				/** free the event data if any **/
-				if (evt_dlv_param->data) {
-					m_MMGR_FREE_EDSV_EVENT_DATA(
-					    evt_dlv_param->data);
-					evt_dlv_param->data = NULL;
-				}
-				eda_msg_destroy(edsv_msg);
-				return NCSCC_RC_FAILURE;
-			}
-
-			/** Lookup the channel record to which
-			 ** this event belongs
-			 **/
-			if (NULL ==
-			    (chan_hdl_rec = eda_find_chan_hdl_rec_by_chan_id(
-				 eda_hdl_rec, evt_dlv_param->chan_id,
-				 evt_dlv_param->chan_open_id))) {
-				TRACE_4(
-				    "chan rec not found for chan_id: %u, chan_open_id: %u",
-				    evt_dlv_param->chan_id,
-				    evt_dlv_param->chan_open_id);
-				edsv_free_evt_pattern_array(
-				    evt_dlv_param->pattern_array);
-				evt_dlv_param->pattern_array = NULL;
-				/** free the event data if any **/
-				if (evt_dlv_param->data) {
-					m_MMGR_FREE_EDSV_EVENT_DATA(
-					    evt_dlv_param->data);
-					evt_dlv_param->data = NULL;
-				}
-				eda_msg_destroy(edsv_msg);
-				return NCSCC_RC_FAILURE;
-			}
-
-			/** Create/Add the new event record.
-			 **/
-			if (NULL == (evt_hdl_rec = eda_event_hdl_rec_add(
-					 &chan_hdl_rec))) {
-				edsv_free_evt_pattern_array(
-				    evt_dlv_param->pattern_array);
-				evt_dlv_param->pattern_array = NULL;
-				/** free the event data if any **/
-				if (evt_dlv_param->data) {
-					m_MMGR_FREE_EDSV_EVENT_DATA(
-					    evt_dlv_param->data);
-					evt_dlv_param->data = NULL;
-				}
-				eda_msg_destroy(edsv_msg);
-				TRACE_4("event record add failed");
-				return NCSCC_RC_FAILURE;
-			}
-
-			/** Initialize the fields in the evt_hdl_rec with data
-			 ** received in the message.
-			 **/
-			evt_hdl_rec->priority = evt_dlv_param->priority;
-			evt_hdl_rec->publisher_name =
-			    evt_dlv_param->publisher_name;
-			evt_hdl_rec->publish_time = evt_dlv_param->publish_time;
-			evt_hdl_rec->retention_time =
-			    evt_dlv_param->retention_time;
-			evt_hdl_rec->event_data_size = evt_dlv_param->data_len;
-
-			/** mark the event as rcvd.
-			 **/
-			evt_hdl_rec->evt_type |= EDA_EVT_RECEIVED;
-
-			/** Create/Add the new event inst record.
-			 **/
-
-			/** The evt hdl rec will take ownership of the memory
-			 ** for the patterns & data to avoid too many copies
-			 ** and not that much use of these in the callback.
-			 **/
-			evt_hdl_rec->del_evt_id = evt_dlv_param->eda_event_id;
-			evt_hdl_rec->pattern_array =
-			    evt_dlv_param->pattern_array;
-			evt_dlv_param->pattern_array = NULL;
-
-			evt_hdl_rec->evt_data = evt_dlv_param->data;
-			evt_dlv_param->data = NULL;
-
-			/* assign the newly allocated hdl */
-			evt_dlv_param->event_hdl = evt_hdl_rec->event_hdl;
-
-			/** enqueue this message. MDS & IPC priority match 1-1
-			 **/
-			if (NCSCC_RC_SUCCESS !=
-			    m_NCS_IPC_SEND(&eda_hdl_rec->mbx, edsv_msg, prio)) {
-				TRACE_4("IPC send failed for msg type: %u",
-					edsv_msg->type);
-				return NCSCC_RC_FAILURE;
-			}
-
-		} break;
+		case EDSV_EDS_DELIVER_EVENT:
+			return eda_eds_deliver_evt_proc(eda_cb, edsv_msg, prio);
+		case EDSV_EDS_DELIVER_EVENT_BATCH:
+			return eda_eds_deliver_evt_batch_proc(eda_cb, edsv_msg,
+							      prio);
 		case EDSV_EDS_CLMNODE_STATUS: {
 			EDSV_EDA_CLM_STATUS_CBK_PARAM *clm_status_param =
 			    &edsv_msg->info.cbk_info.param.clm_status_cbk;
@@ -1385,6 +1581,9 @@ static uint32_t eda_mds_dec(struct ncsmds_callback_info *info)
 		case EDSV_EDS_DELIVER_EVENT:
 			total_bytes += eda_dec_delv_evt_cbk_msg(uba, msg);
 			break;
+		case EDSV_EDS_DELIVER_EVENT_BATCH:
+			total_bytes += eda_dec_delv_evt_batch_cbk_msg(uba, msg);
+			break;
 		case EDSV_EDS_CLMNODE_STATUS:
 			total_bytes += eda_dec_clm_status_cbk_msg(uba, msg);
 		default:
@@ -290,6 +290,7 @@ void tet_EventPublish_ChannelUnlink(void);
 void tet_EventUnsubscribe_EventPublish(void);
 void tet_EventAttributesGet_LessPatternsNumber(void);
 void tet_Simple_Test(void);
+void tet_EventPublish_BatchDeliver(void);
 /** Miscellenious Functions **/
 void tet_ChannelOpen_before_Initialize(void);
 void tet_ChannelOpen_after_Finalize(void);
@@ -1,6 +1,8 @@
+#include <poll.h>
 #include <string.h>
 #include <stdio.h>
 #include "tet_eda.h"
+#include "osaf/apitest/utest.h"
 extern int gl_sync_pointnum;
 extern int fill_syncparameters(int);
 extern int gl_jCount;
@@ -6898,6 +6900,120 @@ void tet_EventSubscribe_after_ChannelUnlink()
 	printf("\n\nCase 56: End");
 }
 
+/* Deliveries per subscription id in tet_EventPublish_BatchDeliver */
+static int batch_deliver_count[4];
+
+static void batch_deliver_callback(SaEvtSubscriptionIdT subscriptionId,
+				   SaEvtEventHandleT eventHandle,
+				   SaSizeT eventDataSize)
+{
+	if (subscriptionId < 4)
+		batch_deliver_count[subscriptionId]++;
+	saEvtEventFree(eventHandle);
+}
+
+void tet_EventPublish_BatchDeliver()
+/* One event to several subscriptions of the same process. EDS sends it once
+ * for all of them and the agent splits it up per event handle and
+ * subscription. */
+{
+	SaEvtCallbacksT callbacks = {NULL, batch_deliver_callback};
+	SaVersionT version = {'B', 1, 1};
+	SaNameT channel_name;
+	SaEvtHandleT evt_handle[2] = {0, 0};
+	SaEvtChannelHandleT channel_handle[3];
+	SaEvtEventHandleT event_handle;
+	SaEvtEventIdT event_id;
+	SaSelectionObjectT sel_obj[2];
+	struct pollfd fds[2];
+	SaEvtEventFilterT filter = {SA_EVT_PREFIX_FILTER,
+				    {5, 5, (SaUint8T *)"Batch"}};
+	SaEvtEventFilterArrayT filter_array = {1, &filter};
+	SaEvtEventPatternT pattern = {10, 10, (SaUint8T *)"BatchEvent"};
+	SaEvtEventPatternArrayT pattern_array = {1, 1, &pattern};
+	SaNameT publisher_name;
+	SaAisErrorT rc;
+	int i, tries;
+
+	printf("\n\n*******Case 63: Publish to several subscriptions of one "
+	       "process********");
+	memset(batch_deliver_count, 0, sizeof(batch_deliver_count));
+	memset(&channel_name, 0, sizeof(channel_name));
+	channel_name.length = strlen("safChnl=BatchDeliverChannel");
+	memcpy(channel_name.value, "safChnl=BatchDeliverChannel",
+	       channel_name.length);
+	memset(&publisher_name, 0, sizeof(publisher_name));
+	publisher_name.length = strlen("BatchPublisher");
+	memcpy(publisher_name.value, "BatchPublisher", publisher_name.length);
+
+	for (i = 0; i < 2; i++) {
+		rc = saEvtInitialize(&evt_handle[i], &callbacks, &version);
+		if (rc != SA_AIS_OK)
+			goto done;
+		rc = saEvtSelectionObjectGet(evt_handle[i], &sel_obj[i]);
+		if (rc != SA_AIS_OK)
+			goto done;
+		fds[i].fd = (int)sel_obj[i];
+		fds[i].events = POLLIN;
+	}
+
+	/* Two channel opens on the first handle, one on the second */
+	for (i = 0; i < 3; i++) {
+		rc = saEvtChannelOpen(evt_handle[i / 2], &channel_name,
+				      SA_EVT_CHANNEL_CREATE |
+					  SA_EVT_CHANNEL_SUBSCRIBER |
+					  SA_EVT_CHANNEL_PUBLISHER,
+				      SA_TIME_ONE_SECOND * 10,
+				      &channel_handle[i]);
+		if (rc != SA_AIS_OK)
+			goto done;
+		rc = saEvtEventSubscribe(channel_handle[i], &filter_array,
+					 i + 1);
+		if (rc != SA_AIS_OK)
+			goto done;
+	}
+
+	rc = saEvtEventAllocate(channel_handle[0], &event_handle);
+	if (rc != SA_AIS_OK)
+		goto done;
+	rc = saEvtEventAttributesSet(event_handle, &pattern_array,
+				     SA_EVT_HIGHEST_PRIORITY, 0,
+				     &publisher_name);
+	if (rc == SA_AIS_OK)
+		rc = saEvtEventPublish(event_handle, "Batch", 5, &event_id);
+	saEvtEventFree(event_handle);
+	if (rc != SA_AIS_OK)
+		goto done;
+
+	for (tries = 0; tries < 50; tries++) {
+		if (batch_deliver_count[1] && batch_deliver_count[2] &&
+		    batch_deliver_count[3])
+			break;
+		if (poll(fds, 2, 100) <= 0)
+			continue;
+		for (i = 0; i < 2; i++) {
+			if (fds[i].revents & POLLIN)
+				saEvtDispatch(evt_handle[i], SA_DISPATCH_ALL);
+		}
+	}
+
+	/* Each subscription gets the event exactly once */
+	for (i = 1; i <= 3; i++) {
+		if (batch_deliver_count[i] != 1) {
+			printf("\nsubscription %d got %d events", i,
+			       batch_deliver_count[i]);
+			rc = SA_AIS_ERR_FAILED_OPERATION;
+		}
+	}
+
+done:
+	saEvtChannelUnlink(evt_handle[0], &channel_name);
+	saEvtFinalize(evt_handle[0]);
+	saEvtFinalize(evt_handle[1]);
+	aisrc_validate(rc, SA_AIS_OK);
+	printf("\n\nCase 63: End");
+}
+
 #if 0
 
 void tet_AttributesGet_NoMemory()
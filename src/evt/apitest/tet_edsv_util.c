@@ -1448,6 +1448,8 @@ __attribute__((constructor)) static void edsv_constructor(void)
 
 	test_suite_add(18, "api test Test Suite");
         test_suite_add(19, "fun test Test Suite");
+	test_case_add(19, tet_EventPublish_BatchDeliver,
+		      "Publish to several subscriptions of one process");
 	test_suite_add(20, "saEvtLimitGet Test Suite");
 	test_case_add(20, tet_saEvtLimitGetCases_01,
 		      "EvtLimitGet() with NULL LimitValue");
@@ -79,6 +79,7 @@ typedef enum edsv_cbk_msg_type {
   EDSV_EDS_CHAN_OPEN = EDSV_CBK_BASE_MSG,
   EDSV_EDS_DELIVER_EVENT,
   EDSV_EDS_CLMNODE_STATUS,
+  EDSV_EDS_DELIVER_EVENT_BATCH, /* From message format version 2 */
   EDSV_EDS_CBK_MAX
 } EDSV_CBK_TYPE;
 
@@ -232,6 +233,14 @@ typedef struct edsv_eda_chan_open_cb_param_tag {
   SaAisErrorT error;
 } EDSV_EDA_CHAN_OPEN_CBK_PARAM;
 
+/* A subscription a batched event is delivered to */
+typedef struct edsv_eda_evt_deliver_subsc_tag {
+  uint32_t reg_id;
+  SaEvtSubscriptionIdT sub_id;
+  uint32_t chan_id;
+  uint32_t chan_open_id;
+} EDSV_EDA_EVT_DELIVER_SUBSC;
+
 typedef struct edsv_eda_evt_deliver_cb_param_tag {
   SaEvtSubscriptionIdT sub_id;
   uint32_t chan_id;
@@ -246,6 +255,10 @@ typedef struct edsv_eda_evt_deliver_cb_param_tag {
   uint32_t ret_evt_ch_oid;
   SaSizeT data_len;
   uint8_t *data;
+  /* EDSV_EDS_DELIVER_EVENT_BATCH only, used instead of reg_id, sub_id,
+   * chan_id and chan_open_id */
+  uint32_t num_subscs;
+  EDSV_EDA_EVT_DELIVER_SUBSC *subscs;
 } EDSV_EDA_EVT_DELIVER_CBK_PARAM;
 
 typedef struct edsv_eda_clm_status_param_tag {
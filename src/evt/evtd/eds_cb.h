@@ -132,11 +132,53 @@ typedef struct edsv_retained_evt_list_tag {
   struct edsv_retained_evt_list_tag *next;
 } EDS_RETAINED_EVT_REC;
 
+/*
+ * Subscription filter index of a channel, see eds_subsc_index_add(). There is
+ * a prefix trie and a suffix trie per filter position. A node of a trie is
+ * the pattern made up of the bytes on the path from the root, reversed in the
+ * suffix trie. The prefix and suffix filters are listed at the node of their
+ * pattern, the exact filters at the node of their pattern in the prefix trie.
+ */
+typedef struct eds_filter_node_tag {
+  uint8_t byte;                               /* Last byte of the pattern */
+  struct eds_filter_node_tag *parent;
+  struct eds_filter_node_tag *child;          /* First child */
+  struct eds_filter_node_tag *sibling;        /* Next child of the parent */
+  struct eds_filter_ref_tag *affix_ref_head;  /* Prefix or suffix filters */
+  struct eds_filter_ref_tag *exact_ref_head;  /* Exact filters */
+} EDS_FILTER_NODE;
+
+/* A filter of a subscription in the index */
+typedef struct eds_filter_ref_tag {
+  struct subsc_rec_tag *subrec;
+  EDS_FILTER_NODE *node;                /* NULL in the pass all list */
+  struct eds_filter_ref_tag **head;     /* List the filter is in */
+  struct eds_filter_ref_tag *prev;
+  struct eds_filter_ref_tag *next;
+} EDS_FILTER_REF;
+
+typedef struct eds_filter_pos_tag {
+  EDS_FILTER_NODE prefix_root;
+  EDS_FILTER_NODE suffix_root;
+} EDS_FILTER_POS;
+
+typedef struct eds_subsc_index_tag {
+  EDS_FILTER_POS **pos;            /* One per filter position */
+  uint32_t num_pos;
+  EDS_FILTER_REF *pass_all_head;   /* Subscriptions matching any event */
+  uint64_t match_gen;              /* Incremented for each match */
+} EDS_SUBSC_INDEX;
+
 typedef struct subsc_rec_tag {
   uint32_t subscript_id;
   uint32_t chan_id;
   uint32_t chan_open_id;
   SaEvtEventFilterArrayT *filters;
+  EDS_FILTER_REF *filter_refs; /* Filters in the index, NULL if none */
+  uint32_t num_filter_refs;
+  uint32_t match_cnt;          /* Filters matched in match_gen */
+  uint64_t match_gen;
+  struct subsc_rec_tag *match_next;
   struct eda_reg_list_tag *reg_list;
   struct chan_open_rec_tag
       *par_chan_open_inst; /* Backpointer to the channel open instance */
@@ -172,6 +214,9 @@ typedef struct chan_open_rec_tag {
       *subsc_rec_head; /* Head of  Linked list of subscriptions */
   struct subsc_rec_tag
       *subsc_rec_tail; /* Tail of  Linked list of subscriptions */
+  uint64_t match_gen;  /* Last match of the subscription index */
+  struct subsc_rec_tag *match_subrec;   /* Subscription to deliver to */
+  struct chan_open_rec_tag *match_next; /* Next channel open to deliver to */
 } CHAN_OPEN_REC;
 
 typedef struct eda_reg_list_tag {
@@ -204,6 +249,7 @@ typedef struct eds_worklist_tag {
 
   NCS_PATRICIA_TREE chan_open_rec; /* Channel Open record - mix of all opens *
                                     * on this channel for all reg_ids        */
+  EDS_SUBSC_INDEX subsc_index;     /* Filters of the subscriptions */
   EDS_RETAINED_EVT_REC
       *ret_evt_list_head[SA_EVT_LOWEST_PRIORITY + 1]; /* priority queues head */
   EDS_RETAINED_EVT_REC
@@ -225,6 +271,18 @@ typedef struct eda_down_list_tag {
   struct eda_down_list_tag *next;
 } EDA_DOWN_LIST;
 
+/* Agents known from their MDS up events, with their subpart version */
+typedef struct eda_dest_rec_tag {
+  NCS_PATRICIA_NODE pat_node;
+  MDS_DEST mds_dest;
+  MDS_SVC_PVT_SUB_PART_VER svc_pvt_ver;
+  uint64_t match_gen;                   /* Last publish grouped for */
+  struct chan_open_rec_tag *match_head; /* Channel opens to deliver to */
+  struct chan_open_rec_tag *match_tail;
+  uint32_t match_num_co;
+  struct eda_dest_rec_tag *match_next; /* Next agent to deliver to */
+} EDA_DEST_REC;
+
 /* List of current nodes in the cluster */
 typedef struct node_info_tag {
   NCS_PATRICIA_NODE pat_node;
@@ -250,6 +308,8 @@ typedef struct eds_cb_tag {
       *eda_down_list_head; /* EDA down reccords - Fix for Failover missed
                               down events Processing */
   EDA_DOWN_LIST *eda_down_list_tail;
+  NCS_PATRICIA_TREE eda_dest_list; /* EDA_DEST_REC per agent MDS_DEST */
+  uint64_t eda_dest_match_gen;     /* Incremented for each grouping */
   SaNameT comp_name;    /* Components's name EDS                     */
   SaAmfHandleT amf_hdl; /* AMF handle, obtained thru AMF init        */
   SaInvocationT
@@ -308,6 +368,12 @@ bool eds_eda_entry_valid(EDS_CB *, MDS_DEST);
 
 uint32_t eds_remove_eda_down_rec(EDS_CB *, MDS_DEST);
 
+uint32_t eds_add_eda_dest_rec(EDS_CB *, MDS_DEST, MDS_SVC_PVT_SUB_PART_VER);
+
+void eds_remove_eda_dest_rec(EDS_CB *, MDS_DEST);
+
+MDS_SVC_PVT_SUB_PART_VER eds_eda_dest_version(EDS_CB *, MDS_DEST);
+
 uint32_t eds_channel_open(EDS_CB *, uint32_t, uint32_t, uint16_t, uint8_t *,
                           MDS_DEST, uint32_t *, uint32_t *, SaTimeT);
 
@@ -326,6 +392,20 @@ uint32_t eds_remove_worklist_entry(EDS_CB *cb, uint32_t chan_id);
 
 bool eds_pattern_match(SaEvtEventPatternArrayT *, SaEvtEventFilterArrayT *);
 
+uint32_t eds_subsc_index_add(EDS_SUBSC_INDEX *, SUBSC_REC *);
+
+void eds_subsc_index_remove(SUBSC_REC *);
+
+CHAN_OPEN_REC *eds_subsc_index_match(EDS_SUBSC_INDEX *,
+                                     SaEvtEventPatternArrayT *);
+
+void eds_subsc_index_destroy(EDS_SUBSC_INDEX *);
+
+EDA_DEST_REC *eds_group_by_eda_dest(EDS_CB *, CHAN_OPEN_REC *,
+                                    CHAN_OPEN_REC **);
+
+bool eds_eda_dest_batched(const EDA_DEST_REC *);
+
 uint32_t eds_store_retained_event(EDS_CB *, EDS_WORKLIST *, CHAN_OPEN_REC *,
                                   EDSV_EDA_PUBLISH_PARAM *, SaTimeT);
 
@@ -504,6 +504,119 @@ static uint32_t eds_proc_chan_unlink_msg(EDS_CB *cb, EDSV_EDS_EVT *evt)
 	return rc;
 }
 
+/****************************************************************************
+ * Name          : eds_deliver_event
+ *
+ * Description   : Sends a published event to the matching subscription of
+ *                 one chan_open_rec.
+ *
+ * Arguments     : co  - chan_open_rec with the subscription in match_subrec.
+ *
+ * Return Values : NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE
+ *
+ * Notes         : None.
+ *****************************************************************************/
+static uint32_t eds_deliver_event(EDS_CB *cb, EDSV_EDS_EVT *evt,
+				  CHAN_OPEN_REC *co, SaTimeT publish_time,
+				  uint32_t retd_evt_chan_open_id,
+				  MDS_SEND_PRIORITY_TYPE prio)
+{
+	uint32_t rc;
+	EDSV_MSG msg;
+	SUBSC_REC *subrec = co->match_subrec;
+	EDSV_EDA_PUBLISH_PARAM *publish_param =
+	    &(evt->info.msg.info.api_info.param).publish;
+
+	/* Fill in the event record to send */
+	m_EDS_EDSV_DELIVER_EVENT_CB_MSG_FILL(
+	    msg, co->reg_id, subrec->subscript_id, subrec->chan_id,
+	    subrec->chan_open_id, publish_param->pattern_array,
+	    publish_param->priority, publish_param->publisher_name,
+	    publish_time, publish_param->retention_time,
+	    publish_param->event_id, retd_evt_chan_open_id,
+	    publish_param->data_len, publish_param->data)
+
+	/* Send the event. Only once per match/per open_id */
+	if (NCSCC_RC_SUCCESS !=
+	    (rc = eds_mds_msg_send(cb, &msg, &co->chan_opener_dest, NULL,
+				   prio))) {
+		LOG_ER("Event Publish(MDS send) failed. From publisher dest: %" PRIx64
+		       ", To subscriber dest: %" PRIx64 ",on Node_id: %u",
+		       evt->fr_dest, co->chan_opener_dest,
+		       m_NCS_NODE_ID_FROM_MDS_DEST(co->chan_opener_dest));
+	}
+	return rc;
+}
+
+/****************************************************************************
+ * Name          : eds_deliver_event_batch
+ *
+ * Description   : Sends a published event once to an agent for all its
+ *                 matching subscriptions, in an EDSV_EDS_DELIVER_EVENT_BATCH
+ *                 message.
+ *
+ * Arguments     : dest_rec - Agent with its chan_open_rec's grouped by
+ *                            eds_group_by_eda_dest().
+ *                 send_rc  - Result of the MDS send.
+ *
+ * Return Values : NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE
+ *
+ * Notes         : NCSCC_RC_FAILURE means that the batch could not be built
+ *                 and nothing was sent, the caller then sends the event
+ *                 per subscription instead.
+ *****************************************************************************/
+static uint32_t eds_deliver_event_batch(EDS_CB *cb, EDSV_EDS_EVT *evt,
+					EDA_DEST_REC *dest_rec,
+					SaTimeT publish_time,
+					uint32_t retd_evt_chan_open_id,
+					MDS_SEND_PRIORITY_TYPE prio,
+					uint32_t *send_rc)
+{
+	EDSV_MSG msg;
+	CHAN_OPEN_REC *co;
+	EDSV_EDA_EVT_DELIVER_SUBSC *subscs;
+	uint32_t x;
+	EDSV_EDA_PUBLISH_PARAM *publish_param =
+	    &(evt->info.msg.info.api_info.param).publish;
+
+	subscs = m_MMGR_ALLOC_EDSV_DELIVER_SUBSCS(dest_rec->match_num_co);
+	if (subscs == NULL)
+		return NCSCC_RC_FAILURE;
+
+	for (x = 0, co = dest_rec->match_head; co; x++, co = co->match_next) {
+		subscs[x].reg_id = co->reg_id;
+		subscs[x].sub_id = co->match_subrec->subscript_id;
+		subscs[x].chan_id = co->match_subrec->chan_id;
+		subscs[x].chan_open_id = co->match_subrec->chan_open_id;
+	}
+
+	co = dest_rec->match_head;
+	m_EDS_EDSV_DELIVER_EVENT_CB_MSG_FILL(
+	    msg, co->reg_id, subscs[0].sub_id, subscs[0].chan_id,
+	    subscs[0].chan_open_id, publish_param->pattern_array,
+	    publish_param->priority, publish_param->publisher_name,
+	    publish_time, publish_param->retention_time,
+	    publish_param->event_id, retd_evt_chan_open_id,
+	    publish_param->data_len, publish_param->data)
+	msg.info.cbk_info.type = EDSV_EDS_DELIVER_EVENT_BATCH;
+	msg.info.cbk_info.param.evt_deliver_cbk.num_subscs =
+	    dest_rec->match_num_co;
+	msg.info.cbk_info.param.evt_deliver_cbk.subscs = subscs;
+
+	if (NCSCC_RC_SUCCESS !=
+	    (*send_rc = eds_mds_msg_send(cb, &msg, &dest_rec->mds_dest, NULL,
+					 prio))) {
+		LOG_ER("Event Publish(MDS send) failed. From publisher dest: %" PRIx64
+		       ", To subscriber dest: %" PRIx64
+		       ",on Node_id: %u, subscriptions: %u",
+		       evt->fr_dest, dest_rec->mds_dest,
+		       m_NCS_NODE_ID_FROM_MDS_DEST(dest_rec->mds_dest),
+		       dest_rec->match_num_co);
+	}
+	m_MMGR_FREE_EDSV_DELIVER_SUBSCS(subscs);
+	return NCSCC_RC_SUCCESS;
+}
+
 /****************************************************************************
  * Name          : eds_proc_publish_msg
  *
@@ -524,9 +637,9 @@ static uint32_t eds_proc_publish_msg(EDS_CB *cb, EDSV_EDS_EVT *evt)
 	SaTimeT publish_time = 0; /* placeholder for now */
 	MDS_SEND_PRIORITY_TYPE prio;
 	EDS_WORKLIST *wp;
+	uint32_t send_rc;
 	CHAN_OPEN_REC *co;
-	SUBSC_REC *subrec;
-	EDSV_MSG msg;
+	EDA_DEST_REC *dest_rec;
 	time_t time_of_day;
 	EDSV_EDA_PUBLISH_PARAM *publish_param;
 	uint32_t retd_evt_chan_open_id = 0;
@@ -577,54 +690,44 @@ static uint32_t eds_proc_publish_msg(EDS_CB *cb, EDSV_EDS_EVT *evt)
 	 ** this event now
 	 **/
 
-	/* Go through all chan_open_rec's under this channel */
-	co = (CHAN_OPEN_REC *)ncs_patricia_tree_getnext(&wp->chan_open_rec,
-							(uint8_t *)0);
-	while (co) {
-		subrec = co->subsc_rec_head;
-		while (subrec) { /* while subscriptions... */
-			/* Does the patterns/filters match? */
-			if (eds_pattern_match(publish_param->pattern_array,
-					      subrec->filters)) {
-
-				/* Fill in the event record to send */
-				m_EDS_EDSV_DELIVER_EVENT_CB_MSG_FILL(
-				    msg, co->reg_id, subrec->subscript_id,
-				    subrec->chan_id, subrec->chan_open_id,
-				    publish_param->pattern_array,
-				    publish_param->priority,
-				    publish_param->publisher_name, publish_time,
-				    publish_param->retention_time,
-				    publish_param->event_id,
-				    retd_evt_chan_open_id,
-				    publish_param->data_len,
-				    publish_param->data)
-
-				    /* Determine evt to MDS priority mapping */
-				    prio = edsv_map_ais_prio_to_mds_snd_prio(
-					publish_param->priority);
-
-				/* Send the event. Only once per match/per
-				 * open_id */
-				if (NCSCC_RC_SUCCESS !=
-				    (rc = eds_mds_msg_send(
-					 cb, &msg, &co->chan_opener_dest, NULL,
-					 prio))) {
-					LOG_ER(
-					    "Event Publish(MDS send) failed. From publisher dest: %" PRIx64
-					    ", To subscriber dest: %" PRIx64
-					    ",on Node_id: %u",
-					    evt->fr_dest, co->chan_opener_dest,
-					    m_NCS_NODE_ID_FROM_MDS_DEST(
-						co->chan_opener_dest));
-				}
+	/* Get the chan_open_rec's under this channel with a matching
+	 * subscription from the subscription index */
+	co = eds_subsc_index_match(&wp->subsc_index,
+				   publish_param->pattern_array);
 
-				break;
-			}
-			subrec = subrec->next;
+	/* Determine evt to MDS priority mapping */
+	prio = edsv_map_ais_prio_to_mds_snd_prio(publish_param->priority);
+
+	/* Group them by agent, each agent is looked up once per match */
+	dest_rec = eds_group_by_eda_dest(cb, co, &co);
+
+	/* Agents without a destination record get one event per match */
+	for (; co; co = co->match_next) {
+		if (NCSCC_RC_SUCCESS !=
+		    (send_rc = eds_deliver_event(cb, evt, co, publish_time,
+						 retd_evt_chan_open_id, prio)))
+			rc = send_rc;
+	}
+
+	for (; dest_rec; dest_rec = dest_rec->match_next) {
+		/* An agent that supports it gets the event once for all its
+		 * matching subscriptions */
+		if (eds_eda_dest_batched(dest_rec) &&
+		    (eds_deliver_event_batch(cb, evt, dest_rec, publish_time,
+					     retd_evt_chan_open_id, prio,
+					     &send_rc) == NCSCC_RC_SUCCESS)) {
+			if (send_rc != NCSCC_RC_SUCCESS)
+				rc = send_rc;
+			continue;
+		}
+
+		for (co = dest_rec->match_head; co; co = co->match_next) {
+			if (NCSCC_RC_SUCCESS !=
+			    (send_rc = eds_deliver_event(cb, evt, co, publish_time,
+							 retd_evt_chan_open_id,
+							 prio)))
+				rc = send_rc;
 		}
-		co = (CHAN_OPEN_REC *)ncs_patricia_tree_getnext(
-		    &wp->chan_open_rec, (uint8_t *)&co->copen_id_Net);
 	}
 
 	/** If this event has been retained, send an async update &
@@ -1078,9 +1181,14 @@ static uint32_t eds_proc_eda_updn_mds_msg(EDSV_EDS_EVT *evt)
 	switch (evt->evt_type) {
 	case EDSV_EDS_EVT_EDA_UP:
 		TRACE("Agent UP");
+		/* Remember the version of the agent in all HA states so that
+		 * it is known after a failover */
+		eds_add_eda_dest_rec(cb, evt->fr_dest,
+				     evt->info.mds_info.svc_pvt_ver);
 		break;
 	case EDSV_EDS_EVT_EDA_DOWN:
 		TRACE("Agent DOWN");
+		eds_remove_eda_dest_rec(cb, evt->fr_dest);
 		if ((cb->ha_state == SA_AMF_HA_ACTIVE) ||
 		    (cb->ha_state == SA_AMF_HA_QUIESCED)) {
 			/* Remove this EDA entry from our processing lists */
@@ -1296,6 +1404,7 @@ uint32_t eds_process_evt(EDSV_EDS_EVT *evt)
 			TRACE("Event processing failed");
 	} else {
 		if ((evt->evt_type == EDSV_EDS_RET_TIMER_EXP) ||
+		    (evt->evt_type == EDSV_EDS_EVT_EDA_UP) ||
 		    (evt->evt_type == EDSV_EDS_EVT_EDA_DOWN))
 			/** Invoke the evt dispatcher **/
 			eds_edsv_top_level_evt_dispatch_tbl[evt->evt_type](evt);
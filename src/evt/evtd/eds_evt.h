@@ -43,6 +43,7 @@ typedef enum edsv_eds_evt_type {
 typedef struct edsv_eds_mds_info_tag {
   uint32_t node_id;
   MDS_DEST mds_dest_id;
+  MDS_SVC_PVT_SUB_PART_VER svc_pvt_ver; /* EDA up only */
 } EDSV_EDS_MDS_INFO;
 
 typedef struct edsv_eds_evt_tag {
@@ -228,6 +228,8 @@ static void eds_remove_subrec_entry(EDS_CB *cb, SUBSC_REC **subrec)
 	TRACE("chan_id: %u, chan_open_id: %u, subscription id: %u", p->chan_id,
 	      p->chan_open_id, p->subscript_id);
 
+	eds_subsc_index_remove(p);
+
 	if (p->prev == NULL) {		      /* Top entry */
 		if (p->next != NULL) {	/* It's not the only element */
 			p->next->prev = NULL; /* Clear prev pointer */
@@ -317,6 +319,14 @@ static uint32_t eds_add_subscription_to_worklist(EDS_CB *cb, SUBSC_REC *subrec)
 			 * root entry later */
 			subrec->par_chan_open_inst = co;
 
+			/* Add the filters to the index used for publish */
+			rs = eds_subsc_index_add(&wp->subsc_index, subrec);
+			if (rs != NCSCC_RC_SUCCESS) {
+				LOG_CR("malloc failed for subscription index");
+				TRACE_LEAVE();
+				return (rs);
+			}
+
 			/* Add it! */
 			rs = eds_add_subrec_entry(co, subrec);
 			TRACE_LEAVE();
@@ -483,6 +493,7 @@ uint32_t eds_remove_worklist_entry(EDS_CB *cb, uint32_t chan_id)
 				/* Destroy the patricia tree for channel open
 				 * recs */
 				ncs_patricia_tree_destroy(&wp->chan_open_rec);
+				eds_subsc_index_destroy(&wp->subsc_index);
 				m_NCS_UNLOCK(&cb->cb_lock, NCS_LOCK_WRITE);
 				m_MMGR_FREE_EDS_CHAN_NAME(
 				    wp->cname); /* free channelName */
@@ -506,6 +517,7 @@ uint32_t eds_remove_worklist_entry(EDS_CB *cb, uint32_t chan_id)
 				/* Destroy the patricia tree for channel open
 				 * recs */
 				ncs_patricia_tree_destroy(&wp->chan_open_rec);
+				eds_subsc_index_destroy(&wp->subsc_index);
 				m_NCS_UNLOCK(&cb->cb_lock, NCS_LOCK_WRITE);
 				m_MMGR_FREE_EDS_CHAN_NAME(wp->cname);
 				m_MMGR_FREE_EDS_WORKLIST(
@@ -530,6 +542,7 @@ uint32_t eds_remove_worklist_entry(EDS_CB *cb, uint32_t chan_id)
 				/* Destroy the patricia tree for channel open
 				 * recs */
 				ncs_patricia_tree_destroy(&wp->chan_open_rec);
+				eds_subsc_index_destroy(&wp->subsc_index);
 				m_NCS_UNLOCK(&cb->cb_lock, NCS_LOCK_WRITE);
 				m_MMGR_FREE_EDS_CHAN_NAME(wp->cname);
 				m_MMGR_FREE_EDS_WORKLIST(
@@ -945,6 +958,7 @@ static void eds_del_work_list(EDS_CB *cb, EDS_WORKLIST **p_work_list)
 		** erased
 		**/
 		ncs_patricia_tree_destroy(&work_list->chan_open_rec);
+		eds_subsc_index_destroy(&work_list->subsc_index);
 
 		/* free channelName */
 		m_MMGR_FREE_EDS_CHAN_NAME(work_list->cname);
@@ -1156,6 +1170,92 @@ uint32_t eds_remove_eda_down_rec(EDS_CB *cb, MDS_DEST mds_dest)
 	return NCSCC_RC_SUCCESS;
 }
 
+/****************************************************************************
+ *
+ * eds_add_eda_dest_rec
+ *
+ *  Records the MDS subpart version of the agent at the passed MDS_DEST, as
+ *  given in its MDS up event. Events to the agent are only batched when it
+ *  supports it, see eds_eda_dest_version().
+ *
+ ****************************************************************************/
+uint32_t eds_add_eda_dest_rec(EDS_CB *cb, MDS_DEST mds_dest,
+			      MDS_SVC_PVT_SUB_PART_VER svc_pvt_ver)
+{
+	EDA_DEST_REC *dest_rec;
+	TRACE_ENTER2("mds_dest: %" PRIx64 ", version: %u", mds_dest,
+		     svc_pvt_ver);
+
+	dest_rec = (EDA_DEST_REC *)ncs_patricia_tree_get(&cb->eda_dest_list,
+							 (uint8_t *)&mds_dest);
+	if (dest_rec) {
+		dest_rec->svc_pvt_ver = svc_pvt_ver;
+		TRACE_LEAVE();
+		return NCSCC_RC_SUCCESS;
+	}
+
+	dest_rec = m_MMGR_ALLOC_EDA_DEST_REC(sizeof(EDA_DEST_REC));
+	if (dest_rec == NULL) {
+		LOG_ER("malloc failed for agent destination record");
+		TRACE_LEAVE();
+		return NCSCC_RC_FAILURE;
+	}
+	memset(dest_rec, 0, sizeof(EDA_DEST_REC));
+	dest_rec->mds_dest = mds_dest;
+	dest_rec->svc_pvt_ver = svc_pvt_ver;
+	dest_rec->pat_node.key_info = (uint8_t *)&dest_rec->mds_dest;
+	if (ncs_patricia_tree_add(&cb->eda_dest_list, &dest_rec->pat_node) !=
+	    NCSCC_RC_SUCCESS) {
+		LOG_ER("Patricia add failed for agent destination record");
+		m_MMGR_FREE_EDA_DEST_REC(dest_rec);
+		TRACE_LEAVE();
+		return NCSCC_RC_FAILURE;
+	}
+
+	TRACE_LEAVE();
+	return NCSCC_RC_SUCCESS;
+}
+
+/****************************************************************************
+ *
+ * eds_remove_eda_dest_rec
+ *
+ *  Removes the record of the agent at the passed MDS_DEST, if any.
+ *
+ ****************************************************************************/
+void eds_remove_eda_dest_rec(EDS_CB *cb, MDS_DEST mds_dest)
+{
+	EDA_DEST_REC *dest_rec;
+
+	dest_rec = (EDA_DEST_REC *)ncs_patricia_tree_get(&cb->eda_dest_list,
+							 (uint8_t *)&mds_dest);
+	if (dest_rec == NULL)
+		return;
+
+	ncs_patricia_tree_del(&cb->eda_dest_list, &dest_rec->pat_node);
+	m_MMGR_FREE_EDA_DEST_REC(dest_rec);
+}
+
+/****************************************************************************
+ *
+ * eds_eda_dest_version
+ *
+ *  Returns the MDS subpart version of the agent at the passed MDS_DEST, 0 if
+ *  no up event has been seen for it.
+ *
+ ****************************************************************************/
+MDS_SVC_PVT_SUB_PART_VER eds_eda_dest_version(EDS_CB *cb, MDS_DEST mds_dest)
+{
+	EDA_DEST_REC *dest_rec;
+
+	dest_rec = (EDA_DEST_REC *)ncs_patricia_tree_get(&cb->eda_dest_list,
+							 (uint8_t *)&mds_dest);
+	if (dest_rec == NULL)
+		return 0;
+
+	return dest_rec->svc_pvt_ver;
+}
+
 /****************************************************************************
  *
  * eds_remove_regid_by_mds_dest
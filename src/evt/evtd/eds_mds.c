@@ -21,9 +21,13 @@
 
 MDS_CLIENT_MSG_FORMAT_VER
 EDS_WRT_EDA_MSG_FMT_ARRAY[EDS_WRT_EDA_SUBPART_VER_RANGE] = {
-    1 /*msg format version for EDA subpart version 1 */
+    1, /*msg format version for EDA subpart version 1 */
+    2  /*msg format version for EDA subpart version 2 */
 };
 
+static uint32_t eds_enc_delv_evt_body(NCS_UBAID *uba,
+				      EDSV_EDA_EVT_DELIVER_CBK_PARAM *param);
+
 /****************************************************************************
   Name          : eds_dec_initialize_msg
 
@@ -825,9 +829,7 @@ static uint32_t eds_enc_chan_open_cbk_msg(NCS_UBAID *uba, EDSV_MSG *msg)
 static uint32_t eds_enc_delv_evt_cbk_msg(NCS_UBAID *uba, EDSV_MSG *msg)
 {
 	uint8_t *p8;
-	uint32_t x;
 	uint32_t total_bytes = 0;
-	SaEvtEventPatternT *pattern_ptr;
 	EDSV_EDA_EVT_DELIVER_CBK_PARAM *param =
 	    &msg->info.cbk_info.param.evt_deliver_cbk;
 
@@ -847,6 +849,87 @@ static uint32_t eds_enc_delv_evt_cbk_msg(NCS_UBAID *uba, EDSV_MSG *msg)
 	ncs_enc_claim_space(uba, 12);
 	total_bytes += 12;
 
+	total_bytes += eds_enc_delv_evt_body(uba, param);
+
+	return total_bytes;
+}
+
+/****************************************************************************
+  Name          : eds_enc_delv_evt_batch_cbk_msg
+
+  Description   : This routine encodes an event callback msg for a batch of
+		  subscriptions of the same agent. The subscriptions are
+		  followed by the event, which is encoded once.
+
+  Arguments     : NCS_UBAID *msg,
+		  EDSV_MSG *msg
+
+  Return Values : uns32
+
+  Notes         : Message format version 2 and later only.
+******************************************************************************/
+static uint32_t eds_enc_delv_evt_batch_cbk_msg(NCS_UBAID *uba, EDSV_MSG *msg)
+{
+	uint8_t *p8;
+	uint32_t x;
+	uint32_t total_bytes = 0;
+	EDSV_EDA_EVT_DELIVER_CBK_PARAM *param =
+	    &msg->info.cbk_info.param.evt_deliver_cbk;
+
+	if (uba == NULL) {
+		TRACE_4("uba is NULL");
+		return 0;
+	}
+
+	/* num_subscs */
+	p8 = ncs_enc_reserve_space(uba, 4);
+	if (!p8) {
+		LOG_WA("encode reserve space failed");
+	}
+	ncs_encode_32bit(&p8, param->num_subscs);
+	ncs_enc_claim_space(uba, 4);
+	total_bytes += 4;
+
+	/* reg_id, sub_id, chan_id, chan_open_id of each subscription */
+	for (x = 0; x < param->num_subscs; x++) {
+		p8 = ncs_enc_reserve_space(uba, 16);
+		if (!p8) {
+			LOG_WA("encode reserve space failed");
+		}
+		ncs_encode_32bit(&p8, param->subscs[x].reg_id);
+		ncs_encode_32bit(&p8, param->subscs[x].sub_id);
+		ncs_encode_32bit(&p8, param->subscs[x].chan_id);
+		ncs_encode_32bit(&p8, param->subscs[x].chan_open_id);
+		ncs_enc_claim_space(uba, 16);
+		total_bytes += 16;
+	}
+
+	total_bytes += eds_enc_delv_evt_body(uba, param);
+
+	return total_bytes;
+}
+
+/****************************************************************************
+  Name          : eds_enc_delv_evt_body
+
+  Description   : This routine encodes the event of an event callback msg,
+		  everything from the patterns on.
+
+  Arguments     : NCS_UBAID *msg,
+		  EDSV_EDA_EVT_DELIVER_CBK_PARAM *param
+
+  Return Values : uns32
+
+  Notes         : None.
+******************************************************************************/
+static uint32_t eds_enc_delv_evt_body(NCS_UBAID *uba,
+				      EDSV_EDA_EVT_DELIVER_CBK_PARAM *param)
+{
+	uint8_t *p8;
+	uint32_t x;
+	uint32_t total_bytes = 0;
+	SaEvtEventPatternT *pattern_ptr;
+
 	/* Encode the patterns */
 
 	/* patternsNumber */
@@ -1095,6 +1178,16 @@ static uint32_t eds_mds_enc(struct ncsmds_callback_info *info)
 		case EDSV_EDS_CLMNODE_STATUS:
 			total_bytes += eds_enc_clm_status_cbk_msg(uba, msg);
 			break;
+		case EDSV_EDS_DELIVER_EVENT_BATCH:
+			if (msg_fmt_version < 2) {
+				LOG_ER("MDS encode: Batched delivery to "
+				       "message format version %hu",
+				       msg_fmt_version);
+				return NCSCC_RC_FAILURE;
+			}
+			total_bytes +=
+			    eds_enc_delv_evt_batch_cbk_msg(uba, msg);
+			break;
 		default:
 			LOG_WA(
 			    "MDS encode: Invalid callback message response type: %u",
@@ -1375,7 +1468,8 @@ static uint32_t eds_mds_svc_event(struct ncsmds_callback_info *info)
 
 	/* If this evt was sent from EDA act on this */
 	if (info->info.svc_evt.i_svc_id == NCSMDS_SVC_ID_EDA) {
-		if (info->info.svc_evt.i_change == NCSMDS_DOWN) {
+		if ((info->info.svc_evt.i_change == NCSMDS_DOWN) ||
+		    (info->info.svc_evt.i_change == NCSMDS_UP)) {
 			/* As of now we are only interested in EDA events */
 			if (NULL == (evt = m_MMGR_ALLOC_EDSV_EDS_EVT)) {
 				LOG_CR("malloc failed for EDS event");
@@ -1383,7 +1477,10 @@ static uint32_t eds_mds_svc_event(struct ncsmds_callback_info *info)
 			}
 
 			memset(evt, '\0', sizeof(EDSV_EDS_EVT));
-			evt->evt_type = EDSV_EDS_EVT_EDA_DOWN;
+			if (info->info.svc_evt.i_change == NCSMDS_UP)
+				evt->evt_type = EDSV_EDS_EVT_EDA_UP;
+			else
+				evt->evt_type = EDSV_EDS_EVT_EDA_DOWN;
 
 			/** Initialize the Event Header **/
 			evt->cb_hdl = eds_cb_hdl;
@@ -1395,13 +1492,18 @@ static uint32_t eds_mds_svc_event(struct ncsmds_callback_info *info)
 			    info->info.svc_evt.i_node_id;
 			evt->info.mds_info.mds_dest_id =
 			    info->info.svc_evt.i_dest;
+			evt->info.mds_info.svc_pvt_ver =
+			    info->info.svc_evt.i_rem_svc_pvt_ver;
 
 			/* Push the event and we are done */
 			if (m_NCS_IPC_SEND(&eds_cb->mbx, evt,
 					   NCS_IPC_PRIORITY_NORMAL) ==
 			    NCSCC_RC_FAILURE) {
 				LOG_WA(
-				    "Mailbox IPC send failed for eda_down event, from node_id: %u",
+				    "Mailbox IPC send failed for eda_%s event, from node_id: %u",
+				    (evt->evt_type == EDSV_EDS_EVT_EDA_UP)
+					? "up"
+					: "down",
 				    evt->info.mds_info.node_id);
 				eds_evt_destroy(evt);
 				goto give_hdl;
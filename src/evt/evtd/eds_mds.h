@@ -32,12 +32,14 @@
 #ifndef EVT_EVTD_EDS_MDS_H_
 #define EVT_EVTD_EDS_MDS_H_
 
-#define EDS_SVC_PVT_SUBPART_VERSION 1
+#define EDS_SVC_PVT_SUBPART_VERSION 2
 #define EDS_WRT_EDA_SUBPART_VER_AT_MIN_MSG_FMT 1
-#define EDS_WRT_EDA_SUBPART_VER_AT_MAX_MSG_FMT 1
+#define EDS_WRT_EDA_SUBPART_VER_AT_MAX_MSG_FMT 2
 #define EDS_WRT_EDA_SUBPART_VER_RANGE       \
   (EDS_WRT_EDA_SUBPART_VER_AT_MAX_MSG_FMT - \
    EDS_WRT_EDA_SUBPART_VER_AT_MIN_MSG_FMT + 1)
+/* Lowest EDA subpart version that takes EDSV_EDS_DELIVER_EVENT_BATCH */
+#define EDS_WRT_EDA_SUBPART_VER_DELIVER_BATCH 2
 
 uint32_t eds_mds_init(EDS_CB *);
 uint32_t eds_mds_vdest_create(EDS_CB *);
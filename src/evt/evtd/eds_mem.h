@@ -48,6 +48,8 @@ typedef enum {
   NCS_SERVICE_EDS_CNAME_REC,
   NCS_SERVICE_EDA_DOWN_LIST,
   NCS_SERVICE_EDS_CLUSTER_NODE_LIST,
+  NCS_SERVICE_EDS_SUBSC_INDEX,
+  NCS_SERVICE_EDA_DEST_REC,
 } NCS_SERVICE_EDS_SUBID;
 
 /****************************************
@@ -162,4 +164,20 @@ typedef enum {
   m_NCS_MEM_FREE(p, NCS_MEM_REGION_PERSISTENT, NCS_SERVICE_ID_EDS, \
                  NCS_SERVICE_EDS_CLUSTER_NODE_LIST)
 
+#define m_MMGR_ALLOC_EDS_SUBSC_INDEX(size)                             \
+  m_NCS_MEM_ALLOC(size, NCS_MEM_REGION_PERSISTENT, NCS_SERVICE_ID_EDS, \
+                  NCS_SERVICE_EDS_SUBSC_INDEX)
+
+#define m_MMGR_FREE_EDS_SUBSC_INDEX(p)                             \
+  m_NCS_MEM_FREE(p, NCS_MEM_REGION_PERSISTENT, NCS_SERVICE_ID_EDS, \
+                 NCS_SERVICE_EDS_SUBSC_INDEX)
+
+#define m_MMGR_ALLOC_EDA_DEST_REC(size)                                \
+  m_NCS_MEM_ALLOC(size, NCS_MEM_REGION_PERSISTENT, NCS_SERVICE_ID_EDS, \
+                  NCS_SERVICE_EDA_DEST_REC)
+
+#define m_MMGR_FREE_EDA_DEST_REC(p)                                \
+  m_NCS_MEM_FREE(p, NCS_MEM_REGION_PERSISTENT, NCS_SERVICE_ID_EDS, \
+                 NCS_SERVICE_EDA_DEST_REC)
+
 #endif  // EVT_EVTD_EDS_MEM_H_
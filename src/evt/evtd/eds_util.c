@@ -61,6 +61,12 @@ bool eds_pattern_match(SaEvtEventPatternArrayT *patternArray,
 			if ((pattern->patternSize == 0) &&
 			    (filter->filter.patternSize != 0))
 				return (false);
+
+			/* Pattern must be at least as long as filter for a
+			 * match */
+			if (pattern->patternSize < filter->filter.patternSize)
+				return (false);
+
 			if (memcmp(filter->filter.pattern, pattern->pattern,
 				   (size_t)filter->filter.patternSize) != 0)
 				return (false); /* No match */
@@ -171,3 +177,489 @@ uint32_t eds_calc_filter_size(SaEvtEventFilterArrayT *filterArray)
 
 	return (size);
 }
+
+/***************************************************************************
+ *
+ * Subscription filter index
+ *
+ * eds_pattern_match() compares the patterns of an event with the filters of
+ * one subscription, so matching an event by comparing it with every
+ * subscription of the channel grows linearly with the number of
+ * subscriptions. The index of a channel (EDS_SUBSC_INDEX) instead holds the
+ * filters of all the subscriptions of the channel in tries, one prefix trie
+ * and one suffix trie per filter position, see eds_cb.h.
+ *
+ * To match an event, the pattern of each position is walked down the tries of
+ * the position. The filters listed at the nodes on the way match the pattern,
+ * and each match counts one for the subscription of the filter. A
+ * subscription matches when all its filters have matched, i.e. when the count
+ * reaches the number of its filters in the index. Pass all filters always
+ * match and are left out of the index, a subscription with only pass all
+ * filters is put in a list of its own instead. The cost of a match is thus
+ * given by the sizes of the patterns and the number of matching filters.
+ *
+ ***************************************************************************/
+
+/***************************************************************************
+ *
+ * eds_filter_node_child() - Get the child of a trie node for a byte.
+ *
+ * Returns the child, or NULL if there is none and create is false or the
+ * allocation failed.
+ *
+ ***************************************************************************/
+static EDS_FILTER_NODE *eds_filter_node_child(EDS_FILTER_NODE *node,
+					      uint8_t byte, bool create)
+{
+	EDS_FILTER_NODE *child;
+
+	for (child = node->child; child != NULL; child = child->sibling) {
+		if (child->byte == byte)
+			return (child);
+	}
+	if (!create)
+		return (NULL);
+
+	child = m_MMGR_ALLOC_EDS_SUBSC_INDEX(sizeof(EDS_FILTER_NODE));
+	if (child == NULL)
+		return (NULL);
+	memset(child, 0, sizeof(EDS_FILTER_NODE));
+	child->byte = byte;
+	child->parent = node;
+	child->sibling = node->child;
+	node->child = child;
+	return (child);
+}
+
+/***************************************************************************
+ *
+ * eds_filter_node_prune() - Free the trie nodes that are no longer used,
+ *                           starting with node and going up to the root.
+ *
+ ***************************************************************************/
+static void eds_filter_node_prune(EDS_FILTER_NODE *node)
+{
+	EDS_FILTER_NODE *parent;
+	EDS_FILTER_NODE **p;
+
+	while ((parent = node->parent) != NULL && node->child == NULL &&
+	       node->affix_ref_head == NULL && node->exact_ref_head == NULL) {
+		for (p = &parent->child; *p != node; p = &(*p)->sibling)
+			;
+		*p = node->sibling;
+		m_MMGR_FREE_EDS_SUBSC_INDEX(node);
+		node = parent;
+	}
+}
+
+/***************************************************************************
+ *
+ * eds_filter_node_free() - Free the descendants of a trie node.
+ *
+ ***************************************************************************/
+static void eds_filter_node_free(EDS_FILTER_NODE *node)
+{
+	EDS_FILTER_NODE *child;
+
+	while ((child = node->child) != NULL) {
+		node->child = child->sibling;
+		eds_filter_node_free(child);
+		m_MMGR_FREE_EDS_SUBSC_INDEX(child);
+	}
+}
+
+static void eds_filter_ref_link(EDS_FILTER_REF *ref, EDS_FILTER_REF **head)
+{
+	ref->head = head;
+	ref->prev = NULL;
+	ref->next = *head;
+	if (*head != NULL)
+		(*head)->prev = ref;
+	*head = ref;
+}
+
+static void eds_filter_ref_unlink(EDS_FILTER_REF *ref)
+{
+	if (ref->prev != NULL)
+		ref->prev->next = ref->next;
+	else
+		*ref->head = ref->next;
+	if (ref->next != NULL)
+		ref->next->prev = ref->prev;
+}
+
+/***************************************************************************
+ *
+ * eds_subsc_index_pos() - Get the tries of a filter position, adding
+ *                         positions as needed.
+ *
+ ***************************************************************************/
+static EDS_FILTER_POS *eds_subsc_index_pos(EDS_SUBSC_INDEX *index,
+					   uint32_t pos)
+{
+	EDS_FILTER_POS **new_pos;
+	uint32_t x;
+
+	if (pos < index->num_pos)
+		return (index->pos[pos]);
+
+	new_pos = m_MMGR_ALLOC_EDS_SUBSC_INDEX((pos + 1) *
+					       sizeof(EDS_FILTER_POS *));
+	if (new_pos == NULL)
+		return (NULL);
+	if (index->num_pos != 0)
+		memcpy(new_pos, index->pos,
+		       index->num_pos * sizeof(EDS_FILTER_POS *));
+	for (x = index->num_pos; x <= pos; x++) {
+		new_pos[x] = m_MMGR_ALLOC_EDS_SUBSC_INDEX(
+		    sizeof(EDS_FILTER_POS));
+		if (new_pos[x] == NULL)
+			break;
+		memset(new_pos[x], 0, sizeof(EDS_FILTER_POS));
+	}
+	if (index->pos != NULL)
+		m_MMGR_FREE_EDS_SUBSC_INDEX(index->pos);
+	index->pos = new_pos;
+	index->num_pos = x;
+	return (x > pos ? index->pos[pos] : NULL);
+}
+
+/***************************************************************************
+ *
+ * eds_subsc_index_add() - Add the filters of a subscription to the index of
+ *                         its channel.
+ *
+ * A subscription without a filter array or with a filter of an unknown type
+ * never matches, as for eds_pattern_match(), and is not added.
+ *
+ * Returns NCSCC_RC_OUT_OF_MEM if an allocation fails, the index is then left
+ * unchanged.
+ *
+ ***************************************************************************/
+uint32_t eds_subsc_index_add(EDS_SUBSC_INDEX *index, SUBSC_REC *subrec)
+{
+	SaEvtEventFilterArrayT *filterArray = subrec->filters;
+	SaEvtEventFilterT *filter;
+	EDS_FILTER_POS *pos;
+	EDS_FILTER_NODE *node = NULL;
+	EDS_FILTER_NODE *child;
+	EDS_FILTER_REF *ref;
+	uint32_t num_refs = 0;
+	uint32_t x;
+	SaSizeT y;
+
+	subrec->filter_refs = NULL;
+	subrec->num_filter_refs = 0;
+	if (filterArray == NULL)
+		return (NCSCC_RC_SUCCESS);
+
+	for (x = 0; x < filterArray->filtersNumber; x++) {
+		switch (filterArray->filters[x].filterType) {
+		case SA_EVT_PREFIX_FILTER:
+		case SA_EVT_SUFFIX_FILTER:
+		case SA_EVT_EXACT_FILTER:
+			num_refs++;
+			break;
+		case SA_EVT_PASS_ALL_FILTER:
+			break;
+		default:
+			return (NCSCC_RC_SUCCESS);
+		}
+	}
+
+	if (num_refs == 0) {
+		/* Only pass all filters */
+		ref = m_MMGR_ALLOC_EDS_SUBSC_INDEX(sizeof(EDS_FILTER_REF));
+		if (ref == NULL)
+			return (NCSCC_RC_OUT_OF_MEM);
+		memset(ref, 0, sizeof(EDS_FILTER_REF));
+		ref->subrec = subrec;
+		eds_filter_ref_link(ref, &index->pass_all_head);
+		subrec->filter_refs = ref;
+		subrec->num_filter_refs = 1;
+		return (NCSCC_RC_SUCCESS);
+	}
+
+	subrec->filter_refs =
+	    m_MMGR_ALLOC_EDS_SUBSC_INDEX(num_refs * sizeof(EDS_FILTER_REF));
+	if (subrec->filter_refs == NULL)
+		return (NCSCC_RC_OUT_OF_MEM);
+	memset(subrec->filter_refs, 0, num_refs * sizeof(EDS_FILTER_REF));
+
+	for (x = 0; x < filterArray->filtersNumber; x++) {
+		filter = &filterArray->filters[x];
+		if (filter->filterType == SA_EVT_PASS_ALL_FILTER)
+			continue;
+
+		pos = eds_subsc_index_pos(index, x);
+		if (pos == NULL)
+			goto out_of_mem;
+
+		if (filter->filterType == SA_EVT_SUFFIX_FILTER) {
+			node = &pos->suffix_root;
+			for (y = filter->filter.patternSize; y > 0; y--) {
+				child = eds_filter_node_child(
+				    node, filter->filter.pattern[y - 1], true);
+				if (child == NULL)
+					goto out_of_mem;
+				node = child;
+			}
+		} else {
+			node = &pos->prefix_root;
+			for (y = 0; y < filter->filter.patternSize; y++) {
+				child = eds_filter_node_child(
+				    node, filter->filter.pattern[y], true);
+				if (child == NULL)
+					goto out_of_mem;
+				node = child;
+			}
+		}
+
+		ref = &subrec->filter_refs[subrec->num_filter_refs++];
+		ref->subrec = subrec;
+		ref->node = node;
+		eds_filter_ref_link(ref,
+				    filter->filterType == SA_EVT_EXACT_FILTER
+					? &node->exact_ref_head
+					: &node->affix_ref_head);
+	}
+	return (NCSCC_RC_SUCCESS);
+
+out_of_mem:
+	/* The nodes created for this subscription only are freed as well */
+	if (node != NULL)
+		eds_filter_node_prune(node);
+	eds_subsc_index_remove(subrec);
+	return (NCSCC_RC_OUT_OF_MEM);
+}
+
+/***************************************************************************
+ *
+ * eds_subsc_index_remove() - Remove the filters of a subscription from the
+ *                            index of its channel.
+ *
+ ***************************************************************************/
+void eds_subsc_index_remove(SUBSC_REC *subrec)
+{
+	EDS_FILTER_REF *ref;
+	uint32_t x;
+
+	for (x = 0; x < subrec->num_filter_refs; x++) {
+		ref = &subrec->filter_refs[x];
+		eds_filter_ref_unlink(ref);
+		if (ref->node != NULL)
+			eds_filter_node_prune(ref->node);
+	}
+	if (subrec->filter_refs != NULL)
+		m_MMGR_FREE_EDS_SUBSC_INDEX(subrec->filter_refs);
+	subrec->filter_refs = NULL;
+	subrec->num_filter_refs = 0;
+}
+
+/***************************************************************************
+ *
+ * eds_subsc_index_destroy() - Free the index of a channel. The
+ *                             subscriptions must have been removed.
+ *
+ ***************************************************************************/
+void eds_subsc_index_destroy(EDS_SUBSC_INDEX *index)
+{
+	uint32_t x;
+
+	for (x = 0; x < index->num_pos; x++) {
+		eds_filter_node_free(&index->pos[x]->prefix_root);
+		eds_filter_node_free(&index->pos[x]->suffix_root);
+		m_MMGR_FREE_EDS_SUBSC_INDEX(index->pos[x]);
+	}
+	if (index->pos != NULL)
+		m_MMGR_FREE_EDS_SUBSC_INDEX(index->pos);
+	memset(index, 0, sizeof(EDS_SUBSC_INDEX));
+}
+
+/***************************************************************************
+ *
+ * eds_subsc_index_hit() - Count a matching filter of a subscription, and
+ *                         put the subscription on the match list when all
+ *                         its filters have matched.
+ *
+ ***************************************************************************/
+static void eds_subsc_index_hit(EDS_SUBSC_INDEX *index, EDS_FILTER_REF *ref,
+				SUBSC_REC **match_list)
+{
+	SUBSC_REC *subrec;
+
+	for (; ref != NULL; ref = ref->next) {
+		subrec = ref->subrec;
+		if (subrec->match_gen != index->match_gen) {
+			subrec->match_gen = index->match_gen;
+			subrec->match_cnt = 0;
+		}
+		if (++subrec->match_cnt == subrec->num_filter_refs) {
+			subrec->match_next = *match_list;
+			*match_list = subrec;
+		}
+	}
+}
+
+static bool eds_subsc_matched(EDS_SUBSC_INDEX *index, SUBSC_REC *subrec)
+{
+	return (subrec->match_gen == index->match_gen &&
+		subrec->match_cnt == subrec->num_filter_refs);
+}
+
+/***************************************************************************
+ *
+ * eds_subsc_index_match() - Match the patterns of an event with the
+ *                           subscriptions of a channel.
+ *
+ * The result is the same as calling eds_pattern_match() for each
+ * subscription. The event is delivered once per channel open, to the first
+ * matching subscription in the subscription list of the channel open.
+ *
+ * Returns the list of the channel opens to deliver to, linked by match_next,
+ * with the subscription to deliver to in match_subrec.
+ *
+ ***************************************************************************/
+CHAN_OPEN_REC *eds_subsc_index_match(EDS_SUBSC_INDEX *index,
+				     SaEvtEventPatternArrayT *patternArray)
+{
+	SaEvtEventPatternT emptyPattern = {0, 0, NULL};
+	SaEvtEventPatternT *pattern;
+	SUBSC_REC *match_list = NULL;
+	SUBSC_REC *subrec;
+	CHAN_OPEN_REC *co_list = NULL;
+	CHAN_OPEN_REC *co;
+	EDS_FILTER_NODE *node;
+	uint32_t x;
+	SaSizeT y;
+
+	if (patternArray == NULL)
+		return (NULL);
+
+	index->match_gen++;
+	eds_subsc_index_hit(index, index->pass_all_head, &match_list);
+
+	for (x = 0; x < index->num_pos; x++) {
+		/* The patterns are paired with the filters as in
+		 * eds_pattern_match(), missing patterns are empty */
+		if (patternArray->patterns != NULL &&
+		    (x == 0 || x < patternArray->patternsNumber))
+			pattern = &patternArray->patterns[x];
+		else
+			pattern = &emptyPattern;
+
+		/* Prefix filters match at each node on the way, exact
+		 * filters at the node of the whole pattern */
+		node = &index->pos[x]->prefix_root;
+		eds_subsc_index_hit(index, node->affix_ref_head, &match_list);
+		for (y = 0; y < pattern->patternSize && node; y++) {
+			node = eds_filter_node_child(node, pattern->pattern[y],
+						     false);
+			if (node != NULL)
+				eds_subsc_index_hit(index, node->affix_ref_head,
+						    &match_list);
+		}
+		if (node != NULL)
+			eds_subsc_index_hit(index, node->exact_ref_head,
+					    &match_list);
+
+		node = &index->pos[x]->suffix_root;
+		eds_subsc_index_hit(index, node->affix_ref_head, &match_list);
+		for (y = pattern->patternSize; y > 0 && node; y--) {
+			node = eds_filter_node_child(
+			    node, pattern->pattern[y - 1], false);
+			if (node != NULL)
+				eds_subsc_index_hit(index, node->affix_ref_head,
+						    &match_list);
+		}
+	}
+
+	/* One delivery per channel open */
+	for (subrec = match_list; subrec != NULL;
+	     subrec = subrec->match_next) {
+		co = subrec->par_chan_open_inst;
+		if (co->match_gen == index->match_gen)
+			continue;
+		co->match_gen = index->match_gen;
+		co->match_subrec = co->subsc_rec_head;
+		while (!eds_subsc_matched(index, co->match_subrec))
+			co->match_subrec = co->match_subrec->next;
+		co->match_next = co_list;
+		co_list = co;
+	}
+
+	return (co_list);
+}
+
+/***************************************************************************
+ *
+ * eds_group_by_eda_dest() - Group the channel opens that an event is to be
+ *                           delivered to by the agent that opened them.
+ *
+ * The channel opens are taken from co_list, as returned by
+ * eds_subsc_index_match(), and relinked by match_next. Each agent is looked
+ * up once per channel open in the agent destination list, so the cost is
+ * linear in the number of matches.
+ *
+ * Returns the list of the agents to deliver to, linked by match_next, each
+ * with its channel opens in match_head and their number in match_num_co.
+ * The channel opens of agents without a destination record (no up event
+ * seen yet) are returned in *ungrouped.
+ *
+ ***************************************************************************/
+EDA_DEST_REC *eds_group_by_eda_dest(EDS_CB *cb, CHAN_OPEN_REC *co_list,
+				    CHAN_OPEN_REC **ungrouped)
+{
+	EDA_DEST_REC *dest_list = NULL;
+	EDA_DEST_REC *dest_tail = NULL;
+	EDA_DEST_REC *dest_rec;
+	CHAN_OPEN_REC *co;
+	CHAN_OPEN_REC *next;
+
+	*ungrouped = NULL;
+	cb->eda_dest_match_gen++;
+
+	for (co = co_list; co != NULL; co = next) {
+		next = co->match_next;
+		co->match_next = NULL;
+
+		dest_rec = (EDA_DEST_REC *)ncs_patricia_tree_get(
+		    &cb->eda_dest_list, (uint8_t *)&co->chan_opener_dest);
+		if (dest_rec == NULL) {
+			co->match_next = *ungrouped;
+			*ungrouped = co;
+			continue;
+		}
+
+		if (dest_rec->match_gen != cb->eda_dest_match_gen) {
+			dest_rec->match_gen = cb->eda_dest_match_gen;
+			dest_rec->match_head = co;
+			dest_rec->match_num_co = 1;
+			dest_rec->match_next = NULL;
+			if (dest_tail == NULL)
+				dest_list = dest_rec;
+			else
+				dest_tail->match_next = dest_rec;
+			dest_tail = dest_rec;
+		} else {
+			dest_rec->match_tail->match_next = co;
+			dest_rec->match_num_co++;
+		}
+		dest_rec->match_tail = co;
+	}
+
+	return (dest_list);
+}
+
+/***************************************************************************
+ *
+ * eds_eda_dest_batched() - Tell whether the channel opens grouped for an
+ *                          agent get the event in one
+ *                          EDSV_EDS_DELIVER_EVENT_BATCH message.
+ *
+ ***************************************************************************/
+bool eds_eda_dest_batched(const EDA_DEST_REC *dest_rec)
+{
+	return (dest_rec->match_num_co > 1 &&
+		dest_rec->svc_pvt_ver >= EDS_WRT_EDA_SUBPART_VER_DELIVER_BATCH);
+}
@@ -0,0 +1,424 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+extern "C" {
+#include "evt/evtd/eds.h"
+}
+#include "gtest/gtest.h"
+
+namespace {
+
+struct Filter {
+  SaEvtEventFilterTypeT type;
+  std::string pattern;
+};
+
+// A subscription with its own channel open, so that the channel opens
+// returned by eds_subsc_index_match() tell which subscriptions matched
+class Subscription {
+ public:
+  explicit Subscription(const std::vector<Filter>& filters)
+      : patterns_(filters.size()), filters_(filters.size()) {
+    for (size_t i = 0; i < filters.size(); ++i) {
+      patterns_[i] = filters[i].pattern;
+      filters_[i].filterType = filters[i].type;
+      filters_[i].filter.allocatedSize = patterns_[i].size();
+      filters_[i].filter.patternSize = patterns_[i].size();
+      filters_[i].filter.pattern = ToBytes(&patterns_[i]);
+    }
+    filter_array_.filtersNumber = filters_.size();
+    filter_array_.filters = filters_.empty() ? nullptr : filters_.data();
+    memset(&subrec_, 0, sizeof(subrec_));
+    memset(&chan_open_, 0, sizeof(chan_open_));
+    subrec_.filters = &filter_array_;
+    subrec_.par_chan_open_inst = &chan_open_;
+    chan_open_.subsc_rec_head = &subrec_;
+    chan_open_.subsc_rec_tail = &subrec_;
+  }
+  Subscription(const Subscription&) = delete;
+  Subscription& operator=(const Subscription&) = delete;
+
+  static SaUint8T* ToBytes(std::string* s) {
+    return s->empty() ? nullptr : reinterpret_cast<SaUint8T*>(&(*s)[0]);
+  }
+
+  SUBSC_REC* subrec() { return &subrec_; }
+  CHAN_OPEN_REC* chan_open() { return &chan_open_; }
+  SaEvtEventFilterArrayT* filter_array() { return &filter_array_; }
+
+ private:
+  std::vector<std::string> patterns_;
+  std::vector<SaEvtEventFilterT> filters_;
+  SaEvtEventFilterArrayT filter_array_;
+  SUBSC_REC subrec_;
+  CHAN_OPEN_REC chan_open_;
+};
+
+class Event {
+ public:
+  explicit Event(const std::vector<std::string>& patterns)
+      : data_(patterns), patterns_(patterns.size()) {
+    for (size_t i = 0; i < data_.size(); ++i) {
+      patterns_[i].allocatedSize = data_[i].size();
+      patterns_[i].patternSize = data_[i].size();
+      patterns_[i].pattern = Subscription::ToBytes(&data_[i]);
+    }
+    pattern_array_.allocatedNumber = patterns_.size();
+    pattern_array_.patternsNumber = patterns_.size();
+    pattern_array_.patterns = patterns_.empty() ? nullptr : patterns_.data();
+  }
+
+  SaEvtEventPatternArrayT* pattern_array() { return &pattern_array_; }
+
+ private:
+  std::vector<std::string> data_;
+  std::vector<SaEvtEventPatternT> patterns_;
+  SaEvtEventPatternArrayT pattern_array_;
+};
+
+class EdsSubscIndexTest : public ::testing::Test {
+ protected:
+  EdsSubscIndexTest() { memset(&index_, 0, sizeof(index_)); }
+
+  ~EdsSubscIndexTest() {
+    for (auto& subscription : subscriptions_)
+      eds_subsc_index_remove(subscription->subrec());
+    eds_subsc_index_destroy(&index_);
+  }
+
+  Subscription* Subscribe(const std::vector<Filter>& filters) {
+    subscriptions_.emplace_back(new Subscription(filters));
+    Subscription* subscription = subscriptions_.back().get();
+    EXPECT_EQ(eds_subsc_index_add(&index_, subscription->subrec()),
+              static_cast<uint32_t>(NCSCC_RC_SUCCESS));
+    return subscription;
+  }
+
+  // The subscriptions that eds_subsc_index_match() delivers the event to
+  std::set<Subscription*> IndexMatch(Event* event) {
+    std::set<Subscription*> result;
+    for (CHAN_OPEN_REC* co =
+             eds_subsc_index_match(&index_, event->pattern_array());
+         co != nullptr; co = co->match_next) {
+      EXPECT_EQ(co->match_subrec, co->subsc_rec_head);
+      for (auto& subscription : subscriptions_) {
+        if (subscription->chan_open() == co) {
+          EXPECT_TRUE(result.insert(subscription.get()).second);
+        }
+      }
+    }
+    return result;
+  }
+
+  // The subscriptions that eds_pattern_match() matches the event with
+  std::set<Subscription*> PatternMatch(Event* event) {
+    std::set<Subscription*> result;
+    for (auto& subscription : subscriptions_) {
+      if (eds_pattern_match(event->pattern_array(),
+                            subscription->filter_array()))
+        result.insert(subscription.get());
+    }
+    return result;
+  }
+
+  void ExpectSameMatch(const std::vector<std::string>& patterns) {
+    Event event(patterns);
+    EXPECT_EQ(IndexMatch(&event), PatternMatch(&event));
+  }
+
+  EDS_SUBSC_INDEX index_;
+  std::vector<std::unique_ptr<Subscription>> subscriptions_;
+};
+
+}  // namespace
+
+TEST_F(EdsSubscIndexTest, PrefixFilter) {
+  Subscription* ab = Subscribe({{SA_EVT_PREFIX_FILTER, "ab"}});
+  Subscription* empty = Subscribe({{SA_EVT_PREFIX_FILTER, ""}});
+  Event abc({"abc"});
+  EXPECT_EQ(IndexMatch(&abc), (std::set<Subscription*>{ab, empty}));
+  Event a({"a"});
+  EXPECT_EQ(IndexMatch(&a), (std::set<Subscription*>{empty}));
+  for (const char* pattern : {"", "a", "ab", "abc", "ba", "xab"})
+    ExpectSameMatch({pattern});
+}
+
+TEST_F(EdsSubscIndexTest, PrefixFilterLongerThanPattern) {
+  Subscribe({{SA_EVT_PREFIX_FILTER, "abcdef"}});
+  Event a({"abc"});
+  EXPECT_TRUE(IndexMatch(&a).empty());
+  EXPECT_TRUE(PatternMatch(&a).empty());
+}
+
+TEST_F(EdsSubscIndexTest, SuffixFilter) {
+  Subscription* bc = Subscribe({{SA_EVT_SUFFIX_FILTER, "bc"}});
+  Subscription* empty = Subscribe({{SA_EVT_SUFFIX_FILTER, ""}});
+  Event abc({"abc"});
+  EXPECT_EQ(IndexMatch(&abc), (std::set<Subscription*>{bc, empty}));
+  Event c({"c"});
+  EXPECT_EQ(IndexMatch(&c), (std::set<Subscription*>{empty}));
+  for (const char* pattern : {"", "c", "bc", "abc", "bcd", "cb"})
+    ExpectSameMatch({pattern});
+}
+
+TEST_F(EdsSubscIndexTest, ExactFilter) {
+  Subscription* ab = Subscribe({{SA_EVT_EXACT_FILTER, "ab"}});
+  Subscription* empty = Subscribe({{SA_EVT_EXACT_FILTER, ""}});
+  Event ab_event({"ab"});
+  EXPECT_EQ(IndexMatch(&ab_event), (std::set<Subscription*>{ab}));
+  Event empty_event({""});
+  EXPECT_EQ(IndexMatch(&empty_event), (std::set<Subscription*>{empty}));
+  for (const char* pattern : {"", "a", "ab", "abc", "xab"})
+    ExpectSameMatch({pattern});
+}
+
+TEST_F(EdsSubscIndexTest, PassAllFilter) {
+  Subscription* pass_all = Subscribe({{SA_EVT_PASS_ALL_FILTER, "xyz"},
+                                      {SA_EVT_PASS_ALL_FILTER, ""}});
+  Subscription* mixed = Subscribe({{SA_EVT_PASS_ALL_FILTER, "xyz"},
+                                   {SA_EVT_EXACT_FILTER, "b"}});
+  Event event({"a", "b"});
+  EXPECT_EQ(IndexMatch(&event), (std::set<Subscription*>{pass_all, mixed}));
+  Event no_patterns(std::vector<std::string>{});
+  EXPECT_EQ(IndexMatch(&no_patterns), (std::set<Subscription*>{pass_all}));
+  ExpectSameMatch({"a", "c"});
+  ExpectSameMatch({});
+}
+
+TEST_F(EdsSubscIndexTest, EmptyPatterns) {
+  Subscribe({{SA_EVT_PREFIX_FILTER, ""}, {SA_EVT_SUFFIX_FILTER, ""}});
+  Subscribe({{SA_EVT_EXACT_FILTER, ""}, {SA_EVT_EXACT_FILTER, ""}});
+  Subscribe({{SA_EVT_PREFIX_FILTER, "a"}});
+  Subscribe({{SA_EVT_SUFFIX_FILTER, "a"}});
+  Subscribe({{SA_EVT_EXACT_FILTER, "a"}});
+  ExpectSameMatch({});
+  ExpectSameMatch({""});
+  ExpectSameMatch({"", ""});
+  ExpectSameMatch({"a", ""});
+}
+
+TEST_F(EdsSubscIndexTest, MoreFiltersThanPatterns) {
+  // The filters without a pattern are matched with the empty pattern
+  Subscription* empty_rest = Subscribe({{SA_EVT_EXACT_FILTER, "a"},
+                                        {SA_EVT_EXACT_FILTER, ""},
+                                        {SA_EVT_PREFIX_FILTER, ""}});
+  Subscribe({{SA_EVT_EXACT_FILTER, "a"}, {SA_EVT_PREFIX_FILTER, "b"}});
+  Subscribe({{SA_EVT_EXACT_FILTER, "a"}, {SA_EVT_SUFFIX_FILTER, "b"}});
+  Event a({"a"});
+  EXPECT_EQ(IndexMatch(&a), (std::set<Subscription*>{empty_rest}));
+  ExpectSameMatch({"a"});
+  ExpectSameMatch({"a", "b"});
+  ExpectSameMatch({"a", "", ""});
+}
+
+TEST_F(EdsSubscIndexTest, OneDeliveryPerChannelOpen) {
+  Subscription* first = Subscribe({{SA_EVT_PREFIX_FILTER, "a"}});
+  Subscription* second = Subscribe({{SA_EVT_EXACT_FILTER, "ab"}});
+  // Both subscriptions belong to the channel open of the first one
+  first->subrec()->next = second->subrec();
+  second->subrec()->par_chan_open_inst = first->chan_open();
+  first->chan_open()->subsc_rec_tail = second->subrec();
+
+  Event event({"ab"});
+  CHAN_OPEN_REC* co = eds_subsc_index_match(&index_, event.pattern_array());
+  ASSERT_NE(co, nullptr);
+  EXPECT_EQ(co, first->chan_open());
+  EXPECT_EQ(co->match_subrec, first->subrec());
+  EXPECT_EQ(co->match_next, nullptr);
+}
+
+TEST_F(EdsSubscIndexTest, AgreesWithPatternMatch) {
+  // All combinations are too many, a fixed seed keeps the test repeatable
+  std::mt19937 random(4711);
+  const SaEvtEventFilterTypeT kTypes[] = {
+      SA_EVT_PREFIX_FILTER, SA_EVT_SUFFIX_FILTER, SA_EVT_EXACT_FILTER,
+      SA_EVT_PASS_ALL_FILTER};
+  auto random_string = [&random]() {
+    std::string s(random() % 4, 'a');
+    for (char& c : s) c = "ab"[random() % 2];
+    return s;
+  };
+
+  for (int i = 0; i < 200; ++i) {
+    std::vector<Filter> filters(random() % 4);
+    for (Filter& filter : filters) {
+      filter.type = kTypes[random() % 4];
+      filter.pattern = random_string();
+    }
+    Subscribe(filters);
+  }
+  for (int i = 0; i < 1000; ++i) {
+    std::vector<std::string> patterns(random() % 4);
+    for (std::string& pattern : patterns) pattern = random_string();
+    ExpectSameMatch(patterns);
+  }
+}
+
+namespace {
+
+// Channel opens of agents, grouped by eds_group_by_eda_dest() as for the
+// deliveries of one published event
+class EdsGroupByEdaDestTest : public ::testing::Test {
+ protected:
+  EdsGroupByEdaDestTest() {
+    memset(&cb_, 0, sizeof(cb_));
+    NCS_PATRICIA_PARAMS param;
+    memset(&param, 0, sizeof(param));
+    param.key_size = sizeof(MDS_DEST);
+    EXPECT_EQ(ncs_patricia_tree_init(&cb_.eda_dest_list, &param),
+              static_cast<uint32_t>(NCSCC_RC_SUCCESS));
+  }
+
+  ~EdsGroupByEdaDestTest() {
+    for (auto& dest_rec : dest_recs_)
+      ncs_patricia_tree_del(&cb_.eda_dest_list, &dest_rec->pat_node);
+    ncs_patricia_tree_destroy(&cb_.eda_dest_list);
+  }
+
+  void AddAgent(MDS_DEST mds_dest, MDS_SVC_PVT_SUB_PART_VER version) {
+    dest_recs_.emplace_back(new EDA_DEST_REC());
+    EDA_DEST_REC* dest_rec = dest_recs_.back().get();
+    dest_rec->mds_dest = mds_dest;
+    dest_rec->svc_pvt_ver = version;
+    dest_rec->pat_node.key_info =
+        reinterpret_cast<uint8_t*>(&dest_rec->mds_dest);
+    EXPECT_EQ(ncs_patricia_tree_add(&cb_.eda_dest_list, &dest_rec->pat_node),
+              static_cast<uint32_t>(NCSCC_RC_SUCCESS));
+  }
+
+  // Appends a match of a channel open of the agent to the match list
+  CHAN_OPEN_REC* Match(MDS_DEST mds_dest) {
+    chan_opens_.emplace_back(new CHAN_OPEN_REC());
+    CHAN_OPEN_REC* co = chan_opens_.back().get();
+    co->chan_opener_dest = mds_dest;
+    if (chan_opens_.size() > 1)
+      chan_opens_[chan_opens_.size() - 2]->match_next = co;
+    return co;
+  }
+
+  EDA_DEST_REC* Group(CHAN_OPEN_REC** ungrouped) {
+    return eds_group_by_eda_dest(
+        &cb_, chan_opens_.empty() ? nullptr : chan_opens_.front().get(),
+        ungrouped);
+  }
+
+  static std::vector<CHAN_OPEN_REC*> List(CHAN_OPEN_REC* co) {
+    std::vector<CHAN_OPEN_REC*> result;
+    for (; co != nullptr; co = co->match_next) result.push_back(co);
+    return result;
+  }
+
+  EDS_CB cb_;
+  std::vector<std::unique_ptr<EDA_DEST_REC>> dest_recs_;
+  std::vector<std::unique_ptr<CHAN_OPEN_REC>> chan_opens_;
+};
+
+}  // namespace
+
+TEST_F(EdsGroupByEdaDestTest, SeveralSubscriptionsOfOneAgent) {
+  AddAgent(1, EDS_WRT_EDA_SUBPART_VER_DELIVER_BATCH);
+  AddAgent(2, EDS_WRT_EDA_SUBPART_VER_DELIVER_BATCH);
+  CHAN_OPEN_REC* a1 = Match(1);
+  CHAN_OPEN_REC* b1 = Match(2);
+  CHAN_OPEN_REC* a2 = Match(1);
+  CHAN_OPEN_REC* a3 = Match(1);
+
+  CHAN_OPEN_REC* ungrouped;
+  EDA_DEST_REC* dest_rec = Group(&ungrouped);
+  EXPECT_EQ(ungrouped, nullptr);
+
+  // The agents come in the order of their first match and keep the order of
+  // their channel opens
+  ASSERT_NE(dest_rec, nullptr);
+  EXPECT_EQ(dest_rec->mds_dest, 1u);
+  EXPECT_EQ(dest_rec->match_num_co, 3u);
+  EXPECT_EQ(List(dest_rec->match_head),
+            (std::vector<CHAN_OPEN_REC*>{a1, a2, a3}));
+  EXPECT_EQ(dest_rec->match_tail, a3);
+  EXPECT_TRUE(eds_eda_dest_batched(dest_rec));
+
+  dest_rec = dest_rec->match_next;
+  ASSERT_NE(dest_rec, nullptr);
+  EXPECT_EQ(dest_rec->mds_dest, 2u);
+  EXPECT_EQ(dest_rec->match_num_co, 1u);
+  EXPECT_EQ(List(dest_rec->match_head), (std::vector<CHAN_OPEN_REC*>{b1}));
+  // A single subscription needs no batch
+  EXPECT_FALSE(eds_eda_dest_batched(dest_rec));
+  EXPECT_EQ(dest_rec->match_next, nullptr);
+}
+
+TEST_F(EdsGroupByEdaDestTest, MixedAgentVersions) {
+  AddAgent(1, EDS_WRT_EDA_SUBPART_VER_DELIVER_BATCH - 1);
+  AddAgent(2, EDS_WRT_EDA_SUBPART_VER_DELIVER_BATCH);
+  CHAN_OPEN_REC* old1 = Match(1);
+  CHAN_OPEN_REC* new1 = Match(2);
+  CHAN_OPEN_REC* old2 = Match(1);
+  CHAN_OPEN_REC* new2 = Match(2);
+
+  CHAN_OPEN_REC* ungrouped;
+  EDA_DEST_REC* old_agent = Group(&ungrouped);
+  EXPECT_EQ(ungrouped, nullptr);
+  ASSERT_NE(old_agent, nullptr);
+  EDA_DEST_REC* new_agent = old_agent->match_next;
+  ASSERT_NE(new_agent, nullptr);
+  EXPECT_EQ(new_agent->match_next, nullptr);
+
+  // The old agent does not know the batch message and gets one per match
+  EXPECT_EQ(List(old_agent->match_head),
+            (std::vector<CHAN_OPEN_REC*>{old1, old2}));
+  EXPECT_FALSE(eds_eda_dest_batched(old_agent));
+  EXPECT_EQ(List(new_agent->match_head),
+            (std::vector<CHAN_OPEN_REC*>{new1, new2}));
+  EXPECT_TRUE(eds_eda_dest_batched(new_agent));
+}
+
+TEST_F(EdsGroupByEdaDestTest, UnknownAgent) {
+  AddAgent(1, EDS_WRT_EDA_SUBPART_VER_DELIVER_BATCH);
+  CHAN_OPEN_REC* unknown1 = Match(3);
+  CHAN_OPEN_REC* known = Match(1);
+  CHAN_OPEN_REC* unknown2 = Match(3);
+
+  CHAN_OPEN_REC* ungrouped;
+  EDA_DEST_REC* dest_rec = Group(&ungrouped);
+  ASSERT_NE(dest_rec, nullptr);
+  EXPECT_EQ(List(dest_rec->match_head), (std::vector<CHAN_OPEN_REC*>{known}));
+  EXPECT_EQ(dest_rec->match_next, nullptr);
+  std::vector<CHAN_OPEN_REC*> rest = List(ungrouped);
+  EXPECT_EQ(std::set<CHAN_OPEN_REC*>(rest.begin(), rest.end()),
+            (std::set<CHAN_OPEN_REC*>{unknown1, unknown2}));
+  EXPECT_EQ(rest.size(), 2u);
+}
+
+TEST_F(EdsGroupByEdaDestTest, RegroupedPerPublish) {
+  AddAgent(1, EDS_WRT_EDA_SUBPART_VER_DELIVER_BATCH);
+  Match(1);
+  Match(1);
+  CHAN_OPEN_REC* ungrouped;
+  EXPECT_EQ(Group(&ungrouped)->match_num_co, 2u);
+
+  // A following publish does not see the matches of the previous one
+  chan_opens_.clear();
+  CHAN_OPEN_REC* co = Match(1);
+  EDA_DEST_REC* dest_rec = Group(&ungrouped);
+  ASSERT_NE(dest_rec, nullptr);
+  EXPECT_EQ(dest_rec->match_num_co, 1u);
+  EXPECT_EQ(List(dest_rec->match_head), (std::vector<CHAN_OPEN_REC*>{co}));
+}
@@ -16,9 +16,13 @@
  */
 
 #include "log/agent/lga_agent.h"
+#include <errno.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include <algorithm>
 #include "base/ncs_hdl_pub.h"
+#include "base/time.h"
 #include "base/osaf_poll.h"
 #include "base/saf_error.h"
 #include "log/agent/lga_mds.h"
@@ -185,9 +189,80 @@ LogAgent::~LogAgent() {
   // used in other process. If this process was forked, two processes will
   // share all created sockets. Cleaning resources in one process causes
   // undefined behaviours in other process.
+  // The write batch thread is private to the process that started it and
+  // must not run while the static objects are destroyed.
+  if (write_batch_thread_pid_ == getpid()) StopWriteBatchThread();
   TRACE_LEAVE();
 }
 
+void LogAgent::StartWriteBatchThread() {
+  TRACE_ENTER();
+  ScopeLock scopeLock(mutex_);
+  if (write_batch_thread_running_ == true) return;
+
+  // Batching is enabled by giving the max number of write requests in
+  // one batch. The delay is how long time a write request may be kept
+  // in the agent before it is sent to the log server.
+  char* value;
+  uint32_t size = 0;
+  if ((value = getenv("LOGSV_AGENT_WRITE_BATCH_SIZE")) != nullptr) {
+    size = strtoul(value, nullptr, 0);
+    if (size > kMaxWriteBatchSize) size = kMaxWriteBatchSize;
+  }
+  uint32_t delay = kDefaultWriteBatchDelayMs;
+  if ((value = getenv("LOGSV_AGENT_WRITE_BATCH_DELAY_MS")) != nullptr) {
+    delay = strtoul(value, nullptr, 0);
+    if (delay == 0) delay = kDefaultWriteBatchDelayMs;
+    if (delay > kMaxWriteBatchDelayMs) delay = kMaxWriteBatchDelayMs;
+  }
+  write_batch_delay_ms_ = delay;
+  write_batch_size_ = size;
+  if (is_write_batch_enabled() == false) return;
+
+  write_batch_thread_stop_ = false;
+  if (pthread_create(&write_batch_thread_, nullptr, WriteBatchThread,
+                     nullptr) != 0) {
+    TRACE("%s: pthread_create FAILED: %s", __func__, strerror(errno));
+    // Without the thread a batch may wait forever, do not batch at all
+    write_batch_size_ = 0;
+    return;
+  }
+  write_batch_thread_pid_ = getpid();
+  write_batch_thread_running_ = true;
+  TRACE_LEAVE2("size = %u, delay = %u ms", size, delay);
+}
+
+void LogAgent::StopWriteBatchThread() {
+  TRACE_ENTER();
+  if (write_batch_thread_running_ == false) return;
+  write_batch_size_ = 0;
+  write_batch_thread_stop_ = true;
+  pthread_join(write_batch_thread_, nullptr);
+  write_batch_thread_running_ = false;
+  TRACE_LEAVE();
+}
+
+void LogAgent::FlushAllWriteBatches(uint64_t max_age_ms) {
+  ScopeLock scopeLock(mutex_);
+  for (auto& client : client_list_) {
+    if (client == nullptr) continue;
+    client->FlushBatch(max_age_ms);
+  }
+}
+
+// Wake up twice per delay period. A write request will then wait at most
+// about one delay period in a batch.
+void* LogAgent::WriteBatchThread(void*) {
+  LogAgent* agent = instance();
+  while (agent->write_batch_thread_stop_ == false) {
+    uint64_t period = agent->write_batch_delay_ms_ / 2;
+    if (period == 0) period = 1;
+    base::Sleep(base::MillisToTimespec(period));
+    agent->FlushAllWriteBatches(period);
+  }
+  return nullptr;
+}
+
 void LogAgent::PopulateOpenParams(
     const char* dn, uint32_t client_id,
     SaLogFileCreateAttributesT_2* logFileCreateAttributes,
@@ -531,6 +606,7 @@ SaAisErrorT LogAgent::saLogInitialize(SaLogHandleT* logHandle,
   *logHandle = client->GetHandle();
   lga_msg_destroy(o_msg);
   AddLogClient(client);
+  StartWriteBatchThread();
 
   TRACE_LEAVE2("client_id = %d", client_id);
   return ais_rc;
@@ -756,6 +832,9 @@ SaAisErrorT LogAgent::saLogFinalize(SaLogHandleT logHandle) {
     }
   }
 
+  // Make sure that batched write requests are written before the finalize
+  client->FlushBatch();
+
   // Populate & send the finalize message and make sure the finalize
   // from the server end returned before deleting the local records.
   ais_rc = SendFinalizeMsg(client->GetClientId());
@@ -770,6 +849,7 @@ SaAisErrorT LogAgent::saLogFinalize(SaLogHandleT logHandle) {
   if (lga_get_number_of_user() == 0) {
     // Stop recovery thread if it's running
     stop_recovery2_thread();
+    StopWriteBatchThread();
     // Shutdown the agent
     rc = lga_shutdown();
     if (rc != NCSCC_RC_SUCCESS) {
@@ -1424,6 +1504,19 @@ SaAisErrorT LogAgent::saLogWriteLogAsync(SaLogStreamHandleT logStreamHandle,
   write_param->client_id = client->GetClientId();
   write_param->lstr_id = stream->GetStreamId();
   write_param->logRecord = const_cast<SaLogRecordT*>(logRecord);
+
+  // Batch the request if configured and if the LOG server understands
+  // batched write requests. The batch is sent when full or by the write
+  // batch thread when it has waited long enough.
+  if (is_write_batch_enabled() && lga_mds_msg_does_support_write_batch()) {
+    if (client->AddToBatch(write_param, write_batch_size_,
+                           kMaxWriteBatchBytes) == true) {
+      return ais_rc;
+    }
+    // Keep the order of the write requests
+    client->FlushBatch();
+  }
+
   // Send the message out to the LGS
   if (NCSCC_RC_SUCCESS !=
       lga_mds_msg_async_send(&msg, MDS_SEND_PRIORITY_MEDIUM)) {
@@ -1544,6 +1637,9 @@ SaAisErrorT LogAgent::saLogStreamClose(SaLogStreamHandleT logStreamHandle) {
     }
   }
 
+  // Make sure that batched write requests are written before the close
+  client->FlushBatch();
+
   // Populate a MDS message to send to the LGS for a channel close operation.
   memset(&msg, 0, sizeof(lgsv_msg_t));
   msg.type = LGSV_LGA_API_MSG;
@@ -18,6 +18,8 @@
 #ifndef SRC_LOG_AGENT_LGA_AGENT_H_
 #define SRC_LOG_AGENT_LGA_AGENT_H_
 
+#include <pthread.h>
+#include <sys/types.h>
 #include <atomic>
 #include <memory>
 #include <string>
@@ -162,6 +164,14 @@ class LogAgent {
   // Mark received initial clm status
   void MarkInitClmStatus();
 
+  // Read the write batching configuration and start the thread sending
+  // batches that have been waiting for too long. Does nothing if write
+  // batching is not enabled or the thread is already running.
+  void StartWriteBatchThread();
+
+  // Stop the write batch thread. Safe to call if the thread is not running.
+  void StopWriteBatchThread();
+
   // Enter critical section - make sure ref counter is fetched.
   // Introduce these public interface for MDS thread use.
   void EnterCriticalSection();
@@ -220,6 +230,15 @@ class LogAgent {
   // Retrieve current time
   static SaTimeT SetLogTime();
 
+  // True if saLogWriteLogAsync() shall batch write requests
+  bool is_write_batch_enabled() const;
+
+  // Send batches of all clients that are older than @max_age_ms
+  void FlushAllWriteBatches(uint64_t max_age_ms);
+
+  // Body of the write batch thread
+  static void* WriteBatchThread(void*);
+
   // Constant values used by @LogAgent only
   enum {
     kSafMinAcceptTime = 10,
@@ -227,7 +246,12 @@ class LogAgent {
     // Temporary maximum log file name length. Used to avoid LOG client
     // sends too long (big data) file name to LOG service.
     // The real limit check will be done on LOG service side.
-    kMaxLogFileNameLenth = 2048
+    kMaxLogFileNameLenth = 2048,
+    // Limits for batching of write requests, see StartWriteBatchThread()
+    kMaxWriteBatchSize = 1024,
+    kMaxWriteBatchBytes = 64 * 1024,
+    kDefaultWriteBatchDelayMs = 10,
+    kMaxWriteBatchDelayMs = 1000
   };
 
   // Group all atomic data into one for easily management.
@@ -279,6 +303,22 @@ class LogAgent {
   // Hold list of current log clients
   std::vector<LogClient*> client_list_;
 
+  // Max number of write requests in one batch. Batching is disabled if 0.
+  // Configured with LOGSV_AGENT_WRITE_BATCH_SIZE
+  std::atomic<uint32_t> write_batch_size_{0};
+
+  // Max time in milliseconds a write request may wait in a batch.
+  // Configured with LOGSV_AGENT_WRITE_BATCH_DELAY_MS
+  std::atomic<uint32_t> write_batch_delay_ms_{kDefaultWriteBatchDelayMs};
+
+  // Thread sending batches that have waited for @write_batch_delay_ms_
+  pthread_t write_batch_thread_{};
+  std::atomic<bool> write_batch_thread_running_{false};
+  std::atomic<bool> write_batch_thread_stop_{false};
+  // Process that started the thread. The thread does not exist in a child
+  // process if the process is forked.
+  pid_t write_batch_thread_pid_{0};
+
   // Initial CLM status sync params
   NCS_SEL_OBJ init_clm_status_sel_;
   // Log server sync params
@@ -320,6 +360,10 @@ inline bool LogAgent::is_logrecord_size_valid(SaUint32T size) {
   return (size > SA_LOG_MAX_RECORD_SIZE);
 }
 
+inline bool LogAgent::is_write_batch_enabled() const {
+  return write_batch_size_ > 1;
+}
+
 inline bool LogAgent::is_log_version_valid(const SaVersionT* ver) {
   assert(ver != nullptr);
   return ((ver->releaseCode == LOG_RELEASE_CODE) &&
@@ -23,6 +23,7 @@
 #include "base/ncs_hdl_pub.h"
 #include "base/saf_error.h"
 #include "base/mutex.h"
+#include "base/ncssysf_mem.h"
 #include "log/agent/lga_mds.h"
 #include "log/common/lgsv_defs.h"
 #include "log/agent/lga_common.h"
@@ -86,6 +87,10 @@ LogClient::~LogClient() {
   }
 
   stream_list_.clear();
+  if (true) {
+    base::Lock scope_lock{mutex_batch_};
+    DiscardBatch();
+  }
   CleanUnackedList();
 
   // Free the client handle allocated to this log client
@@ -400,9 +405,99 @@ void LogClient::NoLogServer() {
     stream->SetRecoveryFlag(false);
   }
 
+  // The batched write requests are tracked as unacked invocations if
+  // the log client has asked for an acknowledgement.
+  if (true) {
+    base::Lock scope_lock{mutex_batch_};
+    DiscardBatch();
+  }
+
   NotifyClientAboutLostInvocations();
 }
 
+bool LogClient::AddToBatch(const lgsv_write_log_async_req_t* param,
+                           uint32_t max_records, uint32_t max_bytes) {
+  TRACE_ENTER();
+  NCS_UBAID uba;
+
+  // Encode outside of the batch so that a failure does not leave
+  // a partly encoded request in it.
+  if (ncs_enc_init_space(&uba) != NCSCC_RC_SUCCESS) {
+    TRACE("%s: ncs_enc_init_space FAILED", __func__);
+    return false;
+  }
+  if (lga_enc_write_log_async_req(&uba, param) == 0) {
+    TRACE("%s: Encoding of write request FAILED", __func__);
+    m_MMGR_FREE_BUFR_LIST(uba.start);
+    return false;
+  }
+
+  base::Lock scope_lock{mutex_batch_};
+  if (batch_records_ == 0) {
+    batch_uba_ = uba;
+    batch_start_ = base::ReadMonotonicClock();
+  } else {
+    ncs_enc_append_usrbuf(&batch_uba_, uba.start);
+  }
+  batch_records_++;
+  if (param->ack_flags == SA_LOG_RECORD_WRITE_ACK) {
+    batch_invocations_.push_back(param->invocation);
+  }
+  KeepTrack(param->invocation, param->ack_flags);
+
+  if ((batch_records_ >= max_records) || (static_cast<uint32_t>(batch_uba_.ttl) >= max_bytes)) {
+    SendBatch();
+  }
+  return true;
+}
+
+void LogClient::FlushBatch(uint64_t max_age_ms) {
+  base::Lock scope_lock{mutex_batch_};
+  if (batch_records_ == 0) return;
+  if (max_age_ms != 0) {
+    struct timespec age = base::ReadMonotonicClock() - batch_start_;
+    if (base::TimespecToMillis(age) < max_age_ms) return;
+  }
+  SendBatch();
+}
+
+void LogClient::SendBatch() {
+  TRACE_ENTER();
+  if (batch_records_ == 0) return;
+
+  lgsv_msg_t msg;
+  memset(&msg, 0, sizeof(lgsv_msg_t));
+  msg.type = LGSV_LGA_API_MSG;
+  msg.info.api_info.type = LGSV_WRITE_LOG_ASYNC_BATCH_REQ;
+  msg.info.api_info.param.write_log_async_batch.num_records = batch_records_;
+  msg.info.api_info.param.write_log_async_batch.records = batch_uba_.start;
+  if (NCSCC_RC_SUCCESS !=
+      lga_mds_msg_async_send(&msg, MDS_SEND_PRIORITY_MEDIUM)) {
+    TRACE("%s: Sending %u write requests FAILED", __func__, batch_records_);
+    // The log client has already got SA_AIS_OK for these requests. Give
+    // a SA_AIS_ERR_TRY_AGAIN in the write callback to the ones that asked
+    // for it, unless that has already been done.
+    base::Lock scope_lock{mutex_unacked_list_};
+    for (const auto& i : batch_invocations_) {
+      auto it = std::find(unacked_invocations_.begin(),
+                          unacked_invocations_.end(), i);
+      if (it == unacked_invocations_.end()) continue;
+      unacked_invocations_.erase(it);
+      NotifyLostInvocation(i);
+    }
+  }
+  DiscardBatch();
+}
+
+void LogClient::DiscardBatch() {
+  if (batch_uba_.start != nullptr) {
+    m_MMGR_FREE_BUFR_LIST(batch_uba_.start);
+  }
+  memset(&batch_uba_, 0, sizeof(batch_uba_));
+  batch_records_ = 0;
+  batch_invocations_.clear();
+}
+
 uint32_t LogClient::SendMsgToMbx(lgsv_msg_t* msg, MDS_SEND_PRIORITY_TYPE prio) {
   TRACE_ENTER();
   if (NCSCC_RC_SUCCESS !=
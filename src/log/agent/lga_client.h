@@ -19,11 +19,13 @@
 #define SRC_LOG_AGENT_LGA_CLIENT_H_
 
 #include <stdint.h>
+#include <time.h>
 #include <vector>
 #include <list>
 #include <atomic>
 #include <saLog.h>
 #include "base/mutex.h"
+#include "base/ncs_ubaid.h"
 #include "mds/mds_papi.h"
 #include "log/agent/lga_stream.h"
 #include "log/common/lgsv_msg.h"
@@ -187,23 +189,24 @@ class LogClient {
   void NotifyClientAboutLostInvocations() {
     base::Lock scope_lock{mutex_unacked_list_};
     for (const auto& i : unacked_invocations_) {
-      TRACE("The write async with this invocation %lld has been lost", i);
-      // the below memory will be freed by lga_msg_destroy(cbk_msg)
-      // after done processing with this msg from the mailbox.
-      lgsv_msg_t* msg = static_cast<lgsv_msg_t*>(malloc(sizeof(lgsv_msg_t)));
-      assert(msg && "Failed to allocate memory for lgsv_msg_t");
-      memset(msg, 0, sizeof(lgsv_msg_t));
-      msg->type = LGSV_LGS_CBK_MSG;
-      msg->info.cbk_info.type = LGSV_WRITE_LOG_CALLBACK_IND;
-      msg->info.cbk_info.lgs_client_id = client_id_;
-      msg->info.cbk_info.write_cbk.error = SA_AIS_ERR_TRY_AGAIN;
-      msg->info.cbk_info.inv = i;
-
-      SendMsgToMbx(msg, MDS_SEND_PRIORITY_HIGH);
+      NotifyLostInvocation(i);
     }
     unacked_invocations_.clear();
   }
 
+  // Add the write request @param to the batch of @this client. The request
+  // is encoded right away so @param is not referred after returning.
+  // The batch is sent to log server when it holds @max_records requests or
+  // @max_bytes encoded bytes. Return false if the request was not added.
+  bool AddToBatch(const lgsv_write_log_async_req_t* param,
+                  uint32_t max_records, uint32_t max_bytes);
+
+  // Send the batched write requests to log server. If @max_age_ms is given,
+  // the batch is only sent if the first request in it is at least that old.
+  // Requests that can not be sent are acknowledged with SA_AIS_ERR_TRY_AGAIN
+  // if the log client asked for an acknowledgement.
+  void FlushBatch(uint64_t max_age_ms = 0);
+
   // true if the client is successfully done recovery.
   // or the client has just borned.
   // Introduce this method to avoid locking the successful recovered client
@@ -237,6 +240,24 @@ class LogClient {
   // Invoke the registered callback
   void InvokeCallback(const lgsv_msg_t* msg);
 
+  // Put a write callback with SA_AIS_ERR_TRY_AGAIN for the lost write
+  // request with invocation @inv in the mailbox of @this client.
+  void NotifyLostInvocation(SaInvocationT inv) {
+    TRACE("The write async with this invocation %lld has been lost", inv);
+    // the below memory will be freed by lga_msg_destroy(cbk_msg)
+    // after done processing with this msg from the mailbox.
+    lgsv_msg_t* msg = static_cast<lgsv_msg_t*>(malloc(sizeof(lgsv_msg_t)));
+    assert(msg && "Failed to allocate memory for lgsv_msg_t");
+    memset(msg, 0, sizeof(lgsv_msg_t));
+    msg->type = LGSV_LGS_CBK_MSG;
+    msg->info.cbk_info.type = LGSV_WRITE_LOG_CALLBACK_IND;
+    msg->info.cbk_info.lgs_client_id = client_id_;
+    msg->info.cbk_info.write_cbk.error = SA_AIS_ERR_TRY_AGAIN;
+    msg->info.cbk_info.inv = inv;
+
+    SendMsgToMbx(msg, MDS_SEND_PRIORITY_HIGH);
+  }
+
   void CleanUnackedList() {
     base::Lock scope_lock{mutex_unacked_list_};
     unacked_invocations_.clear();
@@ -245,6 +266,13 @@ class LogClient {
   // Delete all messages from the mailbox
   static bool ClearMailBox(NCSCONTEXT, NCSCONTEXT);
 
+  // Send the batch. The caller must hold @mutex_batch_
+  void SendBatch();
+
+  // Drop the batched write requests without sending them.
+  // The caller must hold @mutex_batch_
+  void DiscardBatch();
+
  private:
   // Handle value returned by LGS for this client
   uint32_t client_id_;
@@ -304,6 +332,22 @@ class LogClient {
   // To protect the `unacked_invocations_` list.
   base::Mutex mutex_unacked_list_{};
 
+  // Write requests batched by saLogWriteLogAsync(), encoded but not yet sent
+  // to log server. Only used if the write batching is enabled.
+  NCS_UBAID batch_uba_{};
+
+  // Number of write requests in @batch_uba_
+  uint32_t batch_records_{0};
+
+  // Invocations of the batched write requests that asked for an ack
+  std::vector<SaInvocationT> batch_invocations_{};
+
+  // Time when the first write request was added to the batch
+  struct timespec batch_start_{};
+
+  // To protect the batch of write requests
+  base::Mutex mutex_batch_{};
+
   // LOG handle (derived from hdl-mngr)
   SaLogHandleT handle_;
 
@@ -24,22 +24,24 @@
 #include "log/agent/lga_util.h"
 #include "base/osaf_extended_name.h"
 #include "base/ncs_util.h"
+#include "base/ncssysf_mem.h"
 #include "log/agent/lga_agent.h"
 #include "log/agent/lga_client.h"
 #include "log/agent/lga_common.h"
 #include "log/common/lgsv_defs.h"
 
-#define LGA_SVC_PVT_SUBPART_VERSION 2
+#define LGA_SVC_PVT_SUBPART_VERSION 3
 #define LGA_WRT_LGS_SUBPART_VER_AT_MIN_MSG_FMT 1
-#define LGA_WRT_LGS_SUBPART_VER_AT_MAX_MSG_FMT 2
+#define LGA_WRT_LGS_SUBPART_VER_AT_MAX_MSG_FMT 3
 #define LGA_WRT_LGS_SUBPART_VER_RANGE       \
   (LGA_WRT_LGS_SUBPART_VER_AT_MAX_MSG_FMT - \
    LGA_WRT_LGS_SUBPART_VER_AT_MIN_MSG_FMT + 1)
 #define LGA_SVC_PVT_INIT_CLM_STATE_SUBPART_VERSION 2
+#define LGA_SVC_PVT_WRITE_BATCH_SUBPART_VERSION 3
 
-// msg format version for LGA subpart version 2
+// msg format version for LGA subpart version 3
 static MDS_CLIENT_MSG_FORMAT_VER
-    LGA_WRT_LGS_MSG_FMT_ARRAY[LGA_WRT_LGS_SUBPART_VER_RANGE] = {1, 2};
+    LGA_WRT_LGS_MSG_FMT_ARRAY[LGA_WRT_LGS_SUBPART_VER_RANGE] = {1, 2, 3};
 
 static MDS_SVC_PVT_SUB_PART_VER rem_svc_pvt_ver = LGA_SVC_PVT_SUBPART_VERSION;
 
@@ -405,21 +407,22 @@ static uint32_t lga_enc_write_gen_header(
 }
 
 /****************************************************************************
-  Name          : lga_enc_write_log_async_msg
+  Name          : lga_enc_write_log_async_req
 
-  Description   : This routine encodes a write log async API msg
+  Description   : This routine encodes the parameters of one write log async
+                  request. Used both for single and batched requests.
 
   Arguments     : NCS_UBAID *msg,
-                  LGSV_MSG *msg
+                  lgsv_write_log_async_req_t *param
 
-  Return Values : uint32_t
+  Return Values : uint32_t, number of encoded bytes or 0 if error
 
   Notes         : None.
 ******************************************************************************/
-static uint32_t lga_enc_write_log_async_msg(NCS_UBAID *uba, lgsv_msg_t *msg) {
+uint32_t lga_enc_write_log_async_req(NCS_UBAID *uba,
+                                     const lgsv_write_log_async_req_t *param) {
   uint8_t *p8;
   uint32_t total_bytes = 0;
-  lgsv_write_log_async_req_t *param = &msg->info.api_info.param.write_log_async;
   const SaLogNtfLogHeaderT *ntfLogH;
   const SaLogGenericLogHeaderT *genLogH;
 
@@ -497,6 +500,67 @@ static uint32_t lga_enc_write_log_async_msg(NCS_UBAID *uba, lgsv_msg_t *msg) {
   return total_bytes;
 }
 
+/****************************************************************************
+  Name          : lga_enc_write_log_async_msg
+
+  Description   : This routine encodes a write log async API msg
+
+  Arguments     : NCS_UBAID *msg,
+                  LGSV_MSG *msg
+
+  Return Values : uint32_t
+
+  Notes         : None.
+******************************************************************************/
+static uint32_t lga_enc_write_log_async_msg(NCS_UBAID *uba, lgsv_msg_t *msg) {
+  return lga_enc_write_log_async_req(uba,
+                                     &msg->info.api_info.param.write_log_async);
+}
+
+/****************************************************************************
+  Name          : lga_enc_write_log_async_batch_msg
+
+  Description   : This routine encodes a batch of write log async requests.
+                  The requests are already encoded when added to the batch,
+                  a duplicate of the buffer chain is appended to the message.
+
+  Arguments     : NCS_UBAID *msg,
+                  LGSV_MSG *msg
+
+  Return Values : uint32_t
+
+  Notes         : None.
+******************************************************************************/
+static uint32_t lga_enc_write_log_async_batch_msg(NCS_UBAID *uba,
+                                                  lgsv_msg_t *msg) {
+  uint8_t *p8;
+  uint32_t total_bytes = 0;
+  lgsv_write_log_async_batch_req_t *param =
+      &msg->info.api_info.param.write_log_async_batch;
+
+  osafassert(uba != nullptr);
+  osafassert(param->records != nullptr);
+
+  p8 = ncs_enc_reserve_space(uba, 4);
+  if (!p8) {
+    TRACE("Could not reserve space");
+    return 0;
+  }
+  ncs_encode_32bit(&p8, param->num_records);
+  ncs_enc_claim_space(uba, 4);
+  total_bytes += 4;
+
+  USRBUF *records = m_MMGR_DITTO_BUFR(param->records);
+  if (records == nullptr) {
+    TRACE("Could not duplicate batched records");
+    return 0;
+  }
+  total_bytes += m_MMGR_LINK_DATA_LEN(records);
+  ncs_enc_append_usrbuf(uba, records);
+
+  return total_bytes;
+}
+
 /****************************************************************************
   Name          : lga_client_lgs_msg_proc
 
@@ -853,6 +917,10 @@ static uint32_t lga_mds_enc(struct ncsmds_callback_info *info) {
         total_bytes += lga_enc_write_log_async_msg(uba, msg);
         break;
 
+      case LGSV_WRITE_LOG_ASYNC_BATCH_REQ:
+        total_bytes += lga_enc_write_log_async_batch_msg(uba, msg);
+        break;
+
       default:
         TRACE("Unknown API type = %d", msg->info.api_info.type);
         break;
@@ -1474,6 +1542,17 @@ bool lga_mds_msg_does_support_init_clm_status() {
   return rem_svc_pvt_ver >= LGA_SVC_PVT_INIT_CLM_STATE_SUBPART_VERSION;
 }
 
+/****************************************************************************
+ * Name          : lga_mds_msg_does_support_write_batch
+ *
+ * Description   : Check if the log server can receive batched write requests
+ *
+ * Return Values : true/false
+ *****************************************************************************/
+bool lga_mds_msg_does_support_write_batch() {
+  return rem_svc_pvt_ver >= LGA_SVC_PVT_WRITE_BATCH_SUBPART_VERSION;
+}
+
 /****************************************************************************
  * Name          : lga_msg_destroy
  *
@@ -20,9 +20,10 @@
 
 #include <stdint.h>
 #include <saAis.h>
+#include "base/ncs_ubaid.h"
+#include "log/common/lgsv_msg.h"
 
 struct lga_cb_t;
-struct lgsv_msg_t;
 
 uint32_t lga_mds_init();
 uint32_t lga_mds_deinit();
@@ -33,5 +34,9 @@ uint32_t lga_mds_msg_sync_send(lgsv_msg_t *i_msg, lgsv_msg_t **o_msg,
 uint32_t lga_mds_msg_async_send(lgsv_msg_t *i_msg, uint32_t prio);
 
 bool lga_mds_msg_does_support_init_clm_status();
+bool lga_mds_msg_does_support_write_batch();
+
+uint32_t lga_enc_write_log_async_req(NCS_UBAID *uba,
+                                     const lgsv_write_log_async_req_t *param);
 
 #endif  // SRC_LOG_AGENT_LGA_MDS_H_
@@ -26,6 +26,8 @@
 
 #include "logtest.h"
 
+#define MAX_DATA 256
+
 /**
  * Wait for log server asynchronous event and dispatch the callback
  *
@@ -486,6 +488,91 @@ void saLogWriteLogAsync_invalid_handle(void)
 done:
 	logFinalize();
 }
+
+/**
+ * Write log records that are batched by the agent and finalize the handle
+ * without closing the stream. All records shall be found in the log file.
+ */
+void saLogWriteLogAsync_20(void)
+{
+	static SaLogFileCreateAttributesT_2 appStreamLogFileCreateAttributes = {
+	    .logFilePathName = DEFAULT_APP_FILE_PATH_NAME,
+	    .logFileName = DEFAULT_APP_FILE_NAME,
+	    .maxLogFileSize = DEFAULT_APP_LOG_FILE_SIZE,
+	    .maxLogRecordSize = DEFAULT_APP_LOG_REC_SIZE,
+	    .haProperty = SA_TRUE,
+	    .logFileFullAction = SA_LOG_FILE_FULL_ACTION_ROTATE,
+	    .maxFilesRotated = DEFAULT_MAX_FILE_ROTATED,
+	    .logFileFmt = DEFAULT_FORMAT_EXPRESSION};
+	const int num_records = 8;
+	char log_tag[64];
+	char command[MAX_DATA];
+	int found = 0;
+	int i;
+	FILE *fp;
+
+	/* Batch the records and keep them in the agent until finalize */
+	setenv("LOGSV_AGENT_WRITE_BATCH_SIZE", "16", 1);
+	setenv("LOGSV_AGENT_WRITE_BATCH_DELAY_MS", "1000", 1);
+	snprintf(log_tag, sizeof(log_tag), "%s_%d", __FUNCTION__, getpid());
+
+	rc = logInitialize();
+	if (rc != SA_AIS_OK) {
+		test_validate(rc, SA_AIS_OK);
+		goto done_env;
+	}
+	rc = logAppStreamOpen(&app1StreamName,
+			      &appStreamLogFileCreateAttributes);
+	if (rc != SA_AIS_OK) {
+		test_validate(rc, SA_AIS_OK);
+		goto done;
+	}
+
+	for (i = 0; i < num_records; i++) {
+		snprintf((char *)genLogRecord.logBuffer->logBuf,
+			 DEFAULT_APP_LOG_REC_SIZE, "%s record %d", log_tag, i);
+		genLogRecord.logBuffer->logBufSize =
+		    strlen((char *)genLogRecord.logBuffer->logBuf);
+		rc = logWriteAsync(&genLogRecord);
+		if (rc != SA_AIS_OK) {
+			test_validate(rc, SA_AIS_OK);
+			goto done;
+		}
+	}
+
+	/* No stream close, the finalize must write the pending batch */
+	rc = logFinalize();
+	if (rc != SA_AIS_OK) {
+		test_validate(rc, SA_AIS_OK);
+		goto done_env;
+	}
+
+	sprintf(command,
+		"find %s/%s -type f -mmin -1 "
+		"| egrep \"%s_([0-9]{8}_[0-9]{6}\\.log$)\" "
+		"| xargs grep -h \"%s record\" | wc -l",
+		log_root_path, DEFAULT_APP_FILE_PATH_NAME,
+		DEFAULT_APP_FILE_NAME, log_tag);
+	fp = popen(command, "r");
+	if (fp == NULL) {
+		fprintf(stderr, "popen failed: %s\n", strerror(errno));
+		test_validate(SA_AIS_ERR_LIBRARY, SA_AIS_OK);
+		goto done_env;
+	}
+	if (fscanf(fp, "%d", &found) != 1)
+		found = 0;
+	pclose(fp);
+
+	rc_validate(found, num_records);
+	goto done_env;
+
+done:
+	logFinalize();
+done_env:
+	unsetenv("LOGSV_AGENT_WRITE_BATCH_SIZE");
+	unsetenv("LOGSV_AGENT_WRITE_BATCH_DELAY_MS");
+}
+
 __attribute__((constructor)) static void saLibraryLifeCycle_constructor(void)
 {
 	test_case_add(2, saLogWriteLogAsync_01,
@@ -529,4 +616,7 @@ __attribute__((constructor)) static void saLibraryLifeCycle_constructor(void)
 	test_case_add(
 	    2, saLogWriteLogAsync_invalid_handle,
 	    "saLogWriteLogAsync() with invalid logStreamHandle");
+	test_case_add(
+	    2, saLogWriteLogAsync_20,
+	    "saLogWriteLogAsync() batched records are written at finalize");
 }
@@ -25,6 +25,7 @@
 #include <limits.h>
 #include <saLog.h>
 #include <saClm.h>
+#include "base/ncsusrbuf.h"
 
 /* Message type enums */
 typedef enum {
@@ -41,6 +42,7 @@ typedef enum {
   LGSV_STREAM_OPEN_REQ = 2,
   LGSV_STREAM_CLOSE_REQ = 3,
   LGSV_WRITE_LOG_ASYNC_REQ = 4,
+  LGSV_WRITE_LOG_ASYNC_BATCH_REQ = 5,
   LGSV_API_MAX
 } lgsv_api_msg_type_t;
 
@@ -107,6 +109,16 @@ typedef struct {
   SaTimeT *logTimeStamp;
 } lgsv_write_log_async_req_t;
 
+/* A number of write requests from the same log client sent in one message.
+ * The requests are encoded by the agent when batched, @records holds the
+ * encoded requests in the order they were written. The log server decodes
+ * the batch into separate LGSV_WRITE_LOG_ASYNC_REQ messages.
+ */
+typedef struct {
+  uint32_t num_records;
+  USRBUF *records;
+} lgsv_write_log_async_batch_req_t;
+
 /* API param definition */
 typedef struct {
   lgsv_api_msg_type_t type;       /* api type */
@@ -116,6 +128,7 @@ typedef struct {
     lgsv_stream_open_req_t lstr_open_sync;
     lgsv_stream_close_req_t lstr_close;
     lgsv_write_log_async_req_t write_log_async;
+    lgsv_write_log_async_batch_req_t write_log_async_batch;
   } param;
 } lgsv_api_info_t;
 
@@ -0,0 +1,204 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+#include "log/logd/lgs_archive.h"
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <zlib.h>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "base/logtrace.h"
+
+const char kCompressedFileSuffix[] = ".gz";
+
+namespace {
+
+// See ioprio_set(2), there is no glibc wrapper
+const int kIoprioWhoProcess = 1;
+const int kIoprioClassIdle = 3;
+const int kIoprioClassShift = 13;
+
+const size_t kReadBufferSize = 64 * 1024;
+
+struct ArchiveQueue {
+  std::mutex mutex;
+  std::condition_variable cv;
+  // Log files waiting to be compressed, file path and compression
+  std::deque<std::pair<std::string, uint32_t>> jobs;
+};
+
+// Created with the thread and never deleted. The thread may be waiting on the
+// condition variable when the process exits and a condition variable with
+// waiters cannot be destroyed.
+ArchiveQueue* archive_queue = nullptr;
+std::mutex archive_start_mutex;
+
+// Compress `file_path` to `file_path`.gz. A temporary file is written and
+// renamed when complete, so a compressed file is never incomplete.
+// Return false if the log file is kept uncompressed.
+bool GzipFile(const std::string& file_path) {
+  const std::string gz_path = file_path + kCompressedFileSuffix;
+  const std::string tmp_path = gz_path + ".tmp";
+  struct stat statbuf;
+  bool rc = false;
+  gzFile gz_file = nullptr;
+  int out_fd = -1;
+
+  int in_fd = open(file_path.c_str(), O_RDONLY);
+  if (in_fd == -1) {
+    // Removed before it was compressed
+    if (errno != ENOENT) {
+      LOG_NO("Could not open %s - %s", file_path.c_str(), strerror(errno));
+    }
+    return false;
+  }
+
+  if (fstat(in_fd, &statbuf) == -1) {
+    LOG_NO("Could not stat %s - %s", file_path.c_str(), strerror(errno));
+    goto done;
+  }
+
+  out_fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                statbuf.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO));
+  if (out_fd == -1) {
+    LOG_NO("Could not create %s - %s", tmp_path.c_str(), strerror(errno));
+    goto done;
+  }
+  // Keep the log data group, see logDataGroupname
+  if (fchown(out_fd, -1, statbuf.st_gid) == -1) {
+    TRACE("fchown %s failed - %s", tmp_path.c_str(), strerror(errno));
+  }
+
+  gz_file = gzdopen(out_fd, "wb");
+  if (gz_file == nullptr) {
+    LOG_NO("gzdopen %s failed", tmp_path.c_str());
+    close(out_fd);
+    goto done_unlink;
+  }
+
+  {
+    char buffer[kReadBufferSize];
+    ssize_t bytes_read;
+    while ((bytes_read = read(in_fd, buffer, sizeof(buffer))) != 0) {
+      if (bytes_read == -1) {
+        if (errno == EINTR) continue;
+        LOG_NO("Could not read %s - %s", file_path.c_str(), strerror(errno));
+        gzclose(gz_file);
+        goto done_unlink;
+      }
+      if (gzwrite(gz_file, buffer, bytes_read) != bytes_read) {
+        LOG_NO("Could not write %s", tmp_path.c_str());
+        gzclose(gz_file);
+        goto done_unlink;
+      }
+    }
+  }
+
+  // Also closes out_fd
+  if (gzclose(gz_file) != Z_OK) {
+    LOG_NO("Could not close %s", tmp_path.c_str());
+    goto done_unlink;
+  }
+
+  if (rename(tmp_path.c_str(), gz_path.c_str()) == -1) {
+    LOG_NO("Could not rename %s - %s", tmp_path.c_str(), strerror(errno));
+    goto done_unlink;
+  }
+
+  if (unlink(file_path.c_str()) == -1) {
+    if (errno == ENOENT) {
+      // Removed as the oldest log file while being compressed
+      TRACE("%s removed while compressed", file_path.c_str());
+      (void)unlink(gz_path.c_str());
+    } else {
+      LOG_NO("Could not unlink %s - %s", file_path.c_str(), strerror(errno));
+    }
+  }
+  rc = true;
+  goto done;
+
+done_unlink:
+  (void)unlink(tmp_path.c_str());
+
+done:
+  close(in_fd);
+  return rc;
+}
+
+void ArchiveThread() {
+  TRACE("%s - is started", __FUNCTION__);
+  pid_t tid = syscall(SYS_gettid);
+  if (setpriority(PRIO_PROCESS, tid, 19) == -1) {
+    TRACE("setpriority failed - %s", strerror(errno));
+  }
+  if (syscall(SYS_ioprio_set, kIoprioWhoProcess, tid,
+              kIoprioClassIdle << kIoprioClassShift) == -1) {
+    TRACE("ioprio_set failed - %s", strerror(errno));
+  }
+
+  while (true) {
+    std::pair<std::string, uint32_t> job;
+    {
+      std::unique_lock<std::mutex> lock(archive_queue->mutex);
+      archive_queue->cv.wait(
+          lock, [] { return archive_queue->jobs.empty() == false; });
+      job = std::move(archive_queue->jobs.front());
+      archive_queue->jobs.pop_front();
+    }
+
+    TRACE("Compress %s", job.first.c_str());
+    switch (job.second) {
+      case Compression::kGzip:
+        (void)GzipFile(job.first);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+}  // namespace
+
+bool lgs_is_valid_compression(uint32_t compression) {
+  return (compression == Compression::kNone) ||
+         (compression == Compression::kGzip);
+}
+
+void lgs_archive_file(const std::string& file_path, uint32_t compression) {
+  if (compression == Compression::kNone) return;
+  TRACE("Queue %s for compression", file_path.c_str());
+
+  {
+    std::lock_guard<std::mutex> lock(archive_start_mutex);
+    if (archive_queue == nullptr) {
+      archive_queue = new ArchiveQueue{};
+      std::thread{ArchiveThread}.detach();
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(archive_queue->mutex);
+  archive_queue->jobs.emplace_back(file_path, compression);
+  archive_queue->cv.notify_one();
+}
@@ -0,0 +1,42 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+#ifndef LOG_LOGD_LGS_ARCHIVE_H_
+#define LOG_LOGD_LGS_ARCHIVE_H_
+
+#include <cstdint>
+#include <string>
+
+// Values of the saLogStreamFileCompression attribute
+namespace Compression {
+const uint32_t kNone = 0;
+const uint32_t kGzip = 1;
+};
+
+// Suffix added to the name of a compressed log file
+extern const char kCompressedFileSuffix[];
+
+bool lgs_is_valid_compression(uint32_t compression);
+
+// Compress a closed log file, e.g. a file just renamed when rotated.
+// The file is compressed by a background thread running with the lowest CPU
+// and I/O priority, so that the main thread and the file handling threads
+// never wait for compression. The compressed file gets the suffix ".gz" and
+// gets the same permissions and group as the log file, which is then removed.
+// If the log file is removed while being compressed (see
+// remove_oldest_log_files()), also the compressed file is removed.
+void lgs_archive_file(const std::string& file_path, uint32_t compression);
+
+#endif  // LOG_LOGD_LGS_ARCHIVE_H_
@@ -19,11 +19,13 @@
 
 #include "log/logd/lgs_dest.h"
 #include "log/logd/lgs_mbcsv_v8.h"
+#include "log/logd/lgs_mbcsv_v10.h"
 #include "log/logd/lgs_evt.h"
 #include "log/logd/lgs_evt.h"
 #include "log/logd/lgs_mbcsv.h"
 #include "log/logd/lgs_config.h"
 #include "base/time.h"
+#include "base/osaf_time.h"
 
 // The unique id of each queue element. Using this sequence id
 // to check if the standby is kept the queue in sync with the active.
@@ -42,6 +44,11 @@ static const unsigned kMaxQueueSize = 1000;
 static const unsigned kMaxTimeoutInSecond = 30;
 static const unsigned kMinTimeoutInSecond = 15;
 
+// Upper limits of a batch when batched writes are enabled. The bytes limit
+// bounds the memory the file handling thread allocates for one batch.
+static const size_t kMaxBatchSize = 1024;
+static const size_t kMaxBatchBytes = 1024 * 1024;
+
 static bool is_streaming_supported(const log_stream_t* stream) {
   return stream->name != SA_LOG_STREAM_ALARM &&
       stream->name != SA_LOG_STREAM_NOTIFICATION;
@@ -119,6 +126,8 @@ Cache::Data::Data(std::shared_ptr<WriteAsyncInfo> info,
     : param_{info}, log_record_{log_record}, size_{Size} {
   queue_at_ = base::TimespecToNanos(base::ReadMonotonicClock());
   seq_id_   = gl_seq_num++;
+  log_stream_t* stream = param_->stream();
+  record_id_ = (stream != nullptr) ? stream->logRecordId : 0;
 }
 
 Cache::Data::Data(const CkptPushAsync* data) {
@@ -130,6 +139,7 @@ Cache::Data::Data(const CkptPushAsync* data) {
   // put into the queue of each logsv instance.
   queue_at_   = base::TimespecToNanos(base::ReadMonotonicClock());
   seq_id_     = data->seq_id;
+  record_id_  = 0;
   log_record_ = strdup(data->log_record);
   size_       = strlen(log_record_);
 }
@@ -161,7 +171,7 @@ void Cache::Data::Streaming() const {
   data.networkname = lgs_get_networkname().c_str();
   data.msgid       = stream->rfc5424MsgId.c_str();
   data.isRtStream  = stream->isRtStream;
-  data.recordId    = stream->logRecordId;
+  data.recordId    = record_id_ != 0 ? record_id_ : stream->logRecordId;
   data.hostname    = param_->from_node;
   data.appname     = param_->svc_name;
   data.sev         = param_->severity;
@@ -370,15 +380,47 @@ int Cache::DecodeColdSync(NCS_UBAID* uba, lgsv_ckpt_header_t* header,
 void Cache::PeriodicCheck() {
   // NOTE: Avoid adding debug trace into this periodic check 'context',
   // otherwise the log may be get flooded when the file system is hung.
-  if (Empty() == true || is_active() == false) return;
+  if (is_active() == false) return;
+  SyncIdleBatches();
+  if (Empty() == true) return;
   PopOverdueData();
   FlushFrontElement();
 }
 
+Cache::Cache()
+    : pending_write_async_{},
+      batch_size_{1},
+      batch_sync_ms_{-1},
+      batched_records_{0},
+      batches_{} {
+  const char* val_str;
+  if ((val_str = getenv("LOGSV_WRITE_BATCH_SIZE")) != nullptr) {
+    uint64_t val = strtoull(val_str, nullptr, 0);
+    if (val > kMaxBatchSize) {
+      LOG_WA("LOGSV_WRITE_BATCH_SIZE %s is too large, using %zu", val_str,
+             kMaxBatchSize);
+      val = kMaxBatchSize;
+    }
+    if (val > 1) batch_size_ = val;
+  }
+  if ((val_str = getenv("LOGSV_WRITE_BATCH_SYNC_MS")) != nullptr) {
+    batch_sync_ms_ = strtoll(val_str, nullptr, 0);
+    if (batch_sync_ms_ < 0) batch_sync_ms_ = -1;
+  }
+  if (is_batching() == true) {
+    LOG_NO("Batched writes enabled, batch size: %zu, sync: %" PRId64 " ms",
+           batch_size_, batch_sync_ms_);
+  }
+}
+
 void Cache::Write(std::shared_ptr<Data> data) {
   TRACE_ENTER();
   // The resilience feature is disable. Fwd request to I/O thread right away.
   if (Capacity() == 0) {
+    if (is_batching() == true) {
+      AddToBatch(data);
+      return;
+    }
     int rc = data->Write();
     if (rc == -1 || rc == -2) {
       data->AckToClient(SA_AIS_ERR_TRY_AGAIN);
@@ -390,7 +432,12 @@ void Cache::Write(std::shared_ptr<Data> data) {
   }
 
   // The resilience feature is enabled. Caching the request if needed.
-  if (Empty() == true && is_iothread_ready() == true) {
+  if (Empty() == true &&
+      is_iothread_ready(data->param_->stream_id) == true) {
+    if (is_batching() == true) {
+      AddToBatch(data);
+      return;
+    }
     int rc = data->Write();
     // TODO(vu.m.nguyen): the error code is very unclear to know
     // what '-1' and '-2' really mean.
@@ -404,16 +451,169 @@ void Cache::Write(std::shared_ptr<Data> data) {
   }
 
   // Either having data in the queue or the io thread is not yet ready.
+  // Batched records came before this one so they must go first.
+  FlushBatches();
   Push(data);
   FlushFrontElement();
 }
 
+void Cache::AddToBatch(std::shared_ptr<Data> data) {
+  Batch& batch = batches_[data->param_->stream_id];
+  batch.records.push_back(data);
+  batch.bytes += data->size_;
+  batched_records_++;
+  if (batch.records.size() >= batch_size_ || batch.bytes >= kMaxBatchBytes) {
+    FlushBatch(data->param_->stream_id, &batch);
+  }
+}
+
+void Cache::FlushBatches() {
+  if (batched_records_ == 0) return;
+  TRACE_ENTER();
+  for (auto& e : batches_) {
+    FlushBatch(e.first, &e.second);
+  }
+}
+
+bool Cache::IsSyncRequired(Batch* batch) const {
+  if (batch_sync_ms_ < 0) return false;
+  if (batch_sync_ms_ == 0) return true;
+  timespec now = base::ReadMonotonicClock();
+  uint64_t now_ms = osaf_timespec_to_millis(&now);
+  if (now_ms - batch->last_sync_ms < static_cast<uint64_t>(batch_sync_ms_)) {
+    return false;
+  }
+  batch->last_sync_ms = now_ms;
+  return true;
+}
+
+int64_t Cache::NextBatchSyncMs() const {
+  if (batch_sync_ms_ <= 0) return -1;
+  int64_t next = -1;
+  timespec now = base::ReadMonotonicClock();
+  uint64_t now_ms = osaf_timespec_to_millis(&now);
+  for (const auto& e : batches_) {
+    if (e.second.sync_pending == false) continue;
+    uint64_t due_ms = e.second.last_sync_ms + batch_sync_ms_;
+    int64_t left = (due_ms > now_ms) ? static_cast<int64_t>(due_ms - now_ms)
+                                     : 0;
+    if (next == -1 || left < next) next = left;
+  }
+  return next;
+}
+
+void Cache::SyncIdleBatches() {
+  if (batch_sync_ms_ <= 0) return;
+  for (auto& e : batches_) {
+    Batch* batch = &e.second;
+    if (batch->sync_pending == false || IsSyncRequired(batch) == false) {
+      continue;
+    }
+    batch->sync_pending = false;
+    log_stream_t* stream = log_stream_get_by_id(e.first);
+    if (stream != nullptr) (void)log_stream_sync_h(stream);
+  }
+}
+
+void Cache::FlushBatch(uint32_t stream_id, Batch* batch) {
+  if (batch->records.empty() == true) return;
+  TRACE_ENTER2("stream id: %u, records: %zu", stream_id,
+               batch->records.size());
+
+  // Take over the records and reset the batch.
+  std::vector<std::shared_ptr<Data> > records;
+  records.swap(batch->records);
+  batched_records_ -= records.size();
+  batch->bytes = 0;
+
+  size_t written = 0;
+  std::vector<iovec> iov;
+  log_stream_t* stream = log_stream_get_by_id(stream_id);
+  if (stream != nullptr) {
+    iov.reserve(records.size());
+    for (const auto& e : records) {
+      iov.push_back({e->log_record_, static_cast<size_t>(e->size_)});
+    }
+    bool sync = IsSyncRequired(batch);
+    // The records are written one log file at a time, and those written to a
+    // file are synced with the standby before the next file is written, so
+    // that they are checkpointed with the stream state (current log file and
+    // its size) after them, as if they were written one by one.
+    int rc = 0;
+    while (rc == 0 && written < records.size()) {
+      size_t num = 0;
+      rc = log_stream_write_records_h(stream, &iov[written],
+                                      iov.size() - written, sync, &num);
+      if (num == 0) break;
+      PostWriteRecords(stream, records, iov, written, num);
+      written += num;
+    }
+    if (sync == true) {
+      batch->sync_pending = false;
+    } else if (written > 0 && batch_sync_ms_ > 0) {
+      batch->sync_pending = true;
+    }
+  } else {
+    LOG_NO("The stream id (%u) is closed. Drop %zu batched records",
+           stream_id, records.size());
+  }
+
+  for (size_t i = written; i < records.size(); i++) {
+    if (Capacity() == 0 || stream == nullptr) {
+      records[i]->AckToClient(SA_AIS_ERR_TRY_AGAIN);
+    } else {
+      Push(records[i]);
+    }
+  }
+}
+
 void Cache::PostWrite(std::shared_ptr<Data> data) {
   data->Streaming();
   data->SyncWriteWithStandby();
   data->AckToClient(SA_AIS_OK);
 }
 
+void Cache::PostWriteRecords(
+    log_stream_t* stream, const std::vector<std::shared_ptr<Data> >& records,
+    const std::vector<iovec>& iov, size_t first, size_t count) {
+  if (count > 1 && lgs_is_peer_v10() == true &&
+      HasConsecutiveRecordIds(records, first, count) == true) {
+    PostWriteBatch(stream, records, iov, first, count);
+    return;
+  }
+  for (size_t i = first; i < first + count; i++) {
+    PostWrite(records[i]);
+  }
+}
+
+bool Cache::HasConsecutiveRecordIds(
+    const std::vector<std::shared_ptr<Data> >& records, size_t first,
+    size_t count) const {
+  uint32_t first_id = records[first]->record_id_;
+  if (first_id == 0) return false;
+  for (size_t i = 1; i < count; i++) {
+    if (records[first + i]->record_id_ != static_cast<uint32_t>(first_id + i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Cache::PostWriteBatch(log_stream_t* stream,
+                           const std::vector<std::shared_ptr<Data> >& records,
+                           const std::vector<iovec>& iov, size_t first,
+                           size_t count) {
+  TRACE_ENTER2("stream id: %u, records: %zu", stream->streamId, count);
+  for (size_t i = first; i < first + count; i++) {
+    records[i]->Streaming();
+  }
+  lgs_ckpt_log_batch_async(stream, records[first]->record_id_, &iov[first],
+                           count);
+  for (size_t i = first; i < first + count; i++) {
+    records[i]->AckToClient(SA_AIS_OK);
+  }
+}
+
 void Cache::PopOverdueData() {
   if (Empty() == true || is_active() == false) return;
   auto data = Front();
@@ -423,8 +623,9 @@ void Cache::PopOverdueData() {
 }
 
 void Cache::FlushFrontElement() {
-  if (Empty() || !is_active() || !is_iothread_ready()) return;
+  if (Empty() || !is_active()) return;
   auto data = Front();
+  if (!is_iothread_ready(data->param_->stream_id)) return;
   if (data->is_valid() == false) {
     Pop(false);
     return;
@@ -469,12 +670,17 @@ void Cache::Pop(bool wstatus) {
 }
 
 int Cache::GeneratePollTimeout(timespec last) const {
-  if (Size() == 0 || is_active() == false) return -1;
+  if (is_active() == false) return -1;
+  int64_t sync_ms = NextBatchSyncMs();
+  if (Size() == 0) return static_cast<int>(sync_ms);
   struct timespec passed_time;
   struct timespec current = base::ReadMonotonicClock();
   osaf_timespec_subtract(&current, &last, &passed_time);
   auto passed_time_ms = osaf_timespec_to_millis(&passed_time);
-  return (passed_time_ms < kTimeoutMs) ? (kTimeoutMs - passed_time_ms) : 0;
+  int timeout =
+      (passed_time_ms < kTimeoutMs) ? (kTimeoutMs - passed_time_ms) : 0;
+  if (sync_ms >= 0 && sync_ms < timeout) timeout = static_cast<int>(sync_ms);
+  return timeout;
 }
 
 uint32_t Cache::Timeout() const {
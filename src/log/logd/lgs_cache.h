@@ -18,22 +18,20 @@
 #ifndef LOG_LOGD_LGS_CACHE_H_
 #define LOG_LOGD_LGS_CACHE_H_
 
-#include <atomic>
+#include <sys/uio.h>
 #include <cstring>
 #include <string>
 #include <sstream>
 #include <deque>
+#include <map>
 #include <memory>
+#include <vector>
 
 #include "log/logd/lgs.h"
+#include "log/logd/lgs_file.h"
 #include "log/logd/lgs_mbcsv_v8.h"
 #include "base/macros.h"
 
-// This atomic variable stores the readiness status of file hdle thread.
-// It is set to false when the request just arrives at the file handling thread
-// and is set to true when the thread is done with the file i/o request.
-extern std::atomic<bool> is_filehdl_thread_ready;
-
 //>
 // In order to improve resilience of OpenSAF LOG service when underlying
 // file system is unresponsive, a queue is introduced to hold the async
@@ -207,6 +205,9 @@ class Cache {
     uint64_t seq_id_;
     // Write async info which is comming from log client via write async request
     std::shared_ptr<WriteAsyncInfo> param_;
+    // The log record id given to the record when it was formatted. Zero if
+    // not known (data received from active at cold sync or push async).
+    uint32_t record_id_;
     // The full log record which already complied with stream format
     char* log_record_;
     // The record size
@@ -254,18 +255,39 @@ class Cache {
                      void* vdata, void** vckpt_rec,
                      size_t ckpt_rec_size) const;
 
+  // Batched writes are enabled by setting the environment variable
+  // LOGSV_WRITE_BATCH_SIZE to a value larger than one. Then Write() collects
+  // the records per stream, and FlushBatches() hands over each stream's
+  // records to the file handling thread in one request, followed by the same
+  // post-processing per record as for a single write. A stream's batch is
+  // also flushed when it reaches the maximum number of records or bytes.
+  // The optional LOGSV_WRITE_BATCH_SYNC_MS makes the file handling thread
+  // fdatasync() the log file after a batch, at most once per the given
+  // number of milliseconds per stream (0 = after every batch). A stream that
+  // goes idle is synced from the periodic check when the time has passed.
+  bool is_batching() const { return batch_size_ > 1; }
+  // The maximum number of records in one batch; one if batching is disabled.
+  size_t BatchSize() const { return batch_size_; }
+  // Write all collected records. Must be called before handling any
+  // request that is not a write async request, e.g. a stream close.
+  void FlushBatches();
+
  private:
   // Private constructor to not allow to instantiate this object directly,
   // but accessing this class method via a single instance via a static public
   // method `Cache::instance()`.
-  Cache() : pending_write_async_{} {}
+  Cache();
 
   // true if the queue is empty.
   bool Empty() const { return pending_write_async_.empty(); }
   // true if the queue is full - reaching the given capacity.
   bool Full() const { return Size() == Capacity(); }
-  // true if the file handling thread is ready.
-  bool is_iothread_ready() const { return is_filehdl_thread_ready; }
+  // true if the file handling thread of the stream is ready. The thread is
+  // not ready from when a request arrives at the thread until the thread is
+  // done with the file i/o request.
+  bool is_iothread_ready(uint32_t stream_id) const {
+    return lgs_file_is_ready(stream_id);
+  }
   // Flush the front element of the queue.
   void FlushFrontElement();
   // Remove the front if its data is no longer valid.
@@ -275,6 +297,53 @@ class Cache {
   // Jobs need to be done after writing record to file successfully.
   // 1) streaming to destination 2) sync with standby 3) ack to client
   void PostWrite(std::shared_ptr<Data> data);
+  // PostWrite() of the `count` records from `first` of a batch, written to
+  // the same log file. Uses PostWriteBatch() if possible.
+  void PostWriteRecords(log_stream_t* stream,
+                        const std::vector<std::shared_ptr<Data> >& records,
+                        const std::vector<iovec>& iov, size_t first,
+                        size_t count);
+  // Same as PostWrite() for the `count` records from `first` of a written
+  // batch, but the records are synced with a version 10 standby in one
+  // checkpoint (LGS_CKPT_LOG_WRITE_BATCH) instead of one checkpoint per
+  // record.
+  void PostWriteBatch(log_stream_t* stream,
+                      const std::vector<std::shared_ptr<Data> >& records,
+                      const std::vector<iovec>& iov, size_t first,
+                      size_t count);
+  // True if the `count` records from `first` have consecutive record ids.
+  // Needed by the batch checkpoint, which carries the id of the first record
+  // only.
+  bool HasConsecutiveRecordIds(
+      const std::vector<std::shared_ptr<Data> >& records, size_t first,
+      size_t count) const;
+
+  // Records collected for one stream when batched writes are enabled.
+  struct Batch {
+    std::vector<std::shared_ptr<Data> > records;
+    // Sum of the record sizes
+    size_t bytes;
+    // Monotonic time in ms of the last fdatasync of the stream's log file
+    uint64_t last_sync_ms;
+    // True if records have been written since the last fdatasync
+    bool sync_pending;
+    Batch() : records{}, bytes{0}, last_sync_ms{0}, sync_pending{false} {}
+  };
+
+  // Add the data to the batch of its stream. Flush if the batch is full.
+  void AddToBatch(std::shared_ptr<Data> data);
+  // Write the records of one batch, and then do the post processings for
+  // the written records. Records that could not be written are either
+  // pushed into the queue or acked with SA_AIS_ERR_TRY_AGAIN.
+  void FlushBatch(uint32_t stream_id, Batch* batch);
+  // True if the log file shall be synced after writing the batch.
+  bool IsSyncRequired(Batch* batch) const;
+  // Sync the log files of the streams that have had records written without
+  // a sync for LOGSV_WRITE_BATCH_SYNC_MS, so that the last batch before an
+  // idle period is synced as well. Called from PeriodicCheck().
+  void SyncIdleBatches();
+  // Time in ms until SyncIdleBatches() has a log file to sync, -1 if none.
+  int64_t NextBatchSyncMs() const;
 
  private:
   // Use std::deque<> rather std::queue because we need to access
@@ -285,6 +354,15 @@ class Cache {
   // in the queue too long). This queue is always kept in sync with standby.
   std::deque<std::shared_ptr<Data> > pending_write_async_;
 
+  // Max number of records in a batch. Batching is disabled if 1.
+  size_t batch_size_;
+  // Min time in ms between two syncs of a stream's log file. -1 = no sync.
+  int64_t batch_sync_ms_;
+  // Number of records in all batches.
+  size_t batched_records_;
+  // The batches indexed by stream id.
+  std::map<uint32_t, Batch> batches_;
+
   DELETE_COPY_AND_MOVE_OPERATORS(Cache);
 };
 
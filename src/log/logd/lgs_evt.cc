@@ -45,6 +45,7 @@ static uint32_t proc_finalize_msg(lgs_cb_t *, lgsv_lgs_evt_t *evt);
 static uint32_t proc_stream_open_msg(lgs_cb_t *, lgsv_lgs_evt_t *evt);
 static uint32_t proc_stream_close_msg(lgs_cb_t *, lgsv_lgs_evt_t *evt);
 static uint32_t proc_write_log_async_msg(lgs_cb_t *, lgsv_lgs_evt_t *evt);
+static uint32_t proc_write_log_async_batch_msg(lgs_cb_t *, lgsv_lgs_evt_t *evt);
 
 static const LGSV_LGS_EVT_HANDLER lgs_lgsv_top_level_evt_dispatch_tbl[] = {
     process_api_evt, proc_lga_updn_mds_msg, proc_lga_updn_mds_msg,
@@ -54,6 +55,7 @@ static const LGSV_LGS_EVT_HANDLER lgs_lgsv_top_level_evt_dispatch_tbl[] = {
 static const LGSV_LGS_LGA_API_MSG_HANDLER lgs_lga_api_msg_dispatcher[] = {
     proc_initialize_msg,   proc_finalize_msg,        proc_stream_open_msg,
     proc_stream_close_msg, proc_write_log_async_msg,
+    proc_write_log_async_batch_msg,
 };
 
 extern void rda_cb(uint32_t cb_hdl, PCS_RDA_CB_INFO *cb_info,
@@ -1357,8 +1359,8 @@ static uint32_t proc_write_log_async_msg(lgs_cb_t *cb, lgsv_lgs_evt_t *evt) {
     return NCSCC_RC_SUCCESS;
   }
 
-  if ((n = lgs_format_log_record(
-           param->logRecord, stream->logFileFormat, stream->maxLogFileSize,
+  if ((n = log_stream_format(stream).Format(
+           param->logRecord, stream->maxLogFileSize,
            stream->fixedLogRecordSize, buf_size, logOutputString,
            ++stream->logRecordId, node_name)) == 0) {
     AckToWriteAsync(param, evt->fr_dest, SA_AIS_ERR_INVALID_PARAM);
@@ -1376,6 +1378,21 @@ static uint32_t proc_write_log_async_msg(lgs_cb_t *cb, lgsv_lgs_evt_t *evt) {
   return NCSCC_RC_SUCCESS;
 }
 
+/**
+ * Handle a batch of write requests from a log agent.
+ * A batch is split into one event per write request when it is decoded, see
+ * dec_write_log_async_batch_msg(), so a batch shall never reach the mailbox.
+ *
+ * @param cb
+ * @param evt
+ * @return NCSCC_RC_FAILURE
+ */
+static uint32_t proc_write_log_async_batch_msg(lgs_cb_t *cb,
+                                               lgsv_lgs_evt_t *evt) {
+  LOG_ER("%s: Unexpected batch of write requests", __FUNCTION__);
+  return NCSCC_RC_FAILURE;
+}
+
 /****************************************************************************
  * Name          : process_api_evt
  *
@@ -1440,6 +1457,18 @@ done:
   return NCSCC_RC_SUCCESS;
 }
 
+/**
+ * Check if the event is a write async request from a log agent
+ *
+ * @param evt
+ * @return true if write async request
+ */
+static bool is_write_async_evt(const lgsv_lgs_evt_t *evt) {
+  return (evt->evt_type == LGSV_LGS_LGSV_MSG) &&
+         (evt->info.msg.type == LGSV_LGA_API_MSG) &&
+         (evt->info.msg.info.api_info.type == LGSV_WRITE_LOG_ASYNC_REQ);
+}
+
 /****************************************************************************
  * Name          : lgs_process_mbx
  *
@@ -1455,9 +1484,18 @@ done:
  *****************************************************************************/
 void lgs_process_mbx(SYSF_MBX *mbx) {
   lgsv_lgs_evt_t *msg;
+  Cache *cache = Cache::instance();
+
+  // If batched writes are enabled, handle up to one batch of events so that
+  // consecutive write requests can be written to file together.
+  for (size_t i = 0; i < cache->BatchSize(); i++) {
+    msg =
+        reinterpret_cast<lgsv_lgs_evt_t *>(m_NCS_IPC_NON_BLK_RECEIVE(mbx, msg));
+    if (msg == nullptr) break;
+
+    // Records of a batch must be written before e.g. closing its stream
+    if (is_write_async_evt(msg) == false) cache->FlushBatches();
 
-  msg = reinterpret_cast<lgsv_lgs_evt_t *>(m_NCS_IPC_NON_BLK_RECEIVE(mbx, msg));
-  if (msg != nullptr) {
     if (lgs_cb->ha_state == SA_AMF_HA_ACTIVE) {
       if (msg->evt_type <= LGSV_LGS_EVT_LGA_DOWN) {
         lgs_lgsv_top_level_evt_dispatch_tbl[msg->evt_type](msg);
@@ -1481,6 +1519,8 @@ void lgs_process_mbx(SYSF_MBX *mbx) {
 
     lgs_evt_destroy(msg);
   }
+
+  cache->FlushBatches();
 }
 
 //>
@@ -18,6 +18,9 @@
 #include "log/logd/lgs_file.h"
 
 #include <atomic>
+#include <algorithm>
+#include <deque>
+#include <vector>
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
@@ -36,13 +39,7 @@
 #include "log/logd/lgs_config.h"
 #include "log/logd/lgs_filehdl.h"
 
-// This global variable shows if the I/O thread is ready
-// or it is being stuck due to underlying file system status.
-std::atomic<bool> is_filehdl_thread_ready{true};
-
-pthread_mutex_t lgs_ftcom_mutex;  /* For locking communication */
-static pthread_cond_t request_cv; /* File thread waiting for request */
-static pthread_cond_t answer_cv;  /* API waiting for answer (timed) */
+pthread_mutex_t lgs_ftcom_mutex; /* For locking communication */
 
 struct file_communicate {
   bool request_f; /* True if pending request */
@@ -65,12 +62,80 @@ struct file_communicate {
         outdata_ptr(nullptr) {}
 };
 
-/* Used for synchronizing and transfer of data ownership between main thread
- * and file thread.
+/*
+ * List for saving file descriptors.
+ * A file descriptor is added to the list if a close request fails because
+ * the file thread is busy. If the thread is busy the close function is never
+ * called. A new attempt to close is made the next time the file API is used.
+ */
+typedef struct fd_list {
+  struct fd_list *fd_next_p;
+  int32_t fd;
+} fd_list_t;
+
+/* A request queued by log_file_api_async() */
+struct file_async_request {
+  lgsf_treq_t request_code; /* Request code from API */
+  uint32_t stream_id;       /* Stream the request is done for */
+  void *indata_ptr;         /* In-parameters for handlers */
+};
+
+/* A file handling thread.
+ * All file I/O for a stream is done by the same file thread, see
+ * LgsFileAffinity. The lgs_ftcom_mutex is common for all file threads.
  */
-static struct file_communicate lgs_com_data;
+struct file_worker {
+  pthread_t thread_id;
+  pthread_cond_t request_cv; /* File thread waiting for request */
+  pthread_cond_t answer_cv;  /* API waiting for answer (timed) */
+
+  /* Used for synchronizing and transfer of data ownership between main
+   * thread and file thread.
+   */
+  struct file_communicate com_data;
 
-static pthread_t file_thread_id;
+  /* Shows if the file thread is ready or it is being stuck due to
+   * underlying file system status.
+   */
+  std::atomic<bool> is_ready;
+
+  /* File descriptors to close when this file thread is no longer busy.
+   * A file descriptor must be closed by the file thread that uses it.
+   */
+  fd_list_t *fd_first_p;
+  fd_list_t *fd_last_p;
+
+  /* Requests queued by log_file_api_async(), handled in order when there is
+   * no request from log_file_api(). async_running is true while a queued
+   * request is handled.
+   */
+  std::deque<file_async_request> async_requests;
+  bool async_running;
+
+  /* Streams for which a queued request has failed, see
+   * lgs_file_async_failed()
+   */
+  std::vector<uint32_t> async_failed_streams;
+
+  file_worker()
+      : thread_id(0),
+        com_data(),
+        is_ready(true),
+        fd_first_p(nullptr),
+        fd_last_p(nullptr),
+        async_running(false) {}
+};
+
+/* Max number of file threads, see LOGSV_FILE_THREADS in logd.conf */
+static const uint32_t kMaxFileWorkers = 16;
+
+static file_worker *file_workers = nullptr;
+static uint32_t num_file_workers = 1;
+
+/* The file thread used by log_file_api(). Selected by LgsFileAffinity.
+ * Only used in the main thread.
+ */
+static uint32_t current_worker = 0;
 
 /*****************************************************************************
  * Utility functions
@@ -93,21 +158,102 @@ static void get_timeout_time(struct timespec *timeout_time,
   osaf_timespec_add(&start_time, &add_time, timeout_time);
 }
 
+/**
+ * Check if a file thread has requests from log_file_api_async() not yet done.
+ * lgs_ftcom_mutex must be locked.
+ *
+ * @param worker[in]
+ * @return true if there are such requests
+ */
+static bool async_pending(const file_worker *worker) {
+  return (worker->async_requests.empty() == false) ||
+         (worker->async_running == true);
+}
+
 /*****************************************************************************
  * Thread handling
  *****************************************************************************/
 
+/**
+ * Invoke the handler function of a request.
+ * Called in a file thread with lgs_ftcom_mutex locked.
+ *
+ * @return The return code of the handler
+ */
+static int file_request_hdl(lgsf_treq_t request_code, void *indata_ptr,
+                            void *outdata_ptr, size_t outdata_size,
+                            bool *timeout_f) {
+  int hndl_rc = 0;
+
+  switch (request_code) {
+    case LGSF_FILEOPEN:
+      hndl_rc = fileopen_hdl(indata_ptr, outdata_ptr, outdata_size, timeout_f);
+      break;
+    case LGSF_FILECLOSE:
+      hndl_rc = fileclose_hdl(indata_ptr, outdata_ptr, outdata_size);
+      break;
+    case LGSF_DELETE_FILE:
+      hndl_rc = delete_file_hdl(indata_ptr, outdata_ptr, outdata_size);
+      break;
+    case LGSF_GET_LOG_FILES:
+      hndl_rc = get_log_files_hdl(indata_ptr, outdata_ptr, outdata_size);
+      break;
+    case LGSF_MAKELOGDIR:
+      hndl_rc = make_log_dir_hdl(indata_ptr, outdata_ptr, outdata_size);
+      break;
+    case LGSF_WRITELOGREC:
+      hndl_rc = write_log_record_hdl(indata_ptr, outdata_ptr, outdata_size,
+                                     timeout_f);
+      break;
+    case LGSF_WRITELOGRECS:
+      hndl_rc = write_log_records_hdl(indata_ptr, outdata_ptr, outdata_size,
+                                      timeout_f);
+      break;
+    case LGSF_CREATECFGFILE:
+      hndl_rc = create_config_file_hdl(indata_ptr, outdata_ptr, outdata_size);
+      break;
+    case LGSF_RENAME_FILE:
+      hndl_rc = rename_file_hdl(indata_ptr, outdata_ptr, outdata_size);
+      break;
+    case LGSF_CHECKPATH:
+      hndl_rc = check_path_exists_hdl(indata_ptr, outdata_ptr, outdata_size);
+      break;
+    case LGSF_CHECKDIR:
+      hndl_rc =
+          path_is_writeable_dir_hdl(indata_ptr, outdata_ptr, outdata_size);
+      break;
+    case LGSF_OWN_LOGFILES:
+      hndl_rc =
+          own_log_files_by_group_hdl(indata_ptr, outdata_ptr, outdata_size);
+      break;
+    case LGSF_GET_FILE_PAR:
+      hndl_rc = lgs_get_file_params_hdl(indata_ptr, outdata_ptr, outdata_size);
+      break;
+    case LGSF_ARCHIVE_FILE:
+      hndl_rc = archive_file_hdl(indata_ptr, outdata_ptr, outdata_size);
+      break;
+    default:
+      break;
+  }
+
+  return hndl_rc;
+}
+
 /**
  * Thread:
  * Handle functions using file I/O
  * - Wait for request (cond_wait
  * - Handle request
  * - Return result
+ * A request from log_file_api() is handled before the requests queued by
+ * log_file_api_async(), which are handled in order and have no result.
  *
- * @param _init_params[in]
+ * @param worker_in[in] The file_worker of this thread
  * @return void
  */
-static void *file_hndl_thread(void *noparam) {
+static void *file_hndl_thread(void *worker_in) {
+  file_worker *worker = static_cast<file_worker *>(worker_in);
+  struct file_communicate &lgs_com_data = worker->com_data;
   int rc = 0;
   int hndl_rc = 0;
   int dummy;
@@ -119,12 +265,7 @@ static void *file_hndl_thread(void *noparam) {
 
   osaf_mutex_lock_ordie(&lgs_ftcom_mutex); /* LOCK */
   while (1) {
-    /* Wait for request */
-    if (lgs_com_data.request_f == false) {
-      rc = pthread_cond_wait(&request_cv,
-                             &lgs_ftcom_mutex); /* -> UNLOCK -> LOCK */
-      if (rc != 0) osaf_abort(rc);
-    } else {
+    if (lgs_com_data.request_f == true) {
       /* Handle the request.
        * A handler is handling file operations that may 'hang'. Therefore
        * the mutex cannot be locked since that may cause the main thread
@@ -137,132 +278,115 @@ static void *file_hndl_thread(void *noparam) {
        * file I/O functions. Mutex is locked when _hdl function returns.
        */
 
-      is_filehdl_thread_ready = false;
-      /* Invoke requested handler function */
-      switch (lgs_com_data.request_code) {
-        case LGSF_FILEOPEN:
-          hndl_rc =
-              fileopen_hdl(lgs_com_data.indata_ptr, lgs_com_data.outdata_ptr,
-                           lgs_com_data.outdata_size, &lgs_com_data.timeout_f);
-          break;
-        case LGSF_FILECLOSE:
-          hndl_rc =
-              fileclose_hdl(lgs_com_data.indata_ptr, lgs_com_data.outdata_ptr,
-                            lgs_com_data.outdata_size);
-          break;
-        case LGSF_DELETE_FILE:
-          hndl_rc =
-              delete_file_hdl(lgs_com_data.indata_ptr, lgs_com_data.outdata_ptr,
-                              lgs_com_data.outdata_size);
-          break;
-        case LGSF_GET_NUM_LOGFILES:
-          hndl_rc = get_number_of_log_files_hdl(lgs_com_data.indata_ptr,
-                                                lgs_com_data.outdata_ptr,
-                                                lgs_com_data.outdata_size);
-          break;
-        case LGSF_GET_NUM_CFGFILES:
-          hndl_rc = get_number_of_cfg_files_hdl(lgs_com_data.indata_ptr,
-                                                lgs_com_data.outdata_ptr,
-                                                lgs_com_data.outdata_size);
-          break;
-        case LGSF_MAKELOGDIR:
-          hndl_rc = make_log_dir_hdl(lgs_com_data.indata_ptr,
-                                     lgs_com_data.outdata_ptr,
-                                     lgs_com_data.outdata_size);
-          break;
-        case LGSF_WRITELOGREC:
-          hndl_rc = write_log_record_hdl(
-              lgs_com_data.indata_ptr, lgs_com_data.outdata_ptr,
-              lgs_com_data.outdata_size, &lgs_com_data.timeout_f);
-          break;
-        case LGSF_CREATECFGFILE:
-          hndl_rc = create_config_file_hdl(lgs_com_data.indata_ptr,
-                                           lgs_com_data.outdata_ptr,
-                                           lgs_com_data.outdata_size);
-          break;
-        case LGSF_RENAME_FILE:
-          hndl_rc =
-              rename_file_hdl(lgs_com_data.indata_ptr, lgs_com_data.outdata_ptr,
-                              lgs_com_data.outdata_size);
-          break;
-        case LGSF_CHECKPATH:
-          hndl_rc = check_path_exists_hdl(lgs_com_data.indata_ptr,
-                                          lgs_com_data.outdata_ptr,
-                                          lgs_com_data.outdata_size);
-          break;
-        case LGSF_CHECKDIR:
-          hndl_rc = path_is_writeable_dir_hdl(lgs_com_data.indata_ptr,
-                                              lgs_com_data.outdata_ptr,
-                                              lgs_com_data.outdata_size);
-          break;
-        case LGSF_OWN_LOGFILES:
-          hndl_rc = own_log_files_by_group_hdl(lgs_com_data.indata_ptr,
-                                               lgs_com_data.outdata_ptr,
-                                               lgs_com_data.outdata_size);
-          break;
-        case LGSF_GET_FILE_PAR:
-          hndl_rc = lgs_get_file_params_hdl(lgs_com_data.indata_ptr,
-                                            lgs_com_data.outdata_ptr,
-                                            lgs_com_data.outdata_size);
-          break;
-        default:
-          break;
-      }
+      worker->is_ready = false;
+      hndl_rc = file_request_hdl(
+          lgs_com_data.request_code, lgs_com_data.indata_ptr,
+          lgs_com_data.outdata_ptr, lgs_com_data.outdata_size,
+          &lgs_com_data.timeout_f);
 
       /* Handle answer flag and return data
        * Note: This must be done after handler is done (handler may hang)
        */
       lgs_com_data.request_f = false; /* Prepare to take a new request */
       lgs_com_data.request_code = LGSF_NOREQ;
-      is_filehdl_thread_ready = true;
+      worker->is_ready = true;
       /* The following cannot be done if the API has timed out */
       if (lgs_com_data.timeout_f == false) {
         lgs_com_data.answer_f = true;
         lgs_com_data.return_code = hndl_rc;
 
         /* Signal the API function that we are done */
-        rc = pthread_cond_signal(&answer_cv);
+        rc = pthread_cond_signal(&worker->answer_cv);
+        if (rc != 0) osaf_abort(rc);
+      }
+    } else if (worker->async_requests.empty() == false) {
+      /* Handle the oldest queued request. Only one at a time, so that a
+       * request from log_file_api() is handled before the next one.
+       * Nobody waits for the answer, so the timeout flag is never set.
+       */
+      file_async_request request = worker->async_requests.front();
+      worker->async_requests.pop_front();
+      bool timeout_f = false;
+
+      worker->async_running = true;
+      worker->is_ready = false;
+      hndl_rc = file_request_hdl(request.request_code, request.indata_ptr,
+                                 nullptr, 0, &timeout_f);
+      worker->is_ready = true;
+      worker->async_running = false;
+
+      if (hndl_rc == -1) {
+        worker->async_failed_streams.push_back(request.stream_id);
+      }
+      free(request.indata_ptr);
+
+      /* Signal lgs_file_async_wait() when all queued requests are done */
+      if (worker->async_requests.empty() == true) {
+        rc = pthread_cond_signal(&worker->answer_cv);
         if (rc != 0) osaf_abort(rc);
       }
+    } else {
+      /* Wait for request */
+      rc = pthread_cond_wait(&worker->request_cv,
+                             &lgs_ftcom_mutex); /* -> UNLOCK -> LOCK */
+      if (rc != 0) osaf_abort(rc);
     }
   } /* End while(1) */
 }
 
 /**
- * Start the file handling thread.
+ * Start the file handling threads.
  *
  * @param
  */
 static int start_file_thread() {
   int rc = 0;
-  int tbd_inpar = 1;
+  const char *val_str;
 
   TRACE_ENTER();
 
+  if ((val_str = getenv("LOGSV_FILE_THREADS")) != nullptr) {
+    uint32_t val = strtoul(val_str, nullptr, 0);
+    if ((val == 0) || (val > kMaxFileWorkers)) {
+      LOG_WA("Invalid LOGSV_FILE_THREADS %s, using %u", val_str,
+             num_file_workers);
+    } else {
+      num_file_workers = val;
+    }
+  }
+  if (num_file_workers > 1) {
+    LOG_NO("Number of file handling threads: %u", num_file_workers);
+  }
+
   /* Init thread handling */
   rc = pthread_mutex_init(&lgs_ftcom_mutex, NULL);
   if (rc != 0) {
     LOG_ER("pthread_mutex_init fail %s", strerror(errno));
     goto done;
   }
-  rc = pthread_cond_init(&request_cv, NULL);
-  if (rc != 0) {
-    LOG_ER("pthread_cond_init fail %s", strerror(errno));
-    goto done;
-  }
-  rc = pthread_cond_init(&answer_cv, NULL);
-  if (rc != 0) {
-    LOG_ER("pthread_cond_init fail %s", strerror(errno));
-    goto done;
-  }
 
-  /* Create thread.
-   */
-  rc = pthread_create(&file_thread_id, NULL, file_hndl_thread,
-                      &tbd_inpar);
-  if (rc != 0) {
-    LOG_ER("pthread_create fail %s", strerror(errno));
-    goto done;
+  file_workers = new file_worker[num_file_workers];
+  for (uint32_t i = 0; i < num_file_workers; i++) {
+    file_worker *worker = &file_workers[i];
+
+    rc = pthread_cond_init(&worker->request_cv, NULL);
+    if (rc != 0) {
+      LOG_ER("pthread_cond_init fail %s", strerror(errno));
+      goto done;
+    }
+    rc = pthread_cond_init(&worker->answer_cv, NULL);
+    if (rc != 0) {
+      LOG_ER("pthread_cond_init fail %s", strerror(errno));
+      goto done;
+    }
+
+    /* Create thread.
+     */
+    rc = pthread_create(&worker->thread_id, NULL, file_hndl_thread, worker);
+    if (rc != 0) {
+      LOG_ER("pthread_create fail %s", strerror(errno));
+      goto done;
+    }
   }
 
 done:
@@ -286,26 +410,36 @@ uint32_t lgs_file_init() {
   return rc;
 }
 
-/*
- * List for saving file descriptors.
- * A file descriptor is added to the list if a close request fails because
- * the file thread is busy. If the thread is busy the close function is never
- * called. A new attempt to close is made the next time the file API is used.
+/**
+ * Select the file thread handling the requests for a stream
+ *
+ * @param stream_id
  */
+LgsFileAffinity::LgsFileAffinity(uint32_t stream_id)
+    : saved_worker_(current_worker) {
+  current_worker = stream_id % num_file_workers;
+}
 
-typedef struct fd_list {
-  struct fd_list *fd_next_p;
-  int32_t fd;
-} fd_list_t;
+LgsFileAffinity::~LgsFileAffinity() { current_worker = saved_worker_; }
 
-static fd_list_t *fd_first_p = nullptr;
-static fd_list_t *fd_last_p = nullptr;
+/**
+ * Check if the file thread handling the requests for a stream is ready, i.e.
+ * not busy with a request.
+ *
+ * @param stream_id
+ * @return true if ready
+ */
+bool lgs_file_is_ready(uint32_t stream_id) {
+  if (file_workers == nullptr) return true;
+  return file_workers[stream_id % num_file_workers].is_ready;
+}
 
 /**
- * Add stream file descriptor to list
+ * Add stream file descriptor to the list of the current file thread
  * @param fd
  */
 void lgs_fd_list_add(int32_t fd) {
+  file_worker *worker = &file_workers[current_worker];
   fd_list_t *fd_new_p;
 
   TRACE_ENTER2("fd = %d", fd);
@@ -313,13 +447,13 @@ void lgs_fd_list_add(int32_t fd) {
   fd_new_p = static_cast<fd_list_t *>(malloc(sizeof(fd_list_t)));
   osafassert(fd_new_p);
 
-  if (fd_first_p == nullptr) {
+  if (worker->fd_first_p == nullptr) {
     /* First in list */
-    fd_first_p = fd_new_p;
-    fd_last_p = fd_new_p;
+    worker->fd_first_p = fd_new_p;
+    worker->fd_last_p = fd_new_p;
   } else {
-    fd_last_p->fd_next_p = fd_new_p;
-    fd_last_p = fd_new_p;
+    worker->fd_last_p->fd_next_p = fd_new_p;
+    worker->fd_last_p = fd_new_p;
   }
 
   fd_new_p->fd = fd;
@@ -329,24 +463,25 @@ void lgs_fd_list_add(int32_t fd) {
 }
 
 /**
- * Get and remove file descriptor from list
+ * Get and remove file descriptor from the list of the current file thread
  * @return fd If list empty return -1
  */
 int32_t lgs_fd_list_get() {
+  file_worker *worker = &file_workers[current_worker];
   int32_t r_fp;
   fd_list_t *fd_rem_p;
 
-  if (fd_first_p == nullptr) {
+  if (worker->fd_first_p == nullptr) {
     /* List empty */
     return -1;
   }
 
-  r_fp = fd_first_p->fd; /* fd to return */
-  fd_rem_p = fd_first_p;
-  fd_first_p = fd_rem_p->fd_next_p;
-  if (fd_first_p == nullptr) {
+  r_fp = worker->fd_first_p->fd; /* fd to return */
+  fd_rem_p = worker->fd_first_p;
+  worker->fd_first_p = fd_rem_p->fd_next_p;
+  if (worker->fd_first_p == nullptr) {
     /* List is empty */
-    fd_last_p = nullptr;
+    worker->fd_last_p = nullptr;
   }
 
   free(fd_rem_p);
@@ -357,11 +492,14 @@ int32_t lgs_fd_list_get() {
 /**
  * Generic file API handler
  * Handles everything that is generic thread handling for the APIs
+ * The request is handled by the file thread selected by LgsFileAffinity
  *
  * @param apipar_in
  * @return A lgsf return code
  */
 lgsf_retcode_t log_file_api(lgsf_apipar_t *apipar_in) {
+  file_worker *worker = &file_workers[current_worker];
+  struct file_communicate &lgs_com_data = worker->com_data;
   lgsf_retcode_t api_rc = LGSF_SUCESS;
   int rc = 0;
   struct timespec timeout_time;
@@ -437,7 +575,7 @@ lgsf_retcode_t log_file_api(lgsf_apipar_t *apipar_in) {
   lgs_com_data.timeout_f = false;
 
   /* Wake up the thread */
-  rc = pthread_cond_signal(&request_cv);
+  rc = pthread_cond_signal(&worker->request_cv);
   if (rc != 0) osaf_abort(rc);
 
   /* Wait for an answer */
@@ -446,7 +584,7 @@ lgsf_retcode_t log_file_api(lgsf_apipar_t *apipar_in) {
   get_timeout_time(&timeout_time, max_waittime_ms);
 
   while (lgs_com_data.answer_f == false) {
-    rc = pthread_cond_timedwait(&answer_cv, &lgs_ftcom_mutex,
+    rc = pthread_cond_timedwait(&worker->answer_cv, &lgs_ftcom_mutex,
                                 &timeout_time); /* -> UNLOCK -> LOCK */
     if ((rc == ETIMEDOUT) && (lgs_com_data.answer_f == false)) {
       TRACE("Timed out before answer");
@@ -484,6 +622,103 @@ api_exit:
   return api_rc;
 }
 
+/**
+ * Queue a file request to the file thread of a stream without waiting for
+ * it. The queued requests of a thread are handled in order, after any
+ * request from log_file_api(). The request cannot have out data, and the
+ * return code of the handler is not returned, see lgs_file_async_failed().
+ *
+ * @param stream_id
+ * @param apipar_in
+ * @return LGSF_SUCESS or LGSF_FAIL if the request could not be queued
+ */
+lgsf_retcode_t log_file_api_async(uint32_t stream_id,
+                                  lgsf_apipar_t *apipar_in) {
+  file_worker *worker = &file_workers[stream_id % num_file_workers];
+  file_async_request request;
+  int rc = 0;
+
+  osafassert(apipar_in->data_out_size == 0);
+
+  request.request_code = apipar_in->req_code_in;
+  request.stream_id = stream_id;
+  request.indata_ptr = nullptr;
+  if (apipar_in->data_in_size != 0) {
+    request.indata_ptr = malloc(apipar_in->data_in_size);
+    if (request.indata_ptr == nullptr) {
+      LOG_ER("%s Could not allocate memory for in data", __FUNCTION__);
+      return LGSF_FAIL;
+    }
+    memcpy(request.indata_ptr, apipar_in->data_in, apipar_in->data_in_size);
+  }
+
+  osaf_mutex_lock_ordie(&lgs_ftcom_mutex); /* LOCK */
+  worker->async_requests.push_back(request);
+  /* Wake up the thread */
+  rc = pthread_cond_signal(&worker->request_cv);
+  if (rc != 0) osaf_abort(rc);
+  osaf_mutex_unlock_ordie(&lgs_ftcom_mutex); /* UNLOCK */
+
+  return LGSF_SUCESS;
+}
+
+/**
+ * Wait until the file thread of a stream has handled the requests queued by
+ * log_file_api_async(). Used when the next request depends on them, e.g.
+ * creates a file with the name of a file that is renamed. Waits at most
+ * the file I/O timeout, like log_file_api().
+ *
+ * @param stream_id
+ * @return LGSF_SUCESS or LGSF_TIMEOUT
+ */
+lgsf_retcode_t lgs_file_async_wait(uint32_t stream_id) {
+  file_worker *worker = &file_workers[stream_id % num_file_workers];
+  lgsf_retcode_t api_rc = LGSF_SUCESS;
+  struct timespec timeout_time;
+  int rc = 0;
+
+  const uint32_t max_waittime_ms =
+      *static_cast<const SaUint32T *>(lgs_cfg_get(LGS_IMM_FILE_IO_TIMEOUT));
+  get_timeout_time(&timeout_time, max_waittime_ms);
+
+  osaf_mutex_lock_ordie(&lgs_ftcom_mutex); /* LOCK */
+  while (async_pending(worker) == true) {
+    rc = pthread_cond_timedwait(&worker->answer_cv, &lgs_ftcom_mutex,
+                                &timeout_time); /* -> UNLOCK -> LOCK */
+    if ((rc == ETIMEDOUT) && (async_pending(worker) == true)) {
+      TRACE("Timed out waiting for queued requests");
+      api_rc = LGSF_TIMEOUT;
+      break;
+    } else if ((rc != 0) && (rc != ETIMEDOUT)) {
+      LOG_ER("pthread wait Failed - %s", strerror(rc));
+      osaf_abort(rc);
+    }
+  }
+  osaf_mutex_unlock_ordie(&lgs_ftcom_mutex); /* UNLOCK */
+
+  return api_rc;
+}
+
+/**
+ * Check if a request queued by log_file_api_async() for a stream has failed
+ * since the last check.
+ *
+ * @param stream_id
+ * @return true if a request has failed
+ */
+bool lgs_file_async_failed(uint32_t stream_id) {
+  file_worker *worker = &file_workers[stream_id % num_file_workers];
+  std::vector<uint32_t> &failed = worker->async_failed_streams;
+
+  osaf_mutex_lock_ordie(&lgs_ftcom_mutex); /* LOCK */
+  auto it = std::remove(failed.begin(), failed.end(), stream_id);
+  const bool has_failed = (it != failed.end());
+  failed.erase(it, failed.end());
+  osaf_mutex_unlock_ordie(&lgs_ftcom_mutex); /* UNLOCK */
+
+  return has_failed;
+}
+
 /**
  * Return lgsf return code as a string
  * @param rc
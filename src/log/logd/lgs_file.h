@@ -35,7 +35,6 @@ typedef enum {
   LGSF_FILEOPEN,
   LGSF_FILECLOSE,
   LGSF_DELETE_FILE,
-  LGSF_GET_NUM_LOGFILES,
   LGSF_MAKELOGDIR,
   LGSF_WRITELOGREC,
   LGSF_CREATECFGFILE,
@@ -44,7 +43,9 @@ typedef enum {
   LGSF_CHECKDIR,
   LGSF_OWN_LOGFILES,
   LGSF_GET_FILE_PAR,
-  LGSF_GET_NUM_CFGFILES,
+  LGSF_WRITELOGRECS,
+  LGSF_GET_LOG_FILES,
+  LGSF_ARCHIVE_FILE,
   LGSF_NOREQ
 } lgsf_treq_t;
 
@@ -58,9 +59,41 @@ typedef struct {
   void *data_out;          /* Buffer containing out data from the handler */
 } lgsf_apipar_t;
 
+/* File requests are handled by one or more file handling threads, see
+ * LOGSV_FILE_THREADS in logd.conf. All requests for the files of a stream
+ * must be done by the same thread, so the requests for a stream are kept in
+ * order and a thread hanging on one stream's file system does not stop the
+ * streams handled by the other threads.
+ *
+ * log_file_api() waits for the answer of a request. log_file_api_async()
+ * queues a request that has no out data, e.g. renaming or deleting a file
+ * when the log files are rotated, and returns without waiting. A thread
+ * handles the requests waited for before the queued ones not yet started, so
+ * the main thread waits at most for one queued request, and the queued
+ * requests of one stream do not delay the streams of the other threads.
+ *
+ * An object of this class selects the thread used by log_file_api() while
+ * the object is in scope. Without it, the first thread is used.
+ */
+class LgsFileAffinity {
+ public:
+  explicit LgsFileAffinity(uint32_t stream_id);
+  ~LgsFileAffinity();
+
+ private:
+  uint32_t saved_worker_;
+
+  LgsFileAffinity(const LgsFileAffinity &) = delete;
+  LgsFileAffinity &operator=(const LgsFileAffinity &) = delete;
+};
+
 char *lgsf_retcode_str(lgsf_retcode_t rc);
 uint32_t lgs_file_init();
 lgsf_retcode_t log_file_api(lgsf_apipar_t *param_in);
+lgsf_retcode_t log_file_api_async(uint32_t stream_id, lgsf_apipar_t *param_in);
+lgsf_retcode_t lgs_file_async_wait(uint32_t stream_id);
+bool lgs_file_async_failed(uint32_t stream_id);
+bool lgs_file_is_ready(uint32_t stream_id);
 void lgs_fd_list_add(int32_t fd);
 int32_t lgs_fd_list_get();
 
@@ -25,11 +25,15 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <algorithm>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include "base/logtrace.h"
 #include "base/osaf_time.h"
 #include "log/logd/lgs.h"
+#include "log/logd/lgs_archive.h"
 
 #ifdef SIMULATE_NFS_UNRESPONSE
 #include "log/logd/lgs_cache.h"
@@ -145,6 +149,26 @@ int rename_file_hdl(void *indata, void *outdata, size_t max_outsize) {
   return rc;
 }
 
+/**
+ * Queue a rotated log file for compression, see lgs_archive_file().
+ * Requested after the request renaming the file, so the file is compressed
+ * once it has got its final name.
+ *
+ * @param indata[in] afh_t, file_path string
+ * @param outdata[out] Not used
+ * @param max_outsize[in] Must be 0
+ * @return 0
+ */
+int archive_file_hdl(void *indata, void *outdata, size_t max_outsize) {
+  afh_t *params_in = static_cast<afh_t *>(indata);
+  char *file_path = static_cast<char *>(indata) + sizeof(afh_t);
+
+  TRACE_ENTER();
+  lgs_archive_file(file_path, params_in->compression);
+  TRACE_LEAVE();
+  return 0;
+}
+
 /**
  * Create a configuration file.
  * Creates the file, write its content and close the file
@@ -314,6 +338,101 @@ done:
   return rc;
 }
 
+/**
+ * Write a batch of log records to file using one write and, if requested,
+ * one fdatasync for the whole batch.
+ * The file must be opened for append
+ *
+ * @param indata[in] Type wlrsh_t
+ * @param outdata[out], int errno, 0 if no error
+ * @param max_outsize[in], always sizeof(int)
+ * @return (-1) on error or number of written bytes
+ */
+int write_log_records_hdl(void *indata, void *outdata, size_t max_outsize,
+                          bool *timeout_f) {
+  int rc = 0;
+  size_t bytes_written = 0;
+  off_t file_length = 0;
+  wlrsh_t *params_in = static_cast<wlrsh_t *>(indata);
+  int *errno_out_p = static_cast<int *>(outdata);
+
+  TRACE_ENTER2("num_records = %zu", params_in->num_records);
+  *errno_out_p = 0;
+
+  // Gather the records into a tmp storage that is owned by this function.
+  // Same reason as in write_log_record_hdl(): the records belong to the main
+  // thread that may free them as soon as the API has timed out.
+  size_t data_size = params_in->total_size;
+  char *data = nullptr;
+  if (data_size != 0) data = static_cast<char *>(malloc(data_size));
+  if (data == nullptr && data_size != 0) {
+    LOG_ER("%s - Could not allocate %zu bytes", __FUNCTION__, data_size);
+    *errno_out_p = ENOMEM;
+    TRACE_LEAVE();
+    return -1;
+  }
+  for (size_t i = 0, offset = 0; i < params_in->num_records; i++) {
+    memcpy(&data[offset], params_in->records[i].iov_base,
+           params_in->records[i].iov_len);
+    offset += params_in->records[i].iov_len;
+  }
+
+  osaf_mutex_unlock_ordie(&lgs_ftcom_mutex); /* UNLOCK  Critical section */
+
+  while (bytes_written < data_size) {
+    rc = write(params_in->fd, &data[bytes_written], data_size - bytes_written);
+    if (rc == -1) {
+      if (errno == EINTR) continue;
+
+      LOG_ER("%s - write FAILED: %s", __FUNCTION__, strerror(errno));
+      *errno_out_p = errno;
+      break;
+    }
+    /* Handle partial writes */
+    bytes_written += rc;
+  }
+
+  if ((rc != -1) && (params_in->sync == true)) {
+    int sync_rc;
+    do {
+      sync_rc = fdatasync(params_in->fd);
+    } while ((sync_rc == -1) && (errno == EINTR));
+    if (sync_rc == -1) {
+      LOG_WA("%s - fdatasync FAILED: %s", __FUNCTION__, strerror(errno));
+    }
+  }
+
+  free(data);
+  osaf_mutex_lock_ordie(&lgs_ftcom_mutex); /* LOCK after critical section */
+  if (rc == -1) goto done;
+
+  /* If the thread was hanging and has timed out the whole batch is invalid
+   * and shall be removed from file (log service has either returned
+   * SA_AIS_ERR_TRY_AGAIN or queued the records for a new attempt).
+   */
+  if (*timeout_f == true) {
+    LOG_NO("Timeout, removing last %zu log records", params_in->num_records);
+    file_length = lseek(params_in->fd, -((off_t)bytes_written), SEEK_END);
+    if (file_length != -1) {
+      do {
+        rc = ftruncate(params_in->fd, file_length);
+      } while ((rc == -1) && (errno == EINTR));
+    }
+
+    if (file_length == -1) {
+      LOG_WA("%s - lseek error, Could not remove redundant log records, %s",
+             __FUNCTION__, strerror(errno));
+    } else if (rc == -1) {
+      LOG_WA("%s - ftruncate error, Could not remove redundant log records, %s",
+             __FUNCTION__, strerror(errno));
+    }
+  }
+
+done:
+  TRACE_LEAVE2("rc = %d", rc);
+  return rc;
+}
+
 /**
  * Make directory. Handles creation of directory path.
  * Creates the relative directory in the directory given by the root path.
@@ -530,73 +649,8 @@ int delete_file_hdl(void *indata, void *outdata, size_t max_outsize) {
   return rc;
 }
 
-/******************************************************************************
- * Utility functions for get_number_of_log_files_hdl
- */
-static int check_log_oldest(char *line, char *fname_prefix,
-                            int fname_prefix_size, int *old_date,
-                            int *old_time) {
-  int date, time, c, d;
-  date = time = c = d = 0;
-  std::string name_format;
-  char time_stamps[] = "_%d_%d_%d_%d.log";
-
-  name_format = std::string(fname_prefix);
-  TRACE_3("fname: %s", name_format.c_str());
-
-  name_format = name_format + time_stamps;
-  if (sscanf(line, name_format.c_str(), &date, &time, &c, &d) >= 2) {
-    TRACE_3("%s: line: arg 1: %d 2: %d 3: %d 4: %d ok", __FUNCTION__, date,
-            time, c, d);
-    if (date < *old_date || *old_date == -1) {
-      *old_date = date;
-      *old_time = time;
-      return 1;
-    } else if ((date == *old_date) && (time <= *old_time)) {
-      *old_date = date;
-      *old_time = time;
-      return 1;
-    }
-  } else {
-    TRACE_3("no log_oldest match");
-  }
-  return 0;
-}
-
-/******************************************************************************
- * Utility functions for get_number_of_cfg_files_hdl
- */
-static int check_cfg_oldest(char *line, char *fname_prefix,
-                            int fname_prefix_size, int *old_date,
-                            int *old_time) {
-  int date, time;
-  date = time = 0;
-  std::string name_format;
-  char time_stamps[] = "_%d_%d.cfg";
-
-  name_format = std::string(fname_prefix);
-  TRACE_3("fname: %s", name_format.c_str());
-
-  name_format = name_format + time_stamps;
-  if (sscanf(line, name_format.c_str(), &date, &time) >= 1) {
-    TRACE_3("%s: line: arg 1: %d 2: %d ok", __FUNCTION__, date, time);
-    if (date < *old_date || *old_date == -1) {
-      *old_date = date;
-      *old_time = time;
-      return 1;
-    } else if ((date == *old_date) && (time < *old_time)) {
-      *old_date = date;
-      *old_time = time;
-      return 1;
-    }
-  } else {
-    TRACE_3("no cfg_oldest match");
-  }
-  return 0;
-}
-
-/* Log Filter function used by scandir. */
-static std::string file_prefix;
+/* Log Filter function used by scandir. One per file handling thread. */
+static thread_local std::string file_prefix;
 
 static int log_filter_func(const struct dirent *finfo) {
   int ret;
@@ -608,234 +662,146 @@ static int log_filter_func(const struct dirent *finfo) {
   return !ret;
 }
 
-/* Cfg Filter function used by scandir. */
-static int cfg_filter_func(const struct dirent *finfo) {
-  int ret;
-  int filenameLen = strlen(finfo->d_name) - strlen(".cfg");
-
-  ret = strncmp(file_prefix.c_str(), finfo->d_name, file_prefix.size()) ||
-        strcmp(finfo->d_name + filenameLen, ".cfg");
-
-  return !ret;
-}
-
 /**
- * Return number of log files in a dir and the name of the oldest file.
- * @param indata, see gnolfh_in_t
- * @param outdata, char *oldest_file
- * @param max_outsize, Max size for oldest_file string
+ * Get the time stamps of a log or cfg file name <prefix>_<date>_<time>...
+ * The time stamps are used to find the oldest file.
+ * @param name[in], file name
+ * @param prefix[in], file name prefix (name part before time stamps)
+ * @param date[out]
+ * @param time[out]
  *
- * @return int, number of logfiles or -1 if error
+ * @return int, number of time stamps found
  */
-int get_number_of_log_files_hdl(void *indata, void *outdata,
-                                size_t max_outsize) {
-  struct dirent **namelist;
-  int n, old_date = -1, old_time = -1, old_ind = -1, files, i, failed = 0;
-  std::string path;
-  gnolfh_in_t *params_in;
-  char *oldest_file;
-  int rc = 0;
-
-  TRACE_ENTER();
-
-  params_in = static_cast<gnolfh_in_t *>(indata);
-  oldest_file = static_cast<char *>(outdata);
+int lgs_get_file_time(const char *name, const std::string &prefix, int *date,
+                      int *time) {
+  *date = *time = 0;
+  if (strncmp(name, prefix.c_str(), prefix.size()) != 0) return 0;
+  int rc = sscanf(name + prefix.size(), "_%d_%d", date, time);
+  return (rc == EOF ? 0 : rc);
+}
 
-  /* Initialize the filter */
-  file_prefix = params_in->file_name;
-  path = std::string(params_in->logsv_root_dir) + "/" + params_in->pathName;
+static bool has_suffix(const char *name, const char *suffix) {
+  size_t name_len = strlen(name);
+  size_t suffix_len = strlen(suffix);
+  return (name_len >= suffix_len) &&
+         (strcmp(name + name_len - suffix_len, suffix) == 0);
+}
 
-  osaf_mutex_unlock_ordie(&lgs_ftcom_mutex); /* UNLOCK critical section */
-  files = n = scandir(path.c_str(), &namelist, log_filter_func, alphasort);
-  osaf_mutex_lock_ordie(&lgs_ftcom_mutex); /* LOCK after critical section */
+/* Filter function used by scandir in get_log_files_hdl */
+static int log_cfg_filter_func(const struct dirent *finfo) {
+  static thread_local const std::string compressed_log =
+      std::string(".log") + kCompressedFileSuffix;
 
-  if (n == -1 && errno == ENOENT) {
-    rc = 0;
-    goto done_exit;
-  }
+  if (strncmp(file_prefix.c_str(), finfo->d_name, file_prefix.size()) != 0)
+    return 0;
 
-  if (n < 0) {
-    LOG_WA("scandir:%s - %s", strerror(errno), path.c_str());
-    rc = -1;
-    goto done_exit;
-  }
+  return has_suffix(finfo->d_name, ".log") ||
+         has_suffix(finfo->d_name, ".cfg") ||
+         has_suffix(finfo->d_name, compressed_log.c_str());
+}
 
-  if (n == 0) {
-    rc = files;
-    goto done_exit;
-  }
+typedef std::tuple<int, int, std::string> file_time_t;
 
-  while (n--) {
-    TRACE_3("%s", namelist[n]->d_name);
-    if (check_log_oldest(namelist[n]->d_name, params_in->file_name,
-                         strlen(params_in->file_name), &old_date, &old_time)) {
-      old_ind = n;
-    } else {
-      failed++; /* wrong format */
-    }
-  }
-  if (old_ind != -1) {
-    TRACE_1("oldest: %s", namelist[old_ind]->d_name);
-    n = snprintf(oldest_file, max_outsize, "%s/%s", path.c_str(),
-                 namelist[old_ind]->d_name);
-    if (n < 0 || static_cast<uint32_t>(n) >= max_outsize) {
-      LOG_WA("oldest_file > max_outsize");
-      rc = -1;
-      goto done_free;
-    } else {
-      rc = (files - failed);
+/* Copy a '\0' terminated list of file names to outdata, oldest first.
+ * If all names do not fit, false is returned or, if unlisted is given, the
+ * names not fitting (the newest) are counted in unlisted.
+ */
+static bool copy_file_names(const std::vector<file_time_t> &files,
+                            char **outdata, size_t *outsize,
+                            int *unlisted) {
+  for (size_t i = 0; i < files.size(); i++) {
+    const std::string &name = std::get<2>(files[i]);
+    /* Room for the name and the end of the list */
+    if (name.size() + 2 > *outsize) {
+      if (unlisted == nullptr) return false;
+      *unlisted = files.size() - i;
+      break;
     }
-  } else {
-    TRACE("Only file/files with wrong format found");
+    memcpy(*outdata, name.c_str(), name.size() + 1);
+    *outdata += name.size() + 1;
+    *outsize -= name.size() + 1;
   }
 
-done_free:
-  /* Free scandir allocated memory */
-  for (i = 0; i < files; i++) free(namelist[i]);
-  free(namelist);
-
-done_exit:
-  TRACE_LEAVE2("rc = %d", rc);
-  return rc;
+  **outdata = '\0';
+  (*outdata)++;
+  (*outsize)--;
+  return true;
 }
 
 /**
- * Return number of cfg files in a dir and the name of the oldest file.
+ * List the log and cfg files of a stream, oldest first. Used to read the
+ * file index of a stream, see remove_oldest_log_files().
+ * A compressed log file is listed with the name of the log file.
  * @param indata, see gnolfh_in_t
- * @param outdata, char *oldest_file
- * @param max_outsize, Max size for oldest_file string
+ * @param outdata, the names of the cfg files followed by the names of the
+ *        log files. Each name and each of the two lists is '\0' terminated
+ * @param max_outsize, Max size of outdata
  *
- * @return int, number of cfgfiles or -1 if error
+ * @return int, number of log files (the newest) that did not fit in outdata
+ *         or -1 if error
  */
-int get_number_of_cfg_files_hdl(void *indata, void *outdata,
-                                size_t max_outsize) {
-  struct dirent **cfg_namelist = nullptr;
-  struct dirent **log_namelist = nullptr;
-  int n, cfg_old_date = -1, cfg_old_time = -1, old_ind = -1, cfg_files = 0, i,
-         failed = 0;
-  int log_old_date = -1, log_old_time = -1, log_files = 0;
+int get_log_files_hdl(void *indata, void *outdata, size_t max_outsize) {
+  struct dirent **namelist;
+  std::vector<file_time_t> log_files;
+  std::vector<file_time_t> cfg_files;
   std::string path;
   gnolfh_in_t *params_in;
-  char *oldest_file;
+  char *out_p = static_cast<char *>(outdata);
+  int n, files, date, time, unlisted = 0;
   int rc = 0;
 
   TRACE_ENTER();
 
   params_in = static_cast<gnolfh_in_t *>(indata);
-  oldest_file = static_cast<char *>(outdata);
+
   /* Initialize the filter */
   file_prefix = params_in->file_name;
   path = std::string(params_in->logsv_root_dir) + "/" + params_in->pathName;
 
   osaf_mutex_unlock_ordie(&lgs_ftcom_mutex); /* UNLOCK critical section */
-  log_files = n =
-      scandir(path.c_str(), &log_namelist, log_filter_func, alphasort);
+  files = n = scandir(path.c_str(), &namelist, log_cfg_filter_func, nullptr);
   osaf_mutex_lock_ordie(&lgs_ftcom_mutex); /* LOCK after critical section */
 
   if (n == -1 && errno == ENOENT) {
-    rc = 0;
-    goto done_exit;
-  }
-
-  if (n < 0) {
+    files = 0;
+  } else if (n < 0) {
     LOG_WA("scandir:%s - %s", strerror(errno), path.c_str());
     rc = -1;
     goto done_exit;
   }
 
-  if (n == 0) {
-    rc = log_files;
-    goto done_exit;
-  }
-
-  while (n--) {
-    TRACE_3("%s", log_namelist[n]->d_name);
-    if (check_log_oldest(log_namelist[n]->d_name, params_in->file_name,
-                         strlen(params_in->file_name), &log_old_date,
-                         &log_old_time)) {
-      old_ind = n;
-    } else {
-      failed++; /* wrong format */
-    }
-  }
-
-  if (old_ind != -1) {
-    n = 0;
-    old_ind = -1;
-    failed = 0;
-    osaf_mutex_unlock_ordie(&lgs_ftcom_mutex); /* UNLOCK critical section */
-    cfg_files = n =
-        scandir(path.c_str(), &cfg_namelist, cfg_filter_func, alphasort);
-    osaf_mutex_lock_ordie(&lgs_ftcom_mutex); /* LOCK after critical section */
-
-    if (n == -1 && errno == ENOENT) {
-      rc = 0;
-      goto done_log_free;
-    }
-
-    if (n < 0) {
-      LOG_WA("scandir:%s - %s", strerror(errno), path.c_str());
-      rc = -1;
-      goto done_log_free;
-    }
-
-    if (n == 0) {
-      rc = cfg_files;
-      goto done_log_free;
-    }
-
-    // Get the oldest cfg file
-    while (n--) {
-      if (check_cfg_oldest(cfg_namelist[n]->d_name, params_in->file_name,
-                           strlen(params_in->file_name), &cfg_old_date,
-                           &cfg_old_time)) {
-        old_ind = n;
-      } else {
-        const std::string current_cfg_name =
-            std::string(params_in->file_name) + ".cfg";
-        if (strncmp(cfg_namelist[n]->d_name, current_cfg_name.c_str(),
-                    current_cfg_name.size()) != 0) {
-          failed++;   // wrong format
-        }
-      }
-    }
+  for (int i = 0; i < files; i++) {
+    std::string name = namelist[i]->d_name;
+    free(namelist[i]);
 
-    if (old_ind == -1) goto done_cfg_free;
-
-    // If the oldest cfg file is older than the oldest log file, the output
-    // is returned with oldest cfg file. Otherwise the output is returned empty
-    if (((cfg_old_date == log_old_date) && (cfg_old_time <= log_old_time)) ||
-        (cfg_old_date < log_old_date)) {
-      TRACE_1(" (cfg_old_date:%d - log_old_date:%d) -"
-              " (cfg_old_time:%d - log_old_time:%d )",
-              cfg_old_date, log_old_date, cfg_old_time, log_old_time);
-      TRACE_1("oldest: %s", cfg_namelist[old_ind]->d_name);
-      n = snprintf(oldest_file, max_outsize, "%s/%s", path.c_str(),
-                   cfg_namelist[old_ind]->d_name);
-
-      if (n < 0 || static_cast<uint32_t>(n) >= max_outsize) {
-        LOG_WA("oldest_file > max_outsize");
-        rc = -1;
-        goto done_cfg_free;
-      } else {
-        rc = (cfg_files - failed);
+    n = lgs_get_file_time(name.c_str(), file_prefix, &date, &time);
+    if (has_suffix(name.c_str(), ".cfg")) {
+      /* Not the cfg file of the current log file */
+      if (n >= 1) cfg_files.emplace_back(date, time, name);
+    } else if (n >= 2) {
+      if (has_suffix(name.c_str(), kCompressedFileSuffix)) {
+        name.erase(name.size() - strlen(kCompressedFileSuffix));
       }
+      log_files.emplace_back(date, time, name);
+    } else {
+      TRACE_3("Wrong format: %s", name.c_str());
     }
   }
+  if (files > 0) free(namelist);
 
-done_cfg_free:
-  /* Free scandir allocated memory */
-  if (cfg_namelist != nullptr) {
-    for (i = 0; i < cfg_files; i++) free(cfg_namelist[i]);
-    free(cfg_namelist);
-  }
+  std::sort(cfg_files.begin(), cfg_files.end());
+  std::sort(log_files.begin(), log_files.end());
+  /* A log file being compressed is found twice */
+  log_files.erase(std::unique(log_files.begin(), log_files.end()),
+                  log_files.end());
 
-done_log_free:
-  /* Free scandir allocated memory */
-  if (log_namelist != nullptr) {
-    for (i = 0; i < log_files; i++) free(log_namelist[i]);
-    free(log_namelist);
+  if (copy_file_names(cfg_files, &out_p, &max_outsize, nullptr) == false) {
+    LOG_WA("Too many cfg files in %s", path.c_str());
+    rc = -1;
+    goto done_exit;
   }
+  (void)copy_file_names(log_files, &out_p, &max_outsize, &unlisted);
+  rc = unlisted;
 
 done_exit:
   TRACE_LEAVE2("rc = %d", rc);
@@ -975,7 +941,7 @@ static bool all_digits(const char *data, int size) {
  * - two timestamps (other log files has four)
  */
 /* Filename prefix (no timestamps or extension */
-static std::string file_name_find_g;
+static thread_local std::string file_name_find_g;
 static int filter_logfile_name(const struct dirent *finfo) {
   size_t name_len = strlen(file_name_find_g.c_str());
   size_t fixed_length = name_len + strlen("_yyyymmdd_hhmmss.log");
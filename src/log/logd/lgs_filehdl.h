@@ -22,6 +22,7 @@
 #include <stddef.h>
 #include <limits.h>
 #include <utmp.h>
+#include <sys/uio.h>
 
 #include <saAis.h>
 #include "log/logd/lgs_util.h"
@@ -72,8 +73,7 @@ typedef struct {
 } mld_in_t;
 
 /*
- * get_number_of_log_files_hdl(..)
- * get_number_of_cfg_files_hdl(..)
+ * get_log_files_hdl(..)
  */
 typedef struct {
   /* File name prefix (name part before time stamps) */
@@ -96,6 +96,18 @@ typedef struct {
   const void *lgs_rec; /* Pointer to allocated log record */
 } wlrh_t;
 
+/*
+ * write_log_records_hdl(..)
+ * Outpar int errno_save
+ */
+typedef struct {
+  int fd;                      /* File descriptor for current log file */
+  size_t num_records;          /* Number of records in records[] */
+  size_t total_size;           /* Sum of all record sizes */
+  const struct iovec *records; /* Log records in the order to be written */
+  bool sync;                   /* fdatasync() file after writing if true */
+} wlrsh_t;
+
 /*
  * create_config_file_hdl(..)
  * No out parameters
@@ -137,6 +149,18 @@ typedef struct {
  * No out parameters
  */
 
+/*
+ * archive_file_hdl(..)
+ * No out parameters
+ */
+typedef struct {
+  uint32_t compression; /* Value of saLogStreamFileCompression */
+} afh_t;
+/* char file_path[]
+ * String of varying length that shall be added
+ * to the indata buffer directly after the afh_t
+ */
+
 /*
  * check_path_exists_hdl(..)
  *
@@ -178,18 +202,20 @@ typedef struct {
 int path_is_writeable_dir_hdl(void *indata, void *outdata, size_t max_outsize);
 int check_path_exists_hdl(void *indata, void *outdata, size_t max_outsize);
 int rename_file_hdl(void *indata, void *outdata, size_t max_outsize);
+int archive_file_hdl(void *indata, void *outdata, size_t max_outsize);
 int create_config_file_hdl(void *indata, void *outdata, size_t max_outsize);
 int write_log_record_hdl(void *indata, void *outdata, size_t max_outsize,
                          bool *timeout_f);
+int write_log_records_hdl(void *indata, void *outdata, size_t max_outsize,
+                          bool *timeout_f);
 int make_log_dir_hdl(void *indata, void *outdata, size_t max_outsize);
 int fileopen_hdl(void *indata, void *outdata, size_t max_outsize,
                  bool *timeout_f);
 int fileclose_hdl(void *indata, void *outdata, size_t max_outsize);
 int delete_file_hdl(void *indata, void *outdata, size_t max_outsize);
-int get_number_of_log_files_hdl(void *indata, void *outdata,
-                                size_t max_outsize);
-int get_number_of_cfg_files_hdl(void *indata, void *outdata,
-                                size_t max_outsize);
+int lgs_get_file_time(const char *name, const std::string &prefix, int *date,
+                      int *time);
+int get_log_files_hdl(void *indata, void *outdata, size_t max_outsize);
 int own_log_files_by_group_hdl(void *indata, void *outdata, size_t max_outsize);
 int lgs_get_file_params_hdl(void *indata, void *outdata, size_t max_outsize);
 
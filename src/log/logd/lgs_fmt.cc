@@ -534,8 +534,8 @@ static SaBoolT validateSysToken(SaStringT fmtExpPtr, SaUint16T *fmtExpPtrOffset,
 
 /**
  *
- * @param fmtExpPtr
- * @param fmtExpPtrOffset
+ * @param letter
+ * @param fieldSize
  * @param truncationLetterPos
  * @param inputPos
  * @param twelveHourModeFlag
@@ -545,25 +545,21 @@ static SaBoolT validateSysToken(SaStringT fmtExpPtr, SaUint16T *fmtExpPtrOffset,
  *
  * @return SaStringT
  */
-static int extractCommonField(char *dest, size_t dest_size, SaStringT fmtExpPtr,
-                              SaUint16T *fmtExpPtrOffset,
+static int extractCommonField(char *dest, size_t dest_size, char letter,
+                              SaInt32T fieldSize,
                               SaInt32T *truncationLetterPos, SaInt32T inputPos,
                               SaUint32T logRecordIdCounter,
                               const SaBoolT *twelveHourModeFlag,
                               const struct tm *timeStampData,
                               const SaLogRecordT *logRecord, SaUint16T rec_size,
                               char *node_name) {
-  SaInt32T fieldSize;
   size_t stringSize, i;
-  SaUint16T fieldSizeOffset = 0;
   int characters = 0;
   char *hex_string = NULL, *hex_string_ptr = NULL;
   SaTimeT ms;
   long gmtOffset = 0, uGmtOffset = 0;
 
-  *fmtExpPtrOffset = DEFAULT_FMT_EXP_PTR_OFFSET;
-
-  switch (*fmtExpPtr++) { /* input points to a possible field size */
+  switch (letter) {
     case C_LR_ID_LETTER:
       stringSize = 11 * sizeof(char);
       characters = snprintf(dest, dest_size, "% 10d", (int)logRecordIdCounter);
@@ -770,7 +766,6 @@ static int extractCommonField(char *dest, size_t dest_size, SaStringT fmtExpPtr,
       break;
 
     case C_LR_STRING_BODY_LETTER:
-      fieldSize = checkFieldSize(fmtExpPtr, &fieldSizeOffset);
       stringSize = logRecord->logBuffer->logBufSize + 1;
       if (fieldSize == 0) { /* Copy whole body */
         if (stringSize > dest_size) stringSize = dest_size;
@@ -781,13 +776,10 @@ static int extractCommonField(char *dest, size_t dest_size, SaStringT fmtExpPtr,
             snprintf(dest, dest_size, "%*.*s", (int)-fieldSize, (int)fieldSize,
                      (SaStringT)logRecord->logBuffer->logBuf);
       }
-
-      *fmtExpPtrOffset = *fmtExpPtrOffset + fieldSizeOffset;
       break;
 
     case C_LR_HEX_CHAR_BODY_LETTER:
       stringSize = logRecord->logBuffer->logBufSize;
-      fieldSize = checkFieldSize(fmtExpPtr, &fieldSizeOffset);
       hex_string = static_cast<char *>(malloc(2 * stringSize + 1));
 
       if (hex_string == NULL) {
@@ -809,7 +801,6 @@ static int extractCommonField(char *dest, size_t dest_size, SaStringT fmtExpPtr,
         characters = snprintf(dest, dest_size, "%*.*s", (int)fieldSize,
                               (int)fieldSize, hex_string);
       }
-      *fmtExpPtrOffset = *fmtExpPtrOffset + fieldSizeOffset;
       free(hex_string);
       break;
 
@@ -839,38 +830,24 @@ static int extractCommonField(char *dest, size_t dest_size, SaStringT fmtExpPtr,
 
 /**
  *
- * @param fmtExpPtr
- * @param fmtExpPtrOffset
+ * @param letter
+ * @param fieldSize
  * @param twelveHourModeFlag
- * @param commonData
+ * @param eventTimeData
  * @param ntfHeader
  *
  * @return SaStringT
  */
-static int extractNotificationField(char *dest, size_t dest_size,
-                                    SaStringT fmtExpPtr,
-                                    SaUint16T *fmtExpPtrOffset,
+static int extractNotificationField(char *dest, size_t dest_size, char letter,
+                                    SaInt32T fieldSize,
                                     const SaBoolT *twelveHourModeFlag,
+                                    const struct tm *eventTimeData,
                                     const SaLogRecordT *logRecord) {
-  struct tm *eventTimeData;
-  SaTimeT totalTime, ms;
-  SaInt32T fieldSize;
+  SaTimeT ms;
   SaInt32T characters = 0;
-  SaUint16T fieldSizeOffset = 0;
   long gmtOffset = 0, uGmtOffset = 0;
 
-  *fmtExpPtrOffset = DEFAULT_FMT_EXP_PTR_OFFSET;
-
-  /* Convert event time into */
-  totalTime =
-      (logRecord->logHeader.ntfHdr.eventTime / (SaTimeT)SA_TIME_ONE_SECOND);
-
-  /* Split timestamp in timeStampData */
-  struct tm tm_info;
-  eventTimeData = localtime_r((const time_t *)&totalTime, &tm_info);
-  osafassert(eventTimeData);
-
-  switch (*fmtExpPtr++) {
+  switch (letter) {
     case N_NOTIFICATION_ID_LETTER:
       characters = snprintf(dest, dest_size, "0x%#016llx",
                             logRecord->logHeader.ntfHdr.notificationId);
@@ -1036,8 +1013,6 @@ static int extractNotificationField(char *dest, size_t dest_size,
       break;
 
     case N_EVENT_TYPE_LETTER:
-      /* Check field size */
-      fieldSize = checkFieldSize(fmtExpPtr, &fieldSizeOffset);
       if (fieldSize == 0) {
         characters = snprintf(dest, dest_size, "%#x",
                               logRecord->logHeader.ntfHdr.eventType);
@@ -1049,13 +1024,9 @@ static int extractNotificationField(char *dest, size_t dest_size,
         characters = snprintf(dest, dest_size, "%#.*x", fieldSize,
                               logRecord->logHeader.ntfHdr.eventType);
       }
-
-      *fmtExpPtrOffset = *fmtExpPtrOffset + fieldSizeOffset;
       break;
 
     case N_NOTIFICATION_OBJECT_LETTER:
-      /* Check field size and trunkate alternative pad with blanks */
-      fieldSize = checkFieldSize(fmtExpPtr, &fieldSizeOffset);
       if (fieldSize == 0) {
         characters =
             snprintf(dest, dest_size, "%s",
@@ -1067,13 +1038,9 @@ static int extractNotificationField(char *dest, size_t dest_size,
                      osaf_extended_name_borrow(
                          logRecord->logHeader.ntfHdr.notificationObject));
       }
-
-      *fmtExpPtrOffset = *fmtExpPtrOffset + fieldSizeOffset;
       break;
 
     case N_NOTIFYING_OBJECT_LETTER:
-      /* Check field size and trunkate alternative pad with blanks */
-      fieldSize = checkFieldSize(fmtExpPtr, &fieldSizeOffset);
       if (fieldSize == 0) {
         characters = snprintf(dest, dest_size, "%s",
                               osaf_extended_name_borrow(
@@ -1084,8 +1051,6 @@ static int extractNotificationField(char *dest, size_t dest_size,
                      osaf_extended_name_borrow(
                          logRecord->logHeader.ntfHdr.notifyingObject));
       }
-
-      *fmtExpPtrOffset = *fmtExpPtrOffset + fieldSizeOffset;
       break;
 
     default:
@@ -1103,24 +1068,19 @@ static int extractNotificationField(char *dest, size_t dest_size,
 
 /**
  *
- * @param fmtExpPtr
- * @param fmtExpPtrOffset
- * @param commonData
+ * @param letter
+ * @param fieldSize
  * @param genHeader
  *
  * @return SaStringT
  */
-static int extractSystemField(char *dest, size_t dest_size, SaStringT fmtExpPtr,
-                              SaUint16T *fmtExpPtrOffset,
+static int extractSystemField(char *dest, size_t dest_size, char letter,
+                              SaInt32T fieldSize,
                               const SaLogRecordT *logRecord) {
-  SaInt32T fieldSize;
   SaInt32T characters = 0;
-  SaUint16T fieldSizeOffset = 0;
-  *fmtExpPtrOffset = DEFAULT_FMT_EXP_PTR_OFFSET;
 
-  switch (*fmtExpPtr++) { /* input points to a possible field size */
+  switch (letter) {
     case S_LOGGER_NAME_LETTER:
-      fieldSize = checkFieldSize(fmtExpPtr, &fieldSizeOffset);
       if (fieldSize != 0) {
         characters =
             snprintf(dest, dest_size, "%*.*s", (int)-fieldSize, (int)fieldSize,
@@ -1132,7 +1092,6 @@ static int extractSystemField(char *dest, size_t dest_size, SaStringT fmtExpPtr,
                      osaf_extended_name_borrow(
                          logRecord->logHeader.genericHdr.logSvcUsrName));
       }
-      *fmtExpPtrOffset = *fmtExpPtrOffset + fieldSizeOffset;
       break;
 
     case S_SEVERITY_ID_LETTER:
@@ -1262,104 +1221,195 @@ SaBoolT lgs_is_valid_format_expression(const SaStringT formatExpression,
   return formatExpressionOk;
 }
 
+/* The broken-down time of the last second converted by lgs_localtime() */
+typedef struct {
+  time_t seconds;
+  bool valid;
+  struct tm tm_info;
+} timeCacheT;
+
+/**
+ * Convert a time stamp to broken-down local time. The result of localtime_r()
+ * only changes once per second, so the conversion is cached per second.
+ *
+ * @param timeStamp
+ * @param cache[in/out]
+ *
+ * @return const struct tm *
+ */
+static const struct tm *lgs_localtime(SaTimeT timeStamp, timeCacheT *cache) {
+  time_t totalTime = (time_t)(timeStamp / (SaTimeT)SA_TIME_ONE_SECOND);
+
+  if ((cache->valid == false) || (cache->seconds != totalTime)) {
+    struct tm *timeData = localtime_r(&totalTime, &cache->tm_info);
+    osafassert(timeData);
+    cache->seconds = totalTime;
+    cache->valid = true;
+  }
+
+  return &cache->tm_info;
+}
+
+/**
+ * True if the token takes an optional field size, e.g. @Cb30
+ *
+ * @param fieldType
+ * @param letter
+ *
+ * @return bool
+ */
+static bool hasFieldSize(char fieldType, char letter) {
+  switch (fieldType) {
+    case COMMON_LOG_RECORD_FIELD_TYPE:
+      return (letter == C_LR_STRING_BODY_LETTER) ||
+             (letter == C_LR_HEX_CHAR_BODY_LETTER);
+    case NOTIFICATION_LOG_RECORD_FIELD_TYPE:
+      return (letter == N_EVENT_TYPE_LETTER) ||
+             (letter == N_NOTIFICATION_OBJECT_LETTER) ||
+             (letter == N_NOTIFYING_OBJECT_LETTER);
+    case SYSTEM_LOG_RECORD_FIELD_TYPE:
+      return (letter == S_LOGGER_NAME_LETTER);
+    default:
+      return false;
+  }
+}
+
+LogFormat::LogFormat(const char *formatExpression)
+    : expression_{}, ops_{}, valid_{false}, has_event_time_{false} {
+  if (formatExpression == NULL) return;
+  expression_ = formatExpression;
+
+  const char *fmtExpPtr = formatExpression;
+  while (*fmtExpPtr != STRING_END_CHARACTER) {
+    if ((*fmtExpPtr == TOKEN_START_SYMBOL) &&
+        (fmtExpPtr[1] != STRING_END_CHARACTER)) {
+      Op op{fmtExpPtr[1], fmtExpPtr[2], 0, {}};
+      switch (op.type) {
+        case COMMON_LOG_RECORD_FIELD_TYPE:
+        case SYSTEM_LOG_RECORD_FIELD_TYPE:
+          break;
+        case NOTIFICATION_LOG_RECORD_FIELD_TYPE:
+          has_event_time_ = true;
+          break;
+        default:
+          TRACE("Invalid token %u", op.type);
+          ops_.clear();
+          return;
+      }
+
+      if (op.letter == STRING_END_CHARACTER) {
+        /* Token without letter at the end of formatExpression */
+        ops_.push_back(op);
+        break;
+      }
+
+      SaUint16T fmtExpTokenOffset = DEFAULT_FMT_EXP_PTR_OFFSET;
+      if (hasFieldSize(op.type, op.letter) == true) {
+        SaUint16T fieldSizeOffset = 0;
+        op.fieldSize =
+            checkFieldSize(const_cast<SaStringT>(&fmtExpPtr[3]),
+                           &fieldSizeOffset);
+        fmtExpTokenOffset += fieldSizeOffset;
+      }
+      ops_.push_back(op);
+      fmtExpPtr += fmtExpTokenOffset;
+    } else {
+      /* All chars between tokens are collected in one literal */
+      if (ops_.empty() || (ops_.back().type != LITERAL_FIELD_TYPE)) {
+        ops_.push_back(Op{LITERAL_FIELD_TYPE, 0, 0, {}});
+      }
+      ops_.back().literal += *fmtExpPtr++;
+    }
+  }
+
+  valid_ = true;
+}
+
 /**
  * Format a log record
  *
  * @param logRecord
- * @param formatExpression format string
+ * @param logFileSize
  * @param fixedLogRecordSize if 0 do not pad
  * @param dest_size size of dest
  * @param dest write at most dest_size bytes to dest
  * @param logRecordIdCounter
+ * @param node_name
  *
  * @return int number of bytes written to dest
  */
-int lgs_format_log_record(SaLogRecordT *logRecord,
-                          const SaStringT formatExpression,
-                          SaUint64T logFileSize, SaUint16T fixedLogRecordSize,
-                          size_t dest_size, char *dest,
-                          SaUint32T logRecordIdCounter, char *node_name) {
-  SaStringT fmtExpPtr = &formatExpression[0];
-  SaStringT fmtExpPtrSnabel = &formatExpression[1];
-  SaTimeT totalTime;
+int LogFormat::Format(SaLogRecordT *logRecord, SaUint64T logFileSize,
+                      SaUint16T fixedLogRecordSize, size_t dest_size,
+                      char *dest, SaUint32T logRecordIdCounter,
+                      char *node_name) const {
+  /* Formatting is done in the main thread only. Kept per thread anyway. */
+  static thread_local timeCacheT timeStampCache = {0, false, {}};
+  static thread_local timeCacheT eventTimeCache = {0, false, {}};
   SaInt8T truncationCharacter = (SaInt8T)COMPLETED_LOG_RECORD;
-  SaUint16T fmtExpTokenOffset = 1;
   SaInt32T truncationLetterPos = -1;
-  struct tm *timeStampData;
+  const struct tm *timeStampData;
+  const struct tm *eventTimeData = NULL;
   SaBoolT _twelveHourModeFlag = SA_FALSE;
   const SaBoolT *twelveHourModeFlag = &_twelveHourModeFlag;
   size_t i = 0;
   SaUint16T rec_size = dest_size;
 
-  if (formatExpression == NULL) {
+  if (valid_ == false) {
     goto error_exit;
   }
 
   /* Init output vector with a '\0' */
   (void)strcpy(dest, "");
 
-  totalTime = (logRecord->logTimeStamp / (SaTimeT)SA_TIME_ONE_SECOND);
-
   /* Split timestamp in timeStampData */
-  struct tm tm_info;
-  timeStampData = localtime_r((const time_t *)&totalTime, &tm_info);
-  osafassert(timeStampData);
+  timeStampData = lgs_localtime(logRecord->logTimeStamp, &timeStampCache);
+  if (has_event_time_ == true) {
+    eventTimeData = lgs_localtime(logRecord->logHeader.ntfHdr.eventTime,
+                                  &eventTimeCache);
+  }
 
   /* Main formatting loop */
-  for (;;) {
-    /* Scan the Format Expression */
-    if ((*fmtExpPtr == TOKEN_START_SYMBOL) &&
-        (*fmtExpPtrSnabel != STRING_END_CHARACTER)) {
-      switch (*fmtExpPtrSnabel++) {
-        /* Check log record field types if a new token is present */
-        case COMMON_LOG_RECORD_FIELD_TYPE:
-          i += extractCommonField(&dest[i], dest_size - i, fmtExpPtrSnabel,
-                                  &fmtExpTokenOffset, &truncationLetterPos,
-                                  (SaInt32T)strlen(dest), logRecordIdCounter,
-                                  twelveHourModeFlag, timeStampData, logRecord,
-                                  rec_size, node_name);
-          break;
-
-        case NOTIFICATION_LOG_RECORD_FIELD_TYPE:
-          i += extractNotificationField(&dest[i], dest_size - i,
-                                        fmtExpPtrSnabel, &fmtExpTokenOffset,
-                                        twelveHourModeFlag, logRecord);
-          break;
-
-        case SYSTEM_LOG_RECORD_FIELD_TYPE:
-          i += extractSystemField(&dest[i], dest_size - i, fmtExpPtrSnabel,
-                                  &fmtExpTokenOffset, logRecord);
-          break;
-
-        default:
-          TRACE("Invalid token %u", *(fmtExpPtrSnabel - 1));
-          i = 0;
-          goto error_exit;
-      }
-
-    } else { /* All chars between tokens */
-      fmtExpTokenOffset = 1;
-      /* Insert litteral chars i.e. [:, ,/ and "] */
-      if (i < dest_size) {
-        dest[i++] = *fmtExpPtr;
+  for (size_t n = 0; n < ops_.size(); n++) {
+    const Op &op = ops_[n];
+    bool lastLiteral = false;
+
+    switch (op.type) {
+      case COMMON_LOG_RECORD_FIELD_TYPE:
+        i += extractCommonField(&dest[i], dest_size - i, op.letter,
+                                op.fieldSize, &truncationLetterPos,
+                                (SaInt32T)i, logRecordIdCounter,
+                                twelveHourModeFlag, timeStampData, logRecord,
+                                rec_size, node_name);
+        break;
+
+      case NOTIFICATION_LOG_RECORD_FIELD_TYPE:
+        i += extractNotificationField(&dest[i], dest_size - i, op.letter,
+                                      op.fieldSize, twelveHourModeFlag,
+                                      eventTimeData, logRecord);
+        break;
+
+      case SYSTEM_LOG_RECORD_FIELD_TYPE:
+        i += extractSystemField(&dest[i], dest_size - i, op.letter,
+                                op.fieldSize, logRecord);
+        break;
+
+      default: { /* Insert litteral chars i.e. [:, ,/ and "] */
+        size_t len = op.literal.size();
+        if (len > dest_size - i) len = dest_size - i;
+        memcpy(&dest[i], op.literal.data(), len);
+        i += len;
+        /* Filling up dest with the last char is not a truncation */
+        lastLiteral = ((n + 1) == ops_.size()) && (len == op.literal.size());
+        break;
       }
-
-      if (*fmtExpPtrSnabel == STRING_END_CHARACTER)
-        break; /* End of formatExpression */
     }
 
-    if (i >= dest_size) {
+    if ((i >= dest_size) && (lastLiteral == false)) {
       /* Truncation exists */
       truncationCharacter = (SaInt8T)TRUNCATED_LOG_RECORD;
       break;
     }
-
-    /* Step forward */
-    fmtExpPtr += fmtExpTokenOffset;
-    if (*fmtExpPtr == STRING_END_CHARACTER) break; /* End of formatExpression */
-
-    fmtExpPtrSnabel = (fmtExpPtr + 1);
-  } /* for ( ; ; ) */
+  }
 
   /* Pad log record to fixed log record fieldSize */
   if ((fixedLogRecordSize > 0) && (i < fixedLogRecordSize)) {
@@ -1396,3 +1446,26 @@ int lgs_format_log_record(SaLogRecordT *logRecord,
 error_exit:
   return i;
 }
+
+/**
+ * Format a log record. The format expression is compiled for this record
+ * only, use a LogFormat kept per stream for the log records of a stream.
+ *
+ * @param logRecord
+ * @param formatExpression format string
+ * @param fixedLogRecordSize if 0 do not pad
+ * @param dest_size size of dest
+ * @param dest write at most dest_size bytes to dest
+ * @param logRecordIdCounter
+ *
+ * @return int number of bytes written to dest
+ */
+int lgs_format_log_record(SaLogRecordT *logRecord,
+                          const SaStringT formatExpression,
+                          SaUint64T logFileSize, SaUint16T fixedLogRecordSize,
+                          size_t dest_size, char *dest,
+                          SaUint32T logRecordIdCounter, char *node_name) {
+  LogFormat logFormat(formatExpression);
+  return logFormat.Format(logRecord, logFileSize, fixedLogRecordSize,
+                          dest_size, dest, logRecordIdCounter, node_name);
+}
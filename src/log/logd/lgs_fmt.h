@@ -20,6 +20,8 @@
 
 #include <saAis.h>
 #include <saLog.h>
+#include <string>
+#include <vector>
 
 #define TOKEN_START_SYMBOL '@'
 #define STRING_END_CHARACTER '\0'
@@ -135,7 +137,9 @@ typedef enum {
 typedef enum {
   COMMON_LOG_RECORD_FIELD_TYPE = 'C',
   NOTIFICATION_LOG_RECORD_FIELD_TYPE = 'N',
-  SYSTEM_LOG_RECORD_FIELD_TYPE = 'S'
+  SYSTEM_LOG_RECORD_FIELD_TYPE = 'S',
+  /* Not a token, the chars between tokens in a compiled format expression */
+  LITERAL_FIELD_TYPE = '\0'
 } logRecordFieldTypeT;
 
 typedef enum {
@@ -188,4 +192,37 @@ extern int lgs_format_log_record(SaLogRecordT *, const SaStringT,
                                  SaUint16T fixedLogRecordSize, size_t dest_size,
                                  char *dest, SaUint32T, char *node_name);
 
+/**
+ * A format expression compiled into a list of formatting operations, so that
+ * the expression is not parsed again for every log record written to a
+ * stream. The expression shall have been validated with
+ * lgs_is_valid_format_expression(). If not, is_valid() may return false and
+ * Format() writes nothing.
+ */
+class LogFormat {
+ public:
+  explicit LogFormat(const char *formatExpression);
+
+  int Format(SaLogRecordT *logRecord, SaUint64T logFileSize,
+             SaUint16T fixedLogRecordSize, size_t dest_size, char *dest,
+             SaUint32T logRecordIdCounter, char *node_name) const;
+
+  const std::string &expression() const { return expression_; }
+  bool is_valid() const { return valid_; }
+
+ private:
+  struct Op {
+    char type;          /* logRecordFieldTypeT */
+    char letter;        /* Token letter, not used for a literal */
+    SaInt32T fieldSize; /* Field size given in the token or 0 */
+    std::string literal;
+  };
+
+  std::string expression_;
+  std::vector<Op> ops_;
+  bool valid_;
+  /* The expression has notification tokens, eventTime must be converted */
+  bool has_event_time_;
+};
+
 #endif  // LOG_LOGD_LGS_FMT_H_
@@ -50,6 +50,7 @@
 #include "log/logd/lgs_dest.h"
 #include "log/logd/lgs_oi_admin.h"
 #include "log/logd/lgs_cache.h"
+#include "log/logd/lgs_archive.h"
 
 #include "log/logd/lgs_mbcsv_v1.h"
 #include "log/logd/lgs_mbcsv_v2.h"
@@ -57,6 +58,7 @@
 #include "log/logd/lgs_mbcsv_v5.h"
 #include "log/logd/lgs_mbcsv_v6.h"
 #include "log/logd/lgs_mbcsv_v9.h"
+#include "log/logd/lgs_mbcsv_v10.h"
 #include "base/saf_error.h"
 
 /* TYPE DEFINITIONS
@@ -354,6 +356,9 @@ static uint32_t ckpt_stream_config(log_stream_t *stream) {
   }
 
   rc = lgs_ckpt_send_async(lgs_cb, ckpt_ptr, NCS_MBCSV_ACT_ADD);
+  if ((rc == NCSCC_RC_SUCCESS) && lgs_is_peer_v10()) {
+    lgs_ckpt_stream_compression(stream);
+  }
 
   TRACE_LEAVE();
   return rc;
@@ -1312,6 +1317,8 @@ static SaAisErrorT check_attr_validity(
   bool i_severityFilter_mod = false;
   SaUint32T i_facilityId = 0;
   bool i_facilityId_mod = false;
+  SaUint32T i_fileCompression = 0;
+  bool i_fileCompression_mod = false;
 
   TRACE_ENTER();
 
@@ -1370,7 +1377,8 @@ static SaAisErrorT check_attr_validity(
       value = attribute->attrValues[0];
     } else if (opdata->operationType == CCBUTIL_MODIFY) {
       if (!strcmp(attribute->attrName, "saLogRecordDestination") ||
-          !strcmp(attribute->attrName, "saLogStreamFacilityId")) {
+          !strcmp(attribute->attrName, "saLogStreamFacilityId") ||
+          !strcmp(attribute->attrName, "saLogStreamFileCompression")) {
         // do nothing
       } else {
         /* An attribute without a value is never valid if modify */
@@ -1440,6 +1448,11 @@ static SaAisErrorT check_attr_validity(
       i_facilityId = *(reinterpret_cast<SaUint32T *>(value));
       i_facilityId_mod = true;
       TRACE("Saved attribute \"%s\"", attribute->attrName);
+    } else if (!strcmp(attribute->attrName, "saLogStreamFileCompression") &&
+               attribute->attrValuesNumber > 0) {
+      i_fileCompression = *(reinterpret_cast<SaUint32T *>(value));
+      i_fileCompression_mod = true;
+      TRACE("Saved attribute \"%s\"", attribute->attrName);
     } else if (!strcmp(attribute->attrName, "saLogRecordDestination")) {
       std::vector<std::string> vstring{};
       for (unsigned i = 0; i < attribute->attrValuesNumber; i++) {
@@ -1690,6 +1703,18 @@ static SaAisErrorT check_attr_validity(
         goto done;
       }
     }
+
+    /* saLogStreamFileCompression */
+    if (i_fileCompression_mod) {
+      TRACE("Checking saLogStreamFileCompression");
+      if (!lgs_is_valid_compression(i_fileCompression)) {
+        report_oi_error(immOiHandle, opdata->ccbId,
+                        "Invalid file compression: %u", i_fileCompression);
+        rc = SA_AIS_ERR_BAD_OPERATION;
+        TRACE("Invalid file compression: %u", i_fileCompression);
+        goto done;
+      }
+    }
   }
 
 done:
@@ -2321,6 +2346,10 @@ static SaAisErrorT stream_create_and_configure1(
                          "saLogStreamFacilityId")) {
         (*stream)->facilityId = *(reinterpret_cast<SaUint32T *>(value));
         TRACE("facilityId: %u", (*stream)->facilityId);
+      } else if (!strcmp(ccb->param.create.attrValues[i]->attrName,
+                         "saLogStreamFileCompression")) {
+        (*stream)->fileCompression = *(reinterpret_cast<SaUint32T *>(value));
+        TRACE("fileCompression: %u", (*stream)->fileCompression);
       } else if (!strcmp(ccb->param.create.attrValues[i]->attrName,
                          "saLogRecordDestination")) {
         std::vector<std::string> vstring{};
@@ -2460,6 +2489,11 @@ static void stream_ccb_apply_modify(const CcbUtilOperationData_t *opdata) {
         stream->facilityId = Facility::kLocal0;
         attrMod = opdata->param.modify.attrMods[i++];
         continue;
+      } else if (!strcmp(attribute->attrName, "saLogStreamFileCompression")) {
+        LOG_NO("%s deleted", __func__);
+        stream->fileCompression = Compression::kNone;
+        attrMod = opdata->param.modify.attrMods[i++];
+        continue;
       }
     }
 
@@ -2522,6 +2556,8 @@ static void stream_ccb_apply_modify(const CcbUtilOperationData_t *opdata) {
       }
     } else if (!strcmp(attribute->attrName, "saLogStreamFacilityId")) {
       stream->facilityId = *(reinterpret_cast<SaUint32T *>(value));
+    } else if (!strcmp(attribute->attrName, "saLogStreamFileCompression")) {
+      stream->fileCompression = *(reinterpret_cast<SaUint32T *>(value));
     } else {
       LOG_ER("Error: Unknown attribute name");
       osafassert(0);
@@ -2856,6 +2892,9 @@ static SaAisErrorT stream_create_and_configure(
     } else if (!strcmp(attribute->attrName, "saLogStreamFacilityId")) {
       stream->facilityId = *(reinterpret_cast<SaUint32T *>(value));
       TRACE("facilityId: %u", stream->facilityId);
+    } else if (!strcmp(attribute->attrName, "saLogStreamFileCompression")) {
+      stream->fileCompression = *(reinterpret_cast<SaUint32T *>(value));
+      TRACE("fileCompression: %u", stream->fileCompression);
     }
   }
 
@@ -3253,6 +3292,7 @@ int lgs_get_streamobj_attr(SaImmAttrValuesT_2 ***attrib_out,
       const_cast<char *>("saLogStreamSeverityFilter"),
       const_cast<char *>("saLogStreamCreationTimestamp"),
       const_cast<char *>("saLogStreamFacilityId"),
+      const_cast<char *>("saLogStreamFileCompression"),
       NULL};
 
   TRACE_ENTER2("object_name_in \"%s\"", object_name_in.c_str());
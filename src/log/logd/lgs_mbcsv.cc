@@ -23,6 +23,7 @@
 
 #include "osaf/immutil/immutil.h"
 #include "log/logd/lgs_dest.h"
+#include "log/logd/lgs_mbcsv_v10.h"
 #include "log/logd/lgs_mbcsv_v9.h"
 #include "log/logd/lgs_mbcsv_v8.h"
 #include "log/logd/lgs_mbcsv_v6.h"
@@ -67,6 +68,12 @@
  * Version 6: Added client version to initialized message data structure. A new
  * data structure is lgsv_ckpt_msg_v6_t which is used for checkpoint.
  *
+ * Version 10: Added the LGS_CKPT_LOG_WRITE_BATCH record, one record for the
+ * log records written to a stream in one batch, and the
+ * LGS_CKPT_CFG_STREAM_COMPRESSION record, the compression of a configuration
+ * stream's rotated log files. The data structure `lgsv_ckpt_msg_v9_t` is
+ * re-used.
+ *
  */
 
 static uint32_t ckpt_proc_initialize_client(lgs_cb_t *cb, void *data);
@@ -113,7 +120,9 @@ static LGS_CKPT_HDLR ckpt_data_handler[] = {
     ckpt_proc_lgs_cfg_v5,
     ckpt_proc_push_async,
     ckpt_proc_pop_async,
-    ckpt_proc_pop_write_async
+    ckpt_proc_pop_write_async,
+    ckpt_proc_write_log_batch,
+    ckpt_proc_stream_compression
 };
 
 /****************************************************************************
@@ -589,6 +598,14 @@ bool lgs_is_peer_v9() {
   return (lgs_cb->mbcsv_peer_version >= LGS_MBCSV_VERSION_9);
 }
 
+/**
+ * Check if peer is version 10 (or later)
+ * @return bool
+ */
+bool lgs_is_peer_v10() {
+  return (lgs_cb->mbcsv_peer_version >= LGS_MBCSV_VERSION_10);
+}
+
 /**
  * Check if configured for split file system.
  * If other node is version 1 split file system mode is not applicable.
@@ -1621,6 +1638,20 @@ static uint32_t ckpt_decode_async_update(lgs_cb_t *cb,
         goto done;
       }
       break;
+    case LGS_CKPT_LOG_WRITE_BATCH:
+      TRACE("LGS_CKPT_LOG_WRITE_BATCH");
+      rc = DecodeWriteLogBatch(cb, ckpt_msg, cbk_arg);
+      if (rc != NCSCC_RC_SUCCESS) {
+        goto done;
+      }
+      break;
+    case LGS_CKPT_CFG_STREAM_COMPRESSION:
+      TRACE("LGS_CKPT_CFG_STREAM_COMPRESSION");
+      rc = DecodeStreamCompression(cb, ckpt_msg, cbk_arg);
+      if (rc != NCSCC_RC_SUCCESS) {
+        goto done;
+      }
+      break;
     default:
       rc = NCSCC_RC_FAILURE;
       TRACE("\tFAILED Unknown ckpt record type");
@@ -2017,7 +2048,7 @@ static SaTimeT setLogTime() {
  * @param stream
  * @param message
  */
-static void insert_localmsg_in_stream(log_stream_t *stream, char *message) {
+void insert_localmsg_in_stream(log_stream_t *stream, char *message) {
   int n = 0;
   int rc = 0;
   SaLogRecordT log_record;
@@ -3163,7 +3194,9 @@ int32_t ckpt_msg_test_type(NCSCONTEXT arg) {
     LCL_TEST_JUMP_OFFSET_LGS_CKPT_LGS_CFG,
     LCL_TEST_JUMP_OFFSET_LGS_CKPT_PUSH_ASYNC,
     LCL_TEST_JUMP_OFFSET_LGS_CKPT_POP_ASYNC,
-    LCL_TEST_JUMP_OFFSET_LGS_CKPT_POP_WRITE_ASYNC
+    LCL_TEST_JUMP_OFFSET_LGS_CKPT_POP_WRITE_ASYNC,
+    LCL_TEST_JUMP_OFFSET_LGS_CKPT_WRITE_LOG_BATCH,
+    LCL_TEST_JUMP_OFFSET_LGS_CKPT_STREAM_COMPRESSION
   };
   lgsv_ckpt_msg_type_t ckpt_rec_type;
 
@@ -3195,6 +3228,10 @@ int32_t ckpt_msg_test_type(NCSCONTEXT arg) {
       return LCL_TEST_JUMP_OFFSET_LGS_CKPT_POP_ASYNC;
     case LGS_CKPT_POP_WRITE_ASYNC:
       return LCL_TEST_JUMP_OFFSET_LGS_CKPT_POP_WRITE_ASYNC;
+    case LGS_CKPT_LOG_WRITE_BATCH:
+      return LCL_TEST_JUMP_OFFSET_LGS_CKPT_WRITE_LOG_BATCH;
+    case LGS_CKPT_CFG_STREAM_COMPRESSION:
+      return LCL_TEST_JUMP_OFFSET_LGS_CKPT_STREAM_COMPRESSION;
     default:
       return EDU_EXIT;
       break;
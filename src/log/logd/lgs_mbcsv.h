@@ -44,9 +44,10 @@
 #define LGS_MBCSV_VERSION_7 7
 #define LGS_MBCSV_VERSION_8 8
 #define LGS_MBCSV_VERSION_9 9
+#define LGS_MBCSV_VERSION_10 10
 
 /* Current version */
-#define LGS_MBCSV_VERSION 9
+#define LGS_MBCSV_VERSION 10
 #define LGS_MBCSV_VERSION_MIN 1
 
 /* Checkpoint message types(Used as 'reotype' w.r.t mbcsv)  */
@@ -70,6 +71,8 @@ typedef enum {
   LGS_CKPT_PUSH_ASYNC,
   LGS_CKPT_POP_ASYNC,
   LGS_CKPT_POP_WRITE_ASYNC,
+  LGS_CKPT_LOG_WRITE_BATCH,
+  LGS_CKPT_CFG_STREAM_COMPRESSION,
   LGS_CKPT_MSG_MAX
 } lgsv_ckpt_msg_type_t;
 
@@ -124,6 +127,7 @@ bool lgs_is_peer_v6();
 bool lgs_is_peer_v7();
 bool lgs_is_peer_v8();
 bool lgs_is_peer_v9();
+bool lgs_is_peer_v10();
 
 bool lgs_is_split_file_system();
 uint32_t lgs_mbcsv_dispatch(NCS_MBCSV_HDL mbcsv_hdl);
@@ -156,6 +160,7 @@ uint32_t dec_ckpt_header(NCS_UBAID *uba, lgsv_ckpt_header_t *header);
 uint32_t process_ckpt_data(lgs_cb_t *cb, void *data);
 uint32_t WriteOnStandby(log_stream_t* stream, uint64_t timestamp,
                         char* file_current, char* logRecord);
+void insert_localmsg_in_stream(log_stream_t *stream, char *message);
 
 
 #endif  // LOG_LOGD_LGS_MBCSV_H_
@@ -0,0 +1,269 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+#include "log/logd/lgs_mbcsv_v10.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "base/logtrace.h"
+#include "log/logd/lgs_mbcsv_v9.h"
+
+// The records are carried in one string that is encoded with ncs_edp_string,
+// which has a 16 bits length including the terminating null character.
+static const size_t kMaxLogRecordsLen = UINT16_MAX - 1;
+
+uint32_t EncodeDecodeWriteLogBatch(EDU_HDL* edu_hdl, EDU_TKN* edu_tkn,
+                                   NCSCONTEXT ptr, uint32_t* ptr_data_len,
+                                   EDU_BUF_ENV* buf_env, EDP_OP_TYPE op,
+                                   EDU_ERR* o_err) {
+  TRACE_ENTER();
+  CkptWriteLogBatch* ckpt_write_log_batch = nullptr;
+  CkptWriteLogBatch** ckpt_write_log_batch_dec_ptr;
+  EDU_INST_SET ckpt_write_log_batch_rec_ed_rules[] = {
+    {EDU_START, EncodeDecodeWriteLogBatch, 0, 0, 0,
+     sizeof(CkptWriteLogBatch), 0, nullptr},
+    {EDU_EXEC, ncs_edp_uns32, 0, 0, 0,
+     (long)&((CkptWriteLogBatch*)0)->stream_id, 0, nullptr},
+    {EDU_EXEC, ncs_edp_uns32, 0, 0, 0,
+     (long)&((CkptWriteLogBatch*)0)->record_id, 0, nullptr},
+    {EDU_EXEC, ncs_edp_uns32, 0, 0, 0,
+     (long)&((CkptWriteLogBatch*)0)->file_size, 0, nullptr},
+    {EDU_EXEC, ncs_edp_string, 0, 0, 0,
+     (long)&((CkptWriteLogBatch*)0)->log_file, 0, nullptr},
+    {EDU_EXEC, ncs_edp_uns64, 0, 0, 0,
+     (long)&((CkptWriteLogBatch*)0)->timestamp, 0, nullptr},
+    {EDU_EXEC, ncs_edp_uns32, 0, 0, 0,
+     (long)&((CkptWriteLogBatch*)0)->first_record_id, 0, nullptr},
+    {EDU_EXEC, ncs_edp_uns32, 0, 0, 0,
+     (long)&((CkptWriteLogBatch*)0)->num_records, 0, nullptr},
+    {EDU_EXEC, ncs_edp_string, 0, 0, 0,
+     (long)&((CkptWriteLogBatch*)0)->log_records, 0, nullptr},
+    {EDU_END, 0, 0, 0, 0, 0, 0, nullptr},
+  };
+
+  if (op == EDP_OP_TYPE_ENC) {
+    ckpt_write_log_batch = static_cast<CkptWriteLogBatch*>(ptr);
+  } else if (op == EDP_OP_TYPE_DEC) {
+    ckpt_write_log_batch_dec_ptr = static_cast<CkptWriteLogBatch**>(ptr);
+    if (*ckpt_write_log_batch_dec_ptr == nullptr) {
+      *o_err = EDU_ERR_MEM_FAIL;
+      return NCSCC_RC_FAILURE;
+    }
+    memset(*ckpt_write_log_batch_dec_ptr, 0, sizeof(CkptWriteLogBatch));
+    ckpt_write_log_batch = *ckpt_write_log_batch_dec_ptr;
+  } else {
+    ckpt_write_log_batch = static_cast<CkptWriteLogBatch*>(ptr);
+  }
+
+  return m_NCS_EDU_RUN_RULES(edu_hdl, edu_tkn,
+                             ckpt_write_log_batch_rec_ed_rules,
+                             ckpt_write_log_batch, ptr_data_len, buf_env,
+                             op, o_err);
+}
+
+uint32_t DecodeWriteLogBatch(lgs_cb_t* cb, void* ckpt_msg,
+                             NCS_MBCSV_CB_ARG* cbk_arg) {
+  assert(lgs_is_peer_v10());
+  TRACE_ENTER();
+  auto ckpt_msg_v9 = static_cast<lgsv_ckpt_msg_v9_t*>(ckpt_msg);
+  auto data = &ckpt_msg_v9->ckpt_rec.write_log_batch;
+  uint32_t rc = ckpt_decode_log_struct(cb, cbk_arg, ckpt_msg, data,
+                                       EncodeDecodeWriteLogBatch);
+  if (rc == NCSCC_RC_REQ_TIMOUT) {
+    // The records cannot be decoded again. The standby will insert a
+    // "Possible loss of log record" when the next batch is received.
+    LOG_NO("Timeout when writing %u checkpointed records", data->num_records);
+    rc = NCSCC_RC_SUCCESS;
+  }
+  return rc;
+}
+
+uint32_t ckpt_proc_write_log_batch(lgs_cb_t* cb, void* data) {
+  TRACE_ENTER();
+  assert(lgs_is_peer_v10() && "The peer should run with V10 or beyond!");
+  auto data_v9 = static_cast<lgsv_ckpt_msg_v9_t*>(data);
+  auto param = &data_v9->ckpt_rec.write_log_batch;
+  char* log_records = param->log_records;
+
+  log_stream_t* stream = log_stream_get_by_id(param->stream_id);
+  if (stream == nullptr) {
+    TRACE("Could not lookup stream: %u", param->stream_id);
+    lgs_free_edu_mem(log_records);
+    lgs_free_edu_mem(param->log_file);
+    return NCSCC_RC_SUCCESS;
+  }
+
+  stream->logRecordId = param->record_id;
+  stream->curFileSize = param->file_size;
+  stream->logFileCurrent = param->log_file;
+  lgs_free_edu_mem(param->log_file);
+
+  int rc = 0;
+  if (lgs_is_split_file_system() && (log_records != nullptr) &&
+      (param->num_records != 0)) {
+    stream->act_last_close_timestamp = param->timestamp;
+    if ((stream->stb_logRecordId + 1) != param->first_record_id) {
+      insert_localmsg_in_stream(
+          stream, const_cast<char*>("Possible loss of log record"));
+    }
+
+    rc = log_stream_write_h(stream, log_records, strlen(log_records));
+    if (rc != 0) {
+      TRACE("\tError %d when writing %u log records", rc, param->num_records);
+    }
+
+    stream->stb_logRecordId = param->first_record_id + param->num_records - 1;
+  }
+
+  // As in WriteOnStandby(), the file handling thread frees the records if
+  // the write timed out.
+  if (rc != -2) lgs_free_edu_mem(log_records);
+  return (rc == -2 ? NCSCC_RC_REQ_TIMOUT : NCSCC_RC_SUCCESS);
+}
+
+static void SendWriteLogBatch(log_stream_t* stream, uint32_t first_record_id,
+                              uint32_t num_records, const std::string& records) {
+  lgsv_ckpt_msg_v9_t ckpt_v9;
+  memset(&ckpt_v9, 0, sizeof(ckpt_v9));
+  ckpt_v9.header.ckpt_rec_type = LGS_CKPT_LOG_WRITE_BATCH;
+  ckpt_v9.header.num_ckpt_records = 1;
+  ckpt_v9.header.data_len = 1;
+
+  auto data = &ckpt_v9.ckpt_rec.write_log_batch;
+  data->stream_id       = stream->streamId;
+  data->record_id       = stream->logRecordId;
+  data->file_size       = stream->curFileSize;
+  data->log_file        = const_cast<char*>(stream->logFileCurrent.c_str());
+  data->timestamp       = stream->act_last_close_timestamp;
+  data->first_record_id = first_record_id;
+  data->num_records     = num_records;
+  data->log_records     = const_cast<char*>(records.c_str());
+  (void)lgs_ckpt_send_async(lgs_cb, &ckpt_v9, NCS_MBCSV_ACT_ADD);
+}
+
+void lgs_ckpt_log_batch_async(log_stream_t* stream, uint32_t first_record_id,
+                              const iovec* records, size_t num_records) {
+  TRACE_ENTER2("stream id: %u, records: %zu", stream->streamId, num_records);
+  if ((lgs_cb->ha_state == SA_AMF_HA_ACTIVE) && (num_records != 0)) {
+    if (lgs_is_split_file_system() == false) {
+      // Only the stream state is needed by the standby.
+      SendWriteLogBatch(stream, first_record_id, num_records, std::string{});
+    } else {
+      std::string chunk;
+      uint32_t chunk_first = first_record_id;
+      uint32_t chunk_records = 0;
+      for (size_t i = 0; i < num_records; i++) {
+        if ((chunk_records != 0) &&
+            (chunk.size() + records[i].iov_len > kMaxLogRecordsLen)) {
+          SendWriteLogBatch(stream, chunk_first, chunk_records, chunk);
+          chunk_first += chunk_records;
+          chunk_records = 0;
+          chunk.clear();
+        }
+        chunk.append(static_cast<const char*>(records[i].iov_base),
+                     records[i].iov_len);
+        chunk_records++;
+      }
+      SendWriteLogBatch(stream, chunk_first, chunk_records, chunk);
+    }
+  }
+
+  // See lgs_ckpt_log_async()
+  stream->stb_logRecordId = stream->logRecordId;
+}
+
+uint32_t EncodeDecodeStreamCompression(EDU_HDL* edu_hdl, EDU_TKN* edu_tkn,
+                                       NCSCONTEXT ptr, uint32_t* ptr_data_len,
+                                       EDU_BUF_ENV* buf_env, EDP_OP_TYPE op,
+                                       EDU_ERR* o_err) {
+  TRACE_ENTER();
+  CkptStreamCompression* ckpt_stream_compression = nullptr;
+  CkptStreamCompression** ckpt_stream_compression_dec_ptr;
+  EDU_INST_SET ckpt_stream_compression_rec_ed_rules[] = {
+    {EDU_START, EncodeDecodeStreamCompression, 0, 0, 0,
+     sizeof(CkptStreamCompression), 0, nullptr},
+    {EDU_EXEC, ncs_edp_string, 0, 0, 0,
+     (long)&((CkptStreamCompression*)0)->name, 0, nullptr},
+    {EDU_EXEC, ncs_edp_uns32, 0, 0, 0,
+     (long)&((CkptStreamCompression*)0)->compression, 0, nullptr},
+    {EDU_END, 0, 0, 0, 0, 0, 0, nullptr},
+  };
+
+  if (op == EDP_OP_TYPE_ENC) {
+    ckpt_stream_compression = static_cast<CkptStreamCompression*>(ptr);
+  } else if (op == EDP_OP_TYPE_DEC) {
+    ckpt_stream_compression_dec_ptr =
+        static_cast<CkptStreamCompression**>(ptr);
+    if (*ckpt_stream_compression_dec_ptr == nullptr) {
+      *o_err = EDU_ERR_MEM_FAIL;
+      return NCSCC_RC_FAILURE;
+    }
+    memset(*ckpt_stream_compression_dec_ptr, 0,
+           sizeof(CkptStreamCompression));
+    ckpt_stream_compression = *ckpt_stream_compression_dec_ptr;
+  } else {
+    ckpt_stream_compression = static_cast<CkptStreamCompression*>(ptr);
+  }
+
+  return m_NCS_EDU_RUN_RULES(edu_hdl, edu_tkn,
+                             ckpt_stream_compression_rec_ed_rules,
+                             ckpt_stream_compression, ptr_data_len, buf_env,
+                             op, o_err);
+}
+
+uint32_t DecodeStreamCompression(lgs_cb_t* cb, void* ckpt_msg,
+                                 NCS_MBCSV_CB_ARG* cbk_arg) {
+  assert(lgs_is_peer_v10());
+  TRACE_ENTER();
+  auto ckpt_msg_v9 = static_cast<lgsv_ckpt_msg_v9_t*>(ckpt_msg);
+  auto data = &ckpt_msg_v9->ckpt_rec.stream_compression;
+  return ckpt_decode_log_struct(cb, cbk_arg, ckpt_msg, data,
+                                EncodeDecodeStreamCompression);
+}
+
+uint32_t ckpt_proc_stream_compression(lgs_cb_t* cb, void* data) {
+  TRACE_ENTER();
+  assert(lgs_is_peer_v10() && "The peer should run with V10 or beyond!");
+  auto data_v9 = static_cast<lgsv_ckpt_msg_v9_t*>(data);
+  auto param = &data_v9->ckpt_rec.stream_compression;
+
+  log_stream_t* stream = log_stream_get_by_name(param->name);
+  if (stream == nullptr) {
+    TRACE("Could not lookup stream: %s", param->name);
+  } else {
+    TRACE("Stream %s, compression: %u", param->name, param->compression);
+    stream->fileCompression = param->compression;
+  }
+
+  lgs_free_edu_mem(param->name);
+  return NCSCC_RC_SUCCESS;
+}
+
+void lgs_ckpt_stream_compression(log_stream_t* stream) {
+  TRACE_ENTER2("stream: %s", stream->name.c_str());
+  lgsv_ckpt_msg_v9_t ckpt_v9;
+  memset(&ckpt_v9, 0, sizeof(ckpt_v9));
+  ckpt_v9.header.ckpt_rec_type = LGS_CKPT_CFG_STREAM_COMPRESSION;
+  ckpt_v9.header.num_ckpt_records = 1;
+  ckpt_v9.header.data_len = 1;
+
+  auto data = &ckpt_v9.ckpt_rec.stream_compression;
+  data->name = const_cast<char*>(stream->name.c_str());
+  data->compression = stream->fileCompression;
+  (void)lgs_ckpt_send_async(lgs_cb, &ckpt_v9, NCS_MBCSV_ACT_ADD);
+}
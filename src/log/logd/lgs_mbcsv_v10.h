@@ -0,0 +1,78 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+#ifndef LOG_LOGD_LGS_MBCSV_V10_H_
+#define LOG_LOGD_LGS_MBCSV_V10_H_
+
+#include <sys/uio.h>
+
+#include "log/logd/lgs.h"
+#include "base/ncs_edu_pub.h"
+#include "base/ncsencdec_pub.h"
+
+// Checkpoint of a batch of log records written to one stream. Replaces the
+// LGS_CKPT_LOG_WRITE record per log record when the records have been written
+// in one batch (see Cache::FlushBatch). The records are written to the same
+// log file, and the stream state (record id, file size and current file) is
+// the state after they were written, including a rotation of the file.
+// In split file system mode `log_records` holds the records of the batch
+// concatenated, otherwise it is nullptr. `first_record_id` and `num_records`
+// tell which records are carried, so the standby can detect lost records.
+struct CkptWriteLogBatch {
+  uint32_t stream_id;
+  uint32_t record_id;
+  uint32_t file_size;
+  char* log_file;
+  uint64_t timestamp;
+  uint32_t first_record_id;
+  uint32_t num_records;
+  char* log_records;
+};
+
+uint32_t EncodeDecodeWriteLogBatch(EDU_HDL* edu_hdl, EDU_TKN* edu_tkn,
+                                   NCSCONTEXT ptr, uint32_t* ptr_data_len,
+                                   EDU_BUF_ENV* buf_env, EDP_OP_TYPE op,
+                                   EDU_ERR* o_err);
+uint32_t DecodeWriteLogBatch(lgs_cb_t* cb, void* ckpt_msg,
+                             NCS_MBCSV_CB_ARG* cbk_arg);
+uint32_t ckpt_proc_write_log_batch(lgs_cb_t* cb, void* data);
+
+// Checkpoint of the compression of a configuration stream's rotated log
+// files (saLogStreamFileCompression). Sent after LGS_CKPT_CFG_STREAM.
+struct CkptStreamCompression {
+  char* name;
+  uint32_t compression;
+};
+
+uint32_t EncodeDecodeStreamCompression(EDU_HDL* edu_hdl, EDU_TKN* edu_tkn,
+                                       NCSCONTEXT ptr, uint32_t* ptr_data_len,
+                                       EDU_BUF_ENV* buf_env, EDP_OP_TYPE op,
+                                       EDU_ERR* o_err);
+uint32_t DecodeStreamCompression(lgs_cb_t* cb, void* ckpt_msg,
+                                 NCS_MBCSV_CB_ARG* cbk_arg);
+uint32_t ckpt_proc_stream_compression(lgs_cb_t* cb, void* data);
+
+// Checkpoint the compression of the stream. Only valid on active and if the
+// peer is version 10.
+void lgs_ckpt_stream_compression(log_stream_t* stream);
+
+// Checkpoint the given records, just written to the stream's log file, to the
+// standby in as few messages as possible. `first_record_id` is the record id
+// of the first record. Only valid on active and if the peer is version 10.
+void lgs_ckpt_log_batch_async(log_stream_t* stream,
+                              uint32_t first_record_id, const iovec* records,
+                              size_t num_records);
+
+#endif  // LOG_LOGD_LGS_MBCSV_V10_H_
@@ -237,6 +237,19 @@ uint32_t edp_ed_ckpt_msg_v9(EDU_HDL *edu_hdl, EDU_TKN *edu_tkn, NCSCONTEXT ptr,
                        ->ckpt_rec.pop_and_write_async,
        0, nullptr},
 
+      /* Write log records in a batch */
+      {EDU_EXEC, EncodeDecodeWriteLogBatch, 0, 0, static_cast<int>(EDU_EXIT),
+       (int64_t) & (reinterpret_cast<lgsv_ckpt_msg_v9_t *>(0))
+                       ->ckpt_rec.write_log_batch,
+       0, nullptr},
+
+      /* Compression of a configuration stream's rotated log files */
+      {EDU_EXEC, EncodeDecodeStreamCompression, 0, 0,
+       static_cast<int>(EDU_EXIT),
+       (int64_t) & (reinterpret_cast<lgsv_ckpt_msg_v9_t *>(0))
+                       ->ckpt_rec.stream_compression,
+       0, nullptr},
+
       {EDU_END, 0, 0, 0, 0, 0, 0, nullptr},
   };
 
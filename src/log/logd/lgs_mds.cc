@@ -23,9 +23,9 @@
 #include "base/osaf_time.h"
 #include "base/osaf_extended_name.h"
 
-#define LGS_SVC_PVT_SUBPART_VERSION 2
+#define LGS_SVC_PVT_SUBPART_VERSION 3
 #define LGS_WRT_LGA_SUBPART_VER_AT_MIN_MSG_FMT 1
-#define LGS_WRT_LGA_SUBPART_VER_AT_MAX_MSG_FMT 2
+#define LGS_WRT_LGA_SUBPART_VER_AT_MAX_MSG_FMT 3
 #define LGS_WRT_LGA_SUBPART_VER_RANGE       \
   (LGS_WRT_LGA_SUBPART_VER_AT_MAX_MSG_FMT - \
    LGS_WRT_LGA_SUBPART_VER_AT_MIN_MSG_FMT + 1)
@@ -34,7 +34,8 @@
 static MDS_CLIENT_MSG_FORMAT_VER
     LGS_WRT_LGA_MSG_FMT_ARRAY[LGS_WRT_LGA_SUBPART_VER_RANGE] = {
         1, /*msg format version for LGA subpart version 1 */
-        2  /*msg format version for LGA subpart version 2 */
+        2, /*msg format version for LGA subpart version 2 */
+        3  /*msg format version for LGA subpart version 3 */
 };
 
 /****************************************************************************
@@ -547,6 +548,84 @@ err_done:
   return rc;
 }
 
+/****************************************************************************
+  Name          : dec_write_log_async_batch_msg
+
+  Description   : This routine decodes a batch of write async log requests.
+                  Each request is decoded into an event of its own with API
+                  type LGSV_WRITE_LOG_ASYNC_REQ. The first request is decoded
+                  into @evt and the others are linked to it using the next
+                  pointer.
+
+  Arguments     : NCS_UBAID *msg,
+                  lgsv_lgs_evt_t *evt
+
+  Return Values : uint32_t
+
+  Notes         : If decoding fails, all but @evt is freed.
+******************************************************************************/
+static uint32_t dec_write_log_async_batch_msg(NCS_UBAID *uba,
+                                              lgsv_lgs_evt_t *evt) {
+  uint8_t *p8;
+  uint8_t local_data[4];
+  uint32_t rc = NCSCC_RC_SUCCESS;
+  uint32_t num_records, num_decoded = 0;
+  lgsv_lgs_evt_t *last_evt = NULL;
+
+  p8 = ncs_dec_flatten_space(uba, local_data, 4);
+  num_records = ncs_decode_32bit(&p8);
+  ncs_dec_skip_space(uba, 4);
+
+  if (num_records == 0) {
+    LOG_WA("Batch of write requests is empty");
+    return NCSCC_RC_FAILURE;
+  }
+
+  while (num_decoded < num_records) {
+    lgsv_lgs_evt_t *rec_evt = evt;
+    if (num_decoded > 0) {
+      rec_evt =
+          static_cast<lgsv_lgs_evt_t *>(calloc(1, sizeof(lgsv_lgs_evt_t)));
+      if (rec_evt == NULL) {
+        LOG_WA("calloc FAILED");
+        rc = NCSCC_RC_FAILURE;
+        goto err_done;
+      }
+    }
+
+    rec_evt->info.msg.type = LGSV_LGA_API_MSG;
+    rec_evt->info.msg.info.api_info.type = LGSV_WRITE_LOG_ASYNC_REQ;
+    rc = dec_write_log_async_msg(uba, &rec_evt->info.msg);
+    if (rc != NCSCC_RC_SUCCESS) {
+      if (rec_evt != evt) free(rec_evt);
+      goto err_done;
+    }
+
+    if (last_evt != NULL) last_evt->next = rec_evt;
+    last_evt = rec_evt;
+    num_decoded++;
+  }
+
+  TRACE_8("LGSV_WRITE_LOG_ASYNC_BATCH_REQ, %u records", num_records);
+  return rc;
+
+err_done:
+  /* Free the requests decoded so far. @evt itself is freed by the caller */
+  if (num_decoded > 0) {
+    lgsv_lgs_evt_t *rec_evt = evt;
+    while (rec_evt != NULL) {
+      lgsv_lgs_evt_t *next_evt = rec_evt->next;
+      lgs_free_write_log(
+          &rec_evt->info.msg.info.api_info.param.write_log_async);
+      if (rec_evt != evt) free(rec_evt);
+      rec_evt = next_evt;
+    }
+    evt->next = NULL;
+  }
+  TRACE_8("LGSV_WRITE_LOG_ASYNC_BATCH_REQ (error)");
+  return rc;
+}
+
 /****************************************************************************
   Name          : enc_initialize_rsp_msg
 
@@ -906,6 +985,9 @@ static uint32_t mds_dec(struct ncsmds_callback_info *info) {
       case LGSV_WRITE_LOG_ASYNC_REQ:
         rc = dec_write_log_async_msg(uba, &evt->info.msg);
         break;
+      case LGSV_WRITE_LOG_ASYNC_BATCH_REQ:
+        rc = dec_write_log_async_batch_msg(uba, evt);
+        break;
       default:
         break;
     }
@@ -1011,6 +1093,64 @@ static NCS_IPC_PRIORITY getmboxprio(const lgsv_api_info_t *api_info) {
     return LGS_IPC_PRIO_APP_STREAM;
 }
 
+/* Number of writes silently discarded per mailbox priority */
+static unsigned long silently_discarded[NCS_IPC_PRIORITY_MAX];
+
+/**
+ * Put a write request in the mailbox. If the mailbox is full the write is
+ * nacked or silently dropped and the event is freed.
+ *
+ * @param evt
+ */
+static void mbx_send_write_evt(lgsv_lgs_evt_t *evt) {
+  const lgsv_api_info_t *api_info = &evt->info.msg.info.api_info;
+  NCS_IPC_PRIORITY prio = getmboxprio(api_info);
+
+  /* Can only get here for writes */
+  osafassert(api_info->type == LGSV_WRITE_LOG_ASYNC_REQ);
+
+  /* Can we leave the mbox FULL state? */
+  if (mbox_full[prio] && (mbox_msgs[prio] <= mbox_low[prio])) {
+    mbox_full[prio] = false;
+    LOG_NO("discarded %lu writes, stream type: %s", silently_discarded[prio],
+           (prio == LGS_IPC_PRIO_APP_STREAM) ? "app" : "sys/not");
+    silently_discarded[prio] = 0;
+  }
+
+  /* If the mailbox is full, nack or silently drop */
+  if (mbox_full[prio]) {
+    /* If logger has requested an ack, send one with error code TRYAGAIN */
+    if (api_info->param.write_log_async.ack_flags & SA_LOG_RECORD_WRITE_ACK) {
+      lgs_send_write_log_ack(api_info->param.write_log_async.client_id,
+                             api_info->param.write_log_async.invocation,
+                             SA_AIS_ERR_TRY_AGAIN, evt->fr_dest);
+    } else
+      silently_discarded[prio]++;
+
+    goto donefree;
+  }
+
+  if (m_NCS_IPC_SEND(&lgs_mbx, evt, prio) == NCSCC_RC_SUCCESS) {
+    return;
+  } else {
+    mbox_full[prio] = true;
+    TRACE("FULL, msgs: %u, low: %u, high: %u", mbox_msgs[prio], mbox_low[prio],
+          mbox_high[prio]);
+
+    /* If logger has requested an ack, send one with error code TRYAGAIN */
+    if (api_info->param.write_log_async.ack_flags & SA_LOG_RECORD_WRITE_ACK) {
+      lgs_send_write_log_ack(api_info->param.write_log_async.client_id,
+                             api_info->param.write_log_async.invocation,
+                             SA_AIS_ERR_TRY_AGAIN, evt->fr_dest);
+    } else
+      silently_discarded[prio]++;
+  }
+
+donefree:
+  lgs_free_write_log(&api_info->param.write_log_async);
+  free(evt);
+}
+
 /****************************************************************************
  * Name          : mds_rcv
  *
@@ -1030,7 +1170,6 @@ static uint32_t mds_rcv(struct ncsmds_callback_info *mds_info) {
   lgsv_api_msg_type_t type = api_info->type;
   NCS_IPC_PRIORITY prio = NCS_IPC_PRIORITY_LOW;
   uint32_t rc = NCSCC_RC_SUCCESS;
-  static unsigned long silently_discarded[NCS_IPC_PRIORITY_MAX];
 
   /* Wait if the mailbox is being reinitialized in the main thread.
    */
@@ -1069,52 +1208,26 @@ static uint32_t mds_rcv(struct ncsmds_callback_info *mds_info) {
     goto done;
   }
 
-  /* LGSV_WRITE_LOG_ASYNC_REQ
+  /* LGSV_WRITE_LOG_ASYNC_REQ, possibly the first one of a batch of write
+   * requests. The requests of a batch are queued one by one in the order
+   * they were written.
    */
-  /* Can we leave the mbox FULL state? */
-  if (mbox_full[prio] && (mbox_msgs[prio] <= mbox_low[prio])) {
-    mbox_full[prio] = false;
-    LOG_NO("discarded %lu writes, stream type: %s", silently_discarded[prio],
-           (prio == LGS_IPC_PRIO_APP_STREAM) ? "app" : "sys/not");
-    silently_discarded[prio] = 0;
-  }
-
-  /* If the mailbox is full, nack or silently drop */
-  if (mbox_full[prio]) {
-    /* If logger has requested an ack, send one with error code TRYAGAIN */
-    if (api_info->param.write_log_async.ack_flags & SA_LOG_RECORD_WRITE_ACK) {
-      lgs_send_write_log_ack(api_info->param.write_log_async.client_id,
-                             api_info->param.write_log_async.invocation,
-                             SA_AIS_ERR_TRY_AGAIN, evt->fr_dest);
-    } else
-      silently_discarded[prio]++;
-
-    goto donefree;
-  }
-
-  /* Can only get here for writes */
-  osafassert(api_info->type == LGSV_WRITE_LOG_ASYNC_REQ);
-
-  if (m_NCS_IPC_SEND(&lgs_mbx, evt, prio) == NCSCC_RC_SUCCESS) {
-    goto done;
-  } else {
-    mbox_full[prio] = true;
-    TRACE("FULL, msgs: %u, low: %u, high: %u", mbox_msgs[prio], mbox_low[prio],
-          mbox_high[prio]);
-
-    /* If logger has requested an ack, send one with error code TRYAGAIN */
-    if (api_info->param.write_log_async.ack_flags & SA_LOG_RECORD_WRITE_ACK) {
-      lgs_send_write_log_ack(api_info->param.write_log_async.client_id,
-                             api_info->param.write_log_async.invocation,
-                             SA_AIS_ERR_TRY_AGAIN, evt->fr_dest);
-    } else
-      silently_discarded[prio]++;
+  while (evt != NULL) {
+    lgsv_lgs_evt_t *next_evt = evt->next;
+    evt->next = NULL;
+    if (next_evt != NULL) {
+      next_evt->evt_type = evt->evt_type;
+      next_evt->cb_hdl = evt->cb_hdl;
+      next_evt->fr_node_id = evt->fr_node_id;
+      next_evt->fr_dest = evt->fr_dest;
+      next_evt->rcvd_prio = evt->rcvd_prio;
+      next_evt->mds_ctxt = evt->mds_ctxt;
+      memcpy(next_evt->node_name, evt->node_name, _POSIX_HOST_NAME_MAX);
+    }
+    mbx_send_write_evt(evt);
+    evt = next_evt;
   }
 
-donefree:
-  lgs_free_write_log(&api_info->param.write_log_async);
-  free(evt);
-
 done:
   osaf_mutex_unlock_ordie(&lgs_mbox_init_mutex);
 
@@ -34,6 +34,7 @@
 #include "osaf/immutil/immutil.h"
 
 #include "log/logd/lgs.h"
+#include "log/logd/lgs_archive.h"
 #include "log/logd/lgs_config.h"
 #include "log/logd/lgs_file.h"
 #include "log/logd/lgs_filehdl.h"
@@ -52,13 +53,13 @@ static uint32_t numb_of_streams;
 
 static const uint32_t kInvalidId = static_cast<uint32_t>(-1);
 
+// Size of the buffer for the file names when the file index of a stream is
+// read, see files_index_read()
+static const size_t kFilesIndexReadSize = 256 * 1024;
+
 static int lgs_stream_array_insert(log_stream_t *stream, uint32_t id);
 static int lgs_stream_array_insert_new(log_stream_t *stream, uint32_t *id);
 static int lgs_stream_array_remove(int id);
-static int get_number_of_log_files_h(log_stream_t *logStream,
-                                     char *oldest_file);
-static int get_number_of_cfg_files_h(log_stream_t *logStream,
-                                     char *oldest_file);
 
 /**
  * Open/create a file for append in non blocking mode.
@@ -244,6 +245,69 @@ done:
   return rc;
 }
 
+/**
+ * Close a file of a stream without waiting for it, see log_file_api_async().
+ *
+ * @param stream
+ * @param fd [in]
+ * @return -1 if the request could not be queued
+ */
+static int fileclose_async(log_stream_t *stream, int fd) {
+  lgsf_apipar_t apipar;
+  int rc = 0;
+
+  TRACE_ENTER2("fd=%d", fd);
+
+  /* Fill in API structure */
+  apipar.req_code_in = LGSF_FILECLOSE;
+  apipar.data_in_size = sizeof(int);
+  apipar.data_in = &fd;
+  apipar.data_out_size = 0;
+  apipar.data_out = NULL;
+
+  if (log_file_api_async(stream->streamId, &apipar) != LGSF_SUCESS) rc = -1;
+
+  TRACE_LEAVE2("rc = %d", rc);
+  return rc;
+}
+
+/**
+ * Delete a file of a stream without waiting for it, see
+ * log_file_api_async().
+ *
+ * @param stream
+ * @param filepath A null terminated string containing the name of the file to
+ *        be deleted
+ * @return -1 if the request could not be queued
+ */
+static int file_unlink_async(log_stream_t *stream,
+                             const std::string &filepath) {
+  lgsf_apipar_t apipar;
+  size_t filepath_len;
+  int rc = 0;
+
+  TRACE_ENTER();
+
+  filepath_len = filepath.size() + 1;
+  if (filepath_len > PATH_MAX) {
+    LOG_WA("Cannot delete file, File path > PATH_MAX");
+    TRACE_LEAVE();
+    return -1;
+  }
+
+  /* Fill in API structure */
+  apipar.req_code_in = LGSF_DELETE_FILE;
+  apipar.data_in_size = filepath_len;
+  apipar.data_in = const_cast<char *>(filepath.c_str());
+  apipar.data_out_size = 0;
+  apipar.data_out = NULL;
+
+  if (log_file_api_async(stream->streamId, &apipar) != LGSF_SUCESS) rc = -1;
+
+  TRACE_LEAVE2("rc = %d", rc);
+  return rc;
+}
+
 /**
  * Delete config file.
  * @param stream
@@ -269,26 +333,206 @@ static int delete_config_file(log_stream_t *stream) {
   return rc;
 }
 
+/**
+ * Read the index of the log and cfg files of a stream from disk.
+ * See log_stream_t::files_index_valid
+ *
+ * @param stream
+ * @return false if error
+ */
+static bool files_index_read(log_stream_t *stream) {
+  lgsf_apipar_t apipar;
+  lgsf_retcode_t api_rc;
+  gnolfh_in_t parameters_in;
+
+  TRACE_ENTER();
+
+  /* Requests queued for the stream may rename or delete its files */
+  if (lgs_file_async_wait(stream->streamId) != LGSF_SUCESS) {
+    TRACE("%s - Queued file requests not done", __FUNCTION__);
+    return false;
+  }
+
+  std::string logsv_root_dir =
+      static_cast<const char *>(lgs_cfg_get(LGS_IMM_LOG_ROOT_DIRECTORY));
+
+  parameters_in.file_name = const_cast<char *>(stream->fileName.c_str());
+  parameters_in.logsv_root_dir = const_cast<char *>(logsv_root_dir.c_str());
+  parameters_in.pathName = const_cast<char *>(stream->pathName.c_str());
+
+  if ((stream->fileName.size() + logsv_root_dir.size() +
+       stream->pathName.size()) > PATH_MAX) {
+    LOG_WA("Path to log files > PATH_MAX");
+    return false;
+  }
+
+  std::vector<char> file_names(kFilesIndexReadSize);
+
+  /* Fill in API structure */
+  apipar.req_code_in = LGSF_GET_LOG_FILES;
+  apipar.data_in_size = sizeof(gnolfh_in_t);
+  apipar.data_in = &parameters_in;
+  apipar.data_out_size = file_names.size();
+  apipar.data_out = file_names.data();
+
+  api_rc = log_file_api(&apipar);
+  if (api_rc != LGSF_SUCESS) {
+    TRACE("%s - API error %s", __FUNCTION__, lgsf_retcode_str(api_rc));
+    return false;
+  }
+  if (apipar.hdl_ret_code_out == -1) return false;
+
+  /* Two lists of '\0' terminated names, each terminated by '\0' */
+  const char *name = file_names.data();
+  stream->cfg_files.clear();
+  for (; *name != '\0'; name += strlen(name) + 1) {
+    stream->cfg_files.push_back(name);
+  }
+  stream->log_files.clear();
+  for (name++; *name != '\0'; name += strlen(name) + 1) {
+    stream->log_files.push_back(name);
+  }
+  stream->log_files_unlisted = apipar.hdl_ret_code_out;
+  stream->files_index_valid = true;
+
+  TRACE_LEAVE2("log files: %zu, unlisted: %d, cfg files: %zu",
+               stream->log_files.size(), stream->log_files_unlisted,
+               stream->cfg_files.size());
+  return true;
+}
+
+/**
+ * Update the file index when a log file of the stream has been renamed.
+ *
+ * @param stream
+ * @param old_name[in] file name without path
+ * @param new_name[in] file name without path
+ */
+static void files_index_rename(log_stream_t *stream,
+                               const std::string &old_name,
+                               const std::string &new_name) {
+  if (stream->files_index_valid == false) return;
+
+  auto it = std::find(stream->log_files.rbegin(), stream->log_files.rend(),
+                      old_name);
+  if (it != stream->log_files.rend()) {
+    /* The time stamp of the file name is the open time. It is not changed
+     * so the file keeps its place
+     */
+    *it = new_name;
+  } else {
+    TRACE("%s not in file index", old_name.c_str());
+    stream->files_index_valid = false;
+  }
+}
+
+/**
+ * Update the file index when a log file of the stream has been removed.
+ *
+ * @param stream
+ * @param name[in] file name without path
+ */
+static void files_index_erase(log_stream_t *stream, const std::string &name) {
+  if (stream->files_index_valid == false) return;
+
+  auto it = std::find(stream->log_files.begin(), stream->log_files.end(),
+                      name);
+  if (it != stream->log_files.end()) stream->log_files.erase(it);
+}
+
+/**
+ * Compare the time stamps in the names of two files of a stream.
+ *
+ * @return true if file1 is as old as or older than file2
+ */
+static bool file_is_older(log_stream_t *stream, const std::string &file1,
+                          const std::string &file2) {
+  int date1, time1, date2, time2;
+  (void)lgs_get_file_time(file1.c_str(), stream->fileName, &date1, &time1);
+  (void)lgs_get_file_time(file2.c_str(), stream->fileName, &date2, &time2);
+  return (date1 < date2) || ((date1 == date2) && (time1 <= time2));
+}
+
+/**
+ * A log file has been closed and renamed to get the "close timestamp", or
+ * the rename has been requested, see lgs_file_rename_async().
+ * Update the file index and compress the file if configured. The file is
+ * queued for compression by the file thread of the stream after the rename.
+ *
+ * @param root_path[in]
+ * @param stream
+ * @param filename[in] file name before rename without ".log"
+ * @param close_time[in] "close timestamp" added to the file name
+ */
+static void log_file_closed(const std::string &root_path,
+                            log_stream_t *stream, const std::string &filename,
+                            const std::string &close_time) {
+  const std::string closed_name = filename + "_" + close_time + ".log";
+  lgsf_apipar_t apipar;
+
+  files_index_rename(stream, filename + ".log", closed_name);
+  if (stream->fileCompression == Compression::kNone) return;
+
+  const std::string closed_path =
+      root_path + "/" + stream->pathName + "/" + closed_name;
+  size_t params_in_size = sizeof(afh_t) + closed_path.size() + 1;
+  void *params_in = malloc(params_in_size);
+  osafassert(params_in);
+  static_cast<afh_t *>(params_in)->compression = stream->fileCompression;
+  memcpy(static_cast<char *>(params_in) + sizeof(afh_t), closed_path.c_str(),
+         closed_path.size() + 1);
+
+  /* Fill in API structure */
+  apipar.req_code_in = LGSF_ARCHIVE_FILE;
+  apipar.data_in_size = params_in_size;
+  apipar.data_in = params_in;
+  apipar.data_out_size = 0;
+  apipar.data_out = NULL;
+
+  if (log_file_api_async(stream->streamId, &apipar) != LGSF_SUCESS) {
+    LOG_NO("Could not compress %s", closed_path.c_str());
+  }
+  free(params_in);
+}
+
 /**
  * Remove oldest log and cfg files on disk.
  * If the parameter @number_files_to_remove is zero, remove older log and cfg
  * files until there are "maxFilesRotated" - 1 files left on disk.
  *
+ * The files on disk are only read if the file index of the stream is not
+ * valid, see log_stream_t::files_index_valid.
+ * A cfg file is removed if it is older than the oldest log file.
+ * The files are removed by the file thread of the stream without waiting
+ * for it, see log_file_api_async(). If removing a file fails, the index is
+ * read again at the next call.
+ *
  * @param stream
  * @param number_files_to_remove
  * @return true/false
  */
 bool remove_oldest_log_files(log_stream_t *stream,
                              int number_files_to_remove) {
-  char oldest_log_file[PATH_MAX];
-  char oldest_cfg_file[PATH_MAX];
   int max_files_rotated = static_cast<int>(stream->maxFilesRotated) - 1;
 
   TRACE_ENTER2("num: %d", number_files_to_remove);
+  LgsFileAffinity affinity(stream->streamId);
+
+  if (lgs_file_async_failed(stream->streamId) == true) {
+    TRACE("Queued file request failed, read the file index");
+    stream->files_index_valid = false;
+  }
+  if ((stream->files_index_valid == false) &&
+      (files_index_read(stream) == false)) {
+    return false;
+  }
 
-  // Get number of log files and the oldest log file
-  int log_file_cnt = get_number_of_log_files_h(stream, oldest_log_file);
-  if (log_file_cnt == -1) return false;
+  const std::string path =
+      static_cast<const char *>(lgs_cfg_get(LGS_IMM_LOG_ROOT_DIRECTORY)) +
+      std::string("/") + stream->pathName + "/";
+
+  // Get number of log files
+  int log_file_cnt = stream->log_files.size() + stream->log_files_unlisted;
 
   if (number_files_to_remove != 0) {
     // If there are not enough number of log file to remove, return true
@@ -301,30 +545,48 @@ bool remove_oldest_log_files(log_stream_t *stream,
   }
 
   while (log_file_cnt > max_files_rotated) {
-    TRACE("Delete oldest_log_file %s", oldest_log_file);
-    if (file_unlink_h(oldest_log_file) == -1) {
-      LOG_NO("Delete log file fail: %s - %s", oldest_log_file, strerror(errno));
+    if (stream->log_files.empty()) {
+      // The newest log files did not fit when the index was read
+      if (files_index_read(stream) == false) return false;
+      log_file_cnt = stream->log_files.size() + stream->log_files_unlisted;
+      if (stream->log_files.empty()) break;
+      continue;
+    }
+
+    const std::string oldest_log_file = path + stream->log_files.front();
+    TRACE("Delete oldest_log_file %s", oldest_log_file.c_str());
+    if (file_unlink_async(stream, oldest_log_file) == -1) {
+      LOG_NO("Delete log file fail: %s", oldest_log_file.c_str());
+      stream->files_index_valid = false;
       return false;
     }
-    log_file_cnt = get_number_of_log_files_h(stream, oldest_log_file);
-    if (log_file_cnt == -1) return false;
+    // The log file may have been compressed
+    (void)file_unlink_async(stream, oldest_log_file + kCompressedFileSuffix);
+    stream->log_files.pop_front();
+    --log_file_cnt;
   }
 
   // Housekeeping for cfg files
   int number_deleted_files = 0;
-  int cfg_file_cnt = get_number_of_cfg_files_h(stream, oldest_cfg_file);
-  while (cfg_file_cnt > max_files_rotated) {
-    TRACE("Delete oldest_cfg_file %s", oldest_cfg_file);
-    if (file_unlink_h(oldest_cfg_file) == -1) {
-      LOG_NO("Delete cfg file fail: %s - %s", oldest_cfg_file, strerror(errno));
-      return false;
+  bool rc = true;
+  while ((static_cast<int>(stream->cfg_files.size()) > max_files_rotated) &&
+         (stream->log_files.empty() == false) &&
+         file_is_older(stream, stream->cfg_files.front(),
+                       stream->log_files.front())) {
+    const std::string oldest_cfg_file = path + stream->cfg_files.front();
+    TRACE("Delete oldest_cfg_file %s", oldest_cfg_file.c_str());
+    if (file_unlink_async(stream, oldest_cfg_file) == -1) {
+      LOG_NO("Delete cfg file fail: %s", oldest_cfg_file.c_str());
+      stream->files_index_valid = false;
+      rc = false;
+      break;
     }
+    stream->cfg_files.pop_front();
     ++number_deleted_files;
-    cfg_file_cnt = get_number_of_cfg_files_h(stream, oldest_cfg_file);
 
     // If there is too much cfg files that the rotation hasn't deleted them
-    // in previous, lgs should limit the deleting to avoid main thread is hung
-    // due to the deleting huge number of cfg files will take long times.
+    // in previous, lgs should limit the deleting to avoid the file thread is
+    // busy due to the deleting huge number of cfg files will take long times.
     // The workaround here is that hard-code to delete max 100 cfg files
     // in one time. Next rotation will continue to delete them
     // It is useful when upgrading system and there are huge number of cfg
@@ -336,8 +598,12 @@ bool remove_oldest_log_files(log_stream_t *stream,
     }
   }
 
+  // Read the index again next time if all log files are not in the index,
+  // the files created meanwhile cannot be added in order
+  if (stream->log_files_unlisted != 0) stream->files_index_valid = false;
+
   TRACE_LEAVE();
-  return (cfg_file_cnt != -1);
+  return rc;
 }
 
 /**
@@ -351,6 +617,7 @@ void log_initiate_stream_files(log_stream_t *stream) {
       static_cast<const char *>(lgs_cfg_get(LGS_IMM_LOG_ROOT_DIRECTORY));
 
   TRACE_ENTER();
+  LgsFileAffinity affinity(stream->streamId);
 
   /* Initiate standby stream file parameters. Only needed if we are standby
    * and configured for split file system.
@@ -366,12 +633,21 @@ void log_initiate_stream_files(log_stream_t *stream) {
   /* Delete to get counting right. It might not exist. */
   (void)delete_config_file(stream);
 
+  /* Files may have been changed e.g. by a previous active */
+  stream->files_index_valid = false;
+
   /* Remove files from a previous life if needed */
   if (remove_oldest_log_files(stream) == false) {
     TRACE("%s - remove_oldest_log_files() FAIL", __FUNCTION__);
     goto done;
   }
 
+  /* The current log file may be one of the removed files */
+  if (lgs_file_async_wait(stream->streamId) != LGSF_SUCESS) {
+    TRACE("%s - lgs_file_async_wait() FAIL", __FUNCTION__);
+    goto done;
+  }
+
   if (lgs_make_reldir_h(stream->pathName) != 0) {
     TRACE("%s - lgs_make_dir_h() FAIL", __FUNCTION__);
     goto done;
@@ -420,6 +696,26 @@ void log_stream_print(log_stream_t *stream) {
   TRACE_2("  stb_dest_names:       %s", stream->stb_dest_names.c_str());
   TRACE_2("  isRtStream:           %d", stream->isRtStream);
   TRACE_2("  facilityId:           %u", stream->facilityId);
+  TRACE_2("  fileCompression:      %u", stream->fileCompression);
+}
+
+/**
+ * Get the compiled format expression of a stream. The format expression is
+ * compiled again if logFileFormat has been changed since it was compiled,
+ * e.g. by an IMM modify or a checkpoint.
+ *
+ * @param stream[in]
+ *
+ * @return const LogFormat&
+ */
+const LogFormat &log_stream_format(log_stream_t *stream) {
+  if ((stream->logFormat == nullptr) || (stream->logFileFormat == nullptr) ||
+      (stream->logFormat->expression() != stream->logFileFormat)) {
+    TRACE("Compile format expression for %s", stream->name.c_str());
+    stream->logFormat.reset(new LogFormat(stream->logFileFormat));
+  }
+
+  return *stream->logFormat;
 }
 
 /**
@@ -520,6 +816,8 @@ int lgs_populate_log_stream(
   if (o_stream->logFileFormat == NULL) {
     LOG_WA("Failed to allocate memory for logFileFormat");
     rc = -1;
+  } else {
+    o_stream->logFormat.reset(new LogFormat(o_stream->logFileFormat));
   }
 
   return rc;
@@ -733,6 +1031,7 @@ log_stream_t *log_stream_new(const std::string &name, int stream_id) {
   stream->isRtStream = SA_FALSE;
   stream->dest_names.clear();
   stream->facilityId = Facility::kLocal0;
+  stream->fileCompression = Compression::kNone;
 
   /* Initiate local or shared stream file descriptor dependant on shared or
    * split file system
@@ -776,6 +1075,7 @@ int log_file_open(const std::string &root_path, log_stream_t *stream,
   int errno_ret;
 
   TRACE_ENTER();
+  LgsFileAffinity affinity(stream->streamId);
 
   pathname = root_path + "/" + stream->pathName + "/" + filename + ".log";
 
@@ -784,6 +1084,13 @@ int log_file_open(const std::string &root_path, log_stream_t *stream,
   fd = fileopen_h(pathname, &errno_ret);
   if (fd == -1) return fd;
 
+  // Add a created log file to the file index
+  if ((stream->files_index_valid == true) &&
+      (std::find(stream->log_files.begin(), stream->log_files.end(),
+                 filename + ".log") == stream->log_files.end())) {
+    stream->log_files.push_back(filename + ".log");
+  }
+
   if (errno_save != 0) {
     *errno_save = errno_ret;
   }
@@ -810,6 +1117,7 @@ int log_file_open(const std::string &root_path, log_stream_t *stream,
 void log_stream_open_fileinit(log_stream_t *stream) {
   osafassert(stream != NULL);
   TRACE_ENTER2("%s, numOpeners=%u", stream->name.c_str(), stream->numOpeners);
+  LgsFileAffinity affinity(stream->streamId);
 
   /* first time open? */
   if (stream->numOpeners == 0) {
@@ -856,6 +1164,7 @@ void log_stream_close(log_stream_t **s, time_t *close_time_ptr) {
 
   osafassert(stream != NULL);
   TRACE_ENTER2("%s", stream->name.c_str());
+  LgsFileAffinity affinity(stream->streamId);
 
   osafassert(stream->numOpeners > 0);
   stream->numOpeners--;
@@ -936,6 +1245,7 @@ int log_stream_file_close(log_stream_t *stream) {
 
   osafassert(stream != NULL);
   TRACE_ENTER2("%s", stream->name.c_str());
+  LgsFileAffinity affinity(stream->streamId);
 
   osafassert(stream->numOpeners > 0);
 
@@ -951,106 +1261,62 @@ int log_stream_file_close(log_stream_t *stream) {
 }
 
 /**
- * Return number of log files in a dir and the name of the oldest file.
- * @param logStream[in]
- * @param oldest_file[out]
+ * Close the current log file of a stream when rotated, and rename it to give
+ * it the "close timestamp" or delete it if it is empty. This is done by the
+ * file thread of the stream without waiting for it, see
+ * log_file_api_async(), so the main thread continues with other requests.
  *
- * @return -1 if error else number of log files
+ * @param root_path[in]
+ * @param stream
+ * @param filename[in] current log file name without ".log"
+ * @param close_time[in] "close timestamp" added to the file name
+ * @param empty[in] true if the file is empty
+ * @param new_filename[in] name of the next current log file without ".log"
+ * @return -1 on error
  */
-static int get_number_of_log_files_h(log_stream_t *logStream,
-                                     char *oldest_file) {
-  lgsf_apipar_t apipar;
-  lgsf_retcode_t api_rc;
-  gnolfh_in_t parameters_in;
-  size_t path_len;
+static int log_file_rotate(const std::string &root_path, log_stream_t *stream,
+                           const std::string &filename,
+                           const std::string &close_time, bool empty,
+                           const std::string &new_filename) {
   int rc = 0;
 
-  TRACE_ENTER();
-
-  std::string logsv_root_dir =
-      static_cast<const char *>(lgs_cfg_get(LGS_IMM_LOG_ROOT_DIRECTORY));
-
-  parameters_in.file_name = const_cast<char *>(logStream->fileName.c_str());
-  parameters_in.logsv_root_dir = const_cast<char *>(logsv_root_dir.c_str());
-  parameters_in.pathName = const_cast<char *>(logStream->pathName.c_str());
-
-  path_len = strlen(parameters_in.file_name) +
-             strlen(parameters_in.logsv_root_dir) +
-             strlen(parameters_in.pathName);
-  if (path_len > PATH_MAX) {
-    LOG_WA("Path to log files > PATH_MAX");
-    rc = -1;
-    goto done;
+  if (*stream->p_fd != -1) {
+    rc = fileclose_async(stream, *stream->p_fd);
+    *stream->p_fd = -1;
+    if (rc == -1) {
+      LOG_NO("Close log file failed");
+      return rc;
+    }
   }
 
-  /* Fill in API structure */
-  apipar.req_code_in = LGSF_GET_NUM_LOGFILES;
-  apipar.data_in_size = sizeof(gnolfh_in_t);
-  apipar.data_in = &parameters_in;
-  apipar.data_out_size = PATH_MAX;
-  apipar.data_out = oldest_file;
-
-  api_rc = log_file_api(&apipar);
-  if (api_rc != LGSF_SUCESS) {
-    TRACE("%s - API error %s", __FUNCTION__, lgsf_retcode_str(api_rc));
-    rc = -1;
+  if (empty == true) {
+    std::string pathname =
+        root_path + "/" + stream->pathName + "/" + filename + ".log";
+    TRACE("Delete empty file %s", pathname.c_str());
+    rc = file_unlink_async(stream, pathname);
+    if (rc == -1) {
+      LOG_NO("Delete empty file failed: %s", pathname.c_str());
+      return rc;
+    }
+    files_index_erase(stream, filename + ".log");
   } else {
-    rc = apipar.hdl_ret_code_out;
-  }
-
-done:
-  TRACE_LEAVE();
-  return rc;
-}
-/**
- * Return number of cfg files in a dir and the name of the oldest file.
- * @param logStream[in]
- * @param oldest_file[out]
- *
- * @return -1 if error else number of log files
- */
-static int get_number_of_cfg_files_h(log_stream_t *logStream,
-                                     char *oldest_file) {
-  lgsf_apipar_t apipar;
-  lgsf_retcode_t api_rc;
-  gnolfh_in_t parameters_in;
-  size_t path_len;
-  int rc = 0;
-
-  TRACE_ENTER();
-
-  std::string logsv_root_dir =
-      static_cast<const char *>(lgs_cfg_get(LGS_IMM_LOG_ROOT_DIRECTORY));
-
-  parameters_in.file_name = const_cast<char *>(logStream->fileName.c_str());
-  parameters_in.logsv_root_dir = const_cast<char *>(logsv_root_dir.c_str());
-  parameters_in.pathName = const_cast<char *>(logStream->pathName.c_str());
-
-  path_len = strlen(parameters_in.file_name) +
-             strlen(parameters_in.logsv_root_dir) +
-             strlen(parameters_in.pathName);
-  if (path_len > PATH_MAX) {
-    LOG_WA("Path to cfg files > PATH_MAX");
-    rc = -1;
-    goto done;
+    rc = lgs_file_rename_async(stream->streamId, root_path, stream->pathName,
+                               filename, close_time, LGS_LOG_FILE_EXT);
+    if (rc == -1) {
+      LOG_NO("Rename log file failed");
+      return rc;
+    }
+    log_file_closed(root_path, stream, filename, close_time);
   }
 
-  /* Fill in API structure */
-  apipar.req_code_in = LGSF_GET_NUM_CFGFILES;
-  apipar.data_in_size = sizeof(gnolfh_in_t);
-  apipar.data_in = &parameters_in;
-  apipar.data_out_size = PATH_MAX;
-  apipar.data_out = oldest_file;
-  api_rc = log_file_api(&apipar);
-  if (api_rc != LGSF_SUCESS) {
-    TRACE("%s - API error %s", __FUNCTION__, lgsf_retcode_str(api_rc));
+  // If the file is rotated within the second it was opened, the new file
+  // gets the same name and cannot be opened until this one is renamed
+  if ((new_filename == filename) &&
+      (lgs_file_async_wait(stream->streamId) != LGSF_SUCESS)) {
+    LOG_NO("Rotation of %s not done", filename.c_str());
     rc = -1;
-  } else {
-    rc = apipar.hdl_ret_code_out;
   }
 
-done:
-  TRACE_LEAVE();
   return rc;
 }
 
@@ -1064,7 +1330,6 @@ done:
 int log_rotation_stb(log_stream_t *stream) {
   int rc = 0;
   int errno_save;
-  int errno_ret;
   char *current_time_str;
   std::string new_current_log_filename;
   bool do_rotate = false;
@@ -1072,6 +1337,7 @@ int log_rotation_stb(log_stream_t *stream) {
       static_cast<const char *>(lgs_cfg_get(LGS_IMM_LOG_ROOT_DIRECTORY));
 
   TRACE_ENTER();
+  LgsFileAffinity affinity(stream->streamId);
 
   /* If active node has rotated files there is a new "logFileCurrent"
    * (check pointed). Standby always follows active rotation.
@@ -1106,37 +1372,11 @@ int log_rotation_stb(log_stream_t *stream) {
   }
 
   if (do_rotate) {
-    // Close current log file
-    if (*stream->p_fd != -1) {
-      rc = fileclose_h(*stream->p_fd, &errno_ret);
-      *stream->p_fd = -1;
-      if (rc == -1) {
-        LOG_NO("Close log file failed: %s", strerror(errno_ret));
-        return rc;
-      }
-    }
-
-    if (stream->stb_curFileSize == 0) {
-      std::string pathname = root_path + "/" + stream->pathName + "/" +
-                             stream->stb_logFileCurrent + ".log";
-      TRACE("Delete empty file %s", pathname.c_str());
-      rc = file_unlink_h(pathname);
-      if (rc == -1) {
-        LOG_NO("Delete empty file failed: %s - %s", pathname.c_str(),
-               strerror(errno));
-        return rc;
-      }
-    } else {
-      std::string emptyStr = "";
-      // Rename file to give it the "close timestamp"
-      rc = lgs_file_rename_h(root_path, stream->pathName,
-                             stream->stb_logFileCurrent, current_time_str,
-                             LGS_LOG_FILE_EXT, &emptyStr);
-      if (rc == -1) {
-        LOG_NO("Rename log file failed");
-        return rc;
-      }
-    }
+    // Close, and rename or delete, current log file
+    rc = log_file_rotate(root_path, stream, stream->stb_logFileCurrent,
+                         current_time_str, stream->stb_curFileSize == 0,
+                         new_current_log_filename);
+    if (rc == -1) return rc;
 
     // Remove oldest file if needed
     if (remove_oldest_log_files(stream) == false) {
@@ -1172,46 +1412,23 @@ int log_rotation_stb(log_stream_t *stream) {
 int log_rotation_act(log_stream_t *stream) {
   int rc;
   int errno_save;
-  int errno_ret;
   struct timespec closetime_tspec;
   std::string root_path =
       static_cast<const char *>(lgs_cfg_get(LGS_IMM_LOG_ROOT_DIRECTORY));
-  std::string emptyStr = "";
 
   TRACE_ENTER();
+  LgsFileAffinity affinity(stream->streamId);
   osaf_clock_gettime(CLOCK_REALTIME, &closetime_tspec);
   time_t closetime = closetime_tspec.tv_sec;
   char *current_time = lgs_get_time(&closetime);
 
-  // Close current log file
-  if (*stream->p_fd != -1) {
-    rc = fileclose_h(*stream->p_fd, &errno_ret);
-    *stream->p_fd = -1;
-    if (rc == -1) {
-      LOG_NO("Close log file failed: %s", strerror(errno_ret));
-      return rc;
-    }
-  }
+  // Create a new file name that includes "open time stamp"
+  const std::string new_log_file = stream->fileName + "_" + current_time;
 
-  if (stream->curFileSize == 0) {
-    std::string pathname = root_path + "/" + stream->pathName + "/" +
-                           stream->logFileCurrent + ".log";
-    TRACE("Delete empty file %s", pathname.c_str());
-    rc = file_unlink_h(pathname);
-    if (rc == -1) {
-      LOG_NO("Delete empty file failed: %s - %s", pathname.c_str(),
-             strerror(errno));
-      return rc;
-    }
-  } else {
-    // Rename file to give it the "close timestamp"
-    rc = lgs_file_rename_h(root_path, stream->pathName, stream->logFileCurrent,
-                           current_time, LGS_LOG_FILE_EXT, &emptyStr);
-    if (rc == -1) {
-      LOG_NO("Rename log file failed");
-      return rc;
-    }
-  }
+  // Close, and rename or delete, current log file
+  rc = log_file_rotate(root_path, stream, stream->logFileCurrent,
+                       current_time, stream->curFileSize == 0, new_log_file);
+  if (rc == -1) return rc;
 
   // Save time when logFileCurrent was closed
   stream->act_last_close_timestamp = closetime;
@@ -1223,8 +1440,8 @@ int log_rotation_act(log_stream_t *stream) {
   if (remove_oldest_log_files(stream) == false)
     TRACE("Old file removal failed");
 
-  // Create a new file name that includes "open time stamp" and open the file
-  stream->logFileCurrent = stream->fileName + "_" + current_time;
+  // Open the new file
+  stream->logFileCurrent = new_log_file;
   if ((*stream->p_fd = log_file_open(
       root_path, stream, stream->logFileCurrent, &errno_save)) == -1) {
     LOG_IN("Could not open '%s' - %s", stream->logFileCurrent.c_str(),
@@ -1236,6 +1453,72 @@ int log_rotation_act(log_stream_t *stream) {
   return rc;
 }
 
+/**
+ * Open files on demand e.g. on new active after fail/switch-over. This
+ * enables LOG to cope with temporary file system problems.
+ *
+ * @param stream
+ * @return true if the stream has a valid file descriptor
+ */
+static bool log_stream_files_ready(log_stream_t *stream) {
+  if (*stream->p_fd == -1) {
+    /* Create directory and log files if they were not created at
+     * stream open or reopen files if bad file descriptor.
+     */
+    log_initiate_stream_files(stream);
+
+    if (*stream->p_fd == -1) {
+      TRACE("%s - Initiating stream files \"%s\" Failed", __FUNCTION__,
+            stream->name.c_str());
+      return false;
+    } else {
+      TRACE("%s - stream files initiated", __FUNCTION__);
+    }
+  }
+
+  TRACE("%s - *stream->p_fd = %d", __FUNCTION__, *stream->p_fd);
+  return true;
+}
+
+/**
+ * Handle a failed write to the stream file.
+ * If writing failed always invalidate the stream file descriptor.
+ *
+ * @param stream
+ * @param rc[in] -1 on error, -2 on timeout
+ * @param write_errno[in] errno from the write handler
+ * @return int -1 on error
+ *             -2 on write timeout or EWOULDBLOCK/EAGAIN
+ */
+static int log_stream_write_failed(log_stream_t *stream, int rc,
+                                   int write_errno) {
+  int errno_ret;
+
+  /* Careful with log level here to avoid syslog flooding */
+  if (rc == -2) {
+    LOG_IN("write '%s' failed \"Timeout\"", stream->logFileCurrent.c_str());
+  } else {
+    LOG_IN("write '%s' failed \"%s\"", stream->logFileCurrent.c_str(),
+           strerror(write_errno));
+  }
+
+  if (*stream->p_fd != -1) {
+    /* Close the file and invalidate the stream fd */
+    if (fileclose_h(*stream->p_fd, &errno_ret) == -1) {
+      LOG_NO("fileclose failed %s", strerror(errno_ret));
+    }
+    *stream->p_fd = -1;
+  }
+
+  if ((write_errno == EAGAIN) || (write_errno == EWOULDBLOCK)) {
+    /* Change return code to timeout if EAGAIN (would block) */
+    TRACE("Write would block");
+    rc = -2;
+  }
+
+  return rc;
+}
+
 /**
  * log_stream_write will write a number of bytes to the associated file. If
  * the file size gets too big, the file is closed, renamed and a new file is
@@ -1251,7 +1534,6 @@ int log_rotation_act(log_stream_t *stream) {
  */
 int log_stream_write_h(log_stream_t *stream, const char *buf, size_t count) {
   int rc = 0;
-  int errno_ret;
   lgsf_apipar_t apipar;
   wlrh_t params_in;
   size_t params_in_size;
@@ -1260,31 +1542,17 @@ int log_stream_write_h(log_stream_t *stream, const char *buf, size_t count) {
 
   osafassert(stream != NULL && buf != NULL);
   TRACE_ENTER2("%s", stream->name.c_str());
-
-  /* Open files on demand e.g. on new active after fail/switch-over. This
-   * enables LOG to cope with temporary file system problems. */
-  if (*stream->p_fd == -1) {
-    /* Create directory and log files if they were not created at
-     * stream open or reopen files if bad file descriptor.
-     */
-    log_initiate_stream_files(stream);
-
-    if (*stream->p_fd == -1) {
-      TRACE("%s - Initiating stream files \"%s\" Failed", __FUNCTION__,
-            stream->name.c_str());
-      // Seems file system is busy - can not create requrested files.
-      // Let inform the log client TRY_AGAIN.
-      //
-      // Return (-1) to inform that it is caller's responsibility
-      // to free the allocated memmories.
-      return -1;
-    } else {
-      TRACE("%s - stream files initiated", __FUNCTION__);
-    }
+  LgsFileAffinity affinity(stream->streamId);
+
+  if (log_stream_files_ready(stream) == false) {
+    // Seems file system is busy - can not create requrested files.
+    // Let inform the log client TRY_AGAIN.
+    //
+    // Return (-1) to inform that it is caller's responsibility
+    // to free the allocated memmories.
+    return -1;
   }
 
-  TRACE("%s - *stream->p_fd = %d", __FUNCTION__, *stream->p_fd);
-
   /* Get size of write log record header */
   params_in_size = sizeof(wlrh_t);
 
@@ -1322,29 +1590,7 @@ int log_stream_write_h(log_stream_t *stream, const char *buf, size_t count) {
   /* End write the log record */
 
   if ((rc == -1) || (rc == -2)) {
-    /* If writing failed always invalidate the stream file descriptor.
-     */
-    /* Careful with log level here to avoid syslog flooding */
-    if (rc == -2) {
-      LOG_IN("write '%s' failed \"Timeout\"", stream->logFileCurrent.c_str());
-    } else {
-      LOG_IN("write '%s' failed \"%s\"", stream->logFileCurrent.c_str(),
-             strerror(write_errno));
-    }
-
-    if (*stream->p_fd != -1) {
-      /* Close the file and invalidate the stream fd */
-      if (fileclose_h(*stream->p_fd, &errno_ret) == -1) {
-        LOG_NO("fileclose failed %s", strerror(errno_ret));
-      }
-      *stream->p_fd = -1;
-    }
-
-    if ((write_errno == EAGAIN) || (write_errno == EWOULDBLOCK)) {
-      /* Change return code to timeout if EAGAIN (would block) */
-      TRACE("Write would block");
-      rc = -2;
-    }
+    rc = log_stream_write_failed(stream, rc, write_errno);
     goto done;
   }
 
@@ -1367,6 +1613,149 @@ done:
   return rc;
 }
 
+/**
+ * log_stream_write_records_h writes a batch of log records to the associated
+ * file using one file thread request. Writing stops where the file has to be
+ * rotated, so the log files get the same content as if the records were
+ * written one by one using log_stream_write_h(), and the records written to
+ * the rotated file can be checkpointed with the stream state after them. The
+ * caller writes the rest of the records with a new call.
+ * Shall only be used on the active node.
+ *
+ * @param stream
+ * @param records[in] Log records in the order they shall be written
+ * @param count[in] Number of records
+ * @param sync[in] If true, fdatasync() the file after each write
+ * @param written[out] Number of records written to file. Less than count
+ *                     if the file was rotated. Also valid if an error is
+ *                     returned.
+ *
+ * @return int 0 No error
+ *            -1 on error
+ *            -2 Write failed because of write timeout or EWOULDBLOCK/EAGAIN
+ */
+int log_stream_write_records_h(log_stream_t *stream,
+                               const struct iovec *records, size_t count,
+                               bool sync, size_t *written) {
+  int rc = 0;
+  lgsf_apipar_t apipar;
+  wlrsh_t params_in;
+  lgsf_retcode_t api_rc;
+  int write_errno = 0;
+
+  osafassert(stream != NULL && records != NULL && written != NULL);
+  osafassert(lgs_cb->ha_state == SA_AMF_HA_ACTIVE);
+  TRACE_ENTER2("%s, count = %zu", stream->name.c_str(), count);
+  LgsFileAffinity affinity(stream->streamId);
+
+  *written = 0;
+  while (*written < count) {
+    if (log_stream_files_ready(stream) == false) {
+      rc = -1;
+      break;
+    }
+
+    /* Take records until the file size limit is passed */
+    size_t first = *written;
+    size_t num = 0;
+    size_t size = 0;
+    do {
+      size += records[first + num].iov_len;
+      num++;
+    } while ((first + num < count) &&
+             (stream->curFileSize + size <= stream->maxLogFileSize));
+
+    params_in.fd = *stream->p_fd;
+    params_in.num_records = num;
+    params_in.total_size = size;
+    params_in.records = &records[first];
+    params_in.sync = sync;
+
+    apipar.req_code_in = LGSF_WRITELOGRECS;
+    apipar.data_in_size = sizeof(wlrsh_t);
+    apipar.data_in = &params_in;
+    apipar.data_out_size = sizeof(int);
+    apipar.data_out = &write_errno;
+
+    api_rc = log_file_api(&apipar);
+    if (api_rc == LGSF_TIMEOUT) {
+      TRACE("%s - API error %s", __FUNCTION__, lgsf_retcode_str(api_rc));
+      rc = -2;
+    } else if (api_rc != LGSF_SUCESS) {
+      TRACE("%s - API error %s", __FUNCTION__, lgsf_retcode_str(api_rc));
+      rc = -1;
+    } else {
+      rc = apipar.hdl_ret_code_out;
+    }
+
+    if ((rc == -1) || (rc == -2)) {
+      rc = log_stream_write_failed(stream, rc, write_errno);
+      break;
+    }
+
+    rc = 0;
+    *written += num;
+    stream->curFileSize += size;
+    if (stream->curFileSize > stream->maxLogFileSize) {
+      rc = log_rotation_act(stream);
+      break;
+    }
+  }
+
+  TRACE_LEAVE2("rc=%d, written = %zu", rc, *written);
+  return rc;
+}
+
+/**
+ * log_stream_sync_h does fdatasync() of the current log file of the stream,
+ * in the file thread of the stream. Used for batched writes when no write
+ * request comes to do it, see Cache::SyncIdleBatches().
+ * Shall only be used on the active node.
+ *
+ * @param stream
+ *
+ * @return int 0 No error
+ *            -1 on error
+ */
+int log_stream_sync_h(log_stream_t *stream) {
+  lgsf_apipar_t apipar;
+  wlrsh_t params_in;
+  lgsf_retcode_t api_rc;
+  int write_errno = 0;
+
+  osafassert(stream != NULL);
+  osafassert(lgs_cb->ha_state == SA_AMF_HA_ACTIVE);
+  TRACE_ENTER2("%s", stream->name.c_str());
+  LgsFileAffinity affinity(stream->streamId);
+
+  if (*stream->p_fd == -1) {
+    TRACE_LEAVE2("No open log file");
+    return -1;
+  }
+
+  /* A write of no records does only the sync */
+  params_in.fd = *stream->p_fd;
+  params_in.num_records = 0;
+  params_in.total_size = 0;
+  params_in.records = NULL;
+  params_in.sync = true;
+
+  apipar.req_code_in = LGSF_WRITELOGRECS;
+  apipar.data_in_size = sizeof(wlrsh_t);
+  apipar.data_in = &params_in;
+  apipar.data_out_size = sizeof(int);
+  apipar.data_out = &write_errno;
+
+  api_rc = log_file_api(&apipar);
+  if (api_rc != LGSF_SUCESS) {
+    TRACE_LEAVE2("API error %s", lgsf_retcode_str(api_rc));
+    return -1;
+  }
+
+  TRACE_LEAVE();
+  return apipar.hdl_ret_code_out;
+}
+
 /**
  * Get stream from array
  * @param lgs_cb
@@ -1539,6 +1928,7 @@ int log_stream_config_change(bool create_files_f, const std::string &root_path,
   std::string emptyStr = "";
 
   TRACE_ENTER2("%s", stream->name.c_str());
+  LgsFileAffinity affinity(stream->streamId);
 
   /* Peer sync needed due to change in logFileCurrent */
 
@@ -1563,6 +1953,8 @@ int log_stream_config_change(bool create_files_f, const std::string &root_path,
       LOG_WA("log file (%s) is renamed  FAILED: %d",
              current_logfile_name.c_str(), rc);
       ret = -1;
+    } else {
+      log_file_closed(root_path, stream, current_logfile_name, current_time);
     }
 
     rc = lgs_file_rename_h(root_path, stream->pathName, stream->fileName,
@@ -1575,6 +1967,8 @@ int log_stream_config_change(bool create_files_f, const std::string &root_path,
   }
 
   remove_oldest_log_files(stream);
+  // The root directory or the file name may be changed by the caller
+  stream->files_index_valid = false;
 
   /* Reset file size for new log file */
   stream->curFileSize = 0;
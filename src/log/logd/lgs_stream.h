@@ -23,6 +23,9 @@
 #include "base/ncspatricia.h"
 #include <time.h>
 #include <limits.h>
+#include <sys/uio.h>
+#include <deque>
+#include <memory>
 #include <vector>
 
 #include "lgs_fmt.h"
@@ -54,6 +57,7 @@ typedef struct log_stream {
   SaUint64T filtered; /* discarded by server due to filtering */
   std::string rfc5424MsgId;
   uint32_t facilityId;
+  uint32_t fileCompression; /* Compression of rotated log files */
   /* --- end correspond to IMM Class --- */
 
   uint32_t streamId; /* The unique stream id for this stream */
@@ -96,6 +100,19 @@ typedef struct log_stream {
   // Hold a list of strings separated by semicolon "name1;name2;etc"
   // This data is used to checkpoint to standby
   std::string stb_dest_names;
+
+  // logFileFormat compiled, see log_stream_format()
+  std::unique_ptr<LogFormat> logFormat;
+
+  // Index of the log and cfg files of the stream, oldest first, see
+  // remove_oldest_log_files(). Read from disk when not valid and then kept up
+  // to date when the stream's files are opened, renamed and removed.
+  // The newest log files may not fit when read, they are counted in
+  // log_files_unlisted.
+  bool files_index_valid;
+  std::deque<std::string> log_files;
+  std::deque<std::string> cfg_files;
+  int log_files_unlisted;
 } log_stream_t;
 
 extern uint32_t log_stream_init();
@@ -120,6 +137,11 @@ extern void log_stream_close(log_stream_t **stream, time_t *close_time);
 extern int log_stream_file_close(log_stream_t *stream);
 extern int log_stream_write_h(log_stream_t *stream, const char *buf,
                               size_t count);
+extern int log_stream_write_records_h(log_stream_t *stream,
+                                      const struct iovec *records,
+                                      size_t count, bool sync,
+                                      size_t *written);
+extern int log_stream_sync_h(log_stream_t *stream);
 extern void log_stream_id_print();
 
 #define LGS_STREAM_CREATE_FILES true
@@ -132,6 +154,7 @@ extern int log_file_open(const std::string &root_path, log_stream_t *stream,
 
 /* Accessor functions */
 extern void log_stream_print(log_stream_t *stream);
+extern const LogFormat &log_stream_format(log_stream_t *stream);
 extern log_stream_t *log_stream_get_by_id(uint32_t id);
 extern bool check_max_stream();
 void log_free_stream_resources(log_stream_t *stream);
@@ -17,7 +17,11 @@
 
 #include "log/logd/lgs_unixsock_dest.h"
 
+#include <poll.h>
+#include <sys/socket.h>
 #include <algorithm>
+#include <cinttypes>
+#include <cstdlib>
 
 #include "log/logd/lgs_util.h"
 #include "log/logd/lgs_nildest.h"
@@ -42,17 +46,44 @@
 
 static const char kDelimeter[] = ";";
 
+// Max time in ms the sender thread waits for a full socket to be writable
+static const int kSendRetryTimeout = 100;
+
 //==============================================================================
 // UnixSocketHandler class
 //==============================================================================
+const size_t UnixSocketHandler::kMaxBatchSize;
+const size_t UnixSocketHandler::kMaxQueueSize;
+
 UnixSocketHandler::UnixSocketHandler(const char* socket_name)
     : sock_path_{socket_name},
       sock_{socket_name, base::UnixSocket::kNonblocking},
-      status_{DestinationStatus::kFailed} {
+      status_{DestinationStatus::kFailed},
+      queue_{},
+      head_{0},
+      count_{0},
+      stop_{false},
+      dropping_{0},
+      dropped_{0} {
   // Open the unix socket & and flush the destination status to @status_
   Open();
+
+  const char* val_str;
+  if ((val_str = getenv("LOGSV_DEST_QUEUE_SIZE")) != nullptr) {
+    size_t val = strtoul(val_str, nullptr, 0);
+    if (val > kMaxQueueSize) {
+      LOG_WA("Invalid LOGSV_DEST_QUEUE_SIZE %s, using %zu", val_str,
+             kMaxQueueSize);
+      val = kMaxQueueSize;
+    }
+    if (val != 0) {
+      queue_.resize(val);
+      sender_ = std::thread{&UnixSocketHandler::SenderThread, this};
+    }
+  }
 };
 
+// Must be called with @sock_mutex_ locked
 void UnixSocketHandler::FlushStatus() {
   if (sock_.fd() >= 0) {
     status_ = DestinationStatus::kActive;
@@ -62,11 +93,15 @@ void UnixSocketHandler::FlushStatus() {
 }
 
 DestinationStatus UnixSocketHandler::GetSockStatus() {
-  Open();
+  std::lock_guard<std::mutex> lock(sock_mutex_);
+  FlushStatus();
   return status_;
 }
 
-void UnixSocketHandler::Open() { FlushStatus(); }
+void UnixSocketHandler::Open() {
+  std::lock_guard<std::mutex> lock(sock_mutex_);
+  FlushStatus();
+}
 
 void UnixSocketHandler::FormRfc5424(const DestinationHandler::RecordInfo& msg,
                                     RfcBuffer* buf) {
@@ -89,6 +124,13 @@ ErrCode UnixSocketHandler::Send(const DestinationHandler::RecordInfo& msg) {
 
   FormRfc5424(msg, &buffer);
 
+  if (queue_.empty() == false) {
+    ret = Queue(buffer);
+    TRACE_LEAVE();
+    return ret;
+  }
+
+  std::lock_guard<std::mutex> lock(sock_mutex_);
   ssize_t length = buffer.size();
   ssize_t len = sock_.Send(buffer.data(), length);
   // Resend as probably receiver has just been restarted.
@@ -113,6 +155,100 @@ ErrCode UnixSocketHandler::Send(const DestinationHandler::RecordInfo& msg) {
   return ret;
 }
 
+ErrCode UnixSocketHandler::Queue(const RfcBuffer& buf) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (count_ == queue_.size()) {
+    if (dropping_++ == 0) {
+      LOG_NO("Queue to socket destination %s is full. Drop log records.",
+             sock_path_.c_str());
+    }
+    ++dropped_;
+    return ErrCode::kDrop;
+  }
+
+  // The slot keeps its capacity, no allocation once the queue has been used
+  queue_[(head_ + count_) % queue_.size()].assign(buf.data(), buf.size());
+  if (count_++ == 0) cond_.notify_one();
+  return ErrCode::kOk;
+}
+
+size_t UnixSocketHandler::SendBatch(size_t first, size_t num) {
+  struct mmsghdr msgs[kMaxBatchSize];
+  struct iovec iovs[kMaxBatchSize];
+
+  memset(msgs, 0, sizeof(msgs[0]) * num);
+  for (size_t i = 0; i < num; i++) {
+    std::string& msg = queue_[(first + i) % queue_.size()];
+    iovs[i].iov_base = const_cast<char*>(msg.data());
+    iovs[i].iov_len = msg.size();
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  std::lock_guard<std::mutex> lock(sock_mutex_);
+  DestinationStatus old_status = status_;
+  int sock = sock_.fd();
+  int sent = -1;
+  if (sock >= 0) {
+    do {
+      sent = sendmmsg(sock, msgs, num, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    if (sent > 0) return sent;
+    if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+  }
+
+  // The receiver might be just restarted, resend once as in Send(). The
+  // socket is reopened by UnixSocket::Send().
+  TRACE("The receiver might be just restarted");
+  const std::string& msg = queue_[first];
+  ssize_t len = sock_.Send(msg.data(), msg.size());
+  FlushStatus();
+  if (len == static_cast<ssize_t>(msg.size())) return 1;
+  if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return 0;
+
+  // Drop the batch, the next batch will try again
+  if (old_status == DestinationStatus::kActive) {
+    LOG_NO("Failed to send log record to socket destination.");
+  }
+  std::lock_guard<std::mutex> queue_lock(mutex_);
+  dropped_ += num;
+  return num;
+}
+
+void UnixSocketHandler::SenderThread() {
+  TRACE("%s %s - is started", __func__, sock_path_.c_str());
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cond_.wait(lock, [this] { return (stop_ == true) || (count_ != 0); });
+    if (stop_ == true) break;
+    size_t first = head_;
+    size_t num = std::min(count_, kMaxBatchSize);
+    lock.unlock();
+
+    size_t done = SendBatch(first, num);
+    if (done == 0) {
+      // The receiver is slow. Queued msgs are kept until the queue is full.
+      int sock;
+      {
+        std::lock_guard<std::mutex> sock_lock(sock_mutex_);
+        sock = sock_.fd();
+      }
+      struct pollfd fds = {sock, POLLOUT, 0};
+      if (sock >= 0) (void)poll(&fds, 1, kSendRetryTimeout);
+    }
+
+    lock.lock();
+    head_ = (head_ + done) % queue_.size();
+    count_ -= done;
+    if ((count_ == 0) && (dropping_ != 0)) {
+      LOG_NO("Queue to socket destination %s is not full. %" PRIu64
+             " log records dropped, %" PRIu64 " in total",
+             sock_path_.c_str(), dropping_, dropped_);
+      dropping_ = 0;
+    }
+  }
+}
+
 void UnixSocketHandler::Close() {
   // Do nothing
 }
@@ -141,6 +277,15 @@ base::LogMessage::Severity UnixSocketHandler::Sev(uint16_t sev) {
 }
 
 UnixSocketHandler::~UnixSocketHandler() {
+  if (sender_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+      TRACE("%s %zu queued log records dropped", sock_path_.c_str(), count_);
+    }
+    cond_.notify_one();
+    sender_.join();
+  }
   // Destination is deleted
   status_ = DestinationStatus::kFailed;
   // The parent class will do closing the connection
@@ -18,8 +18,12 @@
 #ifndef LOG_LOGD_LGS_UNIXSOCK_DEST_H_
 #define LOG_LOGD_LGS_UNIXSOCK_DEST_H_
 
-#include <string>
+#include <condition_variable>
 #include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "base/log_message.h"
 #include "base/time.h"
@@ -80,6 +84,12 @@
 // The other information on this class is that, within @Send()
 // method, creating a very big stack buffer - over 65*1024 bytes
 // even the sent RFC msg is quite short (e.g: rfc header + 150 bytes).
+//
+// If LOGSV_DEST_QUEUE_SIZE (logd.conf) is set, @Send() does not write to
+// the socket. The RFC msg is put in a ring of that many msgs and a sender
+// thread, one per instance, writes the queued msgs to the socket in batches
+// with sendmmsg(). If the receiver is slow and the ring is full, the msg is
+// dropped and counted, so the LOG main thread never waits for the receiver.
 //<
 class UnixSocketHandler {
  public:
@@ -110,6 +120,18 @@ class UnixSocketHandler {
   void FlushStatus();
   // Convert AIS log stream severity to syslog severity
   static base::LogMessage::Severity Sev(uint16_t);
+  // Put the RFC msg @buf in @queue_ for the @sender_ thread
+  ErrCode Queue(const RfcBuffer& buf);
+  // Body of the @sender_ thread
+  void SenderThread();
+  // Send @num msgs from @queue_ starting at @first with one sendmmsg().
+  // Return number of msgs sent or dropped, 0 if the socket is full.
+  size_t SendBatch(size_t first, size_t num);
+
+  // Max number of msgs sent with one sendmmsg()
+  static const size_t kMaxBatchSize = 64;
+  // Max value of LOGSV_DEST_QUEUE_SIZE
+  static const size_t kMaxQueueSize = 64 * 1024;
 
   // Hold destination info (@value)
   std::string sock_path_;
@@ -117,6 +139,22 @@ class UnixSocketHandler {
   // Hold the connection status
   DestinationStatus status_;
 
+  // Protect @sock_ and @status_, used by @sender_ and the main thread
+  std::mutex sock_mutex_;
+  // Protect the queue
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  // Ring of RFC msgs waiting for @sender_. Empty if no sender thread.
+  // The slots from @head_ to @head_ + @count_ are owned by @sender_.
+  std::vector<std::string> queue_;
+  size_t head_;
+  size_t count_;
+  bool stop_;
+  // Number of msgs dropped since the queue got full, and in total
+  uint64_t dropping_;
+  uint64_t dropped_;
+  std::thread sender_;
+
   DELETE_COPY_AND_MOVE_OPERATORS(UnixSocketHandler);
 };
 
@@ -73,6 +73,7 @@ int lgs_create_config_file_h(const std::string &root_path,
   size_t pathname_size = 0;
 
   TRACE_ENTER();
+  LgsFileAffinity affinity(stream->streamId);
 
   /* check the existence of logsv_root_dir/pathName,
    * check that the path is safe.
@@ -239,6 +240,38 @@ SaTimeT lgs_get_SaTime() {
   return logTime;
 }
 
+/**
+ * Allocate and fill in the in data of a rename request, see rename_file_hdl()
+ *
+ * @param oldpath[in]
+ * @param newpath[in]
+ * @param params_in_size[out] Size of the in data
+ * @return The in data. Shall be freed by the caller
+ */
+static void *rename_params_new(const std::string &oldpath,
+                               const std::string &newpath,
+                               size_t *params_in_size) {
+  size_t oldpath_size = oldpath.size() + 1;
+  size_t newpath_size = newpath.size() + 1;
+
+  /* Allocate memory for parameters */
+  *params_in_size = sizeof(size_t) + oldpath_size + newpath_size;
+  void *params_in_p = malloc(*params_in_size);
+  osafassert(params_in_p);
+
+  /* Fill in pointer addresses */
+  size_t *oldpath_str_size_p = static_cast<size_t *>(params_in_p);
+  char *oldpath_in_p = static_cast<char *>(params_in_p) + sizeof(size_t);
+  char *newpath_in_p = oldpath_in_p + oldpath_size;
+
+  /* Fill in parameters */
+  *oldpath_str_size_p = oldpath_size;
+  memcpy(oldpath_in_p, oldpath.c_str(), oldpath_size);
+  memcpy(newpath_in_p, newpath.c_str(), newpath_size);
+
+  return params_in_p;
+}
+
 /**
  * Rename a file to include a timestamp in the name
  * @param root_path[in]
@@ -266,11 +299,6 @@ int lgs_file_rename_h(const std::string &root_path, const std::string &rel_path,
   void *params_in_p = nullptr;
   size_t params_in_size;
   lgsf_retcode_t api_rc;
-  char *oldpath_in_p;
-  char *newpath_in_p;
-  size_t *oldpath_str_size_p;
-  size_t oldpath_size = 0;
-  size_t newpath_size = 0;
 
   TRACE_ENTER();
 
@@ -301,22 +329,7 @@ int lgs_file_rename_h(const std::string &root_path, const std::string &rel_path,
   TRACE_4("Rename file from %s", oldpath.c_str());
   TRACE_4("              to %s", newpath.c_str());
 
-  /* Allocate memory for parameters */
-  oldpath_size = oldpath.size() + 1;
-  newpath_size = newpath.size() + 1;
-  params_in_size = sizeof(size_t) + oldpath_size + newpath_size;
-
-  params_in_p = malloc(params_in_size);
-
-  /* Fill in pointer addresses */
-  oldpath_str_size_p = static_cast<size_t *>(params_in_p);
-  oldpath_in_p = static_cast<char *>(params_in_p) + sizeof(size_t);
-  newpath_in_p = oldpath_in_p + oldpath_size;
-
-  /* Fill in parameters */
-  *oldpath_str_size_p = oldpath_size;
-  memcpy(oldpath_in_p, oldpath.c_str(), oldpath_size);
-  memcpy(newpath_in_p, newpath.c_str(), newpath_size);
+  params_in_p = rename_params_new(oldpath, newpath, &params_in_size);
 
   /* Fill in API structure */
   apipar.req_code_in = LGSF_RENAME_FILE;
@@ -340,6 +353,61 @@ done:
   return rc;
 }
 
+/**
+ * Rename a file to include a timestamp in the name, without waiting for it.
+ * The file is renamed by the file thread of the stream, see
+ * log_file_api_async().
+ *
+ * @param stream_id[in]
+ * @param root_path[in]
+ * @param rel_path[in]
+ * @param old_name[in]
+ * @param time_stamp[in]
+ * @param suffix[in]
+ *
+ * @return -1 if the request could not be queued
+ */
+int lgs_file_rename_async(uint32_t stream_id, const std::string &root_path,
+                          const std::string &rel_path,
+                          const std::string &old_name,
+                          const std::string &time_stamp,
+                          const std::string &suffix) {
+  int rc = 0;
+  lgsf_apipar_t apipar;
+  size_t params_in_size;
+
+  TRACE_ENTER();
+
+  const std::string oldpath =
+      root_path + "/" + rel_path + "/" + old_name + suffix;
+  const std::string newpath = root_path + "/" + rel_path + "/" + old_name +
+                              "_" + time_stamp + suffix;
+  if (newpath.size() >= PATH_MAX) {
+    LOG_ER("Cannot rename file, new path > PATH_MAX");
+    TRACE_LEAVE();
+    return -1;
+  }
+
+  TRACE_4("Rename file from %s", oldpath.c_str());
+  TRACE_4("              to %s", newpath.c_str());
+
+  void *params_in_p = rename_params_new(oldpath, newpath, &params_in_size);
+
+  /* Fill in API structure */
+  apipar.req_code_in = LGSF_RENAME_FILE;
+  apipar.data_in_size = params_in_size;
+  apipar.data_in = params_in_p;
+  apipar.data_out_size = 0;
+  apipar.data_out = nullptr;
+
+  if (log_file_api_async(stream_id, &apipar) != LGSF_SUCESS) rc = -1;
+
+  free(params_in_p);
+
+  TRACE_LEAVE();
+  return rc;
+}
+
 void lgs_exit(const char *msg) {
   LOG_ER("Exiting with message: %s", msg);
   exit(EXIT_FAILURE);
@@ -594,6 +662,7 @@ int lgs_own_log_files_h(log_stream_t *stream, const char *groupname) {
   olfbgh_t *data_in = static_cast<olfbgh_t *>(malloc(sizeof(olfbgh_t)));
 
   TRACE_ENTER2("stream %s", stream->name.c_str());
+  LgsFileAffinity affinity(stream->streamId);
 
   /* Set in parameter dir_path */
   const std::string logsv_root_dir =
@@ -62,6 +62,12 @@ extern int lgs_file_rename_h(const std::string &root_path,
                              const std::string &old_name,
                              const std::string &time_stamp,
                              const std::string &suffix, std::string *new_name);
+extern int lgs_file_rename_async(uint32_t stream_id,
+                                 const std::string &root_path,
+                                 const std::string &rel_path,
+                                 const std::string &old_name,
+                                 const std::string &time_stamp,
+                                 const std::string &suffix);
 // extern uint32_t lgs_create_known_streams(lgs_cb_t *lgs_cb); /* Not used, no
 // code */
 extern void lgs_exit(const char *msg);
@@ -18,6 +18,8 @@
 #include "log/logd/lgs_dest.h"
 #include "log/logd/lgs_unixsock_dest.h"
 #include "log/logd/lgs_config.h"
+#include <poll.h>
+#include <cstdlib>
 #include <string>
 #include <vector>
 #include "base/unix_server_socket.h"
@@ -273,6 +275,70 @@ TEST(WriteToDestination, HaveDestNameAndDestCfg) {
   ASSERT_EQ(strncmp(buf, testbuf.data(), 1024), 0);
 }
 
+// Same as above, but the records are queued to the sender thread of the
+// destination (LOGSV_DEST_QUEUE_SIZE). Verify that all records arrive in order.
+TEST(WriteToDestination, HaveDestNameAndDestCfgQueued) {
+  base::InitializeHashFunction();
+  RecordData data;
+  DestinationHandler::RecordInfo info{};
+  const int kNumRecords = 3;
+  std::vector<std::string> records;
+
+  // Create the server listen to the local socket
+  static base::UnixServerSocket server{"/tmp/test_queue.sock",
+                                       base::UnixSocket::kNonblocking};
+  server.fd();
+
+  setenv("LOGSV_DEST_QUEUE_SIZE", "16", 1);
+  const std::vector<std::string> dest{"test;UNIX_SOCKET;/tmp/test_queue.sock"};
+  CfgDestination(dest, ModifyType::kReplace);
+  unsetenv("LOGSV_DEST_QUEUE_SIZE");
+
+  initData(&data);
+  // Origin is FQDN = <hostname>[.<networkname>]
+  const std::string origin =
+      std::string{data.hostname} + "." + std::string{data.networkname};
+
+  info.msgid = data.msgid;
+  info.log_record = data.logrec;
+  info.stream_dn = data.name;
+  info.app_name = data.appname;
+  info.severity = data.sev;
+  info.time = data.time;
+  info.origin = origin.c_str();
+  info.facilityId = data.facilityId;
+
+  // Each record has its own text, so that the order can be checked
+  for (int i = 0; i < kNumRecords; i++) {
+    records.push_back(std::string{rec} + " #" + std::to_string(i));
+  }
+
+  for (int i = 0; i < kNumRecords; i++) {
+    data.recordId = i + 1;
+    data.logrec = records[i].c_str();
+    ASSERT_EQ(WriteToDestination(data, {"test"}), true);
+  }
+
+  for (int i = 0; i < kNumRecords; i++) {
+    char buf[1024] = {0};
+    base::Buffer<kMaxSize> testbuf;
+
+    // Form the expected/tested buffer of the i:th record.
+    info.log_record = records[i].c_str();
+    FormRfc5424Test(info, &testbuf);
+
+    struct pollfd fds = {server.fd(), POLLIN, 0};
+    ASSERT_EQ(poll(&fds, 1, 5000), 1);
+    ssize_t size = server.Recv(buf, 1024);
+    ASSERT_EQ(std::string(buf, size > 0 ? size : 0),
+              std::string(testbuf.data(), testbuf.size()));
+  }
+
+  // Stop the sender thread
+  const std::vector<std::string> vdeldest{};
+  CfgDestination(vdeldest, ModifyType::kDelete);
+}
+
 //==============================================================================
 // Verify GetDestinationStatus() interface
 //==============================================================================
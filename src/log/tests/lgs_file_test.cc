@@ -0,0 +1,245 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+#include "log/logd/lgs_file.h"
+#include <pthread.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "base/ncsgl_defs.h"
+#include "base/osaf_utility.h"
+#include "log/logd/lgs_config.h"
+#include "gtest/gtest.h"
+
+extern pthread_mutex_t lgs_ftcom_mutex;
+
+//==============================================================================
+// Dummy functions
+//==============================================================================
+namespace {
+
+SaUint32T file_io_timeout_ms = 10000;
+
+// Names of the requests in the order they are handled, see Handle()
+std::mutex handled_mutex;
+std::vector<std::string> handled;
+
+// A request with the name kBlocked is not done until Release() is called
+const char kBlocked[] = "blocked";
+std::mutex gate_mutex;
+std::condition_variable gate_cv;
+bool gate_open = false;
+bool gate_reached = false;
+
+// A request with the name kFailed returns -1
+const char kFailed[] = "failed";
+
+std::vector<std::string> Handled() {
+  std::lock_guard<std::mutex> lock(handled_mutex);
+  return handled;
+}
+
+// Wait until a request with the name kBlocked has been started
+void WaitBlocked() {
+  std::unique_lock<std::mutex> lock(gate_mutex);
+  gate_cv.wait(lock, [] { return gate_reached; });
+}
+
+void Release() {
+  std::lock_guard<std::mutex> lock(gate_mutex);
+  gate_open = true;
+  gate_cv.notify_all();
+}
+
+// Record the request and do the "file I/O" with the mutex unlocked, like
+// the real handlers
+int Handle(const char *name) {
+  int rc = 0;
+
+  osaf_mutex_unlock_ordie(&lgs_ftcom_mutex);
+  if (strcmp(name, kBlocked) == 0) {
+    std::unique_lock<std::mutex> lock(gate_mutex);
+    gate_reached = true;
+    gate_cv.notify_all();
+    gate_cv.wait(lock, [] { return gate_open; });
+  }
+  if (strcmp(name, kFailed) == 0) rc = -1;
+  {
+    std::lock_guard<std::mutex> lock(handled_mutex);
+    handled.push_back(name);
+  }
+  osaf_mutex_lock_ordie(&lgs_ftcom_mutex);
+
+  return rc;
+}
+
+}  // namespace
+
+const void *lgs_cfg_get(lgs_logconfGet_t param) {
+  return &file_io_timeout_ms;
+}
+
+int rename_file_hdl(void *indata, void *outdata, size_t max_outsize) {
+  return Handle(static_cast<char *>(indata));
+}
+
+int delete_file_hdl(void *indata, void *outdata, size_t max_outsize) {
+  return Handle(static_cast<char *>(indata));
+}
+
+int write_log_record_hdl(void *indata, void *outdata, size_t max_outsize,
+                         bool *timeout_f) {
+  return Handle(static_cast<char *>(indata));
+}
+
+int path_is_writeable_dir_hdl(void *, void *, size_t) { return 0; }
+int check_path_exists_hdl(void *, void *, size_t) { return 0; }
+int archive_file_hdl(void *, void *, size_t) { return 0; }
+int create_config_file_hdl(void *, void *, size_t) { return 0; }
+int write_log_records_hdl(void *, void *, size_t, bool *) { return 0; }
+int make_log_dir_hdl(void *, void *, size_t) { return 0; }
+int fileopen_hdl(void *, void *, size_t, bool *) { return 0; }
+int fileclose_hdl(void *, void *, size_t) { return 0; }
+int get_log_files_hdl(void *, void *, size_t) { return 0; }
+int own_log_files_by_group_hdl(void *, void *, size_t) { return 0; }
+int lgs_get_file_params_hdl(void *, void *, size_t) { return 0; }
+
+//==============================================================================
+// Tests
+//==============================================================================
+namespace {
+
+// Streams handled by different file threads
+const uint32_t kStream = 0;
+const uint32_t kOtherStream = 1;
+
+lgsf_retcode_t Queue(uint32_t stream_id, lgsf_treq_t request,
+                     const char *name) {
+  lgsf_apipar_t apipar;
+  apipar.req_code_in = request;
+  apipar.data_in_size = strlen(name) + 1;
+  apipar.data_in = const_cast<char *>(name);
+  apipar.data_out_size = 0;
+  apipar.data_out = nullptr;
+  return log_file_api_async(stream_id, &apipar);
+}
+
+lgsf_retcode_t Write(uint32_t stream_id, const char *name) {
+  LgsFileAffinity affinity(stream_id);
+  lgsf_apipar_t apipar;
+  apipar.req_code_in = LGSF_WRITELOGREC;
+  apipar.data_in_size = strlen(name) + 1;
+  apipar.data_in = const_cast<char *>(name);
+  apipar.data_out_size = 0;
+  apipar.data_out = nullptr;
+  return log_file_api(&apipar);
+}
+
+class LgsFileTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    setenv("LOGSV_FILE_THREADS", "2", 1);
+    ASSERT_EQ(lgs_file_init(), NCSCC_RC_SUCCESS);
+  }
+
+  void SetUp() override {
+    file_io_timeout_ms = 10000;
+    {
+      std::lock_guard<std::mutex> lock(gate_mutex);
+      gate_open = false;
+      gate_reached = false;
+    }
+    std::lock_guard<std::mutex> lock(handled_mutex);
+    handled.clear();
+  }
+
+  void TearDown() override {
+    Release();
+    file_io_timeout_ms = 10000;
+    EXPECT_EQ(lgs_file_async_wait(kStream), LGSF_SUCESS);
+    EXPECT_EQ(lgs_file_async_wait(kOtherStream), LGSF_SUCESS);
+    (void)lgs_file_async_failed(kStream);
+    (void)lgs_file_async_failed(kOtherStream);
+  }
+};
+
+TEST_F(LgsFileTest, HandlesQueuedRequestsInOrder) {
+  ASSERT_EQ(Queue(kStream, LGSF_RENAME_FILE, "rename"), LGSF_SUCESS);
+  ASSERT_EQ(Queue(kStream, LGSF_DELETE_FILE, "delete 1"), LGSF_SUCESS);
+  ASSERT_EQ(Queue(kStream, LGSF_DELETE_FILE, "delete 2"), LGSF_SUCESS);
+
+  EXPECT_EQ(lgs_file_async_wait(kStream), LGSF_SUCESS);
+  EXPECT_EQ(Handled(),
+            (std::vector<std::string>{"rename", "delete 1", "delete 2"}));
+  EXPECT_FALSE(lgs_file_async_failed(kStream));
+}
+
+TEST_F(LgsFileTest, RequestDoesNotWaitForQueuedRequestsOfOtherThread) {
+  ASSERT_EQ(Queue(kStream, LGSF_RENAME_FILE, kBlocked), LGSF_SUCESS);
+  ASSERT_EQ(Queue(kStream, LGSF_DELETE_FILE, "delete"), LGSF_SUCESS);
+
+  EXPECT_EQ(Write(kOtherStream, "write"), LGSF_SUCESS);
+  EXPECT_EQ(Handled(), std::vector<std::string>{"write"});
+
+  Release();
+  EXPECT_EQ(lgs_file_async_wait(kStream), LGSF_SUCESS);
+  EXPECT_EQ(Handled(),
+            (std::vector<std::string>{"write", kBlocked, "delete"}));
+}
+
+TEST_F(LgsFileTest, HandlesRequestBeforeQueuedRequestsNotStarted) {
+  ASSERT_EQ(Queue(kStream, LGSF_RENAME_FILE, kBlocked), LGSF_SUCESS);
+  ASSERT_EQ(Queue(kStream, LGSF_DELETE_FILE, "delete 1"), LGSF_SUCESS);
+  ASSERT_EQ(Queue(kStream, LGSF_DELETE_FILE, "delete 2"), LGSF_SUCESS);
+  WaitBlocked();
+
+  // The write waits for the started request only
+  std::thread releaser([] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    Release();
+  });
+  EXPECT_EQ(Write(kStream, "write"), LGSF_SUCESS);
+  releaser.join();
+
+  EXPECT_EQ(lgs_file_async_wait(kStream), LGSF_SUCESS);
+  EXPECT_EQ(Handled(), (std::vector<std::string>{kBlocked, "write",
+                                                 "delete 1", "delete 2"}));
+}
+
+TEST_F(LgsFileTest, ReportsFailedQueuedRequestForTheStream) {
+  ASSERT_EQ(Queue(kStream, LGSF_DELETE_FILE, kFailed), LGSF_SUCESS);
+  ASSERT_EQ(Queue(kOtherStream, LGSF_DELETE_FILE, "delete"), LGSF_SUCESS);
+
+  EXPECT_EQ(lgs_file_async_wait(kStream), LGSF_SUCESS);
+  EXPECT_EQ(lgs_file_async_wait(kOtherStream), LGSF_SUCESS);
+  EXPECT_FALSE(lgs_file_async_failed(kOtherStream));
+  EXPECT_TRUE(lgs_file_async_failed(kStream));
+  EXPECT_FALSE(lgs_file_async_failed(kStream));
+}
+
+TEST_F(LgsFileTest, WaitForQueuedRequestsTimesOut) {
+  file_io_timeout_ms = 100;
+  ASSERT_EQ(Queue(kStream, LGSF_RENAME_FILE, kBlocked), LGSF_SUCESS);
+
+  EXPECT_EQ(lgs_file_async_wait(kStream), LGSF_TIMEOUT);
+  EXPECT_EQ(lgs_file_async_wait(kOtherStream), LGSF_SUCESS);
+}
+
+}  // namespace
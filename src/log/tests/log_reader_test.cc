@@ -0,0 +1,232 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+#include "log/tools/log_reader.h"
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
+namespace {
+
+const char kAppFormat[] = "@Cr @Ch:@Cn:@Cs @Cm/@Cd/@CY @Sv @Sl \"@Cb\"";
+const char* const kSeverities[] = {"EM", "AL", "CR", "ER", "WA", "NO", "IN"};
+
+// 2026-03-01 10:00:00 local time
+time_t BaseTime() {
+  struct tm tm = {};
+  tm.tm_year = 2026 - 1900;
+  tm.tm_mon = 2;
+  tm.tm_mday = 1;
+  tm.tm_hour = 10;
+  tm.tm_isdst = -1;
+  return mktime(&tm);
+}
+
+// A log record as written with kAppFormat, one second after the one before
+std::string AppRecord(unsigned id, const std::string& body) {
+  time_t seconds = BaseTime() + id;
+  struct tm tm;
+  localtime_r(&seconds, &tm);
+  char record[256];
+  snprintf(record, sizeof(record),
+           "% 10d %02d:%02d:%02d %02d/%02d/%04d %s safLogger \"%s\"\n", id,
+           tm.tm_hour, tm.tm_min, tm.tm_sec, tm.tm_mon + 1, tm.tm_mday,
+           tm.tm_year + 1900, kSeverities[id % 7], body.c_str());
+  return record;
+}
+
+SaTimeT RecordTime(unsigned id) {
+  return static_cast<SaTimeT>(BaseTime() + id) * SA_TIME_ONE_SECOND;
+}
+
+}  // namespace
+
+class LogReaderTest : public ::testing::Test {
+ protected:
+  LogReaderTest() : tmpdir_{} {}
+
+  void SetUp() override {
+    char tmpdir[] = "/tmp/log_reader_test_XXXXXX";
+    char* result = mkdtemp(tmpdir);
+    ASSERT_NE(result, nullptr);
+    tmpdir_ = result;
+  }
+
+  void TearDown() override {
+    std::string cmd = std::string("rm -f ") + tmpdir_ + std::string("/*");
+    ASSERT_EQ(system(cmd.c_str()), 0);
+    ASSERT_EQ(rmdir(tmpdir_.c_str()), 0);
+  }
+
+  void WriteFile(const std::string& name, const std::string& content) {
+    std::ofstream ostr(tmpdir_ + "/" + name);
+    ostr << content;
+  }
+
+  void WriteConfigFile(const std::string& name, const std::string& format,
+                       int fixed_log_record_size) {
+    WriteFile(name, "LOG_SVC_VERSION: A.2.1\nFORMAT:" + format +
+                        "\nMAX_FILE_SIZE: 5000000\nFIXED_LOG_REC_SIZE: " +
+                        std::to_string(fixed_log_record_size) +
+                        "\nLOG_FULL_ACTION: ROTATE 10\n");
+  }
+
+  std::vector<std::string> Query(LogFileIndex* index, const LogQuery& query) {
+    std::vector<std::string> records;
+    size_t matches = index->Query(query, [&](const char* record, size_t size) {
+      records.emplace_back(record, size);
+    });
+    EXPECT_EQ(matches, records.size());
+    return records;
+  }
+
+  std::string tmpdir_;
+};
+
+TEST_F(LogReaderTest, ParseHeaderOfDefaultFormat) {
+  LogRecordLayout layout{kAppFormat, 0};
+  EXPECT_TRUE(layout.has_time());
+  EXPECT_TRUE(layout.has_severity());
+  SaTimeT time;
+  uint32_t severity;
+  std::string record = AppRecord(3, "body");
+  ASSERT_TRUE(layout.Parse(record.data(), record.size(), &time, &severity));
+  EXPECT_EQ(time, RecordTime(3));
+  EXPECT_EQ(severity, LogSeverityBit(SA_LOG_SEV_ERROR));
+  record = "continued line\n";
+  EXPECT_FALSE(layout.Parse(record.data(), record.size(), &time, &severity));
+}
+
+TEST_F(LogReaderTest, ParseRawTimeStampAndTimezone) {
+  SaTimeT time;
+  uint32_t severity;
+  LogRecordLayout raw{"@Cr @Ct @Nt @Ne6 \"@Cb\"", 0};
+  EXPECT_TRUE(raw.has_time());
+  EXPECT_FALSE(raw.has_severity());
+  std::string record = "         1 0x17f0000000000001 0x2 \"body\"\n";
+  ASSERT_TRUE(raw.Parse(record.data(), record.size(), &time, &severity));
+  EXPECT_EQ(time, SaTimeT{0x17f0000000000001});
+  EXPECT_EQ(severity, kLogSeverityUnknown);
+
+  LogRecordLayout utc{"@CY-@Cm-@Cd @Ch:@Cn:@Cs.@Ck@Cz @Cb", 0};
+  record = "2026-03-01 11:00:00.250+0100 body\n";
+  ASSERT_TRUE(utc.Parse(record.data(), record.size(), &time, &severity));
+  struct tm tm = {};
+  tm.tm_year = 2026 - 1900;
+  tm.tm_mon = 2;
+  tm.tm_mday = 1;
+  tm.tm_hour = 10;
+  EXPECT_EQ(time, static_cast<SaTimeT>(timegm(&tm)) * SA_TIME_ONE_SECOND +
+                      250 * SA_TIME_ONE_MILLISECOND);
+}
+
+TEST_F(LogReaderTest, QueryTimeRangeSeverityAndText) {
+  const unsigned kNoOfRecords = 1000;
+  std::string content;
+  for (unsigned i = 0; i != kNoOfRecords; ++i) {
+    content += AppRecord(i, i == 500 ? "first line\nsecond line" : "body");
+  }
+  WriteFile("app_20260301_100000.log", content);
+  LogFileIndex index{LogRecordLayout{kAppFormat, 0}};
+  ASSERT_TRUE(index.Open(tmpdir_ + "/app_20260301_100000.log"));
+  EXPECT_EQ(index.no_of_records(), kNoOfRecords);
+  EXPECT_EQ(index.no_of_blocks(),
+            (kNoOfRecords + LogFileIndex::kRecordsPerBlock - 1) /
+                LogFileIndex::kRecordsPerBlock);
+
+  LogQuery query;
+  query.start_time = RecordTime(300);
+  query.end_time = RecordTime(310);
+  std::vector<std::string> records = Query(&index, query);
+  ASSERT_EQ(records.size(), 10u);
+  EXPECT_EQ(records.front(), AppRecord(300, "body"));
+  EXPECT_EQ(records.back(), AppRecord(309, "body"));
+
+  query.severities = LogSeverityBit(SA_LOG_SEV_EMERGENCY);
+  records = Query(&index, query);
+  ASSERT_EQ(records.size(), 2u);
+  EXPECT_EQ(records[0], AppRecord(301, "body"));
+  EXPECT_EQ(records[1], AppRecord(308, "body"));
+
+  query = LogQuery{};
+  query.text = "second line";
+  records = Query(&index, query);
+  ASSERT_EQ(records.size(), 1u);
+  EXPECT_EQ(records.front(), AppRecord(500, "first line\nsecond line"));
+}
+
+TEST_F(LogReaderTest, QueryFixedSizeRecords) {
+  const size_t kRecordSize = 150;
+  std::string content;
+  for (unsigned i = 0; i != 600; ++i) {
+    std::string record = AppRecord(i, "fixed");
+    record.back() = ' ';
+    record.resize(kRecordSize, ' ');
+    record.back() = '\n';
+    content += record;
+  }
+  WriteFile("fixed_20260301_100000.log", content);
+  LogFileIndex index{LogRecordLayout{kAppFormat, kRecordSize}};
+  ASSERT_TRUE(index.Open(tmpdir_ + "/fixed_20260301_100000.log"));
+  EXPECT_EQ(index.no_of_records(), 600u);
+  LogQuery query;
+  query.start_time = RecordTime(599);
+  std::vector<std::string> records = Query(&index, query);
+  ASSERT_EQ(records.size(), 1u);
+  EXPECT_EQ(records.front().size(), kRecordSize);
+  EXPECT_EQ(records.front().compare(0, 11, "       599 "), 0);
+}
+
+TEST_F(LogReaderTest, FindRotatedAndCompressedLogFiles) {
+  WriteConfigFile("app.cfg", kAppFormat, 0);
+  WriteConfigFile("app_20260301_100010.cfg", "@Cb", 0);
+  WriteFile("app_20260301_100000_20260301_100010.log", "old format\n");
+  WriteFile("app_20260301_100020.log", AppRecord(20, "current"));
+  gzFile gz_file = gzopen(
+      (tmpdir_ + "/app_20260301_100010_20260301_100020.log.gz").c_str(), "wb");
+  ASSERT_NE(gz_file, nullptr);
+  std::string compressed = AppRecord(10, "compressed");
+  gzwrite(gz_file, compressed.data(), compressed.size());
+  ASSERT_EQ(gzclose(gz_file), Z_OK);
+  WriteFile("application_20260301_100000.log", "other stream\n");
+  WriteFile("app_20260301_100000.txt", "not a log file\n");
+
+  std::vector<LogFileName> files = FindLogFiles(tmpdir_, "app");
+  ASSERT_EQ(files.size(), 3u);
+  EXPECT_EQ(files[0].log_file,
+            tmpdir_ + "/app_20260301_100000_20260301_100010.log");
+  EXPECT_EQ(files[0].cfg_file, tmpdir_ + "/app_20260301_100010.cfg");
+  EXPECT_EQ(files[1].log_file,
+            tmpdir_ + "/app_20260301_100010_20260301_100020.log.gz");
+  EXPECT_EQ(files[1].cfg_file, tmpdir_ + "/app.cfg");
+  EXPECT_EQ(files[2].log_file, tmpdir_ + "/app_20260301_100020.log");
+  EXPECT_EQ(files[2].cfg_file, tmpdir_ + "/app.cfg");
+
+  LogRecordLayout layout;
+  ASSERT_TRUE(layout.ReadConfigFile(files[1].cfg_file));
+  EXPECT_EQ(layout.format_expression(), kAppFormat);
+  LogFileIndex index{layout};
+  ASSERT_TRUE(index.Open(files[1].log_file));
+  std::vector<std::string> records = Query(&index, LogQuery{});
+  ASSERT_EQ(records.size(), 1u);
+  EXPECT_EQ(records.front(), compressed);
+}
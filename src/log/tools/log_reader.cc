@@ -0,0 +1,565 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+#include "log/tools/log_reader.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+#include "log/logd/lgs_fmt.h"
+
+namespace {
+
+// Suffix of a log file compressed when rotated, see lgs_archive.h
+const char kCompressedSuffix[] = ".gz";
+
+const char* const kMonths[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                               "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+// Indexed by SaLogSeverityT, see extractSystemField()
+const char* const kSeverities[] = {"EM", "AL", "CR", "ER", "WA", "NO", "IN"};
+
+// The time fields of a log record header
+struct RecordTime {
+  struct tm tm;
+  int milliseconds;
+  // Offset from UTC in seconds, if the header has the time zone
+  bool has_gmtoff;
+  long gmtoff;
+  // The raw time stamp (@Ct), if the header has it
+  bool has_time_stamp;
+  SaTimeT time_stamp;
+};
+
+// Return the size of the field with the letter @a letter, as written by
+// LogFormat::Format(), or 0 if the field has a variable size. @a field_size
+// is the size given in the token, if any.
+size_t FieldSize(char type, char letter, int field_size) {
+  switch (type) {
+    case COMMON_LOG_RECORD_FIELD_TYPE:
+      switch (letter) {
+        case C_TIME_STAMP_HOUR_LETTER:
+        case C_TIME_STAMP_MINUTE_LETTER:
+        case C_TIME_STAMP_SECOND_LETTER:
+        case C_TIME_STAMP_12_24_MODE_LETTER:
+        case C_TIME_STAMP_MONTH_LETTER:
+        case C_TIME_STAMP_DAY_LETTER:
+        case C_TIME_STAMP_YEAR_LETTER:
+          return 2;
+        case C_TIME_STAMP_MON_LETTER:
+        case C_TIME_STAMP_DAYN_LETTER:
+        case C_TIME_MILLISECOND_LETTER:
+          return 3;
+        case C_TIME_STAMP_FULL_YEAR_LETTER:
+          return 4;
+        case C_TIME_TIMEZONE_LETTER:
+          return 5;
+        case C_LR_TRUNCATION_INFO_LETTER:
+          return 1;
+        default:
+          return 0;
+      }
+    case SYSTEM_LOG_RECORD_FIELD_TYPE:
+      if (letter == S_SEVERITY_ID_LETTER) return 2;
+      if (letter == S_LOGGER_NAME_LETTER && field_size > 0) return field_size;
+      return 0;
+    default:
+      return 0;
+  }
+}
+
+bool HasFieldSize(char type, char letter) {
+  return (type == COMMON_LOG_RECORD_FIELD_TYPE &&
+          (letter == C_LR_STRING_BODY_LETTER ||
+           letter == C_LR_HEX_CHAR_BODY_LETTER)) ||
+         (type == NOTIFICATION_LOG_RECORD_FIELD_TYPE &&
+          (letter == N_EVENT_TYPE_LETTER ||
+           letter == N_NOTIFICATION_OBJECT_LETTER ||
+           letter == N_NOTIFYING_OBJECT_LETTER)) ||
+         (type == SYSTEM_LOG_RECORD_FIELD_TYPE &&
+          letter == S_LOGGER_NAME_LETTER);
+}
+
+// Parse @a size decimal digits
+bool ParseDigits(const char* str, size_t size, int* value) {
+  int result = 0;
+  for (size_t i = 0; i != size; ++i) {
+    if (isdigit(static_cast<unsigned char>(str[i])) == 0) return false;
+    result = result * 10 + (str[i] - '0');
+  }
+  *value = result;
+  return true;
+}
+
+// Parse the time zone offset, +hhmm or -hhmm
+bool ParseTimezone(const char* str, long* gmtoff) {
+  int hhmm;
+  if ((str[0] != '+' && str[0] != '-') || !ParseDigits(str + 1, 4, &hhmm)) {
+    return false;
+  }
+  *gmtoff = (hhmm / 100) * 3600L + (hhmm % 100) * 60L;
+  if (str[0] == '-') *gmtoff = -*gmtoff;
+  return true;
+}
+
+// Parse the name of a log file,
+// <prefix>_yyyymmdd_hhmmss[_yyyymmdd_hhmmss].log[.gz], or of a renamed
+// configuration file, <prefix>_yyyymmdd_hhmmss.cfg, and return the first
+// time stamp in @a date and @a time
+bool ParseFileName(const std::string& name, const std::string& prefix,
+                   bool* is_cfg, int* date, int* time) {
+  if (name.compare(0, prefix.size() + 1, prefix + "_") != 0) return false;
+  const char* str = name.c_str() + prefix.size() + 1;
+  if (strlen(str) < strlen("yyyymmdd_hhmmss") || str[8] != '_' ||
+      !ParseDigits(str, 8, date) || !ParseDigits(str + 9, 6, time)) {
+    return false;
+  }
+  str += strlen("yyyymmdd_hhmmss");
+  int close_date, close_time;
+  if (str[0] == '_' && strlen(str) > strlen("_yyyymmdd_hhmmss") &&
+      str[9] == '_' && ParseDigits(str + 1, 8, &close_date) &&
+      ParseDigits(str + 10, 6, &close_time)) {
+    str += strlen("_yyyymmdd_hhmmss");
+    *is_cfg = false;
+  } else {
+    *is_cfg = strcmp(str, ".cfg") == 0;
+    if (*is_cfg) return true;
+  }
+  return strcmp(str, ".log") == 0 ||
+         strcmp(str, (std::string(".log") + kCompressedSuffix).c_str()) == 0;
+}
+
+uint64_t FileTime(int date, int time) {
+  return static_cast<uint64_t>(date) * 1000000 + time;
+}
+
+}  // namespace
+
+LogRecordLayout::LogRecordLayout(const std::string& format_expression,
+                                 uint16_t fixed_log_record_size)
+    : format_expression_{format_expression},
+      fixed_log_record_size_{fixed_log_record_size},
+      header_{},
+      has_time_{false},
+      has_severity_{false},
+      cached_hour_{},
+      cached_hour_time_{-1} {
+  Compile();
+}
+
+bool LogRecordLayout::ReadConfigFile(const std::string& cfg_file) {
+  FILE* file = fopen(cfg_file.c_str(), "r");
+  if (file == nullptr) return false;
+  bool has_format = false;
+  char line[1024];
+  while (fgets(line, sizeof(line), file) != nullptr) {
+    line[strcspn(line, "\n")] = '\0';
+    if (strncmp(line, kFormatKey, strlen(kFormatKey)) == 0) {
+      format_expression_ = &line[strlen(kFormatKey)];
+      has_format = true;
+    } else if (strncmp(line, kFixedLogRecordSizeKey,
+                       strlen(kFixedLogRecordSizeKey)) == 0) {
+      fixed_log_record_size_ =
+          strtoul(&line[strlen(kFixedLogRecordSizeKey)], nullptr, 10);
+    }
+  }
+  fclose(file);
+  Compile();
+  return has_format;
+}
+
+void LogRecordLayout::Compile() {
+  header_.clear();
+  has_time_ = false;
+  has_severity_ = false;
+  bool has_date = false;
+  const char* str = format_expression_.c_str();
+  while (*str != STRING_END_CHARACTER) {
+    if (*str != TOKEN_START_SYMBOL || str[1] == STRING_END_CHARACTER) {
+      // All chars between tokens are collected in one literal
+      if (header_.empty() || header_.back().type != LITERAL_FIELD_TYPE) {
+        header_.push_back(Field{LITERAL_FIELD_TYPE, 0, 0, {}});
+      }
+      header_.back().literal += *str++;
+      continue;
+    }
+    Field field{str[1], str[2], 0, {}};
+    if (field.letter == STRING_END_CHARACTER) break;
+    str += DEFAULT_FMT_EXP_PTR_OFFSET;
+    int field_size = 0;
+    if (HasFieldSize(field.type, field.letter)) {
+      // As checkFieldSize() in lgs_fmt.cc
+      std::string digits;
+      while (isdigit(static_cast<unsigned char>(*str)) != 0 &&
+             digits.size() <
+                 std::to_string(SA_LOG_MAX_RECORD_SIZE).size() + 1) {
+        digits += *str++;
+      }
+      field_size = strtol(digits.c_str(), nullptr, 0);
+    }
+    field.size = FieldSize(field.type, field.letter, field_size);
+    bool is_number = field.type == COMMON_LOG_RECORD_FIELD_TYPE &&
+                     (field.letter == C_LR_ID_LETTER ||
+                      field.letter == C_LR_TIME_STAMP_LETTER);
+    // The fields after a field of variable size cannot be located
+    if (field.size == 0 && !is_number) break;
+    if (field.type == COMMON_LOG_RECORD_FIELD_TYPE) {
+      switch (field.letter) {
+        case C_LR_TIME_STAMP_LETTER:
+          has_time_ = true;
+          break;
+        case C_TIME_STAMP_DAY_LETTER:
+          has_date = true;
+          break;
+        default:
+          break;
+      }
+    } else if (field.type == SYSTEM_LOG_RECORD_FIELD_TYPE &&
+               field.letter == S_SEVERITY_ID_LETTER) {
+      has_severity_ = true;
+    }
+    header_.push_back(field);
+  }
+  // Without the raw time stamp, the time is the date and the time of day
+  if (has_date) {
+    bool has_year = false, has_month = false, has_hour = false;
+    for (const Field& field : header_) {
+      if (field.type != COMMON_LOG_RECORD_FIELD_TYPE) continue;
+      has_year = has_year || field.letter == C_TIME_STAMP_YEAR_LETTER ||
+                 field.letter == C_TIME_STAMP_FULL_YEAR_LETTER;
+      has_month = has_month || field.letter == C_TIME_STAMP_MONTH_LETTER ||
+                  field.letter == C_TIME_STAMP_MON_LETTER;
+      has_hour = has_hour || field.letter == C_TIME_STAMP_HOUR_LETTER;
+    }
+    has_time_ = has_time_ || (has_year && has_month && has_hour);
+  }
+}
+
+time_t LogRecordLayout::LocalTime(const struct tm& tm) const {
+  if (cached_hour_time_ == -1 || tm.tm_hour != cached_hour_.tm_hour ||
+      tm.tm_mday != cached_hour_.tm_mday || tm.tm_mon != cached_hour_.tm_mon ||
+      tm.tm_year != cached_hour_.tm_year) {
+    struct tm hour = tm;
+    hour.tm_min = 0;
+    hour.tm_sec = 0;
+    hour.tm_isdst = -1;
+    cached_hour_ = tm;
+    cached_hour_time_ = mktime(&hour);
+  }
+  return cached_hour_time_ + tm.tm_min * 60 + tm.tm_sec;
+}
+
+bool LogRecordLayout::Parse(const char* record, size_t size, SaTimeT* time,
+                            uint32_t* severity) const {
+  RecordTime record_time{};
+  *severity = kLogSeverityUnknown;
+  const char* end = record + size;
+  const char* str = record;
+  for (const Field& field : header_) {
+    if (field.type == LITERAL_FIELD_TYPE) {
+      size_t length = field.literal.size();
+      if (static_cast<size_t>(end - str) < length ||
+          memcmp(str, field.literal.data(), length) != 0) {
+        return false;
+      }
+      str += length;
+      continue;
+    }
+    if (field.size == 0) {
+      // The record id, "% 10d", or the time stamp, "%#016llx"
+      const char* number;
+      if (field.letter == C_LR_ID_LETTER) {
+        while (str != end && *str == ' ') ++str;
+        if (str != end && *str == '-') ++str;
+        number = str;
+        while (str != end && isdigit(static_cast<unsigned char>(*str))) ++str;
+        if (str == number) return false;
+      } else {
+        if (end - str >= 2 && str[0] == '0' && str[1] == 'x') str += 2;
+        number = str;
+        while (str != end && isxdigit(static_cast<unsigned char>(*str))) ++str;
+        if (str == number) return false;
+        record_time.has_time_stamp = true;
+        record_time.time_stamp =
+            strtoull(std::string(number, str).c_str(), nullptr, 16);
+      }
+      continue;
+    }
+    if (static_cast<size_t>(end - str) < field.size) return false;
+    bool ok = true;
+    struct tm& tm = record_time.tm;
+    if (field.type == COMMON_LOG_RECORD_FIELD_TYPE) {
+      switch (field.letter) {
+        case C_TIME_STAMP_HOUR_LETTER:
+          ok = ParseDigits(str, 2, &tm.tm_hour);
+          break;
+        case C_TIME_STAMP_MINUTE_LETTER:
+          ok = ParseDigits(str, 2, &tm.tm_min);
+          break;
+        case C_TIME_STAMP_SECOND_LETTER:
+          ok = ParseDigits(str, 2, &tm.tm_sec);
+          break;
+        case C_TIME_STAMP_MONTH_LETTER:
+          ok = ParseDigits(str, 2, &tm.tm_mon);
+          --tm.tm_mon;
+          break;
+        case C_TIME_STAMP_MON_LETTER:
+          ok = false;
+          for (int i = 0; i != 12; ++i) {
+            if (memcmp(str, kMonths[i], 3) == 0) {
+              tm.tm_mon = i;
+              ok = true;
+              break;
+            }
+          }
+          break;
+        case C_TIME_STAMP_DAY_LETTER:
+          ok = ParseDigits(str, 2, &tm.tm_mday);
+          break;
+        case C_TIME_STAMP_YEAR_LETTER:
+          ok = ParseDigits(str, 2, &tm.tm_year);
+          tm.tm_year += YEAR_2000 - START_YEAR;
+          break;
+        case C_TIME_STAMP_FULL_YEAR_LETTER:
+          ok = ParseDigits(str, 4, &tm.tm_year);
+          tm.tm_year -= START_YEAR;
+          break;
+        case C_TIME_MILLISECOND_LETTER:
+          ok = ParseDigits(str, 3, &record_time.milliseconds);
+          break;
+        case C_TIME_TIMEZONE_LETTER:
+          ok = ParseTimezone(str, &record_time.gmtoff);
+          record_time.has_gmtoff = ok;
+          break;
+        default:
+          break;
+      }
+    } else if (field.letter == S_SEVERITY_ID_LETTER) {
+      for (SaLogSeverityT i = SA_LOG_SEV_EMERGENCY; i <= SA_LOG_SEV_INFO; ++i) {
+        if (memcmp(str, kSeverities[i], 2) == 0) {
+          *severity = LogSeverityBit(i);
+          break;
+        }
+      }
+    }
+    if (!ok) return false;
+    str += field.size;
+  }
+
+  if (record_time.has_time_stamp) {
+    *time = record_time.time_stamp;
+  } else if (has_time_) {
+    struct tm& tm = record_time.tm;
+    time_t seconds;
+    if (record_time.has_gmtoff) {
+      seconds = timegm(&tm) - record_time.gmtoff;
+    } else {
+      seconds = LocalTime(tm);
+    }
+    *time = static_cast<SaTimeT>(seconds) * SA_TIME_ONE_SECOND +
+            static_cast<SaTimeT>(record_time.milliseconds) *
+                SA_TIME_ONE_MILLISECOND;
+  }
+  return true;
+}
+
+LogFileIndex::LogFileIndex(const LogRecordLayout& layout)
+    : layout_{layout},
+      data_{nullptr},
+      size_{0},
+      mapped_{false},
+      decompressed_{},
+      blocks_{},
+      no_of_records_{0} {}
+
+LogFileIndex::~LogFileIndex() {
+  if (mapped_) munmap(const_cast<char*>(data_), size_);
+}
+
+bool LogFileIndex::Open(const std::string& path) {
+  size_t suffix_size = strlen(kCompressedSuffix);
+  if (path.size() > suffix_size &&
+      path.compare(path.size() - suffix_size, suffix_size,
+                   kCompressedSuffix) == 0) {
+    gzFile file = gzopen(path.c_str(), "rb");
+    if (file == nullptr) return false;
+    char buffer[64 * 1024];
+    int bytes_read;
+    while ((bytes_read = gzread(file, buffer, sizeof(buffer))) > 0) {
+      decompressed_.insert(decompressed_.end(), buffer, buffer + bytes_read);
+    }
+    gzclose(file);
+    if (bytes_read < 0) return false;
+    data_ = decompressed_.data();
+    size_ = decompressed_.size();
+  } else {
+    int fd;
+    do {
+      fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    } while (fd == -1 && errno == EINTR);
+    if (fd == -1) return false;
+    struct stat statbuf;
+    if (fstat(fd, &statbuf) != 0) {
+      close(fd);
+      return false;
+    }
+    size_ = statbuf.st_size;
+    if (size_ != 0) {
+      void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        close(fd);
+        size_ = 0;
+        return false;
+      }
+      // The index is built by reading the file from the start to the end
+      (void)madvise(data, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(data);
+      mapped_ = true;
+    }
+    close(fd);
+  }
+  BuildIndex();
+  return true;
+}
+
+size_t LogFileIndex::RecordEnd(size_t offset) const {
+  uint16_t fixed_size = layout_.fixed_log_record_size();
+  if (fixed_size != 0) return std::min(offset + fixed_size, size_);
+  SaTimeT time;
+  uint32_t severity;
+  size_t end = offset;
+  do {
+    const void* newline = memchr(data_ + end, '\n', size_ - end);
+    end = newline != nullptr
+              ? static_cast<const char*>(newline) - data_ + 1
+              : size_;
+  } while (end != size_ &&
+           !layout_.Parse(data_ + end, size_ - end, &time, &severity));
+  return end;
+}
+
+void LogFileIndex::BuildIndex() {
+  blocks_.clear();
+  no_of_records_ = 0;
+  size_t offset = 0;
+  while (offset != size_) {
+    Block block{offset, offset, SA_TIME_END, 0, 0};
+    for (size_t i = 0; i != kRecordsPerBlock && offset != size_; ++i) {
+      SaTimeT time = 0;
+      uint32_t severity;
+      if (layout_.Parse(data_ + offset, size_ - offset, &time, &severity)) {
+        block.severities |= severity;
+        if (layout_.has_time()) {
+          block.min_time = std::min(block.min_time, time);
+          block.max_time = std::max(block.max_time, time);
+        }
+      } else {
+        // Not a valid log record, e.g. the start of a file written with
+        // another format. It is never skipped by the index.
+        block.severities = kLogSeverityAll;
+        block.min_time = 0;
+        block.max_time = SA_TIME_END;
+      }
+      offset = RecordEnd(offset);
+      ++no_of_records_;
+    }
+    block.end = offset;
+    blocks_.push_back(block);
+  }
+}
+
+size_t LogFileIndex::Query(
+    const LogQuery& query,
+    const std::function<void(const char*, size_t)>& output) const {
+  bool check_time = layout_.has_time() &&
+                    (query.start_time != 0 || query.end_time != SA_TIME_END);
+  size_t no_of_matches = 0;
+  for (const Block& block : blocks_) {
+    if ((block.severities & query.severities) == 0) continue;
+    if (check_time && (block.max_time < query.start_time ||
+                       block.min_time >= query.end_time)) {
+      continue;
+    }
+    size_t offset = block.begin;
+    while (offset != block.end) {
+      size_t end = RecordEnd(offset);
+      const char* record = data_ + offset;
+      size_t size = end - offset;
+      offset = end;
+      SaTimeT time = 0;
+      uint32_t severity = kLogSeverityAll;
+      if (layout_.Parse(record, size, &time, &severity)) {
+        if ((severity & query.severities) == 0) continue;
+        if (check_time && (time < query.start_time || time >= query.end_time))
+          continue;
+      }
+      if (!query.text.empty() &&
+          memmem(record, size, query.text.data(), query.text.size()) ==
+              nullptr) {
+        continue;
+      }
+      ++no_of_matches;
+      output(record, size);
+    }
+  }
+  return no_of_matches;
+}
+
+std::vector<LogFileName> FindLogFiles(const std::string& directory,
+                                      const std::string& file_name) {
+  std::vector<LogFileName> log_files;
+  // Renamed configuration files, by the time they were renamed
+  std::map<uint64_t, std::string> cfg_files;
+  DIR* dir = opendir(directory.c_str());
+  if (dir == nullptr) return log_files;
+  struct dirent* entry;
+  while ((entry = readdir(dir)) != nullptr) {
+    bool is_cfg;
+    int date, time;
+    if (!ParseFileName(entry->d_name, file_name, &is_cfg, &date, &time)) {
+      continue;
+    }
+    std::string path = directory + "/" + entry->d_name;
+    if (is_cfg) {
+      cfg_files[FileTime(date, time)] = path;
+    } else {
+      log_files.push_back(LogFileName{path, {}, date, time});
+    }
+  }
+  closedir(dir);
+
+  std::sort(log_files.begin(), log_files.end(),
+            [](const LogFileName& a, const LogFileName& b) {
+              return FileTime(a.date, a.time) < FileTime(b.date, b.time);
+            });
+  for (LogFileName& log_file : log_files) {
+    auto cfg = cfg_files.upper_bound(FileTime(log_file.date, log_file.time));
+    log_file.cfg_file = cfg != cfg_files.end()
+                            ? cfg->second
+                            : directory + "/" + file_name + ".cfg";
+  }
+  return log_files;
+}
@@ -0,0 +1,181 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+#ifndef LOG_TOOLS_LOG_READER_H_
+#define LOG_TOOLS_LOG_READER_H_
+
+#include <saAis.h>
+#include <saLog.h>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+#include "base/macros.h"
+
+// Reading of the log files written by osaflogd, for searching the log records
+// of a stream offline, e.g. when investigating an incident.
+//
+// The log files of a stream are found by their names, see FindLogFiles(). The
+// layout of the log records in a file is given by the format expression in
+// the configuration (.cfg) file of the stream, see LogRecordLayout. A log
+// file is memory mapped (or decompressed if it was compressed when rotated)
+// and a sparse index is built from the headers of the log records, see
+// LogFileIndex. A query then only looks at the blocks of log records which
+// may match.
+
+// Bit for a severity in LogQuery::severities, e.g.
+// LogSeverityBit(SA_LOG_SEV_ERROR)
+inline uint32_t LogSeverityBit(SaLogSeverityT severity) {
+  return uint32_t{1} << severity;
+}
+
+// Log records of unknown severity, e.g. of alarm and notification streams
+const uint32_t kLogSeverityUnknown = uint32_t{1} << 7;
+const uint32_t kLogSeverityAll = 0xff;
+
+struct LogQuery {
+  // Time range [start_time, end_time) of the log records, in nanoseconds
+  // since the epoch. The time range is ignored if the log records have no
+  // time stamp.
+  SaTimeT start_time{0};
+  SaTimeT end_time{SA_TIME_END};
+  // Severities of the log records, see LogSeverityBit()
+  uint32_t severities{kLogSeverityAll};
+  // Text the log records shall contain, an empty text matches all
+  std::string text{};
+};
+
+// The header of the log records of a stream, i.e. the fields before the
+// first field of variable size in the format expression.
+class LogRecordLayout {
+ public:
+  // Keys in the .cfg file, as written by lgs_create_config_file_h()
+  static constexpr const char* kFormatKey = "FORMAT:";
+  static constexpr const char* kFixedLogRecordSizeKey = "FIXED_LOG_REC_SIZE:";
+
+  LogRecordLayout() : LogRecordLayout{std::string{}, 0} {}
+  LogRecordLayout(const std::string& format_expression,
+                  uint16_t fixed_log_record_size);
+  // Read the format expression and the fixed log record size from the
+  // configuration file @a cfg_file. Return false if it could not be read.
+  bool ReadConfigFile(const std::string& cfg_file);
+
+  const std::string& format_expression() const { return format_expression_; }
+  uint16_t fixed_log_record_size() const { return fixed_log_record_size_; }
+  // True if the time stamp of the log records is in the header
+  bool has_time() const { return has_time_; }
+  // True if the severity of the log records is in the header
+  bool has_severity() const { return has_severity_; }
+  // Parse the header of the log record at @a record, which has at most @a
+  // size bytes. Return false if the header does not match the format
+  // expression, i.e. it is not the start of a log record. The time stamp is
+  // only valid if has_time() and the severity is kLogSeverityUnknown unless
+  // has_severity().
+  bool Parse(const char* record, size_t size, SaTimeT* time,
+             uint32_t* severity) const;
+
+ private:
+  struct Field {
+    char type;  // logRecordFieldTypeT
+    char letter;
+    // Number of characters, 0 for the record id and the time stamp which
+    // are parsed as numbers
+    size_t size;
+    std::string literal;
+  };
+  void Compile();
+  // Convert the local time @a tm, normalized by mktime() for the same hour
+  time_t LocalTime(const struct tm& tm) const;
+
+  std::string format_expression_;
+  uint16_t fixed_log_record_size_;
+  std::vector<Field> header_;
+  bool has_time_;
+  bool has_severity_;
+  // The last hour a local time was converted for, mktime() is expensive.
+  // A layout is therefore not thread safe, use a copy per thread.
+  mutable struct tm cached_hour_;
+  mutable time_t cached_hour_time_;
+};
+
+// A log file, memory mapped or decompressed, with a sparse index of its log
+// records: the log records are divided into blocks of kRecordsPerBlock
+// records and the index has the time range and severities of each block.
+// The log file must not be written to while it is used, i.e. it shall be a
+// closed log file or the stream shall not be written to.
+class LogFileIndex {
+ public:
+  static constexpr size_t kRecordsPerBlock = 256;
+  explicit LogFileIndex(const LogRecordLayout& layout);
+  ~LogFileIndex();
+  // Map the log file @a path, or read it if it is compressed (has the suffix
+  // ".gz"), and build the index. Return false if the file could not be read.
+  bool Open(const std::string& path);
+  size_t no_of_records() const { return no_of_records_; }
+  size_t no_of_blocks() const { return blocks_.size(); }
+  // Call @a output for each log record in the file matching @a query, in
+  // the order they are stored in the file. The log record includes the
+  // terminating newline (and the padding of a fixed size log record).
+  // Return the number of matching log records.
+  size_t Query(const LogQuery& query,
+               const std::function<void(const char*, size_t)>& output) const;
+
+ private:
+  struct Block {
+    size_t begin;
+    size_t end;
+    SaTimeT min_time;
+    SaTimeT max_time;
+    uint32_t severities;
+  };
+  // Return the end of the log record starting at @a offset. A line not
+  // starting with a log record header is a continuation of the log record
+  // before, i.e. the log record contains a newline.
+  size_t RecordEnd(size_t offset) const;
+  void BuildIndex();
+
+  const LogRecordLayout layout_;
+  const char* data_;
+  size_t size_;
+  // Set if data_ is mapped, otherwise data_ points to decompressed_
+  bool mapped_;
+  std::vector<char> decompressed_;
+  std::vector<Block> blocks_;
+  size_t no_of_records_;
+
+  DELETE_COPY_AND_MOVE_OPERATORS(LogFileIndex);
+};
+
+// A log file of a stream and the configuration file giving its layout
+struct LogFileName {
+  std::string log_file;
+  std::string cfg_file;
+  // Creation time, yyyymmdd and hhmmss, from the file name
+  int date;
+  int time;
+};
+
+// Return the log files in @a directory of the stream with the file name @a
+// file_name (saLogStreamFileName), oldest first. Both the current and the
+// closed log files are returned, also those compressed when rotated. The
+// configuration file of a log file is the one renamed when the log file was
+// closed because of a configuration change, if any, or else the current
+// configuration file.
+std::vector<LogFileName> FindLogFiles(const std::string& directory,
+                                      const std::string& file_name);
+
+#endif  // LOG_TOOLS_LOG_READER_H_
@@ -0,0 +1,246 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+#include <getopt.h>
+#include <time.h>
+#include <unistd.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "base/string_parse.h"
+#include "log/tools/log_reader.h"
+
+namespace {
+
+// The result of a query of one log file
+struct Result {
+  bool done{false};
+  bool ok{false};
+  size_t no_of_matches{0};
+  std::string records{};
+};
+
+void PrintUsage(const char* program_name) {
+  fprintf(stderr,
+          "Usage: %s [OPTION]... STREAM...\n"
+          "\n"
+          "Print the log records of the log STREAM(s) matching the query,\n"
+          "searching all the log files of a stream: the current log file,\n"
+          "the rotated log files and the compressed log files. STREAM is the\n"
+          "path of the log files without the time stamps, e.g.\n"
+          "/var/log/opensaf/saflog/saLogSystem. The log files shall be\n"
+          "readable, i.e. it must be run as a user in the log data group.\n"
+          "\n"
+          "Options:\n"
+          "\n"
+          "-f or --from=TIME     Print the log records with a time stamp at\n"
+          "                      or after TIME, 'YYYY-MM-DD hh:mm:ss' in\n"
+          "                      local time.\n"
+          "-t or --to=TIME       Print the log records with a time stamp\n"
+          "                      before TIME.\n"
+          "-s or --severity=LIST Print the log records with one of the\n"
+          "                      severities in the comma separated LIST, e.g.\n"
+          "                      'EM,AL,CR,ER'. The log records of alarm and\n"
+          "                      notification streams have no severity.\n"
+          "-g or --grep=TEXT     Print the log records containing TEXT.\n"
+          "-c or --count         Print the number of matching log records\n"
+          "                      instead of the log records.\n"
+          "-j or --jobs=N        Search N log files in parallel. The default\n"
+          "                      is the number of CPUs.\n",
+          program_name);
+}
+
+bool ParseTime(const char* str, SaTimeT* time) {
+  struct tm tm;
+  memset(&tm, 0, sizeof(tm));
+  const char* end = strptime(str, "%Y-%m-%d %H:%M:%S", &tm);
+  if (end == nullptr || *end != '\0') return false;
+  tm.tm_isdst = -1;
+  time_t seconds = mktime(&tm);
+  if (seconds == -1) return false;
+  *time = static_cast<SaTimeT>(seconds) * SA_TIME_ONE_SECOND;
+  return true;
+}
+
+bool ParseSeverities(const char* str, uint32_t* severities) {
+  static const char* const kSeverities[] = {"EM", "AL", "CR", "ER",
+                                            "WA", "NO", "IN"};
+  *severities = 0;
+  std::string list = str;
+  size_t pos = 0;
+  while (pos <= list.size()) {
+    size_t comma = list.find(',', pos);
+    if (comma == std::string::npos) comma = list.size();
+    std::string severity = list.substr(pos, comma - pos);
+    bool found = false;
+    for (SaLogSeverityT i = SA_LOG_SEV_EMERGENCY; i <= SA_LOG_SEV_INFO; ++i) {
+      if (severity == kSeverities[i]) {
+        *severities |= LogSeverityBit(i);
+        found = true;
+      }
+    }
+    if (!found) return false;
+    pos = comma + 1;
+  }
+  return true;
+}
+
+// Query the log file @a log_file
+void QueryFile(const LogFileName& log_file, const LogQuery& query,
+               bool count_only, Result* result) {
+  LogRecordLayout layout;
+  if (!layout.ReadConfigFile(log_file.cfg_file)) {
+    fprintf(stderr, "Could not read %s\n", log_file.cfg_file.c_str());
+    return;
+  }
+  LogFileIndex index{layout};
+  if (!index.Open(log_file.log_file)) {
+    fprintf(stderr, "Could not read %s\n", log_file.log_file.c_str());
+    return;
+  }
+  result->no_of_matches =
+      index.Query(query, [&](const char* record, size_t size) {
+        if (!count_only) result->records.append(record, size);
+      });
+  result->ok = true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  struct option long_options[] = {{"from", required_argument, nullptr, 'f'},
+                                  {"to", required_argument, nullptr, 't'},
+                                  {"severity", required_argument, nullptr, 's'},
+                                  {"grep", required_argument, nullptr, 'g'},
+                                  {"count", no_argument, nullptr, 'c'},
+                                  {"jobs", required_argument, nullptr, 'j'},
+                                  {"help", no_argument, nullptr, 'h'},
+                                  {nullptr, 0, nullptr, 0}};
+  LogQuery query;
+  bool count_only = false;
+  size_t no_of_jobs = std::thread::hardware_concurrency();
+  int option;
+  while ((option = getopt_long(argc, argv, "f:t:s:g:cj:h", long_options,
+                               nullptr)) != -1) {
+    switch (option) {
+      case 'f':
+        if (!ParseTime(optarg, &query.start_time)) {
+          fprintf(stderr, "Illegal time '%s'\n", optarg);
+          exit(EXIT_FAILURE);
+        }
+        break;
+      case 't':
+        if (!ParseTime(optarg, &query.end_time)) {
+          fprintf(stderr, "Illegal time '%s'\n", optarg);
+          exit(EXIT_FAILURE);
+        }
+        break;
+      case 's':
+        if (!ParseSeverities(optarg, &query.severities)) {
+          fprintf(stderr, "Illegal severity list '%s'\n", optarg);
+          exit(EXIT_FAILURE);
+        }
+        break;
+      case 'g':
+        query.text = optarg;
+        break;
+      case 'c':
+        count_only = true;
+        break;
+      case 'j': {
+        bool success;
+        no_of_jobs = base::StrToUint64(optarg, &success);
+        if (!success || no_of_jobs == 0) {
+          fprintf(stderr, "Illegal number of jobs '%s'\n", optarg);
+          exit(EXIT_FAILURE);
+        }
+        break;
+      }
+      case 'h':
+        PrintUsage(argv[0]);
+        exit(EXIT_SUCCESS);
+      default:
+        PrintUsage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+  }
+  if (optind == argc) {
+    PrintUsage(argv[0]);
+    exit(EXIT_FAILURE);
+  }
+
+  std::vector<LogFileName> log_files;
+  for (int i = optind; i != argc; ++i) {
+    std::string stream = argv[i];
+    size_t slash = stream.rfind('/');
+    std::string directory =
+        slash != std::string::npos ? stream.substr(0, slash) : ".";
+    std::string file_name =
+        slash != std::string::npos ? stream.substr(slash + 1) : stream;
+    std::vector<LogFileName> files = FindLogFiles(directory, file_name);
+    if (files.empty()) {
+      fprintf(stderr, "No log files found for %s\n", stream.c_str());
+    }
+    log_files.insert(log_files.end(), files.begin(), files.end());
+  }
+  if (no_of_jobs == 0) no_of_jobs = 1;
+  if (no_of_jobs > log_files.size()) no_of_jobs = log_files.size();
+
+  // The log files are queried in parallel and the results are printed in
+  // the order of the log files, as soon as the results of all the log files
+  // before have been printed
+  std::vector<Result> results(log_files.size());
+  std::atomic<size_t> next_file{0};
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::thread> jobs;
+  for (size_t i = 0; i != no_of_jobs; ++i) {
+    jobs.emplace_back([&]() {
+      size_t file;
+      while ((file = next_file++) < log_files.size()) {
+        Result result;
+        QueryFile(log_files[file], query, count_only, &result);
+        std::lock_guard<std::mutex> lock(mutex);
+        results[file] = std::move(result);
+        results[file].done = true;
+        cv.notify_all();
+      }
+    });
+  }
+
+  bool ok = true;
+  size_t no_of_matches = 0;
+  for (Result& result : results) {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&result] { return result.done; });
+    std::string records = std::move(result.records);
+    lock.unlock();
+    ok = ok && result.ok;
+    no_of_matches += result.no_of_matches;
+    if (fwrite(records.data(), 1, records.size(), stdout) != records.size()) {
+      ok = false;
+    }
+  }
+  for (std::thread& job : jobs) job.join();
+  if (count_only) printf("%zu\n", no_of_matches);
+  if (fflush(stdout) != 0) ok = false;
+  return ok && !log_files.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -31,6 +31,7 @@
 #define MSG_AGENT_MQA_H_
 
 #include "msg/common/mqsv.h"
+#include <opensaf/mqsv_papi.h>
 
 /* MQA includes ... */
 #include "mqa_mem.h"
@@ -30,6 +30,7 @@
 #include "mqa.h"
 
 #include <sched.h>
+#include <vector>
 
 /* All MQA utility functions prototypes. */
 
@@ -47,6 +48,10 @@ static SaAisErrorT mqa_send_to_destination_async(MQA_CB *mqa_cb,
                                                  MDS_DEST *mqnd_mds_dest,
                                                  MQSV_DSEND_EVT *qsend_evt,
                                                  uint32_t length);
+static SaAisErrorT mqa_send_to_local_queue(MQA_CB *mqa_cb,
+                                           SaMsgQueueHandleT queueHandle,
+                                           const SaMsgMessageT *message,
+                                           uint32_t msg_fmt_ver);
 static SaAisErrorT mqa_send_to_group(MQA_CB *mqa_cb, ASAPi_OPR_INFO *asapi_or,
                                      MQSV_DSEND_EVT *qsend_evt,
                                      SaMsgAckFlagsT ackFlags,
@@ -63,6 +68,19 @@ static SaAisErrorT mqa_receive_message(SaMsgQueueHandleT queueHandle,
                                        SaTimeT *sendTime,
                                        SaMsgSenderIdT *senderId,
                                        SaTimeT timeout);
+static SaAisErrorT mqa_send_batch_to_destination(
+    MQA_CB *mqa_cb, MDS_DEST *mqnd_mds_dest, SaMsgHandleT msgHandle,
+    SaMsgQueueHandleT queueHandle, const SaMsgMessageT *messages,
+    SaUint32T numberOfMessages, SaTimeT timeout, uint32_t msg_fmt_ver,
+    uint32_t length, SaAisErrorT *errors);
+static SaAisErrorT mqa_receive_batch(SaMsgQueueHandleT queueHandle,
+                                     SaMsgMessageT *messages,
+                                     SaTimeT *sendTimes,
+                                     SaMsgSenderIdT *senderIds,
+                                     SaUint32T maxMessages,
+                                     SaUint32T *numberOfMessages);
+static void mqa_received_callbacks_skip(SaMsgQueueHandleT queueHandle,
+                                        SaUint32T count);
 static SaAisErrorT mqa_send_receive(MQA_CB *mqa_cb, MDS_DEST *mqnd_mds_dest,
                                     MQSV_DSEND_EVT *qsend_evt,
                                     MQSV_DSEND_EVT **qreply_evt,
@@ -1785,6 +1803,104 @@ SaAisErrorT mqa_send_to_destination_async(MQA_CB *mqa_cb,
   return SA_AIS_OK;
 }
 
+/****************************************************************************
+  Name          : mqa_send_to_local_queue
+
+  Description   : This routine puts a message directly into a queue which is
+                  opened on this node, if the local MQND allows it and the
+                  message fits into the queue. The space of the message is
+                  accounted for in the queue itself, MQND is only notified so
+                  that it updates the queue stats. The message itself is not
+                  sent to MQND.
+
+  Arguments     : MQA_CB *mqa_cb - MQA control block
+                  SaMsgQueueHandleT queueHandle - the destination queue
+                  const SaMsgMessageT *message - the message to be sent
+                  uint32_t msg_fmt_ver - message format version
+
+  Return Values : SaAisErrorT, SA_AIS_ERR_NOT_SUPPORTED if the message shall
+                  be sent to MQND instead.
+
+  Notes         : None
+******************************************************************************/
+static SaAisErrorT mqa_send_to_local_queue(MQA_CB *mqa_cb,
+                                           SaMsgQueueHandleT queueHandle,
+                                           const SaMsgMessageT *message,
+                                           uint32_t msg_fmt_ver) {
+  NCS_OS_POSIX_MQ_REQ_INFO mq_req;
+  NCS_OS_MQ_MSG mq_msg;
+  MQSV_MESSAGE *mqsv_msg = (MQSV_MESSAGE *)mq_msg.data;
+  MQSV_DSEND_EVT *notify_evt;
+  SaMsgQueueHandleT listenerHandle = 0;
+  uint32_t size = sizeof(MQSV_MESSAGE) + message->size;
+
+  TRACE_ENTER2("queue handle %llu", queueHandle);
+
+  /* Same as the message written by MQND, see mqnd_evt_proc_send_msg() */
+  memset(mqsv_msg, 0, sizeof(MQSV_MESSAGE));
+  mqsv_msg->type = MQP_EVT_GET_REQ;
+  mqsv_msg->mqsv_version = MQSV_MSG_VERSION;
+  mqsv_msg->info.msg.message_info.sendReceive = SA_FALSE;
+  m_GET_TIME_STAMP(mqsv_msg->info.msg.message_info.sendTime);
+  if (message->data)
+    memcpy(mqsv_msg->info.msg.message.data, message->data, message->size);
+  mqsv_msg->info.msg.message.priority = message->priority;
+  mqsv_msg->info.msg.message.size = message->size;
+  mqsv_msg->info.msg.message.type = message->type;
+  mqsv_msg->info.msg.message.version = message->version;
+  if (message->senderName)
+    mqsv_msg->info.msg.message.senderName = *message->senderName;
+
+  memset(&mq_req, 0, sizeof(NCS_OS_POSIX_MQ_REQ_INFO));
+  mq_req.req = NCS_OS_POSIX_MQ_REQ_MSG_SEND_ASYNC;
+  mq_req.info.send.mqd = queueHandle;
+  mq_req.info.send.datalen = size;
+  mq_req.info.send.i_msg = &mq_msg;
+  mq_req.info.send.i_mtype = message->priority + 3;
+
+  /* Not put if the queue is not owned, full or the message too big, MQND
+   * then reports the error */
+  if (mqsv_shm_mq_direct_send(&mq_req.info.send, message->priority,
+                              message->size,
+                              &listenerHandle) != NCSCC_RC_SUCCESS) {
+    TRACE_LEAVE2("Sent through MQND");
+    return SA_AIS_ERR_NOT_SUPPORTED;
+  }
+
+  /* The message is in the queue, a receiver which is not woken up finds it
+   * with its next get */
+  if (mqsv_listenerq_msg_send(listenerHandle) != NCSCC_RC_SUCCESS)
+    TRACE_4("Unable to send the message to the listener Queue");
+
+  /* MQND updates the queue stats and checks the queue capacity */
+  notify_evt =
+      (MQSV_DSEND_EVT *)mds_alloc_direct_buff(sizeof(MQSV_DSEND_EVT));
+  if (!notify_evt) {
+    TRACE_4("MQSV_DSEND_EVT Memory allocation failed");
+    TRACE_LEAVE();
+    return SA_AIS_OK;
+  }
+
+  memset(notify_evt, 0, sizeof(MQSV_DSEND_EVT));
+  notify_evt->evt_type = MQSV_DSEND_EVENT;
+  notify_evt->endianness = machineEndianness();
+  notify_evt->msg_fmt_version = msg_fmt_ver;
+  notify_evt->src_dest_version = MQA_PVT_SUBPART_VERSION;
+  notify_evt->type.req_type = MQP_EVT_SEND_MSG_LOCAL;
+  notify_evt->agent_mds_dest = mqa_cb->mqa_mds_dest;
+  notify_evt->info.statsReq.qhdl = queueHandle;
+  notify_evt->info.statsReq.priority = message->priority;
+  notify_evt->info.statsReq.size = message->size;
+
+  if (mqa_send_to_destination_async(mqa_cb, &mqa_cb->mqnd_mds_dest,
+                                    notify_evt, sizeof(MQSV_DSEND_EVT)) !=
+      SA_AIS_OK)
+    TRACE_4("Unable to notify MQND of the message");
+
+  TRACE_LEAVE();
+  return SA_AIS_OK;
+}
+
 /****************************************************************************
   Name          : mqa_send_to_group
 
@@ -1824,7 +1940,9 @@ SaAisErrorT mqa_send_to_group(MQA_CB *mqa_cb, ASAPi_OPR_INFO *asapi_or,
   if ((asapi_or->info.dest.o_cache->info.ginfo.policy ==
        SA_MSG_QUEUE_GROUP_ROUND_ROBIN) ||
       (asapi_or->info.dest.o_cache->info.ginfo.policy ==
-       SA_MSG_QUEUE_GROUP_LOCAL_ROUND_ROBIN))
+       SA_MSG_QUEUE_GROUP_LOCAL_ROUND_ROBIN) ||
+      (asapi_or->info.dest.o_cache->info.ginfo.policy ==
+       NCS_MSG_QUEUE_GROUP_LEAST_LOADED))
     unicast = 1;
 
   if (unicast) {
@@ -2133,6 +2251,19 @@ SaAisErrorT mqa_send_message(SaMsgHandleT msgHandle, const SaNameT *destination,
     }
   }
 
+  /* A queue opened on this node is written directly, MQND is only notified.
+   * An older MQND does not know the notification. */
+  if ((asapi_or.info.dest.o_cache->objtype == ASAPi_OBJ_QUEUE) &&
+      !param->async_flag && (destination_mqnd == mqa_cb->mqnd_mds_dest) &&
+      (o_msg_fmt_ver >= MQA_MQND_MSG_FMT_LOCAL_SEND) &&
+      (sizeof(MQSV_MESSAGE) + message->size <= NCS_OS_MQ_MAX_PAYLOAD)) {
+    rc = mqa_send_to_local_queue(
+        mqa_cb, asapi_or.info.dest.o_cache->info.qinfo.param.hdl, message,
+        o_msg_fmt_ver);
+    if (rc != SA_AIS_ERR_NOT_SUPPORTED) goto done;
+    rc = SA_AIS_OK;
+  }
+
   /* Allocate memory for the MQSV_DSEND_EVENT structure + data */
   length = sizeof(MQSV_DSEND_EVT) + message->size;
 
@@ -2420,6 +2551,345 @@ done:
   return rc;
 }
 
+/****************************************************************************
+  Name          : mqa_send_batch_to_destination
+
+  Description   : This routine sends several messages to a queue in one
+                  MQP_EVT_SEND_MSG_BATCH and waits for the status of each
+                  message.
+
+  Arguments     : MQA_CB *mqa_cb - MQA control block
+                  MDS_DEST *mqnd_mds_dest - mds destination of mqnd.
+                  SaMsgHandleT msgHandle - The message handle
+                  SaMsgQueueHandleT queueHandle - the destination queue
+                  const SaMsgMessageT *messages - the messages to be sent
+                  SaUint32T numberOfMessages - number of messages
+                  SaTimeT timeout - time wait for ack.
+                  uint32_t msg_fmt_ver - message format version
+                  uint32_t length - length of the event with the messages
+                  SaAisErrorT *errors - status of each message
+
+  Return Values : SaAisErrorT, the status of the request. errors[] is only
+                  filled in if SA_AIS_OK is returned.
+
+  Notes         : Called with the cb_lock held.
+******************************************************************************/
+static SaAisErrorT mqa_send_batch_to_destination(
+    MQA_CB *mqa_cb, MDS_DEST *mqnd_mds_dest, SaMsgHandleT msgHandle,
+    SaMsgQueueHandleT queueHandle, const SaMsgMessageT *messages,
+    SaUint32T numberOfMessages, SaTimeT timeout, uint32_t msg_fmt_ver,
+    uint32_t length, SaAisErrorT *errors) {
+  SaAisErrorT rc = SA_AIS_OK;
+  MQSV_DSEND_EVT *qsend_evt, *out_evt = NULL;
+  QUEUE_MESSAGE *qmsg;
+  char *record;
+  uint32_t mds_rc, i;
+
+  TRACE_ENTER2("numberOfMessages %u", numberOfMessages);
+
+  qsend_evt = (MQSV_DSEND_EVT *)mds_alloc_direct_buff(length);
+  if (!qsend_evt) {
+    TRACE_4("ERR_MEMORY: MQSV_DSEND_EVT Memory allocation failed");
+    return SA_AIS_ERR_NO_MEMORY;
+  }
+
+  memset(qsend_evt, 0, length);
+  qsend_evt->evt_type = MQSV_DSEND_EVENT;
+  qsend_evt->endianness = machineEndianness();
+  qsend_evt->agent_mds_dest = mqa_cb->mqa_mds_dest;
+  qsend_evt->msg_fmt_version = msg_fmt_ver;
+  qsend_evt->src_dest_version = MQA_PVT_SUBPART_VERSION;
+  qsend_evt->type.req_type = MQP_EVT_SEND_MSG_BATCH;
+  qsend_evt->info.sndMsgBatch.msgHandle = msgHandle;
+  qsend_evt->info.sndMsgBatch.queueHandle = queueHandle;
+  qsend_evt->info.sndMsgBatch.numberOfMessages = numberOfMessages;
+
+  record = (char *)(qsend_evt + 1);
+  for (i = 0; i < numberOfMessages; i++) {
+    qmsg = (QUEUE_MESSAGE *)record;
+    qmsg->type = messages[i].type;
+    qmsg->version = messages[i].version;
+    qmsg->size = messages[i].size;
+    qmsg->priority = messages[i].priority;
+    if (messages[i].senderName) qmsg->senderName = *messages[i].senderName;
+    if (messages[i].data)
+      memcpy(qmsg->data, messages[i].data, messages[i].size);
+    record += m_MQSV_BATCH_MSG_SIZE(messages[i].size);
+  }
+
+  mds_rc = mqa_mds_msg_sync_send_direct(
+      mqa_cb->mqa_mds_hdl, mqnd_mds_dest, qsend_evt, &out_evt,
+      m_MQSV_CONVERT_SATIME_TEN_MILLI_SEC(timeout), length);
+  switch (mds_rc) {
+    case NCSCC_RC_SUCCESS:
+      break;
+    case NCSCC_RC_REQ_TIMOUT:
+      TRACE_2("ERR_TIMEOUT: Message Send through MDS Timeout %" PRIx64,
+              mqa_cb->mqa_mds_dest);
+      rc = SA_AIS_ERR_TIMEOUT;
+      goto done;
+    case NCSCC_RC_FAILURE:
+      TRACE_2("ERR_TRY_AGAIN: Message Send through MDS Failure %" PRIx64,
+              mqa_cb->mqa_mds_dest);
+      rc = SA_AIS_ERR_TRY_AGAIN;
+      goto done;
+    default:
+      TRACE_4("ERR_RESOURCES: Message Send through MDS Failure %" PRIx64,
+              mqa_cb->mqa_mds_dest);
+      rc = SA_AIS_ERR_NO_RESOURCES;
+      goto done;
+  }
+
+  if (!out_evt || (out_evt->type.rsp_type != MQP_EVT_SEND_MSG_BATCH_RSP) ||
+      (out_evt->info.sendBatchRsp.numberOfMessages != numberOfMessages)) {
+    TRACE_4("ERR_RESOURCES: Response not received from MQND");
+    rc = SA_AIS_ERR_NO_RESOURCES;
+    goto done;
+  }
+
+  memcpy(errors, out_evt + 1, numberOfMessages * sizeof(SaAisErrorT));
+
+done:
+  if (out_evt) mds_free_direct_buff((MDS_DIRECT_BUFF)out_evt);
+
+  TRACE_LEAVE2("return code %d", rc);
+  return rc;
+}
+
+/****************************************************************************
+  Name          : ncsMsgMessageSendBatch
+
+  Description   : This routine sends several messages to the queue or queue
+                  group denoted by destination and waits for the ack of each
+                  message. The messages to a queue are sent to its MQND in
+                  as few MQP_EVT_SEND_MSG_BATCH requests as fit into MDS
+                  direct buffers.
+
+  Arguments     : SaMsgHandleT msgHandle - The message handle
+                  const SaNameT *destination - destination queue name to send
+                  to.
+                  const SaMsgMessageT *messages - The messages to be sent.
+                  SaUint32T numberOfMessages - number of messages
+                  SaTimeT timeout - time to wait for each acknowledgement.
+                  SaAisErrorT *errors - status of each message
+
+  Return Values : SaAisErrorT
+
+  Notes         : None
+******************************************************************************/
+
+SaAisErrorT ncsMsgMessageSendBatch(SaMsgHandleT msgHandle,
+                                   const SaNameT *destination,
+                                   const SaMsgMessageT *messages,
+                                   SaUint32T numberOfMessages, SaTimeT timeout,
+                                   SaAisErrorT *errors) {
+  MQA_CB *mqa_cb;
+  MQA_SEND_MESSAGE_PARAM param;
+  MQA_CLIENT_INFO *client_info = NULL;
+  ASAPi_OPR_INFO asapi_or;
+  MDS_DEST destination_mqnd = 0;
+  SaMsgQueueHandleT queueHandle = 0;
+  SaAisErrorT rc = SA_AIS_OK;
+  bool lock_taken = false, is_group = false;
+  uint32_t i = 0, j, length, msg_len, to_dest_ver, o_msg_fmt_ver = 0;
+
+  TRACE_ENTER2(" SaMsgHandle %llu", msgHandle);
+
+  if (!destination || !messages || !errors || (numberOfMessages == 0)) {
+    TRACE_2("ERR_INVALID_PARAM: destination, messages or errors is NULL");
+    return SA_AIS_ERR_INVALID_PARAM;
+  }
+
+  if (destination->length > SA_MAX_NAME_LENGTH) {
+    TRACE_2("ERR_INVALID_PARAM: destinationName exceeds character 256");
+    return SA_AIS_ERR_INVALID_PARAM;
+  }
+
+  /* retrieve MQA CB */
+  mqa_cb = (MQA_CB *)m_MQSV_MQA_RETRIEVE_MQA_CB;
+  if (!mqa_cb) {
+    TRACE_2("ERR_BAD_HANDLE: Control block retrieval failed");
+    return SA_AIS_ERR_BAD_HANDLE;
+  }
+
+  if (m_NCS_SA_IS_VALID_TIME_DURATION(timeout) == false) {
+    TRACE_2("ERR_INVALID_PARAM: Invalid Parameter as input");
+    rc = SA_AIS_ERR_INVALID_PARAM;
+    goto done;
+  }
+
+  if (m_MQSV_CONVERT_SATIME_TEN_MILLI_SEC(timeout) < NCS_SAF_MIN_ACCEPT_TIME) {
+    TRACE_2("ERR_TIMEOUT: Invalid Parameter as input");
+    rc = SA_AIS_ERR_TIMEOUT;
+    goto done;
+  }
+
+  param.async_flag = false;
+  param.info.timeout = timeout;
+
+  if (m_NCS_LOCK(&mqa_cb->cb_lock, NCS_LOCK_WRITE) != NCSCC_RC_SUCCESS) {
+    TRACE_4("ERR_LIBRARY: Lock failed for control block write");
+    rc = SA_AIS_ERR_LIBRARY;
+    goto done;
+  }
+  lock_taken = true;
+
+  client_info = mqa_client_tree_find_and_add(mqa_cb, msgHandle, false);
+  if (!client_info) {
+    TRACE_2("ERR_BAD_HANDLE: Client Database Find Failed");
+    rc = SA_AIS_ERR_BAD_HANDLE;
+    goto done;
+  }
+
+  if (client_info->version.majorVersion == MQA_MAJOR_VERSION) {
+    if (!mqa_cb->clm_node_joined || client_info->isStale) {
+      TRACE_2("ERR_UNAVAILABLE: node is not cluster member");
+      rc = SA_AIS_ERR_UNAVAILABLE;
+      goto done;
+    }
+  }
+
+  /* Check if mqd is up */
+  if (!mqa_cb->is_mqd_up) {
+    TRACE_2("ERR_TRY_AGAIN: MQD is down");
+    rc = SA_AIS_ERR_TRY_AGAIN;
+    goto done;
+  }
+
+  /* Get the destination MQND from ASAPi */
+  memset(&asapi_or, 0, sizeof(asapi_or));
+  asapi_or.type = ASAPi_OPR_GET_DEST;
+  asapi_or.info.dest.i_object = *destination;
+  m_ASAPi_TRACK_ENABLE_SET(asapi_or.info.dest.i_track);
+  asapi_or.info.dest.i_sinfo.to_svc = NCSMDS_SVC_ID_MQD;
+  asapi_or.info.dest.i_sinfo.dest = mqa_cb->mqd_mds_dest;
+  asapi_or.info.dest.i_sinfo.stype = MDS_SENDTYPE_SNDRSP;
+
+  m_NCS_UNLOCK(&mqa_cb->cb_lock, NCS_LOCK_WRITE);
+  lock_taken = false;
+
+  if ((rc = asapi_opr_hdlr(&asapi_or)) != SA_AIS_OK) {
+    TRACE_2("The ASAPi Get Dest Operation Failed");
+    goto done;
+  }
+
+  if (m_NCS_LOCK(&mqa_cb->cb_lock, NCS_LOCK_WRITE) != NCSCC_RC_SUCCESS) {
+    TRACE_4("ERR_LIBRARY: Lock failed for control block write");
+    rc = SA_AIS_ERR_LIBRARY;
+    goto done;
+  }
+  lock_taken = true;
+
+  if (!asapi_or.info.dest.o_cache) {
+    TRACE_2(
+        "ERR_EXIST: The ASAPi Get Dest Operation's result Cache does not exist");
+    rc = SA_AIS_ERR_NOT_EXIST;
+    goto done;
+  }
+
+  if (asapi_or.info.dest.o_cache->objtype == ASAPi_OBJ_GROUP) {
+    is_group = true;
+  } else if (asapi_or.info.dest.o_cache->objtype == ASAPi_OBJ_QUEUE) {
+    destination_mqnd = asapi_or.info.dest.o_cache->info.qinfo.param.addr;
+    queueHandle = asapi_or.info.dest.o_cache->info.qinfo.param.hdl;
+
+    to_dest_ver = mqa_cb->ver_mqnd[mqsv_get_node_id(destination_mqnd)];
+
+    /* MQND HAS GONE DOWN OR NOT YET UP */
+    if (to_dest_ver == 0) {
+      TRACE_2("ERR_TRY_AGAIN: MQND HAS GONE DOWN");
+      rc = SA_AIS_ERR_TRY_AGAIN;
+      goto done;
+    }
+
+    o_msg_fmt_ver = m_NCS_ENC_MSG_FMT_GET(
+        to_dest_ver, MQA_WRT_MQND_SUBPART_VER_AT_MIN_MSG_FMT,
+        MQA_WRT_MQND_SUBPART_VER_AT_MAX_MSG_FMT, mqa_mqnd_msg_fmt_table);
+    if (!o_msg_fmt_ver) {
+      TRACE_4("ERR_LIBRARY: Message Format version Invalid %u", o_msg_fmt_ver);
+      rc = SA_AIS_ERR_LIBRARY;
+      goto done;
+    }
+  } else {
+    TRACE_2("ERR_EXIST: Object type should be QUEUE or QUEUEGROUPS");
+    rc = SA_AIS_ERR_NOT_EXIST;
+    goto done;
+  }
+
+  m_NCS_UNLOCK(&mqa_cb->cb_lock, NCS_LOCK_WRITE);
+  lock_taken = false;
+
+  /* The members of a group are selected per message and an older MQND does
+   * not take batches, send the messages one by one */
+  if (is_group || (o_msg_fmt_ver < MQA_MQND_MSG_FMT_BATCH)) {
+    for (i = 0; i < numberOfMessages; i++)
+      errors[i] =
+          mqa_send_message(msgHandle, destination, &messages[i],
+                           SA_MSG_MESSAGE_DELIVERED_ACK, &param, mqa_cb);
+    goto done;
+  }
+
+  for (i = 0; i < numberOfMessages; i = j) {
+    /* Take as many messages as fit into one direct buffer */
+    length = sizeof(MQSV_DSEND_EVT);
+    for (j = i; j < numberOfMessages; j++) {
+      if (messages[j].size > MDS_DIRECT_BUF_MAXSIZE) break;
+      msg_len = m_MQSV_BATCH_MSG_SIZE(messages[j].size);
+      if (length + msg_len > MDS_DIRECT_BUF_MAXSIZE) break;
+      length += msg_len;
+    }
+
+    /* A message which does not fit alone is sent as by saMsgMessageSend() */
+    if (j == i) {
+      errors[i] = mqa_send_message(msgHandle, destination, &messages[i],
+                                   SA_MSG_MESSAGE_DELIVERED_ACK, &param, mqa_cb);
+      j = i + 1;
+      continue;
+    }
+
+    if (m_NCS_LOCK(&mqa_cb->cb_lock, NCS_LOCK_WRITE) != NCSCC_RC_SUCCESS) {
+      TRACE_4("ERR_LIBRARY: Lock failed for control block write");
+      rc = SA_AIS_ERR_LIBRARY;
+    } else {
+      rc = mqa_send_batch_to_destination(
+          mqa_cb, &destination_mqnd, msgHandle, queueHandle, &messages[i],
+          j - i, timeout, o_msg_fmt_ver, length, &errors[i]);
+      m_NCS_UNLOCK(&mqa_cb->cb_lock, NCS_LOCK_WRITE);
+    }
+
+    if (rc != SA_AIS_OK) {
+      TRACE_2("Message Batch Send through MDS Failure %d", rc);
+      break;
+    }
+  }
+
+done:
+  if (lock_taken) m_NCS_UNLOCK(&mqa_cb->cb_lock, NCS_LOCK_WRITE);
+
+  /* return MQA CB */
+  m_MQSV_MQA_GIVEUP_MQA_CB;
+
+  /* The messages not sent yet fail with the error of the request */
+  if (rc != SA_AIS_OK) {
+    for (; i < numberOfMessages; i++) errors[i] = rc;
+  }
+
+  for (i = 0; i < numberOfMessages; i++) {
+    if (errors[i] != SA_AIS_OK) {
+      rc = errors[i];
+      break;
+    }
+  }
+
+  if (rc == SA_AIS_OK) {
+    TRACE_LEAVE2(" Success ");
+  } else {
+    if (rc == SA_AIS_ERR_TRY_AGAIN) MQA_TRY_AGAIN_WAIT;
+    TRACE_LEAVE2(" Failed with return code %d", rc);
+  }
+  return rc;
+}
+
 /****************************************************************************
   Name          : mqa_receive_message
 
@@ -2572,7 +3042,7 @@ SaAisErrorT mqa_receive_message(SaMsgQueueHandleT queueHandle,
 again:
   posix_mq_get_failure = false;
 
-  if (ncs_os_posix_mq(&mq_req) != NCSCC_RC_SUCCESS) {
+  if (m_MQSV_SHM_MQ(&mq_req) != NCSCC_RC_SUCCESS) {
     if (timeout == 0) {
       TRACE_2("ERR_TIMEOUT: Message get failed ");
       rc = SA_AIS_ERR_TIMEOUT;
@@ -2636,7 +3106,7 @@ again:
         mq_req_snd.info.send.i_msg = &mq_msg;
         mq_req_snd.info.send.i_mtype = 2;
 
-        if (ncs_os_posix_mq(&mq_req_snd) != NCSCC_RC_SUCCESS) {
+        if (m_MQSV_SHM_MQ(&mq_req_snd) != NCSCC_RC_SUCCESS) {
           TRACE_4(
               "ERR_RESOURCES: Unable to put back the genuine message in msgget call");
           rc = SA_AIS_ERR_NO_RESOURCES;
@@ -2686,7 +3156,7 @@ again:
       mq_req_snd.info.send.i_msg = &mq_msg;
       mq_req_snd.info.send.i_mtype = 1;
 
-      if (ncs_os_posix_mq(&mq_req_snd) != NCSCC_RC_SUCCESS) {
+      if (m_MQSV_SHM_MQ(&mq_req_snd) != NCSCC_RC_SUCCESS) {
         TRACE_4(
             "ERR_RESOURCES: Unable to put back the stop Tmr message"
             " which is meant for a different msgget");
@@ -2788,7 +3258,7 @@ again:
       mq_req.info.send.i_msg = &mq_msg;
       mq_req.info.send.i_mtype = 2;
 
-      if (ncs_os_posix_mq(&mq_req) != NCSCC_RC_SUCCESS) {
+      if (m_MQSV_SHM_MQ(&mq_req) != NCSCC_RC_SUCCESS) {
         TRACE_4("Unable to put back the genuine message in msgget call");
         /* TBD: Don't know what to do */
       }
@@ -2910,7 +3380,7 @@ check:
     mq_req.info.send.i_msg = &mq_msg;
     mq_req.info.send.i_mtype = 2;
 
-    if (ncs_os_posix_mq(&mq_req) != NCSCC_RC_SUCCESS) {
+    if (m_MQSV_SHM_MQ(&mq_req) != NCSCC_RC_SUCCESS) {
       TRACE_4("Unable to put back the genuine message in msgget call");
       /* TBD: Don't know what to do */
     }
@@ -3002,6 +3472,376 @@ done:
   return rc;
 }
 
+/****************************************************************************
+  Name          : mqa_queue_put_back
+
+  Description   : This routine puts a message which was received from the
+                  queue back at the head of the queue.
+
+  Arguments     : SaMsgQueueHandleT queueHandle - the queue
+                  NCS_OS_MQ_MSG *mq_msg - the message
+                  uint32_t datalen - length of the message
+                  int64_t mtype - 1 for control messages, 2 for messages
+
+  Return Values : NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE
+
+  Notes         : Type 1 is reserved for MQP_EVT_MSGGET_STOP_TIMER_REQ and
+                  MQP_EVT_CANCEL_REQ messages.
+******************************************************************************/
+static uint32_t mqa_queue_put_back(SaMsgQueueHandleT queueHandle,
+                                   NCS_OS_MQ_MSG *mq_msg, uint32_t datalen,
+                                   int64_t mtype) {
+  NCS_OS_POSIX_MQ_REQ_INFO mq_req;
+
+  memset(&mq_req, 0, sizeof(NCS_OS_POSIX_MQ_REQ_INFO));
+  mq_req.req = NCS_OS_POSIX_MQ_REQ_MSG_SEND_ASYNC;
+  mq_req.info.send.mqd = queueHandle;
+  mq_req.info.send.datalen = datalen;
+  mq_req.info.send.i_msg = mq_msg;
+  mq_req.info.send.i_mtype = mtype;
+
+  if (m_MQSV_SHM_MQ(&mq_req) != NCSCC_RC_SUCCESS) {
+    TRACE_4("Unable to put back the message in the queue");
+    return NCSCC_RC_FAILURE;
+  }
+  return NCSCC_RC_SUCCESS;
+}
+
+/****************************************************************************
+  Name          : mqa_receive_batch
+
+  Description   : This routine gets the messages which are in the queue
+                  pointed by queuehandle, without waiting, and updates the
+                  queue stats in MQND once for all of them.
+
+  Arguments     : SaMsgQueueHandleT queueHandle - queue handle to get messages
+                  from.
+                  SaMsgMessageT *messages - Buffers to receive the messages.
+                  SaTimeT *sendTimes - send time of each message, may be NULL
+                  SaMsgSenderIdT *senderIds - sender of each message, may be
+                  NULL
+                  SaUint32T maxMessages - number of buffers
+                  SaUint32T *numberOfMessages - number of messages received
+
+  Return Values : SaAisErrorT, SA_AIS_ERR_NO_SPACE if the first message does
+                  not fit into its buffer, SA_AIS_ERR_NOT_SUPPORTED if MQND
+                  does not take the batched stats update.
+
+  Notes         : The draining stops at a message sent with
+                  saMsgMessageSendReceive(), a message that does not fit and
+                  a MQP_EVT_CANCEL_REQ, they are put back into the queue.
+******************************************************************************/
+static SaAisErrorT mqa_receive_batch(SaMsgQueueHandleT queueHandle,
+                                     SaMsgMessageT *messages,
+                                     SaTimeT *sendTimes,
+                                     SaMsgSenderIdT *senderIds,
+                                     SaUint32T maxMessages,
+                                     SaUint32T *numberOfMessages) {
+  SaAisErrorT rc = SA_AIS_OK;
+  MQSV_MESSAGE *mqsv_message;
+  NCS_OS_POSIX_MQ_REQ_INFO mq_req;
+  NCS_OS_MQ_MSG mq_msg;
+  MQA_QUEUE_INFO *queue_node;
+  MQA_CB *mqa_cb;
+  MQSV_DSEND_EVT *stats = NULL, *statsrsp = NULL;
+  MQP_UPDATE_STATS_BATCH stats_batch;
+  SaMsgMessageT *message;
+  std::vector<bool> svc_allocated;
+  std::vector<SaTimeT> send_times;
+  uint32_t n = 0, i, mds_rc, to_dest_ver, o_msg_fmt_ver;
+
+  TRACE_ENTER2(" SaMsgQueueHandle %llu ", queueHandle);
+
+  *numberOfMessages = 0;
+  mqsv_message = (MQSV_MESSAGE *)mq_msg.data;
+
+  /* retrieve MQA CB */
+  mqa_cb = (MQA_CB *)m_MQSV_MQA_RETRIEVE_MQA_CB;
+  if (!mqa_cb) {
+    TRACE_2("ERR_BAD_HANDLE: Control block retrieval failed");
+    return SA_AIS_ERR_BAD_HANDLE;
+  }
+
+  if (m_NCS_LOCK(&mqa_cb->cb_lock, NCS_LOCK_WRITE) != NCSCC_RC_SUCCESS) {
+    m_MQSV_MQA_GIVEUP_MQA_CB;
+    TRACE_4("ERR_LIBRARY: Lock failed for control block write");
+    return SA_AIS_ERR_LIBRARY;
+  }
+
+  /* Check if mqnd is up */
+  if (!mqa_cb->is_mqnd_up) {
+    TRACE_2("ERR_TRY_AGAIN: MQND is down");
+    rc = SA_AIS_ERR_TRY_AGAIN;
+    goto done;
+  }
+
+  /* Check if queueHandle is present in the tree */
+  if ((queue_node = mqa_queue_tree_find_and_add(mqa_cb, queueHandle, false,
+                                                NULL, 0)) == NULL) {
+    TRACE_2("ERR_BAD_HANDLE: Queue Database Find Failed");
+    rc = SA_AIS_ERR_BAD_HANDLE;
+    goto done;
+  }
+
+  if (queue_node->client_info->version.majorVersion == MQA_MAJOR_VERSION) {
+    if (!mqa_cb->clm_node_joined || queue_node->client_info->isStale) {
+      TRACE_2("ERR_UNAVAILABLE: MQD or MQND is down");
+      rc = SA_AIS_ERR_UNAVAILABLE;
+      goto done;
+    }
+  }
+
+  to_dest_ver = mqa_cb->ver_mqnd[mqsv_get_node_id(mqa_cb->mqnd_mds_dest)];
+
+  /* MQND HAS GONE DOWN OR NOT YET UP */
+  if (to_dest_ver == 0) {
+    TRACE_2("ERR_TRY_AGAIN: MQND is down");
+    rc = SA_AIS_ERR_TRY_AGAIN;
+    goto done;
+  }
+
+  o_msg_fmt_ver = m_NCS_ENC_MSG_FMT_GET(
+      to_dest_ver, MQA_WRT_MQND_SUBPART_VER_AT_MIN_MSG_FMT,
+      MQA_WRT_MQND_SUBPART_VER_AT_MAX_MSG_FMT, mqa_mqnd_msg_fmt_table);
+  if (!o_msg_fmt_ver) {
+    TRACE_4("ERR_LIBRARY: Message Format version Invalid %u", o_msg_fmt_ver);
+    rc = SA_AIS_ERR_LIBRARY;
+    goto done;
+  }
+
+  if (o_msg_fmt_ver < MQA_MQND_MSG_FMT_BATCH) {
+    rc = SA_AIS_ERR_NOT_SUPPORTED;
+    goto done;
+  }
+
+  memset(&stats_batch, 0, sizeof(stats_batch));
+  stats_batch.qhdl = queueHandle;
+
+  while (n < maxMessages) {
+    memset(&mq_req, 0, sizeof(NCS_OS_POSIX_MQ_REQ_INFO));
+    mq_req.req = NCS_OS_POSIX_MQ_REQ_MSG_RECV_ASYNC;
+    mq_req.info.recv.mqd = queueHandle;
+    mq_req.info.recv.i_msg = &mq_msg;
+    mq_req.info.recv.datalen = NCS_OS_MQ_MAX_PAYLOAD;
+    mq_req.info.recv.i_mtype = -7;
+
+    /* The queue is empty */
+    if (m_MQSV_SHM_MQ(&mq_req) != NCSCC_RC_SUCCESS) break;
+
+    /* A CANCEL or STOP TIMER message is meant for a waiting
+     * saMsgMessageGet call */
+    if (mqsv_message->type != MQP_EVT_GET_REQ) {
+      mqa_queue_put_back(queueHandle, &mq_msg, sizeof(MQSV_MESSAGE), 1);
+      break;
+    }
+
+    /* The sender of a saMsgMessageSendReceive is registered by
+     * mqa_receive_message */
+    if (mqsv_message->info.msg.message_info.sendReceive == SA_TRUE) {
+      mqa_queue_put_back(queueHandle, &mq_msg,
+                         sizeof(MQSV_MESSAGE) +
+                             mqsv_message->info.msg.message.size,
+                         2);
+      break;
+    }
+
+    message = &messages[n];
+    if (message->data &&
+        (mqsv_message->info.msg.message.size > message->size)) {
+      mqa_queue_put_back(queueHandle, &mq_msg,
+                         sizeof(MQSV_MESSAGE) +
+                             mqsv_message->info.msg.message.size,
+                         2);
+      if (n == 0) {
+        /* return the size needed */
+        message->size = mqsv_message->info.msg.message.size;
+        TRACE_2("ERR_NO_SPACE: message buffer is too small");
+        rc = SA_AIS_ERR_NO_SPACE;
+
+        /* if queue opened with RCV_CALLBACK option, put back
+         * the indicator msg into the listener queue */
+        if (queue_node->openFlags & SA_MSG_QUEUE_RECEIVE_CALLBACK)
+          mqsv_listenerq_msg_send(queue_node->listenerHandle);
+      }
+      break;
+    }
+
+    /* This memory allocated has to be freed by the application */
+    svc_allocated.push_back(false);
+    if (!message->data && (mqsv_message->info.msg.message.size != 0)) {
+      message->data = malloc(mqsv_message->info.msg.message.size);
+      if (!message->data) {
+        svc_allocated.pop_back();
+        mqa_queue_put_back(queueHandle, &mq_msg,
+                           sizeof(MQSV_MESSAGE) +
+                               mqsv_message->info.msg.message.size,
+                           2);
+        TRACE_4("ERR_MEMORY: Memory allocation failed");
+        if (n == 0) rc = SA_AIS_ERR_NO_MEMORY;
+        break;
+      }
+      svc_allocated[n] = true;
+    }
+
+    memcpy(message->data, mqsv_message->info.msg.message.data,
+           mqsv_message->info.msg.message.size);
+    message->priority = mqsv_message->info.msg.message.priority;
+    message->size = mqsv_message->info.msg.message.size;
+    message->type = mqsv_message->info.msg.message.type;
+    message->version = mqsv_message->info.msg.message.version;
+    if (message->senderName)
+      *message->senderName = mqsv_message->info.msg.message.senderName;
+
+    send_times.push_back(mqsv_message->info.msg.message_info.sendTime);
+    if (sendTimes) sendTimes[n] = send_times[n];
+    if (senderIds)
+      senderIds[n] = mqsv_message->info.msg.message_info.sender.senderId;
+
+    stats_batch.size[message->priority] += message->size;
+    stats_batch.numberOfMessages[message->priority]++;
+    n++;
+  }
+
+  if (n == 0) goto done;
+
+  /* Send the sizes of the messages per priority to MQND so that MQND
+   * updates the queue stats once */
+  stats = (MQSV_DSEND_EVT *)mds_alloc_direct_buff(sizeof(MQSV_DSEND_EVT));
+  if (!stats) {
+    TRACE_4("ERR_MEMORY: MQSV_DSEND_EVT Memory allocation failed");
+    rc = SA_AIS_ERR_NO_MEMORY;
+    goto check;
+  }
+
+  memset(stats, 0, sizeof(MQSV_DSEND_EVT));
+  stats->evt_type = MQSV_DSEND_EVENT;
+  stats->endianness = machineEndianness();
+  stats->msg_fmt_version = o_msg_fmt_ver;
+  stats->src_dest_version = MQA_PVT_SUBPART_VERSION;
+  stats->type.req_type = MQP_EVT_STAT_UPD_BATCH_REQ;
+  stats->agent_mds_dest = mqa_cb->mqa_mds_dest;
+  stats->info.statsBatchReq = stats_batch;
+
+  mds_rc = mqa_mds_msg_sync_send_direct(
+      mqa_cb->mqa_mds_hdl, &mqa_cb->mqnd_mds_dest, stats, &statsrsp,
+      (uint32_t)MQSV_WAIT_TIME, sizeof(MQSV_DSEND_EVT));
+
+  switch (mds_rc) {
+    case NCSCC_RC_SUCCESS:
+      break;
+    case NCSCC_RC_REQ_TIMOUT:
+      TRACE_2("ERR_TIMEOUT: Message Send through MDS Timeout %" PRIx64,
+              mqa_cb->mqa_mds_dest);
+      rc = SA_AIS_ERR_TIMEOUT;
+      goto check;
+    case NCSCC_RC_FAILURE:
+      TRACE_2("ERR_TRY_AGAIN: Message Send through MDS Failure %" PRIx64,
+              mqa_cb->mqa_mds_dest);
+      rc = SA_AIS_ERR_TRY_AGAIN;
+      goto check;
+    default:
+      TRACE_4("ERR_RESOURCES: Message Send through MDS Failure %" PRIx64,
+              mqa_cb->mqa_mds_dest);
+      rc = SA_AIS_ERR_NO_RESOURCES;
+      goto check;
+  }
+
+  if (statsrsp) {
+    if (statsrsp->type.rsp_type == MQP_EVT_STAT_UPD_RSP)
+      rc = statsrsp->info.sendMsgRsp.error;
+    mds_free_direct_buff((MDS_DIRECT_BUFF)statsrsp);
+  } else {
+    TRACE_4("ERR_LIBRARY: STATS_UPDATE fails");
+    rc = SA_AIS_ERR_LIBRARY;
+  }
+
+check:
+  if (rc != SA_AIS_OK) {
+    /* Post the messages back to the queue, in the order they were
+     * received */
+    for (i = 0; i < n; i++) {
+      message = &messages[i];
+
+      memset(mqsv_message, 0, sizeof(MQSV_MESSAGE));
+      mqsv_message->type = MQP_EVT_GET_REQ;
+      mqsv_message->mqsv_version = MQSV_MSG_VERSION;
+      mqsv_message->info.msg.message_info.sendReceive = SA_FALSE;
+      mqsv_message->info.msg.message_info.sendTime = send_times[i];
+      if (message->data)
+        memcpy(mqsv_message->info.msg.message.data, message->data,
+               message->size);
+      mqsv_message->info.msg.message.priority = message->priority;
+      mqsv_message->info.msg.message.size = message->size;
+      mqsv_message->info.msg.message.type = message->type;
+      mqsv_message->info.msg.message.version = message->version;
+      if (message->senderName)
+        mqsv_message->info.msg.message.senderName = *message->senderName;
+
+      mqa_queue_put_back(queueHandle, &mq_msg,
+                         sizeof(MQSV_MESSAGE) + message->size, 2);
+
+      if (svc_allocated[i]) {
+        free(message->data);
+        message->data = NULL;
+      }
+    }
+
+    /* if queue opened with RCV_CALLBACK option, put back the
+     * indicator msg into the listener queue */
+    if (queue_node->openFlags & SA_MSG_QUEUE_RECEIVE_CALLBACK)
+      mqsv_listenerq_msg_send(queue_node->listenerHandle);
+
+    n = 0;
+  }
+
+done:
+  m_NCS_UNLOCK(&mqa_cb->cb_lock, NCS_LOCK_WRITE);
+  m_MQSV_MQA_GIVEUP_MQA_CB;
+
+  *numberOfMessages = n;
+
+  TRACE_LEAVE2(" return code %d, number of messages %u", rc, n);
+  return rc;
+}
+
+/****************************************************************************
+  Name          : mqa_received_callbacks_skip
+
+  Description   : This routine drops the saMsgMessageReceivedCallback of
+                  messages which have been received by a batched get. Each
+                  message put into a queue opened with the RECEIVE_CALLBACK
+                  option is indicated once, the callbacks of the indications
+                  are dropped when they are dispatched.
+
+  Arguments     : SaMsgQueueHandleT queueHandle - the queue
+                  SaUint32T count - number of callbacks to drop
+
+  Return Values : None
+
+  Notes         : None
+******************************************************************************/
+static void mqa_received_callbacks_skip(SaMsgQueueHandleT queueHandle,
+                                        SaUint32T count) {
+  MQA_QUEUE_INFO *queue_node;
+  MQA_CB *mqa_cb;
+
+  mqa_cb = (MQA_CB *)m_MQSV_MQA_RETRIEVE_MQA_CB;
+  if (!mqa_cb) return;
+
+  if (m_NCS_LOCK(&mqa_cb->cb_lock, NCS_LOCK_WRITE) != NCSCC_RC_SUCCESS) {
+    m_MQSV_MQA_GIVEUP_MQA_CB;
+    return;
+  }
+
+  queue_node =
+      mqa_queue_tree_find_and_add(mqa_cb, queueHandle, false, NULL, 0);
+  if (queue_node && (queue_node->openFlags & SA_MSG_QUEUE_RECEIVE_CALLBACK))
+    queue_node->num_received_skip += count;
+
+  m_NCS_UNLOCK(&mqa_cb->cb_lock, NCS_LOCK_WRITE);
+  m_MQSV_MQA_GIVEUP_MQA_CB;
+}
+
 /****************************************************************************
   Name          : saMsgMessageGet
 
@@ -3042,6 +3882,98 @@ SaAisErrorT saMsgMessageGet(SaMsgQueueHandleT queueHandle,
   return rc;
 }
 
+/****************************************************************************
+  Name          : ncsMsgMessageGetBatch
+
+  Description   : This routine receives up to maxMessages messages from the
+                  queue pointed by queuehandle. It waits for the first
+                  message like saMsgMessageGet and then returns the messages
+                  which are in the queue without waiting.
+
+  Arguments     : SaMsgQueueHandleT queueHandle - queue handle to get messages
+                  from.
+                  SaMsgMessageT *messages - Buffers to receive the messages.
+                  If the data of a buffer is NULL, message service lib
+                  allocates it. The caller of this API MUST free it.
+                  SaTimeT *sendTimes - send time of each message, may be NULL
+                  SaMsgSenderIdT *senderIds - sender of each message, may be
+                  NULL
+                  SaUint32T maxMessages - number of buffers
+                  SaUint32T *numberOfMessages - number of messages received
+                  SaTimeT timeout - Time to wait for the first message.
+
+  Return Values : SaAisErrorT
+
+  Notes         : None
+******************************************************************************/
+
+SaAisErrorT ncsMsgMessageGetBatch(SaMsgQueueHandleT queueHandle,
+                                  SaMsgMessageT *messages, SaTimeT *sendTimes,
+                                  SaMsgSenderIdT *senderIds,
+                                  SaUint32T maxMessages,
+                                  SaUint32T *numberOfMessages,
+                                  SaTimeT timeout) {
+  SaAisErrorT rc;
+  SaMsgSenderIdT senderId;
+  SaUint32T n = 0, more = 0;
+
+  TRACE_ENTER2(" SaMsgQueueHandle %llu ", queueHandle);
+
+  if (!messages || !numberOfMessages || (maxMessages == 0)) {
+    TRACE_2("ERR_INVALID_PARAM: messages or numberOfMessages is NULL");
+    return SA_AIS_ERR_INVALID_PARAM;
+  }
+
+  *numberOfMessages = 0;
+
+  if (m_NCS_SA_IS_VALID_TIME_DURATION(timeout) == false) {
+    TRACE_2("ERR_INVALID_PARAM: Invalid Parameter as input");
+    return SA_AIS_ERR_INVALID_PARAM;
+  }
+
+  rc = mqa_receive_batch(queueHandle, messages, sendTimes, senderIds,
+                         maxMessages, &n);
+
+  if (rc == SA_AIS_ERR_NOT_SUPPORTED) {
+    /* An older MQND, get the messages one by one */
+    rc = mqa_receive_message(queueHandle, &messages[0], sendTimes,
+                             senderIds ? senderIds : &senderId, timeout);
+    if (rc == SA_AIS_OK) {
+      for (n = 1; n < maxMessages; n++) {
+        if (mqa_receive_message(queueHandle, &messages[n],
+                                sendTimes ? &sendTimes[n] : NULL,
+                                senderIds ? &senderIds[n] : &senderId,
+                                0) != SA_AIS_OK)
+          break;
+      }
+    }
+  } else if ((rc == SA_AIS_OK) && (n == 0)) {
+    /* Nothing to drain, wait for the first message */
+    rc = mqa_receive_message(queueHandle, &messages[0], sendTimes,
+                             senderIds ? senderIds : &senderId, timeout);
+    if (rc == SA_AIS_OK) {
+      n = 1;
+      if ((maxMessages > 1) &&
+          (mqa_receive_batch(queueHandle, &messages[1],
+                             sendTimes ? &sendTimes[1] : NULL,
+                             senderIds ? &senderIds[1] : NULL,
+                             maxMessages - 1, &more) == SA_AIS_OK))
+        n += more;
+    }
+  }
+
+  /* The call stands for one received callback, as a saMsgMessageGet() */
+  if (n > 1) mqa_received_callbacks_skip(queueHandle, n - 1);
+
+  *numberOfMessages = n;
+
+  if (rc == SA_AIS_OK)
+    TRACE_LEAVE2(" Success, number of messages %u", n);
+  else
+    TRACE_LEAVE2(" Failed with return code %d", rc);
+  return rc;
+}
+
 /****************************************************************************
   Name          : saMsgMessageCancel
 
@@ -3130,7 +4062,7 @@ SaAisErrorT saMsgMessageCancel(SaMsgQueueHandleT queueHandle) {
   /* Send the message from the Queue using the OS call ->ncs_os_mq() */
 
   for (i = 0; i < cancel_message_count; i++) {
-    if (m_NCS_OS_POSIX_MQ(&mq_req) != NCSCC_RC_SUCCESS) {
+    if (m_MQSV_SHM_MQ(&mq_req) != NCSCC_RC_SUCCESS) {
       TRACE_2("ERR_TRY_AGAIN: Unable to put the cancel message in the queue");
       rc = SA_AIS_ERR_TRY_AGAIN;
     }
@@ -3421,8 +4353,10 @@ SaAisErrorT saMsgMessageSendReceive(SaMsgHandleT msgHandle,
       /* Right now, group is considered multicast if the selected
        * group policy is not round robin. Need to define multicast
        * group in SAF spec in future.  */
-      if (asapi_or.info.dest.o_cache->info.ginfo.policy ==
-          SA_MSG_QUEUE_GROUP_ROUND_ROBIN)
+      if ((asapi_or.info.dest.o_cache->info.ginfo.policy ==
+           SA_MSG_QUEUE_GROUP_ROUND_ROBIN) ||
+          (asapi_or.info.dest.o_cache->info.ginfo.policy ==
+           NCS_MSG_QUEUE_GROUP_LEAST_LOADED))
         unicast = 1;
 
       if (unicast) {
@@ -4168,15 +5102,17 @@ SaAisErrorT saMsgQueueGroupCreate(SaMsgHandleT msgHandle,
     return SA_AIS_ERR_INVALID_PARAM;
   }
 
-  if ((queueGroupPolicy < SA_MSG_QUEUE_GROUP_ROUND_ROBIN) ||
-      (queueGroupPolicy > SA_MSG_QUEUE_GROUP_BROADCAST)) {
+  if (((queueGroupPolicy < SA_MSG_QUEUE_GROUP_ROUND_ROBIN) ||
+       (queueGroupPolicy > SA_MSG_QUEUE_GROUP_BROADCAST)) &&
+      (queueGroupPolicy != NCS_MSG_QUEUE_GROUP_LEAST_LOADED)) {
     TRACE_2("ERR_INVALID_PARAM: queueGroupPolicy not supported");
     return SA_AIS_ERR_INVALID_PARAM;
   }
 
   if ((queueGroupPolicy != SA_MSG_QUEUE_GROUP_ROUND_ROBIN) &&
       (queueGroupPolicy != SA_MSG_QUEUE_GROUP_BROADCAST) &&
-      (queueGroupPolicy != SA_MSG_QUEUE_GROUP_LOCAL_ROUND_ROBIN)) {
+      (queueGroupPolicy != SA_MSG_QUEUE_GROUP_LOCAL_ROUND_ROBIN) &&
+      (queueGroupPolicy != NCS_MSG_QUEUE_GROUP_LEAST_LOADED)) {
     TRACE_2(
         "ERR_NOT_SUPPORTED: supported queueGroupPolicy (ROUND_ROBIN,BROADCAST,LOCAL_ROUND_ROBIN)");
     return SA_AIS_ERR_NOT_SUPPORTED;
@@ -5859,7 +6795,7 @@ static void msgget_timer_expired(void *arg) {
   mq_req.info.send.mqd = (*cancel_req)->queueHandle;
   mq_req.info.send.i_mtype = 1;
 
-  if ((rc = m_NCS_OS_POSIX_MQ(&mq_req)) != NCSCC_RC_SUCCESS) {
+  if ((rc = m_MQSV_SHM_MQ(&mq_req)) != NCSCC_RC_SUCCESS) {
     TRACE_4("Unable to put the cancel message in the queue");
   }
 
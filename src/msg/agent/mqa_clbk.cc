@@ -277,6 +277,13 @@ static void mqa_process_callback(MQA_CB *cb, SaMsgHandleT msgHandle,
         break;
       }
 
+      /* The message has been received by ncsMsgMessageGetBatch */
+      if (queue_info->num_received_skip) {
+        queue_info->num_received_skip--;
+        m_NCS_UNLOCK(&cb->cb_lock, NCS_LOCK_WRITE);
+        break;
+      }
+
       m_NCS_UNLOCK(&cb->cb_lock, NCS_LOCK_WRITE);
 
       if (client_info->msgCallbacks.saMsgMessageReceivedCallback)
@@ -1165,7 +1172,7 @@ void mqa_queue_reader(NCSCONTEXT arg) {
 
   while (1) {
     if ((existing_msg_count == 0) &&
-        (m_NCS_OS_POSIX_MQ(&mq_req) == NCSCC_RC_FAILURE))
+        (m_MQSV_SHM_MQ(&mq_req) == NCSCC_RC_FAILURE))
       break;
 
     if (m_NCS_LOCK(&mqa_cb->cb_lock, NCS_LOCK_WRITE) != NCSCC_RC_SUCCESS) break;
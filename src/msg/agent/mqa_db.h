@@ -40,7 +40,7 @@ typedef unsigned short SVC_SUBPART_VER;
 
 /********************Service Sub part Versions*********************************/
 
-#define MQA_PVT_SUBPART_VERSION 2
+#define MQA_PVT_SUBPART_VERSION 3
 
 /* MQA - MQA */
 #define MQA_WRT_MQA_SUBPART_VER_AT_MIN_MSG_FMT 1
@@ -51,14 +51,20 @@ typedef unsigned short SVC_SUBPART_VER;
 
 /* MQA - MQND */
 #define MQA_WRT_MQND_SUBPART_VER_AT_MIN_MSG_FMT 1
-#define MQA_WRT_MQND_SUBPART_VER_AT_MAX_MSG_FMT 2
+#define MQA_WRT_MQND_SUBPART_VER_AT_MAX_MSG_FMT 3
 #define MQA_WRT_MQND_SUBPART_VER_RANGE       \
   (MQA_WRT_MQND_SUBPART_VER_AT_MAX_MSG_FMT - \
    MQA_WRT_MQND_SUBPART_VER_AT_MIN_MSG_FMT + 1)
+/* From this message format MQND takes the messages put directly into its
+ * queues, see mqa_send_to_local_queue() */
+#define MQA_MQND_MSG_FMT_LOCAL_SEND 3
+/* From this message format MQND takes the batched sends and stats updates,
+ * see ncsMsgMessageSendBatch() and ncsMsgMessageGetBatch() */
+#define MQA_MQND_MSG_FMT_BATCH 3
 
 /* MQA - MQD */
 #define MQA_WRT_MQD_SUBPART_VER_AT_MIN_MSG_FMT 1
-#define MQA_WRT_MQD_SUBPART_VER_AT_MAX_MSG_FMT 2
+#define MQA_WRT_MQD_SUBPART_VER_AT_MAX_MSG_FMT 3
 #define MQA_WRT_MQD_SUBPART_VER_RANGE       \
   (MQA_WRT_MQD_SUBPART_VER_AT_MAX_MSG_FMT - \
    MQA_WRT_MQD_SUBPART_VER_AT_MIN_MSG_FMT + 1)
@@ -108,6 +114,8 @@ typedef struct mqa_queue_info {
   MQA_CLIENT_INFO *client_info;
   NCSCONTEXT task_handle;
   bool is_closed; /* Set to true after invoking the close */
+  /* Received callbacks to drop, for messages got by ncsMsgMessageGetBatch */
+  SaUint32T num_received_skip;
 } MQA_QUEUE_INFO;
 
 /* Timer node */
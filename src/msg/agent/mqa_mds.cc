@@ -159,9 +159,9 @@ static void mqa_mds_reregister_queues(void)
 }
 
 MSG_FRMT_VER mqa_mqnd_msg_fmt_table[MQA_WRT_MQND_SUBPART_VER_RANGE] = {
-    0, 2}; /*With version 1 it is not backward compatible */
+    0, 2, 3}; /*With version 1 it is not backward compatible */
 MSG_FRMT_VER mqa_mqd_msg_fmt_table[MQA_WRT_MQD_SUBPART_VER_RANGE] = {
-    0, 2}; /*With version 1 it is not backward compatible */
+    0, 2, 3}; /*With version 1 it is not backward compatible */
 
 extern uint32_t mqa_mqa_msg_fmt_table[];
 /****************************************************************************
@@ -445,8 +445,9 @@ static uint32_t mqa_mds_enc(MQA_CB *cb, MDS_CALLBACK_ENC_INFO *enc_info) {
   }
 
   if (enc_info->o_msg_fmt_ver) {
-    rc = (m_NCS_EDU_EXEC(&cb->edu_hdl, mqsv_edp_mqsv_evt, enc_info->io_uba,
-                         EDP_OP_TYPE_ENC, msg_ptr, &ederror));
+    rc = (m_NCS_EDU_VER_EXEC(&cb->edu_hdl, mqsv_edp_mqsv_evt,
+                             enc_info->io_uba, EDP_OP_TYPE_ENC, msg_ptr,
+                             &ederror, enc_info->o_msg_fmt_ver));
     if (rc != NCSCC_RC_SUCCESS) TRACE_2("FAILURE: MDS Encoding Failed");
     TRACE_LEAVE2(" return code %d", rc);
     return rc;
@@ -504,9 +505,9 @@ static uint32_t mqa_mds_dec(MQA_CB *cb, MDS_CALLBACK_DEC_INFO *dec_info) {
     memset(msg_ptr, 0, sizeof(MQSV_EVT));
     dec_info->o_msg = (NCSCONTEXT)msg_ptr;
 
-    rc = m_NCS_EDU_EXEC(&cb->edu_hdl, mqsv_edp_mqsv_evt, dec_info->io_uba,
-                        EDP_OP_TYPE_DEC, (MQSV_EVT **)&dec_info->o_msg,
-                        &ederror);
+    rc = m_NCS_EDU_VER_EXEC(&cb->edu_hdl, mqsv_edp_mqsv_evt, dec_info->io_uba,
+                            EDP_OP_TYPE_DEC, (MQSV_EVT **)&dec_info->o_msg,
+                            &ederror, dec_info->i_msg_fmt_ver);
     if (rc != NCSCC_RC_SUCCESS) {
       TRACE_2("FAILURE: MDS Decoding Failed");
       m_MMGR_FREE_MQA_EVT(dec_info->o_msg);
@@ -914,6 +915,28 @@ uint32_t mqa_mds_msg_sync_send_direct(uint32_t mqa_mds_hdl,
             m_MQSV_REVERSE_ENDIAN_L(&pEvt->info.sendMsgRsp.error, endianness));
         pEvt->info.sendMsgRsp.msgHandle = m_MQSV_REVERSE_ENDIAN_LL(
             &pEvt->info.sendMsgRsp.msgHandle, endianness);
+      } else if (pEvt->type.rsp_type == MQP_EVT_SEND_MSG_BATCH_RSP) {
+        /* ncsMsgMessageSendBatch response from MQND, the status of
+         * each message follows the event */
+        SaAisErrorT *errors = reinterpret_cast<SaAisErrorT *>(pEvt + 1);
+        uint32_t i, max_msgs = 0;
+
+        if (mds_info.info.svc_direct_send.info.sndrsp.len >
+            sizeof(MQSV_DSEND_EVT))
+          max_msgs = (mds_info.info.svc_direct_send.info.sndrsp.len -
+                      sizeof(MQSV_DSEND_EVT)) /
+                     sizeof(SaAisErrorT);
+
+        pEvt->info.sendBatchRsp.error =
+            static_cast<SaAisErrorT>(m_MQSV_REVERSE_ENDIAN_L(
+                &pEvt->info.sendBatchRsp.error, endianness));
+        pEvt->info.sendBatchRsp.numberOfMessages = m_MQSV_REVERSE_ENDIAN_L(
+            &pEvt->info.sendBatchRsp.numberOfMessages, endianness);
+        if (pEvt->info.sendBatchRsp.numberOfMessages > max_msgs)
+          pEvt->info.sendBatchRsp.numberOfMessages = max_msgs;
+        for (i = 0; i < pEvt->info.sendBatchRsp.numberOfMessages; i++)
+          errors[i] = static_cast<SaAisErrorT>(
+              m_MQSV_REVERSE_ENDIAN_L(&errors[i], endianness));
       } else {
         /* Reply message from
          * saMsgMessageReply/ReplyAsync */
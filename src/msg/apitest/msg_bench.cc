@@ -0,0 +1,692 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+// msgbench measures the throughput and the latency of the MSG service, see
+// PrintUsage(). Producer threads send messages to the consumer queues, either
+// directly or through a queue group, and a consumer thread per queue gets
+// them. The producers and the consumers run in the same process, or in two
+// processes on different nodes for remote placement.
+
+#include <getopt.h>
+#include <saMsg.h>
+#include <signal.h>
+#include <opensaf/mqsv_papi.h>
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "base/saf_error.h"
+#include "base/string_parse.h"
+#include "base/time.h"
+
+namespace {
+
+enum Destination {
+  kQueue,
+  kRoundRobin,
+  kLocalRoundRobin,
+  kBroadcast,
+  kLeastLoaded,
+  kNoOfDestinations
+};
+
+const char* const kDestinationNames[kNoOfDestinations] = {
+    "queue", "round-robin", "local-round-robin", "broadcast", "least-loaded"};
+
+const SaMsgQueueGroupPolicyT kPolicies[kNoOfDestinations] = {
+    SaMsgQueueGroupPolicyT(0), SA_MSG_QUEUE_GROUP_ROUND_ROBIN,
+    SA_MSG_QUEUE_GROUP_LOCAL_ROUND_ROBIN, SA_MSG_QUEUE_GROUP_BROADCAST,
+    NCS_MSG_QUEUE_GROUP_LEAST_LOADED};
+
+enum Role { kBoth, kProducer, kConsumer };
+
+struct Options {
+  Role role;
+  uint32_t no_of_producers;
+  uint32_t no_of_consumers;
+  std::vector<Destination> destinations;
+  std::vector<SaSizeT> message_sizes;
+  std::vector<SaUint8T> priorities;
+  uint64_t no_of_messages;
+};
+
+// The start of each message. The send time is read from the realtime clock,
+// so that the consumers on another node can compute the delivery latency.
+struct Header {
+  uint64_t send_time;
+  uint32_t no_of_producers;
+  uint32_t destination;
+  uint32_t end;  // The last message of a producer to each queue
+};
+
+// The end of run messages are sent with the lowest priority, after all the
+// messages of the run
+const SaUint8T kEndPriority = SA_MSG_MESSAGE_LOWEST_PRIORITY;
+
+std::atomic<bool> stop{false};
+
+void PrintUsage(const char* program_name) {
+  fprintf(stderr,
+          "Usage: %s [OPTION]...\n"
+          "\n"
+          "Measure the throughput and the latency of the MSG service. The\n"
+          "consumers create a queue each, insert them into a queue group per\n"
+          "group destination and get the messages. The producers send the\n"
+          "messages with saMsgMessageSend() for each combination of\n"
+          "destination and message size. Two lines are printed for each\n"
+          "combination, one for the send calls and one for the delivery to\n"
+          "the consumers, with the latencies in microseconds.\n"
+          "\n"
+          "Options:\n"
+          "\n"
+          "-r or --role=ROLE         'both' runs the producers and the\n"
+          "                          consumers in this process, default.\n"
+          "                          'consumer' creates the queues and gets\n"
+          "                          the messages until interrupted,\n"
+          "                          'producer' sends to the queues of a\n"
+          "                          consumer started before, e.g. on another\n"
+          "                          node.\n"
+          "-p or --producers=N       Number of producer threads, default 1.\n"
+          "-c or --consumers=N       Number of consumer queues, default 1.\n"
+          "-d or --destinations=LIST Comma separated list of destinations,\n"
+          "                          default queue,round-robin:\n"
+          "                          queue             the queues in turn\n"
+          "                          round-robin       queue group\n"
+          "                          local-round-robin queue group\n"
+          "                          broadcast         queue group\n"
+          "                          least-loaded      queue group\n"
+          "-z or --size=LIST         Comma separated list of message sizes\n"
+          "                          in bytes, default 64,1024,4096.\n"
+          "-P or --priorities=LIST   Comma separated list of priorities, 0\n"
+          "                          (highest) to 3, used in turn, default 0.\n"
+          "-n or --messages=N        Number of messages per producer,\n"
+          "                          default 10000.\n"
+          "\n"
+          "The producers and the consumer shall use the same number of\n"
+          "consumers, destinations and priorities. The delivery latency of a\n"
+          "remote consumer is only meaningful when the clocks of the nodes\n"
+          "are synchronized.\n",
+          program_name);
+}
+
+// Split @a str at the commas
+std::vector<std::string> SplitList(const char* str) {
+  std::vector<std::string> items;
+  std::string list = str;
+  size_t pos = 0;
+  while (pos <= list.size()) {
+    size_t comma = list.find(',', pos);
+    if (comma == std::string::npos) comma = list.size();
+    items.push_back(list.substr(pos, comma - pos));
+    pos = comma + 1;
+  }
+  return items;
+}
+
+bool ParseNumber(const char* str, uint64_t min, uint64_t max,
+                 uint64_t* number) {
+  bool success;
+  *number = base::StrToUint64(str, &success);
+  return success && *number >= min && *number <= max;
+}
+
+bool ParseNumbers(const char* str, uint64_t min, uint64_t max,
+                  std::vector<uint64_t>* numbers) {
+  numbers->clear();
+  for (const std::string& item : SplitList(str)) {
+    uint64_t number;
+    if (!ParseNumber(item.c_str(), min, max, &number)) return false;
+    numbers->push_back(number);
+  }
+  return true;
+}
+
+SaNameT MakeName(const std::string& str) {
+  SaNameT name;
+  memset(&name, 0, sizeof(name));
+  name.length = std::min(str.size(), sizeof(name.value));
+  memcpy(name.value, str.data(), name.length);
+  return name;
+}
+
+SaNameT QueueName(uint32_t index) {
+  return MakeName("safMq=msgbench_" + std::to_string(index));
+}
+
+SaNameT GroupName(Destination destination) {
+  return MakeName(std::string{"safMqg=msgbench_"} +
+                  kDestinationNames[destination]);
+}
+
+uint64_t RealtimeNanos() {
+  return base::TimespecToNanos(base::ReadRealtimeClock());
+}
+
+// The latencies of the messages of a run, in nanoseconds
+class Measurement {
+ public:
+  Measurement() : bytes_{0} {}
+  void Add(uint64_t latency, SaSizeT bytes) {
+    latencies_.push_back(latency);
+    bytes_ += bytes;
+  }
+  void Merge(const Measurement& other) {
+    latencies_.insert(latencies_.end(), other.latencies_.begin(),
+                      other.latencies_.end());
+    bytes_ += other.bytes_;
+  }
+  void Print(const Options& options, Destination destination, SaSizeT size,
+             const char* operation, double elapsed) {
+    if (latencies_.empty()) return;
+    std::sort(latencies_.begin(), latencies_.end());
+    uint64_t sum = 0;
+    for (uint64_t latency : latencies_) sum += latency;
+    size_t msgs = latencies_.size();
+    std::string priorities;
+    for (SaUint8T priority : options.priorities) {
+      if (!priorities.empty()) priorities += ',';
+      priorities += std::to_string(priority);
+    }
+    printf("%-17s %6llu %-7s %4" PRIu32 " %4" PRIu32
+           " %-7s %9zu %10.0f %8.1f %9.1f %9.1f %9.1f %9.1f\n",
+           kDestinationNames[destination], size, priorities.c_str(),
+           options.no_of_producers, options.no_of_consumers, operation, msgs,
+           msgs / elapsed, bytes_ / elapsed / (1024 * 1024),
+           sum / 1000.0 / msgs, latencies_[msgs / 2] / 1000.0,
+           latencies_[msgs * 99 / 100] / 1000.0, latencies_.back() / 1000.0);
+    fflush(stdout);
+  }
+  static void PrintHeader() {
+    printf("%-17s %6s %-7s %4s %4s %-7s %9s %10s %8s %9s %9s %9s %9s\n",
+           "destination", "size", "prio", "prod", "cons", "op", "msgs",
+           "msgs/s", "MB/s", "avg_us", "p50_us", "p99_us", "max_us");
+  }
+
+ private:
+  std::vector<uint64_t> latencies_;
+  SaSizeT bytes_;
+};
+
+// Call @a function until it does not return SA_AIS_ERR_TRY_AGAIN or
+// SA_AIS_ERR_QUEUE_FULL. The time spent waiting is part of the latency, as
+// for an application.
+template <typename Function>
+SaAisErrorT Retry(Function function) {
+  SaAisErrorT rc;
+  while ((rc = function()) == SA_AIS_ERR_TRY_AGAIN ||
+         rc == SA_AIS_ERR_QUEUE_FULL) {
+    base::Sleep(base::MillisToTimespec(1));
+  }
+  return rc;
+}
+
+bool Check(SaAisErrorT rc, const char* api) {
+  if (rc == SA_AIS_OK) return true;
+  fprintf(stderr, "%s failed: %s\n", api, saf_error(rc));
+  return false;
+}
+
+// The queues of the consumers and the queue groups they are members of
+class Consumers {
+ public:
+  Consumers(SaMsgHandleT msg_handle, const Options& options)
+      : msg_handle_{msg_handle},
+        options_(options),
+        max_message_size_{0},
+        queues_(options.no_of_consumers, 0) {}
+
+  bool Create(SaSizeT max_queue_size, SaSizeT max_message_size) {
+    max_message_size_ = max_message_size;
+    SaMsgQueueCreationAttributesT attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.creationFlags = 0;
+    attributes.retentionTime = 0;
+    // The queue size is shared by the priorities in use
+    std::vector<SaUint8T> priorities = options_.priorities;
+    priorities.push_back(kEndPriority);
+    std::sort(priorities.begin(), priorities.end());
+    priorities.erase(std::unique(priorities.begin(), priorities.end()),
+                     priorities.end());
+    for (SaUint8T priority : priorities) {
+      attributes.size[priority] = max_queue_size / priorities.size();
+    }
+    for (uint32_t i = 0; i != options_.no_of_consumers; ++i) {
+      SaNameT name = QueueName(i);
+      if (!Check(Retry([&] {
+                   return saMsgQueueOpen(msg_handle_, &name, &attributes,
+                                         SA_MSG_QUEUE_CREATE,
+                                         SA_TIME_ONE_MINUTE, &queues_[i]);
+                 }),
+                 "saMsgQueueOpen")) {
+        return false;
+      }
+    }
+    for (Destination destination : options_.destinations) {
+      if (destination == kQueue) continue;
+      SaNameT group = GroupName(destination);
+      if (!Check(Retry([&] {
+                   return saMsgQueueGroupCreate(msg_handle_, &group,
+                                                kPolicies[destination]);
+                 }),
+                 "saMsgQueueGroupCreate")) {
+        return false;
+      }
+      groups_.push_back(group);
+      for (uint32_t i = 0; i != options_.no_of_consumers; ++i) {
+        SaNameT name = QueueName(i);
+        if (!Check(Retry([&] {
+                     return saMsgQueueGroupInsert(msg_handle_, &group, &name);
+                   }),
+                   "saMsgQueueGroupInsert")) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  void Destroy() {
+    for (const SaNameT& group : groups_) {
+      Retry([&] { return saMsgQueueGroupDelete(msg_handle_, &group); });
+    }
+    for (uint32_t i = 0; i != options_.no_of_consumers; ++i) {
+      if (queues_[i] == 0) continue;
+      SaNameT name = QueueName(i);
+      Retry([&] { return saMsgQueueClose(queues_[i]); });
+      Retry([&] { return saMsgQueueUnlink(msg_handle_, &name); });
+    }
+  }
+
+  // Get the messages of a run from all the queues, until the end message of
+  // every producer has been got from each queue. Returns false if
+  // interrupted or on an error.
+  bool Run(Measurement* measurement, Destination* destination,
+           SaSizeT* size, double* elapsed) {
+    std::vector<Result> results(options_.no_of_consumers);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i != options_.no_of_consumers; ++i) {
+      threads.emplace_back(&Consumers::Get, this, queues_[i], &results[i]);
+    }
+    for (std::thread& thread : threads) thread.join();
+    uint64_t first_send = UINT64_MAX;
+    uint64_t last_receive = 0;
+    for (const Result& result : results) {
+      if (!result.ok) return false;
+      measurement->Merge(result.measurement);
+      first_send = std::min(first_send, result.first_send);
+      last_receive = std::max(last_receive, result.last_receive);
+      if (result.size != 0) {
+        *destination = result.destination;
+        *size = result.size;
+      }
+    }
+    *elapsed =
+        last_receive > first_send ? (last_receive - first_send) / 1e9 : 1e-9;
+    return true;
+  }
+
+ private:
+  struct Result {
+    Result()
+        : ok{false},
+          destination{kQueue},
+          size{0},
+          first_send{UINT64_MAX},
+          last_receive{0} {}
+    bool ok;
+    Measurement measurement;
+    Destination destination;
+    SaSizeT size;
+    uint64_t first_send;
+    uint64_t last_receive;
+  };
+
+  void Get(SaMsgQueueHandleT queue, Result* result) {
+    std::vector<char> buffer(max_message_size_);
+    uint32_t no_of_ends = 0;
+    uint32_t no_of_producers = 1;
+    while (no_of_ends < no_of_producers) {
+      SaMsgMessageT message;
+      memset(&message, 0, sizeof(message));
+      message.data = buffer.data();
+      message.size = buffer.size();
+      SaTimeT send_time;
+      SaMsgSenderIdT sender_id;
+      SaAisErrorT rc = saMsgMessageGet(queue, &message, &send_time,
+                                       &sender_id, SA_TIME_ONE_SECOND);
+      if (rc == SA_AIS_ERR_TIMEOUT || rc == SA_AIS_ERR_TRY_AGAIN) {
+        if (stop) return;
+        continue;
+      }
+      if (!Check(rc, "saMsgMessageGet")) return;
+      uint64_t now = RealtimeNanos();
+      if (message.size < sizeof(Header)) continue;
+      Header header;
+      memcpy(&header, buffer.data(), sizeof(header));
+      no_of_producers = header.no_of_producers;
+      if (header.end) {
+        ++no_of_ends;
+        continue;
+      }
+      result->measurement.Add(
+          now > header.send_time ? now - header.send_time : 0, message.size);
+      result->destination = static_cast<Destination>(header.destination);
+      result->size = message.size;
+      result->first_send = std::min(result->first_send, header.send_time);
+      result->last_receive = now;
+    }
+    result->ok = true;
+  }
+
+  SaMsgHandleT msg_handle_;
+  const Options& options_;
+  SaSizeT max_message_size_;
+  std::vector<SaMsgQueueHandleT> queues_;
+  std::vector<SaNameT> groups_;
+};
+
+// Send the messages of a run from the producer threads, followed by an end
+// message from each producer to each queue
+class Producers {
+ public:
+  Producers(SaMsgHandleT msg_handle, const Options& options,
+            Destination destination, SaSizeT size)
+      : msg_handle_{msg_handle},
+        options_(options),
+        destination_{destination},
+        size_{size} {}
+
+  bool Run(Measurement* measurement, double* elapsed) {
+    std::vector<Measurement> measurements(options_.no_of_producers);
+    std::vector<char> oks(options_.no_of_producers, false);
+    std::vector<std::thread> threads;
+    timespec start = base::ReadMonotonicClock();
+    for (uint32_t i = 0; i != options_.no_of_producers; ++i) {
+      threads.emplace_back(&Producers::Send, this, i, &measurements[i],
+                           &oks[i]);
+    }
+    for (std::thread& thread : threads) thread.join();
+    *elapsed = base::TimespecToDouble(base::ReadMonotonicClock() - start);
+    for (uint32_t i = 0; i != options_.no_of_producers; ++i) {
+      measurement->Merge(measurements[i]);
+      if (!oks[i]) return false;
+    }
+    return true;
+  }
+
+ private:
+  void Send(uint32_t producer, Measurement* measurement, char* ok) {
+    std::vector<char> data(size_, 'x');
+    Header header;
+    memset(&header, 0, sizeof(header));
+    header.no_of_producers = options_.no_of_producers;
+    header.destination = destination_;
+    SaMsgMessageT message;
+    memset(&message, 0, sizeof(message));
+    message.data = data.data();
+    message.size = data.size();
+    SaNameT group = GroupName(destination_);
+    for (uint64_t i = 0; i != options_.no_of_messages; ++i) {
+      if (stop) return;
+      SaNameT queue;
+      const SaNameT* name = &group;
+      if (destination_ == kQueue) {
+        queue = QueueName((producer + i) % options_.no_of_consumers);
+        name = &queue;
+      }
+      message.priority =
+          options_.priorities[i % options_.priorities.size()];
+      timespec start = base::ReadMonotonicClock();
+      header.send_time = RealtimeNanos();
+      memcpy(data.data(), &header, sizeof(header));
+      SaAisErrorT rc = Retry([&] {
+        return saMsgMessageSend(msg_handle_, name, &message,
+                                SA_TIME_ONE_MINUTE);
+      });
+      measurement->Add(
+          base::TimespecToNanos(base::ReadMonotonicClock() - start),
+          message.size);
+      if (!Check(rc, "saMsgMessageSend")) return;
+    }
+    header.end = 1;
+    memcpy(data.data(), &header, sizeof(header));
+    message.size = sizeof(header);
+    message.priority = kEndPriority;
+    for (uint32_t i = 0; i != options_.no_of_consumers; ++i) {
+      SaNameT queue = QueueName(i);
+      if (!Check(Retry([&] {
+                   return saMsgMessageSend(msg_handle_, &queue, &message,
+                                           SA_TIME_ONE_MINUTE);
+                 }),
+                 "saMsgMessageSend")) {
+        return;
+      }
+    }
+    *ok = true;
+  }
+
+  SaMsgHandleT msg_handle_;
+  const Options& options_;
+  Destination destination_;
+  SaSizeT size_;
+};
+
+void SignalHandler(int) { stop = true; }
+
+bool GetLimit(SaMsgHandleT msg_handle, SaMsgLimitIdT id, SaSizeT* limit) {
+  SaLimitValueT value;
+  if (!Check(Retry([&] { return saMsgLimitGet(msg_handle, id, &value); }),
+             "saMsgLimitGet")) {
+    return false;
+  }
+  *limit = value.uint64Value;
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  struct option long_options[] = {
+      {"role", required_argument, nullptr, 'r'},
+      {"producers", required_argument, nullptr, 'p'},
+      {"consumers", required_argument, nullptr, 'c'},
+      {"destinations", required_argument, nullptr, 'd'},
+      {"size", required_argument, nullptr, 'z'},
+      {"priorities", required_argument, nullptr, 'P'},
+      {"messages", required_argument, nullptr, 'n'},
+      {"help", no_argument, nullptr, 'h'},
+      {nullptr, 0, nullptr, 0}};
+  Options options;
+  options.role = kBoth;
+  options.no_of_producers = 1;
+  options.no_of_consumers = 1;
+  options.destinations = {kQueue, kRoundRobin};
+  options.message_sizes = {64, 1024, 4096};
+  options.priorities = {SA_MSG_MESSAGE_HIGHEST_PRIORITY};
+  options.no_of_messages = 10000;
+  std::vector<uint64_t> numbers;
+  uint64_t number;
+  int option;
+  while ((option = getopt_long(argc, argv, "r:p:c:d:z:P:n:h", long_options,
+                               nullptr)) != -1) {
+    switch (option) {
+      case 'r':
+        if (strcmp(optarg, "both") == 0) {
+          options.role = kBoth;
+        } else if (strcmp(optarg, "producer") == 0) {
+          options.role = kProducer;
+        } else if (strcmp(optarg, "consumer") == 0) {
+          options.role = kConsumer;
+        } else {
+          fprintf(stderr, "Illegal role '%s'\n", optarg);
+          exit(EXIT_FAILURE);
+        }
+        break;
+      case 'p':
+        if (!ParseNumber(optarg, 1, 1000, &number)) {
+          fprintf(stderr, "Illegal number of producers '%s'\n", optarg);
+          exit(EXIT_FAILURE);
+        }
+        options.no_of_producers = number;
+        break;
+      case 'c':
+        if (!ParseNumber(optarg, 1, 1000, &number)) {
+          fprintf(stderr, "Illegal number of consumers '%s'\n", optarg);
+          exit(EXIT_FAILURE);
+        }
+        options.no_of_consumers = number;
+        break;
+      case 'd':
+        options.destinations.clear();
+        for (const std::string& item : SplitList(optarg)) {
+          const char* const* name =
+              std::find(kDestinationNames,
+                        kDestinationNames + kNoOfDestinations, item);
+          if (name == kDestinationNames + kNoOfDestinations) {
+            fprintf(stderr, "Illegal destination '%s'\n", item.c_str());
+            exit(EXIT_FAILURE);
+          }
+          options.destinations.push_back(
+              static_cast<Destination>(name - kDestinationNames));
+        }
+        break;
+      case 'z':
+        if (!ParseNumbers(optarg, sizeof(Header), UINT32_MAX, &numbers)) {
+          fprintf(stderr, "Illegal message size '%s', the minimum is %zu\n",
+                  optarg, sizeof(Header));
+          exit(EXIT_FAILURE);
+        }
+        options.message_sizes.assign(numbers.begin(), numbers.end());
+        break;
+      case 'P':
+        if (!ParseNumbers(optarg, SA_MSG_MESSAGE_HIGHEST_PRIORITY,
+                          SA_MSG_MESSAGE_LOWEST_PRIORITY, &numbers)) {
+          fprintf(stderr, "Illegal priority '%s'\n", optarg);
+          exit(EXIT_FAILURE);
+        }
+        options.priorities.assign(numbers.begin(), numbers.end());
+        break;
+      case 'n':
+        if (!ParseNumber(optarg, 1, UINT64_MAX, &number)) {
+          fprintf(stderr, "Illegal number of messages '%s'\n", optarg);
+          exit(EXIT_FAILURE);
+        }
+        options.no_of_messages = number;
+        break;
+      case 'h':
+        PrintUsage(argv[0]);
+        exit(EXIT_SUCCESS);
+      default:
+        PrintUsage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+  }
+  if (optind != argc) {
+    PrintUsage(argv[0]);
+    exit(EXIT_FAILURE);
+  }
+
+  SaMsgHandleT msg_handle;
+  SaVersionT version = {'B', 3, 1};
+  if (!Check(Retry([&] {
+               return saMsgInitialize(&msg_handle, nullptr, &version);
+             }),
+             "saMsgInitialize")) {
+    exit(EXIT_FAILURE);
+  }
+
+  SaSizeT max_queue_size;
+  SaSizeT max_message_size;
+  if (!GetLimit(msg_handle, SA_MSG_MAX_QUEUE_SIZE_ID, &max_queue_size) ||
+      !GetLimit(msg_handle, SA_MSG_MAX_MESSAGE_SIZE_ID, &max_message_size)) {
+    saMsgFinalize(msg_handle);
+    exit(EXIT_FAILURE);
+  }
+  for (SaSizeT size : options.message_sizes) {
+    if (size > max_message_size) {
+      fprintf(stderr, "Message size %llu is above the maximum %llu\n", size,
+              max_message_size);
+      saMsgFinalize(msg_handle);
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  bool ok = true;
+  Consumers consumers{msg_handle, options};
+  if (options.role != kProducer) {
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = SignalHandler;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    ok = consumers.Create(max_queue_size, max_message_size);
+  }
+
+  Measurement::PrintHeader();
+  if (ok && options.role == kConsumer) {
+    // Report each run of the remote producers until interrupted
+    for (;;) {
+      Measurement delivery;
+      Destination destination = kQueue;
+      SaSizeT size = 0;
+      double elapsed;
+      if (!consumers.Run(&delivery, &destination, &size, &elapsed)) break;
+      delivery.Print(options, destination, size, "deliver", elapsed);
+    }
+  } else if (ok) {
+    for (Destination destination : options.destinations) {
+      for (SaSizeT size : options.message_sizes) {
+        Measurement send;
+        Measurement delivery;
+        double send_elapsed;
+        double delivery_elapsed = 0;
+        bool delivery_ok = true;
+        Destination delivery_destination;
+        SaSizeT delivery_size;
+        std::thread consumer_thread;
+        if (options.role == kBoth) {
+          consumer_thread = std::thread([&] {
+            delivery_ok =
+                consumers.Run(&delivery, &delivery_destination,
+                              &delivery_size, &delivery_elapsed);
+          });
+        }
+        Producers producers{msg_handle, options, destination, size};
+        bool send_ok = producers.Run(&send, &send_elapsed);
+        if (!send_ok) stop = true;
+        if (consumer_thread.joinable()) consumer_thread.join();
+        send.Print(options, destination, size, "send", send_elapsed);
+        if (options.role == kBoth && delivery_ok) {
+          delivery.Print(options, destination, size, "deliver",
+                         delivery_elapsed);
+        }
+        if (!send_ok || !delivery_ok) {
+          ok = false;
+          break;
+        }
+      }
+      if (!ok) break;
+    }
+  }
+
+  if (options.role != kProducer) consumers.Destroy();
+  saMsgFinalize(msg_handle);
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,312 @@
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <poll.h>
+#include <unistd.h>
+#include "msg/apitest/msgtest.h"
+#include "ais/include/saMsg.h"
+#include <opensaf/mqsv_papi.h>
+
+static SaVersionT msg3_1 = { 'B', 3, 0 };
+
+static const SaNameT queueName = {
+  sizeof("safMq=TestQueueBatch") - 1,
+  "safMq=TestQueueBatch"
+};
+
+static const SaMsgQueueCreationAttributesT creationAttributes = {
+  0,
+  { 100, 100, 100, 100 },
+  0
+};
+
+static const int numMessages(3);
+
+static int receivedCallbacks;
+
+static void messageReceivedCallback(SaMsgQueueHandleT queueHandle)
+{
+  receivedCallbacks++;
+}
+
+static SaMsgQueueHandleT openBatchQueue(SaMsgHandleT msgHandle,
+                                        SaMsgQueueOpenFlagsT openFlags)
+{
+  SaMsgQueueHandleT queueHandle;
+  SaAisErrorT rc;
+
+  while (true) {
+    rc = saMsgQueueOpen(msgHandle,
+                        &queueName,
+                        &creationAttributes,
+                        SA_MSG_QUEUE_CREATE | openFlags,
+                        SA_TIME_ONE_SECOND * 20,
+                        &queueHandle);
+
+    if (rc == SA_AIS_ERR_TRY_AGAIN || rc == SA_AIS_ERR_TIMEOUT)
+      sleep(1);
+    else
+      break;
+  }
+  assert(rc == SA_AIS_OK);
+
+  return queueHandle;
+}
+
+static void closeBatchQueue(SaMsgHandleT msgHandle)
+{
+  SaAisErrorT rc = saMsgQueueUnlink(msgHandle, &queueName);
+  assert(rc == SA_AIS_OK);
+
+  rc = saMsgFinalize(msgHandle);
+  assert(rc == SA_AIS_OK);
+}
+
+// Messages of 10 bytes, "message a", "message b" and so on with the null
+static void fillMessages(SaMsgMessageT *messages, char (*data)[10], int count,
+                         SaUint8T priority)
+{
+  for (int i = 0; i < count; i++) {
+    snprintf(data[i], sizeof(data[i]), "message %c", 'a' + i);
+    messages[i].type = 0;
+    messages[i].version = 0;
+    messages[i].size = sizeof(data[i]);
+    messages[i].senderName = 0;
+    messages[i].data = data[i];
+    messages[i].priority = priority;
+  }
+}
+
+// Get messages with buffers allocated by the library and check their data
+static SaAisErrorT getMessages(SaMsgQueueHandleT queueHandle, int first,
+                               SaUint32T maxMessages,
+                               SaUint32T *numberOfMessages)
+{
+  SaMsgMessageT messages[numMessages];
+
+  memset(messages, 0, sizeof(messages));
+  SaAisErrorT rc(ncsMsgMessageGetBatch(queueHandle, messages, 0, 0,
+                                       maxMessages, numberOfMessages,
+                                       SA_TIME_ONE_SECOND));
+
+  for (SaUint32T i = 0; i < *numberOfMessages; i++) {
+    char expected[10];
+    snprintf(expected, sizeof(expected), "message %c", 'a' + first + i);
+    if (rc == SA_AIS_OK && (messages[i].size != sizeof(expected) ||
+                            memcmp(messages[i].data, expected,
+                                   sizeof(expected)) != 0))
+      rc = SA_AIS_ERR_MESSAGE_ERROR;
+    free(messages[i].data);
+  }
+
+  return rc;
+}
+
+static void batch_01(void)
+{
+  SaMsgHandleT msgHandle;
+  SaAisErrorT rc = saMsgInitialize(&msgHandle, 0, &msg3_1);
+  assert(rc == SA_AIS_OK);
+
+  SaAisErrorT errors[numMessages];
+  rc = ncsMsgMessageSendBatch(msgHandle, &queueName, 0, numMessages,
+                              SA_TIME_ONE_SECOND, errors);
+  aisrc_validate(rc, SA_AIS_ERR_INVALID_PARAM);
+
+  rc = saMsgFinalize(msgHandle);
+  assert(rc == SA_AIS_OK);
+}
+
+static void batch_02(void)
+{
+  SaMsgHandleT msgHandle;
+  SaAisErrorT rc = saMsgInitialize(&msgHandle, 0, &msg3_1);
+  assert(rc == SA_AIS_OK);
+
+  SaMsgQueueHandleT queueHandle(openBatchQueue(msgHandle, 0));
+
+  SaMsgMessageT message;
+  SaUint32T numberOfMessages;
+  memset(&message, 0, sizeof(message));
+  rc = ncsMsgMessageGetBatch(queueHandle, &message, 0, 0, 0,
+                             &numberOfMessages, SA_TIME_ONE_SECOND);
+  aisrc_validate(rc, SA_AIS_ERR_INVALID_PARAM);
+
+  closeBatchQueue(msgHandle);
+}
+
+static void batch_03(void)
+{
+  SaMsgHandleT msgHandle;
+  SaAisErrorT rc = saMsgInitialize(&msgHandle, 0, &msg3_1);
+  assert(rc == SA_AIS_OK);
+
+  SaMsgQueueHandleT queueHandle(openBatchQueue(msgHandle, 0));
+
+  SaMsgMessageT messages[numMessages];
+  char data[numMessages][10];
+  SaAisErrorT errors[numMessages];
+  fillMessages(messages, data, numMessages, SA_MSG_MESSAGE_HIGHEST_PRIORITY);
+  rc = ncsMsgMessageSendBatch(msgHandle, &queueName, messages, numMessages,
+                              SA_TIME_ONE_SECOND, errors);
+  for (int i = 0; rc == SA_AIS_OK && i < numMessages; i++)
+    rc = errors[i];
+
+  SaUint32T numberOfMessages(0);
+  if (rc == SA_AIS_OK)
+    rc = getMessages(queueHandle, 0, numMessages, &numberOfMessages);
+  if (rc == SA_AIS_OK && numberOfMessages != numMessages)
+    rc = SA_AIS_ERR_MESSAGE_ERROR;
+  aisrc_validate(rc, SA_AIS_OK);
+
+  closeBatchQueue(msgHandle);
+}
+
+static void batch_04(void)
+{
+  SaMsgHandleT msgHandle;
+  SaAisErrorT rc = saMsgInitialize(&msgHandle, 0, &msg3_1);
+  assert(rc == SA_AIS_OK);
+
+  SaMsgQueueHandleT queueHandle(openBatchQueue(msgHandle, 0));
+
+  SaMsgMessageT messages[numMessages];
+  char data[numMessages][10];
+  SaAisErrorT errors[numMessages];
+  fillMessages(messages, data, numMessages, SA_MSG_MESSAGE_HIGHEST_PRIORITY);
+  rc = ncsMsgMessageSendBatch(msgHandle, &queueName, messages, numMessages,
+                              SA_TIME_ONE_SECOND, errors);
+  assert(rc == SA_AIS_OK);
+
+  // The message that does not fit is left for the next call
+  SaUint32T numberOfMessages(0);
+  rc = getMessages(queueHandle, 0, numMessages - 1, &numberOfMessages);
+  if (rc == SA_AIS_OK && numberOfMessages != numMessages - 1)
+    rc = SA_AIS_ERR_MESSAGE_ERROR;
+  if (rc == SA_AIS_OK)
+    rc = getMessages(queueHandle, numMessages - 1, numMessages,
+                     &numberOfMessages);
+  if (rc == SA_AIS_OK && numberOfMessages != 1)
+    rc = SA_AIS_ERR_MESSAGE_ERROR;
+  aisrc_validate(rc, SA_AIS_OK);
+
+  closeBatchQueue(msgHandle);
+}
+
+static void batch_05(void)
+{
+  SaMsgHandleT msgHandle;
+  SaAisErrorT rc = saMsgInitialize(&msgHandle, 0, &msg3_1);
+  assert(rc == SA_AIS_OK);
+
+  SaMsgQueueHandleT queueHandle(openBatchQueue(msgHandle, 0));
+
+  SaUint32T numberOfMessages(0);
+  rc = getMessages(queueHandle, 0, numMessages, &numberOfMessages);
+  if (rc == SA_AIS_ERR_TIMEOUT && numberOfMessages != 0)
+    rc = SA_AIS_ERR_MESSAGE_ERROR;
+  aisrc_validate(rc, SA_AIS_ERR_TIMEOUT);
+
+  closeBatchQueue(msgHandle);
+}
+
+static void batch_06(void)
+{
+  SaMsgHandleT msgHandle;
+  SaAisErrorT rc = saMsgInitialize(&msgHandle, 0, &msg3_1);
+  assert(rc == SA_AIS_OK);
+
+  openBatchQueue(msgHandle, 0);
+
+  // 12 messages of 10 bytes to a priority area of 100 bytes
+  const int count(12);
+  SaMsgMessageT messages[count];
+  char data[count][10];
+  SaAisErrorT errors[count];
+  fillMessages(messages, data, count, SA_MSG_MESSAGE_LOWEST_PRIORITY);
+  rc = ncsMsgMessageSendBatch(msgHandle, &queueName, messages, count,
+                              SA_TIME_ONE_SECOND, errors);
+  if (rc == SA_AIS_ERR_QUEUE_FULL) {
+    for (int i = 0; i < count; i++) {
+      if (errors[i] != (i < 10 ? SA_AIS_OK : SA_AIS_ERR_QUEUE_FULL))
+        rc = SA_AIS_ERR_MESSAGE_ERROR;
+    }
+  }
+  aisrc_validate(rc, SA_AIS_ERR_QUEUE_FULL);
+
+  closeBatchQueue(msgHandle);
+}
+
+static void batch_07(void)
+{
+  SaMsgHandleT msgHandle;
+  SaMsgCallbacksT callbacks = {
+    0,
+    0,
+    0,
+    messageReceivedCallback
+  };
+  SaAisErrorT rc = saMsgInitialize(&msgHandle, &callbacks, &msg3_1);
+  assert(rc == SA_AIS_OK);
+
+  SaSelectionObjectT selectionObject;
+  rc = saMsgSelectionObjectGet(msgHandle, &selectionObject);
+  assert(rc == SA_AIS_OK);
+
+  SaMsgQueueHandleT queueHandle(
+      openBatchQueue(msgHandle, SA_MSG_QUEUE_RECEIVE_CALLBACK));
+
+  SaMsgMessageT messages[numMessages];
+  char data[numMessages][10];
+  SaAisErrorT errors[numMessages];
+  fillMessages(messages, data, numMessages, SA_MSG_MESSAGE_HIGHEST_PRIORITY);
+  rc = ncsMsgMessageSendBatch(msgHandle, &queueName, messages, numMessages,
+                              SA_TIME_ONE_SECOND, errors);
+  assert(rc == SA_AIS_OK);
+
+  SaUint32T numberOfMessages(0);
+  rc = getMessages(queueHandle, 0, numMessages, &numberOfMessages);
+  if (rc == SA_AIS_OK && numberOfMessages != numMessages)
+    rc = SA_AIS_ERR_MESSAGE_ERROR;
+
+  // One callback for the call, as for saMsgMessageGet()
+  receivedCallbacks = 0;
+  struct pollfd fds = { static_cast<int>(selectionObject), POLLIN, 0 };
+  while (rc == SA_AIS_OK && poll(&fds, 1, 1000) > 0) {
+    rc = saMsgDispatch(msgHandle, SA_DISPATCH_ALL);
+  }
+  if (rc == SA_AIS_OK && receivedCallbacks != 1)
+    rc = SA_AIS_ERR_MESSAGE_ERROR;
+  aisrc_validate(rc, SA_AIS_OK);
+
+  closeBatchQueue(msgHandle);
+}
+
+__attribute__((constructor)) static void messageBatch_constructor(void) {
+  test_suite_add(30, "ncsMsgMessageSendBatch and ncsMsgMessageGetBatch");
+  test_case_add(30,
+                batch_01,
+                "ncsMsgMessageSendBatch with null messages pointer");
+  test_case_add(30,
+                batch_02,
+                "ncsMsgMessageGetBatch with maxMessages 0");
+  test_case_add(30,
+                batch_03,
+                "messages sent in a batch are got in a batch in order");
+  test_case_add(30,
+                batch_04,
+                "ncsMsgMessageGetBatch leaves the messages beyond "
+                "maxMessages");
+  test_case_add(30,
+                batch_05,
+                "ncsMsgMessageGetBatch on an empty queue returns TIMEOUT");
+  test_case_add(30,
+                batch_06,
+                "ncsMsgMessageSendBatch returns QUEUE_FULL for the messages "
+                "that do not fit");
+  test_case_add(30,
+                batch_07,
+                "ncsMsgMessageGetBatch invokes one received callback");
+}
@@ -984,6 +984,8 @@ static uint32_t asapi_cpy_track_info(ASAPi_GROUP_INFO *pGinfo,
 		     selection policy is multicast then it selects all the
 		     queues in the list otherwise if the selection policy is
 		     unicast then it selects the queue in round robin manner.
+		     The least loaded policy selects the queue with the lowest
+		     load band, in round robin manner among equal bands.
 
    ARGUMENTS      :  info - Group information
 		     dest - destination information
@@ -1005,8 +1007,9 @@ uint32_t asapi_queue_select(ASAPi_GROUP_INFO *pGinfo)
 	itr.state = pGinfo->plaQueue;
 	q_cnt = pGinfo->qlist.count;
 
-	/* changes for local round robin and round robin takeover */
-	switch (pGinfo->policy) {
+	/* changes for local round robin and round robin takeover, the least
+	 * loaded policy is not in SaMsgQueueGroupPolicyT */
+	switch ((uint32_t)pGinfo->policy) {
 	case SA_MSG_QUEUE_GROUP_ROUND_ROBIN:
 		do {
 			pQelm = (ASAPi_QUEUE_INFO *)ncs_queue_get_next(
@@ -1105,6 +1108,47 @@ uint32_t asapi_queue_select(ASAPi_GROUP_INFO *pGinfo)
 		pGinfo->pQueue = 0;
 		break;
 
+	case NCS_MSG_QUEUE_GROUP_LEAST_LOADED: {
+		ASAPi_QUEUE_INFO *pBest = 0;
+
+		/* Walk all the queues starting after the last selected one,
+		 * the first queue found in the lowest load band wins */
+		do {
+			pQelm = (ASAPi_QUEUE_INFO *)ncs_queue_get_next(
+			    &pGinfo->qlist, &itr);
+
+			if (!pQelm) {
+				/* It has reach end of the list, need to get the
+				 * first Queue */
+				itr.state = 0;
+				pQelm = (ASAPi_QUEUE_INFO *)ncs_queue_get_next(
+				    &pGinfo->qlist, &itr);
+			}
+			if ((pQelm->param.owner !=
+			     MQSV_QUEUE_OWN_STATE_ORPHAN) &&
+			    (!pBest || (m_ASAPi_LOAD_BAND(pQelm->param.load) <
+					m_ASAPi_LOAD_BAND(pBest->param.load))))
+				pBest = pQelm;
+			q_cnt--;
+		} while (q_cnt > 0);
+
+		if (pBest) {
+			pQelm = pBest;
+		} else {
+			/* No opened queue, take the next one as round robin
+			 * does */
+			pQelm = (ASAPi_QUEUE_INFO *)ncs_queue_get_next(
+			    &pGinfo->qlist, &itr);
+
+			if (!pQelm) {
+				itr.state = 0;
+				pQelm = (ASAPi_QUEUE_INFO *)ncs_queue_get_next(
+				    &pGinfo->qlist, &itr);
+			}
+		}
+		break;
+	}
+
 	case SA_MSG_QUEUE_GROUP_BROADCAST:
 		pQelm = (ASAPi_QUEUE_INFO *)ncs_queue_get_next(&pGinfo->qlist,
 							       &itr);
@@ -1275,6 +1319,14 @@ void asapi_msg_free(ASAPi_MSG_INFO **msg)
 		pInfo->qparam = 0;
 	}
 
+	if ((ASAPi_MSG_LOAD_UPD == (*msg)->msgtype) &&
+	    ((*msg)->info.lupd.qload)) {
+		m_MMGR_FREE_ASAPi_DEFAULT_VAL(
+		    (*msg)->info.lupd.qload,
+		    asapi.my_svc_id); /* Free the queue loads */
+		(*msg)->info.lupd.qload = 0;
+	}
+
 	m_MMGR_FREE_ASAPi_MSG_INFO(
 	    (*msg), asapi.my_svc_id); /* Free the ASAPi Message */
 	*msg = 0;
@@ -1332,6 +1384,18 @@ uint32_t asapi_msg_cpy(ASAPi_MSG_INFO *from, ASAPi_MSG_INFO **to)
 		       sizeof(ASAPi_QUEUE_PARAM));
 	}
 
+	if ((ASAPi_MSG_LOAD_UPD == pMsg->msgtype) && (pMsg->info.lupd.qcnt)) {
+		pMsg->info.lupd.qload = m_MMGR_ALLOC_ASAPi_DEFAULT_VAL(
+		    pMsg->info.lupd.qcnt * sizeof(ASAPi_QUEUE_LOAD),
+		    asapi.my_svc_id);
+		if (!pMsg->info.lupd.qload) {
+			m_MMGR_FREE_ASAPi_MSG_INFO(pMsg, asapi.my_svc_id);
+			return m_ASAPi_DBG_SINK(NCSCC_RC_FAILURE);
+		}
+		memcpy(pMsg->info.lupd.qload, from->info.lupd.qload,
+		       pMsg->info.lupd.qcnt * sizeof(ASAPi_QUEUE_LOAD));
+	}
+
 	*to = pMsg;
 	return NCSCC_RC_SUCCESS;
 } /* End of asapi_msg_cpy() */
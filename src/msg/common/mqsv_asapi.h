@@ -33,6 +33,7 @@
 #define MSG_COMMON_MQSV_ASAPI_H_
 
 #include <saAis.h>
+#include <opensaf/mqsv_papi.h>
 #include "msg/common/mqsv_asapi_mem.h"
 #include "base/ncsencdec_pub.h"
 
@@ -66,6 +67,21 @@ extern "C" {
 #define m_ASAPi_TRACK_ENABLE_RESET(flag) (flag &= ~ASAPi_TRACK_ENABLE)
 #define m_ASAPi_TRACK_DISABLE_RESET(flag) (flag &= ~ASAPi_TRACK_DISABLE)
 
+/********************************** ASAPi LOAD ******************************/
+/* The load of a queue is the used part of its size in per mille. Loads in
+ * the same band are treated as equal by the least loaded group policy and
+ * a new load is only reported to MQD when it moves to another band. */
+#define ASAPi_LOAD_MAX 1000
+#define ASAPi_LOAD_BAND 50
+#define m_ASAPi_LOAD_BAND(load) ((load) / ASAPi_LOAD_BAND)
+
+/* Maximum number of queue loads in one load update message */
+#define ASAPi_LOAD_UPD_MAX_QUEUES 128
+
+/* From this message format the queue parameters carry the load and MQND
+ * sends ASAPi_MSG_LOAD_UPD to MQD */
+#define ASAPi_MSG_FMT_LOAD 3
+
 /****************************** ENUM ****************************************/
 typedef enum {
   ASAPi_OBJ_QUEUE = 1, /* Object type QUEUE */
@@ -100,6 +116,7 @@ typedef enum {
   ASAPi_MSG_TRACK,           /* ASAPi Track Message */
   ASAPi_MSG_TRACK_RESP,      /* ASAPi Track Response Message */
   ASAPi_MSG_TRACK_NTFY,      /* ASAPi Track Notification Message */
+  ASAPi_MSG_LOAD_UPD,        /* ASAPi Queue Load Update Message */
 } ASAPi_MSG_TYPE;
 
 typedef enum {
@@ -124,6 +141,7 @@ typedef struct asapi_queue_param {
   uint8_t is_mqnd_down;                   /* true if mqnd is down else false */
   SaMsgQueueCreationFlagsT creationFlags; /* Queue creation flags */
   SaSizeT size[SA_MSG_MESSAGE_LOWEST_PRIORITY + 1]; /* Priority queue sizes */
+  uint32_t load;                          /* Used part of the queue */
 } ASAPi_QUEUE_PARAM;
 
 /*****************************************************************************\
@@ -277,6 +295,18 @@ typedef struct asapi_track_ntfy_info {
   ASAPi_OBJECT_OPR opr;    /* Object Operation */
 } ASAPi_TRACK_NTFY_INFO;
 
+/*****************************************************************************                  A S A Pi - L O A D  U P D A T E  I N F O
+\*****************************************************************************/
+typedef struct asapi_queue_load {
+  SaNameT name;  /* Queue Name */
+  uint32_t load; /* Used part of the queue */
+} ASAPi_QUEUE_LOAD;
+
+typedef struct asapi_load_upd_info {
+  uint16_t qcnt;           /* Number of queues */
+  ASAPi_QUEUE_LOAD *qload; /* Loads of the queues */
+} ASAPi_LOAD_UPD_INFO;
+
 /*@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@*\
                A S A Pi - M E S S A G E  E N V E L O P
 \*@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@*/
@@ -295,6 +325,7 @@ typedef struct asapi_msg_info {
     ASAPi_GETQUEUE_RESP_INFO vresp; /* Getqueue Queue Response Message */
     ASAPi_TRACK_RESP_INFO tresp;    /* Track Response Message */
     ASAPi_TRACK_NTFY_INFO tntfy;    /* Track Notification Message */
+    ASAPi_LOAD_UPD_INFO lupd;       /* Load Update Message */
   } info;
   uint16_t usg_cnt; /* Usage count */
 } ASAPi_MSG_INFO;
@@ -418,8 +449,8 @@ SaAisErrorT asapi_opr_hdlr(struct asapi_opr_info *);
  These routines are to be only used by MDS for Encoding / Decoding / Copying
  ASAPi messages.
 \*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
-void asapi_msg_enc(ASAPi_MSG_INFO *, NCS_UBAID *);
-uint32_t asapi_msg_dec(NCS_UBAID *, ASAPi_MSG_INFO **);
+void asapi_msg_enc(ASAPi_MSG_INFO *, NCS_UBAID *, uint16_t);
+uint32_t asapi_msg_dec(NCS_UBAID *, ASAPi_MSG_INFO **, uint16_t);
 uint32_t asapi_msg_cpy(ASAPi_MSG_INFO *, ASAPi_MSG_INFO **);
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*\
@@ -39,25 +39,28 @@ routine asapi_getqueue_dec.......ASAPi Getqueue Message Decode routine
 #include "msg/common/mqsv.h"
 
 /******************************** LOCAL ROUTINES *****************************/
-static uint32_t asapi_reg_dec(NCS_UBAID *, ASAPi_REG_INFO *);
+static uint32_t asapi_reg_dec(NCS_UBAID *, ASAPi_REG_INFO *, uint16_t);
 static uint32_t asapi_reg_resp_dec(NCS_UBAID *, ASAPi_REG_RESP_INFO *);
 static uint32_t asapi_dereg_dec(NCS_UBAID *, ASAPi_DEREG_INFO *);
 static uint32_t asapi_dereg_resp_dec(NCS_UBAID *, ASAPi_DEREG_RESP_INFO *);
 static uint32_t asapi_nreslove_dec(NCS_UBAID *, ASAPi_NRESOLVE_INFO *);
 static uint32_t asapi_nreslove_resp_dec(NCS_UBAID *,
-					ASAPi_NRESOLVE_RESP_INFO *);
+					ASAPi_NRESOLVE_RESP_INFO *, uint16_t);
 static uint32_t asapi_getqueue_dec(NCS_UBAID *, ASAPi_GETQUEUE_INFO *);
 static uint32_t asapi_getqueue_resp_dec(NCS_UBAID *,
-					ASAPi_GETQUEUE_RESP_INFO *);
+					ASAPi_GETQUEUE_RESP_INFO *, uint16_t);
 static uint32_t asapi_track_dec(NCS_UBAID *, ASAPi_TRACK_INFO *);
-static uint32_t asapi_track_resp_dec(NCS_UBAID *, ASAPi_TRACK_RESP_INFO *);
-static uint32_t asapi_track_ntfy_dec(NCS_UBAID *, ASAPi_TRACK_NTFY_INFO *);
+static uint32_t asapi_track_resp_dec(NCS_UBAID *, ASAPi_TRACK_RESP_INFO *,
+				     uint16_t);
+static uint32_t asapi_track_ntfy_dec(NCS_UBAID *, ASAPi_TRACK_NTFY_INFO *,
+				     uint16_t);
+static uint32_t asapi_load_upd_dec(NCS_UBAID *, ASAPi_LOAD_UPD_INFO *);
 static uint32_t asapi_ginfo_dec(NCS_UBAID *, SaNameT *,
 				SaMsgQueueGroupPolicyT *);
-static uint32_t asapi_qinfo_dec(NCS_UBAID *, ASAPi_QUEUE_PARAM *);
+static uint32_t asapi_qinfo_dec(NCS_UBAID *, ASAPi_QUEUE_PARAM *, uint16_t);
 static uint32_t asapi_name_dec(NCS_UBAID *, SaNameT *);
 static uint32_t asapi_obj_info_dec(NCS_UBAID *, ASAPi_OBJECT_INFO *,
-				   ASAPi_ERR_INFO *);
+				   ASAPi_ERR_INFO *, uint16_t);
 /*****************************************************************************/
 
 /****************************************************************************\
@@ -69,13 +72,15 @@ static uint32_t asapi_obj_info_dec(NCS_UBAID *, ASAPi_OBJECT_INFO *,
 		     the ASAPi messages.
    ARGUMENTS      :  pBuff  - Data buffer
 		     o_pMsg - ASAPi Message
+		     msg_fmt_ver - Message format version of the sender
 
    RETURNS        :  SUCCESS - All went well
 		     FAILURE - internal processing didn't like something.
    NOTE           :  This decode routine is common for both, inter process
 		     decoding & inter card decoding.
 \****************************************************************************/
-uint32_t asapi_msg_dec(NCS_UBAID *pBuff, ASAPi_MSG_INFO **o_pMsg)
+uint32_t asapi_msg_dec(NCS_UBAID *pBuff, ASAPi_MSG_INFO **o_pMsg,
+		       uint16_t msg_fmt_ver)
 {
 	uint8_t *stream = 0;
 	uint8_t space[64]; /* sufficient space to decode data */
@@ -98,7 +103,7 @@ uint32_t asapi_msg_dec(NCS_UBAID *pBuff, ASAPi_MSG_INFO **o_pMsg)
 
 	if (ASAPi_MSG_REG == pMsg->msgtype) {
 		/* Decode ASAPi Registration message */
-		rc = asapi_reg_dec(pBuff, &pMsg->info.reg);
+		rc = asapi_reg_dec(pBuff, &pMsg->info.reg, msg_fmt_ver);
 	} else if (ASAPi_MSG_REG_RESP == pMsg->msgtype) {
 		/* Decode ASAPi Registration Response message */
 		rc = asapi_reg_resp_dec(pBuff, &pMsg->info.rresp);
@@ -113,22 +118,29 @@ uint32_t asapi_msg_dec(NCS_UBAID *pBuff, ASAPi_MSG_INFO **o_pMsg)
 		rc = asapi_nreslove_dec(pBuff, &pMsg->info.nresolve);
 	} else if (ASAPi_MSG_NRESOLVE_RESP == pMsg->msgtype) {
 		/* Decode Name Resolution Response message */
-		rc = asapi_nreslove_resp_dec(pBuff, &pMsg->info.nresp);
+		rc = asapi_nreslove_resp_dec(pBuff, &pMsg->info.nresp,
+					     msg_fmt_ver);
 	} else if (ASAPi_MSG_GETQUEUE == pMsg->msgtype) {
 		/* Decode ASAPi Getqueue queue message */
 		rc = asapi_getqueue_dec(pBuff, &pMsg->info.getqueue);
 	} else if (ASAPi_MSG_GETQUEUE_RESP == pMsg->msgtype) {
 		/* Decode ASAPi Getqueue Queue Response message */
-		rc = asapi_getqueue_resp_dec(pBuff, &pMsg->info.vresp);
+		rc = asapi_getqueue_resp_dec(pBuff, &pMsg->info.vresp,
+					     msg_fmt_ver);
 	} else if (ASAPi_MSG_TRACK == pMsg->msgtype) {
 		/* Decode ASAPi Track message */
 		rc = asapi_track_dec(pBuff, &pMsg->info.track);
 	} else if (ASAPi_MSG_TRACK_RESP == pMsg->msgtype) {
 		/* Decode ASAPi Track Response message */
-		rc = asapi_track_resp_dec(pBuff, &pMsg->info.tresp);
+		rc = asapi_track_resp_dec(pBuff, &pMsg->info.tresp,
+					  msg_fmt_ver);
 	} else if (ASAPi_MSG_TRACK_NTFY == pMsg->msgtype) {
 		/* Decode ASAPi Track Notification message */
-		rc = asapi_track_ntfy_dec(pBuff, &pMsg->info.tntfy);
+		rc = asapi_track_ntfy_dec(pBuff, &pMsg->info.tntfy,
+					  msg_fmt_ver);
+	} else if (ASAPi_MSG_LOAD_UPD == pMsg->msgtype) {
+		/* Decode ASAPi Load Update message */
+		rc = asapi_load_upd_dec(pBuff, &pMsg->info.lupd);
 	}
 
 	if (NCSCC_RC_SUCCESS != rc) {
@@ -151,7 +163,8 @@ uint32_t asapi_msg_dec(NCS_UBAID *pBuff, ASAPi_MSG_INFO **o_pMsg)
    RETURNS        :  SUCCESS - All went well
 		     FAILURE - internal processing didn't like something.
 \****************************************************************************/
-static uint32_t asapi_reg_dec(NCS_UBAID *pBuff, ASAPi_REG_INFO *msg)
+static uint32_t asapi_reg_dec(NCS_UBAID *pBuff, ASAPi_REG_INFO *msg,
+			      uint16_t msg_fmt_ver)
 {
 	uint8_t *stream = 0;
 	uint8_t space[64], flag = 0; /* sufficient space to decode data */
@@ -180,7 +193,7 @@ static uint32_t asapi_reg_dec(NCS_UBAID *pBuff, ASAPi_REG_INFO *msg)
 	}
 
 	/* Decode Queue Information */
-	rc = asapi_qinfo_dec(pBuff, &msg->queue);
+	rc = asapi_qinfo_dec(pBuff, &msg->queue, msg_fmt_ver);
 	if (NCSCC_RC_SUCCESS != rc) { /* Queue Information doesn't exist */
 		if (gflag) {
 			msg->objtype = ASAPi_OBJ_GROUP;
@@ -427,11 +440,12 @@ static uint32_t asapi_nreslove_dec(NCS_UBAID *pBuff, ASAPi_NRESOLVE_INFO *msg)
 		     FAILURE - internal processing didn't like something.
 \****************************************************************************/
 static uint32_t asapi_nreslove_resp_dec(NCS_UBAID *pBuff,
-					ASAPi_NRESOLVE_RESP_INFO *msg)
+					ASAPi_NRESOLVE_RESP_INFO *msg,
+					uint16_t msg_fmt_ver)
 {
 	uint32_t rc = NCSCC_RC_SUCCESS;
 
-	rc = asapi_obj_info_dec(pBuff, &msg->oinfo, &msg->err);
+	rc = asapi_obj_info_dec(pBuff, &msg->oinfo, &msg->err, msg_fmt_ver);
 	return rc;
 } /* End of asapi_nreslove_resp_dec() */
 
@@ -482,7 +496,8 @@ static uint32_t asapi_getqueue_dec(NCS_UBAID *pBuff, ASAPi_GETQUEUE_INFO *msg)
 		     FAILURE - internal processing didn't like something.
 \****************************************************************************/
 static uint32_t asapi_getqueue_resp_dec(NCS_UBAID *pBuff,
-					ASAPi_GETQUEUE_RESP_INFO *msg)
+					ASAPi_GETQUEUE_RESP_INFO *msg,
+					uint16_t msg_fmt_ver)
 {
 	uint8_t *stream = 0;
 	uint8_t space[64]; /* sufficient space to decode data */
@@ -504,7 +519,7 @@ static uint32_t asapi_getqueue_resp_dec(NCS_UBAID *pBuff,
 	}
 
 	/* Decode Queue Information */
-	asapi_qinfo_dec(pBuff, &msg->queue);
+	asapi_qinfo_dec(pBuff, &msg->queue, msg_fmt_ver);
 
 	/* Decode Error Information */
 	if (msg->err.flag) {
@@ -565,11 +580,13 @@ static uint32_t asapi_track_dec(NCS_UBAID *pBuff, ASAPi_TRACK_INFO *msg)
 		     FAILURE - internal processing didn't like something.
 \****************************************************************************/
 static uint32_t asapi_track_resp_dec(NCS_UBAID *pBuff,
-				     ASAPi_TRACK_RESP_INFO *tresp)
+				     ASAPi_TRACK_RESP_INFO *tresp,
+				     uint16_t msg_fmt_ver)
 {
 	uint32_t rc = NCSCC_RC_SUCCESS;
 
-	rc = asapi_obj_info_dec(pBuff, &tresp->oinfo, &tresp->err);
+	rc = asapi_obj_info_dec(pBuff, &tresp->oinfo, &tresp->err,
+				msg_fmt_ver);
 	return rc;
 } /* End of asapi_track_resp_dec() */
 
@@ -585,7 +602,7 @@ static uint32_t asapi_track_resp_dec(NCS_UBAID *pBuff,
 		     FAILURE - internal processing didn't like something.
 \****************************************************************************/
 static uint32_t asapi_obj_info_dec(NCS_UBAID *pBuff, ASAPi_OBJECT_INFO *info,
-				   ASAPi_ERR_INFO *err)
+				   ASAPi_ERR_INFO *err, uint16_t msg_fmt_ver)
 {
 	uint8_t *stream = 0;
 	uint8_t space[64]; /* sufficient space to decode data */
@@ -626,7 +643,8 @@ static uint32_t asapi_obj_info_dec(NCS_UBAID *pBuff, ASAPi_OBJECT_INFO *info,
 
 		for (idx = 0; idx < info->qcnt; idx++) {
 			/* Decode Queue Information */
-			asapi_qinfo_dec(pBuff, &info->qparam[idx]);
+			asapi_qinfo_dec(pBuff, &info->qparam[idx],
+					msg_fmt_ver);
 		}
 	}
 
@@ -653,7 +671,8 @@ static uint32_t asapi_obj_info_dec(NCS_UBAID *pBuff, ASAPi_OBJECT_INFO *info,
 		     FAILURE - internal processing didn't like something.
 \****************************************************************************/
 static uint32_t asapi_track_ntfy_dec(NCS_UBAID *pBuff,
-				     ASAPi_TRACK_NTFY_INFO *msg)
+				     ASAPi_TRACK_NTFY_INFO *msg,
+				     uint16_t msg_fmt_ver)
 {
 	uint8_t *stream = 0;
 	uint8_t space[64], flag = 0; /* sufficient space to decode data */
@@ -699,13 +718,74 @@ static uint32_t asapi_track_ntfy_dec(NCS_UBAID *pBuff,
 
 		for (idx = 0; idx < msg->oinfo.qcnt; idx++) {
 			/* Decode Queue Information */
-			asapi_qinfo_dec(pBuff, &msg->oinfo.qparam[idx]);
+			asapi_qinfo_dec(pBuff, &msg->oinfo.qparam[idx],
+					msg_fmt_ver);
 		}
 	}
 
 	return rc;
 } /* End of asapi_track_ntfy_dec() */
 
+/****************************************************************************\
+   PROCEDURE NAME :  asapi_load_upd_dec
+
+   DESCRIPTION    :  Routine to decode ASAPi Load Update message
+
+   ARGUMENTS      :  pBuff - Data buffer
+		     msg   - Load Update Message
+
+   RETURNS        :  SUCCESS - All went well
+		     FAILURE - internal processing didn't like something.
+\****************************************************************************/
+static uint32_t asapi_load_upd_dec(NCS_UBAID *pBuff, ASAPi_LOAD_UPD_INFO *msg)
+{
+	uint8_t *stream = 0;
+	uint8_t space[64]; /* sufficient space to decode data */
+	uint32_t rc = NCSCC_RC_SUCCESS;
+	uint16_t len = 0, idx = 0;
+
+	/* Skip the Null value */
+	ncs_dec_skip_space(pBuff, sizeof(uint8_t));
+
+	/* Decode message length */
+	stream = ncs_dec_flatten_space(pBuff, space, sizeof(len));
+	len = ncs_decode_16bit(&stream);
+	ncs_dec_skip_space(pBuff, sizeof(len));
+	if (!len) {
+		return m_ASAPi_DBG_SINK(
+		    NCSCC_RC_FAILURE); /* wrong message length */
+	}
+
+	/* Decode number of Queues */
+	stream = ncs_dec_flatten_space(pBuff, space, sizeof(msg->qcnt));
+	msg->qcnt = ncs_decode_16bit(&stream);
+	ncs_dec_skip_space(pBuff, sizeof(msg->qcnt));
+
+	if (msg->qcnt) {
+		msg->qload = m_MMGR_ALLOC_ASAPi_DEFAULT_VAL(
+		    msg->qcnt * sizeof(ASAPi_QUEUE_LOAD), asapi.my_svc_id);
+		if (!msg->qload) {
+			return m_ASAPi_DBG_SINK(NCSCC_RC_FAILURE);
+		}
+		memset(msg->qload, 0, msg->qcnt * sizeof(ASAPi_QUEUE_LOAD));
+
+		for (idx = 0; idx < msg->qcnt; idx++) {
+			/* Decode the Queue name & load */
+			rc = asapi_name_dec(pBuff, &msg->qload[idx].name);
+			if (NCSCC_RC_SUCCESS != rc) {
+				return m_ASAPi_DBG_SINK(rc);
+			}
+
+			stream = ncs_dec_flatten_space(
+			    pBuff, space, sizeof(msg->qload[idx].load));
+			msg->qload[idx].load = ncs_decode_32bit(&stream);
+			ncs_dec_skip_space(pBuff, sizeof(msg->qload[idx].load));
+		}
+	}
+
+	return rc;
+} /* End of asapi_load_upd_dec() */
+
 /****************************************************************************\
    PROCEDURE NAME :  asapi_ginfo_dec
 
@@ -755,11 +835,13 @@ static uint32_t asapi_ginfo_dec(NCS_UBAID *pBuff, SaNameT *group,
 
    ARGUMENTS      :  pBuff - Data buffer
 		     queue - Queue to decode
+		     msg_fmt_ver - Message format version of the sender
 
    RETURNS        :  SUCCESS - All went well
 		     FAILURE - internal processing didn't like something.
 \****************************************************************************/
-static uint32_t asapi_qinfo_dec(NCS_UBAID *pBuff, ASAPi_QUEUE_PARAM *queue)
+static uint32_t asapi_qinfo_dec(NCS_UBAID *pBuff, ASAPi_QUEUE_PARAM *queue,
+				uint16_t msg_fmt_ver)
 {
 	uint8_t *stream = 0;
 	uint8_t space[64]; /* sufficient space to decode data */
@@ -815,6 +897,14 @@ static uint32_t asapi_qinfo_dec(NCS_UBAID *pBuff, ASAPi_QUEUE_PARAM *queue)
 		ncs_dec_skip_space(pBuff, sizeof(queue->size[i]));
 	}
 
+	/* Decode load, not sent by older senders */
+	if (msg_fmt_ver >= ASAPi_MSG_FMT_LOAD) {
+		stream =
+		    ncs_dec_flatten_space(pBuff, space, sizeof(queue->load));
+		queue->load = ncs_decode_32bit(&stream);
+		ncs_dec_skip_space(pBuff, sizeof(queue->load));
+	}
+
 	return rc;
 } /* End of asapi_qinfo_dec() */
 
@@ -39,22 +39,27 @@ routine asapi_getqueue_enc.......ASAPi Getqueue Message Encode routine
 #include "msg/common/mqsv.h"
 
 /******************************** LOCAL ROUTINES *****************************/
-static void asapi_reg_enc(ASAPi_REG_INFO *, NCS_UBAID *);
+static void asapi_reg_enc(ASAPi_REG_INFO *, NCS_UBAID *, uint16_t);
 static void asapi_reg_resp_enc(ASAPi_REG_RESP_INFO *, NCS_UBAID *);
 static void asapi_dereg_enc(ASAPi_DEREG_INFO *, NCS_UBAID *);
 static void asapi_dereg_resp_enc(ASAPi_DEREG_RESP_INFO *, NCS_UBAID *);
 static void asapi_nreslove_enc(ASAPi_NRESOLVE_INFO *, NCS_UBAID *);
-static void asapi_nreslove_resp_enc(ASAPi_NRESOLVE_RESP_INFO *, NCS_UBAID *);
+static void asapi_nreslove_resp_enc(ASAPi_NRESOLVE_RESP_INFO *, NCS_UBAID *,
+				    uint16_t);
 static void asapi_getqueue_enc(ASAPi_GETQUEUE_INFO *, NCS_UBAID *);
-static void asapi_getqueue_resp_enc(ASAPi_GETQUEUE_RESP_INFO *, NCS_UBAID *);
+static void asapi_getqueue_resp_enc(ASAPi_GETQUEUE_RESP_INFO *, NCS_UBAID *,
+				    uint16_t);
 static void asapi_track_enc(ASAPi_TRACK_INFO *, NCS_UBAID *);
-static void asapi_track_resp_enc(ASAPi_TRACK_RESP_INFO *, NCS_UBAID *);
-static void asapi_track_ntfy_enc(ASAPi_TRACK_NTFY_INFO *, NCS_UBAID *);
+static void asapi_track_resp_enc(ASAPi_TRACK_RESP_INFO *, NCS_UBAID *,
+				 uint16_t);
+static void asapi_track_ntfy_enc(ASAPi_TRACK_NTFY_INFO *, NCS_UBAID *,
+				 uint16_t);
+static void asapi_load_upd_enc(ASAPi_LOAD_UPD_INFO *, NCS_UBAID *);
 static void asapi_ginfo_enc(SaNameT *, SaMsgQueueGroupPolicyT, NCS_UBAID *);
-static void asapi_qinfo_enc(ASAPi_QUEUE_PARAM *, NCS_UBAID *);
+static void asapi_qinfo_enc(ASAPi_QUEUE_PARAM *, NCS_UBAID *, uint16_t);
 static void asapi_name_enc(SaNameT *, NCS_UBAID *);
 static void asapi_obj_info_enc(ASAPi_OBJECT_INFO *, ASAPi_ERR_INFO *,
-			       NCS_UBAID *);
+			       NCS_UBAID *, uint16_t);
 /*****************************************************************************/
 
 /****************************************************************************\
@@ -67,13 +72,14 @@ static void asapi_obj_info_enc(ASAPi_OBJECT_INFO *, ASAPi_ERR_INFO *,
 
    ARGUMENTS      :  msg   - ASAPi Message
 		     pBuff - buffer
+		     msg_fmt_ver - Message format version of the receiver
 
    RETURNS        :  SUCCESS - All went well
 		     FAILURE - internal processing didn't like something.
    NOTE           :  This encode routine is common for both, inter process
 		     encoding & inter card encoding.
 \****************************************************************************/
-void asapi_msg_enc(ASAPi_MSG_INFO *msg, NCS_UBAID *pBuff)
+void asapi_msg_enc(ASAPi_MSG_INFO *msg, NCS_UBAID *pBuff, uint16_t msg_fmt_ver)
 {
 	uint8_t *pStream = 0;
 
@@ -84,7 +90,7 @@ void asapi_msg_enc(ASAPi_MSG_INFO *msg, NCS_UBAID *pBuff)
 
 	if (ASAPi_MSG_REG == msg->msgtype) {
 		/* Encode ASAPi Registration message */
-		asapi_reg_enc(&msg->info.reg, pBuff);
+		asapi_reg_enc(&msg->info.reg, pBuff, msg_fmt_ver);
 	} else if (ASAPi_MSG_REG_RESP == msg->msgtype) {
 		/* Encode ASAPi Registration Response message */
 		asapi_reg_resp_enc(&msg->info.rresp, pBuff);
@@ -99,22 +105,25 @@ void asapi_msg_enc(ASAPi_MSG_INFO *msg, NCS_UBAID *pBuff)
 		asapi_nreslove_enc(&msg->info.nresolve, pBuff);
 	} else if (ASAPi_MSG_NRESOLVE_RESP == msg->msgtype) {
 		/* Encode Name Resolution Response message */
-		asapi_nreslove_resp_enc(&msg->info.nresp, pBuff);
+		asapi_nreslove_resp_enc(&msg->info.nresp, pBuff, msg_fmt_ver);
 	} else if (ASAPi_MSG_GETQUEUE == msg->msgtype) {
 		/* Encode ASAPi Getqueue queue message */
 		asapi_getqueue_enc(&msg->info.getqueue, pBuff);
 	} else if (ASAPi_MSG_GETQUEUE_RESP == msg->msgtype) {
 		/* Encode ASAPi Getqueue Queue Response message */
-		asapi_getqueue_resp_enc(&msg->info.vresp, pBuff);
+		asapi_getqueue_resp_enc(&msg->info.vresp, pBuff, msg_fmt_ver);
 	} else if (ASAPi_MSG_TRACK == msg->msgtype) {
 		/* Encode ASAPi Track message */
 		asapi_track_enc(&msg->info.track, pBuff);
 	} else if (ASAPi_MSG_TRACK_RESP == msg->msgtype) {
 		/* Encode ASAPi Track Response message */
-		asapi_track_resp_enc(&msg->info.tresp, pBuff);
+		asapi_track_resp_enc(&msg->info.tresp, pBuff, msg_fmt_ver);
 	} else if (ASAPi_MSG_TRACK_NTFY == msg->msgtype) {
 		/* Encode ASAPi Track Notification message */
-		asapi_track_ntfy_enc(&msg->info.tntfy, pBuff);
+		asapi_track_ntfy_enc(&msg->info.tntfy, pBuff, msg_fmt_ver);
+	} else if (ASAPi_MSG_LOAD_UPD == msg->msgtype) {
+		/* Encode ASAPi Load Update message */
+		asapi_load_upd_enc(&msg->info.lupd, pBuff);
 	}
 } /* End of asapi_msg_enc() */
 
@@ -128,7 +137,8 @@ void asapi_msg_enc(ASAPi_MSG_INFO *msg, NCS_UBAID *pBuff)
 
    RETURNS        :  Nothin
 \****************************************************************************/
-static void asapi_reg_enc(ASAPi_REG_INFO *msg, NCS_UBAID *pBuff)
+static void asapi_reg_enc(ASAPi_REG_INFO *msg, NCS_UBAID *pBuff,
+			  uint16_t msg_fmt_ver)
 {
 	uint8_t *pStream = 0, *pLength = 0;
 	int32_t ival = 0, fval = 0;
@@ -162,13 +172,13 @@ static void asapi_reg_enc(ASAPi_REG_INFO *msg, NCS_UBAID *pBuff)
 		ncs_enc_claim_space(pBuff, sizeof(uint16_t));
 
 		/* Encode Queue Information */
-		asapi_qinfo_enc(&msg->queue, pBuff);
+		asapi_qinfo_enc(&msg->queue, pBuff, msg_fmt_ver);
 	} else if (ASAPi_OBJ_BOTH == msg->objtype) {
 		/* Encode Group Information */
 		asapi_ginfo_enc(&msg->group, msg->policy, pBuff);
 
 		/* Encode Queue Information */
-		asapi_qinfo_enc(&msg->queue, pBuff);
+		asapi_qinfo_enc(&msg->queue, pBuff, msg_fmt_ver);
 	}
 
 	/* OK we are alll set with encoding all the required params,
@@ -423,9 +433,9 @@ static void asapi_nreslove_enc(ASAPi_NRESOLVE_INFO *msg, NCS_UBAID *pBuff)
    RETURNS        :  Nothin
 \****************************************************************************/
 static void asapi_nreslove_resp_enc(ASAPi_NRESOLVE_RESP_INFO *msg,
-				    NCS_UBAID *pBuff)
+				    NCS_UBAID *pBuff, uint16_t msg_fmt_ver)
 {
-	asapi_obj_info_enc(&msg->oinfo, &msg->err, pBuff);
+	asapi_obj_info_enc(&msg->oinfo, &msg->err, pBuff, msg_fmt_ver);
 } /* End of asapi_nreslove_resp_enc() */
 
 /****************************************************************************\
@@ -478,7 +488,7 @@ static void asapi_getqueue_enc(ASAPi_GETQUEUE_INFO *msg, NCS_UBAID *pBuff)
    RETURNS        :  Nothin
 \****************************************************************************/
 static void asapi_getqueue_resp_enc(ASAPi_GETQUEUE_RESP_INFO *msg,
-				    NCS_UBAID *pBuff)
+				    NCS_UBAID *pBuff, uint16_t msg_fmt_ver)
 {
 	uint8_t *pStream = 0, *pLength = 0;
 	int32_t ival = 0, fval = 0;
@@ -498,7 +508,7 @@ static void asapi_getqueue_resp_enc(ASAPi_GETQUEUE_RESP_INFO *msg,
 	ncs_enc_claim_space(pBuff, sizeof(uint16_t));
 
 	/* Encode Queue information */
-	asapi_qinfo_enc(&msg->queue, pBuff);
+	asapi_qinfo_enc(&msg->queue, pBuff, msg_fmt_ver);
 
 	/* Encode error description (optional) */
 	if (msg->err.flag) {
@@ -565,9 +575,10 @@ static void asapi_track_enc(ASAPi_TRACK_INFO *msg, NCS_UBAID *pBuff)
 
    RETURNS        :  Nothin
 \****************************************************************************/
-static void asapi_track_resp_enc(ASAPi_TRACK_RESP_INFO *msg, NCS_UBAID *pBuff)
+static void asapi_track_resp_enc(ASAPi_TRACK_RESP_INFO *msg, NCS_UBAID *pBuff,
+				 uint16_t msg_fmt_ver)
 {
-	asapi_obj_info_enc(&msg->oinfo, &msg->err, pBuff);
+	asapi_obj_info_enc(&msg->oinfo, &msg->err, pBuff, msg_fmt_ver);
 } /* End of asapi_track_resp_enc() */
 
 /****************************************************************************\
@@ -582,7 +593,7 @@ static void asapi_track_resp_enc(ASAPi_TRACK_RESP_INFO *msg, NCS_UBAID *pBuff)
    RETURNS        :  Nothin
 \****************************************************************************/
 static void asapi_obj_info_enc(ASAPi_OBJECT_INFO *info, ASAPi_ERR_INFO *err,
-			       NCS_UBAID *pBuff)
+			       NCS_UBAID *pBuff, uint16_t msg_fmt_ver)
 {
 	uint8_t *pStream = 0, *pLength = 0;
 	uint16_t idx = 0;
@@ -612,7 +623,7 @@ static void asapi_obj_info_enc(ASAPi_OBJECT_INFO *info, ASAPi_ERR_INFO *err,
 
 	/* Encode Queue information */
 	for (idx = 0; idx < info->qcnt; idx++) {
-		asapi_qinfo_enc(&info->qparam[idx], pBuff);
+		asapi_qinfo_enc(&info->qparam[idx], pBuff, msg_fmt_ver);
 	}
 
 	/* Encode error description (optional) */
@@ -640,7 +651,8 @@ static void asapi_obj_info_enc(ASAPi_OBJECT_INFO *info, ASAPi_ERR_INFO *err,
 
    RETURNS        :  Nothin
 \****************************************************************************/
-static void asapi_track_ntfy_enc(ASAPi_TRACK_NTFY_INFO *msg, NCS_UBAID *pBuff)
+static void asapi_track_ntfy_enc(ASAPi_TRACK_NTFY_INFO *msg, NCS_UBAID *pBuff,
+				 uint16_t msg_fmt_ver)
 {
 	uint8_t *pStream = 0, *pLength = 0;
 	uint16_t idx = 0;
@@ -675,7 +687,8 @@ static void asapi_track_ntfy_enc(ASAPi_TRACK_NTFY_INFO *msg, NCS_UBAID *pBuff)
 
 	/* Encode Queue information */
 	for (idx = 0; idx < msg->oinfo.qcnt; idx++) {
-		asapi_qinfo_enc(&msg->oinfo.qparam[idx], pBuff);
+		asapi_qinfo_enc(&msg->oinfo.qparam[idx], pBuff,
+					msg_fmt_ver);
 	}
 
 	/* OK we are alll set with encoding all the required params,
@@ -685,6 +698,58 @@ static void asapi_track_ntfy_enc(ASAPi_TRACK_NTFY_INFO *msg, NCS_UBAID *pBuff)
 	ncs_encode_16bit(&pLength, ((uint16_t)(fval - ival)));
 } /* End of asapi_track_ntfy_enc() */
 
+/****************************************************************************\
+   PROCEDURE NAME :  asapi_load_upd_enc
+
+   DESCRIPTION    :  Routine to encode ASAPi Load Update message
+
+   ARGUMENTS      :  msg   - Load Update Message
+		     pBuff - Data buffer
+
+   RETURNS        :  Nothin
+\****************************************************************************/
+static void asapi_load_upd_enc(ASAPi_LOAD_UPD_INFO *msg, NCS_UBAID *pBuff)
+{
+	uint8_t *pStream = 0, *pLength = 0;
+	uint16_t idx = 0;
+	int32_t ival = 0, fval = 0;
+
+	ival = pBuff->ttl - sizeof(uint8_t); /* Store the current TTL value */
+
+	/* Encode Null value */
+	pStream = ncs_enc_reserve_space(pBuff, sizeof(uint8_t));
+	ncs_encode_8bit(&pStream, 0);
+	ncs_enc_claim_space(pBuff, sizeof(uint8_t));
+
+	/* Encode Total Length of the Message */
+	pStream = ncs_enc_reserve_space(pBuff, sizeof(uint16_t));
+	pLength = pStream;
+	/* As of now encode 0 coz we donno the total length of the msg yet */
+	ncs_encode_16bit(&pStream, 0);
+	ncs_enc_claim_space(pBuff, sizeof(uint16_t));
+
+	/* Encode number of Queues */
+	pStream = ncs_enc_reserve_space(pBuff, sizeof(msg->qcnt));
+	ncs_encode_16bit(&pStream, msg->qcnt);
+	ncs_enc_claim_space(pBuff, sizeof(msg->qcnt));
+
+	/* Encode the Queue name & load */
+	for (idx = 0; idx < msg->qcnt; idx++) {
+		asapi_name_enc(&msg->qload[idx].name, pBuff);
+
+		pStream =
+		    ncs_enc_reserve_space(pBuff, sizeof(msg->qload[idx].load));
+		ncs_encode_32bit(&pStream, msg->qload[idx].load);
+		ncs_enc_claim_space(pBuff, sizeof(msg->qload[idx].load));
+	}
+
+	/* OK we are alll set with encoding all the required params,
+	   Now encode the total length of the Load Update message
+	 */
+	fval += pBuff->ttl;
+	ncs_encode_16bit(&pLength, ((uint16_t)(fval - ival)));
+} /* End of asapi_load_upd_enc() */
+
 /****************************************************************************\
    PROCEDURE NAME :  asapi_ginfo_enc
 
@@ -727,10 +792,12 @@ static void asapi_ginfo_enc(SaNameT *group, SaMsgQueueGroupPolicyT policy,
 
    ARGUMENTS      :  queue - Queue to encode
 		     pBuff - Data buffer
+		     msg_fmt_ver - Message format version of the receiver
 
    RETURNS        :  none
 \****************************************************************************/
-static void asapi_qinfo_enc(ASAPi_QUEUE_PARAM *queue, NCS_UBAID *pBuff)
+static void asapi_qinfo_enc(ASAPi_QUEUE_PARAM *queue, NCS_UBAID *pBuff,
+			    uint16_t msg_fmt_ver)
 {
 	uint8_t *pStream = 0;
 	uint32_t i;
@@ -781,6 +848,14 @@ static void asapi_qinfo_enc(ASAPi_QUEUE_PARAM *queue, NCS_UBAID *pBuff)
 			ncs_encode_64bit(&pStream, queue->size[i]);
 			ncs_enc_claim_space(pBuff, sizeof(queue->size[i]));
 		}
+
+		/* Encode load, not known by older receivers */
+		if (msg_fmt_ver >= ASAPi_MSG_FMT_LOAD) {
+			pStream =
+			    ncs_enc_reserve_space(pBuff, sizeof(queue->load));
+			ncs_encode_32bit(&pStream, queue->load);
+			ncs_enc_claim_space(pBuff, sizeof(queue->load));
+		}
 	}
 } /* End of asapi_qinfo_enc() */
 
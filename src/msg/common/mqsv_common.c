@@ -64,36 +64,10 @@ uint32_t mqsv_listenerq_msg_send(SaMsgQueueHandleT listenerHandle)
 {
 	NCS_OS_POSIX_MQ_REQ_INFO info;
 	NCS_OS_MQ_MSG mq_msg;
-	uint32_t actual_qsize = 0, actual_qused = 0;
 	/* No listener queue present, return */
 	if (!listenerHandle)
 		return NCSCC_RC_SUCCESS;
 
-	/* Get actual queue size and usage stats. This is needed to determine if
-	 * queue size needs to be increased */
-	memset(&info, 0, sizeof(NCS_OS_POSIX_MQ_REQ_INFO));
-	info.req = NCS_OS_POSIX_MQ_REQ_GET_ATTR;
-	info.info.attr.i_mqd = listenerHandle;
-
-	if (m_NCS_OS_POSIX_MQ(&info) != NCSCC_RC_SUCCESS)
-		return NCSCC_RC_FAILURE;
-
-	actual_qsize = info.info.attr.o_attr.mq_maxmsg;
-	actual_qused = info.info.attr.o_attr.mq_msgsize;
-
-	if ((actual_qsize - actual_qused) < 1000) {
-		memset(&info, 0, sizeof(NCS_OS_POSIX_MQ_REQ_INFO));
-		info.req = NCS_OS_POSIX_MQ_REQ_RESIZE;
-		info.info.resize.mqd = listenerHandle;
-
-		/* Increase queue size so that its able to hold 5 such messages
-		 */
-		info.info.resize.i_newqsize = actual_qsize + 10000;
-
-		if (m_NCS_OS_POSIX_MQ(&info) != NCSCC_RC_SUCCESS)
-			return NCSCC_RC_FAILURE;
-	}
-
 	memset(&mq_msg, 0, sizeof(NCS_OS_MQ_MSG));
 	memcpy(mq_msg.data, "A", 1);
 
@@ -104,7 +78,7 @@ uint32_t mqsv_listenerq_msg_send(SaMsgQueueHandleT listenerHandle)
 	info.info.send.i_msg = &mq_msg;
 	info.info.send.i_mtype = 1;
 
-	if (m_NCS_OS_POSIX_MQ(&info) != NCSCC_RC_SUCCESS)
+	if (m_MQSV_SHM_MQ(&info) != NCSCC_RC_SUCCESS)
 		return (NCSCC_RC_FAILURE);
 
 	return NCSCC_RC_SUCCESS;
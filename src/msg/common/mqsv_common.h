@@ -75,6 +75,26 @@ extern "C" {
 
 uint32_t machineEndianness(void);
 uint32_t mqsv_listenerq_msg_send(SaMsgQueueHandleT listenerhandle);
+
+/* Message queue primitives on shared memory queues, see posix.c */
+#define m_MQSV_SHM_MQ mqsv_shm_mq
+uint32_t mqsv_shm_mq(NCS_OS_POSIX_MQ_REQ_INFO* req);
+/* The space of the SAF priorities of a queue and the messages put directly
+ * into a queue by the senders on the node, see posix.c */
+uint32_t mqsv_shm_mq_direct_set(NCS_OS_POSIX_MQD hdl, bool enable,
+                                SaMsgQueueHandleT listener,
+                                const SaSizeT* size, SaSizeT max_msg_size);
+uint32_t mqsv_shm_mq_direct_send(NCS_OS_POSIX_MQ_REQ_MSG_SEND_INFO* send,
+                                 SaUint8T priority, SaSizeT size,
+                                 SaMsgQueueHandleT* listener);
+uint32_t mqsv_shm_mq_space_take(NCS_OS_POSIX_MQD hdl, SaUint8T priority,
+                                SaSizeT size, bool check);
+uint32_t mqsv_shm_mq_space_give(NCS_OS_POSIX_MQD hdl, SaUint8T priority,
+                                SaSizeT size, SaUint32T num_msgs);
+uint32_t mqsv_shm_mq_space_get(NCS_OS_POSIX_MQD hdl, SaSizeT* used,
+                               SaUint32T* num_msgs);
+uint32_t mqsv_shm_mq_space_reset(NCS_OS_POSIX_MQD hdl);
+void mqsv_shm_mq_group_set(gid_t gid);
 NCS_NODE_ID mqsv_get_node_id(MDS_DEST dest);
 typedef unsigned int MSG_FRMT_VER;
 
@@ -276,10 +276,13 @@ static uint32_t mqsv_edp_asapi_info(EDU_HDL *hdl, EDU_TKN *edu_tkn,
 {
 	uint32_t rc = NCSCC_RC_SUCCESS;
 
+	/* The message format version is given to m_NCS_EDU_VER_EXEC() */
 	if (EDP_OP_TYPE_ENC == op) {
-		asapi_msg_enc((ASAPi_MSG_INFO *)ptr, buf_env->info.uba);
+		asapi_msg_enc((ASAPi_MSG_INFO *)ptr, buf_env->info.uba,
+			      hdl->to_version);
 	} else if (op == EDP_OP_TYPE_DEC) {
-		rc = asapi_msg_dec(buf_env->info.uba, (ASAPi_MSG_INFO **)ptr);
+		rc = asapi_msg_dec(buf_env->info.uba, (ASAPi_MSG_INFO **)ptr,
+				   hdl->to_version);
 	}
 
 	return rc;
@@ -66,7 +66,10 @@ typedef enum mqp_req_type {
   MQP_EVT_CAP_SET_REQ,
   MQP_EVT_CAP_GET_REQ,
   MQP_EVT_MDATA_GET_REQ,
-  MQP_EVT_LIMIT_GET_REQ
+  MQP_EVT_LIMIT_GET_REQ,
+  MQP_EVT_SEND_MSG_LOCAL, /* Notification of a message put by MQA */
+  MQP_EVT_SEND_MSG_BATCH,
+  MQP_EVT_STAT_UPD_BATCH_REQ
 } MQP_REQ_TYPE;
 
 /* Enums for MQP Message Types */
@@ -89,7 +92,8 @@ typedef enum mqp_rsp_type {
   MQP_EVT_CAP_SET_RSP,
   MQP_EVT_CAP_GET_RSP,
   MQP_EVT_MDATA_GET_RSP,
-  MQP_EVT_LIMIT_GET_RSP
+  MQP_EVT_LIMIT_GET_RSP,
+  MQP_EVT_SEND_MSG_BATCH_RSP
 } MQP_RSP_TYPE;
 
 /* Enums for MQD messages */
@@ -340,6 +344,26 @@ typedef struct mqp_send_msg_async {
   MQP_SEND_MSG SendMsg;
 } MQP_SEND_MSG_ASYNC;
 
+/* Structure used by MQA to send several messages to a Queue sitting on MQND,
+ * the messages follow the event as QUEUE_MESSAGE records of
+ * m_MQSV_BATCH_MSG_SIZE() bytes */
+typedef struct mqp_send_msg_batch {
+  SaMsgHandleT msgHandle; /* Application Hdl */
+  SaMsgQueueHandleT queueHandle;
+  SaUint32T numberOfMessages;
+  uint32_t padding;
+} MQP_SEND_MSG_BATCH;
+
+#define m_MQSV_BATCH_MSG_SIZE(size) \
+  ((offsetof(QUEUE_MESSAGE, data) + (size) + 7) & ~(SaSizeT)7)
+
+/* Structure used by MQND to ack the delivery of a batch of messages, the
+ * status of each message follows the event as an array of SaAisErrorT */
+typedef struct mqp_send_msg_batch_rsp {
+  SaAisErrorT error;
+  SaUint32T numberOfMessages;
+} MQP_SEND_MSG_BATCH_RSP;
+
 /* Structure used by MQSV to ack the delivery of the sent message to MQA in Sync
  * send */
 typedef struct mqsv_send_msg_rsp {
@@ -372,6 +396,12 @@ typedef struct mqp_update_stats {
   uint32_t size;
 } MQP_UPDATE_STATS;
 
+typedef struct mqp_update_stats_batch {
+  SaMsgQueueHandleT qhdl;
+  SaSizeT size[SA_MSG_MESSAGE_LOWEST_PRIORITY + 1];
+  uint32_t numberOfMessages[SA_MSG_MESSAGE_LOWEST_PRIORITY + 1];
+} MQP_UPDATE_STATS_BATCH;
+
 typedef struct mqp_stats_rsp {
   uint32_t dummy;
 } MQP_STATS_RSP;
@@ -638,6 +668,9 @@ typedef struct mqsv_direct_send_event {
     MQP_QUEUE_REPLY_MSG_ASYNC replyAsyncMsg;
     MQP_UPDATE_STATS statsReq;
     MQP_SEND_MSG_RSP sendMsgRsp;
+    MQP_SEND_MSG_BATCH sndMsgBatch;
+    MQP_SEND_MSG_BATCH_RSP sendBatchRsp;
+    MQP_UPDATE_STATS_BATCH statsBatchReq;
   } info;
 } MQSV_DSEND_EVT;
 
@@ -0,0 +1,101 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+/*****************************************************************************
+  DESCRIPTION:
+
+  Layout of the shared memory message queues of MQSv, see posix.c.
+******************************************************************************
+*/
+#ifndef MSG_COMMON_MQSV_SHM_MQ_H_
+#define MSG_COMMON_MQSV_SHM_MQ_H_
+
+#include <pthread.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MQSV_SHM_MQ_MAGIC 0x4d515356
+#define MQSV_SHM_MQ_NUM_LANES 6
+/* The SAF priorities, sent with the message types 3 to 6 */
+#define MQSV_SHM_MQ_NUM_PRIOS 4
+#define MQSV_SHM_MQ_MIN_LANE_SIZE 4096
+#define MQSV_SHM_MQ_NAME_SIZE 64
+#define MQSV_SHM_MQ_NAME_FORMAT "/opensaf_MQSV_QUEUE_%u"
+/* Shared memory object holding the last queue handle allocated on the node */
+#define MQSV_SHM_MQ_HDL_NAME "/opensaf_MQSV_QUEUE_HDL"
+/* The agents take the lock of a queue and move its head when they receive,
+ * so they need write access, unlike msgrcv() on the kernel message queues.
+ * The queues are writable by all local users unless a queue group is set,
+ * see mqsv_shm_mq_group_set(). */
+#define MQSV_SHM_MQ_PROTECTION_FLAGS 0666
+#define MQSV_SHM_MQ_GROUP_PROTECTION_FLAGS 0660
+/* The handle counter is only written by MQND */
+#define MQSV_SHM_MQ_HDL_PROTECTION_FLAGS 0644
+
+/* The ring of one message type. A message is stored with a 4 byte length
+ * and padded to 8 bytes. head and tail are the positions of the oldest
+ * message and after the newest message, counted in bytes since the ring was
+ * laid out, i.e. the ring holds tail - head bytes. A send is committed by
+ * the store of tail and a receive by the store of head. */
+typedef struct mqsv_shm_mq_lane {
+  uint64_t offset; /* Of the ring in the data area */
+  uint64_t capacity;
+  uint64_t head;
+  uint64_t tail;
+  uint32_t num_msgs;
+  uint32_t reserved;
+} MQSV_SHM_MQ_LANE;
+
+/* The space of one SAF priority. used and num_msgs count the messages put
+ * into the queue and not yet given back by MQND, see posix.c. */
+typedef struct mqsv_shm_mq_space {
+  uint64_t size;
+  uint64_t used;
+  uint32_t num_msgs;
+  uint32_t reserved;
+} MQSV_SHM_MQ_SPACE;
+
+/* The control area at the start of the shared memory object. The data area
+ * of data_size bytes follows at the next page boundary. */
+typedef struct mqsv_shm_mq_ctl {
+  uint32_t magic;
+  uint32_t destroyed;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  uint32_t num_waiters;
+  /* Set while the rings are laid out again when a lane is grown */
+  uint32_t growing;
+  /* Set when the owner of the lock died, the rings are checked */
+  uint32_t recover;
+  uint32_t reserved;
+  uint64_t data_size;
+  MQSV_SHM_MQ_LANE lane[MQSV_SHM_MQ_NUM_LANES];
+  /* Set by MQND while the senders on the node may put messages directly
+   * into the queue, with the listener queue to wake up */
+  uint32_t direct;
+  uint32_t reserved2;
+  uint64_t listener;
+  uint64_t max_msg_size;
+  MQSV_SHM_MQ_SPACE space[MQSV_SHM_MQ_NUM_PRIOS];
+} MQSV_SHM_MQ_CTL;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MSG_COMMON_MQSV_SHM_MQ_H_
@@ -17,11 +17,33 @@
 
 /***************************************************************************
  *
- * uint32_t ncs_os_posix_mq(NCS_OS_POSIX_MQ_REQ_INFO *req)
+ * uint32_t mqsv_shm_mq(NCS_OS_POSIX_MQ_REQ_INFO *req)
  *
  *
  * Description:
- *   This routine handles operating system primitives for message-queues.
+ *   This routine handles the message-queue primitives of MQSv. It takes the
+ *   same requests as m_MQSV_SHM_MQ() but the queues are kept in POSIX
+ *   shared memory instead of kernel message queues, so they are not limited
+ *   by msgmnb and a message is sent and received without a system call.
+ *
+ *   A queue is a shared memory object with a control area, holding a
+ *   process shared (robust) mutex and condition variable, followed by the
+ *   data area holding one ring of messages per message type (lane). The
+ *   message types are the ones used with the kernel message queues: 1 for
+ *   the control messages, 2 for the messages put back by saMsgMessageGet and
+ *   3 to 6 for the SAF priorities 0 to 3. A lane which is full is grown, the
+ *   processes mapping the queue remap the data area when they see that its
+ *   size has changed. A send and a receive are committed by one store, so
+ *   that a queue can be rebuilt if a process dies while holding the mutex.
+ *   The control area also holds the space of the SAF priorities, which MQND
+ *   accounts for when it puts a message and when a message is received. A
+ *   sender on the node puts a message directly into a queue owned on the
+ *   node, mqsv_shm_mq_direct_send() checks it and accounts for it under the
+ *   mutex, as MQND does.
+ *   The control area is checked each time the mutex is taken. The queue
+ *   handle is the number in the name of the shared memory object, allocated
+ *   from a counter in shared memory. The queues are mapped on first use and
+ *   the mappings are cached per process. See mqsv_shm_mq.h for the layout.
  *
  * Synopsis:
  *
@@ -32,6 +54,1080 @@
  *   Returns NCSCC_RC_SUCCESS if successful, otherwise NCSCC_RC_FAILURE.
  *
  * Notes:
+ *   NCS_OS_POSIX_MQ_REQ_OPEN only creates a new queue, i.e. O_CREAT shall be
+ *   set, and mq_msgsize gives the initial size of the lanes of the SAF
+ *   priorities. NCS_OS_POSIX_MQ_REQ_CLOSE destroys the queue. A receive with
+ *   message type 0 returns the message of the lowest message type.
  *
  ****************************************************************************/
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "msg/common/mqsv.h"
+#include "msg/common/mqsv_shm_mq.h"
+#include "base/logtrace.h"
+#include "base/ncspatricia.h"
+
+/* The mapping of a queue in this process */
+typedef struct mqsv_shm_mq {
+	NCS_PATRICIA_NODE node;
+	NCS_OS_POSIX_MQD hdl;
+	uint32_t ref_count;
+	bool in_tree;
+	MQSV_SHM_MQ_CTL *ctl;
+	uint8_t *data;
+	uint64_t data_size;
+} MQSV_SHM_MQ;
+
+static pthread_mutex_t shm_mq_lock = PTHREAD_MUTEX_INITIALIZER;
+static NCS_PATRICIA_TREE shm_mq_tree;
+static bool shm_mq_tree_up = false;
+/* The last queue handle allocated on the node, see shm_mq_alloc_hdl() */
+static NCS_OS_POSIX_MQD *shm_mq_last_hdl = NULL;
+/* The group owning the queues created by this process, -1 for none */
+static gid_t shm_mq_gid = (gid_t)-1;
+
+/* Messages are stored with a 4 byte length and padded to 8 bytes */
+static uint64_t shm_mq_msg_size(uint32_t len)
+{
+	return (sizeof(uint32_t) + len + 7) & ~(uint64_t)7;
+}
+
+static size_t shm_mq_ctl_size(void)
+{
+	size_t page_size = sysconf(_SC_PAGESIZE);
+
+	return (sizeof(MQSV_SHM_MQ_CTL) + page_size - 1) & ~(page_size - 1);
+}
+
+static void shm_mq_name(NCS_OS_POSIX_MQD hdl, char *name)
+{
+	snprintf(name, MQSV_SHM_MQ_NAME_SIZE, MQSV_SHM_MQ_NAME_FORMAT, hdl);
+}
+
+/*
+ * The lock and the condition variable are robust. If the owner of the lock
+ * died, maybe in the middle of an update, the rings are checked before they
+ * are used again, see shm_mq_recover().
+ */
+static int shm_mq_ctl_lock(MQSV_SHM_MQ_CTL *ctl)
+{
+	int rc = pthread_mutex_lock(&ctl->lock);
+
+	if (rc == EOWNERDEAD) {
+		ctl->recover = true;
+		rc = pthread_mutex_consistent(&ctl->lock);
+	}
+	return rc;
+}
+
+static int shm_mq_ctl_wait(MQSV_SHM_MQ_CTL *ctl)
+{
+	int rc = pthread_cond_wait(&ctl->cond, &ctl->lock);
+
+	if (rc == EOWNERDEAD) {
+		ctl->recover = true;
+		rc = pthread_mutex_consistent(&ctl->lock);
+	}
+	return rc;
+}
+
+static void shm_mq_ring_write(uint8_t *ring, uint64_t capacity, uint64_t pos,
+			      const void *src, uint64_t len)
+{
+	uint64_t first = capacity - pos;
+
+	if (len <= first) {
+		memcpy(ring + pos, src, len);
+	} else {
+		memcpy(ring + pos, src, first);
+		memcpy(ring, (const uint8_t *)src + first, len - first);
+	}
+}
+
+static void shm_mq_ring_read(const uint8_t *ring, uint64_t capacity,
+			     uint64_t pos, void *dst, uint64_t len)
+{
+	uint64_t first = capacity - pos;
+
+	if (len <= first) {
+		memcpy(dst, ring + pos, len);
+	} else {
+		memcpy(dst, ring + pos, first);
+		memcpy((uint8_t *)dst + first, ring, len - first);
+	}
+}
+
+/* The length of the message at @a pos in the lane */
+static uint32_t shm_mq_msg_len(const MQSV_SHM_MQ *mq,
+			       const MQSV_SHM_MQ_LANE *lane, uint64_t pos)
+{
+	uint32_t len;
+
+	shm_mq_ring_read(mq->data + lane->offset, lane->capacity,
+			 pos % lane->capacity, &len, sizeof(len));
+	return len;
+}
+
+/****************************************************************************
+ * Name          : shm_mq_map_data
+ *
+ * Description   : Map the data area of the queue again, after it has been
+ *                 grown by this or another process. If @a extend is true,
+ *                 the shared memory object is extended to hold @a data_size
+ *                 bytes of data, otherwise it shall already do so. Called
+ *                 with the lock of the queue taken.
+ *
+ * Return Values : NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE
+ ****************************************************************************/
+static uint32_t shm_mq_map_data(MQSV_SHM_MQ *mq, uint64_t data_size,
+				bool extend)
+{
+	char name[MQSV_SHM_MQ_NAME_SIZE];
+	struct stat st;
+	uint8_t *data;
+	int fd;
+
+	shm_mq_name(mq->hdl, name);
+	fd = shm_open(name, O_RDWR, 0);
+	if (fd < 0) {
+		TRACE_4("shm_open of %s failed: %s", name, strerror(errno));
+		return NCSCC_RC_FAILURE;
+	}
+	if (extend) {
+		if (ftruncate(fd, shm_mq_ctl_size() + data_size) < 0) {
+			TRACE_4("ftruncate of %s failed: %s", name,
+				strerror(errno));
+			close(fd);
+			return NCSCC_RC_FAILURE;
+		}
+	} else if ((fstat(fd, &st) < 0) ||
+		   ((uint64_t)st.st_size < shm_mq_ctl_size() + data_size)) {
+		/* The data size in the control area is not valid */
+		LOG_ER("Queue %u: data area of %" PRIu64 " bytes not found",
+		       mq->hdl, data_size);
+		close(fd);
+		return NCSCC_RC_FAILURE;
+	}
+	data = mmap(NULL, data_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+		    shm_mq_ctl_size());
+	close(fd);
+	if (data == MAP_FAILED) {
+		TRACE_4("mmap of %s failed: %s", name, strerror(errno));
+		return NCSCC_RC_FAILURE;
+	}
+	if (mq->data != NULL)
+		munmap(mq->data, mq->data_size);
+	mq->data = data;
+	mq->data_size = data_size;
+	return NCSCC_RC_SUCCESS;
+}
+
+/*
+ * True if the rings lie within the mapped data area and their positions are
+ * consistent, so that they can be accessed. The control area is writable by
+ * every process using the queue, it is checked each time the lock is taken.
+ */
+static bool shm_mq_check(const MQSV_SHM_MQ *mq)
+{
+	const MQSV_SHM_MQ_CTL *ctl = mq->ctl;
+	int l;
+
+	if (ctl->data_size != mq->data_size)
+		return false;
+	for (l = 0; l < MQSV_SHM_MQ_NUM_LANES; l++) {
+		const MQSV_SHM_MQ_LANE *lane = &ctl->lane[l];
+
+		if ((lane->capacity == 0) || (lane->offset > mq->data_size) ||
+		    (lane->capacity > mq->data_size - lane->offset) ||
+		    ((lane->offset | lane->capacity | lane->head | lane->tail) &
+		     7) ||
+		    (lane->tail - lane->head > lane->capacity))
+			return false;
+	}
+	return true;
+}
+
+/* Lay out empty rings of the same size in the data area, the space of the
+ * dropped messages is given back */
+static void shm_mq_reset(MQSV_SHM_MQ *mq)
+{
+	MQSV_SHM_MQ_CTL *ctl = mq->ctl;
+	uint64_t lane_size =
+	    (mq->data_size / MQSV_SHM_MQ_NUM_LANES) & ~(uint64_t)7;
+	int l;
+
+	for (l = 0; l < MQSV_SHM_MQ_NUM_LANES; l++) {
+		ctl->lane[l].offset = l * lane_size;
+		ctl->lane[l].capacity = lane_size;
+		ctl->lane[l].head = 0;
+		ctl->lane[l].tail = 0;
+		ctl->lane[l].num_msgs = 0;
+	}
+	for (l = 0; l < MQSV_SHM_MQ_NUM_PRIOS; l++) {
+		ctl->space[l].used = 0;
+		ctl->space[l].num_msgs = 0;
+	}
+	ctl->data_size = mq->data_size;
+	ctl->growing = false;
+}
+
+/****************************************************************************
+ * Name          : shm_mq_recover
+ *
+ * Description   : Rebuild the rings after the owner of the lock died. A send
+ *                 or a receive is committed by one store, so a ring is
+ *                 consistent and only its number of messages is counted
+ *                 again. A message with a length that does not fit, which
+ *                 cannot happen, ends the ring. If the rings were being laid
+ *                 out again by shm_mq_grow(), or are not valid, the messages
+ *                 are dropped.
+ ****************************************************************************/
+static void shm_mq_recover(MQSV_SHM_MQ *mq)
+{
+	MQSV_SHM_MQ_CTL *ctl = mq->ctl;
+	int l;
+
+	if (ctl->growing || !shm_mq_check(mq)) {
+		LOG_WA("Queue %u: a process died while updating the queue, "
+		       "its messages are dropped",
+		       mq->hdl);
+		shm_mq_reset(mq);
+	} else {
+		for (l = 0; l < MQSV_SHM_MQ_NUM_LANES; l++) {
+			MQSV_SHM_MQ_LANE *lane = &ctl->lane[l];
+			uint64_t pos = lane->head;
+			uint32_t num_msgs = 0;
+
+			while (pos != lane->tail) {
+				uint64_t size =
+				    shm_mq_msg_size(shm_mq_msg_len(mq, lane,
+								   pos));
+
+				if (size > lane->tail - pos) {
+					lane->tail = pos;
+					break;
+				}
+				pos += size;
+				num_msgs++;
+			}
+			lane->num_msgs = num_msgs;
+		}
+	}
+	ctl->recover = false;
+}
+
+/****************************************************************************
+ * Name          : shm_mq_sync
+ *
+ * Description   : Prepare the queue for use after its lock has been taken:
+ *                 map the data area again if it has been grown by another
+ *                 process, and check the rings, see shm_mq_check() and
+ *                 shm_mq_recover(). Rings that are not valid are laid out
+ *                 again, dropping their messages.
+ *
+ * Return Values : NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE, e.g. if the queue has
+ *                 been destroyed.
+ ****************************************************************************/
+static uint32_t shm_mq_sync(MQSV_SHM_MQ *mq)
+{
+	MQSV_SHM_MQ_CTL *ctl = mq->ctl;
+
+	if (ctl->destroyed)
+		return NCSCC_RC_FAILURE;
+	if ((mq->data_size != ctl->data_size) &&
+	    (shm_mq_map_data(mq, ctl->data_size, false) != NCSCC_RC_SUCCESS))
+		return NCSCC_RC_FAILURE;
+	if (ctl->recover) {
+		shm_mq_recover(mq);
+	} else if (!shm_mq_check(mq)) {
+		LOG_ER("Queue %u is corrupt, its messages are dropped",
+		       mq->hdl);
+		shm_mq_reset(mq);
+	}
+	return NCSCC_RC_SUCCESS;
+}
+
+/****************************************************************************
+ * Name          : shm_mq_grow
+ *
+ * Description   : Grow the lane @a l so that it holds at least @a size more
+ *                 bytes. The data area is extended and the rings are laid
+ *                 out again, with the oldest message of each ring first.
+ *                 Called with the lock of the queue taken and the rings
+ *                 checked.
+ *
+ * Return Values : NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE
+ ****************************************************************************/
+static uint32_t shm_mq_grow(MQSV_SHM_MQ *mq, int l, uint64_t size)
+{
+	MQSV_SHM_MQ_CTL *ctl = mq->ctl;
+	uint64_t capacity[MQSV_SHM_MQ_NUM_LANES];
+	uint64_t used[MQSV_SHM_MQ_NUM_LANES];
+	uint64_t data_size = 0;
+	uint64_t total = 0;
+	uint64_t offset;
+	uint8_t *save;
+	int i;
+
+	for (i = 0; i < MQSV_SHM_MQ_NUM_LANES; i++) {
+		capacity[i] = ctl->lane[i].capacity;
+		used[i] = ctl->lane[i].tail - ctl->lane[i].head;
+		total += used[i];
+	}
+	capacity[l] *= 2;
+	if (capacity[l] < used[l] + size)
+		capacity[l] = (used[l] + size + 7) & ~(uint64_t)7;
+	for (i = 0; i < MQSV_SHM_MQ_NUM_LANES; i++)
+		data_size += capacity[i];
+
+	save = malloc(total ? total : 1);
+	if (save == NULL) {
+		TRACE_4("Memory allocation failed");
+		return NCSCC_RC_FAILURE;
+	}
+	offset = 0;
+	for (i = 0; i < MQSV_SHM_MQ_NUM_LANES; i++) {
+		MQSV_SHM_MQ_LANE *lane = &ctl->lane[i];
+
+		shm_mq_ring_read(mq->data + lane->offset, lane->capacity,
+				 lane->head % lane->capacity, save + offset,
+				 used[i]);
+		offset += used[i];
+	}
+
+	if (shm_mq_map_data(mq, data_size, true) != NCSCC_RC_SUCCESS) {
+		free(save);
+		return NCSCC_RC_FAILURE;
+	}
+
+	/* The rings are overwritten, a process dying now loses the messages */
+	ctl->growing = true;
+	offset = 0;
+	total = 0;
+	for (i = 0; i < MQSV_SHM_MQ_NUM_LANES; i++) {
+		MQSV_SHM_MQ_LANE *lane = &ctl->lane[i];
+
+		memcpy(mq->data + offset, save + total, used[i]);
+		total += used[i];
+		lane->offset = offset;
+		lane->capacity = capacity[i];
+		lane->head = 0;
+		lane->tail = used[i];
+		offset += capacity[i];
+	}
+	ctl->data_size = data_size;
+	ctl->growing = false;
+	free(save);
+
+	TRACE("Queue %u lane %d grown to %" PRIu64 " bytes", mq->hdl, l + 1,
+	      capacity[l]);
+	return NCSCC_RC_SUCCESS;
+}
+
+static void shm_mq_unmap(MQSV_SHM_MQ *mq)
+{
+	if (mq->data != NULL)
+		munmap(mq->data, mq->data_size);
+	munmap(mq->ctl, shm_mq_ctl_size());
+	free(mq);
+}
+
+/* Called with shm_mq_lock taken */
+static uint32_t shm_mq_tree_add(MQSV_SHM_MQ *mq)
+{
+	if (!shm_mq_tree_up) {
+		NCS_PATRICIA_PARAMS param;
+
+		memset(&param, 0, sizeof(param));
+		param.key_size = sizeof(NCS_OS_POSIX_MQD);
+		if (ncs_patricia_tree_init(&shm_mq_tree, &param) !=
+		    NCSCC_RC_SUCCESS)
+			return NCSCC_RC_FAILURE;
+		shm_mq_tree_up = true;
+	}
+	mq->node.key_info = (uint8_t *)&mq->hdl;
+	if (ncs_patricia_tree_add(&shm_mq_tree, &mq->node) != NCSCC_RC_SUCCESS)
+		return NCSCC_RC_FAILURE;
+	mq->in_tree = true;
+	mq->ref_count++;
+	return NCSCC_RC_SUCCESS;
+}
+
+/* Called with shm_mq_lock taken */
+static void shm_mq_tree_del(MQSV_SHM_MQ *mq)
+{
+	if (!mq->in_tree)
+		return;
+	ncs_patricia_tree_del(&shm_mq_tree, &mq->node);
+	mq->in_tree = false;
+	if (--mq->ref_count == 0)
+		shm_mq_unmap(mq);
+}
+
+/****************************************************************************
+ * Name          : shm_mq_lock_queue
+ *
+ * Description   : Take the lock of the queue and prepare it for use, see
+ *                 shm_mq_sync().
+ *
+ * Return Values : NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE, the lock is not taken
+ *                 if the queue has been destroyed.
+ ****************************************************************************/
+static uint32_t shm_mq_lock_queue(MQSV_SHM_MQ *mq)
+{
+	if (shm_mq_ctl_lock(mq->ctl) != 0)
+		return NCSCC_RC_FAILURE;
+	if (shm_mq_sync(mq) != NCSCC_RC_SUCCESS) {
+		pthread_mutex_unlock(&mq->ctl->lock);
+		return NCSCC_RC_FAILURE;
+	}
+	return NCSCC_RC_SUCCESS;
+}
+
+/****************************************************************************
+ * Name          : shm_mq_get
+ *
+ * Description   : Return the mapping of the queue @a hdl, mapping the queue
+ *                 if it is not mapped by this process yet. A mapping of a
+ *                 destroyed queue is dropped. The mapping is released with
+ *                 shm_mq_put().
+ *
+ * Return Values : The mapping or NULL if the queue does not exist
+ ****************************************************************************/
+static MQSV_SHM_MQ *shm_mq_get(NCS_OS_POSIX_MQD hdl)
+{
+	char name[MQSV_SHM_MQ_NAME_SIZE];
+	MQSV_SHM_MQ *mq = NULL;
+	void *ctl;
+	int fd;
+
+	pthread_mutex_lock(&shm_mq_lock);
+	if (shm_mq_tree_up)
+		mq = (MQSV_SHM_MQ *)ncs_patricia_tree_get(&shm_mq_tree,
+							  (uint8_t *)&hdl);
+	if (mq != NULL) {
+		if (!mq->ctl->destroyed) {
+			mq->ref_count++;
+			pthread_mutex_unlock(&shm_mq_lock);
+			return mq;
+		}
+		shm_mq_tree_del(mq);
+	}
+
+	shm_mq_name(hdl, name);
+	fd = shm_open(name, O_RDWR, 0);
+	if (fd < 0) {
+		TRACE_4("shm_open of %s failed: %s", name, strerror(errno));
+		pthread_mutex_unlock(&shm_mq_lock);
+		return NULL;
+	}
+	ctl = mmap(NULL, shm_mq_ctl_size(), PROT_READ | PROT_WRITE, MAP_SHARED,
+		   fd, 0);
+	close(fd);
+	if (ctl == MAP_FAILED) {
+		TRACE_4("mmap of %s failed: %s", name, strerror(errno));
+		pthread_mutex_unlock(&shm_mq_lock);
+		return NULL;
+	}
+
+	mq = calloc(1, sizeof(MQSV_SHM_MQ));
+	if (mq == NULL) {
+		munmap(ctl, shm_mq_ctl_size());
+		pthread_mutex_unlock(&shm_mq_lock);
+		return NULL;
+	}
+	mq->hdl = hdl;
+	mq->ctl = ctl;
+	mq->ref_count = 1;
+
+	/* The queue is being created or has been destroyed */
+	if ((__atomic_load_n(&mq->ctl->magic, __ATOMIC_ACQUIRE) !=
+	     MQSV_SHM_MQ_MAGIC) ||
+	    mq->ctl->destroyed ||
+	    (shm_mq_lock_queue(mq) != NCSCC_RC_SUCCESS)) {
+		shm_mq_unmap(mq);
+		pthread_mutex_unlock(&shm_mq_lock);
+		return NULL;
+	}
+	pthread_mutex_unlock(&mq->ctl->lock);
+
+	if (shm_mq_tree_add(mq) != NCSCC_RC_SUCCESS)
+		TRACE_4("Caching the mapping of queue %u failed", hdl);
+	pthread_mutex_unlock(&shm_mq_lock);
+	return mq;
+}
+
+static void shm_mq_put(MQSV_SHM_MQ *mq)
+{
+	pthread_mutex_lock(&shm_mq_lock);
+	if (mq->ctl->destroyed)
+		shm_mq_tree_del(mq);
+	if (--mq->ref_count == 0)
+		shm_mq_unmap(mq);
+	pthread_mutex_unlock(&shm_mq_lock);
+}
+
+/* Take the lock of the queue @a hdl, the queue is released with
+ * shm_mq_unlock_put() */
+static MQSV_SHM_MQ *shm_mq_get_lock(NCS_OS_POSIX_MQD hdl)
+{
+	MQSV_SHM_MQ *mq = shm_mq_get(hdl);
+
+	if (mq == NULL)
+		return NULL;
+	if (shm_mq_lock_queue(mq) != NCSCC_RC_SUCCESS) {
+		shm_mq_put(mq);
+		return NULL;
+	}
+	return mq;
+}
+
+static void shm_mq_unlock_put(MQSV_SHM_MQ *mq)
+{
+	pthread_mutex_unlock(&mq->ctl->lock);
+	shm_mq_put(mq);
+}
+
+/****************************************************************************
+ * Name          : shm_mq_alloc_hdl
+ *
+ * Description   : Allocate a queue handle. The last handle allocated is kept
+ *                 in a shared memory object of its own, so the handles are
+ *                 unique on the node, also when MQND is restarted and the
+ *                 queues of the previous instance are kept. Called with
+ *                 shm_mq_lock taken.
+ *
+ * Return Values : The handle, or 0 on failure
+ ****************************************************************************/
+static NCS_OS_POSIX_MQD shm_mq_alloc_hdl(void)
+{
+	NCS_OS_POSIX_MQD hdl;
+
+	if (shm_mq_last_hdl == NULL) {
+		struct stat st;
+		void *last_hdl;
+		int fd = shm_open(MQSV_SHM_MQ_HDL_NAME, O_CREAT | O_RDWR,
+				  MQSV_SHM_MQ_HDL_PROTECTION_FLAGS);
+
+		if (fd < 0) {
+			LOG_ER("shm_open of %s failed: %s",
+			       MQSV_SHM_MQ_HDL_NAME, strerror(errno));
+			return 0;
+		}
+		/* Zero when created, the first handle is 1 */
+		if ((fstat(fd, &st) < 0) ||
+		    (((uint64_t)st.st_size < sizeof(NCS_OS_POSIX_MQD)) &&
+		     (ftruncate(fd, sizeof(NCS_OS_POSIX_MQD)) < 0))) {
+			LOG_ER("Sizing %s failed: %s", MQSV_SHM_MQ_HDL_NAME,
+			       strerror(errno));
+			close(fd);
+			return 0;
+		}
+		last_hdl = mmap(NULL, sizeof(NCS_OS_POSIX_MQD),
+				PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		close(fd);
+		if (last_hdl == MAP_FAILED) {
+			LOG_ER("mmap of %s failed: %s", MQSV_SHM_MQ_HDL_NAME,
+			       strerror(errno));
+			return 0;
+		}
+		shm_mq_last_hdl = last_hdl;
+	}
+
+	do {
+		hdl = __atomic_add_fetch(shm_mq_last_hdl, 1, __ATOMIC_RELAXED);
+	} while (hdl == 0);
+	return hdl;
+}
+
+static uint32_t shm_mq_create(NCS_OS_POSIX_MQ_REQ_OPEN_INFO *open)
+{
+	char name[MQSV_SHM_MQ_NAME_SIZE];
+	pthread_mutexattr_t mutex_attr;
+	pthread_condattr_t cond_attr;
+	MQSV_SHM_MQ_CTL *ctl;
+	MQSV_SHM_MQ *mq;
+	NCS_OS_POSIX_MQD hdl;
+	uint64_t lane_size;
+	int fd = -1;
+	int i;
+
+	if (!(open->iflags & O_CREAT)) {
+		TRACE_4("Opening an existing queue by name is not supported");
+		return NCSCC_RC_FAILURE;
+	}
+
+	lane_size = ((uint64_t)open->attr.mq_msgsize / 4 + 7) & ~(uint64_t)7;
+	if (lane_size < MQSV_SHM_MQ_MIN_LANE_SIZE)
+		lane_size = MQSV_SHM_MQ_MIN_LANE_SIZE;
+
+	/* A handle is only in use again when the handles have wrapped */
+	pthread_mutex_lock(&shm_mq_lock);
+	do {
+		hdl = shm_mq_alloc_hdl();
+		if (hdl == 0)
+			break;
+		shm_mq_name(hdl, name);
+		fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR,
+			      MQSV_SHM_MQ_PROTECTION_FLAGS);
+	} while ((fd < 0) && (errno == EEXIST));
+	pthread_mutex_unlock(&shm_mq_lock);
+	if (fd < 0) {
+		LOG_ER("Creation of shared memory queue failed: %s",
+		       strerror(errno));
+		return NCSCC_RC_FAILURE;
+	}
+
+	/* The mode given to shm_open() is masked by the umask */
+	if (((shm_mq_gid != (gid_t)-1) &&
+	     (fchown(fd, (uid_t)-1, shm_mq_gid) < 0)) ||
+	    (fchmod(fd, (shm_mq_gid != (gid_t)-1)
+			    ? MQSV_SHM_MQ_GROUP_PROTECTION_FLAGS
+			    : MQSV_SHM_MQ_PROTECTION_FLAGS) < 0)) {
+		LOG_ER("Setting the access of %s failed: %s", name,
+		       strerror(errno));
+		close(fd);
+		shm_unlink(name);
+		return NCSCC_RC_FAILURE;
+	}
+
+	if (ftruncate(fd, shm_mq_ctl_size() +
+			      MQSV_SHM_MQ_NUM_LANES * lane_size) < 0) {
+		LOG_ER("ftruncate of %s failed: %s", name, strerror(errno));
+		close(fd);
+		shm_unlink(name);
+		return NCSCC_RC_FAILURE;
+	}
+	ctl = mmap(NULL, shm_mq_ctl_size(), PROT_READ | PROT_WRITE, MAP_SHARED,
+		   fd, 0);
+	close(fd);
+	if (ctl == MAP_FAILED) {
+		LOG_ER("mmap of %s failed: %s", name, strerror(errno));
+		shm_unlink(name);
+		return NCSCC_RC_FAILURE;
+	}
+
+	pthread_mutexattr_init(&mutex_attr);
+	pthread_mutexattr_setpshared(&mutex_attr, PTHREAD_PROCESS_SHARED);
+	pthread_mutexattr_setrobust(&mutex_attr, PTHREAD_MUTEX_ROBUST);
+	pthread_mutex_init(&ctl->lock, &mutex_attr);
+	pthread_mutexattr_destroy(&mutex_attr);
+	pthread_condattr_init(&cond_attr);
+	pthread_condattr_setpshared(&cond_attr, PTHREAD_PROCESS_SHARED);
+	pthread_cond_init(&ctl->cond, &cond_attr);
+	pthread_condattr_destroy(&cond_attr);
+	for (i = 0; i < MQSV_SHM_MQ_NUM_LANES; i++) {
+		ctl->lane[i].offset = i * lane_size;
+		ctl->lane[i].capacity = lane_size;
+	}
+	ctl->data_size = MQSV_SHM_MQ_NUM_LANES * lane_size;
+	__atomic_store_n(&ctl->magic, MQSV_SHM_MQ_MAGIC, __ATOMIC_RELEASE);
+	munmap(ctl, shm_mq_ctl_size());
+
+	/* Map it as any other process does, to have it cached */
+	mq = shm_mq_get(hdl);
+	if (mq == NULL) {
+		shm_unlink(name);
+		return NCSCC_RC_FAILURE;
+	}
+	shm_mq_put(mq);
+
+	open->o_mqd = hdl;
+	TRACE("Created shared memory queue %u", hdl);
+	return NCSCC_RC_SUCCESS;
+}
+
+static uint32_t shm_mq_destroy(NCS_OS_POSIX_MQD hdl)
+{
+	char name[MQSV_SHM_MQ_NAME_SIZE];
+	MQSV_SHM_MQ *mq = shm_mq_get(hdl);
+
+	if (mq == NULL)
+		return NCSCC_RC_FAILURE;
+
+	/* Wake up the receivers blocked on the queue, they fail */
+	if (shm_mq_ctl_lock(mq->ctl) == 0) {
+		mq->ctl->destroyed = true;
+		pthread_cond_broadcast(&mq->ctl->cond);
+		pthread_mutex_unlock(&mq->ctl->lock);
+	} else {
+		mq->ctl->destroyed = true;
+	}
+
+	shm_mq_name(hdl, name);
+	shm_unlink(name);
+	shm_mq_put(mq);
+	return NCSCC_RC_SUCCESS;
+}
+
+/* Write a message into the lane of its type. Called with the lock of the
+ * queue taken and the rings checked. */
+static uint32_t shm_mq_write(MQSV_SHM_MQ *mq,
+			     const NCS_OS_POSIX_MQ_REQ_MSG_SEND_INFO *send)
+{
+	MQSV_SHM_MQ_LANE *lane = &mq->ctl->lane[send->i_mtype - 1];
+	uint64_t size = shm_mq_msg_size(send->datalen);
+	uint64_t pos;
+
+	if ((lane->capacity - (lane->tail - lane->head) < size) &&
+	    (shm_mq_grow(mq, send->i_mtype - 1, size) != NCSCC_RC_SUCCESS))
+		return NCSCC_RC_FAILURE;
+
+	pos = lane->tail % lane->capacity;
+	shm_mq_ring_write(mq->data + lane->offset, lane->capacity, pos,
+			  &send->datalen, sizeof(uint32_t));
+	pos = (pos + sizeof(uint32_t)) % lane->capacity;
+	shm_mq_ring_write(mq->data + lane->offset, lane->capacity, pos,
+			  send->i_msg->data, send->datalen);
+	/* Committed, after the message has been written */
+	__atomic_store_n(&lane->tail, lane->tail + size, __ATOMIC_RELEASE);
+	lane->num_msgs++;
+
+	if (mq->ctl->num_waiters != 0)
+		pthread_cond_broadcast(&mq->ctl->cond);
+	return NCSCC_RC_SUCCESS;
+}
+
+static uint32_t shm_mq_send(NCS_OS_POSIX_MQ_REQ_MSG_SEND_INFO *send)
+{
+	MQSV_SHM_MQ *mq;
+	uint32_t rc;
+
+	if ((send->i_mtype < 1) || (send->i_mtype > MQSV_SHM_MQ_NUM_LANES))
+		return NCSCC_RC_FAILURE;
+
+	mq = shm_mq_get_lock(send->mqd);
+	if (mq == NULL)
+		return NCSCC_RC_FAILURE;
+	rc = shm_mq_write(mq, send);
+	shm_mq_unlock_put(mq);
+	return rc;
+}
+
+/* The lane to receive from, as msgrcv() selects the message type */
+static int shm_mq_select_lane(const MQSV_SHM_MQ_CTL *ctl, int32_t mtype)
+{
+	int last = MQSV_SHM_MQ_NUM_LANES;
+	int l;
+
+	if (mtype > 0) {
+		if ((mtype <= MQSV_SHM_MQ_NUM_LANES) &&
+		    (ctl->lane[mtype - 1].num_msgs != 0))
+			return mtype - 1;
+		return -1;
+	}
+	if ((mtype < 0) && (-mtype < last))
+		last = -mtype;
+	for (l = 0; l < last; l++) {
+		if (ctl->lane[l].num_msgs != 0)
+			return l;
+	}
+	return -1;
+}
+
+static uint32_t shm_mq_recv(NCS_OS_POSIX_MQ_REQ_MSG_RECV_INFO *recv,
+			    bool block)
+{
+	MQSV_SHM_MQ *mq;
+	MQSV_SHM_MQ_LANE *lane;
+	uint32_t len;
+	uint64_t size;
+	int rc;
+	int l;
+
+	mq = shm_mq_get(recv->mqd);
+	if (mq == NULL)
+		return NCSCC_RC_FAILURE;
+	if (shm_mq_lock_queue(mq) != NCSCC_RC_SUCCESS) {
+		shm_mq_put(mq);
+		return NCSCC_RC_FAILURE;
+	}
+
+	while ((l = shm_mq_select_lane(mq->ctl, recv->i_mtype)) < 0) {
+		if (!block)
+			goto fail;
+		mq->ctl->num_waiters++;
+		rc = shm_mq_ctl_wait(mq->ctl);
+		mq->ctl->num_waiters--;
+		if ((rc != 0) || (shm_mq_sync(mq) != NCSCC_RC_SUCCESS))
+			goto fail;
+	}
+
+	lane = &mq->ctl->lane[l];
+	len = shm_mq_msg_len(mq, lane, lane->head);
+	size = shm_mq_msg_size(len);
+	if (size > lane->tail - lane->head) {
+		LOG_ER("Queue %u lane %d is corrupt, its messages are dropped",
+		       mq->hdl, l + 1);
+		lane->head = lane->tail;
+		lane->num_msgs = 0;
+		goto fail;
+	}
+	/* As msgrcv() without MSG_NOERROR, the message is left in the queue */
+	if (len > recv->datalen)
+		goto fail;
+	shm_mq_ring_read(mq->data + lane->offset, lane->capacity,
+			 (lane->head + sizeof(uint32_t)) % lane->capacity,
+			 recv->i_msg->data, len);
+	recv->i_msg->ll_hdr = l + 1;
+	/* Committed, after the message has been read */
+	__atomic_store_n(&lane->head, lane->head + size, __ATOMIC_RELEASE);
+	lane->num_msgs--;
+
+	pthread_mutex_unlock(&mq->ctl->lock);
+	shm_mq_put(mq);
+	return NCSCC_RC_SUCCESS;
+
+fail:
+	pthread_mutex_unlock(&mq->ctl->lock);
+	shm_mq_put(mq);
+	return NCSCC_RC_FAILURE;
+}
+
+static uint32_t shm_mq_attr_get(NCS_OS_POSIX_MQ_REQ_ATTR_INFO *attr)
+{
+	MQSV_SHM_MQ *mq;
+	uint64_t capacity = 0;
+	uint64_t used = 0;
+	uint32_t num_msgs = 0;
+	int l;
+
+	mq = shm_mq_get(attr->i_mqd);
+	if (mq == NULL)
+		return NCSCC_RC_FAILURE;
+	if (shm_mq_lock_queue(mq) != NCSCC_RC_SUCCESS) {
+		shm_mq_put(mq);
+		return NCSCC_RC_FAILURE;
+	}
+	for (l = 0; l < MQSV_SHM_MQ_NUM_LANES; l++) {
+		capacity += mq->ctl->lane[l].capacity;
+		used += mq->ctl->lane[l].tail - mq->ctl->lane[l].head;
+		num_msgs += mq->ctl->lane[l].num_msgs;
+	}
+	pthread_mutex_unlock(&mq->ctl->lock);
+	shm_mq_put(mq);
+
+	memset(&attr->o_attr, 0, sizeof(attr->o_attr));
+	attr->o_attr.mq_curmsgs = num_msgs;
+	attr->o_attr.mq_msgsize = used;
+	attr->o_attr.mq_maxmsg = capacity;
+	return NCSCC_RC_SUCCESS;
+}
+
+uint32_t mqsv_shm_mq(NCS_OS_POSIX_MQ_REQ_INFO *req)
+{
+	switch (req->req) {
+	case NCS_OS_POSIX_MQ_REQ_OPEN:
+		return shm_mq_create(&req->info.open);
+	case NCS_OS_POSIX_MQ_REQ_CLOSE:
+		return shm_mq_destroy(req->info.close.mqd);
+	case NCS_OS_POSIX_MQ_REQ_MSG_SEND:
+	case NCS_OS_POSIX_MQ_REQ_MSG_SEND_ASYNC:
+		/* A full lane is grown, a send never blocks */
+		return shm_mq_send(&req->info.send);
+	case NCS_OS_POSIX_MQ_REQ_MSG_RECV:
+		return shm_mq_recv(&req->info.recv, true);
+	case NCS_OS_POSIX_MQ_REQ_MSG_RECV_ASYNC:
+		return shm_mq_recv(&req->info.recv, false);
+	case NCS_OS_POSIX_MQ_REQ_GET_ATTR:
+		return shm_mq_attr_get(&req->info.attr);
+	default:
+		return NCSCC_RC_FAILURE;
+	}
+}
+
+/****************************************************************************
+ * Name          : mqsv_shm_mq_direct_set
+ *
+ * Description   : Set the size of the SAF priorities of the queue and the
+ *                 system limit of the message size, and allow the senders
+ *                 on the node to put messages directly into the queue, see
+ *                 mqsv_shm_mq_direct_send(), if @a enable is true. Called
+ *                 by MQND whenever the owner or the listener queue of the
+ *                 queue changes.
+ *
+ * Return Values : NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE
+ ****************************************************************************/
+uint32_t mqsv_shm_mq_direct_set(NCS_OS_POSIX_MQD hdl, bool enable,
+				SaMsgQueueHandleT listener, const SaSizeT *size,
+				SaSizeT max_msg_size)
+{
+	MQSV_SHM_MQ *mq = shm_mq_get_lock(hdl);
+	int i;
+
+	if (mq == NULL)
+		return NCSCC_RC_FAILURE;
+	for (i = 0; i < MQSV_SHM_MQ_NUM_PRIOS; i++)
+		mq->ctl->space[i].size = size[i];
+	mq->ctl->max_msg_size = max_msg_size;
+	mq->ctl->listener = listener;
+	mq->ctl->direct = enable;
+	shm_mq_unlock_put(mq);
+	return NCSCC_RC_SUCCESS;
+}
+
+/****************************************************************************
+ * Name          : mqsv_shm_mq_direct_send
+ *
+ * Description   : Put a message of the SAF priority @a priority and of
+ *                 @a size bytes of user data directly into the queue, if
+ *                 MQND allows it and the message fits into the space of the
+ *                 priority. The message is checked, written and accounted
+ *                 for with the lock of the queue taken, so it cannot race
+ *                 with another sender or with MQND. The listener queue to
+ *                 wake up is returned in @a listener.
+ *
+ * Return Values : NCSCC_RC_SUCCESS, or NCSCC_RC_FAILURE if the message is
+ *                 not put and shall be sent to MQND, which then reports why
+ *                 it does not fit.
+ ****************************************************************************/
+uint32_t mqsv_shm_mq_direct_send(NCS_OS_POSIX_MQ_REQ_MSG_SEND_INFO *send,
+				 SaUint8T priority, SaSizeT size,
+				 SaMsgQueueHandleT *listener)
+{
+	MQSV_SHM_MQ_SPACE *space;
+	MQSV_SHM_MQ *mq;
+	uint32_t rc = NCSCC_RC_FAILURE;
+
+	if ((priority >= MQSV_SHM_MQ_NUM_PRIOS) ||
+	    (send->i_mtype != (uint32_t)priority + 3))
+		return NCSCC_RC_FAILURE;
+
+	mq = shm_mq_get_lock(send->mqd);
+	if (mq == NULL)
+		return NCSCC_RC_FAILURE;
+
+	space = &mq->ctl->space[priority];
+	if (mq->ctl->direct && (size <= mq->ctl->max_msg_size) &&
+	    (space->used <= space->size) &&
+	    (size <= space->size - space->used)) {
+		rc = shm_mq_write(mq, send);
+		if (rc == NCSCC_RC_SUCCESS) {
+			space->used += size;
+			space->num_msgs++;
+			*listener = mq->ctl->listener;
+		}
+	}
+
+	shm_mq_unlock_put(mq);
+	return rc;
+}
+
+/****************************************************************************
+ * Name          : mqsv_shm_mq_space_take
+ *
+ * Description   : Account for a message of @a size bytes of user data put
+ *                 into the queue by MQND. If @a check is true, the message
+ *                 shall fit into the space of the priority.
+ *
+ * Return Values : NCSCC_RC_SUCCESS, or NCSCC_RC_FAILURE if the message does
+ *                 not fit
+ ****************************************************************************/
+uint32_t mqsv_shm_mq_space_take(NCS_OS_POSIX_MQD hdl, SaUint8T priority,
+				SaSizeT size, bool check)
+{
+	MQSV_SHM_MQ_SPACE *space;
+	MQSV_SHM_MQ *mq;
+	uint32_t rc = NCSCC_RC_SUCCESS;
+
+	if (priority >= MQSV_SHM_MQ_NUM_PRIOS)
+		return NCSCC_RC_FAILURE;
+	mq = shm_mq_get_lock(hdl);
+	if (mq == NULL)
+		return NCSCC_RC_FAILURE;
+
+	space = &mq->ctl->space[priority];
+	if (check && ((space->used > space->size) ||
+		      (size > space->size - space->used))) {
+		rc = NCSCC_RC_FAILURE;
+	} else {
+		space->used += size;
+		space->num_msgs++;
+	}
+
+	shm_mq_unlock_put(mq);
+	return rc;
+}
+
+/****************************************************************************
+ * Name          : mqsv_shm_mq_space_give
+ *
+ * Description   : Give back the space of @a num_msgs messages of @a size
+ *                 bytes of user data in total, which have been received.
+ *
+ * Return Values : NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE
+ ****************************************************************************/
+uint32_t mqsv_shm_mq_space_give(NCS_OS_POSIX_MQD hdl, SaUint8T priority,
+				SaSizeT size, SaUint32T num_msgs)
+{
+	MQSV_SHM_MQ_SPACE *space;
+	MQSV_SHM_MQ *mq;
+
+	if (priority >= MQSV_SHM_MQ_NUM_PRIOS)
+		return NCSCC_RC_FAILURE;
+	mq = shm_mq_get_lock(hdl);
+	if (mq == NULL)
+		return NCSCC_RC_FAILURE;
+
+	/* Never below zero, e.g. if a sender died before accounting for its
+	 * message */
+	space = &mq->ctl->space[priority];
+	space->used = (size < space->used) ? space->used - size : 0;
+	space->num_msgs =
+	    (num_msgs < space->num_msgs) ? space->num_msgs - num_msgs : 0;
+
+	shm_mq_unlock_put(mq);
+	return NCSCC_RC_SUCCESS;
+}
+
+/* The used space and the number of messages of each SAF priority */
+uint32_t mqsv_shm_mq_space_get(NCS_OS_POSIX_MQD hdl, SaSizeT *used,
+			       SaUint32T *num_msgs)
+{
+	MQSV_SHM_MQ *mq = shm_mq_get_lock(hdl);
+	int i;
+
+	if (mq == NULL)
+		return NCSCC_RC_FAILURE;
+	for (i = 0; i < MQSV_SHM_MQ_NUM_PRIOS; i++) {
+		used[i] = mq->ctl->space[i].used;
+		num_msgs[i] = mq->ctl->space[i].num_msgs;
+	}
+	shm_mq_unlock_put(mq);
+	return NCSCC_RC_SUCCESS;
+}
+
+/* Give back all the space, after the queue has been emptied */
+uint32_t mqsv_shm_mq_space_reset(NCS_OS_POSIX_MQD hdl)
+{
+	MQSV_SHM_MQ *mq = shm_mq_get_lock(hdl);
+	int i;
+
+	if (mq == NULL)
+		return NCSCC_RC_FAILURE;
+	for (i = 0; i < MQSV_SHM_MQ_NUM_PRIOS; i++) {
+		mq->ctl->space[i].used = 0;
+		mq->ctl->space[i].num_msgs = 0;
+	}
+	shm_mq_unlock_put(mq);
+	return NCSCC_RC_SUCCESS;
+}
+
+/****************************************************************************
+ * Name          : mqsv_shm_mq_group_set
+ *
+ * Description   : Set the group owning the queues created from now on, -1
+ *                 for none. The queues of a group are only accessible to
+ *                 its members, the others to all local users. Called by
+ *                 MQND, which shall be a member of the group.
+ *
+ * Return Values : None
+ ****************************************************************************/
+void mqsv_shm_mq_group_set(gid_t gid)
+{
+	shm_mq_gid = gid;
+}
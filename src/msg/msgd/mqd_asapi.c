@@ -54,6 +54,7 @@ static uint32_t mqd_asapi_getqueue_hdlr(MQD_CB *, ASAPi_GETQUEUE_INFO *,
 					MQSV_SEND_INFO *);
 static uint32_t mqd_asapi_track_hdlr(MQD_CB *, ASAPi_TRACK_INFO *,
 				     MQSV_SEND_INFO *);
+static uint32_t mqd_asapi_load_upd_hdlr(MQD_CB *, ASAPi_LOAD_UPD_INFO *);
 static bool mqd_asapi_obj_validate(MQD_CB *, SaNameT *, MQD_OBJ_NODE **);
 static uint32_t mqd_asapi_queue_make(MQD_OBJ_INFO *, ASAPi_QUEUE_PARAM **,
 				     uint16_t *, bool);
@@ -112,6 +113,10 @@ uint32_t mqd_asapi_evt_hdlr(MQSV_EVT *pEvt, MQD_CB *pMqd)
 			TRACE_1("ASAPi Track Message Received");
 			rc = mqd_asapi_track_hdlr(pMqd, &pMsg->info.track,
 						  &pEvt->sinfo);
+		} else if (ASAPi_MSG_LOAD_UPD == pMsg->msgtype) {
+			/* Handle the ASAPi Load Update message */
+			TRACE_1("ASAPi Load Update Message Received");
+			rc = mqd_asapi_load_upd_hdlr(pMqd, &pMsg->info.lupd);
 		}
 	}
 	TRACE_1("ASAPi Event processed completely with return value %u", rc);
@@ -1063,6 +1068,61 @@ uint32_t mqd_asapi_track_db_upd(MQD_CB *pMqd, ASAPi_TRACK_INFO *track,
 	return rc;
 } /* End of mqd_asapi_track_db_upd() */
 
+/****************************************************************************\
+   PROCEDURE NAME :  mqd_asapi_load_upd_hdlr
+
+   DESCRIPTION    :  This is a handler for the ASAPi Load Update message from
+		     an MQND. It stores the new loads of the queues and sends
+		     a queue update track notification for each least loaded
+		     group the queue is member of, so that the senders select
+		     the members on the new loads.
+
+   ARGUMENTS      :  pMqd - MQD Controll block pointer
+		     lupd - ASAPi Load Update Message
+
+   RETURNS        :  SUCCESS - All went well
+		     FAILURE - internal processing didn't like something.
+\****************************************************************************/
+static uint32_t mqd_asapi_load_upd_hdlr(MQD_CB *pMqd,
+					ASAPi_LOAD_UPD_INFO *lupd)
+{
+	MQD_OBJ_NODE *pObjNode = 0;
+	MQD_OBJECT_ELEM *pOelm = 0;
+	NCS_Q_ITR itr;
+	uint16_t idx = 0;
+	TRACE_ENTER();
+
+	for (idx = 0; idx < lupd->qcnt; idx++) {
+		if (!mqd_asapi_obj_validate(pMqd, &lupd->qload[idx].name,
+					    &pObjNode) ||
+		    (MQSV_OBJ_QUEUE != pObjNode->oinfo.type)) {
+			TRACE_2("Load update for unknown queue %s",
+				lupd->qload[idx].name.value);
+			continue;
+		}
+
+		pObjNode->oinfo.info.q.load = lupd->qload[idx].load;
+		TRACE_1("Queue %s load %u", pObjNode->oinfo.name.value,
+			pObjNode->oinfo.info.q.load);
+
+		itr.state = 0;
+		while ((pOelm = (MQD_OBJECT_ELEM *)ncs_walk_items(
+			    &pObjNode->oinfo.ilist, &itr))) {
+			if (pOelm->pObject->info.qgrp.policy !=
+			    NCS_MSG_QUEUE_GROUP_LEAST_LOADED)
+				continue;
+
+			/* The notification carries the advertised queue */
+			pObjNode->oinfo.info.q.adv = true;
+			mqd_asapi_track_ntfy_send(pOelm->pObject,
+						  ASAPi_QUEUE_UPD);
+		}
+	}
+
+	TRACE_LEAVE();
+	return NCSCC_RC_SUCCESS;
+} /* End of mqd_asapi_load_upd_hdlr() */
+
 /****************************************************************************\
    PROCEDURE NAME :  mqd_asapi_track_ntfy_send
 
@@ -38,18 +38,18 @@
 
 #define MQSV_MQD_MBCSV_VERSION 1
 #define MQSV_MQD_MBCSV_VERSION_MIN 1
-#define MQD_PVT_SUBPART_VERSION 2
+#define MQD_PVT_SUBPART_VERSION 3
 
 /* MQD - MQA */
 #define MQD_WRT_MQA_SUBPART_VER_AT_MIN_MSG_FMT 1
-#define MQD_WRT_MQA_SUBPART_VER_AT_MAX_MSG_FMT 2
+#define MQD_WRT_MQA_SUBPART_VER_AT_MAX_MSG_FMT 3
 #define MQD_WRT_MQA_SUBPART_VER_RANGE       \
   (MQD_WRT_MQA_SUBPART_VER_AT_MAX_MSG_FMT - \
    MQD_WRT_MQA_SUBPART_VER_AT_MIN_MSG_FMT + 1)
 
 /* MQD - MQND */
 #define MQD_WRT_MQND_SUBPART_VER_AT_MIN_MSG_FMT 1
-#define MQD_WRT_MQND_SUBPART_VER_AT_MAX_MSG_FMT 2
+#define MQD_WRT_MQND_SUBPART_VER_AT_MAX_MSG_FMT 3
 #define MQD_WRT_MQND_SUBPART_VER_RANGE       \
   (MQD_WRT_MQND_SUBPART_VER_AT_MAX_MSG_FMT - \
    MQD_WRT_MQND_SUBPART_VER_AT_MIN_MSG_FMT + 1)
@@ -68,6 +68,7 @@ typedef struct mqd_queue_param {
   uint8_t is_mqnd_down;                   /* true if mqnd is down else false */
   SaMsgQueueCreationFlagsT creationFlags; /* Queue creation flags */
   SaSizeT size[SA_MSG_MESSAGE_LOWEST_PRIORITY + 1]; /* Priority queue sizes */
+  uint32_t load; /* Used part of the queue as last reported by the MQND */
 } MQD_QUEUE_PARAM;
 
 typedef struct mqd_qgroup_param {
@@ -707,7 +707,7 @@ static void mqd_dump_obj_node(MQD_OBJ_NODE *qnode)
 	TRACE(" The Qnode Ohjinfo pointer value is : %p ", &(qnode->oinfo));
 	if (qnode->oinfo.type == MQSV_OBJ_QGROUP) {
 		TRACE("Queue Group Name is : %s", qnode->oinfo.name.value);
-		switch (qnode->oinfo.info.qgrp.policy) {
+		switch ((uint32_t)qnode->oinfo.info.qgrp.policy) {
 		case SA_MSG_QUEUE_GROUP_ROUND_ROBIN:
 			TRACE("Policy is :Round Robin");
 			break;
@@ -720,6 +720,9 @@ static void mqd_dump_obj_node(MQD_OBJ_NODE *qnode)
 		case SA_MSG_QUEUE_GROUP_BROADCAST:
 			TRACE("Policy is :Group Broadcast");
 			break;
+		case NCS_MSG_QUEUE_GROUP_LEAST_LOADED:
+			TRACE("Policy is :Least Loaded");
+			break;
 		default:
 			TRACE("Policy is :Unknown");
 		}
@@ -52,9 +52,9 @@ static void mqd_mds_svc_evt(MQD_CB *, MDS_CALLBACK_SVC_EVENT_INFO *);
 static uint32_t mqd_mds_quiesced_process(MQD_CB *pMqd);
 
 MSG_FRMT_VER mqd_mqa_msg_fmt_table[MQD_WRT_MQA_SUBPART_VER_RANGE] = {
-    0, 2}; /*With version 1 it is not backward compatible */
+    0, 2, 3}; /*With version 1 it is not backward compatible */
 MSG_FRMT_VER mqd_mqnd_msg_fmt_table[MQD_WRT_MQND_SUBPART_VER_RANGE] = {
-    0, 2}; /*With version 1 it is not backward compatible */
+    0, 2, 3}; /*With version 1 it is not backward compatible */
 
 /****************************************************************************
    PROCEDURE NAME :  mqd_mds_callback
@@ -391,8 +391,9 @@ static uint32_t mqd_mds_enc(MQD_CB *pMqd, MDS_CALLBACK_ENC_INFO *enc)
 	if (enc->o_msg_fmt_ver) {
 		pEvt = (MQSV_EVT *)enc->i_msg;
 
-		rc = (m_NCS_EDU_EXEC(&pMqd->edu_hdl, mqsv_edp_mqsv_evt,
-				     enc->io_uba, EDP_OP_TYPE_ENC, pEvt, &err));
+		rc = (m_NCS_EDU_VER_EXEC(&pMqd->edu_hdl, mqsv_edp_mqsv_evt,
+					 enc->io_uba, EDP_OP_TYPE_ENC, pEvt,
+					 &err, enc->o_msg_fmt_ver));
 		if (rc != NCSCC_RC_SUCCESS)
 			LOG_ER("MDS Encode is Failed at EDU");
 		return rc;
@@ -455,9 +456,10 @@ static uint32_t mqd_mds_dec(MQD_CB *pMqd, MDS_CALLBACK_DEC_INFO *dec)
 		memset(pEvt, 0, sizeof(MQSV_EVT));
 		dec->o_msg = (NCSCONTEXT)pEvt;
 
-		rc = m_NCS_EDU_EXEC(&pMqd->edu_hdl, mqsv_edp_mqsv_evt,
-				    dec->io_uba, EDP_OP_TYPE_DEC,
-				    (MQSV_EVT **)&dec->o_msg, &err);
+		rc = m_NCS_EDU_VER_EXEC(&pMqd->edu_hdl, mqsv_edp_mqsv_evt,
+					dec->io_uba, EDP_OP_TYPE_DEC,
+					(MQSV_EVT **)&dec->o_msg, &err,
+					dec->i_msg_fmt_ver);
 		if (NCSCC_RC_SUCCESS != rc) {
 			LOG_ER("MDS Decode is Failed at EDU");
 			if ((MQSV_EVT_ASAPI == pEvt->type) && (pEvt->msg.asapi))
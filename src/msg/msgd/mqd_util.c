@@ -173,6 +173,7 @@ void mqd_qparam_fill(const MQD_QUEUE_PARAM *pParam, ASAPi_QUEUE_PARAM *pQparam)
 	pQparam->creationFlags = pParam->creationFlags;
 	memcpy(pQparam->size, pParam->size,
 	       sizeof(SaSizeT) * (SA_MSG_MESSAGE_LOWEST_PRIORITY + 1));
+	pQparam->load = pParam->load;
 
 } /* End of mqd_qparam_fill() */
 
@@ -44,17 +44,23 @@ extern uint32_t gl_mqnd_cb_hdl;
 /***************************Service Sub part
  * Versions***************************/
 
-#define MQND_PVT_SUBPART_VERSION 2
+#define MQND_PVT_SUBPART_VERSION 3
 /* MQND - MQA */
 #define MQND_WRT_MQA_SUBPART_VER_AT_MIN_MSG_FMT 1
-#define MQND_WRT_MQA_SUBPART_VER_AT_MAX_MSG_FMT 2
+#define MQND_WRT_MQA_SUBPART_VER_AT_MAX_MSG_FMT 3
 #define MQND_WRT_MQA_SUBPART_VER_RANGE       \
   (MQND_WRT_MQA_SUBPART_VER_AT_MAX_MSG_FMT - \
    MQND_WRT_MQA_SUBPART_VER_AT_MIN_MSG_FMT + 1)
+/* From this message format MQA puts messages directly into the queues of
+ * MQND, see mqnd_evt_proc_send_msg_local() */
+#define MQND_MQA_MSG_FMT_LOCAL_SEND 3
+/* From this message format MQA sends MQP_EVT_SEND_MSG_BATCH and
+ * MQP_EVT_STAT_UPD_BATCH_REQ */
+#define MQND_MQA_MSG_FMT_BATCH 3
 
 /* MQND - MQD */
 #define MQND_WRT_MQD_SUBPART_VER_AT_MIN_MSG_FMT 1
-#define MQND_WRT_MQD_SUBPART_VER_AT_MAX_MSG_FMT 2
+#define MQND_WRT_MQD_SUBPART_VER_AT_MAX_MSG_FMT 3
 #define MQND_WRT_MQD_SUBPART_VER_RANGE       \
   (MQND_WRT_MQD_SUBPART_VER_AT_MAX_MSG_FMT - \
    MQND_WRT_MQD_SUBPART_VER_AT_MIN_MSG_FMT + 1)
@@ -94,6 +100,7 @@ typedef struct mqnd_queue_info {
   uint32_t shm_queue_index;
   bool capacityReachedSent;
   bool capacityAvailableSent;
+  uint32_t load; /* Load of the queue last reported to MQD */
 } MQND_QUEUE_INFO;
 
 typedef struct mqnd_qhndl_node {
@@ -179,6 +186,7 @@ typedef struct mqnd_cb {
 
   MDS_DEST mqd_dest; /* MDS Destination ID of MQD */
   bool is_mqd_up;    /* true/false) */
+  MDS_CLIENT_MSG_FORMAT_VER mqd_msg_fmt_ver; /* Message format of MQD */
 
   NCS_LOCK cb_lock;
 
@@ -213,6 +221,9 @@ typedef struct mqnd_cb {
   SaImmOiHandleT immOiHandle;
   SaSelectionObjectT imm_sel_obj;
   SaSelectionObjectT clm_sel_obj;
+  MQND_TMR load_tmr;          /* Timer for the queue load updates to MQD */
+  uint32_t load_upd_interval; /* Load update interval, 0 disables */
+  bool load_resend;           /* Report the load of all queues to MQD */
 } MQND_CB;
 
 #define MQND_QUEUE_INFO_NULL ((MQND_QUEUE_INFO *)0)
@@ -245,9 +256,9 @@ uint32_t mqnd_proc_mqa_down(MQND_CB *cb, MDS_DEST *mqa);
 
 /* Functions from mqnd_mq.c */
 uint32_t mqnd_mq_create(MQND_QUEUE_INFO *q_info);
-uint32_t mqnd_mq_open(MQND_QUEUE_INFO *q_info);
 uint32_t mqnd_mq_destroy(MQND_QUEUE_INFO *q_info);
 uint32_t mqnd_mq_msg_send(uint32_t qhdl, MQSV_MESSAGE *i_msg, uint32_t i_len);
+uint32_t mqnd_mq_direct_set(MQND_CB *cb, MQND_QUEUE_INFO *q_info);
 uint32_t mqnd_mq_empty(SaMsgQueueHandleT handle);
 uint32_t mqnd_mq_rcv(SaMsgQueueHandleT handle);
 
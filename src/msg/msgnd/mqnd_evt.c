@@ -40,6 +40,8 @@ static uint32_t mqnd_evt_proc_send_msg(MQND_CB *cb, MQSV_DSEND_EVT *evt);
 static uint32_t mqnd_evt_proc_qattr_get(MQND_CB *cb, MQSV_EVT *evt);
 static uint32_t mqnd_evt_proc_update_stats_shm(MQND_CB *cb,
 					       MQSV_DSEND_EVT *evt);
+static uint32_t mqnd_evt_proc_send_msg_local(MQND_CB *cb, MQSV_DSEND_EVT *evt);
+static uint32_t mqnd_evt_proc_send_msg_batch(MQND_CB *cb, MQSV_DSEND_EVT *evt);
 static uint32_t mqnd_evt_proc_cb_dump(void);
 static uint32_t mqnd_evt_proc_ret_time_set(MQND_CB *cb, MQSV_EVT *evt);
 static uint32_t mqnd_evt_proc_cap_set(MQND_CB *, MQSV_EVT *);
@@ -49,6 +51,7 @@ static uint32_t mqnd_evt_proc_limit_get(MQND_CB *, MQSV_EVT *);
 static void mqnd_dump_queue_status(MQND_CB *cb, SaMsgQueueStatusT *queueStatus,
 				   uint32_t offset);
 static void mqnd_dump_timer_info(MQND_TMR tmr);
+static void mqnd_load_update_send(MQND_CB *cb);
 void mqnd_process_dsend_evt(MQSV_DSEND_EVT *evt);
 void mqnd_process_evt(MQSV_EVT *evt);
 static uint32_t mqnd_proc_mds_mqa_up(MQND_CB *cb, MQSV_EVT *evt);
@@ -126,6 +129,18 @@ void mqnd_process_dsend_evt(MQSV_DSEND_EVT *evt)
 		(void)mqnd_evt_proc_update_stats_shm(cb, evt);
 		break;
 
+	case MQP_EVT_SEND_MSG_LOCAL:
+		(void)mqnd_evt_proc_send_msg_local(cb, evt);
+		break;
+
+	case MQP_EVT_SEND_MSG_BATCH:
+		(void)mqnd_evt_proc_send_msg_batch(cb, evt);
+		break;
+
+	case MQP_EVT_STAT_UPD_BATCH_REQ:
+		(void)mqnd_evt_proc_update_stats_shm(cb, evt);
+		break;
+
 	default:
 		/* Log the error */
 		/* m_LOG_MQND_EVT(evt->type, NCSFL_SEV_ERROR); */
@@ -140,7 +155,10 @@ void mqnd_process_dsend_evt(MQSV_DSEND_EVT *evt)
 	/* Free the Event */
 	if ((evt->type.req_type == MQP_EVT_SEND_MSG_ASYNC) ||
 	    (evt->type.req_type == MQP_EVT_SEND_MSG) ||
-	    (evt->type.req_type == MQP_EVT_STAT_UPD_REQ))
+	    (evt->type.req_type == MQP_EVT_STAT_UPD_REQ) ||
+	    (evt->type.req_type == MQP_EVT_SEND_MSG_LOCAL) ||
+	    (evt->type.req_type == MQP_EVT_SEND_MSG_BATCH) ||
+	    (evt->type.req_type == MQP_EVT_STAT_UPD_BATCH_REQ))
 		mds_free_direct_buff((MDS_DIRECT_BUFF)evt);
 
 	TRACE_LEAVE();
@@ -1147,7 +1165,7 @@ static void checkCapacity(MQND_CB *cb, MQND_QUEUE_INFO *qInfo)
  * Name          : mqnd_evt_proc_update_stats_shm
  *
  * Description   : Function to update stats of queue in shm when message is
- *received.
+ *received, or when a batch of messages is received.
  *
  * Arguments     : MQND_CB *cb - MQND CB pointer
  *                 MQSV_DSEND_EVT *evt - Received Event structure
@@ -1161,7 +1179,8 @@ static uint32_t mqnd_evt_proc_update_stats_shm(MQND_CB *cb, MQSV_DSEND_EVT *evt)
 	MQND_QUEUE_NODE *qnode = NULL;
 	SaAisErrorT err = SA_AIS_OK;
 	MQP_UPDATE_STATS *statsReq;
-	uint32_t offset, rc = NCSCC_RC_SUCCESS, msg_fmt_ver;
+	MQP_UPDATE_STATS_BATCH *statsBatchReq;
+	uint32_t offset, rc = NCSCC_RC_SUCCESS, msg_fmt_ver, prio;
 	MQND_QUEUE_CKPT_INFO *shm_base_addr;
 	MQSV_DSEND_EVT *direct_rsp_evt = NULL;
 	bool is_valid_msg_fmt = false;
@@ -1177,7 +1196,9 @@ static uint32_t mqnd_evt_proc_update_stats_shm(MQND_CB *cb, MQSV_DSEND_EVT *evt)
 
 	/*Drop the messages with msg_fmt_version=1 as earlier versions are non
 	 * backward compatible */
-	if (!is_valid_msg_fmt || !msg_fmt_ver || (evt->msg_fmt_version == 1)) {
+	if (!is_valid_msg_fmt || !msg_fmt_ver || (evt->msg_fmt_version == 1) ||
+	    ((evt->type.req_type == MQP_EVT_STAT_UPD_BATCH_REQ) &&
+	     (evt->msg_fmt_version < MQND_MQA_MSG_FMT_BATCH))) {
 		/* Drop The Message */
 		if (!is_valid_msg_fmt) {
 			LOG_ER(
@@ -1195,6 +1216,7 @@ static uint32_t mqnd_evt_proc_update_stats_shm(MQND_CB *cb, MQSV_DSEND_EVT *evt)
 	}
 
 	statsReq = &evt->info.statsReq;
+	statsBatchReq = &evt->info.statsBatchReq;
 
 	if (!cb->clm_node_joined) {
 		err = SA_AIS_ERR_UNAVAILABLE;
@@ -1210,7 +1232,10 @@ static uint32_t mqnd_evt_proc_update_stats_shm(MQND_CB *cb, MQSV_DSEND_EVT *evt)
 		goto done;
 	}
 
-	mqnd_queue_node_get(cb, statsReq->qhdl, &qnode);
+	if (evt->type.req_type == MQP_EVT_STAT_UPD_BATCH_REQ)
+		mqnd_queue_node_get(cb, statsBatchReq->qhdl, &qnode);
+	else
+		mqnd_queue_node_get(cb, statsReq->qhdl, &qnode);
 
 	/* If queue not found */
 	if (!qnode) {
@@ -1223,16 +1248,23 @@ static uint32_t mqnd_evt_proc_update_stats_shm(MQND_CB *cb, MQSV_DSEND_EVT *evt)
 	shm_base_addr = cb->mqnd_shm.shm_base_addr;
 	offset = qnode->qinfo.shm_queue_index;
 
-	if (shm_base_addr[offset].valid == SHM_QUEUE_INFO_VALID) {
-		shm_base_addr[offset]
-		    .QueueStatsShm.saMsgQueueUsage[statsReq->priority]
-		    .queueUsed -= statsReq->size;
-		shm_base_addr[offset]
-		    .QueueStatsShm.saMsgQueueUsage[statsReq->priority]
-		    .numberOfMessages--;
-		shm_base_addr[offset].QueueStatsShm.totalQueueUsed -=
-		    statsReq->size;
-		shm_base_addr[offset].QueueStatsShm.totalNumberOfMessages--;
+	/* Give back the space of the received messages */
+	if ((shm_base_addr[offset].valid == SHM_QUEUE_INFO_VALID) &&
+	    (evt->type.req_type == MQP_EVT_STAT_UPD_BATCH_REQ)) {
+		for (prio = SA_MSG_MESSAGE_HIGHEST_PRIORITY;
+		     prio <= SA_MSG_MESSAGE_LOWEST_PRIORITY; prio++) {
+			if (statsBatchReq->numberOfMessages[prio] == 0)
+				continue;
+			mqsv_shm_mq_space_give(
+			    qnode->qinfo.queueHandle, prio,
+			    statsBatchReq->size[prio],
+			    statsBatchReq->numberOfMessages[prio]);
+		}
+		mqnd_queue_stats_update_shm(cb, qnode);
+	} else if (shm_base_addr[offset].valid == SHM_QUEUE_INFO_VALID) {
+		mqsv_shm_mq_space_give(qnode->qinfo.queueHandle,
+				       statsReq->priority, statsReq->size, 1);
+		mqnd_queue_stats_update_shm(cb, qnode);
 	} else {
 		LOG_ER("ERR_LIBRARY: Queue info is invalid");
 		err = SA_AIS_ERR_LIBRARY;
@@ -1270,6 +1302,134 @@ done:
 	return rc;
 }
 
+/****************************************************************************
+ * Name          : mqnd_send_msg_take_space
+ *
+ * Description   : Function to check that a message being sent fits into the
+ *                 queue as per the system defined message size and the user
+ *                 defined queue size, and to take the space for it in the
+ *                 queue. The space is shared with the senders putting
+ *                 messages directly into the queue, see posix.c.
+ *
+ * Arguments     : MQND_CB *cb - MQND CB pointer
+ *                 MQND_QUEUE_NODE *qnode - queue node
+ *                 uint32_t priority - priority of the message
+ *                 SaSizeT msg_size - size of the message
+ *
+ * Return Values : SA_AIS_OK/SA_AIS_ERR_TOO_BIG/SA_AIS_ERR_QUEUE_FULL
+ *
+ * Notes         : None.
+ *****************************************************************************/
+static SaAisErrorT mqnd_send_msg_take_space(MQND_CB *cb,
+					    MQND_QUEUE_NODE *qnode,
+					    uint32_t priority,
+					    SaSizeT msg_size)
+{
+	MQND_QUEUE_CKPT_INFO queue_ckpt_node;
+
+	/* Check if message size is less than system defined msg size */
+	if (msg_size > cb->gl_msg_max_msg_size) {
+		LOG_ER(
+		    "ERR_TOO_BIG: message size is less than system defined msg size");
+		return SA_AIS_ERR_TOO_BIG;
+	}
+	/* Check to see if the message fits into the queue as per user defined
+	 * statistics */
+	if (mqsv_shm_mq_space_take(qnode->qinfo.queueHandle, priority,
+				   msg_size, true) != NCSCC_RC_SUCCESS) {
+		qnode->qinfo.numberOfFullErrors[priority]++;
+		memset(&queue_ckpt_node, 0, sizeof(MQND_QUEUE_CKPT_INFO));
+		mqnd_cpy_qnodeinfo_to_ckptinfo(cb, qnode, &queue_ckpt_node);
+		mqnd_ckpt_queue_info_write(cb, &queue_ckpt_node,
+					   qnode->qinfo.shm_queue_index);
+		LOG_ER("The queue is full");
+		return SA_AIS_ERR_QUEUE_FULL;
+	}
+
+	return SA_AIS_OK;
+}
+
+/****************************************************************************
+ * Name          : mqnd_send_msg_put
+ *
+ * Description   : Function to put a message, for which the space has been
+ *                 taken, into the queue and to account for it in the queue
+ *                 stats. The space is given back if the message is not put.
+ *
+ * Arguments     : MQND_CB *cb - MQND CB pointer
+ *                 MQND_QUEUE_NODE *qnode - queue node
+ *                 QUEUE_MESSAGE_INFO *message_info - sender info
+ *                 QUEUE_MESSAGE *message - the message
+ *
+ * Return Values : SA_AIS_OK/Error.
+ *
+ * Notes         : None.
+ *****************************************************************************/
+static SaAisErrorT mqnd_send_msg_put(MQND_CB *cb, MQND_QUEUE_NODE *qnode,
+				     QUEUE_MESSAGE_INFO *message_info,
+				     QUEUE_MESSAGE *message)
+{
+	MQSV_MESSAGE *mqsv_msg;
+	uint32_t size, rc;
+
+	/* Allocate the memory (size of MQSV_MESSAGE + size of received data) */
+	size = (uint32_t)(sizeof(MQSV_MESSAGE) + message->size);
+	mqsv_msg = (MQSV_MESSAGE *)m_MMGR_ALLOC_MQND_DEFAULT(size);
+
+	if (!mqsv_msg) {
+		LOG_CR("ERR_MEMORY: Memory Allocation Failed");
+		mqsv_shm_mq_space_give(qnode->qinfo.queueHandle,
+				       message->priority, message->size, 1);
+		return SA_AIS_ERR_NO_MEMORY;
+	}
+
+	/* Write into Queue */
+	memset(mqsv_msg, 0, sizeof(size));
+
+	mqsv_msg->type = MQP_EVT_GET_REQ;
+	mqsv_msg->mqsv_version = MQSV_MSG_VERSION;
+
+	/* Fill the Sender info */
+	mqsv_msg->info.msg.message_info = *message_info;
+	m_GET_TIME_STAMP(mqsv_msg->info.msg.message_info.sendTime);
+
+	memcpy(mqsv_msg->info.msg.message.data, message->data,
+	       (uint32_t)message->size);
+	mqsv_msg->info.msg.message.priority = message->priority;
+	mqsv_msg->info.msg.message.size = message->size;
+	mqsv_msg->info.msg.message.type = message->type;
+	mqsv_msg->info.msg.message.version = message->version;
+	mqsv_msg->info.msg.message.senderName = message->senderName;
+
+	rc = mqnd_mq_msg_send(qnode->qinfo.queueHandle, mqsv_msg,
+			      (uint32_t)size);
+
+	/* Free the message */
+	m_MMGR_FREE_MQND_DEFAULT(mqsv_msg);
+
+	if (rc != NCSCC_RC_SUCCESS) {
+		LOG_ER(
+		    "ERR_RESOURCES: Unable to send the message to the Queue");
+		mqsv_shm_mq_space_give(qnode->qinfo.queueHandle,
+				       message->priority, message->size, 1);
+		return SA_AIS_ERR_NO_RESOURCES;
+	}
+
+	mqnd_queue_stats_update_shm(cb, qnode);
+
+	/* Send a 1-byte message to the listener queue. The message is sent only
+	   if their exists a listener queue i.e. when listenerHandle <> 0 */
+	rc = mqsv_listenerq_msg_send(qnode->qinfo.listenerHandle);
+
+	if (rc != NCSCC_RC_SUCCESS) {
+		LOG_ER(
+		    "ERR_RESOURCES: Unable to send the message to the listener Queue");
+		return SA_AIS_ERR_NO_RESOURCES;
+	}
+
+	return SA_AIS_OK;
+}
+
 /****************************************************************************
  * Name          : mqnd_evt_proc_send_msg
  *
@@ -1290,12 +1450,7 @@ static uint32_t mqnd_evt_proc_send_msg(MQND_CB *cb, MQSV_DSEND_EVT *evt)
 	SaAisErrorT err = SA_AIS_OK;
 	MQSV_EVT rsp_evt;
 	MQSV_DSEND_EVT *direct_rsp_evt = NULL;
-	MQSV_MESSAGE *mqsv_msg = NULL;
-	uint32_t size, qsize = 0, qused = 0, actual_qsize = 0, actual_qused = 0,
-		       offset;
-	NCS_OS_POSIX_MQ_REQ_INFO info;
-	MQND_QUEUE_CKPT_INFO *shm_base_addr;
-	MQND_QUEUE_CKPT_INFO queue_ckpt_node;
+	QUEUE_MESSAGE_INFO message_info;
 	bool is_valid_msg_fmt = false;
 	TRACE_ENTER();
 
@@ -1360,142 +1515,27 @@ static uint32_t mqnd_evt_proc_send_msg(MQND_CB *cb, MQSV_DSEND_EVT *evt)
 		goto send_resp;
 	}
 
-	offset = qnode->qinfo.shm_queue_index;
-	shm_base_addr = cb->mqnd_shm.shm_base_addr;
-
-	/* Get user defined queue size and usage stats */
-	qsize = qnode->qinfo.size[snd_msg->message.priority];
-	qused = shm_base_addr[offset]
-		    .QueueStatsShm.saMsgQueueUsage[snd_msg->message.priority]
-		    .queueUsed;
-
-	/* Check if message size is less than system defined msg size */
-	if (snd_msg->message.size > cb->gl_msg_max_msg_size) {
-		LOG_ER(
-		    "ERR_TOO_BIG: message size is less than system defined msg size");
-		err = SA_AIS_ERR_TOO_BIG;
+	err = mqnd_send_msg_take_space(cb, qnode, snd_msg->message.priority,
+				       snd_msg->message.size);
+	if (err != SA_AIS_OK) {
 		rc = NCSCC_RC_FAILURE;
 		goto send_resp;
 	}
-	/* Check to see if the message fits into the queue as per user defined
-	 * statistics */
-	if (snd_msg->message.size > (qsize - qused)) {
-		qnode->qinfo.numberOfFullErrors[snd_msg->message.priority]++;
-		err = SA_AIS_ERR_QUEUE_FULL;
-		memset(&queue_ckpt_node, 0, sizeof(MQND_QUEUE_CKPT_INFO));
-		mqnd_cpy_qnodeinfo_to_ckptinfo(cb, qnode, &queue_ckpt_node);
-		mqnd_ckpt_queue_info_write(cb, &queue_ckpt_node,
-					   qnode->qinfo.shm_queue_index);
-		LOG_ER("The queue is full");
-		rc = NCSCC_RC_FAILURE;
-		goto send_resp;
-	}
-
-	/* Get actual queue size and usage stats */
-	info.req = NCS_OS_POSIX_MQ_REQ_GET_ATTR;
-	info.info.attr.i_mqd = qnode->qinfo.queueHandle;
-
-	if (m_NCS_OS_POSIX_MQ(&info) != NCSCC_RC_SUCCESS) {
-		err = SA_AIS_ERR_BAD_HANDLE;
-		LOG_ER("Unable to get the queue attributes from the queue");
-		rc = NCSCC_RC_FAILURE;
-		goto send_resp;
-	}
-
-	actual_qsize = info.info.attr.o_attr.mq_maxmsg;
-	actual_qused = info.info.attr.o_attr.mq_msgsize;
-
-	/* Check to see if the (message + message header + message type) fits
-	   into the actual queue as per its actual stats, if NOT, increase the
-	   actual queue size so as to hold the message The "message type" is
-	   part of the NCS_OS_MQ_MSG structure which maps to the "mtype" field
-	   of the "struct msqid_ds" posix structure */
-	if ((snd_msg->message.size + sizeof(MQSV_MESSAGE) +
-	     sizeof(NCS_OS_MQ_MSG_LL_HDR)) > (actual_qsize - actual_qused)) {
-		info.req = NCS_OS_POSIX_MQ_REQ_RESIZE;
-		info.info.resize.mqd = qnode->qinfo.queueHandle;
-
-		/* Increase queue size so that its able to hold 5 such messages
-		 */
-		info.info.resize.i_newqsize =
-		    actual_qsize +
-		    (5 * (snd_msg->message.size + sizeof(MQSV_MESSAGE) +
-			  sizeof(NCS_OS_MQ_MSG_LL_HDR)));
-
-		if (m_NCS_OS_POSIX_MQ(&info) != NCSCC_RC_SUCCESS) {
-			LOG_ER("Unable to resize the queue to the given size");
-			err = SA_AIS_ERR_NO_RESOURCES;
-			rc = NCSCC_RC_FAILURE;
-			goto send_resp;
-		}
-	}
-
-	/* Allocate the memory (size of MQSV_MESSAGE + size of received data) */
-	size = (uint32_t)(sizeof(MQSV_MESSAGE) + snd_msg->message.size);
-	mqsv_msg = (MQSV_MESSAGE *)m_MMGR_ALLOC_MQND_DEFAULT(size);
-
-	if (!mqsv_msg) {
-		LOG_CR("ERR_MEMORY: Memory Allocation Failed");
-		err = SA_AIS_ERR_NO_MEMORY;
-		rc = NCSCC_RC_FAILURE;
-		goto send_resp;
-	}
-
-	/* Write into Queue */
-	memset(mqsv_msg, 0, sizeof(size));
-
-	mqsv_msg->type = MQP_EVT_GET_REQ;
-	mqsv_msg->mqsv_version = MQSV_MSG_VERSION;
 
 	/* Fill the Sender info */
-	mqsv_msg->info.msg.message_info = snd_msg->messageInfo;
-	m_GET_TIME_STAMP(mqsv_msg->info.msg.message_info.sendTime);
+	message_info = snd_msg->messageInfo;
 	if (snd_msg->messageInfo.sendReceive) {
-		mqsv_msg->info.msg.message_info.sender.sender_context
-		    .sender_dest = evt->sinfo.dest;
-		mqsv_msg->info.msg.message_info.sender.sender_context.context =
-		    evt->sinfo.ctxt;
-		mqsv_msg->info.msg.message_info.sender.sender_context
-		    .reply_buffer_size = snd_msg->messageInfo.sender
-					     .sender_context.reply_buffer_size;
-	}
-
-	memcpy(mqsv_msg->info.msg.message.data, snd_msg->message.data,
-	       (uint32_t)snd_msg->message.size);
-	mqsv_msg->info.msg.message.priority = snd_msg->message.priority;
-	mqsv_msg->info.msg.message.size = snd_msg->message.size;
-	mqsv_msg->info.msg.message.type = snd_msg->message.type;
-	mqsv_msg->info.msg.message.version = snd_msg->message.version;
-	mqsv_msg->info.msg.message.senderName = snd_msg->message.senderName;
-
-	rc = mqnd_mq_msg_send(qnode->qinfo.queueHandle, mqsv_msg,
-			      (uint32_t)size);
-
-	/* Free the message */
-	if (mqsv_msg)
-		m_MMGR_FREE_MQND_DEFAULT(mqsv_msg);
-
-	if (rc != NCSCC_RC_SUCCESS) {
-		LOG_ER(
-		    "ERR_RESOURCES: Unable to send the message to the Queue");
-		err = SA_AIS_ERR_NO_RESOURCES;
-		goto send_resp;
+		message_info.sender.sender_context.sender_dest =
+		    evt->sinfo.dest;
+		message_info.sender.sender_context.context = evt->sinfo.ctxt;
 	}
 
-	/* Send a 1-byte message to the listener queue. The message is sent only
-	   if their exists a listener queue i.e. when listenerHandle <> 0 */
-	rc = mqsv_listenerq_msg_send(qnode->qinfo.listenerHandle);
-
-	if (rc != NCSCC_RC_SUCCESS) {
-		LOG_ER(
-		    "ERR_RESOURCES: Unable to send the message to the listener Queue");
-		err = SA_AIS_ERR_NO_RESOURCES;
+	err = mqnd_send_msg_put(cb, qnode, &message_info, &snd_msg->message);
+	if (err != SA_AIS_OK) {
+		rc = NCSCC_RC_FAILURE;
 		goto send_resp;
 	}
 
-	mqnd_send_msg_update_stats_shm(cb, qnode, snd_msg->message.size,
-				       snd_msg->message.priority);
-
 	checkCapacity(cb, &qnode->qinfo);
 
 send_resp:
@@ -1571,6 +1611,289 @@ send_resp:
 	return rc;
 }
 
+/****************************************************************************
+ * Name          : mqnd_evt_proc_send_msg_batch
+ *
+ * Description   : Function to process a batch of messages sent to a queue.
+ *                 The messages are put into the queue in order, each as if
+ *                 it was sent on its own, and one response with the status
+ *                 of each message is sent back.
+ *
+ * Arguments     : MQND_CB *cb - MQND CB pointer
+ *                 MQSV_DSEND_EVT *evt - Received Event structure
+ *
+ * Return Values : NCSCC_RC_SUCCESS/Error.
+ *
+ * Notes         : None.
+ *****************************************************************************/
+static uint32_t mqnd_evt_proc_send_msg_batch(MQND_CB *cb, MQSV_DSEND_EVT *evt)
+{
+	uint32_t rc = NCSCC_RC_SUCCESS, msg_fmt_ver, i, num_msgs;
+	MQP_SEND_MSG_BATCH *snd_batch = &evt->info.sndMsgBatch;
+	MQND_QUEUE_NODE *qnode = NULL;
+	SaAisErrorT err = SA_AIS_OK, *errors;
+	MQSV_DSEND_EVT *direct_rsp_evt = NULL;
+	QUEUE_MESSAGE_INFO message_info;
+	QUEUE_MESSAGE *message;
+	char *record;
+	TRACE_ENTER2("numberOfMessages %u", snd_batch->numberOfMessages);
+
+	num_msgs = snd_batch->numberOfMessages;
+	direct_rsp_evt = (MQSV_DSEND_EVT *)mds_alloc_direct_buff(
+	    sizeof(MQSV_DSEND_EVT) + num_msgs * sizeof(SaAisErrorT));
+	if (!direct_rsp_evt) {
+		LOG_CR("Memory Allocation Failed");
+		return NCSCC_RC_FAILURE;
+	}
+
+	memset(direct_rsp_evt, 0,
+	       sizeof(MQSV_DSEND_EVT) + num_msgs * sizeof(SaAisErrorT));
+	errors = (SaAisErrorT *)(direct_rsp_evt + 1);
+
+	msg_fmt_ver = m_NCS_ENC_MSG_FMT_GET(
+	    evt->src_dest_version, MQND_WRT_MQA_SUBPART_VER_AT_MIN_MSG_FMT,
+	    MQND_WRT_MQA_SUBPART_VER_AT_MAX_MSG_FMT, mqnd_mqa_msg_fmt_table);
+
+	if (!m_NCS_MSG_FORMAT_IS_VALID(evt->msg_fmt_version,
+				       MQND_WRT_MQA_SUBPART_VER_AT_MIN_MSG_FMT,
+				       MQND_WRT_MQA_SUBPART_VER_AT_MAX_MSG_FMT,
+				       mqnd_mqa_msg_fmt_table) ||
+	    !msg_fmt_ver ||
+	    (evt->msg_fmt_version < MQND_MQA_MSG_FMT_BATCH)) {
+		LOG_ER("ERR_VERSION: Message Format Version Invalid");
+		err = SA_AIS_ERR_VERSION;
+		goto send_resp;
+	}
+
+	if (!cb->clm_node_joined) {
+		TRACE("node is not cluster member");
+		err = SA_AIS_ERR_UNAVAILABLE;
+		goto send_resp;
+	} else if (!cb->is_restart_done) {
+		LOG_ER(
+		    "%s:%u: ERR_TRY_AGAIN: MQND is not completely Initialized",
+		    __FILE__, __LINE__);
+		err = SA_AIS_ERR_TRY_AGAIN;
+		goto send_resp;
+	}
+
+	mqnd_queue_node_get(cb, snd_batch->queueHandle, &qnode);
+
+	/* If queue not found */
+	if (!qnode) {
+		LOG_ER("ERR_BAD_HANDLE: Get queue node Failed");
+		err = SA_AIS_ERR_BAD_HANDLE;
+		goto send_resp;
+	}
+
+	if (qnode->qinfo.owner_flag == MQSV_QUEUE_OWN_STATE_PROGRESS) {
+		LOG_ER("ERR_TRY_AGAIN: The queue is under transfer Process");
+		err = SA_AIS_ERR_TRY_AGAIN;
+		goto send_resp;
+	}
+
+	memset(&message_info, 0, sizeof(message_info));
+	message_info.sendReceive = SA_FALSE;
+
+	record = (char *)(evt + 1);
+	for (i = 0; i < num_msgs; i++) {
+		message = (QUEUE_MESSAGE *)record;
+		record += m_MQSV_BATCH_MSG_SIZE(message->size);
+
+		if (message->priority > SA_MSG_MESSAGE_LOWEST_PRIORITY) {
+			errors[i] = SA_AIS_ERR_INVALID_PARAM;
+			continue;
+		}
+
+		errors[i] = mqnd_send_msg_take_space(
+		    cb, qnode, message->priority, message->size);
+		if (errors[i] == SA_AIS_OK)
+			errors[i] = mqnd_send_msg_put(cb, qnode, &message_info,
+						      message);
+	}
+
+	checkCapacity(cb, &qnode->qinfo);
+
+send_resp:
+	/* A failure of the whole batch is the status of each message */
+	if (err != SA_AIS_OK) {
+		for (i = 0; i < num_msgs; i++)
+			errors[i] = err;
+	}
+
+	direct_rsp_evt->evt_type = MQSV_DSEND_EVENT;
+	direct_rsp_evt->endianness = machineEndianness();
+	direct_rsp_evt->msg_fmt_version = msg_fmt_ver;
+	direct_rsp_evt->src_dest_version = MQND_PVT_SUBPART_VERSION;
+	direct_rsp_evt->type.rsp_type = MQP_EVT_SEND_MSG_BATCH_RSP;
+	direct_rsp_evt->info.sendBatchRsp.error = err;
+	direct_rsp_evt->info.sendBatchRsp.numberOfMessages = num_msgs;
+
+	rc = mqnd_mds_send_rsp_direct_len(
+	    cb, &evt->sinfo, direct_rsp_evt,
+	    sizeof(MQSV_DSEND_EVT) + num_msgs * sizeof(SaAisErrorT));
+	if (rc != NCSCC_RC_SUCCESS)
+		TRACE_2("Mds Send Response Direct Failed");
+
+	TRACE_LEAVE2("Returned with return code %u", rc);
+	return rc;
+}
+
+/****************************************************************************
+ * Name          : mqnd_evt_proc_send_msg_local
+ *
+ * Description   : Function to process the notification of a collocated MQA
+ *                 which has put a message directly into the queue. The space
+ *                 of the message has been taken by MQA, the queue stats are
+ *                 updated from the space of the queue and the capacity
+ *                 thresholds are checked.
+ *
+ * Arguments     : MQND_CB *cb - MQND CB pointer
+ *                 MQSV_DSEND_EVT *evt - Received Event structure
+ *
+ * Return Values : NCSCC_RC_SUCCESS/Error.
+ *
+ * Notes         : No response is sent.
+ *****************************************************************************/
+static uint32_t mqnd_evt_proc_send_msg_local(MQND_CB *cb, MQSV_DSEND_EVT *evt)
+{
+	MQND_QUEUE_NODE *qnode = NULL;
+	TRACE_ENTER2("queue handle %llu", evt->info.statsReq.qhdl);
+
+	if (!m_NCS_MSG_FORMAT_IS_VALID(evt->msg_fmt_version,
+				       MQND_WRT_MQA_SUBPART_VER_AT_MIN_MSG_FMT,
+				       MQND_WRT_MQA_SUBPART_VER_AT_MAX_MSG_FMT,
+				       mqnd_mqa_msg_fmt_table) ||
+	    (evt->msg_fmt_version < MQND_MQA_MSG_FMT_LOCAL_SEND)) {
+		LOG_ER("ERR_VERSION: Message Format Version Invalid");
+		TRACE_LEAVE();
+		return NCSCC_RC_FAILURE;
+	}
+
+	mqnd_queue_node_get(cb, evt->info.statsReq.qhdl, &qnode);
+
+	/* The queue may have been deleted since */
+	if (!qnode) {
+		TRACE_2("Get queue node Failed");
+		TRACE_LEAVE();
+		return NCSCC_RC_FAILURE;
+	}
+
+	mqnd_queue_stats_update_shm(cb, qnode);
+
+	checkCapacity(cb, &qnode->qinfo);
+
+	TRACE_LEAVE();
+	return NCSCC_RC_SUCCESS;
+}
+
+/****************************************************************************
+ * Name          : mqnd_load_upd_msg_send
+ *
+ * Description   : Function to send an ASAPi load update message to MQD.
+ *
+ * Arguments     : MQND_CB *cb - MQND CB pointer
+ *                 ASAPi_QUEUE_LOAD *qload - Queue loads
+ *                 uint16_t qcnt - Number of queue loads
+ *
+ * Return Values : NCSCC_RC_SUCCESS/Error.
+ *
+ * Notes         : None.
+ *****************************************************************************/
+static uint32_t mqnd_load_upd_msg_send(MQND_CB *cb, ASAPi_QUEUE_LOAD *qload,
+				       uint16_t qcnt)
+{
+	ASAPi_OPR_INFO opr;
+
+	memset(&opr, 0, sizeof(ASAPi_OPR_INFO));
+	opr.type = ASAPi_OPR_MSG;
+	opr.info.msg.opr = ASAPi_MSG_SEND;
+	opr.info.msg.sinfo.to_svc = NCSMDS_SVC_ID_MQD;
+	opr.info.msg.sinfo.dest = cb->mqd_dest;
+	opr.info.msg.sinfo.stype = MDS_SENDTYPE_SND;
+	opr.info.msg.req.msgtype = ASAPi_MSG_LOAD_UPD;
+	opr.info.msg.req.info.lupd.qcnt = qcnt;
+	opr.info.msg.req.info.lupd.qload = qload;
+
+	return asapi_opr_hdlr(&opr);
+}
+
+/****************************************************************************
+ * Name          : mqnd_load_update_send
+ *
+ * Description   : Function to report the loads of the queues on this node
+ *                 to MQD, for the least loaded queue group policy. The load
+ *                 of a queue is the used part of its size, it is only sent
+ *                 when it has moved to another load band since the last
+ *                 report.
+ *
+ * Arguments     : MQND_CB *cb - MQND CB pointer
+ *
+ * Return Values : None.
+ *
+ * Notes         : Called on the expiry of the load update timer. An older
+ *                 MQD does not take the load updates.
+ *****************************************************************************/
+static void mqnd_load_update_send(MQND_CB *cb)
+{
+	static ASAPi_QUEUE_LOAD qload[ASAPi_LOAD_UPD_MAX_QUEUES];
+	MQND_QUEUE_CKPT_INFO *shm_base_addr = cb->mqnd_shm.shm_base_addr;
+	MQND_QUEUE_NODE *qnode = NULL;
+	SaMsgQueueHandleT qhdl;
+	SaSizeT qsize, used;
+	uint32_t load, i;
+	uint16_t qcnt = 0;
+	bool resend;
+
+	if (!cb->is_mqd_up || (cb->mqd_msg_fmt_ver < ASAPi_MSG_FMT_LOAD))
+		return;
+
+	resend = cb->load_resend;
+	cb->load_resend = false;
+
+	mqnd_queue_node_getnext(cb, 0, &qnode);
+	while (qnode) {
+		qhdl = qnode->qinfo.queueHandle;
+
+		qsize = 0;
+		for (i = SA_MSG_MESSAGE_HIGHEST_PRIORITY;
+		     i <= SA_MSG_MESSAGE_LOWEST_PRIORITY; i++)
+			qsize += qnode->qinfo.size[i];
+		used = shm_base_addr[qnode->qinfo.shm_queue_index]
+			   .QueueStatsShm.totalQueueUsed;
+
+		if (!qsize)
+			load = 0;
+		else if (used >= qsize)
+			load = ASAPi_LOAD_MAX;
+		else
+			load = (uint32_t)((used * ASAPi_LOAD_MAX) / qsize);
+
+		if (resend || (m_ASAPi_LOAD_BAND(load) !=
+			       m_ASAPi_LOAD_BAND(qnode->qinfo.load))) {
+			qnode->qinfo.load = load;
+			qload[qcnt].name = qnode->qinfo.queueName;
+			qload[qcnt].load = load;
+
+			if (++qcnt == ASAPi_LOAD_UPD_MAX_QUEUES) {
+				if (mqnd_load_upd_msg_send(cb, qload, qcnt) !=
+				    NCSCC_RC_SUCCESS)
+					cb->load_resend = true;
+				qcnt = 0;
+			}
+		}
+
+		mqnd_queue_node_getnext(cb, qhdl, &qnode);
+	}
+
+	if (qcnt &&
+	    (mqnd_load_upd_msg_send(cb, qload, qcnt) != NCSCC_RC_SUCCESS)) {
+		/* The loads are sent again on the next expiry */
+		TRACE_2("Queue load update to MQD failed");
+		cb->load_resend = true;
+	}
+}
+
 /****************************************************************************
  * Name          : mqnd_evt_proc_tmr_expiry
  *
@@ -1673,6 +1996,11 @@ uint32_t mqnd_evt_proc_tmr_expiry(MQND_CB *cb, MQSV_EVT *evt)
 			LOG_ER("Reg with CPSV Failed");
 		break;
 
+	case MQND_TMR_TYPE_LOAD_UPDATE:
+		mqnd_load_update_send(cb);
+		mqnd_tmr_start(&cb->load_tmr, cb->load_upd_interval);
+		break;
+
 	case MQND_TMR_TYPE_NODE1_QTRANSFER:
 		LOG_NO("QTrans Timer on Node 1 expired");
 		/*Case:  Request response not recieved in Time ,so send a
@@ -30,6 +30,7 @@
 #include "base/osaf_time.h"
 #include "mqnd.h"
 #include "mqnd_imm.h"
+#include <grp.h>
 #include <poll.h>
 #define MQND_CLM_API_TIMEOUT 10000000000LL
 uint32_t gl_mqnd_cb_hdl = 0;
@@ -284,6 +285,9 @@ static uint32_t mqnd_lib_init(MQSV_CREATE_INFO *info)
 	uint32_t rc = NCSCC_RC_SUCCESS;
 	SaAmfHealthcheckKeyT healthy;
 	char *health_key = NULL;
+	char *max_q_size;
+	char *load_upd_interval;
+	char *queue_group;
 	SaAisErrorT amf_error;
 	char str_vector[10] = "";
 	int fd;
@@ -354,10 +358,45 @@ static uint32_t mqnd_lib_init(MQSV_CREATE_INFO *info)
 
 	close(fd);
 
+	/* The queues are in shared memory and not limited by msgmnb, which is
+	 * only the default of the maximum queue size */
+	if ((max_q_size = getenv("MSGND_MAX_QUEUE_SIZE")) != NULL) {
+		cb->gl_msg_max_q_size = strtoul(max_q_size, NULL, 0);
+		TRACE("Maximum queue size: %u", cb->gl_msg_max_q_size);
+	}
+
 	/* As there is no specific limit for priority queue size at present it
 	 * is kept as max msg size */
 	cb->gl_msg_max_prio_q_size = cb->gl_msg_max_q_size;
 
+	/* The queue loads used by the least loaded group policy are reported
+	 * to MQD once per interval, given in milliseconds */
+	cb->load_upd_interval = MQND_LOAD_UPDATE_TIMER;
+	if ((load_upd_interval = getenv("MSGND_LOAD_UPDATE_INTERVAL")) !=
+	    NULL) {
+		cb->load_upd_interval =
+		    (strtoul(load_upd_interval, NULL, 0) + 9) / 10;
+		TRACE("Load update interval: %u", cb->load_upd_interval);
+	}
+
+	/* The applications receive from the shared memory queues themselves,
+	 * the queues are writable by all local users unless a group is set */
+	if (((queue_group = getenv("MSGND_QUEUE_GROUPNAME")) != NULL) &&
+	    (strcmp(queue_group, "") != 0)) {
+		struct group grp;
+		struct group *grp_ptr = NULL;
+		char grp_buf[4096];
+
+		if ((getgrnam_r(queue_group, &grp, grp_buf, sizeof(grp_buf),
+				&grp_ptr) != 0) ||
+		    (grp_ptr == NULL)) {
+			LOG_ER("Queue group %s not found", queue_group);
+			return NCSCC_RC_FAILURE;
+		}
+		mqsv_shm_mq_group_set(grp.gr_gid);
+		TRACE("Queue group: %s", queue_group);
+	}
+
 	/* END: Set attributes of queue in global variable */
 
 	/* Init the EDU Handle */
@@ -463,6 +502,12 @@ static uint32_t mqnd_lib_init(MQSV_CREATE_INFO *info)
 	/* End of code for No Redundanccy Support */
 	TRACE_1("saAmfHealthcheckStart Successfull");
 
+	if (cb->load_upd_interval) {
+		cb->load_tmr.type = MQND_TMR_TYPE_LOAD_UPDATE;
+		cb->load_tmr.uarg = cb->cb_hdl;
+		mqnd_tmr_start(&cb->load_tmr, cb->load_upd_interval);
+	}
+
 	TRACE_1("Initialization Success");
 
 	TRACE_LEAVE();
@@ -530,6 +575,8 @@ static uint32_t mqnd_lib_destroy(MQSV_DESTROY_INFO *info)
 	saClmFinalize(cb->clm_hdl);
 	cb->clm_node_joined = 0;
 
+	mqnd_tmr_stop(&cb->load_tmr);
+
 	m_NCS_IPC_DETACH(&cb->mbx, mqnd_clear_mbx, cb);
 
 	m_NCS_IPC_RELEASE(&cb->mbx, NULL);
@@ -41,17 +41,19 @@ static uint32_t mqnd_mds_rcv(MQND_CB *cb, MDS_CALLBACK_RECEIVE_INFO *rcv_info);
 static uint32_t
 mqnd_mds_direct_rcv(MQND_CB *cb,
 		    MDS_CALLBACK_DIRECT_RECEIVE_INFO *direct_rcv_info);
+static bool mqnd_mds_dec_send_msg_batch(MQSV_DSEND_EVT *pEvt, uint32_t length,
+					bool swap);
 static uint32_t mqnd_mds_svc_evt(MQND_CB *cb,
 				 MDS_CALLBACK_SVC_EVENT_INFO *svc_evt);
 static uint32_t mqnd_mds_get_handle(MQND_CB *cb);
 
 /*To store the message format versions*/
 MSG_FRMT_VER mqnd_mqa_msg_fmt_table[MQND_WRT_MQA_SUBPART_VER_RANGE] = {
-    0, 2}; /*With version 1 it is not backward compatible */
+    0, 2, 3}; /*With version 1 it is not backward compatible */
 MSG_FRMT_VER mqnd_mqnd_msg_fmt_table[MQND_WRT_MQND_SUBPART_VER_RANGE] = {
     0, 2}; /*With version 1 it is not backward compatible */
 MSG_FRMT_VER mqnd_mqd_msg_fmt_table[MQND_WRT_MQD_SUBPART_VER_RANGE] = {
-    0, 2}; /*With version 1 it is not backward compatible */
+    0, 2, 3}; /*With version 1 it is not backward compatible */
 
 /****************************************************************************
  * Name          : mqnd_mds_get_handle
@@ -344,9 +346,10 @@ static uint32_t mqnd_mds_enc(MQND_CB *cb, MDS_CALLBACK_ENC_INFO *enc_info)
 	}
 
 	if (enc_info->o_msg_fmt_ver) {
-		rc = (m_NCS_EDU_EXEC(&cb->edu_hdl, mqsv_edp_mqsv_evt,
-				     enc_info->io_uba, EDP_OP_TYPE_ENC, msg_ptr,
-				     &ederror));
+		rc = (m_NCS_EDU_VER_EXEC(&cb->edu_hdl, mqsv_edp_mqsv_evt,
+					 enc_info->io_uba, EDP_OP_TYPE_ENC,
+					 msg_ptr, &ederror,
+					 enc_info->o_msg_fmt_ver));
 		if (rc != NCSCC_RC_SUCCESS) {
 			LOG_ER("MDS Encode Failed");
 		}
@@ -419,9 +422,10 @@ static uint32_t mqnd_mds_dec(MQND_CB *cb, MDS_CALLBACK_DEC_INFO *dec_info)
 		memset(msg_ptr, 0, sizeof(MQSV_EVT));
 		dec_info->o_msg = (NCSCONTEXT)msg_ptr;
 
-		rc = m_NCS_EDU_EXEC(&cb->edu_hdl, mqsv_edp_mqsv_evt,
-				    dec_info->io_uba, EDP_OP_TYPE_DEC,
-				    (MQSV_EVT **)&dec_info->o_msg, &ederror);
+		rc = m_NCS_EDU_VER_EXEC(&cb->edu_hdl, mqsv_edp_mqsv_evt,
+					dec_info->io_uba, EDP_OP_TYPE_DEC,
+					(MQSV_EVT **)&dec_info->o_msg, &ederror,
+					dec_info->i_msg_fmt_ver);
 		if (rc != NCSCC_RC_SUCCESS) {
 			LOG_ER("MDS Decode Failed");
 			m_MMGR_FREE_MQSV_EVT(dec_info->o_msg,
@@ -470,6 +474,58 @@ static uint32_t mqnd_mds_rcv(MQND_CB *pMqnd,
 	return rc;
 }
 
+/****************************************************************************
+ * Name          : mqnd_mds_dec_send_msg_batch
+ *
+ * Description   : This function checks that the messages of a
+ *                 MQP_EVT_SEND_MSG_BATCH are within the direct buffer and
+ *                 decodes them to host order if the endianness of the source
+ *                 is different.
+ *
+ * Arguments     : pEvt   - The direct send event
+ *                 length - Length of the direct buffer
+ *                 swap   - true if the event is to be decoded to host order
+ *
+ * Return Values : true if the batch is valid.
+ *
+ * Notes         : The event header is already decoded.
+ *****************************************************************************/
+static bool mqnd_mds_dec_send_msg_batch(MQSV_DSEND_EVT *pEvt, uint32_t length,
+					bool swap)
+{
+	bool endianness = machineEndianness();
+	char *record = (char *)(pEvt + 1);
+	char *end = (char *)pEvt + length;
+	QUEUE_MESSAGE *message;
+	uint32_t i;
+
+	if (length < sizeof(MQSV_DSEND_EVT))
+		return false;
+
+	for (i = 0; i < pEvt->info.sndMsgBatch.numberOfMessages; i++) {
+		message = (QUEUE_MESSAGE *)record;
+		if ((char *)message->data > end)
+			return false;
+
+		if (swap) {
+			message->type =
+			    m_MQSV_REVERSE_ENDIAN_L(&message->type, endianness);
+			message->version = m_MQSV_REVERSE_ENDIAN_L(
+			    &message->version, endianness);
+			message->size =
+			    m_MQSV_REVERSE_ENDIAN_LL(&message->size, endianness);
+			message->senderName.length = m_MQSV_REVERSE_ENDIAN_S(
+			    &message->senderName.length, endianness);
+		}
+
+		if (message->size > (SaSizeT)(end - message->data))
+			return false;
+		record += m_MQSV_BATCH_MSG_SIZE(message->size);
+	}
+
+	return true;
+}
+
 /****************************************************************************
  * Name          : mqnd_mds_direct_rcv
  *
@@ -658,13 +714,53 @@ mqnd_mds_direct_rcv(MQND_CB *pMqnd,
 				&pEvt->info.sndMsgAsync.invocation, endianness);
 		} break;
 
-		case MQP_EVT_STAT_UPD_REQ: {
+		case MQP_EVT_STAT_UPD_REQ:
+		case MQP_EVT_SEND_MSG_LOCAL: {
 			pEvt->info.statsReq.qhdl = m_MQSV_REVERSE_ENDIAN_LL(
 			    &pEvt->info.statsReq.qhdl, endianness);
 
 			pEvt->info.statsReq.size = m_MQSV_REVERSE_ENDIAN_LL(
 			    &pEvt->info.statsReq.size, endianness);
 		} break;
+
+		case MQP_EVT_SEND_MSG_BATCH: {
+			pEvt->agent_mds_dest = m_MQSV_REVERSE_ENDIAN_LL(
+			    &pEvt->agent_mds_dest, endianness);
+
+			pEvt->info.sndMsgBatch.msgHandle =
+			    m_MQSV_REVERSE_ENDIAN_LL(
+				&pEvt->info.sndMsgBatch.msgHandle, endianness);
+
+			pEvt->info.sndMsgBatch.queueHandle =
+			    m_MQSV_REVERSE_ENDIAN_LL(
+				&pEvt->info.sndMsgBatch.queueHandle,
+				endianness);
+
+			pEvt->info.sndMsgBatch.numberOfMessages =
+			    m_MQSV_REVERSE_ENDIAN_L(
+				&pEvt->info.sndMsgBatch.numberOfMessages,
+				endianness);
+		} break;
+
+		case MQP_EVT_STAT_UPD_BATCH_REQ: {
+			uint32_t prio;
+
+			pEvt->info.statsBatchReq.qhdl = m_MQSV_REVERSE_ENDIAN_LL(
+			    &pEvt->info.statsBatchReq.qhdl, endianness);
+
+			for (prio = SA_MSG_MESSAGE_HIGHEST_PRIORITY;
+			     prio <= SA_MSG_MESSAGE_LOWEST_PRIORITY; prio++) {
+				pEvt->info.statsBatchReq.size[prio] =
+				    m_MQSV_REVERSE_ENDIAN_LL(
+					&pEvt->info.statsBatchReq.size[prio],
+					endianness);
+				pEvt->info.statsBatchReq.numberOfMessages[prio] =
+				    m_MQSV_REVERSE_ENDIAN_L(
+					&pEvt->info.statsBatchReq
+					     .numberOfMessages[prio],
+					endianness);
+			}
+		} break;
 		default:
 			LOG_ER("MQP_EVT does not match with type %d",
 			       pEvt->type.req_type);
@@ -672,6 +768,14 @@ mqnd_mds_direct_rcv(MQND_CB *pMqnd,
 		}
 	}
 
+	if ((pEvt->type.req_type == MQP_EVT_SEND_MSG_BATCH) &&
+	    !mqnd_mds_dec_send_msg_batch(pEvt,
+					 direct_rcv_info->i_direct_buff_len,
+					 pEvt->endianness != endianness)) {
+		LOG_ER("mqnd_mds_direct_rcv: Invalid message batch");
+		return NCSCC_RC_FAILURE;
+	}
+
 	/* Put it in MQND's Event Queue */
 	rc = m_NCS_IPC_SEND(&pMqnd->mbx, (NCSCONTEXT)pEvt,
 			    NCS_IPC_PRIORITY_NORMAL);
@@ -750,6 +854,8 @@ static uint32_t mqnd_mds_svc_evt(MQND_CB *cb,
 		case NCSMDS_SVC_ID_MQD: {
 			cb->is_mqd_up = true;
 			cb->mqd_dest = svc_evt->i_dest;
+			/* The queue loads are not kept by the standby MQD */
+			cb->load_resend = true;
 			TRACE_1("MQD service is up");
 
 			to_dest_node_id = mqsv_get_node_id(svc_evt->i_dest);
@@ -765,6 +871,7 @@ static uint32_t mqnd_mds_svc_evt(MQND_CB *cb,
 				 * MQD version, Node ID being logged */
 				LOG_ER("Message Format Version Invalid %u",
 				       to_dest_node_id);
+			cb->mqd_msg_fmt_ver = o_msg_fmt_ver;
 
 			MQSV_EVT *evt = NULL;
 			evt = m_MMGR_ALLOC_MQSV_EVT(NCS_SERVICE_ID_MQND);
@@ -895,6 +1002,26 @@ uint32_t mqnd_mds_send_rsp(MQND_CB *cb, MQSV_SEND_INFO *s_info, MQSV_EVT *evt)
 
 uint32_t mqnd_mds_send_rsp_direct(MQND_CB *cb, MQSV_DSEND_INFO *s_info,
 				  MQSV_DSEND_EVT *evt)
+{
+	return mqnd_mds_send_rsp_direct_len(cb, s_info, evt,
+					    sizeof(MQSV_DSEND_EVT));
+}
+
+/****************************************************************************
+ * Name          : mqnd_mds_send_rsp_direct_len
+ *
+ * Description   : Send the Response to Sync Requests, the response is length
+ *                 bytes long
+ *
+ * Arguments     :
+ *
+ * Return Values :
+ *
+ * Notes         :
+ *****************************************************************************/
+
+uint32_t mqnd_mds_send_rsp_direct_len(MQND_CB *cb, MQSV_DSEND_INFO *s_info,
+				      MQSV_DSEND_EVT *evt, uint32_t length)
 {
 	NCSMDS_INFO mds_info;
 	uint32_t rc;
@@ -906,8 +1033,7 @@ uint32_t mqnd_mds_send_rsp_direct(MQND_CB *cb, MQSV_DSEND_INFO *s_info,
 
 	/* fill the send structure */
 	mds_info.info.svc_direct_send.i_direct_buff = (NCSCONTEXT)evt;
-	mds_info.info.svc_direct_send.i_direct_buff_len =
-	    sizeof(MQSV_DSEND_EVT);
+	mds_info.info.svc_direct_send.i_direct_buff_len = length;
 	mds_info.info.svc_direct_send.i_priority = MDS_SEND_PRIORITY_MEDIUM;
 	mds_info.info.svc_direct_send.i_to_svc = s_info->to_svc;
 	mds_info.info.svc_direct_send.i_msg_fmt_ver = evt->msg_fmt_version;
@@ -21,13 +21,14 @@
 ..............................................................................
 
   DESCRIPTION: This file contains the Library functions for Native message
-	       queue operations.
+	       queue operations. The message queues are shared memory queues,
+	       see msg/common/posix.c.
 
     This file inclused following routines:
     mqnd_mq_create
-    mqnd_mq_open
     mqnd_mq_destroy
     mqnd_mq_msg_send
+    mqnd_mq_direct_set
     mqnd_mq_msg_rcv
 
 ******************************************************************************/
@@ -50,8 +51,6 @@ uint32_t mqnd_mq_create(MQND_QUEUE_INFO *q_info)
 	char queue_name[SA_MAX_NAME_LENGTH];
 	uint8_t i;
 	uint32_t size = 0;
-	MQND_QUEUE_INFO zero_q;
-	uint32_t rc = NCSCC_RC_SUCCESS;
 	TRACE_ENTER();
 
 	memset(&info, 0, sizeof(NCS_OS_POSIX_MQ_REQ_INFO));
@@ -69,52 +68,9 @@ uint32_t mqnd_mq_create(MQND_QUEUE_INFO *q_info)
 
 	info.info.open.attr.mq_msgsize = size + MQSV_MSG_OVERHEAD;
 
-	/* Create a New message queue */
-	if (m_NCS_OS_POSIX_MQ(&info) != NCSCC_RC_SUCCESS) {
-		LOG_ER("%s:%u: Creation of New message queue failed", __FILE__,
-		       __LINE__);
-		return (NCSCC_RC_FAILURE);
-	}
-
-	if (info.info.open.o_mqd == 0) {
-		/* MQSv particia can't handle zero Handle, get the new queue */
-		zero_q = *q_info;
-		zero_q.queueHandle = 0;
-		if (m_NCS_OS_POSIX_MQ(&info) != NCSCC_RC_SUCCESS) {
-			LOG_ER("%s:%u: Creation of New message queue failed",
-			       __FILE__, __LINE__);
-			rc = NCSCC_RC_FAILURE;
-		}
-		mqnd_mq_destroy(&zero_q);
-	}
-
-	if (rc == NCSCC_RC_SUCCESS)
-		q_info->queueHandle = info.info.open.o_mqd;
-
-	TRACE_LEAVE();
-	return rc;
-}
-
-/****************************************************************************
- * Function Name: mqnd_mq_open
- * Purpose: Used to open the existing message queue
- * Return Value:  NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE
- ****************************************************************************/
-uint32_t mqnd_mq_open(MQND_QUEUE_INFO *q_info)
-{
-	NCS_OS_POSIX_MQ_REQ_INFO info;
-	char queue_name[SA_MAX_NAME_LENGTH];
-
-	memset(&info, 0, sizeof(NCS_OS_POSIX_MQ_REQ_INFO));
-	info.req = NCS_OS_POSIX_MQ_REQ_OPEN;
-	memcpy(queue_name, q_info->queueName.value, q_info->queueName.length);
-	queue_name[q_info->queueName.length] = '\0';
-	info.info.open.qname = queue_name;
-	info.info.open.node = m_NCS_NODE_ID_FROM_MDS_DEST(q_info->rcvr_mqa);
-	info.info.open.iflags = 0;
-
-	/* Create a New message queue */
-	if (m_NCS_OS_POSIX_MQ(&info) != NCSCC_RC_SUCCESS) {
+	/* Create a New message queue, the handle of a shared memory queue is
+	 * never zero */
+	if (m_MQSV_SHM_MQ(&info) != NCSCC_RC_SUCCESS) {
 		LOG_ER("%s:%u: Creation of New message queue failed", __FILE__,
 		       __LINE__);
 		return (NCSCC_RC_FAILURE);
@@ -122,6 +78,7 @@ uint32_t mqnd_mq_open(MQND_QUEUE_INFO *q_info)
 
 	q_info->queueHandle = info.info.open.o_mqd;
 
+	TRACE_LEAVE();
 	return NCSCC_RC_SUCCESS;
 }
 
@@ -133,35 +90,22 @@ uint32_t mqnd_mq_open(MQND_QUEUE_INFO *q_info)
 uint32_t mqnd_mq_destroy(MQND_QUEUE_INFO *q_info)
 {
 	NCS_OS_POSIX_MQ_REQ_INFO info;
-	uint8_t qName[SA_MAX_NAME_LENGTH] = {0};
 
 	/* No queuehdl present so return success */
 	if (q_info->queueHandle == 0)
 		return NCSCC_RC_SUCCESS;
 
+	/* Closing a shared memory queue also removes it */
 	memset(&info, 0, sizeof(NCS_OS_POSIX_MQ_REQ_INFO));
 	info.req = NCS_OS_POSIX_MQ_REQ_CLOSE;
 	info.info.close.mqd = q_info->queueHandle;
 
-	if (m_NCS_OS_POSIX_MQ(&info) != NCSCC_RC_SUCCESS) {
+	if (m_MQSV_SHM_MQ(&info) != NCSCC_RC_SUCCESS) {
 		LOG_ER("%s:%u: Closing the existing message queue failed",
 		       __FILE__, __LINE__);
 		return (NCSCC_RC_FAILURE);
 	}
 
-	/* Unlink the file created by leap */
-	memset(&info, 0, sizeof(NCS_OS_POSIX_MQ_REQ_INFO));
-	info.req = NCS_OS_POSIX_MQ_REQ_UNLINK;
-	strncpy((char *)qName, (char *)q_info->queueName.value,
-		q_info->queueName.length);
-	info.info.unlink.qname = qName;
-	info.info.unlink.node = m_NCS_NODE_ID_FROM_MDS_DEST(q_info->rcvr_mqa);
-
-	if (m_NCS_OS_POSIX_MQ(&info) != NCSCC_RC_SUCCESS) {
-		LOG_ER("Removing the existing message queue failed");
-		return (NCSCC_RC_FAILURE);
-	}
-
 	return NCSCC_RC_SUCCESS;
 }
 
@@ -190,7 +134,7 @@ uint32_t mqnd_mq_msg_send(uint32_t qhdl, MQSV_MESSAGE *mqsv_msg, uint32_t size)
 
 	info.info.send.i_mtype = mqsv_msg->info.msg.message.priority + 3;
 
-	if (m_NCS_OS_POSIX_MQ(&info) != NCSCC_RC_SUCCESS) {
+	if (m_MQSV_SHM_MQ(&info) != NCSCC_RC_SUCCESS) {
 		LOG_ER("Sending the message to message queue failed");
 		return (NCSCC_RC_FAILURE);
 	}
@@ -198,6 +142,27 @@ uint32_t mqnd_mq_msg_send(uint32_t qhdl, MQSV_MESSAGE *mqsv_msg, uint32_t size)
 	return NCSCC_RC_SUCCESS;
 }
 
+/****************************************************************************
+ * Function Name: mqnd_mq_direct_set
+ * Purpose: Used to set the space of the queue and to allow the senders on
+ *          the node to put messages directly into the queue while it is
+ *          owned, see mqsv_shm_mq_direct_send()
+ * Return Value:  NCSCC_RC_SUCCESS/NCSCC_RC_FAILURE
+ ****************************************************************************/
+uint32_t mqnd_mq_direct_set(MQND_CB *cb, MQND_QUEUE_INFO *q_info)
+{
+	bool enable = (q_info->owner_flag == MQSV_QUEUE_OWN_STATE_OWNED);
+
+	if (mqsv_shm_mq_direct_set(q_info->queueHandle, enable,
+				   q_info->listenerHandle, q_info->size,
+				   cb->gl_msg_max_msg_size) != NCSCC_RC_SUCCESS) {
+		LOG_ER("Setting the direct sends of message queue failed");
+		return NCSCC_RC_FAILURE;
+	}
+
+	return NCSCC_RC_SUCCESS;
+}
+
 /****************************************************************************
  * Function Name: mqnd_mq_empty
  * Purpose: Used to empty the message queue
@@ -215,7 +180,7 @@ uint32_t mqnd_mq_empty(SaMsgQueueHandleT handle)
 
 	mq_req.req = NCS_OS_POSIX_MQ_REQ_GET_ATTR;
 	mq_req.info.attr.i_mqd = handle;
-	if (m_NCS_OS_POSIX_MQ(&mq_req) != NCSCC_RC_SUCCESS) {
+	if (m_MQSV_SHM_MQ(&mq_req) != NCSCC_RC_SUCCESS) {
 		LOG_ER("Empty the message in message queue failed");
 		return NCSCC_RC_FAILURE;
 	}
@@ -239,9 +204,9 @@ uint32_t mqnd_mq_empty(SaMsgQueueHandleT handle)
 	mq_req.info.recv.i_mtype = -7;
 
 	for (count = 0; count < num_messages; count++)
-		m_NCS_OS_POSIX_MQ(&mq_req);
+		m_MQSV_SHM_MQ(&mq_req);
 
-	return NCSCC_RC_SUCCESS;
+	return mqsv_shm_mq_space_reset(handle);
 }
 
 /****************************************************************************
@@ -275,7 +240,7 @@ uint32_t mqnd_mq_rcv(SaMsgQueueHandleT handle)
 	    -7; /* Read only the priorities brtween 1 and 6,
 		   with 1 as highest priority */
 
-	if (m_NCS_OS_POSIX_MQ(&mq_req) != NCSCC_RC_SUCCESS) {
+	if (m_MQSV_SHM_MQ(&mq_req) != NCSCC_RC_SUCCESS) {
 		LOG_ER("Receiving the message from message queue failed");
 		return NCSCC_RC_FAILURE;
 	}
@@ -292,8 +257,6 @@ uint32_t mqnd_listenerq_create(MQND_QUEUE_INFO *q_info)
 {
 	NCS_OS_POSIX_MQ_REQ_INFO info;
 	char queue_name[SA_MAX_NAME_LENGTH];
-	MQND_QUEUE_INFO zero_q;
-	uint32_t rc = NCSCC_RC_SUCCESS;
 
 	memset(&info, 0, sizeof(NCS_OS_POSIX_MQ_REQ_INFO));
 	info.req = NCS_OS_POSIX_MQ_REQ_OPEN;
@@ -305,28 +268,15 @@ uint32_t mqnd_listenerq_create(MQND_QUEUE_INFO *q_info)
 	info.info.open.attr.mq_msgsize = MQND_LISTENER_QUEUE_SIZE;
 
 	/* Create a New message queue */
-	if (m_NCS_OS_POSIX_MQ(&info) != NCSCC_RC_SUCCESS) {
+	if (m_MQSV_SHM_MQ(&info) != NCSCC_RC_SUCCESS) {
 		LOG_ER("%s:%u: Creation of message queue failed", __FILE__,
 		       __LINE__);
 		return (NCSCC_RC_FAILURE);
 	}
 
-	if (info.info.open.o_mqd == 0) {
-		/* MQSv particia can't handle zero Handle, get the new queue */
-		zero_q = *q_info;
-		zero_q.listenerHandle = 0;
-		if (m_NCS_OS_POSIX_MQ(&info) != NCSCC_RC_SUCCESS) {
-			LOG_ER("%s:%u: Creation of message queue failed",
-			       __FILE__, __LINE__);
-			rc = NCSCC_RC_FAILURE;
-		}
-		mqnd_listenerq_destroy(&zero_q);
-	}
-
-	if (rc == NCSCC_RC_SUCCESS)
-		q_info->listenerHandle = info.info.open.o_mqd;
+	q_info->listenerHandle = info.info.open.o_mqd;
 
-	return rc;
+	return NCSCC_RC_SUCCESS;
 }
 
 /****************************************************************************
@@ -337,34 +287,22 @@ uint32_t mqnd_listenerq_create(MQND_QUEUE_INFO *q_info)
 uint32_t mqnd_listenerq_destroy(MQND_QUEUE_INFO *q_info)
 {
 	NCS_OS_POSIX_MQ_REQ_INFO info;
-	uint8_t qName[SA_MAX_NAME_LENGTH] = {0};
 
 	/* No listener queue present, return */
 	if (!q_info->listenerHandle)
 		return NCSCC_RC_SUCCESS;
 
+	/* Closing a shared memory queue also removes it */
 	memset(&info, 0, sizeof(NCS_OS_POSIX_MQ_REQ_INFO));
 	info.req = NCS_OS_POSIX_MQ_REQ_CLOSE;
 	info.info.close.mqd = q_info->listenerHandle;
 
-	if (m_NCS_OS_POSIX_MQ(&info) != NCSCC_RC_SUCCESS) {
+	if (m_MQSV_SHM_MQ(&info) != NCSCC_RC_SUCCESS) {
 		LOG_ER("%s:%u: Closing the existing message queue failed",
 		       __FILE__, __LINE__);
 		return (NCSCC_RC_FAILURE);
 	}
 
-	/* Unlink the file created by leap */
-	memset(&info, 0, sizeof(NCS_OS_POSIX_MQ_REQ_INFO));
-	info.req = NCS_OS_POSIX_MQ_REQ_UNLINK;
-	sprintf((char *)qName, "NCS_MQSV%llu", q_info->queueHandle);
-	info.info.unlink.qname = qName;
-	info.info.unlink.node = m_NCS_NODE_ID_FROM_MDS_DEST(q_info->rcvr_mqa);
-
-	if (m_NCS_OS_POSIX_MQ(&info) != NCSCC_RC_SUCCESS) {
-		LOG_ER("Removing the existing message queue failed");
-		return (NCSCC_RC_FAILURE);
-	}
-
 	return NCSCC_RC_SUCCESS;
 }
 
@@ -187,6 +187,7 @@ uint32_t mqnd_evt_proc_mqp_qtransfer_complete(MQND_CB *cb, MQSV_EVT *req)
 
 		if (rc == SA_AIS_OK) {
 			qnode->qinfo.owner_flag = MQSV_QUEUE_OWN_STATE_ORPHAN;
+			mqnd_mq_direct_set(cb, &qnode->qinfo);
 			memset(&queue_ckpt_node, 0,
 			       sizeof(MQND_QUEUE_CKPT_INFO));
 			mqnd_cpy_qnodeinfo_to_ckptinfo(cb, qnode,
@@ -272,7 +273,7 @@ uint32_t mqnd_evt_proc_mqp_qtransfer(MQND_CB *cb, MQSV_EVT *req)
 	/* Read all the messages from the queue and pack it into buffer */
 	qreq.req = NCS_OS_POSIX_MQ_REQ_GET_ATTR;
 	qreq.info.attr.i_mqd = qhdl;
-	if (m_NCS_OS_POSIX_MQ(&qreq) != NCSCC_RC_SUCCESS) {
+	if (m_MQSV_SHM_MQ(&qreq) != NCSCC_RC_SUCCESS) {
 		LOG_ER(
 		    "ERR_RESOURCES: Unable to get the queue attributes from the queue");
 		err = SA_AIS_ERR_NO_RESOURCES;
@@ -364,6 +365,7 @@ uint32_t mqnd_evt_proc_mqp_qtransfer(MQND_CB *cb, MQSV_EVT *req)
 reg_req:
 	/* Change owner flag to TransferInProgress */
 	qnode->qinfo.owner_flag = MQSV_QUEUE_OWN_STATE_PROGRESS;
+	mqnd_mq_direct_set(cb, &qnode->qinfo);
 	/*Before sending the transfer response start the timer to check the
 	 * Queue Transfer progress */
 	qnode->qinfo.qtransfer_complete_tmr.type =
@@ -459,6 +461,7 @@ reg_req:
 			LOG_ER(
 			    "ERR_LIBRARY: Asapi Opr handler for Queue Register Failed");
 			qnode->qinfo.owner_flag = MQSV_QUEUE_OWN_STATE_ORPHAN;
+			mqnd_mq_direct_set(cb, &qnode->qinfo);
 			err = SA_AIS_ERR_LIBRARY;
 		} else
 			err = SA_AIS_OK;
@@ -728,34 +731,14 @@ uint32_t mqnd_fill_queue_from_transfered_buffer(MQND_CB *cb,
 	MQSV_MESSAGE *mqsv_message;
 	uint32_t offset = 0;
 	uint32_t size = 0;
-	NCS_OS_POSIX_MQ_REQ_INFO info;
 	if ((transfer_rsp->openReq.openFlags & SA_MSG_QUEUE_EMPTY) ||
 	    (transfer_rsp->msg_count == 0)) {
 		mqnd_reset_queue_stats(cb, qnode->qinfo.shm_queue_index);
 		return rc;
 	}
 
-	/* Resizze the new queue so that its able to hold all the incoming
-	 * messages */
-	memset(&info, 0, sizeof(NCS_OS_POSIX_MQ_REQ_INFO));
-
-	info.req = NCS_OS_POSIX_MQ_REQ_RESIZE;
-	info.info.resize.mqd = qnode->qinfo.queueHandle;
-
-	/* Increase queue size so that its able to hold all messages + their
-	 * MQSV + LEAP headers */
-	info.info.resize.i_newqsize =
-	    transfer_rsp->msg_bytes +
-	    (transfer_rsp->msg_count *
-	     (sizeof(MQSV_MESSAGE) + sizeof(NCS_OS_MQ_MSG_LL_HDR)));
-
-	if (m_NCS_OS_POSIX_MQ(&info) != NCSCC_RC_SUCCESS) {
-		LOG_ER("Unable to resize the queue to the given size");
-		rc = NCSCC_RC_FAILURE;
-		return rc;
-	}
-
-	/* Receive all the messages and send it to the queue. */
+	/* Receive all the messages and send it to the queue, the queue grows
+	 * as needed. */
 	for (i = 0; i < transfer_rsp->msg_count; i++) {
 
 		mqsv_message =
@@ -767,10 +750,11 @@ uint32_t mqnd_fill_queue_from_transfered_buffer(MQND_CB *cb,
 				  mqsv_message->info.msg.message.size);
 		offset += size;
 
-		/* Update the stats */
-		mqnd_send_msg_update_stats_shm(
-		    cb, qnode, mqsv_message->info.msg.message.size,
-		    mqsv_message->info.msg.message.priority);
+		/* Account for the message, it may exceed the queue size */
+		mqsv_shm_mq_space_take(qnode->qinfo.queueHandle,
+				       mqsv_message->info.msg.message.priority,
+				       mqsv_message->info.msg.message.size,
+				       false);
 
 		rc = mqnd_mq_msg_send(qnode->qinfo.queueHandle, mqsv_message,
 				      (uint32_t)size);
@@ -781,6 +765,9 @@ uint32_t mqnd_fill_queue_from_transfered_buffer(MQND_CB *cb,
 		}
 	}
 
+	/* Update the stats */
+	mqnd_queue_stats_update_shm(cb, qnode);
+
 	return NCSCC_RC_SUCCESS;
 }
 
@@ -849,6 +836,7 @@ uint32_t mqnd_existing_queue_open(MQND_CB *cb, MQSV_SEND_INFO *sinfo,
 		qnode->qinfo.rcvr_mqa = sinfo->dest;
 		qnode->qinfo.msgHandle = open->msgHandle;
 	}
+	mqnd_mq_direct_set(cb, &qnode->qinfo);
 
 	/* Emptying the queue is to be done as last step coz if done earlier and
 	   if so other error occurrs, we will need to put in an elaborate logic
@@ -897,6 +885,7 @@ error2:
 error1:
 	*qnode = tmpnode;
 	qnode->qinfo.listenerHandle = 0;
+	mqnd_mq_direct_set(cb, &qnode->qinfo);
 	mqnd_cpy_qnodeinfo_to_ckptinfo(cb, qnode, &queue_ckpt_node);
 	mqnd_ckpt_queue_info_write(cb, &queue_ckpt_node,
 				   qnode->qinfo.shm_queue_index);
@@ -1279,6 +1268,7 @@ uint32_t mqnd_proc_queue_close(MQND_CB *cb, MQND_QUEUE_NODE *qnode,
 
 		/* Queue is not unlinked */
 		qnode->qinfo.owner_flag = MQSV_QUEUE_OWN_STATE_ORPHAN;
+		mqnd_mq_direct_set(cb, &qnode->qinfo);
 
 		/* Request the ASAPi */
 		memset(&opr, 0, sizeof(ASAPi_OPR_INFO));
@@ -1355,6 +1345,7 @@ uint32_t mqnd_proc_queue_close(MQND_CB *cb, MQND_QUEUE_NODE *qnode,
 			    (opr.info.msg.resp->info.rresp.err.flag)) {
 				qnode->qinfo.owner_flag =
 				    MQSV_QUEUE_OWN_STATE_OWNED;
+				mqnd_mq_direct_set(cb, &qnode->qinfo);
 				LOG_ER(
 				    "ERR_RESOURCES: Asapi Opr handler for Queue Register Failed");
 				*err = SA_AIS_ERR_NO_RESOURCES;
@@ -1383,6 +1374,7 @@ uint32_t mqnd_proc_queue_close(MQND_CB *cb, MQND_QUEUE_NODE *qnode,
 		if (rc != SA_AIS_OK) {
 			/* Log that CKPT Delete is not successfull */
 			qnode->qinfo.owner_flag = MQSV_QUEUE_OWN_STATE_OWNED;
+			mqnd_mq_direct_set(cb, &qnode->qinfo);
 			LOG_ER(
 			    "ERR_RESOURCES: Checkpointing queue info to local shared memory of MQND");
 			*err = SA_AIS_ERR_NO_RESOURCES;
@@ -29,7 +29,7 @@
     mqnd_shm_create
     mqnd_reset_queue_stats
     mqnd_find_shm_ckpt_empty_section
-    mqnd_send_msg_update_stats_shm
+    mqnd_queue_stats_update_shm
     mqnd_shm_queue_ckpt_section_invalidate
 
 ******************************************************************************/
@@ -207,42 +207,49 @@ uint32_t mqnd_find_shm_ckpt_empty_section(MQND_CB *cb, uint32_t *index)
 }
 
 /****************************************************************************
- * Name          : mqnd_send_msg_update_stats_shm
+ * Name          : mqnd_queue_stats_update_shm
  *
- * Description   : Function to update stats of queue in shm when message is
- sent.
- *
- * Arguments     : MQND_QUEUE_NODE *qnode
-		   MQP_SEND_MSG *snd_msg
+ * Description   : Function to update the usage stats of the queue in shm from
+ *                 the space of the queue, which accounts for the messages put
+ *                 into the queue by MQND and by the senders on the node.
  *
+ * Arguments     : MQND_CB *cb - MQND CB pointer
+ *                 MQND_QUEUE_NODE *qnode - queue node
  *
  * Return Values : NCSCC_RC_SUCCESS/Error.
  *
  * Notes         : None.
  *****************************************************************************/
-uint32_t mqnd_send_msg_update_stats_shm(MQND_CB *cb, MQND_QUEUE_NODE *qnode,
-					SaSizeT size, SaUint8T priority)
+uint32_t mqnd_queue_stats_update_shm(MQND_CB *cb, MQND_QUEUE_NODE *qnode)
 {
-	uint32_t offset;
-
+	uint32_t offset, i;
 	MQND_QUEUE_CKPT_INFO *shm_base_addr;
+	SaSizeT used[SA_MSG_MESSAGE_LOWEST_PRIORITY + 1];
+	SaUint32T num_msgs[SA_MSG_MESSAGE_LOWEST_PRIORITY + 1];
 
 	shm_base_addr = cb->mqnd_shm.shm_base_addr;
 
 	offset = qnode->qinfo.shm_queue_index;
-	if (shm_base_addr[offset].valid == SHM_QUEUE_INFO_VALID) {
-		shm_base_addr[offset]
-		    .QueueStatsShm.saMsgQueueUsage[priority]
-		    .queueUsed += size;
-		shm_base_addr[offset]
-		    .QueueStatsShm.saMsgQueueUsage[priority]
-		    .numberOfMessages += 1;
-		shm_base_addr[offset].QueueStatsShm.totalQueueUsed += size;
-		shm_base_addr[offset].QueueStatsShm.totalNumberOfMessages += 1;
-	} else {
+	if ((shm_base_addr[offset].valid != SHM_QUEUE_INFO_VALID) ||
+	    (mqsv_shm_mq_space_get(qnode->qinfo.queueHandle, used, num_msgs) !=
+	     NCSCC_RC_SUCCESS)) {
 		/*log the error */
 		return NCSCC_RC_FAILURE;
 	}
+
+	shm_base_addr[offset].QueueStatsShm.totalQueueUsed = 0;
+	shm_base_addr[offset].QueueStatsShm.totalNumberOfMessages = 0;
+	for (i = SA_MSG_MESSAGE_HIGHEST_PRIORITY;
+	     i <= SA_MSG_MESSAGE_LOWEST_PRIORITY; i++) {
+		shm_base_addr[offset].QueueStatsShm.saMsgQueueUsage[i].queueUsed =
+		    used[i];
+		shm_base_addr[offset]
+		    .QueueStatsShm.saMsgQueueUsage[i]
+		    .numberOfMessages = num_msgs[i];
+		shm_base_addr[offset].QueueStatsShm.totalQueueUsed += used[i];
+		shm_base_addr[offset].QueueStatsShm.totalNumberOfMessages +=
+		    num_msgs[i];
+	}
 	return NCSCC_RC_SUCCESS;
 }
 
@@ -58,7 +58,7 @@ static void mqnd_timer_expiry(NCSCONTEXT uarg)
 		/* post a message to the corresponding component */
 		if ((cb = (MQND_CB *)ncshm_take_hdl(NCS_SERVICE_ID_MQND,
 						    mqnd_hdl)) != NULL) {
-			if (cb->mqa_timer.type == MQND_TMR_TYPE_MQA_EXPIRY) {
+			if (tmr->type == MQND_TMR_TYPE_MQA_EXPIRY) {
 				LOG_ER("The MQA timer expired");
 			}
 			evt = m_MMGR_ALLOC_MQSV_EVT(NCS_SERVICE_ID_MQND);
@@ -20,11 +20,13 @@
 #define MQND_MQA_EXPIRY_TIMER 10
 #define MQND_QTRANSFER_REQ_TIMER \
   999 /*  999 Ten milli seconds = 9.99 sec because timer at mqa is 10 sec */
+#define MQND_LOAD_UPDATE_TIMER 100 /* Default 1 sec between load updates */
 typedef enum mqndq_tmr_type {
   MQND_TMR_TYPE_RETENTION = 1,
   MQND_TMR_TYPE_MQA_EXPIRY,
   MQND_TMR_TYPE_NODE1_QTRANSFER,
   MQND_TMR_TYPE_NODE2_QTRANSFER,
+  MQND_TMR_TYPE_LOAD_UPDATE,
   MQND_TMR_TYPE_MAX = MQND_TMR_TYPE_MQA_EXPIRY
 } MQND_TMR_TYPE;
 
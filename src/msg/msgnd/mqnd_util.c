@@ -152,6 +152,12 @@ uint32_t mqnd_queue_create(MQND_CB *cb, MQP_OPEN_REQ *open, MDS_DEST *rcvr_mqa,
 		}
 	}
 
+	/* The queue is owned, the senders on the node may put messages
+	 * directly */
+	rc = mqnd_mq_direct_set(cb, &qnode->qinfo);
+	if (rc != NCSCC_RC_SUCCESS)
+		goto qnode_destroy;
+
 	/* Create & add qname structure */
 	memset(pnode, 0, sizeof(MQND_QNAME_NODE));
 	pnode->qname = qnode->qinfo.queueName;
@@ -0,0 +1,463 @@
+/*      -*- OpenSAF  -*-
+ *
+ * (C) Copyright 2026 The OpenSAF Foundation
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. This file and program are licensed
+ * under the GNU Lesser General Public License Version 2.1, February 1999.
+ * The complete license can be accessed from the following location:
+ * http://opensource.org/licenses/lgpl-license.php
+ * See the Copying file included with the OpenSAF distribution for full
+ * licensing terms.
+ *
+ */
+
+#include <fcntl.h>
+#include <grp.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include "msg/common/mqsv.h"
+#include "msg/common/mqsv_shm_mq.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// A user and groups other than the ones of the test
+const uid_t kOtherUid = 65534;
+const gid_t kOtherGid = 65534;
+const gid_t kQueueGid = 65533;
+
+class MqsvShmMqTest : public ::testing::Test {
+ protected:
+  MqsvShmMqTest() : hdl_{0}, ctl_{nullptr} {}
+
+  void SetUp() override {
+    ASSERT_TRUE(Create(&hdl_));
+    ctl_ = MapControlArea(hdl_);
+    ASSERT_NE(ctl_, nullptr);
+  }
+
+  void TearDown() override {
+    if (ctl_ != nullptr) munmap(ctl_, sysconf(_SC_PAGESIZE));
+    if (hdl_ != 0) Destroy(hdl_);
+  }
+
+  static std::string Name(NCS_OS_POSIX_MQD hdl) {
+    char name[MQSV_SHM_MQ_NAME_SIZE];
+    snprintf(name, sizeof(name), MQSV_SHM_MQ_NAME_FORMAT, hdl);
+    return name;
+  }
+
+  static bool Create(NCS_OS_POSIX_MQD* hdl) {
+    NCS_OS_POSIX_MQ_REQ_INFO req;
+    memset(&req, 0, sizeof(req));
+    req.req = NCS_OS_POSIX_MQ_REQ_OPEN;
+    req.info.open.iflags = O_CREAT | O_RDWR;
+    req.info.open.attr.mq_msgsize = 4096;
+    if (mqsv_shm_mq(&req) != NCSCC_RC_SUCCESS) return false;
+    *hdl = req.info.open.o_mqd;
+    return true;
+  }
+
+  static bool Destroy(NCS_OS_POSIX_MQD hdl) {
+    NCS_OS_POSIX_MQ_REQ_INFO req;
+    memset(&req, 0, sizeof(req));
+    req.req = NCS_OS_POSIX_MQ_REQ_CLOSE;
+    req.info.close.mqd = hdl;
+    return mqsv_shm_mq(&req) == NCSCC_RC_SUCCESS;
+  }
+
+  // The control area, as it is seen by the other processes
+  static MQSV_SHM_MQ_CTL* MapControlArea(NCS_OS_POSIX_MQD hdl) {
+    int fd = shm_open(Name(hdl).c_str(), O_RDWR, 0);
+    if (fd < 0) return nullptr;
+    void* ctl = mmap(nullptr, sysconf(_SC_PAGESIZE), PROT_READ | PROT_WRITE,
+                     MAP_SHARED, fd, 0);
+    close(fd);
+    return ctl == MAP_FAILED ? nullptr : static_cast<MQSV_SHM_MQ_CTL*>(ctl);
+  }
+
+  bool Send(uint32_t mtype, const std::string& data) {
+    return Send(hdl_, mtype, data);
+  }
+
+  static bool Send(NCS_OS_POSIX_MQD hdl, uint32_t mtype,
+                   const std::string& data) {
+    NCS_OS_MQ_MSG msg;
+    memcpy(msg.data, data.data(), data.size());
+    NCS_OS_POSIX_MQ_REQ_INFO req;
+    memset(&req, 0, sizeof(req));
+    req.req = NCS_OS_POSIX_MQ_REQ_MSG_SEND_ASYNC;
+    req.info.send.mqd = hdl;
+    req.info.send.datalen = data.size();
+    req.info.send.i_msg = &msg;
+    req.info.send.i_mtype = mtype;
+    return mqsv_shm_mq(&req) == NCSCC_RC_SUCCESS;
+  }
+
+  // Put a message of the SAF priority @a priority as a sender on the node
+  bool DirectSend(SaUint8T priority, const std::string& data,
+                  SaMsgQueueHandleT* listener) {
+    NCS_OS_MQ_MSG msg;
+    memcpy(msg.data, data.data(), data.size());
+    NCS_OS_POSIX_MQ_REQ_INFO req;
+    memset(&req, 0, sizeof(req));
+    req.info.send.mqd = hdl_;
+    req.info.send.datalen = data.size();
+    req.info.send.i_msg = &msg;
+    req.info.send.i_mtype = priority + 3;
+    return mqsv_shm_mq_direct_send(&req.info.send, priority, data.size(),
+                                   listener) == NCSCC_RC_SUCCESS;
+  }
+
+  // Allow the direct sends, 25 bytes for each priority
+  bool DirectSet(bool enable) {
+    const SaSizeT size[MQSV_SHM_MQ_NUM_PRIOS] = {25, 25, 25, 25};
+    return mqsv_shm_mq_direct_set(hdl_, enable, 77, size, 20) ==
+           NCSCC_RC_SUCCESS;
+  }
+
+  // Receive a message of type @a mtype, as msgrcv(), without blocking
+  static bool Receive(NCS_OS_POSIX_MQD hdl, int32_t mtype, uint32_t* type,
+                      std::string* data, uint32_t max_size = sizeof(
+                          NCS_OS_MQ_MSG::data),
+                      bool block = false) {
+    NCS_OS_MQ_MSG msg;
+    NCS_OS_POSIX_MQ_REQ_INFO req;
+    memset(&req, 0, sizeof(req));
+    req.req = block ? NCS_OS_POSIX_MQ_REQ_MSG_RECV
+                    : NCS_OS_POSIX_MQ_REQ_MSG_RECV_ASYNC;
+    req.info.recv.mqd = hdl;
+    req.info.recv.datalen = max_size;
+    req.info.recv.i_msg = &msg;
+    req.info.recv.i_mtype = mtype;
+    if (mqsv_shm_mq(&req) != NCSCC_RC_SUCCESS) return false;
+    *type = msg.ll_hdr;
+    // The length is not returned, the messages of the tests are strings
+    *data = std::string(reinterpret_cast<char*>(msg.data),
+                        strnlen(reinterpret_cast<char*>(msg.data),
+                                sizeof(msg.data)));
+    return true;
+  }
+
+  bool Receive(int32_t mtype, uint32_t* type, std::string* data) {
+    return Receive(hdl_, mtype, type, data);
+  }
+
+  static std::string Message(int i) {
+    return "message " + std::to_string(i) + std::string(1, '\0');
+  }
+
+  // Expect the messages of one type to be received in order
+  void ExpectMessages(uint32_t mtype, int first, int count) {
+    for (int i = first; i != first + count; ++i) {
+      uint32_t type;
+      std::string data;
+      ASSERT_TRUE(Receive(mtype, &type, &data)) << i;
+      EXPECT_EQ(type, mtype);
+      EXPECT_EQ(data + std::string(1, '\0'), Message(i));
+    }
+  }
+
+  // Run @a function in a child process that dies holding the queue lock
+  void DieHoldingTheLock(void (*function)(MQSV_SHM_MQ_CTL* ctl)) {
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      pthread_mutex_lock(&ctl_->lock);
+      function(ctl_);
+      _exit(0);
+    }
+    int status;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  }
+
+  // Create a queue holding a message and receive it in a child process of
+  // the user @a uid and the group @a gid, which maps the queue itself as an
+  // application does. Returns true if the child received the message.
+  static bool ReceiveInChild(uid_t uid, gid_t gid) {
+    int fds[2];
+    if (pipe(fds) != 0) return false;
+    pid_t pid = fork();
+    if (pid < 0) return false;
+    if (pid == 0) {
+      NCS_OS_POSIX_MQD hdl;
+      uint32_t type;
+      std::string data;
+      close(fds[1]);
+      if (setgroups(0, nullptr) != 0 || setgid(gid) != 0 ||
+          setuid(uid) != 0 ||
+          read(fds[0], &hdl, sizeof(hdl)) != sizeof(hdl))
+        _exit(2);
+      _exit(Receive(hdl, 0, &type, &data) &&
+                    data + std::string(1, '\0') == Message(0)
+                ? 0
+                : 1);
+    }
+    close(fds[0]);
+    // The access does not depend on the umask of MQND
+    mode_t mask = umask(022);
+    NCS_OS_POSIX_MQD hdl = 0;
+    bool sent = Create(&hdl) && Send(hdl, 3, Message(0)) &&
+                write(fds[1], &hdl, sizeof(hdl)) == sizeof(hdl);
+    umask(mask);
+    close(fds[1]);
+    int status;
+    bool received = waitpid(pid, &status, 0) == pid && WIFEXITED(status) &&
+                    WEXITSTATUS(status) == 0;
+    if (hdl != 0) Destroy(hdl);
+    return sent && received;
+  }
+
+  NCS_OS_POSIX_MQD hdl_;
+  MQSV_SHM_MQ_CTL* ctl_;
+};
+
+}  // namespace
+
+TEST_F(MqsvShmMqTest, ReceivesTheLowestTypeFirst) {
+  ASSERT_TRUE(Send(3, Message(0)));
+  ASSERT_TRUE(Send(6, Message(1)));
+  ASSERT_TRUE(Send(1, Message(2)));
+  ASSERT_TRUE(Send(3, Message(3)));
+
+  uint32_t type;
+  std::string data;
+  EXPECT_FALSE(Receive(2, &type, &data));
+  ASSERT_TRUE(Receive(0, &type, &data));
+  EXPECT_EQ(type, 1u);
+  // A negative type selects the lowest type up to its absolute value
+  EXPECT_TRUE(Receive(-3, &type, &data));
+  EXPECT_EQ(type, 3u);
+  EXPECT_EQ(data + '\0', Message(0));
+  EXPECT_TRUE(Receive(-3, &type, &data));
+  EXPECT_EQ(data + '\0', Message(3));
+  EXPECT_FALSE(Receive(-3, &type, &data));
+  ExpectMessages(6, 1, 1);
+  EXPECT_FALSE(Receive(0, &type, &data));
+}
+
+TEST_F(MqsvShmMqTest, LeavesAMessageLargerThanTheBuffer) {
+  ASSERT_TRUE(Send(3, Message(12345)));
+  uint32_t type;
+  std::string data;
+  EXPECT_FALSE(Receive(hdl_, 0, &type, &data, 4));
+  ExpectMessages(3, 12345, 1);
+}
+
+TEST_F(MqsvShmMqTest, WrapsAroundAndGrowsTheLanes) {
+  // Keep some messages in the lane while sending, so the ring wraps around
+  for (int i = 0; i != 2000; ++i) {
+    ASSERT_TRUE(Send(4, Message(i)));
+    if (i >= 100) ExpectMessages(4, i - 100, 1);
+  }
+  // Fill the lanes of two types beyond their initial size
+  for (int i = 0; i != 1000; ++i) {
+    ASSERT_TRUE(Send(3, Message(i)));
+    ASSERT_TRUE(Send(5, Message(i)));
+  }
+  EXPECT_GT(ctl_->lane[2].capacity, uint64_t{MQSV_SHM_MQ_MIN_LANE_SIZE});
+  EXPECT_GT(ctl_->lane[4].capacity, uint64_t{MQSV_SHM_MQ_MIN_LANE_SIZE});
+  ExpectMessages(4, 1900, 100);
+  ExpectMessages(3, 0, 1000);
+  ExpectMessages(5, 0, 1000);
+
+  NCS_OS_POSIX_MQ_REQ_INFO req;
+  memset(&req, 0, sizeof(req));
+  req.req = NCS_OS_POSIX_MQ_REQ_GET_ATTR;
+  req.info.attr.i_mqd = hdl_;
+  ASSERT_EQ(mqsv_shm_mq(&req), NCSCC_RC_SUCCESS);
+  EXPECT_EQ(req.info.attr.o_attr.mq_curmsgs, 0u);
+  EXPECT_EQ(req.info.attr.o_attr.mq_msgsize, 0u);
+}
+
+TEST_F(MqsvShmMqTest, DestroyWakesABlockedReceiver) {
+  bool received = true;
+  NCS_OS_POSIX_MQD hdl = hdl_;
+  std::thread receiver{[hdl, &received] {
+    uint32_t type;
+    std::string data;
+    received = Receive(hdl, 0, &type, &data, sizeof(NCS_OS_MQ_MSG::data),
+                       true);
+  }};
+  while (__atomic_load_n(&ctl_->num_waiters, __ATOMIC_ACQUIRE) == 0) {
+    usleep(1000);
+  }
+  EXPECT_TRUE(Destroy(hdl_));
+  receiver.join();
+  EXPECT_FALSE(received);
+  hdl_ = 0;
+}
+
+TEST_F(MqsvShmMqTest, HandlesAreNotReused) {
+  NCS_OS_POSIX_MQD hdl;
+  ASSERT_TRUE(Create(&hdl));
+  EXPECT_NE(hdl, hdl_);
+  EXPECT_TRUE(Destroy(hdl));
+  NCS_OS_POSIX_MQD next;
+  ASSERT_TRUE(Create(&next));
+  EXPECT_NE(next, hdl);
+  EXPECT_NE(next, hdl_);
+  EXPECT_TRUE(Destroy(next));
+}
+
+TEST_F(MqsvShmMqTest, ReceivesInAProcessOfAnotherUser) {
+  if (geteuid() != 0) GTEST_SKIP() << "Switching the user needs root";
+  EXPECT_TRUE(ReceiveInChild(kOtherUid, kOtherGid));
+}
+
+TEST_F(MqsvShmMqTest, ReceivesInAProcessOfTheQueueGroupOnly) {
+  if (geteuid() != 0) GTEST_SKIP() << "Switching the user needs root";
+  mqsv_shm_mq_group_set(kQueueGid);
+  EXPECT_TRUE(ReceiveInChild(kOtherUid, kQueueGid));
+  EXPECT_FALSE(ReceiveInChild(kOtherUid, kOtherGid));
+  mqsv_shm_mq_group_set(static_cast<gid_t>(-1));
+}
+
+TEST_F(MqsvShmMqTest, CountsTheMessagesAgainAfterTheOwnerDied) {
+  ASSERT_TRUE(Send(3, Message(0)));
+  ASSERT_TRUE(Send(3, Message(1)));
+  // As if the owner died after committing a send, before counting it
+  DieHoldingTheLock([](MQSV_SHM_MQ_CTL* ctl) { ctl->lane[2].num_msgs = 1; });
+  ExpectMessages(3, 0, 2);
+  uint32_t type;
+  std::string data;
+  EXPECT_FALSE(Receive(0, &type, &data));
+  ASSERT_TRUE(Send(3, Message(2)));
+  ExpectMessages(3, 2, 1);
+}
+
+TEST_F(MqsvShmMqTest, DropsTheMessagesIfTheOwnerDiedGrowingALane) {
+  ASSERT_TRUE(Send(3, Message(0)));
+  DieHoldingTheLock([](MQSV_SHM_MQ_CTL* ctl) {
+    ctl->growing = true;
+    ctl->lane[2].offset = 4;
+  });
+  uint32_t type;
+  std::string data;
+  EXPECT_FALSE(Receive(0, &type, &data));
+  EXPECT_FALSE(ctl_->growing);
+  ASSERT_TRUE(Send(3, Message(1)));
+  ExpectMessages(3, 1, 1);
+}
+
+TEST_F(MqsvShmMqTest, RebuildsACorruptControlArea) {
+  ASSERT_TRUE(Send(3, Message(0)));
+  pthread_mutex_lock(&ctl_->lock);
+  ctl_->lane[2].offset = ctl_->data_size;
+  ctl_->lane[5].tail = ctl_->lane[5].head + ctl_->lane[5].capacity + 8;
+  pthread_mutex_unlock(&ctl_->lock);
+  uint32_t type;
+  std::string data;
+  EXPECT_FALSE(Receive(0, &type, &data));
+  ASSERT_TRUE(Send(3, Message(1)));
+  ExpectMessages(3, 1, 1);
+
+  // A message of 16 bytes, the length of which does not fit in the lane
+  ASSERT_TRUE(Send(4, Message(2)));
+  ExpectMessages(4, 2, 1);
+  pthread_mutex_lock(&ctl_->lock);
+  ctl_->lane[3].head -= 16;
+  ctl_->lane[3].tail = ctl_->lane[3].head + 8;
+  ctl_->lane[3].num_msgs = 1;
+  pthread_mutex_unlock(&ctl_->lock);
+  EXPECT_FALSE(Receive(4, &type, &data));
+  ASSERT_TRUE(Send(4, Message(3)));
+  ExpectMessages(4, 3, 1);
+}
+
+TEST_F(MqsvShmMqTest, DirectSendsOnlyWhileAllowed) {
+  SaMsgQueueHandleT listener = 0;
+  EXPECT_FALSE(DirectSend(0, Message(0), &listener));
+  ASSERT_TRUE(DirectSet(true));
+  ASSERT_TRUE(DirectSend(0, Message(0), &listener));
+  EXPECT_EQ(listener, 77u);
+  ASSERT_TRUE(DirectSet(false));
+  EXPECT_FALSE(DirectSend(0, Message(1), &listener));
+  ExpectMessages(3, 0, 1);
+}
+
+TEST_F(MqsvShmMqTest, DirectSendAccountsForTheSpace) {
+  ASSERT_TRUE(DirectSet(true));
+  SaMsgQueueHandleT listener = 0;
+  // Messages of 10 bytes, two fit into the space of a priority
+  ASSERT_TRUE(DirectSend(1, Message(0), &listener));
+  ASSERT_TRUE(DirectSend(1, Message(1), &listener));
+  EXPECT_FALSE(DirectSend(1, Message(2), &listener));
+  ASSERT_TRUE(DirectSend(3, Message(3), &listener));
+  // Larger than the largest message allowed
+  EXPECT_FALSE(DirectSend(2, std::string(21, 'x'), &listener));
+  // Not a SAF priority
+  EXPECT_FALSE(DirectSend(4, Message(4), &listener));
+
+  SaSizeT used[MQSV_SHM_MQ_NUM_PRIOS];
+  SaUint32T num_msgs[MQSV_SHM_MQ_NUM_PRIOS];
+  ASSERT_EQ(mqsv_shm_mq_space_get(hdl_, used, num_msgs), NCSCC_RC_SUCCESS);
+  EXPECT_EQ(used[0], 0u);
+  EXPECT_EQ(used[1], 20u);
+  EXPECT_EQ(num_msgs[1], 2u);
+  EXPECT_EQ(used[3], 10u);
+  EXPECT_EQ(num_msgs[3], 1u);
+  ExpectMessages(4, 0, 2);
+  ExpectMessages(6, 3, 1);
+
+  // Received and given back by MQND
+  ASSERT_EQ(mqsv_shm_mq_space_give(hdl_, 1, 10, 1), NCSCC_RC_SUCCESS);
+  ASSERT_TRUE(DirectSend(1, Message(2), &listener));
+  ExpectMessages(4, 2, 1);
+}
+
+TEST_F(MqsvShmMqTest, TakesAndGivesTheSpace) {
+  ASSERT_TRUE(DirectSet(false));
+  EXPECT_EQ(mqsv_shm_mq_space_take(hdl_, 2, 20, true), NCSCC_RC_SUCCESS);
+  EXPECT_EQ(mqsv_shm_mq_space_take(hdl_, 2, 6, true), NCSCC_RC_FAILURE);
+  // As the messages of a transferred queue, which may exceed the size
+  EXPECT_EQ(mqsv_shm_mq_space_take(hdl_, 2, 6, false), NCSCC_RC_SUCCESS);
+  EXPECT_EQ(mqsv_shm_mq_space_take(hdl_, 4, 1, false), NCSCC_RC_FAILURE);
+
+  SaSizeT used[MQSV_SHM_MQ_NUM_PRIOS];
+  SaUint32T num_msgs[MQSV_SHM_MQ_NUM_PRIOS];
+  ASSERT_EQ(mqsv_shm_mq_space_get(hdl_, used, num_msgs), NCSCC_RC_SUCCESS);
+  EXPECT_EQ(used[2], 26u);
+  EXPECT_EQ(num_msgs[2], 2u);
+
+  // Never given back below zero
+  ASSERT_EQ(mqsv_shm_mq_space_give(hdl_, 2, 40, 3), NCSCC_RC_SUCCESS);
+  ASSERT_EQ(mqsv_shm_mq_space_get(hdl_, used, num_msgs), NCSCC_RC_SUCCESS);
+  EXPECT_EQ(used[2], 0u);
+  EXPECT_EQ(num_msgs[2], 0u);
+
+  EXPECT_EQ(mqsv_shm_mq_space_take(hdl_, 0, 5, false), NCSCC_RC_SUCCESS);
+  ASSERT_EQ(mqsv_shm_mq_space_reset(hdl_), NCSCC_RC_SUCCESS);
+  ASSERT_EQ(mqsv_shm_mq_space_get(hdl_, used, num_msgs), NCSCC_RC_SUCCESS);
+  EXPECT_EQ(used[0], 0u);
+  EXPECT_EQ(num_msgs[0], 0u);
+}
+
+TEST_F(MqsvShmMqTest, GivesBackTheSpaceOfACorruptQueue) {
+  ASSERT_TRUE(DirectSet(true));
+  SaMsgQueueHandleT listener = 0;
+  ASSERT_TRUE(DirectSend(0, Message(0), &listener));
+  pthread_mutex_lock(&ctl_->lock);
+  ctl_->lane[2].offset = ctl_->data_size;
+  pthread_mutex_unlock(&ctl_->lock);
+  uint32_t type;
+  std::string data;
+  EXPECT_FALSE(Receive(0, &type, &data));
+
+  // The messages are dropped, so is their space
+  SaSizeT used[MQSV_SHM_MQ_NUM_PRIOS];
+  SaUint32T num_msgs[MQSV_SHM_MQ_NUM_PRIOS];
+  ASSERT_EQ(mqsv_shm_mq_space_get(hdl_, used, num_msgs), NCSCC_RC_SUCCESS);
+  EXPECT_EQ(used[0], 0u);
+  EXPECT_EQ(num_msgs[0], 0u);
+  EXPECT_TRUE(DirectSend(0, Message(1), &listener));
+  ExpectMessages(3, 1, 1);
+}